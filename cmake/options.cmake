@@ -11,7 +11,12 @@ option(BUILD_AHBOT          "Build Auction House Bot mod"           OFF)
 option(BUILD_METRICS        "Build Metrics, generate data for Grafana" OFF)
 option(BUILD_RECASTDEMOMOD  "Build map/vmap/mmap viewer"            OFF)
 option(BUILD_GIT_ID         "Build git_id"                          OFF)
+option(BUILD_BENCHMARK      "Build mangos-bench, mangos-microbench and mangos-replay" OFF)
 option(BUILD_DOCS           "Build documentation with doxygen"      OFF)
+option(NO_DEBUG_LOG         "Compile out DEBUG_LOG output"          OFF)
+option(BUILD_TRACING        "Build timeline tracing zones"          OFF)
+set(ALLOCATOR "system" CACHE STRING "Memory allocator to link: system, mimalloc or jemalloc")
+set_property(CACHE ALLOCATOR PROPERTY STRINGS system mimalloc jemalloc)
 option(CMAKE_INTERPROCEDURAL_OPTIMIZATION "Enable link-time optimizations" OFF)
 
 # TODO: options that should be checked/created:
@@ -39,6 +44,9 @@ message(STATUS
     BUILD_RECASTDEMOMOD     Build map/vmap/mmap viewer
     BUILD_GIT_ID            Build git_id
     BUILD_DOCS              Build documentation with doxygen
+    NO_DEBUG_LOG            Compile out DEBUG_LOG and DEBUG_FILTER_LOG output, their arguments are not evaluated
+    BUILD_TRACING           Build timeline tracing zones of the world and map updates, captured to a file with .debug trace
+    ALLOCATOR               Memory allocator to link: system (default), mimalloc or jemalloc
 
   To set an option simply type -D<OPTION>=<VALUE> after 'cmake <srcs>'.
   Also, you can specify the generator with -G. see 'cmake --help' for more details
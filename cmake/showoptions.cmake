@@ -85,6 +85,30 @@ else()
   message(STATUS "Build git_id          : No  (default)")
 endif()
 
+if(BUILD_BENCHMARK)
+  message(STATUS "Build benchmarks      : Yes")
+else()
+  message(STATUS "Build benchmarks      : No  (default)")
+endif()
+
+if(NO_DEBUG_LOG)
+  message(STATUS "Debug log compiled out: Yes")
+else()
+  message(STATUS "Debug log compiled out: No  (default)")
+endif()
+
+if(BUILD_TRACING)
+  message(STATUS "Build tracing zones   : Yes")
+else()
+  message(STATUS "Build tracing zones   : No  (default)")
+endif()
+
+if(ALLOCATOR STREQUAL "system")
+  message(STATUS "Allocator             : system (default)")
+else()
+  message(STATUS "Allocator             : ${ALLOCATOR}")
+endif()
+
 if(BUILD_DOCS)
   message(STATUS "Build documentation   : Yes")
 else()
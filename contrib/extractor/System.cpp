@@ -1,9 +1,13 @@
 #define _CRT_SECURE_NO_DEPRECATE
 
 #include <stdio.h>
+#include <algorithm>
+#include <atomic>
 #include <deque>
 #include <set>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include "direct.h"
@@ -78,6 +82,9 @@ float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
 float CONF_flat_liquid_delta_limit = 0.001f; // If max - min less this value - liquid surface is flat
 
+// Number of map tiles converted at the same time, 0 - one per hardware thread
+uint32 CONF_threads = 0;
+
 // List MPQ for extract from
 static char const* CONF_mpq_list[] =
 {
@@ -125,6 +132,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-t number of map tiles converted in parallel, 0 (one per hardware thread) by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -161,6 +169,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc)                           // all ok
+                    CONF_threads = atoi(arg[(c++) + 1]);
+                else
+                    Usage(arg[0]);
+                break;
             case 'e':
                 if (c + 1 < argc)                           // all ok
                 {
@@ -262,20 +276,57 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per converting thread
+thread_local uint16 area_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+
+std::atomic<uint32> unchangedMapFiles(0);
+
+inline void AppendData(std::vector<char>& out, void const* data, size_t size)
+{
+    char const* bytes = static_cast<char const*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+// Writes a converted file unless the one already in the output path has the same content,
+// so a new extraction over an old one leaves the unchanged tiles (and their timestamps) alone
+bool WriteFileIfChanged(char const* filename, std::vector<char> const& data)
+{
+    if (FILE* existing = fopen(filename, "rb"))
+    {
+        std::vector<char> old(data.size() + 1);
+        size_t oldSize = fread(old.data(), 1, old.size(), existing);
+        fclose(existing);
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+        if (oldSize == data.size() && std::equal(data.begin(), data.end(), old.begin()))
+        {
+            ++unchangedMapFiles;
+            return true;
+        }
+    }
+
+    FILE* output = fopen(filename, "wb");
+    if (!output)
+    {
+        printf("Can't create the output file '%s'\n", filename);
+        return false;
+    }
+
+    fwrite(data.data(), data.size(), 1, output);
+    fclose(output);
+    return true;
+}
 
 bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
 {
@@ -769,67 +820,60 @@ bool ConvertADT(char* filename, char* filename2, int cell_y, int cell_x)
     }
 
     // Ok all data prepared - store it
-    FILE* output = fopen(filename2, "wb");
-    if (!output)
-    {
-        printf("Can't create the output file '%s'\n", filename2);
-        return false;
-    }
-    fwrite(&map, sizeof(map), 1, output);
+    std::vector<char> output;
+    output.reserve(map.holesOffset + map.holesSize);
+
+    AppendData(output, &map, sizeof(map));
     // Store area data
-    fwrite(&areaHeader, sizeof(areaHeader), 1, output);
+    AppendData(output, &areaHeader, sizeof(areaHeader));
     if (!(areaHeader.flags & MAP_AREA_NO_AREA))
-        fwrite(area_flags, sizeof(area_flags), 1, output);
+        AppendData(output, area_flags, sizeof(area_flags));
 
     // Store height data
-    fwrite(&heightHeader, sizeof(heightHeader), 1, output);
+    AppendData(output, &heightHeader, sizeof(heightHeader));
     if (!(heightHeader.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if (heightHeader.flags & MAP_HEIGHT_AS_INT16)
         {
-            fwrite(uint16_V9, sizeof(uint16_V9), 1, output);
-            fwrite(uint16_V8, sizeof(uint16_V8), 1, output);
+            AppendData(output, uint16_V9, sizeof(uint16_V9));
+            AppendData(output, uint16_V8, sizeof(uint16_V8));
         }
         else if (heightHeader.flags & MAP_HEIGHT_AS_INT8)
         {
-            fwrite(uint8_V9, sizeof(uint8_V9), 1, output);
-            fwrite(uint8_V8, sizeof(uint8_V8), 1, output);
+            AppendData(output, uint8_V9, sizeof(uint8_V9));
+            AppendData(output, uint8_V8, sizeof(uint8_V8));
         }
         else
         {
-            fwrite(V9, sizeof(V9), 1, output);
-            fwrite(V8, sizeof(V8), 1, output);
+            AppendData(output, V9, sizeof(V9));
+            AppendData(output, V8, sizeof(V8));
         }
     }
 
     // Store liquid data if need
     if (map.liquidMapOffset)
     {
-        fwrite(&liquidHeader, sizeof(liquidHeader), 1, output);
+        AppendData(output, &liquidHeader, sizeof(liquidHeader));
         if (!(liquidHeader.flags & MAP_LIQUID_NO_TYPE))
         {
-            fwrite(liquid_entry, sizeof(liquid_entry), 1, output);
-            fwrite(liquid_flags, sizeof(liquid_flags), 1, output);
+            AppendData(output, liquid_entry, sizeof(liquid_entry));
+            AppendData(output, liquid_flags, sizeof(liquid_flags));
         }
         if (!(liquidHeader.flags & MAP_LIQUID_NO_HEIGHT))
         {
             for (int y = 0; y < liquidHeader.height; y++)
-                fwrite(&liquid_height[y + liquidHeader.offsetY][liquidHeader.offsetX], sizeof(float), liquidHeader.width, output);
+                AppendData(output, &liquid_height[y + liquidHeader.offsetY][liquidHeader.offsetX], sizeof(float) * liquidHeader.width);
         }
     }
 
     // store hole data
-    fwrite(holes, map.holesSize, 1, output);
+    AppendData(output, holes, map.holesSize);
 
-    fclose(output);
-
-    return true;
+    return WriteFileIfChanged(filename2, output);
 }
 
 void ExtractMapsFromMpq()
 {
-    char mpq_filename[1024];
-    char output_filename[1024];
     char mpq_map_name[1024];
 
     printf("Extracting maps...\n");
@@ -843,7 +887,8 @@ void ExtractMapsFromMpq()
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    uint32 threads = CONF_threads ? CONF_threads : std::max(1u, std::thread::hardware_concurrency());
+    printf("Convert map files using %u threads\n", threads);
     for (uint32 z = 0; z < map_count; ++z)
     {
         printf("Extract %s (%d/%d)                  \n", map_ids[z].name, z + 1, map_count);
@@ -856,20 +901,38 @@ void ExtractMapsFromMpq()
             continue;
         }
 
+        std::vector<std::pair<uint32, uint32>> tiles;
         for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
-        {
             for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
+                if (wdt.main->adt_list[y][x].exist)
+                    tiles.emplace_back(y, x);
+
+        // tiles of one map are independent, MPQ reads are serialized inside MPQFile
+        std::atomic<size_t> nextTile(0);
+        auto worker = [&]()
+        {
+            char mpq_filename[1024];
+            char output_filename[1024];
+            for (size_t i = nextTile++; i < tiles.size(); i = nextTile++)
             {
-                if (!wdt.main->adt_list[y][x].exist)
-                    continue;
+                uint32 y = tiles[i].first;
+                uint32 x = tiles[i].second;
                 sprintf(mpq_filename, "World\\Maps\\%s\\%s_%u_%u.adt", map_ids[z].name, map_ids[z].name, x, y);
                 sprintf(output_filename, "%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
                 ConvertADT(mpq_filename, output_filename, y, x);
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
-        }
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < std::min<size_t>(threads, tiles.size()); ++i)
+            workers.emplace_back(worker);
+        worker();
+        for (std::thread& thread : workers)
+            thread.join();
     }
+
+    if (unchangedMapFiles)
+        printf("%u map files were already up to date\n", unchangedMapFiles.load());
     delete [] areas;
     delete [] map_ids;
 }
@@ -27,7 +27,7 @@
 
 #include <climits>
 #include <fstream>
-#include <future>
+#include <zlib.h>
 
 using namespace VMAP;
 
@@ -73,14 +73,17 @@ namespace MMAP
     }
 
     MapBuilder::MapBuilder(const char* configInputPath, int threads, bool skipLiquid, bool skipContinents, bool skipJunkMaps,
-                           bool skipBattlegrounds, bool debug, const char* offMeshFilePath, const char* workdir) :
-        m_taskQueue(new TaskQueue(this, threads)),
+                           bool skipBattlegrounds, bool debug, const char* offMeshFilePath, const char* workdir, bool compressTiles) :
+        m_taskQueue(new TaskQueue(threads)),
         m_debug(debug),
+        m_skipLiquid(skipLiquid),
+        m_compressTiles(compressTiles),
         m_skipContinents(skipContinents),
         m_skipJunkMaps(skipJunkMaps),
         m_skipBattlegrounds(skipBattlegrounds),
         m_offMeshFilePath(offMeshFilePath),
-        m_workdir(workdir)
+        m_workdir(workdir),
+        m_tileInputHashFile(nullptr)
     {
         std::ifstream jsonConfig(configInputPath);
         if (jsonConfig)
@@ -91,6 +94,7 @@ namespace MMAP
 
         printf("Using %d thread(s) for processing.\n", threads);
         discoverTiles();
+        loadTileInputHashes();
     }
 
     /**************************************************************************/
@@ -104,6 +108,9 @@ namespace MMAP
 
         delete m_terrainBuilder;
         delete m_rcContext;
+
+        if (m_tileInputHashFile)
+            fclose(m_tileInputHashFile);
     }
 
     /**************************************************************************/
@@ -117,7 +124,7 @@ namespace MMAP
                 if (!shouldSkipMap(mapID))
                     buildMap(mapID);
 
-                m_mapDone.insert(mapID);
+                m_taskQueue->SetMapDone(mapID);
             }
         }
         else
@@ -127,7 +134,7 @@ namespace MMAP
                 if (!shouldSkipMap(mapId))
                     buildMap(mapId);
 
-                m_mapDone.insert(mapId);
+                m_taskQueue->SetMapDone(mapId);
             }
         }
 
@@ -216,13 +223,6 @@ namespace MMAP
         return tiles;
     }
 
-    /**************************************************************************/
-    bool MapBuilder::IsMapDone(uint32 mapId) const
-    {
-        auto itr = std::find(m_mapDone.begin(), m_mapDone.end(), mapId);
-        return itr != m_mapDone.end();
-    }
-
     /**************************************************************************/
     void MapBuilder::buildGameObject(std::string modelName, uint32 displayId)
     {
@@ -534,7 +534,7 @@ namespace MMAP
             return;
         }
 
-        buildTile(mapID, tileX, tileY, navMesh, 1, 1);
+        buildTile(mapID, tileX, tileY, navMesh, 1, 1, getTileInputHash(mapID, tileX, tileY));
         dtFreeNavMesh(navMesh);
     }
 
@@ -582,9 +582,6 @@ namespace MMAP
             // unpack tile coords
             StaticMapTree::unpackTileID((*it), tileX, tileY);
 
-            if (shouldSkipTile(mapID, tileX, tileY))
-                continue;
-
             // Make a copy of the original navMesh object to work on a separate
             // thread since "the data should not be reused in other nav meshes"
             // (see dtNavMesh::addTile description)
@@ -600,8 +597,12 @@ namespace MMAP
             // passing by value
             auto builder = [=]()
             {
+                // hashing reads all input files of the tile, done by the worker
+                uint64 inputHash = getTileInputHash(mapID, tileX, tileY);
+
                 // build tile with copy version of the navmesh
-                buildTile(mapID, tileX, tileY, navMeshCopy, currentTile, uint32(tiles->size()));
+                if (!shouldSkipTile(mapID, tileX, tileY, inputHash))
+                    buildTile(mapID, tileX, tileY, navMeshCopy, currentTile, uint32(tiles->size()), inputHash);
 
                 // free this navmesh
                 dtFreeNavMesh(navMeshCopy);
@@ -614,7 +615,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount)
+    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount, uint64 inputHash)
     {
         printf("[Map %03i] Building tile [%02u,%02u] (%02u / %02u)    \n", mapID, tileX, tileY, curTile, tileCount);
 
@@ -649,7 +650,7 @@ namespace MMAP
         m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, inputHash);
     }
 
     /**************************************************************************/
@@ -732,7 +733,7 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                       MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+                                      dtNavMesh* navMesh, uint64 inputHash)
     {
         // console output
         char tileString[20];
@@ -968,12 +969,36 @@ namespace MMAP
             MmapTileHeader header;
             header.size = uint32(navDataSize);
             header.usesLiquids = m_terrainBuilder->usesLiquids() ? 1 : 0;
+
+            std::vector<Bytef> compressed;
+            if (m_compressTiles)
+            {
+                uLongf compressedSize = compressBound(navDataSize);
+                compressed.resize(compressedSize);
+                if (compress2(compressed.data(), &compressedSize, navData, navDataSize, Z_BEST_COMPRESSION) == Z_OK)
+                {
+                    header.mmapMagic = MMAP_COMPRESSED_MAGIC;
+                    compressed.resize(compressedSize);
+                }
+                else
+                    compressed.clear();                     // written uncompressed
+            }
+
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
             // write data
-            fwrite(navData, sizeof(unsigned char), navDataSize, file);
+            if (header.mmapMagic == MMAP_COMPRESSED_MAGIC)
+            {
+                uint32 compressedSize = uint32(compressed.size());
+                fwrite(&compressedSize, sizeof(uint32), 1, file);
+                fwrite(compressed.data(), sizeof(Bytef), compressed.size(), file);
+            }
+            else
+                fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
+            storeTileInputHash(mapID, tileX, tileY, inputHash);
+
             // now that tile is written to disk, we can unload it
             navMesh->removeTile(tileRef, nullptr, nullptr);
         }
@@ -1172,8 +1197,16 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY)
+    bool MapBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash)
     {
+        {
+            std::lock_guard<std::mutex> guard(m_tileInputHashLock);
+            auto itr = m_tileInputHashes.find(uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY));
+            if (itr == m_tileInputHashes.end() || itr->second != inputHash)
+                return false;
+        }
+
+
         char fileName[255];
         sprintf(fileName, "%s/mmaps/%03u%02i%02i.mmtile", m_workdir, mapID, tileY, tileX);
         FILE* file = fopen(fileName, "rb");
@@ -1186,7 +1219,7 @@ namespace MMAP
         if (count != 1)
             return false;
 
-        if (header.mmapMagic != MMAP_MAGIC || header.dtVersion != uint32(DT_NAVMESH_VERSION))
+        if ((header.mmapMagic != MMAP_MAGIC && header.mmapMagic != MMAP_COMPRESSED_MAGIC) || header.dtVersion != uint32(DT_NAVMESH_VERSION))
             return false;
 
         if (header.mmapVersion != MMAP_VERSION)
@@ -1195,6 +1228,97 @@ namespace MMAP
         return true;
     }
 
+    /**************************************************************************/
+    static void hashAppend(uint64& hash, const void* data, size_t size)
+    {
+        // FNV-1a
+        const uint8* bytes = static_cast<const uint8*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    static void hashAppendFile(uint64& hash, const char* fileName)
+    {
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+        {
+            hashAppend(hash, "-", 1);                       // missing files count as well
+            return;
+        }
+
+        uint8 buffer[64 * 1024];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hashAppend(hash, buffer, read);
+        fclose(file);
+    }
+
+    /**************************************************************************/
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY)
+    {
+        uint64 hash = 14695981039346656037ULL;
+
+        uint32 versions[] = { MMAP_VERSION, uint32(DT_NAVMESH_VERSION), m_skipLiquid ? 1u : 0u, m_compressTiles ? 1u : 0u };
+        hashAppend(hash, versions, sizeof(versions));
+
+        std::string config = getTileConfig(mapID, tileX, tileY).dump();
+        hashAppend(hash, config.c_str(), config.size());
+
+        // terrain of the tile and the borders of its neighbours, see TerrainBuilder::loadMap
+        char fileName[1024];
+        int const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (auto const& neighbour : neighbours)
+        {
+            sprintf(fileName, "%s/maps/%03u%02u%02u.map", m_workdir, mapID, tileY + neighbour[1], tileX + neighbour[0]);
+            hashAppendFile(hash, fileName);
+        }
+
+        // model spawns, the model files themselves are not hashed
+        sprintf(fileName, "%s/vmaps/%03u.vmtree", m_workdir, mapID);
+        hashAppendFile(hash, fileName);
+        sprintf(fileName, "%s/vmaps/%03u_%02u_%02u.vmtile", m_workdir, mapID, tileX, tileY);
+        hashAppendFile(hash, fileName);
+
+        if (m_offMeshFilePath)
+            hashAppendFile(hash, m_offMeshFilePath);
+
+        return hash;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::loadTileInputHashes()
+    {
+        char fileName[1024];
+        sprintf(fileName, "%s/mmaps/tile_hashes", m_workdir);
+
+        // one line per written tile, a later line replaces an earlier one of the same tile
+        if (FILE* file = fopen(fileName, "r"))
+        {
+            uint32 mapID, tileX, tileY;
+            unsigned long long hash;
+            while (fscanf(file, "%u %u %u %llx", &mapID, &tileX, &tileY, &hash) == 4)
+                m_tileInputHashes[uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY)] = hash;
+            fclose(file);
+        }
+
+        m_tileInputHashFile = fopen(fileName, "a");
+        if (!m_tileInputHashFile)
+            printf("Failed to open %s, the next build will build all tiles again\n", fileName);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::storeTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash)
+    {
+        std::lock_guard<std::mutex> guard(m_tileInputHashLock);
+        m_tileInputHashes[uint64(mapID) << 32 | StaticMapTree::packTileID(tileX, tileY)] = inputHash;
+        if (m_tileInputHashFile)
+        {
+            // flushed for every tile so an interrupted build resumes with all tiles written
+            fprintf(m_tileInputHashFile, "%u %u %u %016llx\n", mapID, tileX, tileY, (unsigned long long)inputHash);
+            fflush(m_tileInputHashFile);
+        }
+    }
+
     json MapBuilder::getDefaultConfig()
     {
         return {
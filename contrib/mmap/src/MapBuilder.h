@@ -22,8 +22,12 @@
 #include <vector>
 #include <set>
 #include <map>
-#include <future>
 #include <sstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 
 #include "TerrainBuilder.h"
 #include "IntermediateValues.h"
@@ -90,7 +94,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debug               = false,
                        const char* offMeshFilePath = NULL,
-                       const char* workdir = NULL);
+                       const char* workdir = NULL,
+                       bool compressTiles = false);
 
             ~MapBuilder();
 
@@ -104,8 +109,6 @@ namespace MMAP
             void buildGameObject(std::string modelName, uint32 displayId);
             void buildTransports();
 
-            bool IsMapDone(uint32 mapId) const;
-
         private:
             // builds all mmap tiles for the specified map id (ignores skip settings)
             void buildMap(uint32 mapID);
@@ -116,18 +119,23 @@ namespace MMAP
 
             void buildNavMesh(uint32 mapID, dtNavMesh*& navMesh);
 
-            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount);
+            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh, uint32 curTile, uint32 tileCount, uint64 inputHash);
             bool buildCommonTile(const char* tileString, Tile& tile, rcConfig& tileCfg, float* tVerts, int tVertCount, int* tTris, int tTriCount, float* lVerts, int lVertCount,
                                  int* lTris, int lTriCount, uint8* lTriFlags);
 
             // move map building
-            void buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY, MeshData& meshData, float bmin[3], float bmax[3], dtNavMesh* navMesh);
+            void buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY, MeshData& meshData, float bmin[3], float bmax[3], dtNavMesh* navMesh, uint64 inputHash);
             void getTileBounds(uint32 tileX, uint32 tileY, float* verts, int vertCount, float* bmin, float* bmax);
             void getGridBounds(uint32 mapID, uint32& minX, uint32& minY, uint32& maxX, uint32& maxY);
 
             bool shouldSkipMap(uint32 mapID);
             bool isTransportMap(uint32 mapID);
-            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY);
+            bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash);
+
+            // resumable builds, a tile is built again only when the files it is built from changed
+            uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY);
+            void loadTileInputHashes();
+            void storeTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash);
 
             json getDefaultConfig();
             json getMapIdConfig(uint32 mapId);
@@ -137,6 +145,8 @@ namespace MMAP
             TileList m_tiles;
 
             bool m_debug;
+            bool m_skipLiquid;
+            bool m_compressTiles;
 
             const char* m_offMeshFilePath;
             const char* m_workdir;
@@ -152,102 +162,122 @@ namespace MMAP
             // Task queue that will handle all worker
             TaskQueueUPtr m_taskQueue;
 
-            // used to know wich map have launched all its tile work
-            MapSet m_mapDone;
+            // input hash of every tile written, by map id << 32 | packed tile id
+            std::map<uint64, uint64> m_tileInputHashes;
+            std::mutex m_tileInputHashLock;
+            FILE* m_tileInputHashFile;
     };
 
-    // Task queue : not thread safe (do not add worker asynchronously)
+    // Fixed pool of worker threads building tiles of any map from one shared queue
+    // Work must be added from a single thread
     class TaskQueue
     {
         private:
-            typedef std::pair<uint32, std::future<void>> TaskType;
-            typedef std::vector<TaskType> TaskVec;
+            typedef std::pair<uint32, std::function<void()>> TaskType;
 
         public:
-            TaskQueue(MapBuilder* mapBuilder, uint32 maxSize)
-                : m_mapBuilder(mapBuilder), m_maxSize(maxSize) {
-                m_taskList.reserve(maxSize);
+            TaskQueue(uint32 threads) : m_maxQueued(threads * 2), m_stop(false)
+            {
+                for (uint32 i = 0; i < threads; ++i)
+                    m_threads.emplace_back(&TaskQueue::WorkerThread, this);
             }
             TaskQueue() = delete;
             TaskQueue(TaskQueue const&) = delete;
 
-            // Add worker to the queue and block until at least there is one thread free
-            template<typename T>
-            void PushWork(T&& work, uint32 mapId)
+            ~TaskQueue()
             {
-                m_taskList.emplace_back(mapId, std::async(std::launch::async, work));
-                while (m_taskList.size() == m_maxSize)
                 {
-                    RemoveFinishedTask();
-
-                    // allow other thread to run
-                    std::this_thread::yield();
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    m_stop = true;
                 }
+                m_workReady.notify_all();
+                for (auto& thread : m_threads)
+                    thread.join();
+            }
+
+            // Add work to the queue, blocks while enough work is waiting for a free thread
+            void PushWork(std::function<void()> work, uint32 mapId)
+            {
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_workDone.wait(lock, [&]() { return m_queue.size() < m_maxQueued; });
+                m_queue.emplace_back(mapId, std::move(work));
+                ++m_pendingByMap[mapId];
+                lock.unlock();
+                m_workReady.notify_one();
+            }
+
+            // All work of the map was added
+            void SetMapDone(uint32 mapId)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_mapsDone.insert(mapId);
+                ReportMapDone(mapId);
             }
 
             // wait all worker to finish
             void WaitAll()
             {
-                while (!m_taskList.empty())
-                    RemoveFinishedTask();
+                std::unique_lock<std::mutex> lock(m_lock);
+                m_workDone.wait(lock, [&]() { return m_pendingByMap.empty(); });
             }
 
         private:
-            // Try to remove a finished worker from the queue
-            void RemoveFinishedTask()
+            void WorkerThread()
             {
-                for (TaskVec::iterator fItr = m_taskList.begin(); fItr != m_taskList.end();)
+                std::unique_lock<std::mutex> lock(m_lock);
+                while (true)
                 {
-                    std::future_status status = fItr->second.wait_for(std::chrono::seconds(0));
-                    if (status == std::future_status::ready)
+                    m_workReady.wait(lock, [&]() { return m_stop || !m_queue.empty(); });
+                    if (m_queue.empty())
+                        return;
+
+                    TaskType task = std::move(m_queue.front());
+                    m_queue.pop_front();
+                    m_workDone.notify_all();                // room in the queue
+
+                    lock.unlock();
+                    task.second();
+                    lock.lock();
+
+                    auto pending = m_pendingByMap.find(task.first);
+                    if (!--pending->second)
                     {
-                        // take a copy of current finished job work map id before deleting this iterator
-                        uint32 justDeletedMapId = fItr->first;
-
-                        fItr->second.get();
-                        fItr = m_taskList.erase(fItr);
-
-                        // check if map is done (all tile jobs should be in the queue if any remain)
-                        if (m_mapBuilder->IsMapDone(justDeletedMapId))
-                        {
-                            MapSet onGoingMap;
-                            // search if there is remaining work to do 
-                            bool foundWork = false;
-                            for (auto& itr : m_taskList)
-                            {
-                                if (itr.first == justDeletedMapId)
-                                {
-                                    foundWork = true;
-                                    break;
-                                }
-                                onGoingMap.insert(itr.first);
-                            }
-
-                            if (!foundWork)
-                            {
-                                std::stringstream ss;
-                                ss << "Map [" << justDeletedMapId << "] is done!";
-                                if (onGoingMap.empty())
-                                    ss << "                             \n"; // should delete some remaining char in the line
-                                else
-                                {
-                                    ss << " Still ongoing:";
-                                    for (auto mId : onGoingMap)
-                                        ss << " [" << mId << "]";
-                                    ss << "                              ";
-                                }
-                                printf("%s\n", ss.str().c_str());
-                            }
-                        }
+                        m_pendingByMap.erase(pending);
+                        ReportMapDone(task.first);
                     }
-                    else
-                        ++fItr;
+                    m_workDone.notify_all();
                 }
-            };
+            }
+
+            // m_lock held
+            void ReportMapDone(uint32 mapId)
+            {
+                if (m_mapsDone.find(mapId) == m_mapsDone.end() || m_pendingByMap.find(mapId) != m_pendingByMap.end())
+                    return;
+
+                std::stringstream ss;
+                ss << "Map [" << mapId << "] is done!";
+                if (m_pendingByMap.empty())
+                    ss << "                             \n"; // should delete some remaining char in the line
+                else
+                {
+                    ss << " Still ongoing:";
+                    for (auto& pending : m_pendingByMap)
+                        ss << " [" << pending.first << "]";
+                    ss << "                              ";
+                }
+                printf("%s\n", ss.str().c_str());
+            }
 
-            MapBuilder* m_mapBuilder;       // needed for MapNuilder::IsMapDone
-            uint32 m_maxSize;               // max thread usable
-            TaskVec m_taskList;             // task queue in a vector
+            uint32 m_maxQueued;                             // work waiting for a thread, bounds the navmesh copies alive
+            bool m_stop;
+            std::mutex m_lock;
+            std::condition_variable m_workReady;
+            std::condition_variable m_workDone;
+            std::deque<TaskType> m_queue;
+            std::map<uint32, uint32> m_pendingByMap;        // queued and running work by map id
+            MapSet m_mapsDone;                              // maps with all their work added
+            std::vector<std::thread> m_threads;
     };
 }
 
@@ -85,6 +85,7 @@ void printUsage()
     printf("--buildGameObjects : builds only gameobject models for transports\n\n");
     printf("--threads [#]: specifies number of threads to use for maps processing\n\n");
     printf("--workdir [directory] : Path to basedir of maps/vmaps.\n\n");
+    printf("--compressTiles : write zlib compressed map tiles, smaller on disk, decompressed by the server at load\n\n");
     printf("Example:\nmovemapgen (generate all mmap with default arg\n"
            "movemapgen \"1 0 169\" (generate maps 1, 0 and 169)\n"
            "movemapgen 0 --tile 34,46 (builds only tile 34,46 of map 0)\n\n");
@@ -105,7 +106,8 @@ bool handleArgs(int argc, char** argv,
                 char*& offMeshInputPath,
                 char*& configInputPath,
                 int& threads,
-                char*& workdir)
+                char*& workdir,
+                bool& compressTiles)
 {
     char* param = NULL;
     workdir = "./";
@@ -163,6 +165,10 @@ bool handleArgs(int argc, char** argv,
         {
             buildGameObjects = true;
         }
+        else if (strcmp(argv[i], "--compressTiles") == 0)
+        {
+            compressTiles = true;
+        }
         else if (strcmp(argv[i], "--offMeshInput") == 0 && i + 1 < argc)
         {
             param = argv[++i];
@@ -246,6 +252,7 @@ int main(int argc, char** argv)
     bool debug = false;
     bool silent = false;
     bool buildGameObjects = false;
+    bool compressTiles = false;
 
     char* offMeshInputPath = "offmesh.txt";
     char* configInputPath = "config.json";
@@ -253,7 +260,7 @@ int main(int argc, char** argv)
 
     bool validParam = handleArgs(argc, argv, mapIds, tileX, tileY, skipLiquid,
                                  skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debug, silent, buildGameObjects, offMeshInputPath, configInputPath, threads, workdir);
+                                 debug, silent, buildGameObjects, offMeshInputPath, configInputPath, threads, workdir, compressTiles);
 
     if (!validParam)
     {
@@ -284,7 +291,7 @@ int main(int argc, char** argv)
     if (!checkDirectories(debug, workdir))
         return -3;
 
-    MapBuilder builder(configInputPath, threads, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds, debug, offMeshInputPath, workdir);
+    MapBuilder builder(configInputPath, threads, skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds, debug, offMeshInputPath, workdir, compressTiles);
 
     if (mapIds.size() == 1 && tileX > -1 && tileY > -1)
         builder.buildSingleTile(mapIds.front(), tileX, tileY);
@@ -18,15 +18,35 @@
 
 #include <string>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
 #include "TileAssembler.h"
 
 //=======================================================
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    int threads = 0;
+    bool rebuild = false;
+    bool validArgs = argc >= 3;
+    for (int i = 3; i < argc && validArgs; ++i)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+            validArgs = threads > 0;
+        }
+        else if (strcmp(argv[i], "--rebuild") == 0)
+            rebuild = true;
+        else
+            validArgs = false;
+    }
+
+    if (!validArgs)
+    {
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> [--threads #] [--rebuild]" << std::endl;
+        std::cout << "  --threads #: number of threads converting maps and models, default one per hardware thread" << std::endl;
+        std::cout << "  --rebuild: convert all models, also the ones unchanged since the last run into <vmap dest dir>" << std::endl;
         return 1;
     }
 
@@ -36,6 +56,8 @@ int main(int argc, char* argv[])
     std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
 
     VMAP::TileAssembler tileAssembler(src, dest);
+    tileAssembler.setThreads(threads);
+    tileAssembler.setRebuild(rebuild);
 
     if (!tileAssembler.convertWorld2())
     {
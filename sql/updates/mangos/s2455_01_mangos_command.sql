@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2454_01_mangos_battleground_reflooot required_s2455_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server mapcost');
+
+INSERT INTO `command` VALUES
+('server mapcost', 3, 'Syntax: .server mapcost [#count]\r\n\r\nShow the #count (default 10) most expensive loaded maps, ordered by the moving average of their update time. Maps are dispatched to map update threads in this order.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2455_01_mangos_command required_s2456_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug opcodestats');
+
+INSERT INTO `command` VALUES
+('debug opcodestats', 3, 'Syntax: .debug opcodestats [#count|reset]\r\n\r\nShow the #count (default 10) opcode handlers with the highest total execution time, with call count and latency percentiles. reset clears the collected stats. Requires Network.OpcodeStats = 1.');
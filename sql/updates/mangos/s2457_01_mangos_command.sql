@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2456_01_mangos_command required_s2457_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug perf spellcast');
+
+INSERT INTO `command` VALUES
+('debug perf spellcast', 3, 'Syntax: .debug perf spellcast #spellid [#count]\r\n\r\nCast the spell #count times (default 100) from yourself on the selected unit or yourself, ignoring costs and cooldowns, and show the time per cast and the spells, aura holders and auras allocated per cast. Spells with travel time only count their launch.');
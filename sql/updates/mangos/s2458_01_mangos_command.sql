@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2457_01_mangos_command required_s2458_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('send mass status');
+
+INSERT INTO `command` VALUES
+('send mass status', 3, 'Syntax: .send mass status\r\n\r\nShow the queued mass mail tasks, the mails left to send and the estimated time, and the progress of streamed tasks (MassMailer.WritesPerSecond).');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2458_01_mangos_command required_s2459_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug scriptprofile');
+
+INSERT INTO `command` VALUES
+('debug scriptprofile', 3, 'Syntax: .debug scriptprofile [#count|reset]\r\n\r\nShow the #count (default 10) ScriptDevAI scripts with the highest estimated total time per map and hook (UpdateAI, JustDied, Gossip, InstanceUpdate), with sample count and latency percentiles. reset clears the collected profile. Requires ScriptProfile.SampleRate > 0.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2459_01_mangos_command required_s2460_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server zonestats');
+
+INSERT INTO `command` VALUES
+('server zonestats', 3, 'Syntax: .server zonestats [#count]\r\n\r\nShow the #count (default 10) zones with the highest estimated map update time in the last minute, split in players, objects, spells, AI and visibility, with the packets and bytes sent to players there. Requires ZoneStats.SampleRate > 0.');
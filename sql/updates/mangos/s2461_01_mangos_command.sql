@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2460_01_mangos_command required_s2461_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('server allocstats');
+
+INSERT INTO `command` VALUES
+('server allocstats', 3, 'Syntax: .server allocstats\r\n\r\nShow the bytes and number of operator new calls of the last minute split by subsystem: map update phases, database and network threads, everything else. Requires AllocStats.Enabled.');
@@ -0,0 +1,6 @@
+ALTER TABLE db_version CHANGE COLUMN required_s2461_01_mangos_command required_s2462_01_mangos_command bit;
+
+DELETE FROM command WHERE name IN ('debug trace');
+
+INSERT INTO `command` VALUES
+('debug trace', 3, 'Syntax: .debug trace [#seconds|stop]\r\n\r\nRecord the tracing zones of all threads (world update phases, map update phases, sessions, spell casts, pathfinding, line of sight, database workers, grid loading) for #seconds (default 5, at most 60) and write them as chrome trace json to trace_<time>.json in LogsDir, viewable in ui.perfetto.dev. stop ends a running capture early. Requires a build with BUILD_TRACING.');
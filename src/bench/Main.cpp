@@ -0,0 +1,460 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * mangos-bench - measures Map::Update of one map without network and without the world loop
+ *
+ * The world is loaded like mangosd does from its configuration, use a test database. The synthetic players
+ * get free guids and are never saved, they run circles through the real movement handler or melee summoned
+ * creatures. Reports tick percentiles, the time of the Map::Update phases and the operator new calls.
+ */
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Config/Config.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Util.h"
+#include "SystemConfig.h"
+#include "revision_sql.h"
+#include "World/World.h"
+#include "Maps/Map.h"
+#include "Maps/MapManager.h"
+#include "Maps/GridDefines.h"
+#include "Entities/Player.h"
+#include "Entities/Creature.h"
+#include "Server/WorldSession.h"
+#include "Server/Opcodes.h"
+#include "Globals/ObjectMgr.h"
+#include "Globals/ObjectAccessor.h"
+#include "WorldPacket.h"
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+DatabaseType WorldDatabase;                                 ///< Accessor to the world database
+DatabaseType CharacterDatabase;                             ///< Accessor to the character database
+DatabaseType LoginDatabase;                                 ///< Accessor to the realm/login database
+DatabaseType LogsDatabase;                                  ///< Accessor to the logs database
+
+uint32 realmID;                                             ///< Id of the realm
+
+#ifdef _WIN32
+int m_ServiceStatus = -1;
+#endif
+
+// every operator new of the process, the measured ticks take the difference
+static std::atomic<uint64> s_allocCount(0);
+static std::atomic<uint64> s_allocBytes(0);
+
+void* operator new(std::size_t size)
+{
+    s_allocCount.fetch_add(1, std::memory_order_relaxed);
+    s_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct BenchOptions
+{
+    std::string configFile;
+    uint32 mapId;
+    float x, y, z;
+    float spread;
+    uint32 players;
+    uint32 level;
+    uint32 fighterPercent;
+    uint32 targetEntry;
+    uint32 targetHealth;
+    uint32 moveInterval;
+    uint32 ticks;
+    uint32 warmupTicks;
+    uint32 diff;
+};
+
+struct BenchPlayer
+{
+    Player* player;
+    float centerX, centerY, radius, angle;
+    uint32 moveTimer;
+    bool fighter;
+    ObjectGuid target;
+};
+
+static bool StartDB(DatabaseType& database, char const* infoKey, char const* connectionsKey)
+{
+    std::string dbstring = sConfig.GetStringDefault(infoKey);
+    if (dbstring.empty())
+    {
+        sLog.outError("%s not specified in configuration file", infoKey);
+        return false;
+    }
+
+    if (!database.Initialize(dbstring.c_str(), sConfig.GetIntDefault(connectionsKey, 1)))
+    {
+        sLog.outError("Cannot connect to database %s", dbstring.c_str());
+        return false;
+    }
+    return true;
+}
+
+static void StopDB()
+{
+    CharacterDatabase.HaltDelayThread();
+    WorldDatabase.HaltDelayThread();
+    LoginDatabase.HaltDelayThread();
+    LogsDatabase.HaltDelayThread();
+}
+
+static Player* CreatePlayer(BenchOptions const& options, uint32 index, Map*& map)
+{
+    // alliance and horde warriors, both can be created by every database
+    uint8 race = index % 2 ? RACE_ORC : RACE_HUMAN;
+
+    WorldSession* session = new WorldSession(0, nullptr, SEC_PLAYER, MAX_EXPANSION, 0, DEFAULT_LOCALE, "bench", 0, 0, false);
+    session->SetNoAnticheat();
+
+    Player* player = new Player(session);
+    if (!player->Create(sObjectMgr.GeneratePlayerLowGuid(), "Bench" + std::to_string(index), race, CLASS_WARRIOR, GENDER_MALE, 0, 0, 0, 0, 0, 0))
+    {
+        delete player;
+        delete session;
+        return nullptr;
+    }
+    session->SetPlayer(player, player->GetGUIDLow());
+    player->SetSaveTimer(0);                                // never saved
+
+    if (options.level > 1)
+        player->GiveLevel(options.level);
+
+    // spread out around the given position, on the ground when the map knows it
+    float angle = rand_norm_f() * 2 * M_PI_F;
+    float distance = rand_norm_f() * options.spread;
+    float x = options.x + distance * cos(angle);
+    float y = options.y + distance * sin(angle);
+
+    // Create placed the player on the start map of its race
+    player->ResetMap();
+    player->Relocate(x, y, options.z, angle);
+
+    // a dungeon is created for the first player, the others join it
+    if (!map)
+        map = sMapMgr.CreateMap(options.mapId, player);
+    if (!map)
+    {
+        sLog.outError("Cannot create map %u", options.mapId);
+        session->SetPlayer(nullptr, 0);
+        delete player;
+        delete session;
+        return nullptr;
+    }
+
+    float groundZ = map->GetHeight(x, y, options.z + 5.0f);
+    if (groundZ > INVALID_HEIGHT)
+        player->Relocate(x, y, groundZ, angle);
+
+    player->SetMap(map);
+    if (!map->Add(player))
+    {
+        sLog.outError("Map %u refused player %u (instance full?)", options.mapId, index);
+        player->ResetMap();
+        session->SetPlayer(nullptr, 0);
+        delete player;
+        delete session;
+        return nullptr;
+    }
+
+    sObjectAccessor.AddObject(player);
+    player->SetInGameTime(WorldTimer::getMSTime());
+    return player;
+}
+
+static void RemovePlayer(BenchPlayer& benchPlayer)
+{
+    Player* player = benchPlayer.player;
+    WorldSession* session = player->GetSession();
+    player->GetMap()->Remove(player, true);
+    session->SetPlayer(nullptr, 0);
+    delete session;
+}
+
+// sends the heartbeat a client running a circle would send, through the handler of real clients
+static void MovePlayer(BenchPlayer& benchPlayer, BenchOptions const& options)
+{
+    if (benchPlayer.moveTimer > options.diff)
+    {
+        benchPlayer.moveTimer -= options.diff;
+        return;
+    }
+
+    Player* player = benchPlayer.player;
+    float elapsed = float(options.moveInterval - benchPlayer.moveTimer + options.diff) / IN_MILLISECONDS;
+    benchPlayer.moveTimer = options.moveInterval;
+    benchPlayer.angle += player->GetSpeed(MOVE_RUN) * elapsed / benchPlayer.radius;
+
+    float x = benchPlayer.centerX + benchPlayer.radius * cos(benchPlayer.angle);
+    float y = benchPlayer.centerY + benchPlayer.radius * sin(benchPlayer.angle);
+    float z = player->GetMap()->GetHeight(x, y, player->GetPositionZ() + 5.0f);
+    if (z <= INVALID_HEIGHT)
+        z = player->GetPositionZ();
+
+    MovementInfo movementInfo = player->m_movementInfo;
+    movementInfo.SetMovementFlags(MOVEFLAG_FORWARD);
+    movementInfo.ChangePosition(x, y, z, MapManager::NormalizeOrientation(benchPlayer.angle + M_PI_F / 2));
+
+    WorldPacket data(MSG_MOVE_HEARTBEAT, 64);
+    data << movementInfo;
+    player->GetSession()->HandleMovementOpcodes(data);
+}
+
+// keeps the player in melee with a summoned creature, a new one replaces the killed one
+static void FightPlayer(BenchPlayer& benchPlayer, BenchOptions const& options)
+{
+    Player* player = benchPlayer.player;
+    if (!player->IsAlive())
+    {
+        player->ResurrectPlayer(1.0f);
+        player->SpawnCorpseBones();
+        return;
+    }
+
+    Creature* target = player->GetMap()->GetCreature(benchPlayer.target);
+    if (!target || !target->IsAlive())
+    {
+        float x, y, z;
+        player->GetClosePoint(x, y, z, player->GetObjectBoundingRadius(), 2.0f, player->GetOrientation());
+        target = player->SummonCreature(options.targetEntry, x, y, z, 0.0f, TEMPSPAWN_TIMED_OOC_OR_DEAD_DESPAWN, 10 * IN_MILLISECONDS, false, false, 0, 14);
+        if (!target)
+            return;
+
+        target->SetMaxHealth(options.targetHealth);
+        target->SetHealth(options.targetHealth);
+        benchPlayer.target = target->GetObjectGuid();
+    }
+
+    if (player->GetVictim() != target)
+        player->Attack(target, true);
+}
+
+static double Percentile(std::vector<uint64> const& sorted, double percent)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t index = std::min(sorted.size() - 1, size_t(percent / 100.0 * sorted.size()));
+    return sorted[index] / 1000.0;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("config,c", boost::program_options::value<std::string>(&options.configFile)->default_value(_MANGOSD_CONFIG), "configuration file")
+    ("map,m", boost::program_options::value<uint32>(&options.mapId)->default_value(530), "map id, dungeons get a new instance")
+    ("x", boost::program_options::value<float>(&options.x)->default_value(-1850.21f), "center of the players")
+    ("y", boost::program_options::value<float>(&options.y)->default_value(5435.82f), "center of the players")
+    ("z", boost::program_options::value<float>(&options.z)->default_value(-10.96f), "center of the players")
+    ("spread,s", boost::program_options::value<float>(&options.spread)->default_value(60.0f), "radius the players are spread over")
+    ("players,p", boost::program_options::value<uint32>(&options.players)->default_value(100), "number of players")
+    ("level,l", boost::program_options::value<uint32>(&options.level)->default_value(70), "level of the players")
+    ("fighters,f", boost::program_options::value<uint32>(&options.fighterPercent)->default_value(50), "percent of the players in melee, the others move")
+    ("target-entry", boost::program_options::value<uint32>(&options.targetEntry)->default_value(6), "creature entry the fighters attack, made hostile")
+    ("target-health", boost::program_options::value<uint32>(&options.targetHealth)->default_value(100000), "health of the attacked creatures")
+    ("move-interval", boost::program_options::value<uint32>(&options.moveInterval)->default_value(500), "ms between the heartbeats of a moving player")
+    ("ticks,t", boost::program_options::value<uint32>(&options.ticks)->default_value(1000), "measured ticks")
+    ("warmup,w", boost::program_options::value<uint32>(&options.warmupTicks)->default_value(100), "ticks run before measuring")
+    ("diff,d", boost::program_options::value<uint32>(&options.diff)->default_value(50), "ms passed to Map::Update per tick")
+    ("help,h", "prints usage");
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+    }
+    catch (boost::program_options::error const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if (!options.players || !options.ticks || !options.diff || !options.moveInterval)
+    {
+        std::cerr << "ERROR: players, ticks, diff and move-interval must be > 0" << std::endl;
+        return 1;
+    }
+
+    if (!sConfig.SetSource(options.configFile))
+    {
+        sLog.outError("Could not find configuration file %s.", options.configFile.c_str());
+        return 1;
+    }
+
+    realmID = sConfig.GetIntDefault("RealmID", 0);
+
+    if (!StartDB(WorldDatabase, "WorldDatabaseInfo", "WorldDatabaseConnections") ||
+        !StartDB(CharacterDatabase, "CharacterDatabaseInfo", "CharacterDatabaseConnections") ||
+        !StartDB(LoginDatabase, "LoginDatabaseInfo", "LoginDatabaseConnections") ||
+        !StartDB(LogsDatabase, "LogsDatabaseInfo", "LogsDatabaseConnections"))
+    {
+        StopDB();
+        return 1;
+    }
+
+    if (!WorldDatabase.CheckRequiredField("db_version", REVISION_DB_MANGOS) ||
+        !CharacterDatabase.CheckRequiredField("character_db_version", REVISION_DB_CHARACTERS))
+    {
+        StopDB();
+        return 1;
+    }
+
+    sWorld.SetInitialWorldSettings();
+
+    CharacterDatabase.AllowAsyncTransactions();
+    WorldDatabase.AllowAsyncTransactions();
+    LoginDatabase.AllowAsyncTransactions();
+    LogsDatabase.AllowAsyncTransactions();
+
+    WorldTimer::tick();
+    World::UpdateClocks(0);
+
+    Map* map = nullptr;
+    std::vector<BenchPlayer> players;
+    players.reserve(options.players);
+    for (uint32 i = 0; i < options.players; ++i)
+    {
+        Player* player = CreatePlayer(options, i, map);
+        if (!player)
+            continue;
+
+        BenchPlayer benchPlayer;
+        benchPlayer.player = player;
+        benchPlayer.radius = 5.0f + rand_norm_f() * 15.0f;
+        benchPlayer.angle = rand_norm_f() * 2 * M_PI_F;
+        benchPlayer.centerX = player->GetPositionX() - benchPlayer.radius * cos(benchPlayer.angle);
+        benchPlayer.centerY = player->GetPositionY() - benchPlayer.radius * sin(benchPlayer.angle);
+        benchPlayer.moveTimer = urand(0, options.moveInterval);
+        benchPlayer.fighter = options.targetEntry && i * 100 < options.fighterPercent * options.players;
+        players.push_back(benchPlayer);
+    }
+
+    if (!map || players.empty())
+    {
+        sLog.outError("No player could be added to map %u", options.mapId);
+        StopDB();
+        return 1;
+    }
+
+    MapUpdatePhaseTimes phaseTimes;
+    std::vector<uint64> tickTimes;
+    tickTimes.reserve(options.ticks);
+    uint64 inputTime = 0;
+    uint64 allocCount = 0, allocBytes = 0;
+
+    for (uint32 tick = 0; tick < options.warmupTicks + options.ticks; ++tick)
+    {
+        bool measured = tick >= options.warmupTicks;
+        if (tick == options.warmupTicks)
+            map->SetUpdatePhaseTimes(&phaseTimes);
+
+        WorldTimer::tick();
+        World::UpdateClocks(options.diff);
+
+        auto inputStart = std::chrono::steady_clock::now();
+        for (auto& benchPlayer : players)
+        {
+            if (benchPlayer.fighter)
+                FightPlayer(benchPlayer, options);
+            else
+                MovePlayer(benchPlayer, options);
+        }
+
+        uint64 allocCountStart = s_allocCount.load(std::memory_order_relaxed);
+        uint64 allocBytesStart = s_allocBytes.load(std::memory_order_relaxed);
+        auto updateStart = std::chrono::steady_clock::now();
+
+        map->Update(options.diff);
+
+        auto updateEnd = std::chrono::steady_clock::now();
+        if (measured)
+        {
+            inputTime += std::chrono::duration_cast<std::chrono::microseconds>(updateStart - inputStart).count();
+            tickTimes.push_back(std::chrono::duration_cast<std::chrono::microseconds>(updateEnd - updateStart).count());
+            allocCount += s_allocCount.load(std::memory_order_relaxed) - allocCountStart;
+            allocBytes += s_allocBytes.load(std::memory_order_relaxed) - allocBytesStart;
+        }
+    }
+
+    map->SetUpdatePhaseTimes(nullptr);
+
+    // results
+    uint64 total = 0;
+    for (uint64 time : tickTimes)
+        total += time;
+    std::vector<uint64> sorted(tickTimes);
+    std::sort(sorted.begin(), sorted.end());
+    double ticks = double(tickTimes.size());
+
+    printf("\nmap %u instance %u, %u players (%u fighting), %u ticks of %u ms after %u warmup ticks\n",
+           map->GetId(), map->GetInstanceId(), uint32(players.size()),
+           uint32(std::count_if(players.begin(), players.end(), [](BenchPlayer const& p) { return p.fighter; })),
+           options.ticks, options.diff, options.warmupTicks);
+    printf("Map::Update ms   mean %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n",
+           total / ticks / 1000.0, Percentile(sorted, 50), Percentile(sorted, 90), Percentile(sorted, 99), sorted.back() / 1000.0);
+
+    static char const* phaseNames[MapUpdatePhaseTimes::PHASE_COUNT] = { "sessions", "players", "objects", "relocations", "SendObjectUpdates" };
+    uint64 phaseTotal = 0;
+    printf("phase ms/tick   ");
+    for (uint32 i = 0; i < MapUpdatePhaseTimes::PHASE_COUNT; ++i)
+    {
+        printf(" %s %.3f", phaseNames[i], phaseTimes.us[i] / ticks / 1000.0);
+        phaseTotal += phaseTimes.us[i];
+    }
+    printf(" other %.3f\n", (total > phaseTotal ? total - phaseTotal : 0) / ticks / 1000.0);
+    printf("input ms/tick    %.3f (movement handler and combat setup, outside Map::Update)\n", inputTime / ticks / 1000.0);
+    printf("allocations/tick %.1f (%.1f KB) by operator new during Map::Update\n", allocCount / ticks, allocBytes / ticks / 1024.0);
+
+    for (auto& benchPlayer : players)
+        RemovePlayer(benchPlayer);
+
+    sMapMgr.UnloadAll();
+    StopDB();
+    return 0;
+}
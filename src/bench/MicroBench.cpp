@@ -0,0 +1,342 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * mangos-microbench - time per call of the low level primitives of packet building and string handling
+ *
+ * Needs no configuration or database. Every benchmark runs its body until the minimum time is reached,
+ * with a growing iteration count, and reports nanoseconds per iteration.
+ */
+
+#include "Common.h"
+#include "ByteBuffer.h"
+#include "WorldPacket.h"
+#include "Util.h"
+#include "Auth/AuthCrypt.h"
+#include "Auth/BigNumber.h"
+#include "Entities/ObjectGuid.h"
+#include "Entities/UpdateMask.h"
+#include "Entities/UpdateFields.h"
+#include "Server/Opcodes.h"
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// keeps the compiler from dropping the computation of value
+template<typename T>
+inline void DoNotOptimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile char const* sink;
+    sink = reinterpret_cast<char const*>(&value);
+#endif
+}
+
+typedef void (*MicroBenchFunc)(uint64 iterations);
+
+struct MicroBenchmark
+{
+    char const* name;
+    MicroBenchFunc func;
+};
+
+static void BM_ByteBufferAppendUInt32(uint64 iterations)
+{
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        ByteBuffer buffer;
+        for (uint32 j = 0; j < 64; ++j)
+            buffer << j;
+        DoNotOptimize(buffer.contents());
+    }
+}
+
+static void BM_ByteBufferAppendUInt32Reserved(uint64 iterations)
+{
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        ByteBuffer buffer(64 * sizeof(uint32));
+        for (uint32 j = 0; j < 64; ++j)
+            buffer << j;
+        DoNotOptimize(buffer.contents());
+    }
+}
+
+static void BM_ByteBufferAppendString(uint64 iterations)
+{
+    std::string text = "The quick brown fox jumps over the lazy dog";
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        ByteBuffer buffer;
+        for (uint32 j = 0; j < 8; ++j)
+            buffer << text;
+        DoNotOptimize(buffer.contents());
+    }
+}
+
+static void BM_ByteBufferReadUInt32(uint64 iterations)
+{
+    ByteBuffer buffer;
+    for (uint32 j = 0; j < 64; ++j)
+        buffer << j;
+
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        buffer.rpos(0);
+        uint32 sum = 0;
+        for (uint32 j = 0; j < 64; ++j)
+            sum += buffer.read<uint32>();
+        DoNotOptimize(sum);
+    }
+}
+
+// shape of a movement packet: packed guid, flags, time, position
+static void BM_WorldPacketMovement(uint64 iterations)
+{
+    ObjectGuid guid(HIGHGUID_PLAYER, uint32(12345));
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        WorldPacket data(MSG_MOVE_HEARTBEAT, 64);
+        data.appendPackGUID(guid.GetRawValue());
+        data << uint32(1) << uint8(0) << uint32(i);
+        data << float(1.0f) << float(2.0f) << float(3.0f) << float(4.0f);
+        data << uint32(0);
+        DoNotOptimize(data.contents());
+    }
+}
+
+static void BM_WorldPacketCopy(uint64 iterations)
+{
+    WorldPacket data(SMSG_UPDATE_OBJECT, 1024);
+    for (uint32 j = 0; j < 256; ++j)
+        data << j;
+
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        WorldPacket copy(data);
+        DoNotOptimize(copy.contents());
+    }
+}
+
+static AuthCrypt& GetInitializedCrypt()
+{
+    static AuthCrypt crypt;
+    static bool initialized = false;
+    if (!initialized)
+    {
+        BigNumber K;
+        K.SetRand(40 * 8);
+        crypt.Init(&K);
+        initialized = true;
+    }
+    return crypt;
+}
+
+static void BM_AuthCryptEncryptHeader(uint64 iterations)
+{
+    AuthCrypt& crypt = GetInitializedCrypt();
+    uint8 header[4] = { 0x00, 0x20, 0xA9, 0x00 };
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        crypt.EncryptSend(header, sizeof(header));
+        DoNotOptimize(header);
+    }
+}
+
+static void BM_AuthCryptDecryptHeader(uint64 iterations)
+{
+    AuthCrypt& crypt = GetInitializedCrypt();
+    uint8 header[6] = { 0x00, 0x20, 0xDA, 0x00, 0x00, 0x00 };
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        crypt.DecryptRecv(header, sizeof(header));
+        DoNotOptimize(header);
+    }
+}
+
+static void BM_Utf8toWStr(uint64 iterations)
+{
+    std::string text = "Looking for group Karazhan, need healer and tank \xc3\xa4\xc3\xb6\xc3\xbc";
+    std::wstring wtext;
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        Utf8toWStr(text, wtext);
+        DoNotOptimize(wtext.data());
+    }
+}
+
+static void BM_WstrToLower(uint64 iterations)
+{
+    std::wstring source;
+    Utf8toWStr("Looking For Group KARAZHAN, Need Healer And Tank", source);
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        std::wstring text = source;
+        wstrToLower(text);
+        DoNotOptimize(text.data());
+    }
+}
+
+static void BM_UpdateMaskSetBits(uint64 iterations)
+{
+    UpdateMask mask;
+    mask.SetCount(PLAYER_END);
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        mask.Clear();
+        for (uint32 index = 0; index < PLAYER_END; index += 7)
+            mask.SetBit(index);
+        DoNotOptimize(mask.GetMask());
+    }
+}
+
+static void BM_UpdateMaskIterateSparse(uint64 iterations)
+{
+    UpdateMask mask;
+    mask.SetCount(PLAYER_END);
+    for (uint32 index = 0; index < PLAYER_END; index += 97)
+        mask.SetBit(index);
+
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        uint32 count = 0;
+        for (uint32 index = mask.GetNextSetBit(0); index < mask.GetCount(); index = mask.GetNextSetBit(index + 1))
+            ++count;
+        DoNotOptimize(count);
+    }
+}
+
+static void BM_ObjectGuidHash(uint64 iterations)
+{
+    std::hash<ObjectGuid> hasher;
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        size_t sum = 0;
+        for (uint32 counter = 1; counter <= 64; ++counter)
+            sum += hasher(ObjectGuid(HIGHGUID_UNIT, uint32(1000), counter));
+        DoNotOptimize(sum);
+    }
+}
+
+static void BM_ObjectGuidMapFind(uint64 iterations)
+{
+    std::unordered_map<ObjectGuid, uint32> guids;
+    for (uint32 counter = 1; counter <= 4096; ++counter)
+        guids[ObjectGuid(HIGHGUID_UNIT, uint32(1000), counter)] = counter;
+
+    for (uint64 i = 0; i < iterations; ++i)
+    {
+        uint32 sum = 0;
+        for (uint32 counter = 1; counter <= 4096; counter += 64)
+            sum += guids.find(ObjectGuid(HIGHGUID_UNIT, uint32(1000), counter))->second;
+        DoNotOptimize(sum);
+    }
+}
+
+static MicroBenchmark const s_benchmarks[] =
+{
+    { "ByteBuffer/AppendUInt32x64",         BM_ByteBufferAppendUInt32 },
+    { "ByteBuffer/AppendUInt32x64Reserved", BM_ByteBufferAppendUInt32Reserved },
+    { "ByteBuffer/AppendStringx8",          BM_ByteBufferAppendString },
+    { "ByteBuffer/ReadUInt32x64",           BM_ByteBufferReadUInt32 },
+    { "WorldPacket/Movement",               BM_WorldPacketMovement },
+    { "WorldPacket/Copy1K",                 BM_WorldPacketCopy },
+    { "AuthCrypt/EncryptHeader",            BM_AuthCryptEncryptHeader },
+    { "AuthCrypt/DecryptHeader",            BM_AuthCryptDecryptHeader },
+    { "Util/Utf8toWStr",                    BM_Utf8toWStr },
+    { "Util/wstrToLower",                   BM_WstrToLower },
+    { "UpdateMask/SetBitsPlayer",           BM_UpdateMaskSetBits },
+    { "UpdateMask/IterateSparsePlayer",     BM_UpdateMaskIterateSparse },
+    { "ObjectGuid/Hashx64",                 BM_ObjectGuidHash },
+    { "ObjectGuid/MapFindx64",              BM_ObjectGuidMapFind },
+};
+
+int main(int argc, char* argv[])
+{
+    std::string filter;
+    double minTime;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("filter,f", boost::program_options::value<std::string>(&filter), "run only the benchmarks with this in their name")
+    ("min-time,t", boost::program_options::value<double>(&minTime)->default_value(0.5), "seconds each benchmark runs at least")
+    ("list,l", "list the benchmarks")
+    ("help,h", "prints usage");
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    if (vm.count("list"))
+    {
+        for (auto const& benchmark : s_benchmarks)
+            std::cout << benchmark.name << std::endl;
+        return 0;
+    }
+
+    printf("%-40s %14s %12s\n", "Benchmark", "Iterations", "ns/iter");
+    for (auto const& benchmark : s_benchmarks)
+    {
+        if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+            continue;
+
+        benchmark.func(1);                                  // warm up caches and static state
+
+        uint64 iterations = 1;
+        double seconds = 0.0;
+        while (true)
+        {
+            auto start = std::chrono::steady_clock::now();
+            benchmark.func(iterations);
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (seconds >= minTime || iterations >= (uint64(1) << 40))
+                break;
+
+            // aim a bit above the minimum time, at most 10 times more per round
+            double factor = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+            iterations = uint64(double(iterations) * std::min(std::max(factor, 2.0), 10.0));
+        }
+
+        printf("%-40s %14llu %12.2f\n", benchmark.name, (unsigned long long)iterations, seconds * 1e9 / iterations);
+    }
+
+    return 0;
+}
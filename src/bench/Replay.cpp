@@ -0,0 +1,987 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * mangos-replay - replays captured client sessions against a test mangosd as many synthetic clients
+ *
+ * Reads a packet log written by mangosd (PacketLogFile) and replays the client packets every captured connection
+ * sent after its CMSG_PLAYER_LOGIN, with the captured timing scaled by --speed. Client n logs in as account
+ * <prefix>n with the first character of the account, the player guids of the capture are rewritten to the
+ * characters of the clients. The accounts need the session key given by --session-key, realmd is not involved:
+ *
+ *   UPDATE account SET sessionkey = '<key>', os = 'Win' WHERE username LIKE 'REPLAY%';
+ *
+ * The characters are not moved, place them where the capture was taken. Reports bandwidth, the latency of every
+ * replayed opcode up to the server opcode which answered it in the capture, and the round trip of CMSG_QUERY_TIME,
+ * which is answered by the world update and follows the server tick time. A mangosd built with BUILD_METRICS
+ * reports the exact tick time as world.update.
+ */
+
+#include "Common.h"
+#include "ByteBuffer.h"
+#include "WorldPacket.h"
+#include "Log.h"
+#include "Util.h"
+#include "Database/DatabaseEnv.h"
+#include "Auth/AuthCrypt.h"
+#include "Auth/BigNumber.h"
+#include "Auth/Sha1.h"
+#include "Globals/SharedDefines.h"
+#include "Server/Opcodes.h"
+#include "Server/PacketLog.h"
+
+#include <boost/asio.hpp>
+#include <boost/program_options.hpp>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// the game library is linked for the opcode names and expects the globals of mangosd
+DatabaseType WorldDatabase;                                 ///< Accessor to the world database
+DatabaseType CharacterDatabase;                             ///< Accessor to the character database
+DatabaseType LoginDatabase;                                 ///< Accessor to the realm/login database
+DatabaseType LogsDatabase;                                  ///< Accessor to the logs database
+
+uint32 realmID;                                             ///< Id of the realm
+
+#ifdef _WIN32
+int m_ServiceStatus = -1;
+#endif
+
+typedef std::chrono::steady_clock ReplayClock;
+
+static uint32 const RESPONSE_WINDOW = 1000;                 // ms, a later server packet is not taken as the answer
+static size_t const MAX_PENDING_RESPONSES = 64;             // per answer opcode, older requests count as unanswered
+static uint32 const PKT_DIRECTION_SMSG = 0x47534d53;        // "SMSG"
+
+struct ReplayOptions
+{
+    std::string logFile;
+    std::string host;
+    uint16 port;
+    uint32 clients;
+    std::string accountPrefix;
+    std::string sessionKey;
+    float speed;
+    uint32 rampUp;
+    bool loop;
+    bool createCharacters;
+    uint32 duration;
+    uint32 reportInterval;
+    uint32 probeInterval;
+};
+
+struct CapturedPacket
+{
+    uint32 time;                                            // ms after the login
+    uint16 opcode;
+    uint16 responseOpcode;                                  // first server opcode within RESPONSE_WINDOW, 0 - none
+    std::vector<uint8> payload;
+};
+
+struct CapturedSession
+{
+    uint64 playerGuid = 0;                                  // 0 - the login is not in the log
+    std::vector<CapturedPacket> packets;
+};
+
+// the clients log in and out by themselves
+static bool IsSessionOpcode(uint32 opcode)
+{
+    switch (opcode)
+    {
+        case CMSG_AUTH_SESSION:
+        case CMSG_CHAR_ENUM:
+        case CMSG_CHAR_CREATE:
+        case CMSG_CHAR_DELETE:
+        case CMSG_CHAR_RENAME:
+        case CMSG_PLAYER_LOGIN:
+        case CMSG_LOGOUT_REQUEST:
+        case CMSG_LOGOUT_CANCEL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+struct LoggedPacket
+{
+    uint32 ticks;
+    bool fromClient;
+    uint32 opcode;
+    std::vector<uint8> payload;                             // client packets only
+};
+
+static bool LoadCapture(std::string const& fileName, std::vector<CapturedSession>& sessions)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+    {
+        sLog.outError("Cannot open packet log %s", fileName.c_str());
+        return false;
+    }
+
+    LogHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.Signature, "PKT", 3) != 0 || header.FormatVersion != 0x0301)
+    {
+        sLog.outError("%s is not a PKT 3.1 packet log", fileName.c_str());
+        fclose(file);
+        return false;
+    }
+
+    if (header.OptionalDataSize)
+        fseek(file, header.OptionalDataSize, SEEK_CUR);
+
+    // connections are told apart by their address, mangosd does not fill ConnectionId
+    std::map<std::vector<uint8>, std::vector<LoggedPacket>> connections;
+    std::vector<uint8> data;
+    uint32 records = 0;
+    while (true)
+    {
+        PacketHeader packetHeader;
+        if (fread(&packetHeader, offsetof(PacketHeader, OptionalData), 1, file) != 1)
+            break;
+
+        std::vector<uint8> key(packetHeader.OptionalDataSize + sizeof(uint32));
+        memcpy(&key[packetHeader.OptionalDataSize], &packetHeader.ConnectionId, sizeof(uint32));
+        data.resize(packetHeader.Length);
+        if ((packetHeader.OptionalDataSize && fread(key.data(), packetHeader.OptionalDataSize, 1, file) != 1) ||
+            data.size() < sizeof(uint32) || fread(data.data(), data.size(), 1, file) != 1)
+        {
+            sLog.outError("%s: truncated record after %u packets, the rest is ignored", fileName.c_str(), records);
+            break;
+        }
+        ++records;
+
+        LoggedPacket packet;
+        packet.ticks = packetHeader.ArrivalTicks;
+        packet.fromClient = packetHeader.Direction != PKT_DIRECTION_SMSG;
+        memcpy(&packet.opcode, data.data(), sizeof(uint32));
+        if (packet.fromClient)
+            packet.payload.assign(data.begin() + sizeof(uint32), data.end());
+        connections[key].push_back(std::move(packet));
+    }
+    fclose(file);
+
+    for (auto& connection : connections)
+    {
+        std::vector<LoggedPacket>& packets = connection.second;
+
+        // every logging thread has its own ring, the records are only ordered per thread
+        uint32 firstTicks = packets.front().ticks;
+        std::stable_sort(packets.begin(), packets.end(), [firstTicks](LoggedPacket const& a, LoggedPacket const& b)
+        {
+            return int32(a.ticks - firstTicks) < int32(b.ticks - firstTicks);
+        });
+
+        CapturedSession session;
+        uint32 loginTicks = firstTicks;                     // logs started by .debug packetlog begin in the world
+        std::vector<size_t> unanswered;
+        for (LoggedPacket& packet : packets)
+        {
+            if (!packet.fromClient)
+            {
+                for (size_t index : unanswered)
+                {
+                    CapturedPacket& request = session.packets[index];
+                    if (packet.ticks - loginTicks - request.time <= RESPONSE_WINDOW)
+                        request.responseOpcode = uint16(packet.opcode);
+                }
+                unanswered.clear();
+                continue;
+            }
+
+            if (packet.opcode == CMSG_PLAYER_LOGIN && packet.payload.size() >= sizeof(uint64))
+            {
+                // a relog starts a new session, what was sent at the character screen is dropped
+                if (session.playerGuid)
+                    sessions.push_back(std::move(session));
+                session = CapturedSession();
+                memcpy(&session.playerGuid, packet.payload.data(), sizeof(uint64));
+                loginTicks = packet.ticks;
+                unanswered.clear();
+                continue;
+            }
+
+            if (IsSessionOpcode(packet.opcode) || packet.opcode >= NUM_MSG_TYPES)
+                continue;
+
+            CapturedPacket captured;
+            captured.time = packet.ticks - loginTicks;
+            captured.opcode = uint16(packet.opcode);
+            captured.responseOpcode = 0;
+            captured.payload = std::move(packet.payload);
+            unanswered.push_back(session.packets.size());
+            session.packets.push_back(std::move(captured));
+        }
+
+        if (!session.packets.empty())
+            sessions.push_back(std::move(session));
+    }
+
+    sessions.erase(std::remove_if(sessions.begin(), sessions.end(), [](CapturedSession const& session) { return session.packets.empty(); }), sessions.end());
+    printf("%s: %u packets, %u connections, %u sessions to replay\n", fileName.c_str(), records, uint32(connections.size()), uint32(sessions.size()));
+    return !sessions.empty();
+}
+
+struct OpcodeStats
+{
+    uint64 sentCount = 0;
+    uint64 sentBytes = 0;
+    uint64 receivedCount = 0;
+    uint64 receivedBytes = 0;
+    uint64 unanswered = 0;
+    std::vector<uint32> latencies;                          // us up to the captured answer
+};
+
+class ReplayClient;
+
+struct ReplayContext
+{
+    explicit ReplayContext(ReplayOptions const& options, std::vector<CapturedSession> const& sessions) :
+        options(options), sessions(sessions), opcodeStats(NUM_MSG_TYPES), failed(0),
+        intervalSentBytes(0), intervalSentPackets(0), intervalReceivedBytes(0), intervalReceivedPackets(0)
+    {}
+
+    uint64 GetReplayedGuid(uint64 capturedGuid, uint32 clientIndex) const;
+
+    void CountSent(uint16 opcode, size_t size)
+    {
+        ++opcodeStats[opcode].sentCount;
+        opcodeStats[opcode].sentBytes += size;
+        ++intervalSentPackets;
+        intervalSentBytes += size;
+    }
+
+    void CountReceived(uint16 opcode, size_t size)
+    {
+        if (opcode < NUM_MSG_TYPES)
+        {
+            ++opcodeStats[opcode].receivedCount;
+            opcodeStats[opcode].receivedBytes += size;
+        }
+        ++intervalReceivedPackets;
+        intervalReceivedBytes += size;
+    }
+
+    ReplayOptions const& options;
+    std::vector<CapturedSession> const& sessions;
+    std::unordered_map<uint64, size_t> capturedGuids;       // player guid of the capture -> session
+    boost::asio::io_service service;
+    boost::asio::ip::tcp::endpoint endpoint;
+    BigNumber sessionKey;
+    ByteBuffer addonData;
+    std::vector<std::unique_ptr<ReplayClient>> clients;
+
+    std::vector<OpcodeStats> opcodeStats;
+    std::vector<uint32> probeLatencies;                     // us
+    size_t intervalProbeStart = 0;
+    uint32 failed;
+    uint64 intervalSentBytes, intervalSentPackets;
+    uint64 intervalReceivedBytes, intervalReceivedPackets;
+};
+
+class ReplayClient
+{
+    public:
+        ReplayClient(ReplayContext& context, uint32 index) : m_context(context), m_index(index),
+            m_session(context.sessions[index % context.sessions.size()]), m_state(STATE_WAITING),
+            m_socket(context.service), m_timer(context.service), m_readBuffer(16 * 1024), m_inPos(0),
+            m_headerDecrypted(false), m_packetSize(0), m_packetOpcode(0), m_writing(false),
+            m_playerGuid(0), m_nextPacket(0), m_probePending(false)
+        {}
+
+        void Start(uint32 delay)
+        {
+            m_timer.expires_from_now(boost::posix_time::milliseconds(delay));
+            m_timer.async_wait([this](boost::system::error_code const& error)
+            {
+                if (!error)
+                    Connect();
+            });
+        }
+
+        bool IsInWorld() const { return m_state == STATE_IN_WORLD || m_state == STATE_FINISHED; }
+        bool IsFinished() const { return m_state == STATE_FINISHED || m_state == STATE_FAILED; }
+        uint64 GetPlayerGuid() const { return m_playerGuid; }
+
+        // CMSG_QUERY_TIME is answered by the next world update of the session
+        bool SendProbe()
+        {
+            if (!IsInWorld() || m_probePending)
+                return false;
+
+            m_probePending = true;
+            m_probeSent = ReplayClock::now();
+            SendPacket(CMSG_QUERY_TIME, nullptr, 0);
+            return true;
+        }
+
+        void Stop()
+        {
+            boost::system::error_code error;
+            m_timer.cancel(error);
+            m_socket.close(error);
+        }
+
+    private:
+        enum State
+        {
+            STATE_WAITING,
+            STATE_CONNECTING,
+            STATE_AUTH,
+            STATE_CHAR_SCREEN,
+            STATE_LOGGING_IN,
+            STATE_IN_WORLD,
+            STATE_FINISHED,
+            STATE_FAILED
+        };
+
+        struct PendingRequest
+        {
+            uint16 opcode;
+            ReplayClock::time_point sent;
+        };
+
+        void Fail(char const* reason)
+        {
+            if (m_state == STATE_FAILED)
+                return;
+
+            sLog.outError("Client %u (%s%u): %s", m_index, m_context.options.accountPrefix.c_str(), m_index + 1, reason);
+            m_state = STATE_FAILED;
+            ++m_context.failed;
+            Stop();
+        }
+
+        void Connect()
+        {
+            m_state = STATE_CONNECTING;
+            m_socket.async_connect(m_context.endpoint, [this](boost::system::error_code const& error)
+            {
+                if (error)
+                {
+                    Fail(("cannot connect: " + error.message()).c_str());
+                    return;
+                }
+
+                boost::system::error_code ignored;
+                m_socket.set_option(boost::asio::ip::tcp::no_delay(true), ignored);
+                StartRead();
+            });
+        }
+
+        void StartRead()
+        {
+            m_socket.async_read_some(boost::asio::buffer(m_readBuffer), [this](boost::system::error_code const& error, size_t length)
+            {
+                if (m_state == STATE_FAILED)
+                    return;
+
+                if (error)
+                {
+                    Fail(m_state == STATE_AUTH ? "disconnected at authentication, check the account and its session key" : "disconnected by the server");
+                    return;
+                }
+
+                m_inBuffer.insert(m_inBuffer.end(), m_readBuffer.begin(), m_readBuffer.begin() + length);
+                if (ProcessIncomingData())
+                    StartRead();
+            });
+        }
+
+        bool ProcessIncomingData()
+        {
+            while (true)
+            {
+                if (!m_headerDecrypted)
+                {
+                    if (m_inBuffer.size() - m_inPos < 4)
+                        break;
+
+                    uint8* header = &m_inBuffer[m_inPos];
+                    m_crypt.DecryptRecv(header, 4);
+                    m_packetSize = uint16(header[0] << 8 | header[1]);
+                    m_packetOpcode = uint16(header[2] | header[3] << 8);
+                    m_inPos += 4;
+                    m_headerDecrypted = true;
+
+                    if (m_packetSize < 2)
+                    {
+                        Fail("malformed server packet header");
+                        return false;
+                    }
+                }
+
+                size_t payloadSize = m_packetSize - 2;
+                if (m_inBuffer.size() - m_inPos < payloadSize)
+                    break;
+
+                WorldPacket packet(Opcodes(m_packetOpcode), payloadSize);
+                if (payloadSize)
+                    packet.append(&m_inBuffer[m_inPos], payloadSize);
+                m_inPos += payloadSize;
+                m_headerDecrypted = false;
+
+                m_context.CountReceived(m_packetOpcode, payloadSize + 4);
+
+                try
+                {
+                    HandlePacket(packet);
+                }
+                catch (ByteBufferException&)
+                {
+                    Fail(("malformed " + std::string(LookupOpcodeName(m_packetOpcode))).c_str());
+                }
+
+                if (m_state == STATE_FAILED)
+                    return false;
+            }
+
+            m_inBuffer.erase(m_inBuffer.begin(), m_inBuffer.begin() + m_inPos);
+            m_inPos = 0;
+            return true;
+        }
+
+        void HandlePacket(WorldPacket& packet)
+        {
+            switch (packet.GetOpcode())
+            {
+                case SMSG_AUTH_CHALLENGE:
+                {
+                    uint32 serverSeed;
+                    packet >> serverSeed;
+                    SendAuthSession(serverSeed);
+                    m_state = STATE_AUTH;
+                    return;
+                }
+                case SMSG_AUTH_RESPONSE:
+                {
+                    uint8 result;
+                    packet >> result;
+                    if (result == AUTH_OK)
+                    {
+                        m_state = STATE_CHAR_SCREEN;
+                        SendPacket(CMSG_CHAR_ENUM, nullptr, 0);
+                    }
+                    else if (result != AUTH_WAIT_QUEUE)
+                        Fail(("authentication refused, code " + std::to_string(result)).c_str());
+                    return;
+                }
+                case SMSG_CHAR_ENUM:
+                {
+                    uint8 count;
+                    packet >> count;
+                    if (count)
+                    {
+                        packet >> m_playerGuid;
+                        m_state = STATE_LOGGING_IN;
+                        SendPacket(CMSG_PLAYER_LOGIN, reinterpret_cast<uint8 const*>(&m_playerGuid), sizeof(m_playerGuid));
+                    }
+                    else if (m_context.options.createCharacters)
+                        SendCharCreate();
+                    else
+                        Fail("the account has no character, see --create-characters");
+                    return;
+                }
+                case SMSG_CHAR_CREATE:
+                {
+                    uint8 result;
+                    packet >> result;
+                    if (result == CHAR_CREATE_SUCCESS)
+                        SendPacket(CMSG_CHAR_ENUM, nullptr, 0);
+                    else
+                        Fail(("character creation refused, code " + std::to_string(result)).c_str());
+                    return;
+                }
+                case SMSG_LOGIN_VERIFY_WORLD:
+                    if (m_state == STATE_LOGGING_IN)
+                    {
+                        m_state = STATE_IN_WORLD;
+                        m_replayStart = ReplayClock::now();
+                        m_nextPacket = 0;
+                        ScheduleReplay();
+                    }
+                    return;
+                case SMSG_QUERY_TIME_RESPONSE:
+                    if (m_probePending)
+                    {
+                        m_probePending = false;
+                        m_context.probeLatencies.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(ReplayClock::now() - m_probeSent).count()));
+                        return;
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            // answer of a replayed packet
+            auto itr = m_pending.find(packet.GetOpcode());
+            if (itr == m_pending.end() || itr->second.empty())
+                return;
+
+            PendingRequest const& request = itr->second.front();
+            m_context.opcodeStats[request.opcode].latencies.push_back(uint32(std::chrono::duration_cast<std::chrono::microseconds>(ReplayClock::now() - request.sent).count()));
+            itr->second.pop_front();
+        }
+
+        void SendAuthSession(uint32 serverSeed)
+        {
+            static uint32 const clientBuild[] = EXPECTED_MANGOSD_CLIENT_BUILD;
+
+            std::string account = m_context.options.accountPrefix + std::to_string(m_index + 1);
+            uint32 clientSeed = urand();
+            uint32 t = 0;
+
+            // the digest mangosd checks in WorldSocket::HandleAuthSession
+            Sha1Hash sha;
+            sha.UpdateData(account);
+            sha.UpdateData((uint8*)&t, 4);
+            sha.UpdateData((uint8*)&clientSeed, 4);
+            sha.UpdateData((uint8*)&serverSeed, 4);
+            sha.UpdateBigNumbers(&m_context.sessionKey, nullptr);
+            sha.Finalize();
+
+            ByteBuffer packet(64 + m_context.addonData.size());
+            packet << uint32(clientBuild[0]);
+            packet << uint32(0);
+            packet << account;
+            packet << clientSeed;
+            packet.append(sha.GetDigest(), SHA_DIGEST_LENGTH);
+            packet.append(m_context.addonData.contents(), m_context.addonData.size());
+            SendPacket(CMSG_AUTH_SESSION, packet.contents(), packet.size());
+
+            // the server encrypts everything after reading the session
+            m_crypt.Init(&m_context.sessionKey, true);
+        }
+
+        void SendCharCreate()
+        {
+            // names take letters only, the index is written in base 26
+            std::string name = "Replay";
+            uint32 number = m_index;
+            do
+            {
+                name += char('a' + number % 26);
+                number /= 26;
+            }
+            while (number);
+
+            ByteBuffer packet(name.size() + 10);
+            packet << name;
+            packet << uint8(RACE_HUMAN) << uint8(CLASS_WARRIOR) << uint8(GENDER_MALE);
+            packet << uint8(0) << uint8(0) << uint8(0) << uint8(0) << uint8(0); // skin, face, hair style, hair color, facial hair
+            packet << uint8(0);                             // outfit
+            SendPacket(CMSG_CHAR_CREATE, packet.contents(), packet.size());
+        }
+
+        ReplayClock::time_point GetDueTime(CapturedPacket const& packet) const
+        {
+            return m_replayStart + std::chrono::microseconds(uint64(packet.time * 1000.0 / m_context.options.speed));
+        }
+
+        void ScheduleReplay()
+        {
+            if (m_nextPacket >= m_session.packets.size())
+            {
+                if (!m_context.options.loop)
+                {
+                    m_state = STATE_FINISHED;
+                    return;
+                }
+
+                m_replayStart = ReplayClock::now();
+                m_nextPacket = 0;
+            }
+
+            auto delay = std::chrono::duration_cast<std::chrono::microseconds>(GetDueTime(m_session.packets[m_nextPacket]) - ReplayClock::now());
+            m_timer.expires_from_now(boost::posix_time::microseconds(std::max<int64>(delay.count(), 0)));
+            m_timer.async_wait([this](boost::system::error_code const& error)
+            {
+                if (!error && m_state == STATE_IN_WORLD)
+                    ReplayDuePackets();
+            });
+        }
+
+        void ReplayDuePackets()
+        {
+            ReplayClock::time_point now = ReplayClock::now();
+            std::vector<uint8> payload;
+            while (m_nextPacket < m_session.packets.size() && GetDueTime(m_session.packets[m_nextPacket]) <= now)
+            {
+                CapturedPacket const& packet = m_session.packets[m_nextPacket++];
+                payload = packet.payload;
+                RewriteGuids(payload);
+                SendPacket(packet.opcode, payload.data(), payload.size());
+
+                if (packet.responseOpcode)
+                {
+                    std::deque<PendingRequest>& pending = m_pending[packet.responseOpcode];
+                    if (pending.size() >= MAX_PENDING_RESPONSES)
+                    {
+                        ++m_context.opcodeStats[pending.front().opcode].unanswered;
+                        pending.pop_front();
+                    }
+                    pending.push_back({ packet.opcode, now });
+                }
+            }
+
+            ScheduleReplay();
+        }
+
+        // player guids of the capture become the characters replaying them, the payload layout is unknown so every offset is tried
+        void RewriteGuids(std::vector<uint8>& payload) const
+        {
+            for (size_t pos = 0; pos + sizeof(uint64) <= payload.size(); ++pos)
+            {
+                uint64 value;
+                memcpy(&value, &payload[pos], sizeof(uint64));
+                if (!value || (value >> 32) != 0)           // HIGHGUID_PLAYER is 0
+                    continue;
+
+                if (uint64 guid = m_context.GetReplayedGuid(value, m_index))
+                {
+                    memcpy(&payload[pos], &guid, sizeof(uint64));
+                    pos += sizeof(uint64) - 1;
+                }
+            }
+        }
+
+        void SendPacket(uint16 opcode, uint8 const* payload, size_t size)
+        {
+            uint8 header[6];
+            uint16 packetSize = uint16(size + 4);
+            header[0] = uint8(packetSize >> 8);
+            header[1] = uint8(packetSize);
+            header[2] = uint8(opcode);
+            header[3] = uint8(opcode >> 8);
+            header[4] = 0;
+            header[5] = 0;
+            m_crypt.EncryptSend(header, sizeof(header));
+
+            m_outBuffer.insert(m_outBuffer.end(), header, header + sizeof(header));
+            if (size)
+                m_outBuffer.insert(m_outBuffer.end(), payload, payload + size);
+
+            m_context.CountSent(opcode, size + sizeof(header));
+            StartWrite();
+        }
+
+        void StartWrite()
+        {
+            if (m_writing || m_outBuffer.empty())
+                return;
+
+            m_writing = true;
+            m_writeBuffer.swap(m_outBuffer);
+            boost::asio::async_write(m_socket, boost::asio::buffer(m_writeBuffer), [this](boost::system::error_code const& error, size_t /*length*/)
+            {
+                m_writing = false;
+                m_writeBuffer.clear();
+                if (m_state == STATE_FAILED)
+                    return;
+
+                if (error)
+                {
+                    Fail("write failed");
+                    return;
+                }
+
+                StartWrite();
+            });
+        }
+
+        ReplayContext& m_context;
+        uint32 m_index;
+        CapturedSession const& m_session;
+        State m_state;
+
+        boost::asio::ip::tcp::socket m_socket;
+        boost::asio::deadline_timer m_timer;
+        AuthCrypt m_crypt;
+
+        std::vector<uint8> m_readBuffer;
+        std::vector<uint8> m_inBuffer;
+        size_t m_inPos;
+        bool m_headerDecrypted;                             // header of the incomplete packet at m_inPos is read
+        uint16 m_packetSize;
+        uint16 m_packetOpcode;
+
+        std::vector<uint8> m_outBuffer;
+        std::vector<uint8> m_writeBuffer;                   // owned by the running async_write
+        bool m_writing;
+
+        uint64 m_playerGuid;
+        size_t m_nextPacket;
+        ReplayClock::time_point m_replayStart;
+        std::unordered_map<uint16, std::deque<PendingRequest>> m_pending; // by answer opcode
+
+        bool m_probePending;
+        ReplayClock::time_point m_probeSent;
+};
+
+uint64 ReplayContext::GetReplayedGuid(uint64 capturedGuid, uint32 clientIndex) const
+{
+    auto itr = capturedGuids.find(capturedGuid);
+    if (itr == capturedGuids.end())
+        return 0;
+
+    // clients replaying the capture once more only see each other
+    size_t target = clientIndex - clientIndex % sessions.size() + itr->second;
+    if (target >= clients.size() || !clients[target]->IsInWorld())
+        return 0;
+
+    return clients[target]->GetPlayerGuid();
+}
+
+static double Percentile(std::vector<uint32> const& sorted, double percent)
+{
+    if (sorted.empty())
+        return 0.0;
+    size_t index = std::min(sorted.size() - 1, size_t(percent / 100.0 * sorted.size()));
+    return sorted[index] / 1000.0;
+}
+
+static void PrintInterval(ReplayContext& context, uint32 elapsed, double seconds)
+{
+    uint32 inWorld = uint32(std::count_if(context.clients.begin(), context.clients.end(), [](std::unique_ptr<ReplayClient> const& client) { return client->IsInWorld(); }));
+
+    std::vector<uint32> probes(context.probeLatencies.begin() + context.intervalProbeStart, context.probeLatencies.end());
+    std::sort(probes.begin(), probes.end());
+    context.intervalProbeStart = context.probeLatencies.size();
+
+    printf("%5us  in world %u/%u  failed %u  sent %.1f KB/s %.0f packets/s  received %.1f KB/s %.0f packets/s  tick probe ms p50 %.1f max %.1f\n",
+           elapsed, inWorld, uint32(context.clients.size()), context.failed,
+           context.intervalSentBytes / seconds / 1024.0, context.intervalSentPackets / seconds,
+           context.intervalReceivedBytes / seconds / 1024.0, context.intervalReceivedPackets / seconds,
+           Percentile(probes, 50), probes.empty() ? 0.0 : probes.back() / 1000.0);
+
+    context.intervalSentBytes = context.intervalSentPackets = 0;
+    context.intervalReceivedBytes = context.intervalReceivedPackets = 0;
+}
+
+static void PrintReport(ReplayContext& context, double seconds)
+{
+    std::vector<uint32> probes(context.probeLatencies);
+    std::sort(probes.begin(), probes.end());
+
+    uint64 sentBytes = 0, receivedBytes = 0;
+    for (OpcodeStats const& stats : context.opcodeStats)
+    {
+        sentBytes += stats.sentBytes;
+        receivedBytes += stats.receivedBytes;
+    }
+
+    printf("\n%u clients replaying %u captured sessions at speed %.2f for %.0f s, %u failed\n",
+           uint32(context.clients.size()), uint32(context.sessions.size()), context.options.speed, seconds, context.failed);
+    printf("bandwidth KB/s   sent %.1f  received %.1f\n", sentBytes / seconds / 1024.0, receivedBytes / seconds / 1024.0);
+    printf("tick probe ms    p50 %.1f  p95 %.1f  p99 %.1f  max %.1f  (%u CMSG_QUERY_TIME round trips)\n",
+           Percentile(probes, 50), Percentile(probes, 95), Percentile(probes, 99), probes.empty() ? 0.0 : probes.back() / 1000.0, uint32(probes.size()));
+
+    std::vector<uint32> opcodes;
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        if (context.opcodeStats[i].sentCount)
+            opcodes.push_back(i);
+    std::sort(opcodes.begin(), opcodes.end(), [&context](uint32 a, uint32 b) { return context.opcodeStats[a].sentCount > context.opcodeStats[b].sentCount; });
+
+    printf("\n%-40s %10s %10s %10s %9s %9s %9s %10s\n", "sent opcode", "packets", "KB", "answered", "p50 ms", "p95 ms", "p99 ms", "unanswered");
+    for (uint32 opcode : opcodes)
+    {
+        OpcodeStats& stats = context.opcodeStats[opcode];
+        std::sort(stats.latencies.begin(), stats.latencies.end());
+        printf("%-40s %10llu %10.1f %10u %9.2f %9.2f %9.2f %10llu\n", LookupOpcodeName(opcode),
+               (unsigned long long)stats.sentCount, stats.sentBytes / 1024.0, uint32(stats.latencies.size()),
+               Percentile(stats.latencies, 50), Percentile(stats.latencies, 95), Percentile(stats.latencies, 99),
+               (unsigned long long)stats.unanswered);
+    }
+
+    opcodes.clear();
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        if (context.opcodeStats[i].receivedCount)
+            opcodes.push_back(i);
+    std::sort(opcodes.begin(), opcodes.end(), [&context](uint32 a, uint32 b) { return context.opcodeStats[a].receivedBytes > context.opcodeStats[b].receivedBytes; });
+
+    printf("\n%-40s %10s %10s %10s\n", "received opcode", "packets", "KB", "KB/s");
+    for (uint32 opcode : opcodes)
+    {
+        OpcodeStats const& stats = context.opcodeStats[opcode];
+        printf("%-40s %10llu %10.1f %10.2f\n", LookupOpcodeName(opcode),
+               (unsigned long long)stats.receivedCount, stats.receivedBytes / 1024.0, stats.receivedBytes / seconds / 1024.0);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    ReplayOptions options;
+
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+    ("log,l", boost::program_options::value<std::string>(&options.logFile)->required(), "packet log written by mangosd (PacketLogFile)")
+    ("host", boost::program_options::value<std::string>(&options.host)->default_value("127.0.0.1"), "address of the test mangosd")
+    ("port", boost::program_options::value<uint16>(&options.port)->default_value(8085), "world port of the test mangosd")
+    ("clients,n", boost::program_options::value<uint32>(&options.clients)->default_value(0), "synthetic clients, each replays the captured sessions in turn, 0 - one per session")
+    ("account-prefix,a", boost::program_options::value<std::string>(&options.accountPrefix)->default_value("REPLAY"), "client n logs in as account <prefix>n, starting with 1")
+    ("session-key,k", boost::program_options::value<std::string>(&options.sessionKey)->required(), "hex session key stored for every replay account")
+    ("speed,s", boost::program_options::value<float>(&options.speed)->default_value(1.0f), "time scale of the capture, 2 replays twice as fast")
+    ("ramp-up,r", boost::program_options::value<uint32>(&options.rampUp)->default_value(100), "ms between the connects of two clients")
+    ("loop", boost::program_options::bool_switch(&options.loop), "restart a session when it is replayed")
+    ("create-characters", boost::program_options::bool_switch(&options.createCharacters), "create a character for accounts without one")
+    ("duration,d", boost::program_options::value<uint32>(&options.duration)->default_value(0), "seconds until the replay stops, 0 - once every session is replayed")
+    ("report", boost::program_options::value<uint32>(&options.reportInterval)->default_value(10), "seconds between two progress lines")
+    ("probe-interval", boost::program_options::value<uint32>(&options.probeInterval)->default_value(1000), "ms between two tick probes, 0 - none")
+    ("help,h", "prints usage");
+
+    boost::program_options::variables_map vm;
+
+    try
+    {
+        boost::program_options::store(boost::program_options::parse_command_line(argc, argv, desc), vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+
+        boost::program_options::notify(vm);
+    }
+    catch (boost::program_options::error const& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if (options.speed <= 0.0f || !options.reportInterval)
+    {
+        std::cerr << "ERROR: speed and report must be > 0" << std::endl;
+        return 1;
+    }
+
+    std::vector<CapturedSession> sessions;
+    if (!LoadCapture(options.logFile, sessions))
+        return 1;
+
+    if (!options.clients)
+        options.clients = uint32(sessions.size());
+
+    ReplayContext context(options, sessions);
+    context.sessionKey.SetHexStr(options.sessionKey.c_str());
+    for (size_t i = 0; i < sessions.size(); ++i)
+        if (sessions[i].playerGuid)
+            context.capturedGuids.emplace(sessions[i].playerGuid, i);
+
+    // one addon of the default UI, mangosd refuses a session without addon data
+    ByteBuffer addons;
+    addons << std::string("Blizzard_AuctionUI") << uint8(1) << uint32(0x4C1C776D) << uint32(0);
+    uLongf compressedSize = compressBound(uLong(addons.size()));
+    std::vector<uint8> compressed(compressedSize);
+    if (compress(compressed.data(), &compressedSize, addons.contents(), uLong(addons.size())) != Z_OK)
+    {
+        sLog.outError("Cannot compress the addon data");
+        return 1;
+    }
+    context.addonData << uint32(addons.size());
+    context.addonData.append(compressed.data(), compressedSize);
+
+    try
+    {
+        boost::asio::ip::tcp::resolver resolver(context.service);
+        context.endpoint = *resolver.resolve(boost::asio::ip::tcp::resolver::query(options.host, std::to_string(options.port)));
+    }
+    catch (boost::system::system_error const& e)
+    {
+        sLog.outError("Cannot resolve %s: %s", options.host.c_str(), e.what());
+        return 1;
+    }
+
+    context.clients.reserve(options.clients);
+    for (uint32 i = 0; i < options.clients; ++i)
+    {
+        context.clients.emplace_back(new ReplayClient(context, i));
+        context.clients.back()->Start(i * options.rampUp);
+    }
+
+    ReplayClock::time_point start = ReplayClock::now();
+    ReplayClock::time_point lastReport = start;
+
+    boost::asio::deadline_timer reportTimer(context.service);
+    std::function<void (boost::system::error_code const&)> onReport = [&](boost::system::error_code const& error)
+    {
+        if (error)
+            return;
+
+        ReplayClock::time_point now = ReplayClock::now();
+        uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::seconds>(now - start).count());
+        PrintInterval(context, elapsed, std::chrono::duration<double>(now - lastReport).count());
+        lastReport = now;
+
+        bool finished = std::all_of(context.clients.begin(), context.clients.end(), [](std::unique_ptr<ReplayClient> const& client) { return client->IsFinished(); });
+        if ((options.duration && elapsed >= options.duration) || (!options.duration && finished))
+        {
+            context.service.stop();
+            return;
+        }
+
+        reportTimer.expires_from_now(boost::posix_time::seconds(options.reportInterval));
+        reportTimer.async_wait(onReport);
+    };
+    reportTimer.expires_from_now(boost::posix_time::seconds(options.reportInterval));
+    reportTimer.async_wait(onReport);
+
+    // one client at a time, so the probes do not add load of their own
+    boost::asio::deadline_timer probeTimer(context.service);
+    size_t probeClient = 0;
+    std::function<void (boost::system::error_code const&)> onProbe = [&](boost::system::error_code const& error)
+    {
+        if (error)
+            return;
+
+        for (size_t i = 0; i < context.clients.size(); ++i)
+            if (context.clients[probeClient++ % context.clients.size()]->SendProbe())
+                break;
+
+        probeTimer.expires_from_now(boost::posix_time::milliseconds(options.probeInterval));
+        probeTimer.async_wait(onProbe);
+    };
+    if (options.probeInterval)
+    {
+        probeTimer.expires_from_now(boost::posix_time::milliseconds(options.probeInterval));
+        probeTimer.async_wait(onProbe);
+    }
+
+    context.service.run();
+
+    PrintReport(context, std::chrono::duration<double>(ReplayClock::now() - start).count());
+
+    for (auto& client : context.clients)
+        client->Stop();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_DENSEOBJECTMAP_H
+#define MANGOS_DENSEOBJECTMAP_H
+
+#include "Platform/Define.h"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/*
+ * @class DenseObjectMap keeps key/object pairs in one contiguous array, iteration walks that array.
+ * Keys are found by an open addressing table of array slots, a lookup usually reads one index entry
+ * and one pair instead of following the bucket list of an unordered_map.
+ * Erasing moves the last pair into the freed slot, so it invalidates iterators and changes the order.
+ */
+template<class KEY_TYPE, class OBJECT>
+class DenseObjectMap
+{
+    public:
+        typedef std::pair<KEY_TYPE, OBJECT*> value_type;
+        typedef typename std::vector<value_type>::iterator iterator;
+        typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+        DenseObjectMap() : m_mask(0) {}
+
+        iterator begin() { return m_values.begin(); }
+        iterator end() { return m_values.end(); }
+        const_iterator begin() const { return m_values.begin(); }
+        const_iterator end() const { return m_values.end(); }
+        size_t size() const { return m_values.size(); }
+        bool empty() const { return m_values.empty(); }
+
+        OBJECT* find(KEY_TYPE const& key) const
+        {
+            if (m_index.empty())
+                return nullptr;
+
+            for (size_t i = bucket(key); ; i = (i + 1) & m_mask)
+            {
+                uint32 slot = m_index[i];
+                if (slot == EMPTY_SLOT)
+                    return nullptr;
+                if (m_values[slot].first == key)
+                    return m_values[slot].second;
+            }
+        }
+
+        // false when the key is present already, the stored object is kept then
+        bool insert(KEY_TYPE const& key, OBJECT* obj)
+        {
+            if ((m_values.size() + 1) * 2 > m_index.size())
+                rehash(m_index.empty() ? MIN_INDEX_SIZE : m_index.size() * 2);
+
+            size_t i = bucket(key);
+            for (; m_index[i] != EMPTY_SLOT; i = (i + 1) & m_mask)
+                if (m_values[m_index[i]].first == key)
+                    return false;
+
+            m_index[i] = uint32(m_values.size());
+            m_values.emplace_back(key, obj);
+            return true;
+        }
+
+        bool erase(KEY_TYPE const& key)
+        {
+            if (m_index.empty())
+                return false;
+
+            size_t hole = bucket(key);
+            for (; ; hole = (hole + 1) & m_mask)
+            {
+                if (m_index[hole] == EMPTY_SLOT)
+                    return false;
+                if (m_values[m_index[hole]].first == key)
+                    break;
+            }
+
+            uint32 slot = m_index[hole];
+
+            // shift following entries of the probe run back, no tombstones needed
+            for (size_t j = (hole + 1) & m_mask; m_index[j] != EMPTY_SLOT; j = (j + 1) & m_mask)
+            {
+                size_t home = bucket(m_values[m_index[j]].first);
+                if (((j - home) & m_mask) >= ((j - hole) & m_mask))
+                {
+                    m_index[hole] = m_index[j];
+                    hole = j;
+                }
+            }
+            m_index[hole] = EMPTY_SLOT;
+
+            // keep the pairs contiguous, the last one takes the freed slot
+            uint32 last = uint32(m_values.size() - 1);
+            if (slot != last)
+            {
+                m_values[slot] = m_values[last];
+                size_t i = bucket(m_values[slot].first);
+                while (m_index[i] != last)
+                    i = (i + 1) & m_mask;
+                m_index[i] = slot;
+            }
+            m_values.pop_back();
+            return true;
+        }
+
+    private:
+        static constexpr uint32 EMPTY_SLOT = 0xFFFFFFFF;
+        static constexpr size_t MIN_INDEX_SIZE = 16;
+
+        size_t bucket(KEY_TYPE const& key) const
+        {
+            // spread sequential guids over the table
+            return size_t((uint64(std::hash<KEY_TYPE>()(key)) * 0x9E3779B97F4A7C15ULL) >> 32) & m_mask;
+        }
+
+        void rehash(size_t indexSize)
+        {
+            m_index.assign(indexSize, EMPTY_SLOT);
+            m_mask = indexSize - 1;
+            for (uint32 slot = 0; slot < m_values.size(); ++slot)
+            {
+                size_t i = bucket(m_values[slot].first);
+                while (m_index[i] != EMPTY_SLOT)
+                    i = (i + 1) & m_mask;
+                m_index[i] = slot;
+            }
+        }
+
+        std::vector<value_type> m_values;
+        std::vector<uint32> m_index;                        // power of two size, at most half full
+        size_t m_mask;
+};
+
+#endif
@@ -28,6 +28,9 @@
   a subtle difference between dynamic loader and on-demand loader but
   this is implementation specific to the loader class.  From the
   Grid's perspective, the loader meets its API requirement is suffice.
+  Every object entering or leaving the grid is also passed to the
+  POSITION_INDEX, which may keep packed positions of the types it cares
+  about for radius searches that do not walk the object lists.
 */
 
 #include "Platform/Define.h"
@@ -36,18 +39,19 @@
 #include "TypeContainerVisitor.h"
 
 // forward declaration
-template<class A, class T, class O> class GridLoader;
+template<class A, class T, class O, class P> class GridLoader;
 
 template
 <
     class ACTIVE_OBJECT,
     class WORLD_OBJECT_TYPES,
-    class GRID_OBJECT_TYPES
+    class GRID_OBJECT_TYPES,
+    class POSITION_INDEX
     >
 class Grid
 {
         // allows the GridLoader to access its internals
-        template<class A, class T, class O> friend class GridLoader;
+        template<class A, class T, class O, class P> friend class GridLoader;
 
     public:
 
@@ -61,6 +65,7 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool AddWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_positionIndex.Insert(obj);
             return i_objects.template insert<SPECIFIC_OBJECT>(obj);
         }
 
@@ -69,6 +74,7 @@ class Grid
         template<class SPECIFIC_OBJECT>
         bool RemoveWorldObject(SPECIFIC_OBJECT* obj)
         {
+            i_positionIndex.Remove(obj);
             return i_objects.template remove<SPECIFIC_OBJECT>(obj);
         }
 
@@ -103,6 +109,7 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.insert(obj);
 
+            i_positionIndex.Insert(obj);
             return i_container.template insert<SPECIFIC_OBJECT>(obj);
         }
 
@@ -114,15 +121,21 @@ class Grid
             if (obj->isActiveObject())
                 m_activeGridObjects.erase(obj);
 
+            i_positionIndex.Remove(obj);
             return i_container.template remove<SPECIFIC_OBJECT>(obj);
         }
 
+        /** Packed positions of the objects within the grid
+         */
+        const POSITION_INDEX& GetPositionIndex() const { return i_positionIndex; }
+
     private:
 
         TypeMapContainer<GRID_OBJECT_TYPES> i_container;
         TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
         typedef std::set<void*> ActiveGridObjects;
         ActiveGridObjects m_activeGridObjects;
+        POSITION_INDEX i_positionIndex;
 };
 
 #endif
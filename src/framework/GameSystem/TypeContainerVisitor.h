@@ -28,9 +28,55 @@
 #include "Platform/Define.h"
 #include "TypeContainer.h"
 
+#include <type_traits>
+
 // forward declaration
 template<class T, class Y> class TypeContainerVisitor;
 
+/*
+ * Compile time type masks. The users of the containers give every stored
+ * type a bit by specializing ContainerTypeMask, visitors declaring
+ * `static constexpr uint32 VisitMask` are only handed the lists of the
+ * types in their mask, the others are not even walked. Types and visitors
+ * without a mask match everything.
+ */
+template<class T>
+struct ContainerTypeMask
+{
+    static constexpr uint32 value = 0xFFFFFFFF;
+};
+
+template<>
+struct ContainerTypeMask<TypeNull>
+{
+    static constexpr uint32 value = 0;
+};
+
+template<class H, class T>
+struct ContainerTypeMask<TypeList<H, T> >
+{
+    static constexpr uint32 value = ContainerTypeMask<H>::value | ContainerTypeMask<T>::value;
+};
+
+template<class VISITOR, class = void>
+struct VisitorTypeMask
+{
+    static constexpr uint32 value = 0xFFFFFFFF;
+};
+
+template<class VISITOR>
+struct VisitorTypeMask<VISITOR, std::void_t<decltype(VISITOR::VisitMask)> >
+{
+    static constexpr uint32 value = VISITOR::VisitMask;
+};
+
+// true when the visitor cares for any of the types, TYPES is a single type or a TypeList
+template<class VISITOR, class TYPES>
+constexpr bool VisitorWants()
+{
+    return (VisitorTypeMask<std::remove_const_t<VISITOR> >::value & ContainerTypeMask<TYPES>::value) != 0;
+}
+
 // visitor helper
 template<class VISITOR, class TYPE_CONTAINER>
 void VisitorHelper(VISITOR& v, TYPE_CONTAINER& c)
@@ -47,7 +93,8 @@ void VisitorHelper(VISITOR& /*v*/, ContainerMapList<TypeNull>& /*c*/)
 template<class VISITOR, class T>
 void VisitorHelper(VISITOR& v, ContainerMapList<T>& c)
 {
-    v.Visit(c._element);
+    if constexpr (VisitorWants<VISITOR, T>())
+        v.Visit(c._element);
 }
 
 // recursion container map list
@@ -65,10 +112,18 @@ void VisitorHelper(VISITOR& v, TypeMapContainer<OBJECT_TYPES>& c)
     VisitorHelper(v, c.GetElements());
 }
 
+template<class OBJECT_TYPES>
+struct ContainerTypeMask<TypeMapContainer<OBJECT_TYPES> >
+{
+    static constexpr uint32 value = ContainerTypeMask<OBJECT_TYPES>::value;
+};
+
 template<class VISITOR, class TYPE_CONTAINER>
 class TypeContainerVisitor
 {
     public:
+        // false when the visitor has no use for any type of the container, callers may skip the walk to it
+        static constexpr bool IsNeeded = VisitorWants<VISITOR, TYPE_CONTAINER>();
 
         TypeContainerVisitor(VISITOR& v)
             : i_visitor(v)
@@ -21,6 +21,7 @@
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_sequence = 0;
     m_aborting = false;
 }
 
@@ -35,12 +36,11 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    while (!m_queue.empty() && m_queue.front().execTime <= m_time)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_queue.front().event;
+        RemoveAt(0);
 
         if (!Event->to_Abort)
         {
@@ -63,39 +63,38 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
+    // take the queue over so events added by Abort handlers don't disturb the walk
+    EventQueue events;
+    events.swap(m_queue);
+
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    for (QueueEntry const& entry : events)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
-        {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
-                m_events.erase(i_old);
-        }
+        BasicEvent* event = entry.event;
+        event->m_queueIndex = BasicEvent::NOT_QUEUED;
+        event->to_Abort = true;
+        event->Abort(m_time);
+        if (force || event->IsDeletable())
+            delete event;
+        else                                                // stays queued until its time to be deleted by Update
+            Push(entry);
     }
 
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
+    // keep the grown storage for later events
+    if (m_queue.empty())
+    {
+        events.clear();
+        m_queue.swap(events);
+    }
 }
 
 void EventProcessor::KillEvent(BasicEvent* event)
 {
-    for (EventList::iterator iter = m_events.begin(); iter != m_events.end();)
-    {
-        if (iter->second == event)
-        {
-            delete iter->second;
-            iter = m_events.erase(iter);
-        }
-        else ++iter;
-    }
+    if (!IsQueued(event))
+        return;
+
+    RemoveAt(event->m_queueIndex);
+    delete event;
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -104,24 +103,86 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    if (IsQueued(Event))
+        RemoveAt(Event->m_queueIndex);
+
+    Push({ e_time, m_sequence++, Event });
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* Event, uint64 msTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != Event)
-            continue;
+    if (!IsQueued(Event))
+        return;
 
-        Event->m_execTime = msTime;
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(msTime, Event));
-        break;
-    }
+    Event->m_execTime = msTime;
+    RemoveAt(Event->m_queueIndex);
+    Push({ msTime, m_sequence++, Event });
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::Push(QueueEntry const& entry)
+{
+    m_queue.push_back(entry);
+    entry.event->m_queueIndex = m_queue.size() - 1;
+    SiftUp(m_queue.size() - 1);
+}
+
+void EventProcessor::RemoveAt(size_t index)
+{
+    m_queue[index].event->m_queueIndex = BasicEvent::NOT_QUEUED;
+
+    size_t last = m_queue.size() - 1;
+    if (index != last)
+    {
+        Place(index, m_queue[last]);
+        m_queue.pop_back();
+        if (index > 0 && m_queue[index] < m_queue[(index - 1) / 2])
+            SiftUp(index);
+        else
+            SiftDown(index);
+    }
+    else
+        m_queue.pop_back();
+}
+
+void EventProcessor::SiftUp(size_t index)
+{
+    QueueEntry entry = m_queue[index];
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+        if (!(entry < m_queue[parent]))
+            break;
+
+        Place(index, m_queue[parent]);
+        index = parent;
+    }
+    Place(index, entry);
+}
+
+void EventProcessor::SiftDown(size_t index)
+{
+    QueueEntry entry = m_queue[index];
+    size_t size = m_queue.size();
+    while (true)
+    {
+        size_t child = index * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && m_queue[child + 1] < m_queue[child])
+            ++child;
+
+        if (!(m_queue[child] < entry))
+            break;
+
+        Place(index, m_queue[child]);
+        index = child;
+    }
+    Place(index, entry);
+}
@@ -21,7 +21,7 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
@@ -30,7 +30,7 @@ class BasicEvent
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_addTime(0), m_execTime(0), m_queueIndex(NOT_QUEUED)
         {
         }
 
@@ -53,9 +53,14 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
-};
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+    private:
+        friend class EventProcessor;
+
+        static constexpr size_t NOT_QUEUED = size_t(-1);
+
+        size_t m_queueIndex;                                // position in the owning processor queue, NOT_QUEUED while executing or idle
+};
 
 class EventProcessor
 {
@@ -70,12 +75,48 @@ class EventProcessor
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         void ModifyEventTime(BasicEvent* event, uint64 msTime);
         uint64 CalculateTime(uint64 t_offset) const;
-        EventList& GetEvents() { return m_events; }
+        bool Empty() const { return m_queue.empty(); }
+
+        // visits queued events in no particular order, the visitor must not add or remove events
+        template<typename Visitor>
+        void ForEachEvent(Visitor&& visitor) const
+        {
+            for (QueueEntry const& entry : m_queue)
+                visitor(entry.event);
+        }
 
     protected:
 
+        // Binary min heap ordered by execution time then by insertion order, each event knows its
+        // own position so kill and reschedule don't need a search and queueing allocates nothing
+        // once the vector has grown to the usual number of pending events of its owner
+        struct QueueEntry
+        {
+            uint64 execTime;
+            uint64 sequence;
+            BasicEvent* event;
+
+            bool operator<(QueueEntry const& other) const
+            {
+                return execTime != other.execTime ? execTime < other.execTime : sequence < other.sequence;
+            }
+        };
+
+        typedef std::vector<QueueEntry> EventQueue;
+
+        void Push(QueueEntry const& entry);
+        void RemoveAt(size_t index);
+        void SiftUp(size_t index);
+        void SiftDown(size_t index);
+        void Place(size_t index, QueueEntry const& entry) { m_queue[index] = entry; entry.event->m_queueIndex = index; }
+        bool IsQueued(BasicEvent const* event) const
+        {
+            return event->m_queueIndex < m_queue.size() && m_queue[event->m_queueIndex].event == event;
+        }
+
         uint64 m_time;
-        EventList m_events;
+        uint64 m_sequence;
+        EventQueue m_queue;
         bool m_aborting;
 };
 
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECTPOOL_H
+#define MANGOS_OBJECTPOOL_H
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace MaNGOS
+{
+    struct ObjectPoolStats
+    {
+        size_t inUse;                                       // live objects allocated through the pool
+        size_t cached;                                      // freed blocks kept in thread free lists
+        uint64 systemAllocations;                           // blocks taken from the global allocator
+        uint64 reuses;                                      // allocations served from a free list
+    };
+
+    // Per thread free lists of Size byte blocks, Tag keeps pools of different users apart.
+    // A block freed on another thread than the one allocating it joins the freeing thread list,
+    // frees over MaxCached blocks per thread go to the global allocator.
+    template <class Tag, size_t Size, size_t MaxCached = 4096>
+    class BlockPool
+    {
+        public:
+            static void* Allocate()
+            {
+                s_inUse.fetch_add(1, std::memory_order_relaxed);
+                FreeList& list = t_freeList;
+                if (FreeBlock* block = list.head)
+                {
+                    list.head = block->next;
+                    --list.count;
+                    s_cached.fetch_sub(1, std::memory_order_relaxed);
+                    s_reuses.fetch_add(1, std::memory_order_relaxed);
+                    return block;
+                }
+
+                s_systemAllocations.fetch_add(1, std::memory_order_relaxed);
+                return ::operator new(BlockSize);
+            }
+
+            static void Deallocate(void* ptr)
+            {
+                s_inUse.fetch_sub(1, std::memory_order_relaxed);
+                FreeList& list = t_freeList;
+                if (list.count >= MaxCached)
+                {
+                    ::operator delete(ptr);
+                    return;
+                }
+
+                FreeBlock* block = static_cast<FreeBlock*>(ptr);
+                block->next = list.head;
+                list.head = block;
+                ++list.count;
+                s_cached.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            static ObjectPoolStats GetStats()
+            {
+                return { s_inUse.load(std::memory_order_relaxed), s_cached.load(std::memory_order_relaxed),
+                    s_systemAllocations.load(std::memory_order_relaxed), s_reuses.load(std::memory_order_relaxed) };
+            }
+
+        private:
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            struct FreeList
+            {
+                FreeBlock* head = nullptr;
+                size_t count = 0;
+
+                ~FreeList()
+                {
+                    while (FreeBlock* block = head)
+                    {
+                        head = block->next;
+                        ::operator delete(block);
+                    }
+                    s_cached.fetch_sub(count, std::memory_order_relaxed);
+                    count = MaxCached;                      // objects freed later in thread exit go to the global allocator
+                }
+            };
+
+            static constexpr size_t BlockSize = Size < sizeof(FreeBlock) ? sizeof(FreeBlock) : Size;
+
+            static inline thread_local FreeList t_freeList;
+            static inline std::atomic<size_t> s_inUse{0};
+            static inline std::atomic<size_t> s_cached{0};
+            static inline std::atomic<uint64> s_systemAllocations{0};
+            static inline std::atomic<uint64> s_reuses{0};
+    };
+
+    // Base class allocating T from a BlockPool, derived classes of another size use the global allocator.
+    template <class T>
+    class PooledObject
+    {
+        public:
+            static void* operator new(size_t size)
+            {
+                if (size != sizeof(T))
+                    return ::operator new(size);
+                return BlockPool<PooledObject<T>, sizeof(T)>::Allocate();
+            }
+
+            static void operator delete(void* ptr, size_t size)
+            {
+                if (!ptr)
+                    return;
+
+                if (size != sizeof(T))
+                    ::operator delete(ptr);
+                else
+                    BlockPool<PooledObject<T>, sizeof(T)>::Deallocate(ptr);
+            }
+
+            static ObjectPoolStats GetPoolStats() { return BlockPool<PooledObject<T>, sizeof(T)>::GetStats(); }
+    };
+
+    // Standard allocator serving single element allocations from a BlockPool, meant for node based containers.
+    template <class T>
+    class PoolAllocator
+    {
+        public:
+            typedef T value_type;
+
+            PoolAllocator() noexcept {}
+            template <class U> PoolAllocator(PoolAllocator<U> const&) noexcept {}
+
+            T* allocate(size_t n)
+            {
+                if (n != 1)
+                    return static_cast<T*>(::operator new(n * sizeof(T)));
+                return static_cast<T*>(Pool::Allocate());
+            }
+
+            void deallocate(T* ptr, size_t n)
+            {
+                if (n != 1)
+                    ::operator delete(ptr);
+                else
+                    Pool::Deallocate(ptr);
+            }
+
+            static ObjectPoolStats GetPoolStats() { return Pool::GetStats(); }
+
+            template <class U> bool operator==(PoolAllocator<U> const&) const noexcept { return true; }
+            template <class U> bool operator!=(PoolAllocator<U> const&) const noexcept { return false; }
+
+        private:
+            typedef BlockPool<PoolAllocator<T>, sizeof(T)> Pool;
+    };
+}
+
+#endif
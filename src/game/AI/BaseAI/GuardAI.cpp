@@ -79,10 +79,10 @@ void GuardAI::MoveInLineOfSight(Unit* who)
     }
     else
     {
-        if (m_creature->CanInitiateAttack() && m_creature->CanAttackOnSight(who) && who->isInAccessablePlaceFor(m_creature))
+        // attack radius first, it rules out most units before relations, terrain and LoS are checked
+        if (m_creature->CanInitiateAttack() && m_creature->IsWithinDistInMap(who, m_creature->GetAttackDistance(who)))
         {
-            float attackRadius = m_creature->GetAttackDistance(who);
-            if (m_creature->IsWithinDistInMap(who, attackRadius) && m_creature->IsWithinLOSInMap(who, true))
+            if (m_creature->CanAttackOnSight(who) && who->isInAccessablePlaceFor(m_creature) && m_creature->IsWithinLOSInMap(who, true))
             {
                 AttackStart(who);
             }
@@ -123,10 +123,7 @@ void GuardianAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_EVADE))
+        CheckAndReadyEventForExecution(i);
     ProcessEvents();
 }
@@ -33,7 +33,7 @@ int TotemAI::Permissible(const Creature* creature)
     return PERMIT_BASE_NO;
 }
 
-TotemAI::TotemAI(Creature* creature) : CreatureEventAI(creature)
+TotemAI::TotemAI(Creature* creature) : CreatureEventAI(creature), m_targetSearchTimer(0)
 {
 }
 
@@ -47,11 +47,8 @@ void TotemAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_EVADE))
+        CheckAndReadyEventForExecution(i);
     ProcessEvents();
 }
 
@@ -62,6 +59,9 @@ void TotemAI::UpdateAI(const uint32 diff)
     if (getTotem().GetTotemType() != TOTEM_ACTIVE)
         return;
 
+    if (m_targetSearchTimer)
+        m_targetSearchTimer = m_targetSearchTimer > diff ? m_targetSearchTimer - diff : 0;
+
     if (!m_creature->IsAlive() || m_creature->IsNonMeleeSpellCasted(false))
         return;
 
@@ -92,9 +92,16 @@ void TotemAI::UpdateAI(const uint32 diff)
 
         if (maxRange != 0.0f)
         {
+            // an idle totem would otherwise scan the grid every tick while nothing is in range
+            if (m_targetSearchTimer)
+                return;
+
             MaNGOS::NearestAttackableUnitInObjectRangeCheck u_check(m_creature, m_creature->GetOwner(), maxRange);
             MaNGOS::UnitLastSearcher<MaNGOS::NearestAttackableUnitInObjectRangeCheck> checker(victim, u_check);
             Cell::VisitAllObjects(m_creature, checker, maxRange);
+
+            if (!victim)
+                m_targetSearchTimer = TOTEM_TARGET_SEARCH_INTERVAL;
         }
         else
             victim = m_creature;
@@ -27,6 +27,8 @@
 class Creature;
 class Totem;
 
+#define TOTEM_TARGET_SEARCH_INTERVAL 500                    // delay between grid searches of an active totem that found no target
+
 class TotemAI : public CreatureEventAI
 {
     public:
@@ -46,5 +48,6 @@ class TotemAI : public CreatureEventAI
 
     private:
         ObjectGuid i_victimGuid;
+        uint32 m_targetSearchTimer;
 };
 #endif
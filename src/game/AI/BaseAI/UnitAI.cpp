@@ -91,13 +91,18 @@ void UnitAI::MoveInLineOfSight(Unit* who)
     if (AssistPlayerInCombat(who))
         return;
 
+    // most units in the visited range are out of the attack radius, test it before relations and terrain
+    float attackRadius = m_unit->GetAttackDistance(who);
+    if (m_unit->GetDistance(who, true, DIST_CALC_NONE) > attackRadius * attackRadius)
+        return;
+
     if (!m_unit->CanAttackOnSight(who))
         return;
 
     if (!who->isInAccessablePlaceFor(m_unit))
         return;
 
-    DetectOrAttack(who);
+    DetectOrAttack(who, attackRadius);
 }
 
 void UnitAI::EnterCombat(Unit*)
@@ -520,12 +525,8 @@ void UnitAI::CheckForHelp(Unit* who, Unit* me, float distance)
     }
 }
 
-void UnitAI::DetectOrAttack(Unit* who)
+void UnitAI::DetectOrAttack(Unit* who, float attackRadius)
 {
-    float attackRadius = m_unit->GetAttackDistance(who);
-    if (m_unit->GetDistance(who, true, DIST_CALC_NONE) > attackRadius * attackRadius)
-        return;
-
     if (!m_unit->IsWithinLOSInMap(who, true))
         return;
 
@@ -1140,6 +1141,8 @@ bool UnitAI::IsEligibleForDistancing() const
 
 void UnitAI::SpellListChanged()
 {
+    m_spellListCandidates.clear();                          // points into the replaced list
+
     CreatureSpellList const& spells = GetSpellList();
     if (spells.Disabled)
         return;
@@ -1149,6 +1152,12 @@ void UnitAI::SpellListChanged()
         {
             AddMainSpell(data.second.SpellId);
         }
+
+        // spells never cast by AI are dropped here instead of being skipped every update
+        if (data.second.DisabledForAI)
+            continue;
+
+        m_spellListCandidates.push_back({ &data.second, sSpellTemplate.LookupEntry<SpellEntry>(data.second.SpellId) });
     }
     if (!spells.Spells.empty())
         m_spellListCooldown = false;
@@ -1173,15 +1182,15 @@ void UnitAI::UpdateSpellLists()
     std::vector<std::tuple<uint32, uint32, uint32, Unit*>> eligibleSpells;
     uint32 sum = 0;
 
+    // targeting entry, range, result and target of selections usable by every spell with the same targeting and range
+    std::vector<std::tuple<CreatureSpellListTargeting const*, float, bool, Unit*>> sharedTargets;
+
     // one roll due to multiple spells
     uint32 supportActionRoll = urand(0, 100);
     uint32 rangedActionRoll = urand(0, 100);
-    for (auto& data : spells.Spells)
+    for (SpellListCandidate const& candidate : m_spellListCandidates)
     {
-        CreatureSpellListSpell const& spell = data.second;
-
-        if (spell.DisabledForAI)
-            continue;
+        CreatureSpellListSpell const& spell = *candidate.spell;
 
         if (spell.Flags & SPELL_LIST_FLAG_SUPPORT_ACTION)
             if (supportActionRoll > spells.ChanceSupportAction)
@@ -1193,11 +1202,27 @@ void UnitAI::UpdateSpellLists()
             if (rangedActionRoll > (GetCurrentRangedMode() ? spells.ChanceRangedAttack : std::max((int32(spells.ChanceRangedAttack) - 50), 0)))
                 continue;
 
-        if (!m_unit->IsSpellReady(spell.SpellId))
+        if (!m_unit->IsSpellReady(*candidate.spellInfo))
             continue;
 
         bool result; Unit* target;
-        std::tie(result, target) = ChooseTarget(spell.Target, spell.SpellId);
+        float range;
+        if (GetSharedTargetingRange(spell.Target, candidate.spellInfo, range))
+        {
+            auto itr = std::find_if(sharedTargets.begin(), sharedTargets.end(), [&](std::tuple<CreatureSpellListTargeting const*, float, bool, Unit*> const& shared)
+            {
+                return std::get<0>(shared) == spell.Target && std::get<1>(shared) == range;
+            });
+            if (itr != sharedTargets.end())
+                std::tie(std::ignore, std::ignore, result, target) = *itr;
+            else
+            {
+                std::tie(result, target) = ChooseTarget(spell.Target, spell.SpellId);
+                sharedTargets.emplace_back(spell.Target, range, result, target);
+            }
+        }
+        else
+            std::tie(result, target) = ChooseTarget(spell.Target, spell.SpellId);
         if (!result)
             continue;
 
@@ -1306,6 +1331,30 @@ std::pair<bool, Unit*> UnitAI::ChooseTarget(CreatureSpellListTargeting* targetDa
     return { result, target };
 }
 
+bool UnitAI::GetSharedTargetingRange(CreatureSpellListTargeting const* targetData, SpellEntry const* spellInfo, float& range) const
+{
+    switch (targetData->Type)
+    {
+        case SPELL_LIST_TARGETING_HARDCODED:
+            switch (targetData->Id)
+            {
+                case SPELL_LIST_TARGET_NONE:
+                case SPELL_LIST_TARGET_CURRENT:
+                case SPELL_LIST_TARGET_SELF:
+                case SPELL_LIST_TARGET_CURRENT_NOT_ALONE:
+                    range = 0.f;
+                    return true;
+                default:                                    // dispel and buff checks are spell specific
+                    return false;
+            }
+        case SPELL_LIST_TARGETING_SUPPORT:
+            range = CalculateSpellRange(spellInfo);
+            return true;
+        default:                                            // attacking target selection checks the spell itself
+            return false;
+    }
+}
+
 void UnitAI::AddInitialCooldowns()
 {
     CreatureSpellList const& spells = GetSpellList();
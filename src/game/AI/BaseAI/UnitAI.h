@@ -38,6 +38,7 @@ struct SpellEntry;
 class ChatHandler;
 class Spell;
 struct CreatureSpellListTargeting;
+struct CreatureSpellListSpell;
 struct CreatureSpellList;
 
 #define TIME_INTERVAL_LOOK   5000
@@ -425,7 +426,7 @@ class UnitAI : public CombatActions
         virtual void OnUnsummon() {}
 
         void CheckForHelp(Unit* /*who*/, Unit* /*me*/, float /*dist*/);
-        void DetectOrAttack(Unit* who);
+        void DetectOrAttack(Unit* who, float attackRadius);     // who must be within attackRadius
         bool CanTriggerStealthAlert(Unit* who, float attackRadius) const;
 
         virtual void HandleMovementOnAttackStart(Unit* victim, bool targetChange) const;
@@ -551,6 +552,8 @@ class UnitAI : public CombatActions
         void SpellListChanged();
         void UpdateSpellLists();
         std::pair<bool, Unit*> ChooseTarget(CreatureSpellListTargeting* targetData, uint32 spellId) const;
+        // true when the targeting result depends on the spell only through range, those results are shared within one update
+        bool GetSharedTargetingRange(CreatureSpellListTargeting const* targetData, SpellEntry const* spellInfo, float& range) const;
         virtual CreatureSpellList const& GetSpellList() const = 0;
         void AddInitialCooldowns();
 
@@ -613,6 +616,13 @@ class UnitAI : public CombatActions
 
         // Spell Lists
         bool m_spellListCooldown;
+
+        struct SpellListCandidate
+        {
+            CreatureSpellListSpell const* spell;
+            SpellEntry const* spellInfo;
+        };
+        std::vector<SpellListCandidate> m_spellListCandidates;  // spells of the owner list usable by AI in position order, set by SpellListChanged
 };
 
 struct SelectableAI : public FactoryHolder<UnitAI>, public Permissible<Creature>
@@ -108,6 +108,7 @@ CreatureEventAI::CreatureEventAI(Creature* creature) : CreatureAI(creature),
 
 void CreatureEventAI::InitAI()
 {
+    ClearEventTypeIndex();
     m_CreatureEventAIList.clear();
     m_distanceSpells.clear();
     m_mainSpells.clear();
@@ -186,9 +187,12 @@ void CreatureEventAI::InitAI()
         }
     };
 
-    // Need make copy for filter unneeded steps and safe in case table reload
-    auto creatureEventsItr = m_creature->GetMap()->GetMapDataContainer().GetCreatureEventEntryAIMap()->find(m_creature->GetEntry());
-    if (creatureEventsItr != m_creature->GetMap()->GetMapDataContainer().GetCreatureEventEntryAIMap()->end())
+    // Holders only keep the per instance state and point into the shared tables, which are held here so a table reload cannot free them
+    m_eventEntryMap = m_creature->GetMap()->GetMapDataContainer().GetCreatureEventEntryAIMap();
+    m_eventGuidMap = m_creature->GetMap()->GetMapDataContainer().GetCreatureEventGuidAIMap();
+
+    auto creatureEventsItr = m_eventEntryMap->find(m_creature->GetEntry());
+    if (creatureEventsItr != m_eventEntryMap->end())
     {
         const CreatureEventAI_Event_Vec& creatureEvent = creatureEventsItr->second;
         processMap(creatureEvent);
@@ -196,12 +200,29 @@ void CreatureEventAI::InitAI()
 
     if (m_creature->GetDbGuid() == 5026)
         printf("");
-    auto creatureEventsGuidItr = m_creature->GetMap()->GetMapDataContainer().GetCreatureEventGuidAIMap()->find(m_creature->GetDbGuid());
-    if (creatureEventsGuidItr != m_creature->GetMap()->GetMapDataContainer().GetCreatureEventGuidAIMap()->end())
+    auto creatureEventsGuidItr = m_eventGuidMap->find(m_creature->GetDbGuid());
+    if (creatureEventsGuidItr != m_eventGuidMap->end())
     {
         const CreatureEventAI_Event_Vec& creatureEvent = creatureEventsGuidItr->second;
         processMap(creatureEvent);
     }
+
+    // Index only after both maps were processed, the second one may reallocate the list
+    BuildEventTypeIndex();
+}
+
+void CreatureEventAI::BuildEventTypeIndex()
+{
+    ClearEventTypeIndex();
+    for (auto& i : m_CreatureEventAIList)
+        if (i.event.event_type < EVENT_T_END)
+            m_eventTypeHolders[i.event.event_type].push_back(i);
+}
+
+void CreatureEventAI::ClearEventTypeIndex()
+{
+    for (auto& holders : m_eventTypeHolders)
+        holders.clear();
 }
 
 bool CreatureEventAI::IsTimerExecutedEvent(EventAI_Type type) const
@@ -1495,11 +1516,8 @@ void CreatureEventAI::Reset()
 void CreatureEventAI::JustReachedHome()
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_REACHED_HOME)
-            CheckAndReadyEventForExecution(i);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_REACHED_HOME))
+        CheckAndReadyEventForExecution(i);
     ProcessEvents();
 
     Reset();
@@ -1511,11 +1529,8 @@ void CreatureEventAI::EnterEvadeMode()
 
     // Handle Evade events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_EVADE)
-            CheckAndReadyEventForExecution(i);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_EVADE))
+        CheckAndReadyEventForExecution(i);
     ProcessEvents();
 
     if ((m_despawnAggregationMask & AGGREGATION_EVADE) != 0)
@@ -1532,11 +1547,8 @@ void CreatureEventAI::JustDied(Unit* killer)
 
     // Handle On Death events
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_DEATH)
-            CheckAndReadyEventForExecution(i, killer);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_DEATH))
+        CheckAndReadyEventForExecution(i, killer);
     ProcessEvents(killer);
 
     // reset phase after any death state events
@@ -1549,22 +1561,16 @@ void CreatureEventAI::JustDied(Unit* killer)
 void CreatureEventAI::KilledUnit(Unit* victim)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_KILL)
-            CheckAndReadyEventForExecution(i, victim);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_KILL))
+        CheckAndReadyEventForExecution(i, victim);
     ProcessEvents(victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_UNIT)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_SUMMONED_UNIT))
+        CheckAndReadyEventForExecution(i, summoned);
     ProcessEvents(summoned);
     if ((m_despawnAggregationMask & AGGREGATION_ENABLED) != 0)
         if (m_entriesForDespawn.empty() || m_entriesForDespawn.find(summoned->GetEntry()) != m_entriesForDespawn.end())
@@ -1574,22 +1580,16 @@ void CreatureEventAI::JustSummoned(Creature* summoned)
 void CreatureEventAI::SummonedCreatureJustDied(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_SUMMONED_JUST_DIED))
+        CheckAndReadyEventForExecution(i, summoned);
     ProcessEvents(summoned);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* summoned)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-    {
-        if (i.event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            CheckAndReadyEventForExecution(i, summoned);
-    }
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_SUMMONED_JUST_DESPAWN))
+        CheckAndReadyEventForExecution(i, summoned);
     ProcessEvents(summoned);
 }
 
@@ -1598,10 +1598,9 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Unit* sender, Unit*
     MANGOS_ASSERT(sender);
 
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    for (CreatureEventAIHolder& itr : GetEventsOfType(EVENT_T_RECEIVE_AI_EVENT))
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-                itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
+        if (itr.event.receiveAIEvent.eventType == uint32(eventType) && (!itr.event.receiveAIEvent.senderEntry || itr.event.receiveAIEvent.senderEntry == sender->GetEntry()))
             CheckAndReadyEventForExecution(itr, invoker, sender);
     }
     ProcessEvents(invoker, sender);
@@ -1658,24 +1657,21 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     IncreaseDepthIfNecessary();
     if (m_HasOOCLoSEvent && !m_creature->GetVictim())
     {
-        for (auto& itr : m_CreatureEventAIList)
+        for (CreatureEventAIHolder& itr : GetEventsOfType(EVENT_T_OOC_LOS))
         {
-            if (itr.event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)itr.event.ooc_los.maxRange;
 
-                // who must be player type if this option is turned on
-                if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            // who must be player type if this option is turned on
+            if (!itr.event.ooc_los.playerOnly || who->GetTypeId() == TYPEID_PLAYER)
+            {
+                // if friendly event && who is not hostile OR hostile event && who is hostile
+                if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
+                        ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
                 {
-                    // if friendly event && who is not hostile OR hostile event && who is hostile
-                    if ((itr.event.ooc_los.noHostile && !m_creature->IsEnemy(who)) ||
-                            ((!itr.event.ooc_los.noHostile) && m_creature->IsEnemy(who)))
-                    {
-                        // if range is ok and we are actually in LOS
-                        if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                            CheckAndReadyEventForExecution(itr, who);
-                    }
+                    // if range is ok and we are actually in LOS
+                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+                        CheckAndReadyEventForExecution(itr, who);
                 }
             }
         }
@@ -1688,12 +1684,11 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
-                if (spellInfo->SchoolMask & i.event.spell_hit.schoolMask)
-                    CheckAndReadyEventForExecution(i, unit);
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_SPELLHIT))
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit.spellId || spellInfo->Id == i.event.spell_hit.spellId)
+            if (spellInfo->SchoolMask & i.event.spell_hit.schoolMask)
+                CheckAndReadyEventForExecution(i, unit);
 
     ProcessEvents(unit);
 }
@@ -1701,12 +1696,11 @@ void CreatureEventAI::SpellHit(Unit* unit, const SpellEntry* spellInfo)
 void CreatureEventAI::SpellHitTarget(Unit* target, const SpellEntry* spellInfo)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_SPELLHIT_TARGET)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
-                if (spellInfo->SchoolMask & i.event.spell_hit_target.schoolMask)
-                    CheckAndReadyEventForExecution(i, target);
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_SPELLHIT_TARGET))
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!i.event.spell_hit_target.spellId || spellInfo->Id == i.event.spell_hit_target.spellId)
+            if (spellInfo->SchoolMask & i.event.spell_hit_target.schoolMask)
+                CheckAndReadyEventForExecution(i, target);
 
     ProcessEvents(target);
 }
@@ -1849,15 +1843,12 @@ inline Unit* CreatureEventAI::GetTargetByType(uint32 target, Unit* actionInvoker
 void CreatureEventAI::ReceiveEmote(Player* player, uint32 textEmote)
 {
     IncreaseDepthIfNecessary();
-    for (auto& itr : m_CreatureEventAIList)
+    for (CreatureEventAIHolder& itr : GetEventsOfType(EVENT_T_RECEIVE_EMOTE))
     {
-        if (itr.event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if (itr.event.receive_emote.emoteId != textEmote)
-                continue;
+        if (itr.event.receive_emote.emoteId != textEmote)
+            continue;
 
-            CheckAndReadyEventForExecution(itr, player);
-        }
+        CheckAndReadyEventForExecution(itr, player);
     }
     ProcessEvents(player);
 }
@@ -1899,10 +1890,8 @@ void CreatureEventAI::DamageTaken(Unit* dealer, uint32& damage, DamageEffectType
 void CreatureEventAI::JustPreventedDeath(Unit* attacker)
 {
     IncreaseDepthIfNecessary();
-    for (auto& i : m_CreatureEventAIList)
-        if (i.event.event_type == EVENT_T_DEATH_PREVENTED)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            CheckAndReadyEventForExecution(i, attacker);
+    for (CreatureEventAIHolder& i : GetEventsOfType(EVENT_T_DEATH_PREVENTED))
+        CheckAndReadyEventForExecution(i, attacker);
 
     ProcessEvents(attacker);
 }
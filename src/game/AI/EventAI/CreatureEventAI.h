@@ -834,9 +834,9 @@ typedef std::unordered_map<uint32, CreatureEventAI_Summon> CreatureEventAI_Summo
 
 struct CreatureEventAIHolder
 {
-    CreatureEventAIHolder(CreatureEventAI_Event p) : event(p), timer(0), enabled(true), inProgress(false), eventTarget(nullptr) {}
+    CreatureEventAIHolder(CreatureEventAI_Event const& p) : event(p), timer(0), enabled(true), inProgress(false), eventTarget(nullptr) {}
 
-    CreatureEventAI_Event event;
+    CreatureEventAI_Event const& event;                     // Shared by all instances, kept alive by CreatureEventAI::m_eventEntryMap/m_eventGuidMap
     uint32 timer;
     bool enabled;
     bool inProgress;
@@ -854,6 +854,7 @@ class CreatureEventAI : public CreatureAI
         ~CreatureEventAI()
         {
             m_CreatureEventAIList.clear();
+            ClearEventTypeIndex();
         }
         void InitAI();
 
@@ -906,6 +907,12 @@ class CreatureEventAI : public CreatureAI
         bool IsRepeatableEvent(EventAI_Type type) const;
         bool IsTimerBasedEvent(EventAI_Type type) const;
 
+        // Holders indexed by event type, so single event hooks do not scan the whole list
+        typedef std::vector<std::reference_wrapper<CreatureEventAIHolder>> CreatureEventAIRefList;
+        CreatureEventAIRefList& GetEventsOfType(EventAI_Type type) { return m_eventTypeHolders[type]; }
+        void BuildEventTypeIndex();
+        void ClearEventTypeIndex();
+
         uint32 m_EventUpdateTime;                           // Time between event updates
         uint32 m_EventDiff;                                 // Time between the last event call
         bool   m_bEmptyList;
@@ -913,7 +920,10 @@ class CreatureEventAI : public CreatureAI
         // Variables used by Events themselves
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
+        std::shared_ptr<CreatureEventAI_Event_Map> m_eventEntryMap; // Event tables the holders point into, kept over a table reload
+        std::shared_ptr<CreatureEventAI_Event_Map> m_eventGuidMap;
         std::vector<std::vector<std::reference_wrapper<CreatureEventAIHolder>>> m_creatureEventAITempList; // Holder for events that are ready to go off
+        CreatureEventAIRefList m_eventTypeHolders[EVENT_T_END]; // Holders of m_CreatureEventAIList per event type, rebuilt in InitAI
         uint32 m_depth;
 
         uint8  m_Phase;                                     // Current phase, max 32 phases
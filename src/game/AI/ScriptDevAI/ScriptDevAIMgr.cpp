@@ -3,6 +3,7 @@
 * Please see the included DOCS/LICENSE.TXT for more information */
 
 #include "include/sc_common.h"
+#include "AI/ScriptDevAI/ScriptProfiler.h"
 #include "Policies/Singleton.h"
 #include "Config/Config.h"
 #include "Database/DatabaseEnv.h"
@@ -169,6 +170,7 @@ bool ScriptDevAIMgr::OnGossipHello(Player* pPlayer, Creature* pCreature)
 
     pPlayer->GetPlayerMenu()->ClearMenus();
 
+    ScriptProfileScope profile(SCRIPT_PROFILE_GOSSIP, pCreature->GetScriptId(), pCreature->GetMapId());
     return pTempScript->pGossipHello(pPlayer, pCreature);
 }
 
@@ -181,6 +183,7 @@ bool ScriptDevAIMgr::OnGossipHello(Player* pPlayer, GameObject* pGo)
 
     pPlayer->GetPlayerMenu()->ClearMenus();
 
+    ScriptProfileScope profile(SCRIPT_PROFILE_GOSSIP, pGo->GetGOInfo()->ScriptId, pGo->GetMapId());
     return pTempScript->pGossipHelloGO(pPlayer, pGo);
 }
 
@@ -193,6 +196,7 @@ bool ScriptDevAIMgr::OnGossipSelect(Player* pPlayer, Creature* pCreature, uint32
     if (!pTempScript)
         return false;
 
+    ScriptProfileScope profile(SCRIPT_PROFILE_GOSSIP, pCreature->GetScriptId(), pCreature->GetMapId());
     if (code)
     {
         if (!pTempScript->pGossipSelectWithCode)
@@ -218,6 +222,7 @@ bool ScriptDevAIMgr::OnGossipSelect(Player* pPlayer, GameObject* pGo, uint32 uiS
     if (!pTempScript)
         return false;
 
+    ScriptProfileScope profile(SCRIPT_PROFILE_GOSSIP, pGo->GetGOInfo()->ScriptId, pGo->GetMapId());
     if (code)
     {
         if (!pTempScript->pGossipSelectGOWithCode)
@@ -579,6 +584,15 @@ void ScriptDevAIMgr::CheckScriptNames()
     outstring_log(">> Loaded %i C++ Scripts.", m_scriptCount);
 }
 
+std::string ScriptDevAIMgr::GetScriptNamesKey() const
+{
+    std::string names;
+    for (std::string const& name : m_scriptNames)
+        names += name + ',';
+
+    return std::to_string(m_scriptNames.size()) + ':' + std::to_string(std::hash<std::string>()(names));
+}
+
 uint32 ScriptDevAIMgr::GetScriptId(const char* name) const
 {
     // use binary search to find the script name in the sorted vector
@@ -169,6 +169,8 @@ class ScriptDevAIMgr
         const char* GetScriptName(uint32 id) const { return id < m_scriptNames.size() ? m_scriptNames[id].c_str() : ""; }
         uint32 GetScriptId(const char* name) const;
         uint32 GetScriptIdsCount() const { return m_scriptNames.size(); }
+        // changes whenever script ids get assigned differently, for caches holding script ids
+        std::string GetScriptNamesKey() const;
 
         UnitAI* GetCreatureAI(Creature* pCreature) const;
         GameObjectAI* GetGameObjectAI(GameObject* gameobject) const;
@@ -0,0 +1,74 @@
+/* This file is part of the ScriptDev2 Project. See AUTHORS file for Copyright information
+ * This program is free software licensed under GPL version 2
+ * Please see the included DOCS/LICENSE.TXT for more information */
+
+#include "AI/ScriptDevAI/ScriptProfiler.h"
+#include "Policies/Singleton.h"
+#include "World/World.h"
+
+#include <mutex>
+
+ScriptProfiler& ScriptProfiler::Instance()
+{
+    static ScriptProfiler instance;
+    return instance;
+}
+
+bool ScriptProfiler::ShouldSample()
+{
+    uint32 rate = sWorld.getConfig(CONFIG_UINT32_SCRIPT_PROFILE_SAMPLE_RATE);
+    if (!rate)
+        return false;
+
+    // every thread counts its own calls, no shared state for the calls not sampled
+    static thread_local uint32 calls = 0;
+    return ++calls % rate == 0;
+}
+
+void ScriptProfiler::Record(Key const& key, uint64 us)
+{
+    Entry* entry = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_entriesLock);
+        auto itr = m_entries.find(key);
+        if (itr != m_entries.end())
+            entry = itr->second.get();
+    }
+
+    if (!entry)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_entriesLock);
+        std::unique_ptr<Entry>& created = m_entries[key];
+        if (!created)
+            created.reset(new Entry());
+        entry = created.get();
+    }
+
+    for (auto& histogram : entry->histograms)
+        histogram.Record(us);
+}
+
+void ScriptProfiler::GetSnapshots(Range range, std::vector<std::pair<Key, LatencyHistogram::Snapshot>>& snapshots, bool reset)
+{
+    std::shared_lock<std::shared_mutex> lock(m_entriesLock);
+    for (auto& entry : m_entries)
+    {
+        LatencyHistogram::Snapshot snapshot;
+        entry.second->histograms[range].GetSnapshot(snapshot, reset);
+        if (snapshot.count)
+            snapshots.emplace_back(entry.first, snapshot);
+    }
+}
+
+void ScriptProfiler::Reset()
+{
+    std::shared_lock<std::shared_mutex> lock(m_entriesLock);
+    for (auto& entry : m_entries)
+        entry.second->histograms[RANGE_TOTAL].Reset();
+}
+
+char const* ScriptProfiler::GetHookName(ScriptProfileHook hook)
+{
+    static char const* hookNames[SCRIPT_PROFILE_HOOK_COUNT] = { "UpdateAI", "JustDied", "Gossip", "InstanceUpdate" };
+    return hook < SCRIPT_PROFILE_HOOK_COUNT ? hookNames[hook] : "Unknown";
+}
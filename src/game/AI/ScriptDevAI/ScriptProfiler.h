@@ -0,0 +1,110 @@
+/* This file is part of the ScriptDev2 Project. See AUTHORS file for Copyright information
+ * This program is free software licensed under GPL version 2
+ * Please see the included DOCS/LICENSE.TXT for more information */
+
+#ifndef SC_SCRIPTPROFILER_H
+#define SC_SCRIPTPROFILER_H
+
+#include "Common.h"
+#include "Server/OpcodeStats.h"
+#include "World/TickWatchdog.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+enum ScriptProfileHook
+{
+    SCRIPT_PROFILE_UPDATE_AI,
+    SCRIPT_PROFILE_JUST_DIED,
+    SCRIPT_PROFILE_GOSSIP,
+    SCRIPT_PROFILE_INSTANCE_UPDATE,
+    SCRIPT_PROFILE_HOOK_COUNT
+};
+
+// Sampled execution time of ScriptDevAI hooks per script, map and hook, see ScriptProfile.SampleRate
+class ScriptProfiler
+{
+    public:
+        static ScriptProfiler& Instance();
+
+        // total - since the last reset, interval - since the last metrics report
+        enum Range
+        {
+            RANGE_TOTAL,
+            RANGE_INTERVAL,
+            RANGE_COUNT
+        };
+
+        struct Key
+        {
+            uint32 scriptId;
+            uint32 mapId;
+            ScriptProfileHook hook;
+
+            bool operator<(Key const& other) const
+            {
+                if (scriptId != other.scriptId)
+                    return scriptId < other.scriptId;
+                if (mapId != other.mapId)
+                    return mapId < other.mapId;
+                return hook < other.hook;
+            }
+        };
+
+        // true for the calls picked by the sample rate on the calling thread
+        static bool ShouldSample();
+
+        void Record(Key const& key, uint64 us);
+        void GetSnapshots(Range range, std::vector<std::pair<Key, LatencyHistogram::Snapshot>>& snapshots, bool reset);
+        void Reset();
+
+        static char const* GetHookName(ScriptProfileHook hook);
+
+    private:
+        struct Entry
+        {
+            LatencyHistogram histograms[RANGE_COUNT];
+        };
+
+        ScriptProfiler() {}
+
+        // entries are only added, so a recorded entry stays valid after the lookup lock is released
+        std::map<Key, std::unique_ptr<Entry>> m_entries;
+        mutable std::shared_mutex m_entriesLock;
+};
+
+#define sScriptProfiler ScriptProfiler::Instance()
+
+// Measures the enclosing scope when the call is sampled, and names it in slow tick reports
+class ScriptProfileScope
+{
+    public:
+        ScriptProfileScope(ScriptProfileHook hook, uint32 scriptId, uint32 mapId) : m_frame(WATCHDOG_FRAME_SCRIPT, ScriptProfiler::GetHookName(hook), scriptId),
+            m_sampled(scriptId && ScriptProfiler::ShouldSample())
+        {
+            if (!m_sampled)
+                return;
+
+            m_key = { scriptId, mapId, hook };
+            m_start = std::chrono::steady_clock::now();
+        }
+
+        ~ScriptProfileScope()
+        {
+            if (m_sampled)
+                sScriptProfiler.Record(m_key, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+        ScriptProfileScope(ScriptProfileScope const&) = delete;
+        ScriptProfileScope& operator=(ScriptProfileScope const&) = delete;
+
+    private:
+        WatchdogFrame m_frame;
+        bool m_sampled;
+        ScriptProfiler::Key m_key;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
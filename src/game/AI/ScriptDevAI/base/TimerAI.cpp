@@ -17,71 +17,96 @@
 #include "TimerAI.h"
 #include "Chat/Chat.h"
 #include "Log.h"
+#include <algorithm>
 #include <string>
 
 Timer::Timer(uint32 id, std::function<void()> functor, uint32 timerMin, uint32 timerMax, bool disabled)
-    : id(id), timer(urand(timerMin, timerMax)), disabled(disabled), functor(functor), initialMin(timerMin), initialMax(timerMax), initialDisabled(disabled)
+    : id(id), deadline(0), generation(0), disabled(disabled), functor(functor), initialMin(timerMin), initialMax(timerMax), initialDisabled(disabled)
     {}
 
-bool Timer::UpdateTimer(const uint32 diff)
+void TimerQueue::Schedule(Timer& timer, uint32 delay)
 {
-    if (disabled)
-        return false;
-
-    if (timer <= diff)
-    {
-        timer = 0;
-        disabled = true;
-        return true;
-    }
-    else timer -= diff;
-
-    return false;
-}
+    timer.deadline = m_now + delay;
+    ++timer.generation;
+    if (timer.disabled)
+        return;
 
-void Timer::ResetTimer()
-{
-    timer = urand(initialMin, initialMax);
-    disabled = initialDisabled;
+    m_heap.push_back({ timer.deadline, timer.id, timer.generation });
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
 }
 
-bool CombatTimer::UpdateTimer(const uint32 diff, bool combat)
+void TimerQueue::Update(const uint32 diff, std::map<uint32, Timer>& timers)
 {
-    if (disabled)
-        return false;
+    m_now += diff;
 
-    if (this->combat && !combat)
-        return false;
+    m_expired.clear();
+    while (!m_heap.empty() && m_heap.front().deadline <= m_now)
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
+        m_expired.push_back(m_heap.back());
+        m_heap.pop_back();
+    }
 
-    if (timer <= diff)
+    if (!m_expired.empty())
     {
-        timer = 0;
-        disabled = true;
-        return true;
+        std::sort(m_expired.begin(), m_expired.end(), [](Entry const& a, Entry const& b) { return a.id < b.id; });
+
+        // functors may add timers or reschedule later ones of this batch, every timer is looked up again
+        std::vector<Entry> expired;
+        expired.swap(m_expired);
+        for (Entry const& entry : expired)
+        {
+            auto data = timers.find(entry.id);
+            if (data == timers.end())
+                continue;
+
+            Timer& timer = data->second;
+            if (timer.disabled || timer.generation != entry.generation)
+                continue;
+
+            timer.disabled = true;
+            ++timer.generation;
+            timer.functor();
+        }
+        expired.clear();
+        if (m_expired.empty())
+            m_expired.swap(expired);
     }
-    else timer -= diff;
 
-    return false;
+    // entries of rescheduled timers stay until their old deadline, rebuild when they pile up
+    if (m_heap.size() > timers.size() * 4 + 16)
+        Compact(timers);
+}
+
+void TimerQueue::Compact(std::map<uint32, Timer> const& timers)
+{
+    m_heap.clear();
+    for (auto const& data : timers)
+        if (!data.second.disabled)
+            m_heap.push_back({ data.second.deadline, data.second.id, data.second.generation });
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Entry>());
 }
 
 void TimerManager::AddTimer(uint32 id, Timer&& timer)
 {
-    m_timers.emplace(id, timer);
+    auto result = m_timers.emplace(id, timer);
+    if (result.second)
+        m_timerQueue.Schedule(result.first->second, urand(timer.initialMin, timer.initialMax));
 }
 
 void TimerManager::AddCustomAction(uint32 id, bool disabled, std::function<void()> functor)
 {
-    m_timers.emplace(id, Timer(id, functor, 0, 0, disabled));
+    AddTimer(id, Timer(id, functor, 0, 0, disabled));
 }
 
 void TimerManager::AddCustomAction(uint32 id, uint32 timer, std::function<void()> functor)
 {
-    m_timers.emplace(id, Timer(id, functor, timer, timer, false));
+    AddTimer(id, Timer(id, functor, timer, timer, false));
 }
 
 void TimerManager::AddCustomAction(uint32 id, uint32 timerMin, uint32 timerMax, std::function<void()> functor)
 {
-    m_timers.emplace(id, Timer(id, functor, timerMin, timerMax, false));
+    AddTimer(id, Timer(id, functor, timerMin, timerMax, false));
 }
 
 void TimerManager::ResetTimer(uint32 index, uint32 timer)
@@ -92,7 +117,8 @@ void TimerManager::ResetTimer(uint32 index, uint32 timer)
         sLog.outError("Timer index %u does not exist.", index);
         return;
     }
-    (*data).second.timer = timer; (*data).second.disabled = false;
+    (*data).second.disabled = false;
+    m_timerQueue.Schedule((*data).second, timer);
 }
 
 void TimerManager::DisableTimer(uint32 index)
@@ -103,7 +129,8 @@ void TimerManager::DisableTimer(uint32 index)
         sLog.outError("Timer index %u does not exist.", index);
         return;
     }
-    (*data).second.timer = 0; (*data).second.disabled = true;
+    (*data).second.disabled = true;
+    m_timerQueue.Schedule((*data).second, 0);
 }
 
 void TimerManager::ReduceTimer(uint32 index, uint32 timer)
@@ -114,7 +141,8 @@ void TimerManager::ReduceTimer(uint32 index, uint32 timer)
         sLog.outError("Timer index %u does not exist.", index);
         return;
     }
-    (*data).second.timer = std::min((*data).second.timer, timer);
+    if (m_timerQueue.GetRemaining((*data).second) > timer)
+        m_timerQueue.Schedule((*data).second, timer);
 }
 
 void TimerManager::DelayTimer(uint32 index, uint32 timer)
@@ -125,8 +153,8 @@ void TimerManager::DelayTimer(uint32 index, uint32 timer)
         sLog.outError("Timer index %u does not exist.", index);
         return;
     }
-    if (!(*data).second.disabled)
-        (*data).second.timer = (*data).second.timer > timer ? (*data).second.timer : timer;
+    if (!(*data).second.disabled && m_timerQueue.GetRemaining((*data).second) < timer)
+        m_timerQueue.Schedule((*data).second, timer);
 }
 
 void TimerManager::ResetIfNotStarted(uint32 index, uint32 timer)
@@ -139,25 +167,23 @@ void TimerManager::ResetIfNotStarted(uint32 index, uint32 timer)
     }
     if ((*data).second.disabled)
     {
-        (*data).second.timer = timer;
         (*data).second.disabled = false;
+        m_timerQueue.Schedule((*data).second, timer);
     }
 }
 
 void TimerManager::UpdateTimers(const uint32 diff)
 {
-    for (auto& data : m_timers)
-    {
-        Timer& timer = data.second;
-        if (timer.UpdateTimer(diff))
-            timer.functor();
-    }
+    m_timerQueue.Update(diff, m_timers);
 }
 
 void TimerManager::ResetAllTimers()
 {
     for (auto& data : m_timers)
-        data.second.ResetTimer();
+    {
+        data.second.disabled = data.second.initialDisabled;
+        m_timerQueue.Schedule(data.second, urand(data.second.initialMin, data.second.initialMax));
+    }
 }
 
 void TimerManager::GetAIInformation(ChatHandler& reader)
@@ -167,7 +193,7 @@ void TimerManager::GetAIInformation(ChatHandler& reader)
     for (auto itr = m_timers.begin(); itr != m_timers.end(); ++itr)
     {
         Timer& timer = (*itr).second;
-        output += "Timer ID: " + std::to_string(timer.id) + " Timer: " + std::to_string(timer.timer), +" Disabled: " + std::to_string(timer.disabled) + "\n";
+        output += "Timer ID: " + std::to_string(timer.id) + " Timer: " + std::to_string(m_timerQueue.GetRemaining(timer)), +" Disabled: " + std::to_string(timer.disabled) + "\n";
     }
     reader.PSendSysMessage("%s", output.data());
 }
@@ -175,12 +201,8 @@ void TimerManager::GetAIInformation(ChatHandler& reader)
 void CombatActions::UpdateTimers(const uint32 diff, bool combat)
 {
     TimerManager::UpdateTimers(diff);
-    for (auto& data : m_CombatActions)
-    {
-        CombatTimer& timer = data.second;
-        if (timer.UpdateTimer(diff, combat))
-            timer.functor();
-    }
+    if (combat)
+        m_combatQueue.Update(diff, m_CombatActions);
 }
 
 void CombatActions::ResetAllTimers()
@@ -194,25 +216,34 @@ void CombatActions::ResetAllTimers()
             m_actionReadyStatus[i] = (*itr).second;
     }
     for (auto& data : m_CombatActions)
-        data.second.ResetTimer();
+    {
+        data.second.disabled = data.second.initialDisabled;
+        m_combatQueue.Schedule(data.second, urand(data.second.initialMin, data.second.initialMax));
+    }
     TimerManager::ResetAllTimers();
 }
 
 void CombatActions::AddCombatAction(uint32 id, bool disabled)
 {
-    m_CombatActions.emplace(id, CombatTimer(id, [&, id] { m_actionReadyStatus[id] = true; }, true, 0, 0, disabled));
+    auto result = m_CombatActions.emplace(id, Timer(id, [&, id] { m_actionReadyStatus[id] = true; }, 0, 0, disabled));
+    if (result.second)
+        m_combatQueue.Schedule(result.first->second, 0);
     m_actionReadyStatus[id] = !disabled;
 }
 
 void CombatActions::AddCombatAction(uint32 id, uint32 timer)
 {
-    m_CombatActions.emplace(id, CombatTimer(id, [&, id] { m_actionReadyStatus[id] = true; }, true, timer, timer, false));
+    auto result = m_CombatActions.emplace(id, Timer(id, [&, id] { m_actionReadyStatus[id] = true; }, timer, timer, false));
+    if (result.second)
+        m_combatQueue.Schedule(result.first->second, timer);
     m_actionReadyStatus[id] = false;
 }
 
 void CombatActions::AddCombatAction(uint32 id, uint32 timerMin, uint32 timerMax)
 {
-    m_CombatActions.emplace(id, CombatTimer(id, [&, id] { m_actionReadyStatus[id] = true; }, true, timerMin, timerMax, false));
+    auto result = m_CombatActions.emplace(id, Timer(id, [&, id] { m_actionReadyStatus[id] = true; }, timerMin, timerMax, false));
+    if (result.second)
+        m_combatQueue.Schedule(result.first->second, urand(timerMin, timerMax));
     m_actionReadyStatus[id] = false;
 }
 
@@ -229,8 +260,8 @@ void CombatActions::ResetTimer(uint32 index, uint32 timer)
         TimerManager::ResetTimer(index, timer);
     else
     {
-        (*data).second.timer = timer;
         (*data).second.disabled = false;
+        m_combatQueue.Schedule((*data).second, timer);
     }
 }
 
@@ -241,8 +272,8 @@ void CombatActions::DisableTimer(uint32 index)
         TimerManager::DisableTimer(index);
     else
     {
-        (*data).second.timer = 0;
         (*data).second.disabled = true;
+        m_combatQueue.Schedule((*data).second, 0);
     }
 }
 
@@ -251,8 +282,8 @@ void CombatActions::ReduceTimer(uint32 index, uint32 timer)
     auto data = m_CombatActions.find(index);
     if (data == m_CombatActions.end())
         TimerManager::ReduceTimer(index, timer);
-    else
-        (*data).second.timer = std::min((*data).second.timer, timer);
+    else if (m_combatQueue.GetRemaining((*data).second) > timer)
+        m_combatQueue.Schedule((*data).second, timer);
 }
 
 void CombatActions::DelayTimer(uint32 index, uint32 timer)
@@ -260,8 +291,8 @@ void CombatActions::DelayTimer(uint32 index, uint32 timer)
     auto data = m_CombatActions.find(index);
     if (data == m_CombatActions.end())
         TimerManager::DelayTimer(index, timer);
-    else if (!(*data).second.disabled)
-        (*data).second.timer = (*data).second.timer > timer ? (*data).second.timer : timer;
+    else if (!(*data).second.disabled && m_combatQueue.GetRemaining((*data).second) < timer)
+        m_combatQueue.Schedule((*data).second, timer);
 }
 
 void CombatActions::ResetIfNotStarted(uint32 index, uint32 timer)
@@ -271,8 +302,8 @@ void CombatActions::ResetIfNotStarted(uint32 index, uint32 timer)
         TimerManager::ResetIfNotStarted(index, timer);
     else if ((*data).second.disabled)
     {
-        (*data).second.timer = timer;
         (*data).second.disabled = false;
+        m_combatQueue.Schedule((*data).second, timer);
     }
 }
 
@@ -290,7 +321,7 @@ void CombatActions::GetAIInformation(ChatHandler& reader)
     for (auto itr = m_CombatActions.begin(); itr != m_CombatActions.end(); ++itr)
     {
         Timer& timer = (*itr).second;
-        output += "Timer ID: " + std::to_string(timer.id) + " Timer: " + std::to_string(timer.timer), +" Disabled: " + std::to_string(timer.disabled) + "\n";
+        output += "Timer ID: " + std::to_string(timer.id) + " Timer: " + std::to_string(m_combatQueue.GetRemaining(timer)), +" Disabled: " + std::to_string(timer.disabled) + "\n";
     }
     reader.PSendSysMessage("%s", output.data());
-}
\ No newline at end of file
+}
@@ -36,25 +36,46 @@ struct Timer
 {
     Timer(uint32 id, std::function<void()> functor, uint32 timerMin, uint32 timerMax, bool disabled = false);
     uint32 id;
-    uint32 timer;
+    uint64 deadline;                                        // time of the owning TimerQueue at which the timer expires
+    uint32 generation;                                      // changed on every reschedule, older queue entries are skipped
     bool disabled;
     std::function<void()> functor;
 
     // initial settings
     uint32 initialMin, initialMax;
     bool initialDisabled;
-
-    virtual bool UpdateTimer(const uint32 diff);
-    void ResetTimer();
 };
 
-struct CombatTimer : public Timer
+/*
+Expiry queue of a timer map, timers hold absolute deadlines so an update only touches the expired ones
+*/
+class TimerQueue
 {
-    CombatTimer(uint32 id, std::function<void()> functor, bool combat, uint32 timerMin, uint32 timerMax, bool disabled = false) : Timer(id, functor, timerMin, timerMax, disabled), combat(combat) {}
+    public:
+        TimerQueue() : m_now(0) {}
+
+        void Schedule(Timer& timer, uint32 delay);
+        void Invalidate(Timer& timer) { ++timer.generation; }
+        uint32 GetRemaining(Timer const& timer) const { return timer.deadline > m_now ? uint32(timer.deadline - m_now) : 0; }
+
+        // advances the time and fires the expired timers in id order, like the former scan of the map did
+        void Update(const uint32 diff, std::map<uint32, Timer>& timers);
+
+    private:
+        struct Entry
+        {
+            uint64 deadline;
+            uint32 id;
+            uint32 generation;
+
+            bool operator>(Entry const& other) const { return deadline > other.deadline || (deadline == other.deadline && id > other.id); }
+        };
 
-    bool combat;
+        void Compact(std::map<uint32, Timer> const& timers);
 
-    virtual bool UpdateTimer(const uint32 diff, bool combat);
+        uint64 m_now;
+        std::vector<Entry> m_heap;
+        std::vector<Entry> m_expired;
 };
 
 /*
@@ -110,6 +131,7 @@ class TimerManager
         void AddTimer(uint32 id, Timer&& timer);
     private:
         std::map<uint32, Timer> m_timers;
+        TimerQueue m_timerQueue;
 };
 
 class CombatActions : public TimerManager
@@ -196,7 +218,8 @@ class CombatActions : public TimerManager
         size_t GetCombatActionCount() { return m_actionReadyStatus.size(); }
 
     private:
-        std::map<uint32, CombatTimer> m_CombatActions;
+        std::map<uint32, Timer> m_CombatActions;
+        TimerQueue m_combatQueue;                           // only advances while in combat
         std::vector<bool> m_actionReadyStatus;
         std::map<uint32, bool> m_timerlessActionSettings;
         std::map<uint32, uint32> m_spellAction;
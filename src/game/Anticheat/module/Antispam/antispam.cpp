@@ -69,142 +69,101 @@ void Antispam::Notify(const char *format, ...)
 
     _lastNotification = WorldTimer::getMSTime();
 
-    auto const session = sWorld.FindSession(_account);
-
-    // do not log or notify GMs if the account is already silenced
-    if (!!session && sAntispamMgr.IsSilenced(session))
-        return;
-
     char buffer[1024];
 
     va_list args;
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
 
-    std::stringstream message;
-
-    message << "Possible spammer.  Account: " << _account;
-
-    if (!!session)
-        message << " Player: " << session->GetPlayerName();
-
-    message << ".  " << buffer << "\nMost blacklisted messages:";
-
-    for (auto const &msg : _topBlacklistedMessages)
-        message << "\n" << msg;
-
-    message << "\nRecent messages:";
-
-    for (auto const &msg : _recentMessages)
-        message << "\n" << msg;
-
-    // LOGS DATABASE
-    static SqlStatementID logSilence;
-
-    LogsDatabase.BeginTransaction();
-
-    auto ins = LogsDatabase.CreateStatement(logSilence,
-        "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
-
-    ins.addUInt32(realmID);
-    ins.addUInt32(_account);
-
-    if (!!session)
-    {
-        ins.addString(session->GetRemoteAddress());
-
-        if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
-            ins.addUInt32(anticheat->GetFingerprint());
-        else
-            ins.addUInt32(0);
-    }
-    else
-    {
-        ins.addString("<unknown>");
-        ins.addUInt32(0);
-    }
-
-    ins.addString(message.str());
-
-    ins.Execute();
-
-    LogsDatabase.CommitTransaction();
-
-    // GM NOTIFICATION
-    sWorld.SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+    PostVerdict(false, buffer);
 }
 
 void Antispam::Silence(const char *format, ...)
 {
-    auto const session = sWorld.FindSession(_account);
-
-    // do not log or notify GMs if the account is already silenced
-    if (!!session && sAntispamMgr.IsSilenced(session))
-        return;
-
     char buffer[1024];
 
     va_list args;
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
 
-    std::stringstream message;
+    PostVerdict(true, buffer);
+}
+
+void Antispam::PostVerdict(bool silence, const std::string &reason)
+{
+    std::stringstream details;
 
-    message << "Flagrant spammer.  Account: " << _account;
+    details << "\nMost blacklisted messages:";
 
-    if (!!session)
-        message << " Player: " << session->GetPlayerName();
+    for (auto const &msg : _topBlacklistedMessages)
+        details << "\n" << msg;
 
-    if (sAnticheatConfig.EnableAntispamSilence())
+    details << "\nRecent messages:";
+
+    for (auto const &msg : _recentMessages)
+        details << "\n" << msg;
+
+    // only the verdict leaves the analysis thread, sessions, GM notification and logging belong to the world thread
+    sWorld.GetMessager().AddMessage([account = _account, silence, reason, details = details.str()](World* world)
     {
-        sAntispamMgr.Silence(_account);
-        message << " (silenced)";
-    }
+        auto const session = world->FindSession(account);
 
-    message << ".  " << buffer << "\nMost blacklisted messages:";
+        // do not log or notify GMs if the account is already silenced
+        if (!!session && sAntispamMgr.IsSilenced(session))
+            return;
 
-    for (auto const &msg : _topBlacklistedMessages)
-        message << "\n" << msg;
+        std::stringstream message;
 
-    message << "\nRecent messages:";
+        message << (silence ? "Flagrant spammer.  Account: " : "Possible spammer.  Account: ") << account;
 
-    for (auto const &msg : _recentMessages)
-        message << "\n" << msg;
+        if (!!session)
+            message << " Player: " << session->GetPlayerName();
 
-    // LOGS DATABASE
-    static SqlStatementID logSilence;
+        if (silence && sAnticheatConfig.EnableAntispamSilence())
+        {
+            sAntispamMgr.Silence(account);
+            message << " (silenced)";
+        }
 
-    LogsDatabase.BeginTransaction();
+        message << ".  " << reason << details;
 
-    auto ins = LogsDatabase.CreateStatement(logSilence,
-        "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
+        // LOGS DATABASE
+        static SqlStatementID logSilence;
 
-    ins.addUInt32(realmID);
-    ins.addUInt32(_account);
+        LogsDatabase.BeginTransaction();
 
-    if (!!session)
-    {
-        ins.addString(session->GetRemoteAddress());
+        auto ins = LogsDatabase.CreateStatement(logSilence,
+            "INSERT INTO logs_spamdetect (realm, accountId, fromIP, fromFingerprint, comment) VALUES(?, ?, ?, ?, ?)");
+
+        ins.addUInt32(realmID);
+        ins.addUInt32(account);
 
-        if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
-            ins.addUInt32(anticheat->GetFingerprint());
+        if (!!session)
+        {
+            ins.addString(session->GetRemoteAddress());
+
+            if (auto const anticheat = dynamic_cast<const SessionAnticheat *>(session->GetAnticheat()))
+                ins.addUInt32(anticheat->GetFingerprint());
+            else
+                ins.addUInt32(0);
+        }
         else
+        {
+            ins.addString("<unknown>");
             ins.addUInt32(0);
-    }
-    else
-    {
-        ins.addString("<unknown>");
-        ins.addUInt32(0);
-    }
+        }
+
+        ins.addString(message.str());
 
-    ins.addString(message.str());
+        ins.Execute();
 
-    ins.Execute();
+        LogsDatabase.CommitTransaction();
 
-    LogsDatabase.CommitTransaction();
-    
-    // GM NOTIFICATION
-    sWorld.SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+        // GM NOTIFICATION
+        world->SendGMTextFlags(ACCOUNT_FLAG_SHOW_ANTISPAM, LANG_GM_ANNOUNCE_COLOR, "AntiSpam", message.str().c_str());
+    });
 }
 
 Antispam::Antispam(uint32 account) :
@@ -84,6 +84,9 @@ class Antispam : public std::enable_shared_from_this<Antispam>
         // send GM notification of flagrant spammer and silence account (when automatic silencing is enabled)
         void Silence(const char *format, ...);
 
+        // hands the verdict of the analysis thread over to the world thread, which notifies, logs and silences
+        void PostVerdict(bool silence, const std::string &reason);
+
         // new message for analysis, assumes mutex is locked
         void NewMessage(const std::string &msg);
 
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <regex>
 #include <algorithm>
@@ -26,6 +27,7 @@
 #include <thread>
 #include <chrono>
 #include <array>
+#include <deque>
 
 INSTANTIATE_SINGLETON_1(NamreebAnticheat::AntispamMgr);
 
@@ -54,9 +56,108 @@ void ReplaceAllW(std::wstring &str, const std::wstring& from, const std::wstring
 
 namespace NamreebAnticheat
 {
+void BlacklistMatcher::Build(const std::vector<std::string> &patterns)
+{
+    _nodes.clear();
+    _nodes.emplace_back();
+    _lengths.clear();
+
+    // build the trie of all patterns
+    for (auto i = 0u; i < patterns.size(); ++i)
+    {
+        _lengths.push_back(patterns[i].length());
+
+        if (patterns[i].empty())
+            continue;
+
+        uint32 node = 0;
+        for (auto const c : patterns[i])
+        {
+            auto const n = _nodes[node].next.find(c);
+
+            if (n != _nodes[node].next.end())
+                node = n->second;
+            else
+            {
+                _nodes.emplace_back();
+                _nodes[node].next[c] = _nodes.size() - 1;
+                node = _nodes.size() - 1;
+            }
+        }
+
+        _nodes[node].patterns.push_back(i);
+    }
+
+    // breadth first, link each node to the longest proper suffix which is also in the trie
+    std::deque<uint32> queue;
+    for (auto const &n : _nodes[0].next)
+        queue.push_back(n.second);
+
+    while (!queue.empty())
+    {
+        auto const node = queue.front();
+        queue.pop_front();
+
+        for (auto const &n : _nodes[node].next)
+        {
+            auto fail = _nodes[node].fail;
+            while (fail && _nodes[fail].next.find(n.first) == _nodes[fail].next.end())
+                fail = _nodes[fail].fail;
+
+            auto const f = _nodes[fail].next.find(n.first);
+            auto const child = n.second;
+
+            _nodes[child].fail = (f != _nodes[fail].next.end() && f->second != child) ? f->second : 0;
+
+            // the fail node is closer to the root, so its own pattern list is already complete
+            auto const &inherited = _nodes[_nodes[child].fail].patterns;
+            _nodes[child].patterns.insert(_nodes[child].patterns.end(), inherited.begin(), inherited.end());
+
+            queue.push_back(child);
+        }
+    }
+}
+
+void BlacklistMatcher::Count(const std::string &text, std::vector<uint32> &counts) const
+{
+    counts.assign(_lengths.size(), 0);
+
+    if (_nodes.size() <= 1)
+        return;
+
+    // first position at which the next occurrence of each pattern may start
+    std::vector<size_t> nextStart(_lengths.size(), 0);
+
+    uint32 node = 0;
+    for (size_t pos = 0; pos < text.length(); ++pos)
+    {
+        auto const c = text[pos];
+
+        auto n = _nodes[node].next.find(c);
+        while (node && n == _nodes[node].next.end())
+        {
+            node = _nodes[node].fail;
+            n = _nodes[node].next.find(c);
+        }
+
+        node = n != _nodes[node].next.end() ? n->second : 0;
+
+        for (auto const p : _nodes[node].patterns)
+        {
+            auto const start = pos + 1 - _lengths[p];
+
+            if (start < nextStart[p])
+                continue;
+
+            ++counts[p];
+            nextStart[p] = pos + 1;
+        }
+    }
+}
+
 std::string AntispamMgr::NormalizeString(const std::string &string, uint32 mask) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_mutex);
     return NormalizeStringInternal(string, mask);
 }
 
@@ -157,12 +258,15 @@ void AntispamMgr::WorkerLoop()
 
         if (sAnticheatConfig.EnableAntispam())
         {
+            // a session scheduled several times since the last tick is analyzed once, with all its pending messages
             std::unordered_set<std::shared_ptr<Antispam> > workQueue;
+            std::shared_ptr<Antispam> session;
+            while (_workQueue.Dequeue(session))
+                workQueue.insert(std::move(session));
 
-            // lock the mutex only long enough to move the work queue to a local container and expire old blacklist history
+            // lock the mutex only long enough to expire old blacklist history
             {
-                std::lock_guard<std::mutex> guard(_mutex);
-                workQueue = std::move(_workQueue);
+                std::lock_guard<std::mutex> guard(_cacheMutex);
 
                 for (auto i = _temporaryCache.begin(); i != _temporaryCache.end(); )
                 {
@@ -178,8 +282,10 @@ void AntispamMgr::WorkerLoop()
         }
         else
         {
-            std::lock_guard<std::mutex> guard(_mutex);
-            _workQueue.clear();
+            std::shared_ptr<Antispam> session;
+            while (_workQueue.Dequeue(session));
+
+            std::lock_guard<std::mutex> guard(_cacheMutex);
             _temporaryCache.clear();
         }
 
@@ -198,7 +304,7 @@ void AntispamMgr::WorkerLoop()
 
 void AntispamMgr::LoadFromDB()
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_mutex);
 
     auto const normMask = sAnticheatConfig.GetSpamNormalizationMask();
 
@@ -270,11 +376,27 @@ void AntispamMgr::LoadFromDB()
         } while (result->NextRow());
 
     sLog.outString(">> %lu unicode character replacements loaded", uint64(_unicodeReplace.size()));
+
+    BuildMatchers();
+}
+
+void AntispamMgr::BuildMatchers()
+{
+    std::vector<std::string> original, normalized;
+
+    for (auto const &entry : _blacklist)
+    {
+        original.push_back(entry.first);
+        normalized.push_back(entry.second);
+    }
+
+    _originalMatcher.Build(original);
+    _normalizedMatcher.Build(normalized);
 }
 
 void AntispamMgr::BlacklistAdd(const std::string &string_)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::unique_lock<std::shared_mutex> guard(_mutex);
 
     // cannot be empty!
     if (string_.empty())
@@ -303,11 +425,13 @@ void AntispamMgr::BlacklistAdd(const std::string &string_)
     LoginDatabase.CommitTransaction();
 
     _blacklist.emplace_back(entry, normEntry);
+
+    BuildMatchers();
 }
 
 uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log) const
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::shared_lock<std::shared_mutex> guard(_mutex);
 
     auto const normalizationMask = sAnticheatConfig.GetSpamNormalizationMask();
     auto const msg = NormalizeStringInternal(string, normalizationMask);
@@ -317,28 +441,20 @@ uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log)
 
     uint32 result = 0;
 
-    // for each entry, search the given string for multiple occurrences of both the original and normalized form of the entry
-    for (auto const& entry : _blacklist)
+    // search the original string for the original entries and the normalized string for the normalized entries
+    std::vector<uint32> originalCounts, normalizedCounts;
+    _originalMatcher.Count(string, originalCounts);
+    _normalizedMatcher.Count(msg, normalizedCounts);
+
+    for (auto i = 0u; i < _blacklist.size(); ++i)
     {
-        // search the original string for the original blacklist entry
-        if (!entry.first.empty())
-        {
-            for (auto pos = string.find(entry.first); pos != std::string::npos; pos = string.find(entry.first, pos + entry.first.length()))
-            {
-                logstr << "\nOriginal: \"" << entry.first << "\"";
-                ++result;
-            }
-        }
+        for (auto n = 0u; n < originalCounts[i]; ++n)
+            logstr << "\nOriginal: \"" << _blacklist[i].first << "\"";
 
-        // search for the normalized blacklist entry
-        if (!entry.second.empty())
-        {
-            for (auto pos = msg.find(entry.second); pos != std::string::npos; pos = msg.find(entry.second, pos + entry.second.length()))
-            {
-                logstr << "\nNormalized: \"" << entry.second << "\"";
-                ++result;
-            }
-        }
+        for (auto n = 0u; n < normalizedCounts[i]; ++n)
+            logstr << "\nNormalized: \"" << _blacklist[i].second << "\"";
+
+        result += originalCounts[i] + normalizedCounts[i];
     }
 
     logstr << "\n";
@@ -352,19 +468,18 @@ uint32 AntispamMgr::CheckBlacklist(const std::string &string, std::string &log)
 
 void AntispamMgr::ScheduleAnalysis(std::shared_ptr<Antispam> session)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
-    _workQueue.insert(session);
+    _workQueue.Enqueue(std::move(session));
 }
 
 void AntispamMgr::CacheSession(std::shared_ptr<Antispam> session)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::mutex> guard(_cacheMutex);
     _temporaryCache[session->GetAccount()] = std::make_pair(WorldTimer::getMSTime(), session);
 }
 
 std::shared_ptr<Antispam> AntispamMgr::GetSession(uint32 accountId)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::mutex> guard(_cacheMutex);
     
     auto const i = _temporaryCache.find(accountId);
 
@@ -380,7 +495,7 @@ std::shared_ptr<Antispam> AntispamMgr::GetSession(uint32 accountId)
 
 std::shared_ptr<Antispam> AntispamMgr::CheckCache(uint32 accountId)
 {
-    std::lock_guard<std::mutex> guard(_mutex);
+    std::lock_guard<std::mutex> guard(_cacheMutex);
 
     auto const i = _temporaryCache.find(accountId);
 
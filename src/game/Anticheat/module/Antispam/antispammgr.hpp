@@ -9,10 +9,12 @@
 #define __ANTISPAMMGR_HPP_
 
 #include "Policies/Singleton.h"
+#include "Multithreading/MPSCQueue.h"
 
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_set>
 #include <unordered_map>
 #include <thread>
@@ -25,26 +27,56 @@ namespace NamreebAnticheat
 {
 class Antispam;
 
+// finds all blacklist entries in a string in one pass (Aho-Corasick automaton)
+class BlacklistMatcher
+{
+    private:
+        struct Node
+        {
+            std::unordered_map<char, uint32> next;
+            uint32 fail = 0;
+
+            // patterns ending at this node, including those ending at nodes along the fail chain
+            std::vector<uint32> patterns;
+        };
+
+        std::vector<Node> _nodes;
+        std::vector<size_t> _lengths;
+
+    public:
+        // empty patterns never match
+        void Build(const std::vector<std::string> &patterns);
+
+        // counts[i] is set to the non-overlapping occurrences of pattern i, as repeated std::string::find would count them
+        void Count(const std::string &text, std::vector<uint32> &counts) const;
+};
+
 class AntispamMgr
 {
     private:
-        // note that once we begin using c++17, std::shared_mutex will be much more performant
-        // here as the guarded values are seldom changed but frequently read
-        mutable std::mutex _mutex;
+        // guards the blacklist and its matchers, they are seldom changed but read for every analyzed message
+        mutable std::shared_mutex _mutex;
+
+        // guards _temporaryCache
+        std::mutex _cacheMutex;
 
         bool _shutdownRequested;
 
         // this collection contains a pair of strings, the original entry and the normalized version based on current settings
         std::vector<std::pair<std::string, std::string> > _blacklist;
 
+        // precompiled from the original and the normalized blacklist entries, pattern indices match _blacklist
+        BlacklistMatcher _originalMatcher;
+        BlacklistMatcher _normalizedMatcher;
+
         // NOTE: _asciiReplace and _unicodeReplace are not protected by _mutex, because it would make the code much more complicated
         // and they should never be changing once the world server has started.
 
         std::vector<std::pair<std::string, std::string> > _asciiReplace;        // replacements for ascii strings (for things like @ -> A or \/\/ -> W etc.)
         std::vector<std::pair<std::wstring, std::wstring> > _unicodeReplace;    // replacements for individual unicode characters
 
-        // set of sessions to analyze in the next tick of the antispam worker thread
-        std::unordered_set<std::shared_ptr<Antispam> > _workQueue;
+        // sessions to analyze in the next tick of the antispam worker thread, filled without locking by the session threads
+        MPSCQueue<std::shared_ptr<Antispam> > _workQueue;
 
         // temporarily cache antispam session information in case they reconnect and resume spamming
         std::unordered_map<uint32, std::pair<uint32, std::shared_ptr<Antispam> > > _temporaryCache;
@@ -55,6 +87,9 @@ class AntispamMgr
         // this function performs the actual normalization, but assumes that the mutex is already locked
         std::string NormalizeStringInternal(const std::string &string, uint32 mask) const;
 
+        // rebuilds the matchers from _blacklist, assumes that the mutex is exclusively locked
+        void BuildMatchers();
+
         void WorkerLoop();
 
     public:
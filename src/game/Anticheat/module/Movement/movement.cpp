@@ -87,6 +87,9 @@ uint32 GetMoveType(uint32 moveFlags)
 }
 
 constexpr float extrapolationEpsilon = 0.0002f;
+
+// movement packets getting the geometry checks after a suspicious one, regardless of Movement.GeometrySampleRate
+constexpr uint32 suspicionPackets = 50;
 }
 
 namespace Movement
@@ -100,7 +103,8 @@ Movement::Movement(Player* me) :
     _me(me), _jumpInitialSpeed(0.f), _inKnockBack(false),
     _anticheat(reinterpret_cast<SessionAnticheat *>(me->GetSession()->GetAnticheat())),
     _serverInitTime(0), _clientInitTime(0), _justTeleported(false), _totalDistanceTraveled(0.f),
-    overSpeedDistanceTick(0.f), overSpeedDistanceTotal(0.f), _wasMovingOther(false)
+    overSpeedDistanceTick(0.f), overSpeedDistanceTotal(0.f), _wasMovingOther(false),
+    _orderCount(0), _geometrySkipped(0), _suspicion(0)
 {
     memset(clientSpeeds, 0, sizeof(clientSpeeds));
 
@@ -186,8 +190,10 @@ void Movement::VerifyMovementFlags(uint32 flags, uint32 &removeFlags, bool stric
         return;
 
     bool pendingRoot = false, pendingWaterWalkRemoval = false, pendingSlowFallRemoval = false;
-    for (auto const &order : _orders)
+    for (size_t i = 0; i < _orderCount; ++i)
     {
+        auto const &order = _orders[i];
+
         if (order.opcode == SMSG_FORCE_MOVE_ROOT)
             pendingRoot = true;
 
@@ -237,7 +243,10 @@ void Movement::OrderSent(uint16 opcode, uint32 counter)
 {
     _orderHistory.push_back({ opcode, WorldTimer::getMSTime() });
 
-    _orders.emplace_back<PendingOrder>({ opcode, counter, WorldTimer::getMSTime() });
+    if (_orderCount == MaxPendingOrders)
+        RemoveOrder(0);
+
+    _orders[_orderCount++] = { opcode, counter, WorldTimer::getMSTime() };
 
     sLog.outDebug("ORDER: %s (%u) sent to %s (counter = %u)", LookupOpcodeName(opcode), opcode, _me->GetName(), counter);
 }
@@ -248,7 +257,7 @@ void Movement::OrderAck(uint16 opcode, uint32 counter)
 
     sLog.outDebug("ORDER: %s (%u) ACK %s (counter = %u)", LookupOpcodeName(opcode), opcode, _me->GetName(), counter);
 
-    if (_orders.empty())
+    if (!_orderCount)
     {
         if (sAnticheatConfig.IsEnabled(CHEAT_TYPE_BAD_ORDER_ACK))
             _anticheat->RecordCheatInternal(CHEAT_TYPE_BAD_ORDER_ACK, "Received ACK %s (%u) but no orders are pending",
@@ -260,7 +269,7 @@ void Movement::OrderAck(uint16 opcode, uint32 counter)
     // if this detection method is disabled, just empty the results and stop
     if (!sAnticheatConfig.IsEnabled(CHEAT_TYPE_BAD_ORDER_ACK))
     {
-        _orders.clear();
+        _orderCount = 0;
         return;
     }
 
@@ -269,14 +278,14 @@ void Movement::OrderAck(uint16 opcode, uint32 counter)
     // are not guaranteed to arrive in the same order they were sent.  once that bug is fixed, the below code
     // can be replaced with one which is both faster and more strict, where only the front of the queue is
     // checked against the data received from the client.
-    for (auto i = _orders.begin(); i != _orders.end(); ++i)
+    for (size_t i = 0; i < _orderCount; ++i)
     {
-        auto const response = GetOrderResponse(i->opcode);
+        auto const response = GetOrderResponse(_orders[i].opcode);
 
         // found? remove from the queue and return
-        if (response == opcode && counter == i->counter)
+        if (response == opcode && counter == _orders[i].counter)
         {
-            _orders.erase(i);
+            RemoveOrder(i);
             return;
         }
     }
@@ -293,20 +302,58 @@ void Movement::CheckExpiredOrders(uint32 latency)
     auto const now = WorldTimer::getMSTime();
     const uint32 expirationDelay = 2.5 * latency;
 
-    for (auto i = _orders.begin(); i != _orders.end(); ++i)
+    // compact the still pending orders to the front, keeping their order
+    size_t kept = 0;
+    for (size_t i = 0; i < _orderCount; ++i)
     {
-        auto const expected = i->time + expirationDelay;
+        auto const expected = _orders[i].time + expirationDelay;
 
         if (expected < now)
         {
             //m_anticheat->RecordCheatInternal(CHEAT_TYPE_BAD_ORDER_ACK, "Expired order received no ACK for %s (%u) counter %u sent %u expected %u latency %u now %u",
-            //    LookupOpcodeName(i->opcode), i->opcode, i->counter, i->time, expected, latency, now);
-            i = _orders.erase(i);
-
-            if (i == _orders.end())
-                break;
+            //    LookupOpcodeName(_orders[i].opcode), _orders[i].opcode, _orders[i].counter, _orders[i].time, expected, latency, now);
+            continue;
         }
+
+        _orders[kept++] = _orders[i];
+    }
+
+    _orderCount = kept;
+}
+
+void Movement::RemoveOrder(size_t index)
+{
+    MANGOS_ASSERT(index < _orderCount);
+
+    for (size_t i = index + 1; i < _orderCount; ++i)
+        _orders[i - 1] = _orders[i];
+
+    --_orderCount;
+}
+
+bool Movement::ShouldCheckGeometry()
+{
+    if (_suspicion)
+    {
+        --_suspicion;
+        _geometrySkipped = 0;
+        return true;
     }
+
+    auto const rate = sAnticheatConfig.GetMovementGeometrySampleRate();
+
+    if (rate <= 1 || ++_geometrySkipped >= rate)
+    {
+        _geometrySkipped = 0;
+        return true;
+    }
+
+    return false;
+}
+
+void Movement::RaiseSuspicion()
+{
+    _suspicion = suspicionPackets;
 }
 
 // Movement processing anticheat main routine
@@ -527,8 +574,9 @@ bool Movement::HandleAnticheatTests(MovementInfo& movementInfo, WorldSession* se
 
         auto const dt = movementInfo.ctime - GetLastMovementInfo().ctime;
 
-        // Check vs extrapolation
-        if (sAnticheatConfig.EnableExtrapolation())
+        // Check vs extrapolation, sampled packets only unless the player moved suspiciously.  the others get the
+        // plain maximum distance check below, which needs no terrain lookups
+        if (sAnticheatConfig.EnableExtrapolation() && ShouldCheckGeometry())
         {
             Position extrap;
 
@@ -560,12 +608,16 @@ bool Movement::HandleAnticheatTests(MovementInfo& movementInfo, WorldSession* se
                     }
 
                     if (delta >= minErr)
+                    {
+                        RaiseSuspicion();
+
                         if (auto const anticheat = dynamic_cast<AnticheatLib *>(GetAnticheatLib()))
                             anticheat->OfferExtrapolationData(
                                 GetLastMovementInfo(),
                                 clientSpeeds[GetMoveType(GetLastMovementInfo().moveFlags)],
                                 clientSpeeds[GetMoveType(movementInfo.moveFlags)],
                                 movementInfo, extrap, delta);
+                    }
                 }
             }
         }
@@ -585,6 +637,7 @@ bool Movement::HandleAnticheatTests(MovementInfo& movementInfo, WorldSession* se
                 {
                     overSpeedDistanceTick += dist;
                     overSpeedDistanceTotal += dist;
+                    RaiseSuspicion();
                 }
             }
 
@@ -937,6 +990,17 @@ bool Movement::IsTeleportAllowed(MovementInfo const& movementInfo, float& distan
     if (_me->IsBeingTeleported())
         return true;
 
+    float deltaX = _me->GetPositionX() - movementInfo.pos.x;
+    float deltaY = _me->GetPositionY() - movementInfo.pos.y;
+    float deltaZ = _me->GetPositionZ() - movementInfo.pos.z;
+    distance = sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+
+    // short moves need no terrain lookup
+    if (distance < 40.0f)
+        return true;
+
+    RaiseSuspicion();
+
     // some exclude zones - lifts and other, but..
     uint32 destZoneId = 0;
     uint32 destAreaId = 0;
@@ -955,14 +1019,6 @@ bool Movement::IsTeleportAllowed(MovementInfo const& movementInfo, float& distan
             return true;
     }
 
-    float deltaX = _me->GetPositionX() - movementInfo.pos.x;
-    float deltaY = _me->GetPositionY() - movementInfo.pos.y;
-    float deltaZ = _me->GetPositionZ() - movementInfo.pos.z;
-    distance = sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
-
-    if (distance < 40.0f)
-        return true;
-
     return false;
 }
 
@@ -1054,21 +1110,12 @@ bool Movement::CheckTeleport(uint16 opcode, MovementInfo& movementInfo)
 
 void Movement::SendOrderInfo(ChatHandler *handler) const
 {
-    handler->PSendSysMessage("Order ACKs pending: %lu Current time: %u", uint64(_orders.size()), WorldTimer::getMSTime());
-
-    if (!_orders.empty())
-    {
-        static constexpr size_t maxCount = 10;
+    handler->PSendSysMessage("Order ACKs pending: %lu Current time: %u", uint64(_orderCount), WorldTimer::getMSTime());
 
-        size_t count = 0;
-        for (auto const &order : _orders)
-        {
-            handler->PSendSysMessage("Next: %s Age: %ums", LookupOpcodeName(order.opcode), WorldTimer::getMSTime() - order.time);
+    static constexpr size_t maxCount = 10;
 
-            if (++count >= maxCount)
-                break;
-        }
-    }
+    for (size_t i = 0; i < _orderCount && i < maxCount; ++i)
+        handler->PSendSysMessage("Next: %s Age: %ums", LookupOpcodeName(_orders[i].opcode), WorldTimer::getMSTime() - _orders[i].time);
     
     std::string str;
 
@@ -15,7 +15,6 @@
 
 #include <vector>
 #include <map>
-#include <deque>
 
 class ChatHandler;
 class Player;
@@ -46,8 +45,17 @@ class Movement
         // true when the client has acknowledged a teleport after the last movement packet was received
         bool _justTeleported;
 
-        // movement orders sent to the client, acknowledgement still pending
-        std::deque<PendingOrder> _orders;
+        // movement orders sent to the client, acknowledgement still pending, oldest first.  when full, the oldest order
+        // is dropped as it would have expired long before
+        static constexpr size_t MaxPendingOrders = 32;
+        PendingOrder _orders[MaxPendingOrders];
+        size_t _orderCount;
+
+        // movement packets received since the last geometry (extrapolation) check
+        uint32 _geometrySkipped;
+
+        // while non-zero, every movement packet gets the geometry checks regardless of the sample rate
+        uint32 _suspicion;
 
         // keep track of the client clock in relation to our own.  some speed hacks function by accelerating the client clock.
         // if more time passes for the client than for us then it is probably a hack as this should not happen under normal circumstances.
@@ -100,6 +108,12 @@ class Movement
 
         bool IsTeleportAllowed(MovementInfo const& movementInfo, float& distance);
 
+        void RemoveOrder(size_t index);
+
+        // true when this movement packet should get the expensive geometry checks
+        bool ShouldCheckGeometry();
+        void RaiseSuspicion();
+
     public:
         float clientSpeeds[MAX_MOVE_TYPE];
 
@@ -141,7 +155,7 @@ class Movement
         // commands
         void SendOrderInfo(ChatHandler *handler) const;
 
-        size_t PendingOrderCount() const { return _orders.size(); }
+        size_t PendingOrderCount() const { return _orderCount; }
 
         // debug logging
         size_t DumpOrders(std::string &out) const;
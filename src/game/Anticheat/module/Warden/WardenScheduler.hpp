@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2017-2020 namreeb (legal@namreeb.org)
+ *
+ * This is private software and may not be shared under any circumstances,
+ * absent permission of namreeb.
+ */
+
+#ifndef __WARDENSCHEDULER_HPP_
+#define __WARDENSCHEDULER_HPP_
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <map>
+
+// spreads the periodic scans of all sessions evenly over time and caps the Warden work done per world tick.
+// all sessions are updated by the world thread, so no locking is needed.
+class WardenScheduler
+{
+    private:
+        // periodic scans scheduled per second of WorldTimer::getMSTime()
+        std::map<uint32, uint32> m_scansPerSecond;
+
+        // world tick the counters below belong to
+        uint32 m_tick;
+        uint32 m_requests;
+        uint32 m_validations;
+
+        void BeginTick();
+
+    public:
+        WardenScheduler() : m_tick(0), m_requests(0), m_validations(0) {}
+
+        // time of the next periodic scan of a session, in the least busy second around the scan frequency
+        uint32 ScheduleScan(uint32 now);
+        void CancelScan(uint32 scanTime);
+
+        // false when the periodic requests or the result checks of this tick are used up
+        bool AcquireRequest();
+        bool AcquireValidation();
+};
+
+#define sWardenScheduler MaNGOS::Singleton<WardenScheduler>::Instance()
+
+#endif /*!__WARDENSCHEDULER_HPP_*/
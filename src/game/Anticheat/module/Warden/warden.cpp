@@ -27,6 +27,7 @@
 #include "WardenWin.hpp"
 #include "WardenMac.hpp"
 #include "WardenScanMgr.hpp"
+#include "WardenScheduler.hpp"
 
 #include <openssl/md5.h>
 #include <openssl/sha.h>
@@ -50,7 +51,7 @@ void Warden::LoadScriptedScans()
 
 Warden::Warden(WorldSession *session, const WardenModule *module, const BigNumber &K, SessionAnticheatInterface *anticheat) :
     _session(session), _inputCrypto(KeyLength), _outputCrypto(KeyLength), _initialized(false), _module(module), _crk(nullptr),
-    _timeoutClock(0), _scanClock(0), _anticheat(reinterpret_cast<SessionAnticheat *>(anticheat)), _moduleSendPending(false)
+    _timeoutClock(0), _scanClock(0), _anticheat(reinterpret_cast<SessionAnticheat *>(anticheat)), _moduleSendPending(false), _resultsDeferred(false)
 {
     MANGOS_ASSERT(!!_module);
     MANGOS_ASSERT(!!_anticheat);
@@ -86,6 +87,11 @@ Warden::Warden(WorldSession *session, const WardenModule *module, const BigNumbe
     BeginTimeoutClock();
 }
 
+Warden::~Warden()
+{
+    StopScanClock();
+}
+
 void Warden::RequestChallenge()
 {
     MANGOS_ASSERT(!!_module && !_module->crk.empty());
@@ -325,11 +331,17 @@ void Warden::StopTimeoutClock()
 
 void Warden::BeginScanClock()
 {
-    _scanClock = WorldTimer::getMSTime() + 1000 * sAnticheatConfig.GetWardenScanFrequency();
+    StopScanClock();
+
+    _scanClock = sWardenScheduler.ScheduleScan(WorldTimer::getMSTime());
 }
 
 void Warden::StopScanClock()
 {
+    // give the scheduled second back when the scan will not happen
+    if (!!_scanClock && _scanClock > WorldTimer::getMSTime())
+        sWardenScheduler.CancelScan(_scanClock);
+
     _scanClock = 0;
 }
 
@@ -403,6 +415,18 @@ void Warden::HandlePacket(WorldPacket& recvData)
             return;
         }
 
+        // the scans stay pending until their results are checked, so no new request is sent in the meantime
+        if (!sWardenScheduler.AcquireValidation())
+        {
+            StopTimeoutClock();
+
+            _deferredResults.clear();
+            _deferredResults.append(recvData.contents() + recvData.rpos(), recvData.wpos() - recvData.rpos());
+            recvData.rpos(recvData.wpos());
+            _resultsDeferred = true;
+            break;
+        }
+
         // this function will also act on the results
         ReadScanResults(recvData);
 
@@ -467,13 +491,26 @@ void Warden::Update(uint32 /*diff*/)
         return;
     }
 
+    // results deferred by the validation budget are checked before anything else is requested
+    if (_resultsDeferred)
+    {
+        if (!sWardenScheduler.AcquireValidation())
+            return;
+
+        _resultsDeferred = false;
+        ReadScanResults(_deferredResults);
+        _deferredResults.clear();
+
+        BeginScanClock();
+    }
+
     if (_pendingScans.empty())
     {
         // if there are enqueued scans which may now be requested, do so immediately (with no additional scans)
         if (!_enqueuedScans.empty())
             RequestScans({});
         // otherwise, if the scan clock is running and has expired, request randomly selected scans
-        else if (!!_scanClock && WorldTimer::getMSTime() > _scanClock)
+        else if (!!_scanClock && WorldTimer::getMSTime() > _scanClock && sWardenScheduler.AcquireRequest())
         {
             auto const inWorld = _session->GetPlayer() ? _session->GetPlayer()->IsInWorld() : false;
 
@@ -58,6 +58,10 @@ class Warden
         // true when we have sent a module to the client and are waiting for a result
         bool _moduleSendPending;
 
+        // scan results received while the validation budget of the tick was used up, checked by a later update
+        ByteBuffer _deferredResults;
+        bool _resultsDeferred;
+
         SARC4 _inputCrypto;
         SARC4 _outputCrypto;
 
@@ -116,7 +120,7 @@ class Warden
         std::vector<std::shared_ptr<const Scan>> _enqueuedScans;
 
     public:
-        virtual ~Warden() = default;
+        virtual ~Warden();
 
         // size, in bytes, of client request buffer
         static constexpr size_t MaxRequest = 256;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017-2020 namreeb (legal@namreeb.org)
+ *
+ * This is private software and may not be shared under any circumstances,
+ * absent permission of namreeb.
+ */
+
+#include "WardenScheduler.hpp"
+#include "../config.hpp"
+
+#include "World/World.h"
+#include "Util.h"
+
+INSTANTIATE_SINGLETON_1(WardenScheduler);
+
+uint32 WardenScheduler::ScheduleScan(uint32 now)
+{
+    auto const nowSecond = now / 1000;
+
+    // forget the seconds which have passed
+    while (!m_scansPerSecond.empty() && m_scansPerSecond.begin()->first <= nowSecond)
+        m_scansPerSecond.erase(m_scansPerSecond.begin());
+
+    auto const frequency = std::max(sAnticheatConfig.GetWardenScanFrequency(), 1u);
+    auto const spread = frequency / 2;
+
+    // look outwards from the configured frequency for the second with the fewest scans, so that
+    // sessions logged in at the same time drift apart instead of scanning in waves
+    auto bestSecond = nowSecond + frequency;
+    auto bestCount = m_scansPerSecond[bestSecond];
+    for (auto offset = 1u; offset <= spread && bestCount; ++offset)
+    {
+        for (auto const second : { nowSecond + frequency - offset, nowSecond + frequency + offset })
+        {
+            auto const itr = m_scansPerSecond.find(second);
+            auto const count = itr == m_scansPerSecond.end() ? 0 : itr->second;
+            if (count < bestCount)
+            {
+                bestSecond = second;
+                bestCount = count;
+            }
+        }
+    }
+
+    ++m_scansPerSecond[bestSecond];
+
+    return bestSecond * 1000 + urand(0, 999);
+}
+
+void WardenScheduler::CancelScan(uint32 scanTime)
+{
+    auto const itr = m_scansPerSecond.find(scanTime / 1000);
+    if (itr != m_scansPerSecond.end() && !!itr->second)
+        --itr->second;
+}
+
+void WardenScheduler::BeginTick()
+{
+    if (m_tick == World::GetCurrentMSTime())
+        return;
+
+    m_tick = World::GetCurrentMSTime();
+    m_requests = 0;
+    m_validations = 0;
+}
+
+bool WardenScheduler::AcquireRequest()
+{
+    BeginTick();
+
+    auto const limit = sAnticheatConfig.GetWardenMaxRequestsPerTick();
+    if (!!limit && m_requests >= limit)
+        return false;
+
+    ++m_requests;
+    return true;
+}
+
+bool WardenScheduler::AcquireValidation()
+{
+    BeginTick();
+
+    auto const limit = sAnticheatConfig.GetWardenMaxValidationsPerTick();
+    if (!!limit && m_validations >= limit)
+        return false;
+
+    ++m_validations;
+    return true;
+}
@@ -70,6 +70,7 @@ void AnticheatConfig::loadConfigSettings()
     setConfig(CONFIG_BOOL_AC_ANTISPAM_ENABLED, "Antispam.Enable", false);
     setConfig(CONFIG_BOOL_AC_ANTISPAM_SILENCE, "Antispam.Silence", false);
 
+    setConfig(CONFIG_UINT32_AC_MOVEMENT_GEOMETRY_SAMPLE_RATE, "Movement.GeometrySampleRate", 1);
     setConfig(CONFIG_UINT32_AC_FINGERPRINT_HISTORY, "FingerprintHistory", 30);
     setConfig(CONFIG_UINT32_AC_FINGERPRINT_LEVEL, "FingerprintLevel", 6);
 
@@ -136,6 +137,8 @@ void AnticheatConfig::loadConfigSettings()
     setConfig(CONFIG_UINT32_AC_WARDEN_MINIMUM_LEVEL, "Warden.MinimumLevel", 25);
     setConfig(CONFIG_UINT32_AC_WARDEN_MINIMUM_ADVANCED_LEVEL, "Warden.MinimumAdvancedLevel", 18);
     setConfig(CONFIG_UINT32_AC_WARDEN_SUSPICIOUS_ENDSCENE_HOOK_ACTION, "Warden.SuspiciousEndSceneHookAction", 1);
+    setConfig(CONFIG_UINT32_AC_WARDEN_MAX_REQUESTS_PER_TICK, "Warden.MaxRequestsPerTick", 0);
+    setConfig(CONFIG_UINT32_AC_WARDEN_MAX_VALIDATIONS_PER_TICK, "Warden.MaxValidationsPerTick", 0);
     setConfig(CONFIG_BOOL_AC_WARDEN_ENABLED, "Warden.Enable", false);
     m_wardenModuleDir = GetStringDefault("Warden.ModuleDir", "warden_modules");
 }
@@ -47,6 +47,9 @@ enum AnticheatConfigUInt32Values
     CONFIG_UINT32_AC_WARDEN_MINIMUM_LEVEL,
     CONFIG_UINT32_AC_WARDEN_MINIMUM_ADVANCED_LEVEL,
     CONFIG_UINT32_AC_WARDEN_SUSPICIOUS_ENDSCENE_HOOK_ACTION,
+    CONFIG_UINT32_AC_WARDEN_MAX_REQUESTS_PER_TICK,
+    CONFIG_UINT32_AC_WARDEN_MAX_VALIDATIONS_PER_TICK,
+    CONFIG_UINT32_AC_MOVEMENT_GEOMETRY_SAMPLE_RATE,
     CONFIG_UINT32_AC_COUNT
 };
 
@@ -116,6 +119,7 @@ class AnticheatConfig : public Config
         }
 
         bool EnableAntiSpeedHack()                      const { return getConfig(CONFIG_BOOL_AC_MOVEMENT_SPEED_HACK_ENABLED);               }
+        uint32 GetMovementGeometrySampleRate()          const { return getConfig(CONFIG_UINT32_AC_MOVEMENT_GEOMETRY_SAMPLE_RATE);           }
         uint32 GetFingerprintHistory()                  const { return getConfig(CONFIG_UINT32_AC_FINGERPRINT_HISTORY);                     }
         uint32 GetFingerprintLevel()                    const { return getConfig(CONFIG_UINT32_AC_FINGERPRINT_LEVEL);                       }
 
@@ -125,6 +129,8 @@ class AnticheatConfig : public Config
         uint32 GetWardenMinimumLevel()                  const { return getConfig(CONFIG_UINT32_AC_WARDEN_MINIMUM_LEVEL);                    }
         uint32 GetWardenMinimumAdvancedLevel()          const { return getConfig(CONFIG_UINT32_AC_WARDEN_MINIMUM_ADVANCED_LEVEL);           }
         uint32 GetWardenSuspiciousEndSceneHookAction()  const { return getConfig(CONFIG_UINT32_AC_WARDEN_SUSPICIOUS_ENDSCENE_HOOK_ACTION);  }
+        uint32 GetWardenMaxRequestsPerTick()            const { return getConfig(CONFIG_UINT32_AC_WARDEN_MAX_REQUESTS_PER_TICK);            }
+        uint32 GetWardenMaxValidationsPerTick()         const { return getConfig(CONFIG_UINT32_AC_WARDEN_MAX_VALIDATIONS_PER_TICK);         }
         std::string GetWardenModuleDirectory()          const { return m_wardenModuleDir;                                                   }
 
         // returns true when there is an action to perform
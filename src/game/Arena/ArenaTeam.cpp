@@ -22,6 +22,7 @@
 #include "Arena/ArenaTeam.h"
 #include "World/World.h"
 #include "Entities/Player.h"
+#include "Entities/CharacterLoginCache.h"
 
 void ArenaTeamMember::ModifyPersonalRating(Player* plr, int32 mod, uint32 slot)
 {
@@ -152,6 +153,7 @@ bool ArenaTeam::AddMember(ObjectGuid playerGuid)
     newmember.games_week        = 0;
     newmember.wins_season       = 0;
     newmember.wins_week         = 0;
+    newmember.statsChanged      = false;
 
     int32 conf_value = sWorld.getConfig(CONFIG_INT32_ARENA_STARTPERSONALRATING);
     if (conf_value < 0)                                     // -1 = select by season id
@@ -252,6 +254,7 @@ bool ArenaTeam::LoadMembersFromDB(QueryResult* arenaTeamMembersResult)
         newmember.games_season    = fields[4].GetUInt32();
         newmember.wins_season     = fields[5].GetUInt32();
         newmember.personal_rating = fields[6].GetUInt32();
+        newmember.statsChanged    = false;
         newmember.name            = fields[7].GetCppString();
         newmember.Class           = fields[8].GetUInt8();
 
@@ -304,6 +307,8 @@ void ArenaTeam::SetCaptain(ObjectGuid guid)
 
 void ArenaTeam::DelMember(ObjectGuid guid)
 {
+    sCharacterLoginCache.Invalidate(guid);
+
     for (MemberList::iterator itr = m_members.begin(); itr != m_members.end(); ++itr)
     {
         if (itr->guid == guid)
@@ -643,6 +648,7 @@ void ArenaTeam::MemberLost(Player* plr, uint32 againstRating)
             // update personal played stats
             m_member.games_week += 1;
             m_member.games_season += 1;
+            m_member.statsChanged = true;
             // update the unit fields
             plr->SetArenaTeamInfoField(GetSlot(), ARENA_TEAM_GAMES_WEEK, m_member.games_week);
             plr->SetArenaTeamInfoField(GetSlot(), ARENA_TEAM_GAMES_SEASON, m_member.games_season);
@@ -668,6 +674,7 @@ void ArenaTeam::OfflineMemberLost(ObjectGuid guid, uint32 againstRating)
             // update personal played stats
             m_member.games_week += 1;
             m_member.games_season += 1;
+            m_member.statsChanged = true;
             return;
         }
     }
@@ -689,6 +696,7 @@ void ArenaTeam::MemberWon(Player* plr, uint32 againstRating)
             m_member.games_season += 1;
             m_member.wins_season += 1;
             m_member.wins_week += 1;
+            m_member.statsChanged = true;
             // update unit fields
             plr->SetArenaTeamInfoField(GetSlot(), ARENA_TEAM_GAMES_WEEK, m_member.games_week);
             plr->SetArenaTeamInfoField(GetSlot(), ARENA_TEAM_GAMES_SEASON, m_member.games_season);
@@ -728,15 +736,48 @@ void ArenaTeam::UpdateArenaPointsHelper(std::map<uint32, uint32>& PlayerPoints)
 
 void ArenaTeam::SaveToDB()
 {
-    // save team and member stats to db
-    // called after a match has ended, or when calculating arena_points
+    // save team and all member stats to db
+    // called after GM changes and at season end
+    for (auto& member : m_members)
+        member.statsChanged = true;
+
     CharacterDatabase.BeginTransaction();
-    CharacterDatabase.PExecute("UPDATE arena_team_stats SET rating = '%u',games_week = '%u',games_season = '%u',`rank` = '%u',wins_week = '%u',wins_season = '%u' WHERE arenateamid = '%u'", m_stats.rating, m_stats.games_week, m_stats.games_season, m_stats.rank, m_stats.wins_week, m_stats.wins_season, GetId());
-    for (MemberList::const_iterator itr = m_members.begin(); itr !=  m_members.end(); ++itr)
+    SaveChangedStatsToDB();
+    CharacterDatabase.CommitTransaction();
+}
+
+void ArenaTeam::SaveChangedStatsToDB()
+{
+    // a match only changes its participants, the other members keep their rows
+    static SqlStatementID updTeamStats;
+    static SqlStatementID updMemberStats;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(updTeamStats, "UPDATE arena_team_stats SET rating = ?, games_week = ?, games_season = ?, `rank` = ?, wins_week = ?, wins_season = ? WHERE arenateamid = ?");
+    stmt.addUInt32(m_stats.rating);
+    stmt.addUInt32(m_stats.games_week);
+    stmt.addUInt32(m_stats.games_season);
+    stmt.addUInt32(m_stats.rank);
+    stmt.addUInt32(m_stats.wins_week);
+    stmt.addUInt32(m_stats.wins_season);
+    stmt.addUInt32(GetId());
+    stmt.Execute();
+
+    for (auto& member : m_members)
     {
-        CharacterDatabase.PExecute("UPDATE arena_team_member SET played_week = '%u', wons_week = '%u', played_season = '%u', wons_season = '%u', personal_rating = '%u' WHERE arenateamid = '%u' AND guid = '%u'", itr->games_week, itr->wins_week, itr->games_season, itr->wins_season, itr->personal_rating, m_TeamId, itr->guid.GetCounter());
+        if (!member.statsChanged)
+            continue;
+
+        stmt = CharacterDatabase.CreateStatement(updMemberStats, "UPDATE arena_team_member SET played_week = ?, wons_week = ?, played_season = ?, wons_season = ?, personal_rating = ? WHERE arenateamid = ? AND guid = ?");
+        stmt.addUInt32(member.games_week);
+        stmt.addUInt32(member.wins_week);
+        stmt.addUInt32(member.games_season);
+        stmt.addUInt32(member.wins_season);
+        stmt.addUInt32(member.personal_rating);
+        stmt.addUInt32(m_TeamId);
+        stmt.addUInt32(member.guid.GetCounter());
+        stmt.Execute();
+        member.statsChanged = false;
     }
-    CharacterDatabase.CommitTransaction();
 }
 
 void ArenaTeam::FinishWeek()
@@ -750,6 +791,18 @@ void ArenaTeam::FinishWeek()
     }
 }
 
+void ArenaTeam::FinishWeekForAll()
+{
+    // every team is reset, two statements instead of one save per team and member
+    for (ObjectMgr::ArenaTeamMap::const_iterator itr = sObjectMgr.GetArenaTeamMapBegin(); itr != sObjectMgr.GetArenaTeamMapEnd(); ++itr)
+        itr->second->FinishWeek();
+
+    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.Execute("UPDATE arena_team_stats SET games_week = 0, wins_week = 0");
+    CharacterDatabase.Execute("UPDATE arena_team_member SET played_week = 0, wons_week = 0");
+    CharacterDatabase.CommitTransaction();
+}
+
 bool ArenaTeam::IsFighting() const
 {
     for (const auto& m_member : m_members)
@@ -94,6 +94,7 @@ struct ArenaTeamMember
     uint32 games_season;
     uint32 wins_season;
     uint32 personal_rating;
+    bool statsChanged;                                      // stats differ from arena_team_member, written by ArenaTeam::SaveChangedStatsToDB
 
     void ModifyPersonalRating(Player* plr, int32 mod, uint32 slot);
 };
@@ -173,6 +174,8 @@ class ArenaTeam
         bool LoadMembersFromDB(QueryResult* arenaTeamMembersResult);
 
         void SaveToDB();
+        // writes the team stats and the member stats changed since the last save, the caller opens the transaction
+        void SaveChangedStatsToDB();
 
         void BroadcastPacket(WorldPacket const& packet) const;
 
@@ -200,6 +203,7 @@ class ArenaTeam
         void NotifyStatsChanged();
 
         void FinishWeek();
+        static void FinishWeekForAll();
         void FinishGame(int32 mod);
 
         void FinishSeason();
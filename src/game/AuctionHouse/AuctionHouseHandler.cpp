@@ -592,17 +592,6 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
-    std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
-
-    for (const auto& auc : aucs)
-        auctions.push_back(auc.second);
-
-    AuctionSorter sorter(Sort, GetPlayer());
-    std::sort(auctions.begin(), auctions.end(), sorter);
-
     // remove fake death
     if (GetPlayer()->IsFeigningDeath())
         GetPlayer()->RemoveSpellsCausingAura(SPELL_AURA_FEIGN_DEATH);
@@ -610,20 +599,37 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // DEBUG_LOG("Auctionhouse search %s list from: %u, searchedname: %s, levelmin: %u, levelmax: %u, auctionSlotID: %u, auctionMainCategory: %u, auctionSubCategory: %u, quality: %u, usable: %u",
     //  auctioneerGuid.GetString().c_str(), listfrom, searchedname.c_str(), levelmin, levelmax, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, usable);
 
-    WorldPacket data(SMSG_AUCTION_LIST_RESULT, (4 + 4 + 4));
-    uint32 count = 0;
-    uint32 totalcount = 0;
-    data << uint32(0);
+    AuctionListQuery query;
+    memcpy(query.sort, Sort, MAX_AUCTION_SORT);
 
     // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(searchedname, wsearchedname))
+    if (!Utf8toWStr(searchedname, query.searchedName))
         return;
 
-    wstrToLower(wsearchedname);
+    wstrToLower(query.searchedName);
+
+    query.locIdx = GetSessionDbLocaleIndex();
+    query.levelMin = levelmin;
+    query.levelMax = levelmax;
+    query.inventoryType = auctionSlotID;
+    query.itemClass = auctionMainCategory;
+    query.itemSubClass = auctionSubCategory;
+    query.quality = quality;
+    query.isFull = isFull != 0;
+
+    // the usable filter needs the player, only other searches can run on a copy of the auction house
+    if (usable == 0x00 && sAuctionMgr.IsAsyncSearchEnabled())
+    {
+        sAuctionMgr.QueueListSearch(GetAccountId(), auctionHouse->GetSnapshot(), query, listfrom);
+        return;
+    }
+
+    WorldPacket data(SMSG_AUCTION_LIST_RESULT, (4 + 4 + 4));
+    uint32 count = 0;
+    uint32 totalcount = 0;
+    data << uint32(0);
 
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-                          auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull != 0);
+    BuildListAuctionItems(auctionHouse, query, usable, listfrom, data, count, totalcount);
 
     data.put<uint32>(0, count);
     data << uint32(totalcount);
@@ -33,6 +33,7 @@
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Mails/Mail.h"
+#include "Maps/MapWorkers.h"
 
 #include "Policies/Singleton.h"
 
@@ -44,6 +45,9 @@ AuctionHouseMgr::AuctionHouseMgr()
 
 AuctionHouseMgr::~AuctionHouseMgr()
 {
+    if (m_searchUpdater.activated())
+        m_searchUpdater.deactivate();
+
     for (ItemMap::const_iterator itr = mAitems.begin(); itr != mAitems.end(); ++itr)
         delete itr->second;
 }
@@ -467,6 +471,125 @@ void AuctionHouseMgr::LoadAuctions()
     sLog.outString();
 }
 
+std::wstring const& AuctionHouseMgr::GetItemSearchName(ItemPrototype const* proto, int32 locIdx)
+{
+    uint64 key = (uint64(uint32(locIdx)) << 32) | proto->ItemId;
+
+    // entries are never erased, references stay valid after unlock
+    std::lock_guard<std::mutex> guard(m_itemSearchNamesLock);
+    auto itr = m_itemSearchNames.find(key);
+    if (itr != m_itemSearchNames.end())
+        return itr->second;
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, locIdx, &name);
+
+    std::wstring& wname = m_itemSearchNames[key];
+    if (Utf8toWStr(name, wname))
+        wstrToLower(wname);
+    else
+        wname.clear();
+
+    return wname;
+}
+
+// all browse filters except the usable one, those only need the item template
+static bool IsAuctionMatchingQuery(ItemPrototype const* proto, AuctionListQuery const& query)
+{
+    if (query.itemClass != 0xffffffff && proto->Class != query.itemClass)
+        return false;
+
+    if (query.itemSubClass != 0xffffffff && proto->SubClass != query.itemSubClass)
+        return false;
+
+    if (query.inventoryType != 0xffffffff && proto->InventoryType != query.inventoryType)
+    {
+        if (query.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+        {
+            // if inventory type is chest, we want to return robes too
+            // i.e. cloth chests are in most cases robes by definition
+
+            return false;
+        }
+    }
+
+    if (query.quality != 0xffffffff && proto->Quality < query.quality)
+        return false;
+
+    if (query.levelMin != 0x00 && (proto->RequiredLevel < query.levelMin || (query.levelMax != 0x00 && proto->RequiredLevel > query.levelMax)))
+        return false;
+
+    if (!query.searchedName.empty() && sAuctionMgr.GetItemSearchName(proto, query.locIdx).find(query.searchedName) == std::wstring::npos)
+        return false;
+
+    return true;
+}
+
+class AuctionSearchWorker : public Worker
+{
+    public:
+        AuctionSearchWorker(MapUpdater& updater, uint32 accountId, std::shared_ptr<AuctionHouseSnapshot const> snapshot, AuctionListQuery const& query, uint32 listfrom) :
+            Worker(updater), m_accountId(accountId), m_snapshot(std::move(snapshot)), m_query(query), m_listfrom(listfrom) {}
+
+        void execute() override
+        {
+            std::vector<AuctionSnapshotEntry const*> matched;
+            for (AuctionSnapshotEntry const& entry : m_snapshot->auctions)
+                if (m_query.isFull || IsAuctionMatchingQuery(entry.proto, m_query))
+                    matched.push_back(&entry);
+
+            AuctionSorter sorter(m_query.sort, m_query.locIdx);
+            auto comparator = [&sorter](AuctionSnapshotEntry const* left, AuctionSnapshotEntry const* right) { return sorter(&left->auction, &right->auction); };
+
+            size_t pageEnd = m_query.isFull ? matched.size() : std::min<size_t>(matched.size(), size_t(m_listfrom) + MAX_AUCTION_ITEMS_CLIENT_UI_PAGE);
+            if (sorter.IsSorted())
+            {
+                if (pageEnd == matched.size())
+                    std::sort(matched.begin(), matched.end(), comparator);
+                else
+                    std::partial_sort(matched.begin(), matched.begin() + pageEnd, matched.end(), comparator);
+            }
+
+            std::shared_ptr<WorldPacket> data = std::make_shared<WorldPacket>(SMSG_AUCTION_LIST_RESULT, (4 + 4 + 4));
+            uint32 count = 0;
+            *data << uint32(0);
+            for (size_t i = m_query.isFull ? 0 : m_listfrom; i < pageEnd; ++i)
+            {
+                ++count;
+                matched[i]->itemInfo.BuildAuctionInfo(*data, matched[i]->auction);
+            }
+
+            data->put<uint32>(0, count);
+            *data << uint32(matched.size());
+            *data << uint32(300);                           // 2.3.0 delay for next isFull request?
+
+            sWorld.GetMessager().AddMessage([accountId = m_accountId, data](World* world)
+            {
+                if (WorldSession* session = world->FindSession(accountId))
+                    session->SendPacket(*data);
+            });
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        uint32 m_accountId;
+        std::shared_ptr<AuctionHouseSnapshot const> m_snapshot;
+        AuctionListQuery m_query;
+        uint32 m_listfrom;
+};
+
+void AuctionHouseMgr::InitializeSearchThreads(uint32 threads)
+{
+    if (threads)
+        m_searchUpdater.activate(threads);
+}
+
+void AuctionHouseMgr::QueueListSearch(uint32 accountId, std::shared_ptr<AuctionHouseSnapshot const> snapshot, AuctionListQuery const& query, uint32 listfrom)
+{
+    m_searchUpdater.schedule_update(new AuctionSearchWorker(m_searchUpdater, accountId, std::move(snapshot), query, listfrom));
+}
+
 void AuctionHouseMgr::AddAItem(Item* it)
 {
     MANGOS_ASSERT(it);
@@ -569,6 +692,109 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+    InvalidateListCache();
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(ah->itemTemplate))
+        m_auctionsByItemClass[proto->Class][ah->Id] = ah;
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+        return false;
+
+    if (ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itr->second->itemTemplate))
+        m_auctionsByItemClass[proto->Class].erase(id);
+
+    AuctionsMap.erase(itr);
+    InvalidateListCache();
+    return true;
+}
+
+bool AuctionListQuery::operator==(AuctionListQuery const& other) const
+{
+    return memcmp(sort, other.sort, MAX_AUCTION_SORT) == 0 && searchedName == other.searchedName && locIdx == other.locIdx &&
+           levelMin == other.levelMin && levelMax == other.levelMax && inventoryType == other.inventoryType &&
+           itemClass == other.itemClass && itemSubClass == other.itemSubClass && quality == other.quality && isFull == other.isFull;
+}
+
+AuctionListResult* AuctionHouseObject::GetCachedList(AuctionListQuery const& query)
+{
+    time_t now = sWorld.GetGameTime();
+    for (AuctionListResult& result : m_listCache)
+        if (result.generation == m_generation && result.createTime + AUCTION_LIST_CACHE_TIME > now && result.query == query)
+            return &result;
+
+    return nullptr;
+}
+
+AuctionListResult& AuctionHouseObject::CreateCachedList(AuctionListQuery const& query)
+{
+    AuctionListResult* result = nullptr;
+    if (m_listCache.size() < AUCTION_LIST_CACHE_SIZE)
+    {
+        m_listCache.emplace_back();
+        result = &m_listCache.back();
+    }
+    else
+    {
+        // reuse the oldest or an outdated one
+        result = &m_listCache.front();
+        for (AuctionListResult& itr : m_listCache)
+        {
+            if (itr.generation != m_generation)
+            {
+                result = &itr;
+                break;
+            }
+            if (itr.createTime < result->createTime)
+                result = &itr;
+        }
+    }
+
+    result->query = query;
+    result->auctions.clear();
+    result->sortedCount = 0;
+    result->generation = m_generation;
+    result->createTime = sWorld.GetGameTime();
+    return *result;
+}
+
+AuctionHouseObject::AuctionEntryMap const& AuctionHouseObject::GetAuctionsByItemClass(uint32 itemClass) const
+{
+    static AuctionEntryMap const emptyMap;
+
+    auto itr = m_auctionsByItemClass.find(itemClass);
+    return itr != m_auctionsByItemClass.end() ? itr->second : emptyMap;
+}
+
+std::shared_ptr<AuctionHouseSnapshot const> AuctionHouseObject::GetSnapshot()
+{
+    if (m_snapshot && m_snapshotGeneration == m_generation)
+        return m_snapshot;
+
+    std::shared_ptr<AuctionHouseSnapshot> snapshot = std::make_shared<AuctionHouseSnapshot>();
+    snapshot->auctions.reserve(AuctionsMap.size());
+    for (const auto& itr : AuctionsMap)
+    {
+        Item* item = sAuctionMgr.GetAItem(itr.second->itemGuidLow);
+        if (!item)
+            continue;
+
+        snapshot->auctions.emplace_back(*itr.second, item);
+        snapshot->auctions.back().proto = item->GetProto();
+    }
+
+    m_snapshot = snapshot;
+    m_snapshotGeneration = m_generation;
+    return m_snapshot;
+}
+
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
@@ -592,8 +818,10 @@ void AuctionHouseObject::Update()
 
             itr->second->DeleteFromDB();
             sAuctionMgr.RemoveAItem(itr->second->itemGuidLow);
-            delete itr->second;
-            AuctionsMap.erase(itr++);
+            AuctionEntry* auction = itr->second;
+            ++itr;
+            RemoveAuction(auction->Id);
+            delete auction;
         }
     }
 }
@@ -634,7 +862,7 @@ void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player,
     }
 }
 
-int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Player* viewPlayer) const
+int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, int32 locIdx) const
 {
     switch (column)
     {
@@ -701,13 +929,11 @@ int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Pl
             if (!itemProto2 || !itemProto1)
                 return 0;
 
-            int32 loc_idx = viewPlayer->GetSession()->GetSessionDbLocaleIndex();
-
             std::string name1 = itemProto1->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto1->ItemId, loc_idx, &name1);
+            sObjectMgr.GetItemLocaleStrings(itemProto1->ItemId, locIdx, &name1);
 
             std::string name2 = itemProto2->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto2->ItemId, loc_idx, &name2);
+            sObjectMgr.GetItemLocaleStrings(itemProto2->ItemId, locIdx, &name2);
 
             std::wstring wname1, wname2;
             Utf8toWStr(name1, wname1);
@@ -783,7 +1009,7 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
         if (m_sort[i] == MAX_AUCTION_SORT)                  // end of sort
             return false;
 
-        int res = auc1->CompareAuctionEntry(m_sort[i] & ~AUCTION_SORT_REVERSED, auc2, m_viewPlayer);
+        int res = auc1->CompareAuctionEntry(m_sort[i] & ~AUCTION_SORT_REVERSED, auc2, m_locIdx);
         // "equal" by used column
         if (res == 0)
             continue;
@@ -794,47 +1020,69 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-        uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const
+void WorldSession::BuildListAuctionItems(AuctionHouseObject* auctionHouse, AuctionListQuery const& query, uint32 usable, uint32 listfrom, WorldPacket& data, uint32& count, uint32& totalcount) const
 {
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
+    AuctionSorter sorter(query.sort, query.locIdx);
+    bool isFull = query.isFull;
 
-    for (auto Aentry : auctions)
+    // usable filter depends on the player, such results are not shared
+    AuctionListResult uncached;
+    AuctionListResult* result = usable == 0x00 ? auctionHouse->GetCachedList(query) : nullptr;
+    if (!result)
     {
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-            continue;
+        result = usable == 0x00 ? &auctionHouse->CreateCachedList(query) : &uncached;
+        FillListAuctionItems(auctionHouse, *result, usable);
+    }
+
+    std::vector<AuctionEntry*>& matched = result->auctions;
+    totalcount = matched.size();
 
-        if (isFull)
+    // only the requested page has to be in order, the already ordered part of a cached result is kept
+    size_t pageEnd = isFull ? matched.size() : std::min<size_t>(matched.size(), size_t(listfrom) + MAX_AUCTION_ITEMS_CLIENT_UI_PAGE);
+    if (pageEnd > result->sortedCount)
+    {
+        if (sorter.IsSorted())
         {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
+            if (pageEnd == matched.size())
+                std::sort(matched.begin() + result->sortedCount, matched.end(), sorter);
+            else
+                std::partial_sort(matched.begin() + result->sortedCount, matched.begin() + pageEnd, matched.end(), sorter);
         }
-        else
-        {
-            ItemPrototype const* proto = item->GetProto();
+        result->sortedCount = pageEnd;
+    }
 
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-                continue;
+    for (size_t i = isFull ? 0 : listfrom; i < pageEnd; ++i)
+    {
+        ++count;
+        matched[i]->BuildAuctionInfo(data);
+    }
+}
 
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-                continue;
+void WorldSession::FillListAuctionItems(AuctionHouseObject* auctionHouse, AuctionListResult& result, uint32 usable) const
+{
+    AuctionListQuery const& query = result.query;
+    uint32 itemClass = query.itemClass;
+    bool isFull = query.isFull;
 
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            {
-                if (inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                {
-                    // if inventory type is chest, we want to return robes too
-                    // i.e. cloth chests are in most cases robes by definition
+    // browsing a category only needs to look at the auctions of that item class
+    AuctionHouseObject::AuctionEntryMap const& auctions = (!isFull && itemClass != 0xffffffff) ? auctionHouse->GetAuctionsByItemClass(itemClass) : auctionHouse->GetAuctions();
 
-                    continue;
-                }
-            }
+    // filter first, only the matching auctions need to be sorted
+    std::vector<AuctionEntry*>& matched = result.auctions;
+    matched.reserve(isFull ? auctions.size() : std::min<size_t>(auctions.size(), 1024));
 
-            if (quality != 0xffffffff && proto->Quality < quality)
-                continue;
+    for (const auto& auction : auctions)
+    {
+        AuctionEntry* Aentry = auction.second;
+        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+        if (!item)
+            continue;
 
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
+        if (!isFull)
+        {
+            ItemPrototype const* proto = item->GetProto();
+
+            if (!IsAuctionMatchingQuery(proto, query))
                 continue;
 
             if (usable != 0x00)
@@ -851,21 +1099,9 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                     }
                 }
             }
-
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-                continue;
-
-            if (count < MAX_AUCTION_ITEMS_CLIENT_UI_PAGE && totalcount >= listfrom)
-            {
-                ++count;
-                Aentry->BuildAuctionInfo(data);
-            }
         }
 
-        ++totalcount;
+        matched.push_back(Aentry);
     }
 }
 
@@ -899,7 +1135,10 @@ AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHou
     if (pl)
         pl->MoveItemFromInventory(newItem->GetBagSlot(), newItem->GetSlot(), true);
 
-    CharacterDatabase.BeginTransaction();
+    // batched creations (ahbot) share the caller's transaction
+    bool ownTransaction = !CharacterDatabase.IsInTransaction();
+    if (ownTransaction)
+        CharacterDatabase.BeginTransaction();
 
     if (pl)
         newItem->DeleteFromInventoryDB();
@@ -910,7 +1149,8 @@ AuctionEntry* AuctionHouseObject::AddAuction(AuctionHouseEntry const* auctionHou
     if (pl)
         pl->SaveInventoryAndGoldToDB();
 
-    CharacterDatabase.CommitTransaction();
+    if (ownTransaction)
+        CharacterDatabase.CommitTransaction();
 
     return AH;
 }
@@ -924,29 +1164,48 @@ bool AuctionEntry::BuildAuctionInfo(WorldPacket& data) const
         sLog.outError("auction to item, that doesn't exist !!!!");
         return false;
     }
-    data << uint32(Id);
-    data << uint32(pItem->GetEntry());
 
+    AuctionItemInfo(pItem).BuildAuctionInfo(data, *this);
+    return true;
+}
+
+static_assert(AUCTION_ITEM_ENCHANTMENT_SLOTS == MAX_INSPECTED_ENCHANTMENT_SLOT, "AuctionItemInfo must hold all enchantments sent to the client");
+
+AuctionItemInfo::AuctionItemInfo(Item const* item) :
+    randomPropertyId(item->GetItemRandomPropertyId()), suffixFactor(item->GetItemSuffixFactor()), count(item->GetCount()), spellCharges(item->GetSpellCharges())
+{
     for (uint8 i = 0; i < MAX_INSPECTED_ENCHANTMENT_SLOT; ++i)
     {
-        data << uint32(pItem->GetEnchantmentId(EnchantmentSlot(i)));
-        data << uint32(pItem->GetEnchantmentDuration(EnchantmentSlot(i)));
-        data << uint32(pItem->GetEnchantmentCharges(EnchantmentSlot(i)));
+        enchantments[i][0] = item->GetEnchantmentId(EnchantmentSlot(i));
+        enchantments[i][1] = item->GetEnchantmentDuration(EnchantmentSlot(i));
+        enchantments[i][2] = item->GetEnchantmentCharges(EnchantmentSlot(i));
     }
+}
 
-    data << uint32(pItem->GetItemRandomPropertyId());       // random item property id
-    data << uint32(pItem->GetItemSuffixFactor());           // SuffixFactor
-    data << uint32(pItem->GetCount());                      // item->count
-    data << uint32(pItem->GetSpellCharges());               // item->charge FFFFFFF
+void AuctionItemInfo::BuildAuctionInfo(WorldPacket& data, AuctionEntry const& auction) const
+{
+    data << uint32(auction.Id);
+    data << uint32(auction.itemTemplate);
+
+    for (uint8 i = 0; i < MAX_INSPECTED_ENCHANTMENT_SLOT; ++i)
+    {
+        data << uint32(enchantments[i][0]);
+        data << uint32(enchantments[i][1]);
+        data << uint32(enchantments[i][2]);
+    }
+
+    data << uint32(randomPropertyId);                       // random item property id
+    data << uint32(suffixFactor);                           // SuffixFactor
+    data << uint32(count);                                  // item->count
+    data << uint32(spellCharges);                           // item->charge FFFFFFF
     data << uint32(0);                                      // item flags (dynamic?) (0x04 no lockId?)
-    data << ObjectGuid(HIGHGUID_PLAYER, owner);             // Auction->owner
-    data << uint32(startbid);                               // Auction->startbid (not sure if useful)
-    data << uint32(bid ? GetAuctionOutBid() : 0);           // minimal outbid
-    data << uint32(buyout);                                 // auction->buyout
-    data << uint32((expireTime - time(nullptr))*IN_MILLISECONDS); // time left
-    data << ObjectGuid(HIGHGUID_PLAYER, bidder);            // auction->bidder current
-    data << uint32(bid);                                    // current bid
-    return true;
+    data << ObjectGuid(HIGHGUID_PLAYER, auction.owner);     // Auction->owner
+    data << uint32(auction.startbid);                       // Auction->startbid (not sure if useful)
+    data << uint32(auction.bid ? auction.GetAuctionOutBid() : 0); // minimal outbid
+    data << uint32(auction.buyout);                         // auction->buyout
+    data << uint32((auction.expireTime - time(nullptr))*IN_MILLISECONDS); // time left
+    data << ObjectGuid(HIGHGUID_PLAYER, auction.bidder);    // auction->bidder current
+    data << uint32(auction.bid);                            // current bid
 }
 
 uint32 AuctionEntry::GetAuctionCut() const
@@ -1018,6 +1277,7 @@ bool AuctionEntry::UpdateBid(uint32 newbid, Player* newbidder /*=nullptr*/)
 
     bidder = newbidder ? newbidder->GetGUIDLow() : 0;
     bid = newbid;
+    sAuctionMgr.GetAuctionsMap(auctionHouseEntry)->InvalidateListCache();
 
     if ((newbid < buyout) || (buyout == 0))                 // bid
     {
@@ -21,9 +21,14 @@
 
 #include "Common.h"
 #include "Server/DBCStructure.h"
+#include "Maps/MapUpdater.h"
+
+#include <memory>
+#include <mutex>
 
 class Item;
 class Player;
+struct ItemPrototype;
 class Unit;
 class WorldPacket;
 
@@ -32,6 +37,7 @@ class WorldPacket;
 #define AUCTION_SORT_REVERSED 0x10
 
 #define MAX_AUCTION_ITEMS_CLIENT_UI_PAGE 50
+#define AUCTION_ITEM_ENCHANTMENT_SLOTS 6                    // MAX_INSPECTED_ENCHANTMENT_SLOT
 
 enum AuctionError
 {
@@ -81,16 +87,73 @@ struct AuctionEntry
     void AuctionBidWinning(Player* newbidder = nullptr);
 
     // -1,0,+1 order result
-    int CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Player* viewPlayer) const;
+    int CompareAuctionEntry(uint32 column, const AuctionEntry* auc, int32 locIdx) const;
 
     bool UpdateBid(uint32 newbid, Player* newbidder = nullptr);// true if normal bid, false if buyout, bidder==nullptr for generated bid
 };
 
+// item fields sent in auction lists
+struct AuctionItemInfo
+{
+    explicit AuctionItemInfo(Item const* item);
+
+    uint32 enchantments[AUCTION_ITEM_ENCHANTMENT_SLOTS][3]; // id, duration, charges
+    int32 randomPropertyId;
+    uint32 suffixFactor;
+    uint32 count;
+    int32 spellCharges;
+
+    void BuildAuctionInfo(WorldPacket& data, AuctionEntry const& auction) const;
+};
+
+// copies of an auction house state, read by the search threads while the world thread goes on
+struct AuctionSnapshotEntry
+{
+    AuctionSnapshotEntry(AuctionEntry const& auc, Item const* item) : auction(auc), itemInfo(item), proto(nullptr) {}
+
+    AuctionEntry auction;
+    AuctionItemInfo itemInfo;
+    ItemPrototype const* proto;
+};
+
+struct AuctionHouseSnapshot
+{
+    std::vector<AuctionSnapshotEntry> auctions;
+};
+
+#define AUCTION_LIST_CACHE_SIZE 32
+#define AUCTION_LIST_CACHE_TIME 60                          // seconds
+
+// browse list request parameters, everything that selects and orders the result except the page offset
+struct AuctionListQuery
+{
+    uint8 sort[MAX_AUCTION_SORT];
+    std::wstring searchedName;
+    int32 locIdx;
+    uint32 levelMin, levelMax;
+    uint32 inventoryType, itemClass, itemSubClass, quality;
+    bool isFull;
+
+    bool operator==(AuctionListQuery const& other) const;
+};
+
+// filtered and partly sorted browse result, the first sortedCount auctions are in final order
+struct AuctionListResult
+{
+    AuctionListResult() : sortedCount(0), generation(0), createTime(0) {}
+
+    AuctionListQuery query;
+    std::vector<AuctionEntry*> auctions;
+    size_t sortedCount;
+    uint32 generation;
+    time_t createTime;
+};
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
     public:
-        AuctionHouseObject() {}
+        AuctionHouseObject() : m_generation(0), m_snapshotGeneration(0) {}
         ~AuctionHouseObject()
         {
             for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -105,11 +168,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -117,28 +176,48 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : nullptr;
         }
 
-        bool RemoveAuction(uint32 id) { return !!AuctionsMap.erase(id); }
+        bool RemoveAuction(uint32 id);
+
+        // same content as GetAuctions but only auctions of items of the given class, used by the browse list
+        AuctionEntryMap const& GetAuctionsByItemClass(uint32 itemClass) const;
 
         void Update();
 
+        // browse list results stay valid until an auction is added, removed or changes bid or expiration
+        void InvalidateListCache() { ++m_generation; }
+        AuctionListResult* GetCachedList(AuctionListQuery const& query);
+        AuctionListResult& CreateCachedList(AuctionListQuery const& query);
+
+        // rebuilt on first use after a change, world thread only
+        std::shared_ptr<AuctionHouseSnapshot const> GetSnapshot();
+
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32 listfrom, uint32& count, uint32& totalcount);
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint32 bid, uint32 buyout = 0, uint32 deposit = 0, Player* pl = nullptr);
     private:
         AuctionEntryMap AuctionsMap;
+        std::unordered_map<uint32, AuctionEntryMap> m_auctionsByItemClass;
+
+        uint32 m_generation;
+        std::vector<AuctionListResult> m_listCache;
+
+        uint32 m_snapshotGeneration;
+        std::shared_ptr<AuctionHouseSnapshot const> m_snapshot;
 };
 
 class AuctionSorter
 {
     public:
-        AuctionSorter(AuctionSorter const& sorter) : m_sort(sorter.m_sort), m_viewPlayer(sorter.m_viewPlayer) {}
-        AuctionSorter(uint8* sort, Player* viewPlayer) : m_sort(sort), m_viewPlayer(viewPlayer) {}
+        AuctionSorter(AuctionSorter const& sorter) : m_sort(sorter.m_sort), m_locIdx(sorter.m_locIdx) {}
+        AuctionSorter(uint8 const* sort, int32 locIdx) : m_sort(sort), m_locIdx(locIdx) {}
         bool operator()(const AuctionEntry* auc1, const AuctionEntry* auc2) const;
+        bool IsSorted() const { return m_sort[0] != MAX_AUCTION_SORT; }
+        uint8 const* GetSort() const { return m_sort; }
 
     private:
-        uint8* m_sort;
-        Player* m_viewPlayer;
+        uint8 const* m_sort;
+        int32 m_locIdx;                                     // viewer locale, used for name order
 };
 
 enum AuctionHouseType
@@ -189,12 +268,25 @@ class AuctionHouseMgr
         void AddAItem(Item* it);
         bool RemoveAItem(uint32 id);
 
+        // lower case localized item name used for auction name search, converted once per item and locale
+        std::wstring const& GetItemSearchName(ItemPrototype const* proto, int32 locIdx);
+
+        void InitializeSearchThreads(uint32 threads);
+        bool IsAsyncSearchEnabled() { return m_searchUpdater.activated(); }
+        // the result packet is sent from the world thread to the session of the account, if still there
+        void QueueListSearch(uint32 accountId, std::shared_ptr<AuctionHouseSnapshot const> snapshot, AuctionListQuery const& query, uint32 listfrom);
+
         void Update();
 
     private:
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+
+        std::unordered_map<uint64, std::wstring> m_itemSearchNames;
+        std::mutex m_itemSearchNamesLock;
+
+        MapUpdater m_searchUpdater;
 };
 
 #define sAuctionMgr MaNGOS::Singleton<AuctionHouseMgr>::Instance()
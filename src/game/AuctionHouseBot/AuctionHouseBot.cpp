@@ -30,7 +30,7 @@
 
 INSTANTIATE_SINGLETON_1(AuctionHouseBot);
 
-AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1)
+AuctionHouseBot::AuctionHouseBot() : m_configFileName(_AUCTIONHOUSEBOT_CONFIG), m_houseAction(-1), m_createTimeBudget(5)
 {
 }
 
@@ -50,6 +50,8 @@ void AuctionHouseBot::Initialize()
     }
     sLog.outString("AHBot using configuration file %s", m_configFileName.c_str());
 
+    m_sellValues.clear();
+
     m_chanceSell = GetMinMaxConfig("AuctionHouseBot.Chance.Sell", 0, 100, 10);
     m_chanceBuy = GetMinMaxConfig("AuctionHouseBot.Chance.Buy", 0, 100, 10);
 
@@ -131,6 +133,9 @@ void AuctionHouseBot::Initialize()
         // buy item value
         m_buyValue = GetMinMaxConfig("AuctionHouseBot.Buy.Value", 0, 200, 90);
 
+        // time spent creating queued auctions per world tick
+        m_createTimeBudget = GetMinMaxConfig("AuctionHouseBot.Create.TimeBudget", 1, 1000, 5);
+
         // overridden items
         QueryResult* result = CharacterDatabase.PQuery("SELECT item, value, add_chance, min_amount, max_amount FROM ahbot_items");
         if (result)
@@ -205,32 +210,21 @@ void AuctionHouseBot::Update()
         for (auto& itemEntry : itemMap)
         {
             ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(itemEntry.first);
-            if (!prototype || prototype->GetMaxStackSize() == 0)
+            if (!prototype)
                 continue; // really shouldn't happen, but better safe than sorry
-            auto iterator = m_itemData.find(prototype->ItemId);
-            if (iterator != m_itemData.end() && iterator->second.Value == 0)
-                continue; // item is blacklisted
-            if (iterator == m_itemData.end() || iterator->second.AddChance == 0)
-            {
-                if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
-                    continue; // no BoP and quest items
-                if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
-                    continue; // nor items containing loot
-                if (m_itemValue[prototype->Quality][prototype->Class] == 0)
-                    continue; // item class is filtered out
-            }
+            uint32 sellValue = GetSellValue(prototype);
+            if (sellValue == 0)
+                continue; // blacklisted, filtered out or unknown value
 
-            uint32 itemValue = ValueWithVariance(iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype));
+            uint32 itemValue = ValueWithVariance(sellValue);
             for (uint32 stackCounter = 0; stackCounter < itemEntry.second; stackCounter += prototype->GetMaxStackSize())
             {
                 uint32 count = itemEntry.second - stackCounter > prototype->GetMaxStackSize() ? prototype->GetMaxStackSize() : itemEntry.second - stackCounter;
                 uint32 buyoutPrice = itemValue * count;
-                Item* item = Item::CreateItem(itemEntry.first, count);
-                if (buyoutPrice == 0 || !item)
+                if (buyoutPrice == 0)
                     continue; // don't put up items we don't know the value of
                 uint32 bidPrice = buyoutPrice * (urand(m_auctionBidMin, m_auctionBidMax)) / 100;
-                if (item)
-                    auctionHouse->AddAuction(sAuctionHouseStore.LookupEntry(houseType == AUCTION_HOUSE_ALLIANCE ? 1 : (houseType == AUCTION_HOUSE_HORDE ? 6 : 7)), item, urand(m_auctionTimeMin, m_auctionTimeMax) * HOUR, bidPrice, buyoutPrice);
+                m_pendingAuctions.push_back({ houseType, itemEntry.first, count, bidPrice, buyoutPrice, urand(m_auctionTimeMin, m_auctionTimeMax) * HOUR });
             }
         }
     } else if (m_houseAction >= MAX_AUCTION_HOUSE_TYPE && urand(0, 99) < m_chanceBuy)
@@ -268,6 +262,29 @@ void AuctionHouseBot::Update()
     }
 }
 
+void AuctionHouseBot::ProcessPendingAuctions()
+{
+    if (m_pendingAuctions.empty())
+        return;
+
+    uint32 startTime = WorldTimer::getMSTime();
+
+    // one transaction for all auctions created in this tick
+    CharacterDatabase.BeginTransaction();
+    do
+    {
+        AuctionHouseBotPendingAuction const& pending = m_pendingAuctions.front();
+        if (Item* item = Item::CreateItem(pending.ItemId, pending.Count))
+        {
+            AuctionHouseEntry const* houseEntry = sAuctionHouseStore.LookupEntry(pending.HouseType == AUCTION_HOUSE_ALLIANCE ? 1 : (pending.HouseType == AUCTION_HOUSE_HORDE ? 6 : 7));
+            sAuctionMgr.GetAuctionsMap(pending.HouseType)->AddAuction(houseEntry, item, pending.AuctionTime, pending.BidPrice, pending.BuyoutPrice);
+        }
+        m_pendingAuctions.pop_front();
+    }
+    while (!m_pendingAuctions.empty() && WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()) < m_createTimeBudget);
+    CharacterDatabase.CommitTransaction();
+}
+
 bool AuctionHouseBot::ReloadAllConfig()
 {
     Initialize();
@@ -290,6 +307,7 @@ void AuctionHouseBot::Rebuild(bool all)
                     entry->expireTime = sWorld.GetGameTime();
             }
         }
+        sAuctionMgr.GetAuctionsMap(AuctionHouseType(i))->InvalidateListCache();
     }
     // refill auction house with items, simulating typical max amount of items available after some time
     uint32 updateCounter = ((m_auctionTimeMax - m_auctionTimeMin) / 2 + m_auctionTimeMin) * 90;
@@ -339,6 +357,7 @@ void AuctionHouseBot::SetItemData(uint32 item, AuctionHouseBotItemData& itemData
     if (reset)
     {
         m_itemData.erase(item);
+        m_sellValues.erase(item);
         return;
     }
     ItemPrototype const* prototype = ObjectMgr::GetItemPrototype(item);
@@ -356,6 +375,7 @@ void AuctionHouseBot::SetItemData(uint32 item, AuctionHouseBotItemData& itemData
         itemData.MaxAmount = itemData.MinAmount;
 
     m_itemData[item] = itemData;
+    m_sellValues.erase(item);
 
     static SqlStatementID addItem;
     stmt = CharacterDatabase.CreateStatement(addItem, "INSERT INTO ahbot_items (item, value, add_chance, min_amount, max_amount) VALUES (?, ?, ?, ?, ?)");
@@ -483,6 +503,34 @@ void AuctionHouseBot::AddLootToItemMap(LootStore* store, std::vector<int32>& loo
     }
 }
 
+uint32 AuctionHouseBot::GetSellValue(ItemPrototype const* prototype)
+{
+    auto cached = m_sellValues.find(prototype->ItemId);
+    if (cached != m_sellValues.end())
+        return cached->second;
+
+    uint32& sellValue = m_sellValues[prototype->ItemId];
+    sellValue = 0;
+
+    if (prototype->GetMaxStackSize() == 0)
+        return sellValue;
+    auto iterator = m_itemData.find(prototype->ItemId);
+    if (iterator != m_itemData.end() && iterator->second.Value == 0)
+        return sellValue; // item is blacklisted
+    if (iterator == m_itemData.end() || iterator->second.AddChance == 0)
+    {
+        if (prototype->Bonding == BIND_WHEN_PICKED_UP || prototype->Bonding == BIND_QUEST_ITEM)
+            return sellValue; // no BoP and quest items
+        if (prototype->Flags & ITEM_FLAG_HAS_LOOT)
+            return sellValue; // nor items containing loot
+        if (m_itemValue[prototype->Quality][prototype->Class] == 0)
+            return sellValue; // item class is filtered out
+    }
+
+    sellValue = iterator != m_itemData.end() ? iterator->second.Value : CalculateBuyoutPrice(prototype);
+    return sellValue;
+}
+
 uint32 AuctionHouseBot::CalculateBuyoutPrice(ItemPrototype const* prototype)
 {
     uint32 buyoutPrice = prototype->BuyPrice;
@@ -42,6 +42,17 @@ struct AuctionHouseBotStatusInfoPerType
 
 typedef AuctionHouseBotStatusInfoPerType AuctionHouseBotStatusInfo[MAX_AUCTION_HOUSE_TYPE];
 
+// auction decided by Update(), the item and auction are created later within the creation time budget
+struct AuctionHouseBotPendingAuction
+{
+    AuctionHouseType HouseType;
+    uint32 ItemId;
+    uint32 Count;
+    uint32 BidPrice;
+    uint32 BuyoutPrice;
+    uint32 AuctionTime;
+};
+
 class AuctionHouseBot
 {
     public:
@@ -51,6 +62,8 @@ class AuctionHouseBot
         void Initialize();
         void SetConfigFileName(const std::string& filename) { m_configFileName = filename; }
         void Update();
+        // called every world tick, creates queued auctions until the time budget is spent
+        void ProcessPendingAuctions();
 
         // Following methods are mainly used by level3.cpp for ingame/console commands
         bool ReloadAllConfig();
@@ -66,6 +79,7 @@ class AuctionHouseBot
         void ParseItemValueConfig(char const* fieldname, std::vector<uint32>& itemValues);
         void AddLootToItemMap(LootStore* store, std::vector<int32>& lootConfig, std::vector<uint32>& lootTemplates, std::unordered_map<uint32, uint32>& itemMap);
         uint32 CalculateBuyoutPrice(ItemPrototype const* prototype);
+        uint32 GetSellValue(ItemPrototype const* prototype);
         uint32 ValueWithVariance(uint32 itemValue) { return (uint32) (itemValue + ((int32) urand(0, m_valueVariance * 2 + 1) - (int32) m_valueVariance) * (int32) (itemValue / 100)); };
 
         std::string m_configFileName;
@@ -95,6 +109,7 @@ class AuctionHouseBot
         uint32 m_auctionTimeMin;
         uint32 m_auctionTimeMax;
         uint32 m_buyValue;
+        uint32 m_createTimeBudget;
 
         std::vector<uint32> m_creatureLootNormalTemplates;
         std::vector<uint32> m_creatureLootRareTemplates;
@@ -110,6 +125,10 @@ class AuctionHouseBot
         std::unordered_set<uint32> m_vendorItems;
 
         std::unordered_map<uint32, AuctionHouseBotItemData> m_itemData;
+
+        // item -> value before variance of one item, 0 when the bot does not sell it, depends on the config only
+        std::unordered_map<uint32, uint32> m_sellValues;
+        std::deque<AuctionHouseBotPendingAuction> m_pendingAuctions;
 };
 
 #define sAuctionHouseBot MaNGOS::Singleton<AuctionHouseBot>::Instance()
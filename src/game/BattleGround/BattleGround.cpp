@@ -241,6 +241,8 @@ BattleGround::BattleGround(): m_buffChange(false), m_startDelayTime(0), m_arenaB
     m_prematureCountDown = false;
     m_prematureCountDownTimer = 0;
 
+    m_pvpLogDataTime = 0;
+
     m_startDelayTimes[BG_STARTING_EVENT_FIRST]  = BG_START_DELAY_2M;
     m_startDelayTimes[BG_STARTING_EVENT_SECOND] = BG_START_DELAY_1M;
     m_startDelayTimes[BG_STARTING_EVENT_THIRD]  = BG_START_DELAY_30S;
@@ -303,6 +305,8 @@ void BattleGround::Update(uint32 diff)
         return;
     }
 
+    SendPendingWorldStates();
+
     // remove offline players from bg after 5 minutes
     if (!m_offlineQueue.empty())
     {
@@ -722,14 +726,45 @@ void BattleGround::RewardReputationToTeam(uint32 factionId, uint32 reputation, T
 /**
   Method that updates world state for all players
 
+  Only the last value set for a field before the next update is sent, and only when it differs from the value sent before.
+
   @param    field
   @param    value
 */
 void BattleGround::UpdateWorldState(uint32 field, uint32 value)
 {
+    for (auto& pending : m_pendingWorldStates)
+    {
+        if (pending.first == field)
+        {
+            pending.second = value;
+            return;
+        }
+    }
+
+    m_pendingWorldStates.push_back({ field, value });
+}
+
+/**
+  Method that sends the world states updated since the previous update
+*/
+void BattleGround::SendPendingWorldStates()
+{
+    if (m_pendingWorldStates.empty())
+        return;
+
     WorldPacket data;
-    sBattleGroundMgr.BuildUpdateWorldStatePacket(data, field, value);
-    SendPacketToAll(data);
+    for (auto const& pending : m_pendingWorldStates)
+    {
+        auto sent = m_sentWorldStates.find(pending.first);
+        if (sent != m_sentWorldStates.end() && sent->second == pending.second)
+            continue;
+
+        m_sentWorldStates[pending.first] = pending.second;
+        sBattleGroundMgr.BuildUpdateWorldStatePacket(data, pending.first, pending.second);
+        SendPacketToAll(data);
+    }
+    m_pendingWorldStates.clear();
 }
 
 /**
@@ -739,13 +774,32 @@ void BattleGround::UpdateWorldState(uint32 field, uint32 value)
   @param    value
   @param    player
 */
-void BattleGround::UpdateWorldStateForPlayer(uint32 field, uint32 value, Player* player) const
+void BattleGround::UpdateWorldStateForPlayer(uint32 field, uint32 value, Player* player)
 {
+    // players no longer share the value
+    m_sentWorldStates.erase(field);
+
     WorldPacket data;
     sBattleGroundMgr.BuildUpdateWorldStatePacket(data, field, value);
     player->GetSession()->SendPacket(data);
 }
 
+/**
+  Method that returns the scoreboard shared by all its requests within PVP_LOG_DATA_CACHE_TIME
+
+  The scoreboard does not change anymore once the battleground has ended.
+*/
+WorldPacket const& BattleGround::GetPvpLogDataPacket()
+{
+    uint32 now = WorldTimer::getMSTime();
+    if (m_pvpLogData.empty() || (GetStatus() != STATUS_WAIT_LEAVE && WorldTimer::getMSTimeDiff(m_pvpLogDataTime, now) >= PVP_LOG_DATA_CACHE_TIME))
+    {
+        sBattleGroundMgr.BuildPvpLogDataPacket(m_pvpLogData, this);
+        m_pvpLogDataTime = now;
+    }
+    return m_pvpLogData;
+}
+
 /**
   Method that ends battleground
 
@@ -811,6 +865,7 @@ void BattleGround::EndBattleGround(Team winner)
     }
 
     SetStatus(STATUS_WAIT_LEAVE);
+    m_pvpLogData.clear();                                   // the final scoreboard is built at the next request
     // we must set it this way, because end time is sent in packet!
     m_endTime = TIME_TO_AUTOREMOVE;
 
@@ -956,9 +1011,11 @@ void BattleGround::EndBattleGround(Team winner)
         // update arena points only after increasing the player's match count!
         // obsolete: winner_arena_team->UpdateArenaPointsHelper();
         // obsolete: loser_arena_team->UpdateArenaPointsHelper();
-        // save the stat changes
-        winner_arena_team->SaveToDB();
-        loser_arena_team->SaveToDB();
+        // save the stat changes of both teams with one transaction
+        CharacterDatabase.BeginTransaction();
+        winner_arena_team->SaveChangedStatsToDB();
+        loser_arena_team->SaveChangedStatsToDB();
+        CharacterDatabase.CommitTransaction();
         // send updated arena team stats to players
         // this way all arena team members will get notified, not only the ones who participated in this match
         winner_arena_team->NotifyStatsChanged();
@@ -1350,6 +1407,10 @@ void BattleGround::Reset()
     for (BattleGroundScoreMap::const_iterator itr = m_playerScores.begin(); itr != m_playerScores.end(); ++itr)
         delete itr->second;
     m_playerScores.clear();
+
+    m_pendingWorldStates.clear();
+    m_sentWorldStates.clear();
+    m_pvpLogData.clear();
 }
 
 /**
@@ -1390,6 +1451,7 @@ void BattleGround::AddPlayer(Player* player)
 
     // Add to list/maps
     m_players[guid] = bp;
+    m_sentWorldStates.clear();                              // the player got the initial world states instead
 
     UpdatePlayersCountByTeam(team, false);                  // +1 player
 
@@ -1492,6 +1554,7 @@ void BattleGround::EventPlayerLoggedIn(Player* player)
     }
 
     m_players[playerGuid].offlineRemoveTime = 0;
+    m_sentWorldStates.clear();                              // the player got the initial world states instead
     PlayerAddedToBgCheckIfBgIsRunning(player);
     // if battleground is starting, then add preparation aura
     // we don't have to do that, because preparation aura isn't removed when player logs out
@@ -1968,6 +2031,7 @@ void BattleGround::EndNow()
 {
     RemoveFromBgFreeSlotQueue();
     SetStatus(STATUS_WAIT_LEAVE);
+    m_pvpLogData.clear();
     SetEndTime(0);
 }
 
@@ -2058,8 +2122,7 @@ void BattleGround::PlayerAddedToBgCheckIfBgIsRunning(Player* player)
 
     BlockMovement(player);
 
-    sBattleGroundMgr.BuildPvpLogDataPacket(data, this);
-    player->GetSession()->SendPacket(data);
+    player->GetSession()->SendPacket(GetPvpLogDataPacket());
 
     sBattleGroundMgr.BuildBattleGroundStatusPacket(data, this, player->GetBattleGroundQueueIndex(bgQueueTypeId), STATUS_IN_PROGRESS, GetEndTime(), GetStartTime(), GetArenaType(), player->GetBGTeam());
     player->GetSession()->SendPacket(data);
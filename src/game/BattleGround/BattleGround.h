@@ -23,6 +23,7 @@
 #include "Globals/SharedDefines.h"
 #include "Maps/Map.h"
 #include "ByteBuffer.h"
+#include "WorldPacket.h"
 #include "Entities/ObjectGuid.h"
 
 // magic event-numbers
@@ -111,6 +112,7 @@ enum BattleGroundTimeIntervals
     BUFF_RESPAWN_TIME               = 180,                  // secs
     ARENA_SPAWN_BUFF_OBJECTS        = 90000,                // ms - 90sec after start
     ARENA_FORCED_DRAW               = 2700000,              // ms - 45min after start
+    PVP_LOG_DATA_CACHE_TIME         = 1000,                 // ms - scoreboard shared by the requests in this time
 };
 
 enum BattleGroundStartTimeIntervals
@@ -455,11 +457,14 @@ class BattleGround
         // Function that rewards spell id
         void RewardSpellCast(Player* /*player*/, uint32 /*spellId*/) const;
 
-        // Function that updates world states for all players
+        // Function that updates world states for all players, sent with the next update
         void UpdateWorldState(uint32 /*field*/, uint32 /*value*/);
 
         // Function that updates world state for a player
-        void UpdateWorldStateForPlayer(uint32 /*field*/, uint32 /*value*/, Player* /*player*/) const;
+        void UpdateWorldStateForPlayer(uint32 /*field*/, uint32 /*value*/, Player* /*player*/);
+
+        // Function that returns the scoreboard, rebuilt at most every PVP_LOG_DATA_CACHE_TIME while the battleground runs
+        WorldPacket const& GetPvpLogDataPacket();
 
         // Function that ends battleground
         virtual void EndBattleGround(Team /*winner*/);
@@ -618,6 +623,7 @@ class BattleGround
         // this method is called, when BG cannot spawn its own spirit guide, or something is wrong, It correctly ends BattleGround
         void EndNow();
         void PlayerAddedToBgCheckIfBgIsRunning(Player* /*player*/);
+        void SendPendingWorldStates();
 
         /* Scorekeeping */
         BattleGroundScoreMap m_playerScores;                // Player scores
@@ -686,6 +692,14 @@ class BattleGround
 
         int32 m_arenaTeamRatingChanges[PVP_TEAM_COUNT];
 
+        /* World states */
+        std::vector<std::pair<uint32, uint32>> m_pendingWorldStates; // field, last value set since the previous update
+        std::map<uint32, uint32> m_sentWorldStates;         // field, value sent to all players, forgotten when a player (re)joins
+
+        /* Scoreboard */
+        WorldPacket m_pvpLogData;
+        uint32 m_pvpLogDataTime;
+
         /* Limits */
         uint32 m_levelMin;
         uint32 m_levelMax;
@@ -321,9 +321,7 @@ void WorldSession::HandlePVPLogDataOpcode(WorldPacket& /*recv_data*/)
     if (bg->IsArena())
         return;
 
-    WorldPacket data;
-    sBattleGroundMgr.BuildPvpLogDataPacket(data, bg);
-    SendPacket(data);
+    SendPacket(bg->GetPvpLogDataPacket());
 
     DEBUG_LOG("WORLD: Sent MSG_PVP_LOG_DATA Message");
 }
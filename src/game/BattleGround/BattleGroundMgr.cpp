@@ -40,6 +40,11 @@
 #include "Mails/Mail.h"
 
 #include "Policies/Singleton.h"
+#include "Entities/CharacterLoginCache.h"
+
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
 
 INSTANTIATE_SINGLETON_1(BattleGroundMgr);
 
@@ -233,6 +238,7 @@ GroupQueueInfo* BattleGroundQueue::AddGroup(Player* leader, Group* group, Battle
 
         // add GroupInfo to m_QueuedGroups
         m_queuedGroups[bracketId][index].push_back(queueInfo);
+        IndexRatedTeam(queueInfo, bracketId, index);
 
         // announce to world, this code needs mutex
         if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -443,6 +449,7 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     if (group->players.empty())
     {
         m_queuedGroups[bracketId][index].erase(group_itr);
+        UnindexRatedTeam(group, BattleGroundBracketId(bracketId), index);
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -877,6 +884,15 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
             m_queuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].empty())
         return;
 
+#ifdef BUILD_METRICS
+    metric::duration<std::chrono::microseconds> meas("battleground.queue.update", {
+        { "bg_type", std::to_string(bgTypeId) },
+        { "bracket_id", std::to_string(bracketId) },
+        { "arena_type", std::to_string(arenaType) },
+        { "rated", std::to_string(isRated) }
+    });
+#endif
+
     // battleground with free slot for player should be always in the beggining of the queue
     // maybe it would be better to create bgfreeslotqueue for each bracket_id
     BgFreeSlotQueueType::iterator next;
@@ -1052,63 +1068,32 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
 
         // we need to find 2 teams which will play next game
 
-        GroupsQueueType::iterator itr_team[PVP_TEAM_COUNT];
+        GroupQueueInfo* team[PVP_TEAM_COUNT] = { nullptr, nullptr };
 
         // optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
 
         for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; ++i)
         {
             // take the group that joined first
-            itr_team[i] = m_queuedGroups[bracketId][i].begin();
-            for (; itr_team[i] != m_queuedGroups[bracketId][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if (!(*itr_team[i])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[i])->arenaTeamRating >= arenaMinRating && (*itr_team[i])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[i])->joinTime < discardTime))
-                {
-                    m_selectionPools[i].AddGroup((*itr_team[i]), maxPlayersPerTeam, 0);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
+            team[i] = SelectRatedTeam(bracketId, i, arenaMinRating, arenaMaxRating, discardTime, nullptr);
+            if (team[i])
+                m_selectionPools[i].AddGroup(team[i], maxPlayersPerTeam, 0);
         }
         // now we are done if we have 2 groups - ali vs horde!
         // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
+        // this is supposed to continue search for mathing group in HORDE queue
         if (m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_ALLIANCE] = itr_team[TEAM_INDEX_HORDE];
-            ++itr_team[TEAM_INDEX_ALLIANCE];
-
-            for (; itr_team[TEAM_INDEX_ALLIANCE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[TEAM_INDEX_ALLIANCE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_ALLIANCE])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_ALLIANCE])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_ALLIANCE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup((*itr_team[TEAM_INDEX_ALLIANCE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+            team[TEAM_INDEX_ALLIANCE] = SelectRatedTeam(bracketId, BG_QUEUE_PREMADE_HORDE, arenaMinRating, arenaMaxRating, discardTime, team[TEAM_INDEX_HORDE]);
+            if (team[TEAM_INDEX_ALLIANCE])
+                m_selectionPools[TEAM_INDEX_ALLIANCE].AddGroup(team[TEAM_INDEX_ALLIANCE], maxPlayersPerTeam, 0);
         }
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
+        // this is supposed to continue search for mathing group in ALLIANCE queue
         if (m_selectionPools[TEAM_INDEX_HORDE].GetPlayerCount() == 0 && m_selectionPools[TEAM_INDEX_ALLIANCE].GetPlayerCount())
         {
-            itr_team[TEAM_INDEX_HORDE] = itr_team[TEAM_INDEX_ALLIANCE];
-            ++itr_team[TEAM_INDEX_HORDE];
-
-            for (; itr_team[TEAM_INDEX_HORDE] != m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[TEAM_INDEX_HORDE]))
-            {
-                if (!(*itr_team[TEAM_INDEX_HORDE])->isInvitedToBgInstanceGuid
-                        && (((*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating >= arenaMinRating && (*itr_team[TEAM_INDEX_HORDE])->arenaTeamRating <= arenaMaxRating)
-                            || (*itr_team[TEAM_INDEX_HORDE])->joinTime < discardTime))
-                {
-                    m_selectionPools[TEAM_INDEX_HORDE].AddGroup((*itr_team[TEAM_INDEX_HORDE]), maxPlayersPerTeam, 0);
-                    break;
-                }
-            }
+            team[TEAM_INDEX_HORDE] = SelectRatedTeam(bracketId, BG_QUEUE_PREMADE_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, team[TEAM_INDEX_ALLIANCE]);
+            if (team[TEAM_INDEX_HORDE])
+                m_selectionPools[TEAM_INDEX_HORDE].AddGroup(team[TEAM_INDEX_HORDE], maxPlayersPerTeam, 0);
         }
 
         // if we have 2 teams, then start new arena and invite players!
@@ -1121,30 +1106,20 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
                 return;
             }
 
-            (*(itr_team[TEAM_INDEX_ALLIANCE]))->opponentsTeamRating = (*(itr_team[TEAM_INDEX_HORDE]))->arenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_ALLIANCE]))->arenaTeamId, (*(itr_team[TEAM_INDEX_ALLIANCE]))->opponentsTeamRating);
-            (*(itr_team[TEAM_INDEX_HORDE]))->opponentsTeamRating = (*(itr_team[TEAM_INDEX_ALLIANCE]))->arenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[TEAM_INDEX_HORDE]))->arenaTeamId, (*(itr_team[TEAM_INDEX_HORDE]))->opponentsTeamRating);
+            team[TEAM_INDEX_ALLIANCE]->opponentsTeamRating = team[TEAM_INDEX_HORDE]->arenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", team[TEAM_INDEX_ALLIANCE]->arenaTeamId, team[TEAM_INDEX_ALLIANCE]->opponentsTeamRating);
+            team[TEAM_INDEX_HORDE]->opponentsTeamRating = team[TEAM_INDEX_ALLIANCE]->arenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", team[TEAM_INDEX_HORDE]->arenaTeamId, team[TEAM_INDEX_HORDE]->opponentsTeamRating);
 
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if ((*(itr_team[TEAM_INDEX_ALLIANCE]))->groupTeam != ALLIANCE)
-            {
-                // add to alliance queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].push_front(*(itr_team[TEAM_INDEX_ALLIANCE]));
-                // erase from horde queue
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].erase(itr_team[TEAM_INDEX_ALLIANCE]);
-                itr_team[TEAM_INDEX_ALLIANCE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].begin();
-            }
+            if (team[TEAM_INDEX_ALLIANCE]->groupTeam != ALLIANCE)
+                MoveRatedTeam(team[TEAM_INDEX_ALLIANCE], bracketId, BG_QUEUE_PREMADE_HORDE, BG_QUEUE_PREMADE_ALLIANCE);
 
-            if ((*(itr_team[TEAM_INDEX_HORDE]))->groupTeam != HORDE)
-            {
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].push_front(*(itr_team[TEAM_INDEX_HORDE]));
-                m_queuedGroups[bracketId][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[TEAM_INDEX_HORDE]);
-                itr_team[TEAM_INDEX_HORDE] = m_queuedGroups[bracketId][BG_QUEUE_PREMADE_HORDE].begin();
-            }
+            if (team[TEAM_INDEX_HORDE]->groupTeam != HORDE)
+                MoveRatedTeam(team[TEAM_INDEX_HORDE], bracketId, BG_QUEUE_PREMADE_ALLIANCE, BG_QUEUE_PREMADE_HORDE);
 
-            InviteGroupToBg(*(itr_team[TEAM_INDEX_ALLIANCE]), arena, ALLIANCE);
-            InviteGroupToBg(*(itr_team[TEAM_INDEX_HORDE]), arena, HORDE);
+            InviteGroupToBg(team[TEAM_INDEX_ALLIANCE], arena, ALLIANCE);
+            InviteGroupToBg(team[TEAM_INDEX_HORDE], arena, HORDE);
 
             DEBUG_LOG("Starting rated arena match!");
 
@@ -1153,6 +1128,79 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
     }
 }
 
+void BattleGroundQueue::IndexRatedTeam(GroupQueueInfo* groupInfo, BattleGroundBracketId bracketId, uint32 queueType)
+{
+    if (groupInfo->isRated && queueType < PVP_TEAM_COUNT)
+        m_ratedTeams[bracketId][queueType].insert(RatedTeamIndex::value_type(groupInfo->arenaTeamRating, groupInfo));
+}
+
+void BattleGroundQueue::UnindexRatedTeam(GroupQueueInfo* groupInfo, BattleGroundBracketId bracketId, uint32 queueType)
+{
+    if (!groupInfo->isRated || queueType >= PVP_TEAM_COUNT)
+        return;
+
+    auto bounds = m_ratedTeams[bracketId][queueType].equal_range(groupInfo->arenaTeamRating);
+    for (auto itr = bounds.first; itr != bounds.second; ++itr)
+    {
+        if (itr->second == groupInfo)
+        {
+            m_ratedTeams[bracketId][queueType].erase(itr);
+            return;
+        }
+    }
+}
+
+/**
+  Method that moves a rated team, which was selected to play for the other faction, to the front of that faction's queue
+*/
+void BattleGroundQueue::MoveRatedTeam(GroupQueueInfo* groupInfo, BattleGroundBracketId bracketId, uint32 fromQueueType, uint32 toQueueType)
+{
+    m_queuedGroups[bracketId][fromQueueType].remove(groupInfo);
+    m_queuedGroups[bracketId][toQueueType].push_front(groupInfo);
+
+    UnindexRatedTeam(groupInfo, bracketId, fromQueueType);
+    IndexRatedTeam(groupInfo, bracketId, toQueueType);
+}
+
+/**
+  Method that finds the rated team of a premade queue that joined first, among the not invited teams that are in the rating range or waited longer than the discard time
+
+  @param    bracket id
+  @param    premade queue type
+  @param    minimum rating
+  @param    maximum rating
+  @param    teams that joined before this time are selected regardless of their rating
+  @param    team that must not be selected again
+*/
+GroupQueueInfo* BattleGroundQueue::SelectRatedTeam(BattleGroundBracketId bracketId, uint32 queueType, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude) const
+{
+    GroupQueueInfo* selected = nullptr;
+
+    // not invited teams stay in join order, so only the first of them can be the one whose rating is discarded
+    for (GroupQueueInfo* groupInfo : m_queuedGroups[bracketId][queueType])
+    {
+        if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude)
+            continue;
+
+        if (groupInfo->joinTime < discardTime)
+            selected = groupInfo;
+        break;
+    }
+
+    RatedTeamIndex const& index = m_ratedTeams[bracketId][queueType];
+    for (RatedTeamIndex::const_iterator itr = index.lower_bound(minRating); itr != index.end() && itr->first <= maxRating; ++itr)
+    {
+        GroupQueueInfo* groupInfo = itr->second;
+        if (groupInfo->isInvitedToBgInstanceGuid || groupInfo == exclude)
+            continue;
+
+        if (!selected || groupInfo->joinTime < selected->joinTime)
+            selected = groupInfo;
+    }
+
+    return selected;
+}
+
 /*********************************************************/
 /***            BATTLEGROUND QUEUE EVENTS              ***/
 /*********************************************************/
@@ -2013,6 +2061,9 @@ void BattleGroundMgr::DistributeArenaPoints() const
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_ONLINE_START);
 
+    // offline characters get their points too
+    sCharacterLoginCache.Clear();
+
     // temporary structure for storing maximum points to add values for all players
     std::map<uint32, uint32> PlayerPoints;
 
@@ -2026,28 +2077,33 @@ void BattleGroundMgr::DistributeArenaPoints() const
     }
 
     // cycle that gives points to all players
+    static SqlStatementID updArenaPoints;
+    CharacterDatabase.BeginTransaction();
     for (auto& PlayerPoint : PlayerPoints)
     {
+        // members below the participation limit are in the map with 0 points
+        if (!PlayerPoint.second)
+            continue;
+
         // update to database
-        CharacterDatabase.PExecute("UPDATE characters SET arenaPoints = arenaPoints + '%u' WHERE guid = '%u'", PlayerPoint.second, PlayerPoint.first);
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updArenaPoints, "UPDATE characters SET arenaPoints = arenaPoints + ? WHERE guid = ?");
+        stmt.PExecute(PlayerPoint.second, PlayerPoint.first);
         // add points if player is online
         if (Player* pl = sObjectMgr.GetPlayer(ObjectGuid(HIGHGUID_PLAYER, PlayerPoint.first)))
             pl->ModifyArenaPoints(PlayerPoint.second);
     }
+    CharacterDatabase.CommitTransaction();
 
     PlayerPoints.clear();
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_ONLINE_END);
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_TEAM_START);
+    ArenaTeam::FinishWeekForAll();                          // set played this week etc values to 0 in memory and db
     for (ObjectMgr::ArenaTeamMap::iterator titr = sObjectMgr.GetArenaTeamMapBegin(); titr != sObjectMgr.GetArenaTeamMapEnd(); ++titr)
     {
         if (ArenaTeam* at = titr->second)
-        {
-            at->FinishWeek();                              // set played this week etc values to 0 in memory, too
-            at->SaveToDB();                                // save changes
             at->NotifyStatsChanged();                      // notify the players of the changes
-        }
     }
 
     sWorld.SendWorldTextToAboveSecurity(SEC_GAMEMASTER, LANG_DIST_ARENA_POINTS_TEAM_END);
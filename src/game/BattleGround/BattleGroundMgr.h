@@ -116,6 +116,15 @@ class BattleGroundQueue
         */
         GroupsQueueType m_queuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // rated arena teams of the BG_QUEUE_PREMADE_* queues by rating, lets matchmaking look up only the teams in rating range
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedTeamIndex;
+        RatedTeamIndex m_ratedTeams[MAX_BATTLEGROUND_BRACKETS][PVP_TEAM_COUNT];
+
+        void IndexRatedTeam(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/, uint32 /*queueType*/);
+        void UnindexRatedTeam(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/, uint32 /*queueType*/);
+        void MoveRatedTeam(GroupQueueInfo* /*groupInfo*/, BattleGroundBracketId /*bracketId*/, uint32 /*fromQueueType*/, uint32 /*toQueueType*/);
+        GroupQueueInfo* SelectRatedTeam(BattleGroundBracketId /*bracketId*/, uint32 /*queueType*/, uint32 /*minRating*/, uint32 /*maxRating*/, uint32 /*discardTime*/, GroupQueueInfo const* /*exclude*/) const;
+
         // class to select and invite groups to bg
         class SelectionPool
         {
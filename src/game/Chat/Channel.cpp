@@ -120,6 +120,7 @@ void Channel::Join(Player* player, const char* password)
 
     PlayerInfo& pinfo = m_players[guid];
     pinfo.player = guid;
+    pinfo.plr = player;
     pinfo.flags = MEMBER_FLAG_NONE;
 
     MakeYouJoined(data, m_name, *this);
@@ -746,16 +747,60 @@ void Channel::SendToOne(WorldPacket const& data, ObjectGuid receiver) const
 
 void Channel::SendToAll(WorldPacket const& data) const
 {
+    SharedWorldPacket sharedData(data);
+
+    uint32 count = 0;
+
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        SendToOne(data, i->first);
+    {
+        if (Player* plr = i->second.plr)
+        {
+            plr->GetSession()->SendPacket(sharedData);
+            ++count;
+        }
+    }
+
+    MeterSends(count);
 }
 
 void Channel::SendMessage(WorldPacket const& data, ObjectGuid sender) const
 {
+    SharedWorldPacket sharedData(data);
+    uint32 count = 0;
+
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
-        if (Player* plr = sObjectMgr.GetPlayer(i->first))
-            if (!sender || !plr->GetSocial()->HasIgnore(sender))
-                plr->GetSession()->SendPacket(data);
+    {
+        Player* plr = i->second.plr;
+        if (plr && (!sender || !plr->GetSocial()->HasIgnore(sender)))
+        {
+            plr->GetSession()->SendPacket(sharedData);
+            ++count;
+        }
+    }
+
+    MeterSends(count);
+}
+
+void Channel::MeterSends(uint32 count) const
+{
+    time_t now = sWorld.GetGameTime();
+    if (now != m_meterSecond)
+    {
+        m_sentLastSecond = (now == m_meterSecond + 1) ? m_sentThisSecond : 0;
+        m_sentThisSecond = 0;
+        m_meterSecond = now;
+    }
+
+    m_sentThisSecond += count;
+}
+
+uint32 Channel::GetSendRate() const
+{
+    time_t now = sWorld.GetGameTime();
+    if (now == m_meterSecond)
+        return m_sentLastSecond;
+
+    return (now == m_meterSecond + 1) ? m_sentThisSecond : 0;
 }
 
 void Channel::Voice(ObjectGuid /*guid1*/, ObjectGuid /*guid2*/) const
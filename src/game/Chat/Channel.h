@@ -121,6 +121,7 @@ class Channel
         struct PlayerInfo
         {
             ObjectGuid player;
+            Player* plr;                                    // members leave all channels before logout, so the pointer stays valid
             uint8 flags;
 
             inline bool HasFlag(uint8 flag) const { return (flags & flag) != 0; }
@@ -146,6 +147,7 @@ class Channel
         inline bool IsPublic() const { return (IsConstant() || IsStatic()); }
         std::string GetPassword() const { return m_password; }
         size_t GetNumPlayers() const { return m_players.size(); }
+        uint32 GetSendRate() const;                         // packets sent to members during the last full second
         uint8 GetFlags() const { return m_flags; }
         bool HasFlag(uint8 flag) const { return (m_flags & flag) != 0; }
 
@@ -236,6 +238,8 @@ class Channel
         void SetModeFlags(ObjectGuid guid, ChannelMemberFlags flags, bool set);
         void SetOwner(ObjectGuid guid, bool exclaim = true);
 
+        void MeterSends(uint32 count) const;
+
     private:
         std::string                 m_name;
         std::string                 m_password;
@@ -249,5 +253,8 @@ class Channel
         // Custom features:
         bool                        m_static = false;
         bool                        m_realmzone = false;
+        mutable time_t              m_meterSecond = 0;
+        mutable uint32              m_sentThisSecond = 0;
+        mutable uint32              m_sentLastSecond = 0;
 };
 #endif
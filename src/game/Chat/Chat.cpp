@@ -34,7 +34,9 @@
 #include "Pools/PoolManager.h"
 #include "GameEvents/GameEventMgr.h"
 
+#include <atomic>
 #include <cstdarg>
+#include <unordered_map>
 
 // Supported shift-links (client generated and server side)
 // |color|Harea:area_id|h[name]|h|r
@@ -58,7 +60,81 @@
 // |color|Htele:id|h[name]|h|r
 // |color|Htitle:id|h[name]|h|r
 
-bool ChatHandler::load_command_table = true;
+std::atomic<bool> ChatHandler::load_command_table(true);
+
+// Entries of every command table a typed name can match, by its first letter and in table order, so the search
+// compares a few names instead of the whole table. Built once from the hardcoded names, which never change,
+// reloading the command table only changes security and help.
+class ChatCommandIndex
+{
+    public:
+        explicit ChatCommandIndex(ChatCommand* rootTable) { Add(rootTable); }
+
+        // first is the first letter of the typed name, '\0' for an empty name
+        static std::vector<uint32> const& GetCandidates(ChatCommand const* table, char first);
+
+    private:
+        struct TableIndex
+        {
+            std::unordered_map<char, std::vector<uint32>> byLetter;
+            std::vector<uint32> unnamed;                    // "" commands, they match any name
+        };
+
+        void Add(ChatCommand* table);
+
+        std::unordered_map<ChatCommand const*, TableIndex> m_tables;
+};
+
+static std::atomic<ChatCommandIndex const*> s_commandIndex(nullptr);
+
+void ChatCommandIndex::Add(ChatCommand* table)
+{
+    if (m_tables.find(table) != m_tables.end())
+        return;                                             // subtable of several commands
+
+    TableIndex& index = m_tables[table];
+    for (uint32 i = 0; table[i].Name != nullptr; ++i)
+    {
+        if (table[i].Name[0] == '\0')
+        {
+            index.unnamed.push_back(i);
+            for (auto& letter : index.byLetter)
+                letter.second.push_back(i);
+        }
+        else
+        {
+            char const letter = char(tolower(uint8(table[i].Name[0])));
+            auto itr = index.byLetter.find(letter);
+            if (itr == index.byLetter.end())
+                itr = index.byLetter.emplace(letter, index.unnamed).first;
+            itr->second.push_back(i);
+        }
+
+        if (table[i].ChildCommands)
+            Add(table[i].ChildCommands);
+    }
+}
+
+std::vector<uint32> const& ChatCommandIndex::GetCandidates(ChatCommand const* table, char first)
+{
+    static std::vector<uint32> const none;
+
+    // every table searched is reachable from the root table, indexed before the first search
+    ChatCommandIndex const* commandIndex = s_commandIndex.load(std::memory_order_acquire);
+    if (!commandIndex)
+        return none;
+
+    auto tableItr = commandIndex->m_tables.find(table);
+    if (tableItr == commandIndex->m_tables.end())
+        return none;
+
+    TableIndex const& index = tableItr->second;
+    if (first == '\0')
+        return index.unnamed;
+
+    auto itr = index.byLetter.find(char(tolower(uint8(first))));
+    return itr != index.byLetter.end() ? itr->second : index.unnamed;
+}
 
 ChatCommand* ChatHandler::getCommandTable()
 {
@@ -221,6 +297,7 @@ ChatCommand* ChatHandler::getCommandTable()
     {
         { "tempspawn",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleShowTemporarySpawnList,          "", nullptr },
         { "gridsloaded",    SEC_ADMINISTRATOR,  false, &ChatHandler::HandleGridsLoadedCount,                "", nullptr },
+        { "spellcast",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugPerfSpellCastCommand,       "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -272,7 +349,10 @@ ChatCommand* ChatHandler::getCommandTable()
         { "spawn",          SEC_GAMEMASTER,     true,  nullptr,                                             "", debugSpawnsCommandtable },
         { "debugflags",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugObjectFlags,                "", nullptr },
         { "packetlog",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugPacketLog,                  "", nullptr },
+        { "opcodestats",    SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugOpcodeStats,                "", nullptr },
+        { "scriptprofile",  SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugScriptProfile,              "", nullptr },
         { "dbscript",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugDbscript,                   "", nullptr },
+        { "trace",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleDebugTrace,                      "", nullptr },
         { nullptr,          0,                  false, nullptr,                                             "", nullptr }
     };
 
@@ -706,6 +786,7 @@ ChatCommand* ChatHandler::getCommandTable()
         { "items",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSendMassItemsCommand,       "", nullptr },
         { "mail",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSendMassMailCommand,        "", nullptr },
         { "money",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSendMassMoneyCommand,       "", nullptr },
+        { "status",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleSendMassStatusCommand,      "", nullptr },
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
 
@@ -792,14 +873,17 @@ ChatCommand* ChatHandler::getCommandTable()
         { "exit",           SEC_CONSOLE,        true,  &ChatHandler::HandleServerExitCommand,          "", nullptr },
         { "idlerestart",    SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverIdleRestartCommandTable },
         { "idleshutdown",   SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverIdleShutdownCommandTable },
+        { "allocstats",     SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerAllocStatsCommand,    "", nullptr },
         { "info",           SEC_PLAYER,         true,  &ChatHandler::HandleServerInfoCommand,          "", nullptr },
         { "log",            SEC_CONSOLE,        true,  nullptr,                                        "", serverLogCommandTable },
+        { "mapcost",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerMapCostCommand,       "", nullptr },
         { "motd",           SEC_PLAYER,         true,  &ChatHandler::HandleServerMotdCommand,          "", nullptr },
         { "plimit",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerPLimitCommand,        "", nullptr },
         { "resetallraid",   SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerResetAllRaidCommand,  "", nullptr },
         { "restart",        SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverRestartCommandTable },
         { "shutdown",       SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverShutdownCommandTable },
         { "set",            SEC_ADMINISTRATOR,  true,  nullptr,                                        "", serverSetCommandTable },
+        { "zonestats",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleServerZoneStatsCommand,     "", nullptr },
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
 
@@ -1032,6 +1116,9 @@ ChatCommand* ChatHandler::getCommandTable()
         { nullptr,          0,                  false, nullptr,                                        "", nullptr }
     };
 
+    static ChatCommandIndex const commandIndex(commandTable);
+    s_commandIndex.store(&commandIndex, std::memory_order_release);
+
     if (load_command_table)
     {
         load_command_table = false;
@@ -1284,6 +1371,41 @@ ChatCommand const* ChatHandler::FindCommand(char const* text)
     return FindCommand(getCommandTable(), textPtr, command) == CHAT_COMMAND_OK ? command : nullptr;
 }
 
+/**
+ * Check if the command of a command line only reads data safe to read from any thread,
+ * like counters and stores behind their own lock, and can run off the world thread.
+ *
+ * @param text  Command line string, with or without leading . or !
+ *
+ * @return true for such a command available for chat handler access level
+ */
+bool ChatHandler::IsConcurrentCommand(char const* text)
+{
+    // the table is loaded and reloaded by the world thread
+    if (load_command_table)
+        return false;
+
+    if (text[0] == '!' || text[0] == '.')
+        ++text;
+
+    ChatCommand const* command = FindCommand(text);
+    if (!command)
+        return false;
+
+    static bool (ChatHandler::* const concurrentHandlers[])(char*) =
+    {
+        &ChatHandler::HandleServerInfoCommand,
+        &ChatHandler::HandleServerZoneStatsCommand,
+        &ChatHandler::HandleServerAllocStatsCommand,
+    };
+
+    for (auto handler : concurrentHandlers)
+        if (command->Handler == handler)
+            return true;
+
+    return false;
+}
+
 /**
  * Search (sub)command for command line available for chat handler access level with options and fail case additional info
  *
@@ -1328,7 +1450,7 @@ ChatCommandSearchResult ChatHandler::FindCommand(ChatCommand* table, char const*
     while (*text == ' ') ++text;
 
     // search first level command in table
-    for (uint32 i = 0; table[i].Name != nullptr; ++i)
+    for (uint32 i : ChatCommandIndex::GetCandidates(table, cmd.empty() ? '\0' : cmd[0]))
     {
         if (exactlyName)
         {
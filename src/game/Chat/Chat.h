@@ -24,6 +24,7 @@
 #include "Globals/SharedDefines.h"
 #include "Entities/ObjectGuid.h"
 
+#include <atomic>
 #include <functional>
 #include <utility>
 
@@ -95,6 +96,8 @@ class ChatHandler
 
         bool ParseCommands(const char* text);
         ChatCommand const* FindCommand(char const* text);
+        // read only commands allowed to run off the world thread, see World::QueueCliCommand
+        bool IsConcurrentCommand(char const* text);
 
         static bool HasEscapeSequences(const char* message);
         static bool CheckEscapeSequences(const char* message);
@@ -283,6 +286,7 @@ class ChatHandler
 
         bool HandleShowTemporarySpawnList(char* args);
         bool HandleGridsLoadedCount(char* args);
+        bool HandleDebugPerfSpellCastCommand(char* args);
 
         bool HandleDebugPlayCinematicCommand(char* args);
         bool HandleDebugPlaySoundCommand(char* args);
@@ -316,7 +320,10 @@ class ChatHandler
         bool HandleDebugRespawnDynguid(char* args);
 
         bool HandleDebugPacketLog(char* args);
+        bool HandleDebugOpcodeStats(char* args);
+        bool HandleDebugScriptProfile(char* args);
         bool HandleDebugDbscript(char* args);
+        bool HandleDebugTrace(char* args);
 
         bool HandleSD2HelpCommand(char* args);
         bool HandleSD2ScriptCommand(char* args);
@@ -627,6 +634,7 @@ class ChatHandler
         bool HandleSendMassItemsCommand(char* args);
         bool HandleSendMassMailCommand(char* args);
         bool HandleSendMassMoneyCommand(char* args);
+        bool HandleSendMassStatusCommand(char* args);
 
         bool HandleServerCorpsesCommand(char* args);
         bool HandleServerExitCommand(char* args);
@@ -635,6 +643,9 @@ class ChatHandler
         bool HandleServerInfoCommand(char* args);
         bool HandleServerLogFilterCommand(char* args);
         bool HandleServerLogLevelCommand(char* args);
+        bool HandleServerMapCostCommand(char* args);
+        bool HandleServerZoneStatsCommand(char* args);
+        bool HandleServerAllocStatsCommand(char* args);
         bool HandleServerMotdCommand(char* args);
         bool HandleServerPLimitCommand(char* args);
         bool HandleServerResetAllRaidCommand(char* args);
@@ -871,7 +882,7 @@ class ChatHandler
         WorldSession* m_session;                            // != nullptr for chat command call and nullptr for CLI command
 
         // common global flag
-        static bool load_command_table;
+        static std::atomic<bool> load_command_table;
         bool sentErrorMessage;
 };
 
@@ -2291,7 +2291,7 @@ bool ChatHandler::HandleChannelListCommand(char* args)
         {
             std::ostringstream output;
 
-            output << "* " << '"' << (*itr)->GetName() << '"' << " - "  << (*itr)->GetNumPlayers();
+            output << "* " << '"' << (*itr)->GetName() << '"' << " - "  << (*itr)->GetNumPlayers() << " - " << (*itr)->GetSendRate() << "/s";
 
             if ((*itr)->IsStatic())
                 output << " " << GetMangosString(LANG_CHANNEL_CUSTOM_DETAILS_STATIC);
@@ -54,6 +54,7 @@
 #include "Movement/MoveSplineInit.h"
 #include "Anticheat/Anticheat.hpp"
 #include "Entities/Transports.h"
+#include "Entities/CharacterLoginCache.h"
 
 #include <fstream>
 #include <map>
@@ -2364,6 +2365,7 @@ bool ChatHandler::HandleNpcShowLootCommand(char* /*args*/)
         return true;
     }
 
+    creature->m_loot->GenerateDeferred(m_session->GetPlayer());
     creature->m_loot->PrintLootList(*this, m_session);
     return true;
 }
@@ -3665,6 +3667,7 @@ bool ChatHandler::HandleCharacterRenameCommand(char* args)
 
         PSendSysMessage(LANG_RENAME_PLAYER_GUID, oldNameLink.c_str(), target_guid.GetCounter());
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '1' WHERE guid = '%u'", target_guid.GetCounter());
+        sCharacterLoginCache.Invalidate(target_guid);
     }
 
     return true;
@@ -4510,7 +4513,7 @@ bool ChatHandler::HandlePoolInfoCommand(char* args)
             {
                 if (CreatureInfo const* info = ObjectMgr::GetCreatureTemplate(data->id))
                 {
-                    char const* active = crSpawns && crSpawns->find(itr.guid) != crSpawns->end() ? active_str.c_str() : "";
+                    char const* active = crSpawns && crSpawns->Contains(itr.guid) ? active_str.c_str() : "";
                     if (m_session)
                         PSendSysMessage(LANG_POOL_CHANCE_CREATURE_LIST_CHAT, itr.guid, PrepareStringNpcOrGoSpawnInformation<Creature>(itr.guid).c_str(),
                             itr.guid, info->Name, data->posX, data->posY, data->posZ, data->mapid, itr.chance, active);
@@ -4532,7 +4535,7 @@ bool ChatHandler::HandlePoolInfoCommand(char* args)
             {
                 if (CreatureInfo const* info = ObjectMgr::GetCreatureTemplate(data->id))
                 {
-                    char const* active = crSpawns && crSpawns->find(itr.guid) != crSpawns->end() ? active_str.c_str() : "";
+                    char const* active = crSpawns && crSpawns->Contains(itr.guid) ? active_str.c_str() : "";
                     if (m_session)
                         PSendSysMessage(LANG_POOL_CREATURE_LIST_CHAT, itr.guid, PrepareStringNpcOrGoSpawnInformation<Creature>(itr.guid).c_str(),
                             itr.guid, info->Name, data->posX, data->posY, data->posZ, data->mapid, active);
@@ -4557,7 +4560,7 @@ bool ChatHandler::HandlePoolInfoCommand(char* args)
             {
                 if (GameObjectInfo const* info = ObjectMgr::GetGameObjectInfo(data->id))
                 {
-                    char const* active = goSpawns && goSpawns->find(itr.guid) != goSpawns->end() ? active_str.c_str() : "";
+                    char const* active = goSpawns && goSpawns->Contains(itr.guid) ? active_str.c_str() : "";
                     if (m_session)
                         PSendSysMessage(LANG_POOL_CHANCE_GO_LIST_CHAT, itr.guid, PrepareStringNpcOrGoSpawnInformation<GameObject>(itr.guid).c_str(),
                             itr.guid, info->name, data->posX, data->posY, data->posZ, data->mapid, itr.chance, active);
@@ -4579,7 +4582,7 @@ bool ChatHandler::HandlePoolInfoCommand(char* args)
             {
                 if (GameObjectInfo const* info = ObjectMgr::GetGameObjectInfo(data->id))
                 {
-                    char const* active = goSpawns && goSpawns->find(itr.guid) != goSpawns->end() ? active_str.c_str() : "";
+                    char const* active = goSpawns && goSpawns->Contains(itr.guid) ? active_str.c_str() : "";
                     if (m_session)
                         PSendSysMessage(LANG_POOL_GO_LIST_CHAT, itr.guid, PrepareStringNpcOrGoSpawnInformation<GameObject>(itr.guid).c_str(),
                             itr.guid, info->name, data->posX, data->posY, data->posZ, data->mapid, active);
@@ -56,11 +56,15 @@
 #include "Server/SQLStorages.h"
 #include "Loot/LootMgr.h"
 #include "World/WorldState.h"
+#include "Maps/ZoneStats.h"
+#include "AllocStats.h"
 #include "Arena/ArenaTeam.h"
 #ifdef BUILD_METRICS
 #include "Metric/Metric.h"
 #endif
 #include "Server/PacketLog.h"
+#include "Entities/CharacterLoginCache.h"
+#include "Server/QueryResponseCache.h"
 
 #ifdef BUILD_AHBOT
 #include "AuctionHouseBot/AuctionHouseBot.h"
@@ -461,6 +465,7 @@ bool ChatHandler::HandleReloadQuestTemplateCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Quest Templates...");
     sObjectMgr.LoadQuests();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_QUEST);
     SendGlobalSysMessage("DB table `quest_template` (quest definitions) reloaded.");
 
     /// dependent also from `gameobject` but this table not reloaded anyway
@@ -581,6 +586,7 @@ bool ChatHandler::HandleReloadNpcTextCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading `npc_text` Table!");
     sObjectMgr.LoadGossipText();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     SendGlobalSysMessage("DB table `npc_text` reloaded.");
     return true;
 }
@@ -774,6 +780,7 @@ bool ChatHandler::HandleReloadPageTextsCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Page Texts...");
     sObjectMgr.LoadPageTexts();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     SendGlobalSysMessage("DB table `page_texts` reloaded.");
     return true;
 }
@@ -1015,6 +1022,7 @@ bool ChatHandler::HandleReloadLocalesCreatureCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Creature ...");
     sObjectMgr.LoadCreatureLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_CREATURE);
     SendGlobalSysMessage("DB table `locales_creature` reloaded.");
     return true;
 }
@@ -1023,6 +1031,7 @@ bool ChatHandler::HandleReloadLocalesGameobjectCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Gameobject ... ");
     sObjectMgr.LoadGameObjectLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_GAMEOBJECT);
     SendGlobalSysMessage("DB table `locales_gameobject` reloaded.");
     return true;
 }
@@ -1039,6 +1048,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_ITEM);
     SendGlobalSysMessage("DB table `locales_item` reloaded.");
     return true;
 }
@@ -1047,6 +1057,7 @@ bool ChatHandler::HandleReloadLocalesNpcTextCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales NPC Text ... ");
     sObjectMgr.LoadGossipTextLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     SendGlobalSysMessage("DB table `locales_npc_text` reloaded.");
     return true;
 }
@@ -1055,6 +1066,7 @@ bool ChatHandler::HandleReloadLocalesPageTextCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Page Text ... ");
     sObjectMgr.LoadPageTextLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     SendGlobalSysMessage("DB table `locales_page_text` reloaded.");
     return true;
 }
@@ -1071,6 +1083,7 @@ bool ChatHandler::HandleReloadLocalesQuestCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Quest ... ");
     sObjectMgr.LoadQuestLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_QUEST);
     SendGlobalSysMessage("DB table `locales_quest` reloaded.");
     return true;
 }
@@ -3992,6 +4005,8 @@ void ChatHandler::HandleCharacterLevel(Player* player, ObjectGuid player_guid, u
     {
         // update level and XP at level, all other will be updated at loading
         CharacterDatabase.PExecute("UPDATE characters SET level = '%u', xp = 0 WHERE guid = '%u'", newlevel, player_guid.GetCounter());
+        sCharacterLoginCache.Invalidate(player_guid);
+        sObjectMgr.UpdatePlayerDataCacheLevel(player_guid.GetCounter(), newlevel);
     }
 }
 
@@ -4625,6 +4640,7 @@ static bool HandleResetStatsOrLevelHelper(Player* player)
 
     player->SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, DEFAULT_WORLD_OBJECT_SIZE);
     player->SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
+    player->UpdateCellPositionIndex();
 
     player->setFactionForRace(player->getRace());
 
@@ -4705,6 +4721,7 @@ bool ChatHandler::HandleResetSpellsCommand(char* args)
     else
     {
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", uint32(AT_LOGIN_RESET_SPELLS), target_guid.GetCounter());
+        sCharacterLoginCache.Invalidate(target_guid);
         PSendSysMessage(LANG_RESET_SPELLS_OFFLINE, target_name.c_str());
     }
 
@@ -4732,6 +4749,7 @@ bool ChatHandler::HandleResetTalentsCommand(char* args)
     {
         uint32 at_flags = AT_LOGIN_RESET_TALENTS;
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", at_flags, target_guid.GetCounter());
+        sCharacterLoginCache.Invalidate(target_guid);
         std::string nameLink = playerLink(target_name);
         PSendSysMessage(LANG_RESET_TALENTS_OFFLINE, nameLink.c_str());
         return true;
@@ -4763,6 +4781,7 @@ bool ChatHandler::HandleResetTaxiNodesCommand(char* args)
     {
         uint32 at_flags = AT_LOGIN_RESET_TAXINODES;
         CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE guid = '%u'", at_flags, target_guid.GetCounter());
+        sCharacterLoginCache.Invalidate(target_guid);
         std::string nameLink = playerLink(target_name);
         PSendSysMessage("Taxi nodes of %s will be reset at next login.", nameLink.c_str());
         return true;
@@ -4805,6 +4824,7 @@ bool ChatHandler::HandleResetAllCommand(char* args)
     }
 
     CharacterDatabase.PExecute("UPDATE characters SET at_login = at_login | '%u' WHERE (at_login & '%u') = '0'", atLogin, atLogin);
+    sCharacterLoginCache.Clear();
     HashMapHolder<Player>::MapType const& plist = sObjectAccessor.GetPlayers();
     for (const auto& itr : plist)
         itr.second->SetAtLoginFlag(atLogin);
@@ -6334,6 +6354,7 @@ bool ChatHandler::HandleInstanceSaveDataCommand(char* /*args*/)
     }
 
     iData->SaveToDB();
+    iData->FlushSaveToDB();
     return true;
 }
 
@@ -6739,6 +6760,22 @@ bool ChatHandler::HandleSendMassMoneyCommand(char* args)
     return true;
 }
 
+/// Show the progress of queued mass mails
+bool ChatHandler::HandleSendMassStatusCommand(char* /*args*/)
+{
+    uint32 tasks, mails, needTime;
+    sMassMailMgr.GetStatistic(tasks, mails, needTime);
+
+    PSendSysMessage("Mass mail tasks: %u, mails left: %u, estimated time: %u sec", tasks, mails, needTime);
+
+    std::vector<MassMailMgr::StreamProgress> progress;
+    sMassMailMgr.GetStreamProgress(progress);
+    for (uint32 i = 0; i < progress.size(); ++i)
+        PSendSysMessage("Streamed task %u: %u of %u mails sent", i + 1, progress[i].sent, progress[i].total);
+
+    return true;
+}
+
 /// Send a message to a player in game
 bool ChatHandler::HandleSendMessageCommand(char* args)
 {
@@ -7009,6 +7046,79 @@ bool ChatHandler::HandleMmapTestHeight(char* args)
     return true;
 }
 
+bool ChatHandler::HandleServerMapCostCommand(char* args)
+{
+    uint32 count = 10;
+    if (*args && !ExtractUInt32(&args, count))
+        return false;
+
+    std::vector<Map*> maps = sMapMgr.GetMapsByUpdateCost();
+    float total = 0.0f;
+    for (Map const* map : maps)
+        total += map->GetUpdateCost();
+
+    PSendSysMessage("Loaded maps: %u, summary average update cost: %.2f ms", uint32(maps.size()), total / 1000.0f);
+    for (uint32 i = 0; i < maps.size() && i < count; ++i)
+    {
+        Map const* map = maps[i];
+        PSendSysMessage("%u. Map %u (%s) instance %u, players %u: average %.2f ms, last %.2f ms", i + 1, map->GetId(), map->GetMapName(),
+                        map->GetInstanceId(), uint32(map->GetPlayers().getSize()), map->GetUpdateCost() / 1000.0f, map->GetLastUpdateCost() / 1000.0f);
+    }
+    return true;
+}
+
+bool ChatHandler::HandleServerZoneStatsCommand(char* args)
+{
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10))
+        return false;
+
+    uint32 rate = sWorld.getConfig(CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE);
+    if (!rate)
+        SendSysMessage("ZoneStats.SampleRate is 0, zone stats are not collected.");
+
+    ZoneStats::Snapshot snapshot;
+    sZoneStats.GetLastInterval(snapshot);
+
+    // estimates scaled by the sample rate, spells and AI are part of players and objects
+    PSendSysMessage("Last minute, top %u of %u zones by estimated update time (1 of %u events sampled):", std::min(count, uint32(snapshot.size())), uint32(snapshot.size()), std::max(rate, 1u));
+    for (uint32 i = 0; i < snapshot.size() && i < count; ++i)
+    {
+        ZoneStatsKey const& key = snapshot[i].first;
+        ZoneStatsCounters const& counters = snapshot[i].second;
+
+        AreaTableEntry const* zoneEntry = GetAreaEntryByAreaID(key.zoneId);
+        AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(key.areaId);
+        PSendSysMessage("%u. Map %u zone %u (%s) area %u (%s): %.1f ms - players %.1f, objects %.1f, spells %.1f, ai %.1f, visibility %.1f - sent %llu packets, %llu KB",
+            i + 1, key.mapId, key.zoneId, zoneEntry ? zoneEntry->area_name[GetSessionDbcLocale()] : "", key.areaId, areaEntry ? areaEntry->area_name[GetSessionDbcLocale()] : "",
+            counters.GetUpdateUs() / 1000.0f, counters.us[ZONE_STATS_PLAYERS] / 1000.0f, counters.us[ZONE_STATS_OBJECTS] / 1000.0f, counters.us[ZONE_STATS_SPELLS] / 1000.0f,
+            counters.us[ZONE_STATS_AI] / 1000.0f, counters.us[ZONE_STATS_VISIBILITY] / 1000.0f, (unsigned long long)counters.packets, (unsigned long long)(counters.bytes / 1024));
+    }
+    return true;
+}
+
+bool ChatHandler::HandleServerAllocStatsCommand(char* /*args*/)
+{
+    if (!AllocStats::IsEnabled())
+        SendSysMessage("AllocStats.Enabled is 0, allocations are not counted.");
+
+    AllocStatsCounters counters;
+    sAllocStats.GetLastInterval(counters);
+
+    uint64 totalCount = 0;
+    uint64 totalBytes = 0;
+    for (uint32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+    {
+        totalCount += counters.count[i];
+        totalBytes += counters.bytes[i];
+    }
+
+    PSendSysMessage("Last minute, %llu allocations, %llu KB (%s allocator):", (unsigned long long)totalCount, (unsigned long long)(totalBytes / 1024), AllocStats::GetAllocatorName());
+    for (uint32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+        PSendSysMessage("%s: %llu allocations, %llu KB", AllocStats::GetTagName(AllocTag(i)), (unsigned long long)counters.count[i], (unsigned long long)(counters.bytes[i] / 1024));
+    return true;
+}
+
 bool ChatHandler::HandleServerResetAllRaidCommand(char* /*args*/)
 {
     PSendSysMessage("Global raid instances reset, all players in raid instances will be teleported to homebind!");
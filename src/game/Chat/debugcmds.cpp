@@ -35,6 +35,15 @@
 #include "Maps/InstanceData.h"
 #include "Cinematics/M2Stores.h"
 #include "Entities/Transports.h"
+#include "Server/OpcodeStats.h"
+#include "AI/ScriptDevAI/ScriptProfiler.h"
+#include "World/World.h"
+#include "Spells/Spell.h"
+#include "Spells/SpellAuras.h"
+#include "Config/Config.h"
+#include "Trace.h"
+
+#include <chrono>
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1424,6 +1433,56 @@ bool ChatHandler::HandleGridsLoadedCount(char* /*args*/)
     return true;
 }
 
+bool ChatHandler::HandleDebugPerfSpellCastCommand(char* args)
+{
+    Player* player = m_session->GetPlayer();
+
+    uint32 spellId = ExtractSpellIdFromLink(&args);
+    if (!spellId)
+        return false;
+
+    SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(spellId);
+    if (!spellInfo || !SpellMgr::IsSpellValid(spellInfo, player))
+    {
+        PSendSysMessage(LANG_COMMAND_SPELL_BROKEN, spellId);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 100) || !count || count > 10000)
+        return false;
+
+    Unit* target = getSelectedUnit(false);
+    if (!target)
+        target = player;
+
+    MaNGOS::ObjectPoolStats spellsBefore = Spell::GetPoolStats();
+    MaNGOS::ObjectPoolStats holdersBefore = SpellAuraHolder::GetPoolStats();
+    MaNGOS::ObjectPoolStats aurasBefore = Aura::GetPoolStats();
+
+    // same path as scripted casts, costs and cooldowns would stop the loop after the first cast
+    uint32 failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < count; ++i)
+        if (player->CastSpell(target, spellInfo, TriggerCastFlags(TRIGGERED_OLD_TRIGGERED | TRIGGERED_IGNORE_COSTS | TRIGGERED_IGNORE_COOLDOWNS | TRIGGERED_IGNORE_GCD)) != SPELL_CAST_OK)
+            ++failed;
+    uint64 elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    auto allocated = [](MaNGOS::ObjectPoolStats const& before, MaNGOS::ObjectPoolStats const& after)
+    {
+        return (after.systemAllocations + after.reuses) - (before.systemAllocations + before.reuses);
+    };
+    uint64 spells = allocated(spellsBefore, Spell::GetPoolStats());
+    uint64 holders = allocated(holdersBefore, SpellAuraHolder::GetPoolStats());
+    uint64 auras = allocated(aurasBefore, Aura::GetPoolStats());
+
+    PSendSysMessage("Spell %u cast %u times on %s (%u failed): %.0f ns per cast", spellId, count, target->GetGuidStr().c_str(), failed, double(elapsedNs) / count);
+    PSendSysMessage("Per cast: %.2f spells (%.2f triggered), %.2f aura holders, %.2f auras",
+        double(spells) / count, spells > count ? double(spells - count) / count : 0.0, double(holders) / count, double(auras) / count);
+    return true;
+}
+
 bool ChatHandler::HandleDebugWaypoint(char* args)
 {
     Creature* target = getSelectedCreature();
@@ -1887,6 +1946,80 @@ bool ChatHandler::HandleDebugPacketLog(char* args)
     return true;
 }
 
+bool ChatHandler::HandleDebugOpcodeStats(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sOpcodeStats.Reset();
+        SendSysMessage("Opcode handler stats reset.");
+        return true;
+    }
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    if (!sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS))
+        SendSysMessage("Network.OpcodeStats is disabled, stats are not updated.");
+
+    static char const* processingNames[] = { "inplace", "threadunsafe", "threadsafe", "map_thread", "immediate" };
+
+    std::vector<std::pair<uint64, uint32>> byTotal;         // total us, opcode
+    LatencyHistogram::Snapshot stats;
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+        if (sOpcodeStats.GetSnapshot(i, OpcodeStats::RANGE_TOTAL, stats, false))
+            byTotal.emplace_back(stats.totalUs, i);
+
+    std::sort(byTotal.begin(), byTotal.end(), std::greater<std::pair<uint64, uint32>>());
+    if (byTotal.size() > limit)
+        byTotal.resize(limit);
+
+    PSendSysMessage("Top %u opcode handlers by total time:", uint32(byTotal.size()));
+    for (auto const& entry : byTotal)
+    {
+        sOpcodeStats.GetSnapshot(entry.second, OpcodeStats::RANGE_TOTAL, stats, false);
+        PSendSysMessage("%s (%s): %llu calls, %llu ms total, p50 %llu us, p99 %llu us, max %llu us", LookupOpcodeName(entry.second),
+            processingNames[opcodeTable[entry.second].packetProcessing], (unsigned long long)stats.count, (unsigned long long)(stats.totalUs / 1000),
+            (unsigned long long)stats.Percentile(50.0), (unsigned long long)stats.Percentile(99.0), (unsigned long long)stats.maxUs);
+    }
+    return true;
+}
+
+bool ChatHandler::HandleDebugScriptProfile(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sScriptProfiler.Reset();
+        SendSysMessage("Script profile reset.");
+        return true;
+    }
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    uint32 rate = sWorld.getConfig(CONFIG_UINT32_SCRIPT_PROFILE_SAMPLE_RATE);
+    if (!rate)
+        SendSysMessage("ScriptProfile.SampleRate is 0, the profile is not updated.");
+
+    std::vector<std::pair<ScriptProfiler::Key, LatencyHistogram::Snapshot>> snapshots;
+    sScriptProfiler.GetSnapshots(ScriptProfiler::RANGE_TOTAL, snapshots, false);
+    std::sort(snapshots.begin(), snapshots.end(), [](std::pair<ScriptProfiler::Key, LatencyHistogram::Snapshot> const& a, std::pair<ScriptProfiler::Key, LatencyHistogram::Snapshot> const& b)
+    {
+        return a.second.totalUs > b.second.totalUs;
+    });
+    if (snapshots.size() > limit)
+        snapshots.resize(limit);
+
+    // totals are scaled by the sample rate, percentiles are those of the sampled calls
+    PSendSysMessage("Top %u scripts by estimated total time (1 of %u calls sampled):", uint32(snapshots.size()), std::max(rate, 1u));
+    for (auto const& entry : snapshots)
+        PSendSysMessage("%s map %u %s: %llu samples, ~%llu ms total, p50 %llu us, p99 %llu us, max %llu us", sScriptDevAIMgr.GetScriptName(entry.first.scriptId),
+            entry.first.mapId, ScriptProfiler::GetHookName(entry.first.hook), (unsigned long long)entry.second.count, (unsigned long long)(entry.second.totalUs * std::max(rate, 1u) / 1000),
+            (unsigned long long)entry.second.Percentile(50.0), (unsigned long long)entry.second.Percentile(99.0), (unsigned long long)entry.second.maxUs);
+    return true;
+}
+
 bool ChatHandler::HandleDebugDbscript(char* args)
 {
     Unit* target = getSelectedUnit();
@@ -1901,3 +2034,48 @@ bool ChatHandler::HandleDebugDbscript(char* args)
     player->GetMap()->ScriptsStart(sRelayScripts, chosenId, player, target);
     return true;
 }
+
+bool ChatHandler::HandleDebugTrace(char* args)
+{
+#ifdef BUILD_TRACING
+    if (ExtractLiteralArg(&args, "stop"))
+    {
+        if (!sTrace.IsCaptureRunning())
+        {
+            SendSysMessage("No trace capture is running.");
+            SetSentErrorMessage(true);
+            return false;
+        }
+
+        sTrace.StopCapture();
+        SendSysMessage("Trace capture stopped, the file is written to LogsDir.");
+        return true;
+    }
+
+    uint32 seconds;
+    if (!ExtractOptUInt32(&args, seconds, 5))
+        return false;
+
+    seconds = std::min(std::max(seconds, 1u), 60u);
+
+    std::string fileName = sConfig.GetStringDefault("LogsDir", "");
+    if (!fileName.empty())
+        if ((fileName.at(fileName.length() - 1) != '/') && (fileName.at(fileName.length() - 1) != '\\'))
+            fileName.push_back('/');
+    fileName += "trace_" + std::to_string(time(nullptr)) + ".json";
+
+    if (!sTrace.StartCapture(fileName, seconds * IN_MILLISECONDS))
+    {
+        SendSysMessage("A trace capture is already running.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Tracing for %u seconds into %s.", seconds, fileName.c_str());
+    return true;
+#else
+    SendSysMessage("Tracing zones are not compiled in, rebuild with the BUILD_TRACING cmake option.");
+    SetSentErrorMessage(true);
+    return false;
+#endif
+}
@@ -60,6 +60,14 @@ void WorldSession::HandleDuelAcceptedOpcode(WorldPacket& recvPacket)
 
     self->SendDuelCountdown(3000);
     opponent->SendDuelCountdown(3000);
+
+    // sets the duel teams of both players at the end of the countdown, a canceled or restarted duel ignores it
+    self->m_events.AddEvent(new UnitLambdaEvent(*self, [startTimer = now](Unit& unit)
+    {
+        Player& player = static_cast<Player&>(unit);
+        if (player.duel && player.duel->startTimer == startTimer)
+            player.UpdateDuelFlag(startTimer + 3);
+    }), self->m_events.CalculateTime(3000));
 }
 
 void WorldSession::HandleDuelCancelledOpcode(WorldPacket& recvPacket)
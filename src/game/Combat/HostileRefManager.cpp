@@ -60,9 +60,25 @@ void HostileRefManager::threatAssist(Unit* victim, float threat, SpellEntry cons
 
     uint32 size = singleTarget ? 1 : validRefs.size();            // if singleTarget do not devide threat
     float threatPerTarget = threat / size;
+    SpellSchoolMask schoolMask = threatSpell ? GetSpellSchoolMask(threatSpell) : SPELL_SCHOOL_MASK_NORMAL;
+    // the calculated threat depends only on the helper and the spell for creature owners, so it is done once for all of them
+    bool calculated = false;
+    float calculatedThreat = 0.f;
     for (HostileReference* validReference : validRefs)
     {
-        validReference->getSource()->addThreat(victim, threatPerTarget, false, (threatSpell ? GetSpellSchoolMask(threatSpell) : SPELL_SCHOOL_MASK_NORMAL), threatSpell, true);
+        ThreatManager* threatManager = validReference->getSource();
+        Unit* owner = threatManager->getOwner();
+        if (owner->IsPlayer())
+            threatManager->addThreat(victim, threatPerTarget, false, schoolMask, threatSpell, true);
+        else if (threatManager->CanHaveThreatOn(victim))
+        {
+            if (!calculated)
+            {
+                calculatedThreat = ThreatCalcHelper::CalcThreat(victim, owner, threatPerTarget, false, schoolMask, threatSpell, true);
+                calculated = true;
+            }
+            threatManager->addCalculatedThreat(victim, calculatedThreat);
+        }
         if (!ignoreTimer)
             victim->GetCombatManager().TriggerCombatTimer(validReference->getSource()->getOwner());
     }
@@ -26,6 +26,9 @@
 #include "Entities/UnitEvents.h"
 #include "Spells/SpellAuras.h"
 
+#include <algorithm>
+#include <vector>
+
 //==============================================================
 //================= ThreatCalcHelper ===========================
 //==============================================================
@@ -308,37 +311,51 @@ void ThreatContainer::update(bool force, bool isPlayer)
 {
     if ((iDirty || force || isPlayer) && iThreatList.size() > 1)
     {
-        iThreatList.sort([&](const HostileReference* lhs, const HostileReference* rhs)->bool
+        // the sort keys are gathered once per reference, reach and attackability checks are too costly to redo per comparison
+        struct SortKey
         {
-            Unit* owner = lhs->getSource()->getOwner();
-            if (isPlayer)
-            {
-                Unit* left = lhs->getTarget();
-                Unit* right = rhs->getTarget();
-                if (left->IsPlayer() && !right->IsPlayer())
-                    return true;
-                if (!left->IsPlayer() && right->IsPlayer())
-                    return false;
-                bool attackLeft = owner->CanAttack(left);
-                bool attackRight = owner->CanAttack(right);
-                if (attackLeft && !attackRight)
-                    return true;
-                if (!attackLeft && attackRight)
-                    return false;
-            }
-            if (lhs->GetTauntState() != rhs->GetTauntState())
-                return lhs->GetTauntState() > rhs->GetTauntState();
-            if (force)
-            {
-                bool first = owner->CanReachWithMeleeAttack(lhs->getTarget());
-                bool second = owner->CanReachWithMeleeAttack(rhs->getTarget());
-                if (first != second)
-                    return first > second;
-            }
-            if (lhs->GetHostileState() != rhs->GetHostileState())
-                return lhs->GetHostileState() > rhs->GetHostileState();
-            return lhs->getThreat() > rhs->getThreat(); // reverse sorting
-        });
+            bool playerTarget;
+            bool attackable;
+            TauntState tauntState;
+            bool inMelee;
+            HostileState hostileState;
+            float threat;
+            ThreatList::iterator itr;
+        };
+        static thread_local std::vector<SortKey> keys;
+        keys.clear();
+
+        Unit* owner = iThreatList.front()->getSource()->getOwner();
+        for (ThreatList::iterator itr = iThreatList.begin(); itr != iThreatList.end(); ++itr)
+        {
+            HostileReference* ref = *itr;
+            Unit* target = ref->getTarget();
+            keys.push_back({ isPlayer && target->IsPlayer(), isPlayer && owner->CanAttack(target), ref->GetTauntState(),
+                force && owner->CanReachWithMeleeAttack(target), ref->GetHostileState(), ref->getThreat(), itr });
+        }
+
+        auto higherPriority = [](SortKey const& lhs, SortKey const& rhs)->bool
+        {
+            if (lhs.playerTarget != rhs.playerTarget)
+                return lhs.playerTarget;
+            if (lhs.attackable != rhs.attackable)
+                return lhs.attackable;
+            if (lhs.tauntState != rhs.tauntState)
+                return lhs.tauntState > rhs.tauntState;
+            if (lhs.inMelee != rhs.inMelee)
+                return lhs.inMelee;
+            if (lhs.hostileState != rhs.hostileState)
+                return lhs.hostileState > rhs.hostileState;
+            return lhs.threat > rhs.threat; // reverse sorting
+        };
+
+        // most updates move only a few references, a sorted list is left untouched
+        if (!std::is_sorted(keys.begin(), keys.end(), higherPriority))
+        {
+            std::stable_sort(keys.begin(), keys.end(), higherPriority);
+            for (SortKey const& key : keys)
+                iThreatList.splice(iThreatList.end(), iThreatList, key.itr);
+        }
     }
     iDirty = false;
 }
@@ -471,20 +488,32 @@ void ThreatManager::addThreat(Unit* victim, float threat, bool crit, SpellSchool
     // players and pets have only InHateListOf
     // HateOfflineList is used co contain unattackable victims (in-flight, in-water, GM etc.)
 
+    if (!CanHaveThreatOn(victim))
+        return;
+
+    float calculatedThreat = ThreatCalcHelper::CalcThreat(victim, iOwner, threat, crit, schoolMask, threatSpell, assist);
+    addCalculatedThreat(victim, calculatedThreat);
+}
+
+bool ThreatManager::CanHaveThreatOn(Unit* victim) const
+{
     // not to self
     if (victim == getOwner())
-        return;
+        return false;
 
     // not to GM
     if (!victim || (victim->GetTypeId() == TYPEID_PLAYER && static_cast<Player*>(victim)->IsGameMaster()))
-        return;
+        return false;
 
     // not to dead and not for dead
     if (!victim->IsAlive() || !getOwner()->IsAlive())
-        return;
+        return false;
 
-    float calculatedThreat = ThreatCalcHelper::CalcThreat(victim, iOwner, threat, crit, schoolMask, threatSpell, assist);
+    return true;
+}
 
+void ThreatManager::addCalculatedThreat(Unit* victim, float calculatedThreat)
+{
     if (calculatedThreat > 0.0f)
     {
         if (Unit* redirectedTarget = victim->getHostileRefManager().GetThreatRedirectionTarget())
@@ -201,6 +201,10 @@ class ThreatManager
         void addThreat(Unit* victim, float threat, bool crit, SpellSchoolMask schoolMask, SpellEntry const* threatSpell, bool assist);
         void addThreat(Unit* victim, float threat) { addThreat(victim, threat, false, SPELL_SCHOOL_MASK_NONE, nullptr, false); }
 
+        // threat already passed through ThreatCalcHelper, redirections still apply, caller checks CanHaveThreatOn
+        void addCalculatedThreat(Unit* victim, float calculatedThreat);
+        bool CanHaveThreatOn(Unit* victim) const;
+
         // add threat as raw value (ignore redirections and expection all mods applied already to it
         void addThreatDirectly(Unit* victim, float threat);
 
@@ -35,6 +35,10 @@
 #include "Maps/InstanceData.h"
 #include "Entities/Object.h"
 
+#ifdef BUILD_METRICS
+ #include "Metric/Metric.h"
+#endif
+
 ScriptMapMapName sQuestEndScripts;
 ScriptMapMapName sQuestStartScripts;
 ScriptMapMapName sSpellScripts;
@@ -1525,6 +1529,15 @@ Player* ScriptAction::GetPlayerTargetOrSourceAndLog(WorldObject* pSource, WorldO
 // Return true if and only if further parts of this script shall be skipped
 bool ScriptAction::HandleScriptStep()
 {
+#ifdef BUILD_METRICS
+    // slow steps only, tagged by script so expensive db scripts can be found
+    auto meas = metric::make_slow_span<std::chrono::microseconds>("dbscript.step", 1000, [&] { return std::map<std::string, std::string> {
+        { "table", m_table },
+        { "id", std::to_string(GetId()) },
+        { "command", std::to_string(m_script->command) }
+    }; });
+#endif
+
     std::vector<WorldObject*> sources;
     std::vector<WorldObject*> targets;
 
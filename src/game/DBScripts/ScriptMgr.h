@@ -681,6 +681,7 @@ class ScriptMgr
         int32 GetRandomRelayDbscriptFromTemplate(uint32 id);
 
         uint32 IncreaseScheduledScriptsCount() { return (uint32)++m_scheduledScripts; }
+        uint32 IncreaseScheduledScriptsCount(size_t count) { return (uint32)(m_scheduledScripts += count); }
         uint32 DecreaseScheduledScriptCount() { return (uint32)--m_scheduledScripts; }
         uint32 DecreaseScheduledScriptCount(size_t count) { return (uint32)(m_scheduledScripts -= count); }
         bool IsScriptScheduled() const { return m_scheduledScripts > 0; }
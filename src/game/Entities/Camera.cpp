@@ -22,8 +22,9 @@
 #include "Log.h"
 #include "Errors.h"
 #include "Entities/Player.h"
+#include "World/World.h"
 
-Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl)
+Camera::Camera(Player* pl) : m_owner(*pl), m_source(pl), m_moveUpdates(0)
 {
     m_source->GetViewPoint().Attach(this);
 }
@@ -145,11 +146,27 @@ template void Camera::UpdateVisibilityOf(DynamicObject*, UpdateData&, WorldObjec
 
 void Camera::UpdateVisibilityForOwner(bool addToWorld)
 {
-    MaNGOS::VisibleNotifier notifier(*this);
+    m_moveUpdates = 0;
+    MaNGOS::VisibleNotifier notifier(*this, false);
     Cell::VisitAllObjects(m_source, notifier, addToWorld ? MAX_VISIBILITY_DISTANCE : m_source->GetVisibilityData().GetVisibilityDistance(), false);
     notifier.Notify();
 }
 
+void Camera::UpdateVisibilityAfterMove()
+{
+    // visibility state changes of objects are event driven, moving only changes what is in range;
+    // the periodic full update still catches everything else
+    if (++m_moveUpdates >= sWorld.getConfig(CONFIG_UINT32_VISIBILITY_FULL_SWEEP_INTERVAL))
+    {
+        UpdateVisibilityForOwner(false);
+        return;
+    }
+
+    MaNGOS::VisibleNotifier notifier(*this, true);
+    Cell::VisitAllObjects(m_source, notifier, m_source->GetVisibilityData().GetVisibilityDistance(), false);
+    notifier.Notify();
+}
+
 //////////////////
 
 ViewPoint::~ViewPoint()
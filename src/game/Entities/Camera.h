@@ -56,6 +56,8 @@ class Camera
         // updates visibility of worldobjects around viewpoint for camera's owner
         void UpdateVisibilityForOwner() { UpdateVisibilityForOwner(false); }
         void UpdateVisibilityForOwner(bool addToWorld);
+        // same after the viewpoint moved, objects at the client well inside visibility range are mostly skipped
+        void UpdateVisibilityAfterMove();
 
     private:
         // called when viewpoint changes visibility state
@@ -66,6 +68,7 @@ class Camera
 
         Player& m_owner;
         WorldObject* m_source;
+        uint32 m_moveUpdates;                               // partial visibility updates since the last full one
 
         void UpdateForCurrentViewPoint();
 
@@ -136,6 +139,11 @@ class ViewPoint
         {
             CameraCall(&Camera::UpdateVisibilityForOwner);
         }
+
+        void Call_UpdateVisibilityAfterMove()
+        {
+            CameraCall(&Camera::UpdateVisibilityAfterMove);
+        }
 };
 
 #endif
@@ -41,6 +41,8 @@
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Anticheat/Anticheat.hpp"
 
+#include "Entities/CharacterLoginCache.h"
+
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
 #endif
@@ -60,7 +62,7 @@ class LoginQueryHolder : public SqlQueryHolder
         ObjectGuid m_guid;
     public:
         LoginQueryHolder(uint32 accountId, ObjectGuid guid)
-            : m_accountId(accountId), m_guid(guid) { }
+            : m_accountId(accountId), m_guid(guid) { SetSerialKey(guid.GetCounter()); }   // must see the last save of the character
         ObjectGuid GetGuid() const { return m_guid; }
         uint32 GetAccountId() const { return m_accountId; }
         bool Initialize();
@@ -102,8 +104,7 @@ bool LoginQueryHolder::Initialize()
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADBGDATA,          "SELECT instance_id, team, join_x, join_y, join_z, join_o, join_map FROM character_battleground_data WHERE guid = '%u'", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADACCOUNTDATA,     "SELECT type, time, data FROM character_account_data WHERE guid='%u'", m_guid.GetCounter());
     res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADSKILLS,          "SELECT skill, value, max FROM character_skills WHERE guid = '%u'", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILS,           "SELECT id,messageType,sender,receiver,subject,itemTextId,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", m_guid.GetCounter());
-    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,     "SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
+    res &= SetPQuery(PLAYER_LOGIN_QUERY_LOADMAILSTATUS,      "SELECT deliver_time, checked FROM mail WHERE receiver = '%u'", m_guid.GetCounter());
 
     return res;
 }
@@ -132,6 +133,14 @@ class CharacterHandler
             if (WorldSession* session = sWorld.FindSession(((LoginQueryHolder*)holder)->GetAccountId()))
                 session->HandlePlayerLogin((LoginQueryHolder*)holder);
         }
+
+        void HandleLoginCacheFillCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder, uint32 requestId)
+        {
+            if (!holder) return;
+
+            sCharacterLoginCache.Store(((LoginQueryHolder*)holder)->GetGuid(), requestId, holder, MAX_PLAYER_LOGIN_QUERY);
+            delete holder;
+        }
 #ifdef BUILD_PLAYERBOT
         // This callback is different from the normal HandlePlayerLoginCallback in that it
         // sets up the bot's world session and also stores the pointer to the bot player in the master's
@@ -550,9 +559,34 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recv_data)
         return;
     }
 
+    // relog shortly after the logout, the results were read back behind the logout save
+    if (sCharacterLoginCache.Take(playerGuid, holder, MAX_PLAYER_LOGIN_QUERY))
+    {
+        HandlePlayerLogin(holder);
+        return;
+    }
+
     CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandlePlayerLoginCallback, holder);
 }
 
+void WorldSession::FillCharacterLoginCache(ObjectGuid playerGuid)
+{
+    uint32 requestId = sCharacterLoginCache.RequestFill(playerGuid);
+    if (!requestId)
+        return;
+
+    // same serial key as the saves, so it reads what the logout save wrote
+    LoginQueryHolder* holder = new LoginQueryHolder(GetAccountId(), playerGuid);
+    if (!holder->Initialize())
+    {
+        delete holder;
+        sCharacterLoginCache.Invalidate(playerGuid);
+        return;
+    }
+
+    CharacterDatabase.DelayQueryHolder(&chrHandler, &CharacterHandler::HandleLoginCacheFillCallback, holder, requestId);
+}
+
 #ifdef BUILD_PLAYERBOT
 // Can't easily reuse HandlePlayerLoginOpcode for logging in bots because it assumes
 // a WorldSession exists for the bot. The WorldSession for a bot is created after the character is loaded.
@@ -580,6 +614,9 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 {
     ObjectGuid playerGuid = holder->GetGuid();
 
+    // online from now on, also for logins not going through the cache
+    sCharacterLoginCache.Invalidate(playerGuid);
+
     Player* pCurrChar = new Player(this);
     SetPlayer(pCurrChar, playerGuid);
     m_playerLoading = true;
@@ -676,6 +713,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder* holder)
 
             guild->DisplayGuildBankTabsInfo(this);
 
+            guild->MemberLoggedIn(pCurrChar);
             guild->BroadcastEvent(GE_SIGNED_ON, pCurrChar->GetObjectGuid(), pCurrChar->GetName());
         }
         else
@@ -903,6 +941,7 @@ void WorldSession::HandlePlayerReconnect()
             SendPacket(data);
             DEBUG_LOG("WORLD: Sent guild-motd (SMSG_GUILD_EVENT)");
 
+            guild->MemberLoggedIn(_player);
             guild->BroadcastEvent(GE_SIGNED_ON, _player->GetObjectGuid(), _player->GetName());
         }
         else
@@ -1141,11 +1180,15 @@ void WorldSession::HandleChangePlayerNameOpcodeCallBack(QueryResult* result, uin
 
     delete result;
 
+    sCharacterLoginCache.Invalidate(guid);
+
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("UPDATE characters set name = '%s', at_login = at_login & ~ %u WHERE guid ='%u'", newname.c_str(), uint32(AT_LOGIN_RENAME), guidLow);
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid ='%u'", guidLow);
     CharacterDatabase.CommitTransaction();
 
+    sObjectMgr.UpdatePlayerDataCacheName(guidLow, newname);
+
     sLog.outChar("Account: %d (IP: %s) Character:[%s] (guid:%u) Changed name to: %s", session->GetAccountId(), session->GetRemoteAddress().c_str(), oldname.c_str(), guidLow, newname.c_str());
 
     WorldPacket data(SMSG_CHAR_RENAME, 1 + 8 + (newname.size() + 1));
@@ -1232,6 +1275,8 @@ void WorldSession::HandleSetPlayerDeclinedNamesOpcode(WorldPacket& recv_data)
     for (auto& i : declinedname.name)
         CharacterDatabase.escape_string(i);
 
+    sCharacterLoginCache.Invalidate(guid);
+
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM character_declinedname WHERE guid = '%u'", guid.GetCounter());
     CharacterDatabase.PExecute("INSERT INTO character_declinedname (guid, genitive, dative, accusative, instrumental, prepositional) VALUES ('%u','%s','%s','%s','%s','%s')",
@@ -0,0 +1,132 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/CharacterLoginCache.h"
+#include "Policies/Singleton.h"
+#include "Database/SqlOperations.h"
+#include "World/World.h"
+
+INSTANTIATE_SINGLETON_1(CharacterLoginCache);
+
+bool CharacterLoginCache::IsEnabled() const
+{
+    return sWorld.getConfig(CONFIG_UINT32_LOGIN_CACHE_SIZE) != 0;
+}
+
+uint32 CharacterLoginCache::RequestFill(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // the cached state is older than the save just queued
+    m_entries.erase(guid.GetCounter());
+
+    if (!IsEnabled())
+        return 0;
+
+    uint32 requestId = ++m_lastRequest;
+    if (!requestId)                                         // 0 means no request
+        requestId = ++m_lastRequest;
+
+    m_pendingFills[guid.GetCounter()] = requestId;
+    return requestId;
+}
+
+void CharacterLoginCache::Store(ObjectGuid guid, uint32 requestId, SqlQueryHolder* holder, uint32 queryCount)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    auto pending = m_pendingFills.find(guid.GetCounter());
+    if (pending == m_pendingFills.end() || pending->second != requestId)
+        return;                                             // changed or logged in meanwhile
+
+    m_pendingFills.erase(pending);
+
+    uint32 maxSize = sWorld.getConfig(CONFIG_UINT32_LOGIN_CACHE_SIZE);
+    if (!maxSize)
+        return;
+
+    time_t now = sWorld.GetGameTime();
+    RemoveExpired(now);
+
+    // full - drop the entry expiring first
+    while (m_entries.size() >= maxSize)
+    {
+        auto oldest = m_entries.begin();
+        for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+            if (itr->second.expireTime < oldest->second.expireTime)
+                oldest = itr;
+        m_entries.erase(oldest);
+    }
+
+    Entry& entry = m_entries[guid.GetCounter()];
+    entry.expireTime = now + sWorld.getConfig(CONFIG_UINT32_LOGIN_CACHE_TTL);
+    entry.results.resize(queryCount);
+    for (uint32 i = 0; i < queryCount; ++i)
+    {
+        // the rows take over the result
+        if (QueryResult* result = holder->GetResult(i))
+            entry.results[i] = std::make_shared<QueryResultRows const>(result);
+    }
+}
+
+bool CharacterLoginCache::Take(ObjectGuid guid, SqlQueryHolder* holder, uint32 queryCount)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_pendingFills.erase(guid.GetCounter());
+
+    auto itr = m_entries.find(guid.GetCounter());
+    if (itr == m_entries.end())
+        return false;
+
+    Entry entry = std::move(itr->second);
+    m_entries.erase(itr);
+
+    if (entry.expireTime < sWorld.GetGameTime() || entry.results.size() != queryCount)
+        return false;
+
+    for (uint32 i = 0; i < queryCount; ++i)
+        holder->SetResult(i, entry.results[i] ? new QueryResultCopy(entry.results[i]) : nullptr);
+
+    return true;
+}
+
+void CharacterLoginCache::Invalidate(ObjectGuid guid)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_entries.erase(guid.GetCounter());
+    m_pendingFills.erase(guid.GetCounter());
+}
+
+void CharacterLoginCache::Clear()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_entries.clear();
+    m_pendingFills.clear();
+}
+
+void CharacterLoginCache::RemoveExpired(time_t now)
+{
+    for (auto itr = m_entries.begin(); itr != m_entries.end();)
+    {
+        if (itr->second.expireTime < now)
+            itr = m_entries.erase(itr);
+        else
+            ++itr;
+    }
+}
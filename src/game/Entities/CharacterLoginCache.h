@@ -0,0 +1,77 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CHARACTER_LOGIN_CACHE_H
+#define MANGOS_CHARACTER_LOGIN_CACHE_H
+
+#include "Common.h"
+#include "Database/QueryResult.h"
+#include "Entities/ObjectGuid.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class SqlQueryHolder;
+
+/**
+ * Login query results of recently logged out characters, see CharacterLoginCache.Size
+ *
+ * The results are read back by a query holder queued behind the logout save with the character serial key,
+ * so they are the saved state. Changes the server makes to an offline character must call Invalidate.
+ */
+class CharacterLoginCache
+{
+    public:
+        CharacterLoginCache() : m_lastRequest(0) {}
+
+        bool IsEnabled() const;
+
+        /// Returns the id to pass to Store, 0 when nothing should be read back
+        uint32 RequestFill(ObjectGuid guid);
+        /// Keeps the results of holder when no change happened since RequestFill
+        void Store(ObjectGuid guid, uint32 requestId, SqlQueryHolder* holder, uint32 queryCount);
+
+        /// Moves the cached results into holder, false - the character must be loaded from DB
+        bool Take(ObjectGuid guid, SqlQueryHolder* holder, uint32 queryCount);
+
+        void Invalidate(ObjectGuid guid);
+        /// For changes made to all characters at once, like quest resets
+        void Clear();
+
+    private:
+        typedef std::vector<std::shared_ptr<QueryResultRows const>> Results;    ///< nullptr for empty results
+
+        struct Entry
+        {
+            time_t expireTime;
+            Results results;
+        };
+
+        void RemoveExpired(time_t now);
+
+        std::mutex m_lock;                                  ///< Invalidate may be called from map threads
+        std::map<uint32, Entry> m_entries;                  ///< by guid counter
+        std::map<uint32, uint32> m_pendingFills;            ///< guid counter -> request id of the read back on the way
+        uint32 m_lastRequest;
+};
+
+#define sCharacterLoginCache MaNGOS::Singleton<CharacterLoginCache>::Instance()
+
+#endif
@@ -266,11 +266,11 @@ bool Corpse::isVisibleForInState(Player const* u, WorldObject const* viewPoint,
     return IsInWorld() && u->IsInWorld() && IsWithinDistInMap(viewPoint, GetMap()->GetVisibilityDistance(), false);
 }
 
-bool Corpse::IsExpired(time_t t) const
+time_t Corpse::GetExpiryTime() const
 {
     if (m_type == CORPSE_BONES)
-        return m_time < t - 60 * MINUTE;
-    return m_time < t - 3 * DAY;
+        return m_time + 60 * MINUTE;
+    return m_time + 3 * DAY;
 }
 
 Team Corpse::GetTeam() const
@@ -88,7 +88,8 @@ class Corpse : public WorldObject
 
         GridReference<Corpse>& GetGridRef() { return m_gridRef; }
 
-        bool IsExpired(time_t t) const;
+        time_t GetExpiryTime() const;
+        bool IsExpired(time_t t) const { return GetExpiryTime() < t; }
         Team GetTeam() const;
     private:
         GridReference<Corpse> m_gridRef;
@@ -140,7 +140,7 @@ Creature::Creature(CreatureSubtype subtype) : Unit(),
     m_respawnTime(0), m_respawnDelay(25), m_respawnOverriden(false), m_respawnOverrideOnce(false), m_corpseDelay(60), m_canAggro(false),
     m_respawnradius(5.0f), m_interactionPauseTimer(0), m_subtype(subtype), m_defaultMovementType(IDLE_MOTION_TYPE),
     m_equipmentId(0), m_detectionRange(20.f), m_AlreadyCallAssistance(false), m_canCallForAssistance(true),
-    m_isDeadByDefault(false),
+    m_isDeadByDefault(false), m_hibernationWakeUp(false),
     m_temporaryFactionFlags(TEMPFACTION_NONE),
     m_originalEntry(0), m_gameEventVendorId(0), m_ai(nullptr),
     m_isInvisible(false), m_ignoreMMAP(false), m_forceAttackingCapability(false),
@@ -711,8 +711,24 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo* cinfo, const CreatureData*
     return display_id;
 }
 
-void Creature::Update(const uint32 diff)
+void Creature::Update(const uint32 p_time)
 {
+    // hibernating creatures catch up once per interval, low detail ones every few ticks, awake ones right away
+    m_deferredUpdateTime += p_time;
+    if (CanDeferUpdate())
+    {
+        if (GetMap()->IsHibernationArea(GetPositionX(), GetPositionY()))
+        {
+            if (m_deferredUpdateTime < sWorld.getConfig(CONFIG_UINT32_CREATURE_HIBERNATE_INTERVAL))
+                return;
+        }
+        else if (DeferLowDetailUpdate())
+            return;
+    }
+
+    uint32 const diff = TakeDeferredUpdateTime();
+    m_hibernationWakeUp = false;
+
     switch (m_deathState)
     {
         case JUST_ALIVED:
@@ -812,6 +828,14 @@ void Creature::Update(const uint32 diff)
     }
 }
 
+bool Creature::CanDeferUpdate() const
+{
+    if (m_hibernationWakeUp || !IsAlive() || IsInCombat() || isActiveObject())
+        return false;
+
+    return m_subtype == CREATURE_SUBTYPE_GENERIC && !GetMasterGuid() && !GetScriptId();
+}
+
 void Creature::RegenerateAll(uint32 diff)
 {
     m_regenTimer += diff;
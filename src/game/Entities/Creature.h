@@ -334,26 +334,27 @@ struct CreatureConditionalSpawn
 #pragma pack(pop)
 #endif
 
+// the texts below are offsets in the ObjectMgr locale string pool, see ObjectMgr::GetLocaleString
 struct CreatureLocale
 {
-    std::vector<std::string> Name;
-    std::vector<std::string> SubName;
+    std::vector<uint32> Name;
+    std::vector<uint32> SubName;
 };
 
 struct GossipMenuItemsLocale
 {
-    std::vector<std::string> OptionText;
-    std::vector<std::string> BoxText;
+    std::vector<uint32> OptionText;
+    std::vector<uint32> BoxText;
 };
 
 struct PointOfInterestLocale
 {
-    std::vector<std::string> IconName;
+    std::vector<uint32> IconName;
 };
 
 struct AreaTriggerLocale
 {
-    std::vector<std::string> StatusFailed;
+    std::vector<uint32> StatusFailed;
 };
 
 enum InhabitTypeValues
@@ -567,7 +568,11 @@ class Creature : public Unit
 
         char const* GetSubName() const { return GetCreatureInfo()->SubName; }
 
-        void Update(const uint32 diff) override;  // overwrite Unit::Update
+        void Update(const uint32 p_time) override;  // overwrite Unit::Update
+
+        // idle creatures away from players skip updates and catch up later with the accumulated time
+        bool CanDeferUpdate() const;
+        void WakeFromHibernation() { m_hibernationWakeUp = true; }
 
         virtual void RegenerateAll(uint32 update_diff);
         uint32 GetEquipmentId() const { return m_equipmentId; }
@@ -914,6 +919,7 @@ class Creature : public Unit
         bool m_AlreadyCallAssistance;
         bool m_canCallForAssistance;
         bool m_isDeadByDefault;
+        bool m_hibernationWakeUp;
         uint32 m_temporaryFactionFlags;                     // used for real faction changes (not auras etc)
 
         uint32 m_originalEntry;
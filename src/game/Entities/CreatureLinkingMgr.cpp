@@ -337,52 +337,27 @@ void CreatureLinkingHolder::AddSlaveToHolder(Creature* pCreature)
     if (!pInfo)
         return;
 
-    if (pInfo->mapId == INVALID_MAP_ID)                     // Guid case, store master->slaves for fast access
-    {
-        HolderMapBounds bounds = m_holderGuidMap.equal_range(pInfo->masterId);
-        for (HolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
-        {
-            if (itr->second.linkingFlag == pInfo->linkingFlag)
-            {
-                itr->second.linkedGuids.push_back(std::make_pair(pCreature->GetDbGuid(), pCreature->GetObjectGuid()));
-                pCreature = nullptr;                           // Store that is was handled
-                break;
-            }
-        }
-
-        // If this is a new flag, insert new entry
-        if (pCreature)
-        {
-            InfoAndGuids tmp;
-            tmp.linkedGuids.push_back(std::make_pair(pCreature->GetDbGuid(), pCreature->GetObjectGuid()));
-            tmp.linkingFlag = pInfo->linkingFlag;
-            tmp.searchRange = 0;
-            m_holderGuidMap.insert(HolderMap::value_type(pInfo->masterId, tmp));
-        }
-        return;
-    }
+    // Guid case, store master->slaves for fast access
+    bool byGuid = pInfo->mapId == INVALID_MAP_ID;
+    uint16 searchRange = byGuid ? 0 : pInfo->searchRange;
+    InfoAndGuidsList& holders = (byGuid ? m_holderGuidMap : m_holderMap)[pInfo->masterId];
 
     // First try to find holder with same flag
-    HolderMapBounds bounds = m_holderMap.equal_range(pInfo->masterId);
-    for (HolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
+    for (InfoAndGuids& holder : holders)
     {
-        if (itr->second.linkingFlag == pInfo->linkingFlag && itr->second.searchRange == pInfo->searchRange)
+        if (holder.linkingFlag == pInfo->linkingFlag && holder.searchRange == searchRange)
         {
-            itr->second.linkedGuids.push_back(std::make_pair(pCreature->GetDbGuid(), pCreature->GetObjectGuid()));
-            pCreature = nullptr;                               // Store that is was handled
-            break;
+            holder.linkedGuids.emplace_back(pCreature->GetDbGuid(), pCreature->GetObjectGuid());
+            return;
         }
     }
 
     // If this is a new flag, insert new entry
-    if (pCreature)
-    {
-        InfoAndGuids tmp;
-        tmp.linkedGuids.push_back(std::make_pair(pCreature->GetDbGuid(), pCreature->GetObjectGuid()));
-        tmp.linkingFlag = pInfo->linkingFlag;
-        tmp.searchRange = pInfo->searchRange;
-        m_holderMap.insert(HolderMap::value_type(pInfo->masterId, tmp));
-    }
+    holders.emplace_back();
+    InfoAndGuids& holder = holders.back();
+    holder.linkedGuids.emplace_back(pCreature->GetDbGuid(), pCreature->GetObjectGuid());
+    holder.linkingFlag = pInfo->linkingFlag;
+    holder.searchRange = searchRange;
 }
 
 // Function to add master-NPCs to the holder
@@ -396,12 +371,11 @@ void CreatureLinkingHolder::AddMasterToHolder(Creature* pCreature)
         return;
 
     // Check, if already stored
-    BossGuidMapBounds bounds = m_masterGuid.equal_range(pCreature->GetEntry());
-    for (BossGuidMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
-        if (itr->second == pCreature->GetObjectGuid())
-            return;                                         // Already added
+    BossGuidList& masters = m_masterGuid[pCreature->GetEntry()];
+    if (std::find(masters.begin(), masters.end(), pCreature->GetObjectGuid()) != masters.end())
+        return;                                             // Already added
 
-    m_masterGuid.insert(BossGuidMap::value_type(pCreature->GetEntry(), pCreature->GetObjectGuid()));
+    masters.push_back(pCreature->GetObjectGuid());
 }
 
 // Function to process actions for linked NPCs
@@ -431,28 +405,10 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
     }
 
     // Process Slaves (by entry)
-    HolderMapBounds bounds = m_holderMap.equal_range(pSource->GetEntry());
-    for (HolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
-    {
-        if (!itr->second.inUse)
-        {
-            itr->second.inUse = true;
-            ProcessSlaveGuidList(eventType, pSource, itr->second.linkingFlag & eventFlagFilter, itr->second.searchRange, itr->second.linkedGuids, pEnemy);
-            itr->second.inUse = false;
-        }
-    }
+    ProcessHolderList(eventType, pSource, eventFlagFilter, m_holderMap, pSource->GetEntry(), pEnemy);
 
     // Process Slaves (by guid)
-    bounds = m_holderGuidMap.equal_range(pSource->GetDbGuid());
-    for (HolderMap::iterator itr = bounds.first; itr != bounds.second; ++itr)
-    {
-        if (!itr->second.inUse)
-        {
-            itr->second.inUse = true;
-            ProcessSlaveGuidList(eventType, pSource, itr->second.linkingFlag & eventFlagFilter, itr->second.searchRange, itr->second.linkedGuids, pEnemy);
-            itr->second.inUse = false;
-        }
-    }
+    ProcessHolderList(eventType, pSource, eventFlagFilter, m_holderGuidMap, pSource->GetDbGuid(), pEnemy);
 
     // Process Master
     if (CreatureLinkingInfo const* pInfo = sCreatureLinkingMgr.GetLinkedTriggerInformation(pSource))
@@ -462,10 +418,9 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
             Creature* pMaster = nullptr;
             if (pInfo->mapId != INVALID_MAP_ID)             // entry case
             { 
-                BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
-                for (BossGuidMap::const_iterator itr = finds.first; itr != finds.second; ++itr)
+                for (ObjectGuid const& masterGuid : GetMasterGuids(pInfo->masterId))
                 {
-                    Creature* master = pSource->GetMap()->GetCreature(itr->second);
+                    Creature* master = pSource->GetMap()->GetCreature(masterGuid);
                     if (master && IsSlaveInRangeOfMaster(pSource, master, pInfo->searchRange))
                     {
                         pMaster = master;
@@ -517,8 +472,37 @@ void CreatureLinkingHolder::DoCreatureLinkingEvent(CreatureLinkingEvent eventTyp
     }
 }
 
+// Helper function, returns the stored masters of an entry
+CreatureLinkingHolder::BossGuidList const& CreatureLinkingHolder::GetMasterGuids(uint32 masterEntry) const
+{
+    static BossGuidList const emptyList;
+    BossGuidMap::const_iterator find = m_masterGuid.find(masterEntry);
+    return find != m_masterGuid.end() ? find->second : emptyList;
+}
+
+// Helper function, to process all groups linked to a master
+void CreatureLinkingHolder::ProcessHolderList(CreatureLinkingEvent eventType, Creature* pSource, uint32 eventFlagFilter, HolderMap& holderMap, uint32 masterId, Unit* pEnemy)
+{
+    HolderMap::iterator find = holderMap.find(masterId);
+    if (find == holderMap.end())
+        return;
+
+    // Slaves spawned by the event can add groups, the deque keeps references valid but the count is read each time
+    InfoAndGuidsList& holders = find->second;
+    for (size_t i = 0; i < holders.size(); ++i)
+    {
+        InfoAndGuids& holder = holders[i];
+        if (!holder.inUse)
+        {
+            holder.inUse = true;
+            ProcessSlaveGuidList(eventType, pSource, holder.linkingFlag & eventFlagFilter, holder.searchRange, holder.linkedGuids, pEnemy);
+            holder.inUse = false;
+        }
+    }
+}
+
 // Helper function, to process a slave list
-void CreatureLinkingHolder::ProcessSlaveGuidList(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, uint16 searchRange, std::list<std::pair<uint32, ObjectGuid>>& slaveGuidList, Unit* pEnemy)
+void CreatureLinkingHolder::ProcessSlaveGuidList(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, uint16 searchRange, std::vector<std::pair<uint32, ObjectGuid>>& slaveGuidList, Unit* pEnemy)
 {
     if (!flag)
         return;
@@ -531,23 +515,25 @@ void CreatureLinkingHolder::ProcessSlaveGuidList(CreatureLinkingEvent eventType,
         postprocessFlag = (postprocessFlag & ~(FLAG_RESPAWN_ON_EVADE | FLAG_RESPAWN_ON_DEATH | FLAG_RESPAWN_ON_RESPAWN));
     }
 
-    for (auto slave_itr = slaveGuidList.begin(); slave_itr != slaveGuidList.end();)
+    // Indexed, slaves respawned here can be appended to the list while it is walked
+    for (size_t i = 0; i < slaveGuidList.size();)
     {
+        std::pair<uint32, ObjectGuid> const slaveGuid = slaveGuidList[i];
         Creature* pSlave;
-        if ((*slave_itr).first)
-            pSlave = pSource->GetMap()->GetCreature((*slave_itr).first);
+        if (slaveGuid.first)
+            pSlave = pSource->GetMap()->GetCreature(slaveGuid.first);
         else
-            pSlave = pSource->GetMap()->GetCreature((*slave_itr).second);
+            pSlave = pSource->GetMap()->GetCreature(slaveGuid.second);
         if ((!pSlave || pSlave->IsCorpse()) && preprocessFlag) // dynguid respawning
-            pSource->GetMap()->GetSpawnManager().RespawnCreature((*slave_itr).first);
+            pSource->GetMap()->GetSpawnManager().RespawnCreature(slaveGuid.first);
         if (!pSlave)
         {
-            // Remove old guid first
-            slave_itr = slaveGuidList.erase(slave_itr);
+            // Remove old guid first, the respawn above may have appended a new one at the end
+            slaveGuidList.erase(slaveGuidList.begin() + i);
             continue;
         }
 
-        ++slave_itr;
+        ++i;
 
         // Ignore Pets
         if (pSlave->IsPet())
@@ -562,6 +548,8 @@ void CreatureLinkingHolder::ProcessSlaveGuidList(CreatureLinkingEvent eventType,
 // Helper function, to process a single slave
 void CreatureLinkingHolder::ProcessSlave(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, Creature* pSlave, Unit* pEnemy)
 {
+    pSlave->WakeFromHibernation();
+
     switch (eventType)
     {
         case LINKING_EVENT_AGGRO:
@@ -743,10 +731,9 @@ bool CreatureLinkingHolder::CanSpawn(uint32 dbGuid, Map* _map, CreatureLinkingIn
     }
 
     // Search for nearby master
-    BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
-    for (BossGuidMap::const_iterator itr = finds.first; itr != finds.second; ++itr)
+    for (ObjectGuid const& masterGuid : GetMasterGuids(pInfo->masterId))
     {
-        Creature* pMaster = _map->GetCreature(itr->second);
+        Creature* pMaster = _map->GetCreature(masterGuid);
         if (pMaster && IsSlaveInRangeOfMaster(pMaster, sx, sy, pInfo->searchRange))
         {
             if (pInfo->linkingFlag & FLAG_CANT_SPAWN_IF_BOSS_DEAD)
@@ -770,10 +757,9 @@ bool CreatureLinkingHolder::TryFollowMaster(Creature* pCreature)
     Creature* pMaster = nullptr;
     if (pInfo->mapId != INVALID_MAP_ID)                     // entry case
     {
-        BossGuidMapBounds finds = m_masterGuid.equal_range(pInfo->masterId);
-        for (BossGuidMap::const_iterator itr = finds.first; itr != finds.second; ++itr)
+        for (ObjectGuid const& masterGuid : GetMasterGuids(pInfo->masterId))
         {
-            pMaster = pCreature->GetMap()->GetCreature(itr->second);
+            pMaster = pCreature->GetMap()->GetCreature(masterGuid);
             if (pMaster && IsSlaveInRangeOfMaster(pCreature, pMaster, pInfo->searchRange))
                 break;
         }
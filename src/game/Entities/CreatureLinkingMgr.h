@@ -38,6 +38,8 @@
 #include "Common.h"
 #include "Entities/ObjectGuid.h"
 
+#include <deque>
+
 class Unit;
 class Creature;
 class Map;
@@ -171,7 +173,7 @@ class CreatureLinkingHolder
         {
             uint16 linkingFlag: 16;
             uint16 searchRange: 16;
-            std::list<std::pair<uint32, ObjectGuid>> linkedGuids;
+            std::vector<std::pair<uint32, ObjectGuid>> linkedGuids;
             bool inUse = false;
         };
         // Structure associated to a master (guid case)
@@ -181,13 +183,18 @@ class CreatureLinkingHolder
             ObjectGuid linkedGuid;
         };
 
-        typedef std::multimap < uint32 /*masterEntryOrGuid*/, InfoAndGuids > HolderMap;
-        typedef std::pair<HolderMap::iterator, HolderMap::iterator> HolderMapBounds;
-        typedef std::multimap < uint32 /*Entry*/, ObjectGuid > BossGuidMap;
-        typedef std::pair<BossGuidMap::const_iterator, BossGuidMap::const_iterator> BossGuidMapBounds;
+        // A deque keeps the groups of a master in place when another group is added while one is processed
+        typedef std::deque<InfoAndGuids> InfoAndGuidsList;
+        typedef std::unordered_map < uint32 /*masterEntryOrGuid*/, InfoAndGuidsList > HolderMap;
+        typedef std::vector<ObjectGuid> BossGuidList;
+        typedef std::unordered_map < uint32 /*Entry*/, BossGuidList > BossGuidMap;
 
         // Helper function, to process a slave list
-        void ProcessSlaveGuidList(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, uint16 searchRange, std::list<std::pair<uint32, ObjectGuid>>& slaveGuidList, Unit* pEnemy);
+        void ProcessSlaveGuidList(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, uint16 searchRange, std::vector<std::pair<uint32, ObjectGuid>>& slaveGuidList, Unit* pEnemy);
+        // Helper function, returns the stored masters of an entry
+        BossGuidList const& GetMasterGuids(uint32 masterEntry) const;
+        // Helper function, to process all groups linked to a master
+        void ProcessHolderList(CreatureLinkingEvent eventType, Creature* pSource, uint32 eventFlagFilter, HolderMap& holderMap, uint32 masterId, Unit* pEnemy);
         // Helper function, to process a single slave
         void ProcessSlave(CreatureLinkingEvent eventType, Creature* pSource, uint32 flag, Creature* pSlave, Unit* pEnemy);
         // Helper function to set following
@@ -26,7 +26,7 @@
 #include "Server/DBCStores.h"
 #include "Spells/Scripts/SpellScript.h"
 
-DynamicObject::DynamicObject() : WorldObject(), m_spellId(0), m_effIndex(), m_radius(0), m_positive(false), m_target(), m_auraScript(nullptr)
+DynamicObject::DynamicObject() : WorldObject(), m_spellId(0), m_effIndex(), m_radius(0), m_positive(false), m_target(), m_scanTimer(0), m_auraScript(nullptr)
 {
     m_objectType |= TYPEMASK_DYNAMICOBJECT;
     m_objectTypeId = TYPEID_DYNAMICOBJECT;
@@ -124,7 +124,7 @@ Unit* DynamicObject::GetCaster() const
     return ObjectAccessor::GetUnit(*this, GetCasterGuid());
 }
 
-void DynamicObject::Update(const uint32 /*diff*/)
+void DynamicObject::Update(const uint32 diff)
 {
     // caster can be not in world at time dynamic object update, but dynamic object not yet deleted in Unit destructor
     Unit* caster = GetCaster();
@@ -139,12 +139,17 @@ void DynamicObject::Update(const uint32 /*diff*/)
     if (m_aliveTime < GetMap()->GetCurrentClockTime())
         deleteThis = true;
 
-    // have radius and work as persistent effect
+    // have radius and work as persistent effect, targets leaving it are handled by their PersistentAreaAura
     if (m_radius)
     {
-        // TODO: make a timer and update this in larger intervals
-        MaNGOS::DynamicObjectUpdater notifier(*this, caster, m_positive);
-        Cell::VisitAllObjects(this, notifier, m_radius);
+        if (m_scanTimer <= diff)
+        {
+            m_scanTimer = DYNAMIC_OBJECT_SCAN_INTERVAL;
+            MaNGOS::DynamicObjectUpdater notifier(*this, caster, m_positive);
+            Cell::VisitAllObjects(this, notifier, m_radius);
+        }
+        else
+            m_scanTimer -= diff;
     }
 
     if (deleteThis)
@@ -34,6 +34,8 @@ enum DynamicObjectType
 struct SpellEntry;
 struct AuraScript;
 
+#define DYNAMIC_OBJECT_SCAN_INTERVAL 250                    // ms between scans for new targets in the radius
+
 class DynamicObject : public WorldObject
 {
     public:
@@ -90,6 +92,7 @@ class DynamicObject : public WorldObject
         SpellTarget m_target;
         int32 m_damage;
         int32 m_basePoints;
+        uint32 m_scanTimer;
 
         AuraScript* m_auraScript;
     private:
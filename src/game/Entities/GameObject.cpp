@@ -89,6 +89,7 @@ GameObject::GameObject() : WorldObject(),
     m_cooldownTime = 0;
 
     m_captureTimer = 0;
+    m_captureOutdoorPvP = nullptr;
 
     m_lootGroupRecipientId = 0;
 
@@ -98,6 +99,7 @@ GameObject::GameObject() : WorldObject(),
     m_despawnTimer = 0;
 
     m_delayedActionTimer = 0;
+    m_updateSleepUntil = 0;
 
     m_goGroup = nullptr;
 }
@@ -284,7 +286,11 @@ bool GameObject::Create(uint32 dbGuid, uint32 guidlow, uint32 name_id, Map* map,
     if (map->IsBattleGroundOrArena())
         ((BattleGroundMap*)map)->GetBG()->HandleGameObjectCreate(this);
     else if (OutdoorPvP* outdoorPvP = sOutdoorPvPMgr.GetScript(GetZoneId()))
+    {
+        if (GetGoType() == GAMEOBJECT_TYPE_CAPTURE_POINT)
+            m_captureOutdoorPvP = outdoorPvP;
         outdoorPvP->HandleGameObjectCreate(this);
+    }
 
     // Notify the map's instance data.
     // Only works if you create the object in it, not if it is moves to that map.
@@ -302,7 +308,25 @@ bool GameObject::Create(uint32 dbGuid, uint32 guidlow, uint32 name_id, Map* map,
     return true;
 }
 
-void GameObject::Update(const uint32 diff)
+bool GameObject::CanDeferUpdate() const
+{
+    if (isActiveObject() || GetOwnerGuid() || GetSpellId())
+        return false;
+
+    return GetGoType() != GAMEOBJECT_TYPE_TRAP;
+}
+
+// ready objects without AI, pending events or delayed action have nothing to do until
+// their respawn timer expires or something interacts with them, which wakes them again
+bool GameObject::CanSleepUpdate() const
+{
+    if (m_lootState != GO_READY || m_AI || m_delayedActionTimer || !m_events.Empty())
+        return false;
+
+    return CanDeferUpdate();
+}
+
+void GameObject::Update(const uint32 p_time)
 {
     if (GetObjectGuid().IsMOTransport())
     {
@@ -310,6 +334,13 @@ void GameObject::Update(const uint32 diff)
         return;
     }
 
+    // objects far from players only run every few ticks with the time of the skipped ones
+    m_deferredUpdateTime += p_time;
+    if (CanDeferUpdate() && DeferLowDetailUpdate())
+        return;
+
+    uint32 const diff = TakeDeferredUpdateTime();
+
     m_events.Update(diff);
 
     switch (m_lootState)
@@ -561,7 +592,9 @@ void GameObject::Update(const uint32 diff)
                     m_captureTimer += diff;
                     if (m_captureTimer >= 5000)
                     {
-                        TickCapturePoint();
+                        // nobody can enter the point while its outdoor pvp zone is empty
+                        if (!m_UniqueUsers.empty() || !m_captureOutdoorPvP || m_captureOutdoorPvP->HasPlayersInZone())
+                            TickCapturePoint();
                         m_captureTimer -= 5000;
                     }
                     break;
@@ -727,6 +760,14 @@ void GameObject::Update(const uint32 diff)
         m_AI->UpdateAI(diff);
 
     WorldObject::Update(diff);
+
+    if (CanSleepUpdate())
+    {
+        time_t const now = sWorld.GetGameTime();
+        m_updateSleepUntil = now + GO_UPDATE_SLEEP_MAX_TIME;
+        if (m_respawnTime > 0 && m_respawnTime < m_updateSleepUntil)
+            m_updateSleepUntil = m_respawnTime;
+    }
 }
 
 void GameObject::Heartbeat()
@@ -1131,6 +1172,8 @@ bool GameObject::isVisibleForInState(Player const* u, WorldObject const* viewPoi
 
 void GameObject::Respawn()
 {
+    WakeUpdate();
+
     if (m_spawnedByDefault && m_respawnTime > 0)
     {
         m_respawnTime = time(nullptr);
@@ -1370,6 +1413,8 @@ void GameObject::SwitchDoorOrButton(bool activate, bool alternative /* = false *
 
 void GameObject::Use(Unit* user, SpellEntry const* spellInfo)
 {
+    WakeUpdate();
+
     // user must be provided
     MANGOS_ASSERT(user || PrintEntryError("GameObject::Use (without user)"));
 
@@ -2020,6 +2065,7 @@ void GameObject::UpdateRotationFields(float rotation2 /*=0.0f*/, float rotation3
 
 void GameObject::SetLootState(LootState state, Unit* user/*= nullptr*/)
 {
+    WakeUpdate();
     m_lootState = state;
     UpdateCollisionState();
 
@@ -2030,6 +2076,7 @@ void GameObject::SetLootState(LootState state, Unit* user/*= nullptr*/)
 
 void GameObject::SetGoState(GOState state)
 {
+    WakeUpdate();
     SetByteValue(GAMEOBJECT_STATE, 0, state);
     UpdateCollisionState();
 }
@@ -2047,6 +2094,10 @@ void GameObject::UpdateCollisionState() const
         return;
 
     m_model->enable(IsCollisionEnabled() ? true : false);
+    GetMap()->DynamicTreeChanged();
+
+    // a door opened or closed, do not hand out corridors found before
+    GetMap()->GetPathCorridorCache().Invalidate();
 }
 
 void GameObject::UpdateModel()
@@ -2740,6 +2791,8 @@ const QuaternionData GameObject::GetLocalRotation() const
 
 void GameObject::ForcedDespawn(uint32 timeMSToDespawn)
 {
+    WakeUpdate();
+
     if (timeMSToDespawn)
     {
         ForcedDespawnDelayGameObjectEvent* pEvent = new ForcedDespawnDelayGameObjectEvent(*this);
@@ -695,6 +695,7 @@ struct GameObjectDisplayInfoEntry;
 struct TransportAnimation;
 class Item;
 class GameObjectGroup;
+class OutdoorPvP;
 
 struct QuaternionData
 {
@@ -711,6 +712,8 @@ struct QuaternionData
 // 5 sec for bobber catch
 #define FISHING_BOBBER_READY_TIME 5
 
+#define GO_UPDATE_SLEEP_MAX_TIME 10                         // in secs, longest time an idle object is left out of updates
+
 #define GO_ANIMPROGRESS_DEFAULT 100                         // in 3.x 0xFF
 
 class GameObject : public WorldObject
@@ -726,7 +729,11 @@ class GameObject : public WorldObject
 
         virtual bool Create(uint32 dbGuid, uint32 guidlow, uint32 name_id, Map* map, float x, float y, float z, float ang,
                     float rotation0 = 0.0f, float rotation1 = 0.0f, float rotation2 = 0.0f, float rotation3 = 0.0f, uint32 animprogress = GO_ANIMPROGRESS_DEFAULT, GOState go_state = GO_STATE_READY);
-        void Update(const uint32 diff) override;
+        void Update(const uint32 p_time) override;
+        bool CanDeferUpdate() const;
+        // idle objects are left out of the map object sweep until their respawn time or any state change
+        bool IsUpdateSleeping(time_t now) const { return m_updateSleepUntil > now && m_events.Empty(); }
+        void WakeUpdate() { m_updateSleepUntil = 0; }
         void Heartbeat() override;
         GameObjectInfo const* GetGOInfo() const;
         GameObjectTemplateAddon const* GetTemplateAddon() const;
@@ -776,6 +783,7 @@ class GameObject : public WorldObject
 
         void SetRespawnTime(time_t respawn)
         {
+            WakeUpdate();
             m_respawnTime = respawn > 0 ? time(nullptr) + respawn : 0;
             m_respawnDelay = respawn > 0 ? uint32(respawn) : 0;
         }
@@ -829,7 +837,7 @@ class GameObject : public WorldObject
 
         void SetActionTarget(ObjectGuid guid) { m_actionTarget = guid; };
         void AddUniqueUse(Player* player);
-        void AddUse() { ++m_useTimes; }
+        void AddUse() { ++m_useTimes; WakeUpdate(); }
         bool IsInUse() const { return m_isInUse; }
         void SetInUse(bool use);
 
@@ -940,6 +948,7 @@ class GameObject : public WorldObject
         uint32      m_captureTimer;                         // (msecs) timer used for capture points
         float       m_captureSlider;                        // capture point slider value in range of [0..100]
         CapturePointState m_captureState;
+        OutdoorPvP* m_captureOutdoorPvP;                    // outdoor pvp script of the capture point zone, if any
 
         GuidSet m_SkillupSet;                               // players that already have skill-up at GO use
 
@@ -970,6 +979,9 @@ class GameObject : public WorldObject
         void TriggerDelayedAction();
 
         uint32 m_delayedActionTimer;                        // used for delayed GO actions
+        time_t m_updateSleepUntil;                          // update sweep skips the object until then, 0 while awake
+
+        bool CanSleepUpdate() const;
 
         ObjectGuid m_actionTarget;                          // used for setting target of Summoning rituals
 
@@ -230,8 +230,8 @@ void PlayerMenu::SendPointOfInterest(uint32 poi_id) const
     int loc_idx = GetMenuSession()->GetSessionDbLocaleIndex();
     if (loc_idx >= 0)
         if (PointOfInterestLocale const* pl = sObjectMgr.GetPointOfInterestLocale(poi_id))
-            if (pl->IconName.size() > size_t(loc_idx) && !pl->IconName[loc_idx].empty())
-                icon_name = pl->IconName[loc_idx];
+            if (char const* iconName = sObjectMgr.GetLocaleString(pl->IconName, loc_idx))
+                icon_name = iconName;
 
     WorldPacket data(SMSG_GOSSIP_POI, (4 + 4 + 4 + 4 + 4 + 10)); // guess size
     data << uint32(poi->flags);
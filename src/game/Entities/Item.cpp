@@ -751,6 +751,11 @@ void Item::UpdateItemSuffixFactor()
 
 void Item::SetState(ItemUpdateState state, Player* forplayer)
 {
+    // every inventory change of a player item passes here
+    if (state != ITEM_UNCHANGED)
+        if (Player* owner = forplayer ? forplayer : (GetOwnerGuid() ? GetOwner() : nullptr))
+            owner->ConditionStateChanged(CONDITION_STATE_ITEMS);
+
     if (uState == ITEM_NEW && state == ITEM_REMOVED)
     {
         // pretend the item never existed
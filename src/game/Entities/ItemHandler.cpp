@@ -26,6 +26,7 @@
 #include "Entities/Item.h"
 #include "Entities/UpdateData.h"
 #include "Chat/Chat.h"
+#include "Server/QueryResponseCache.h"
 
 void WorldSession::HandleSplitItemOpcode(WorldPacket& recv_data)
 {
@@ -290,12 +291,19 @@ void WorldSession::HandleItemQuerySingleOpcode(WorldPacket& recv_data)
     {
         int loc_idx = GetSessionDbLocaleIndex();
 
+        if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_ITEM, item, loc_idx))
+        {
+            SendPacket(*response);
+            return;
+        }
+
         std::string name = pProto->Name1;
         std::string description = pProto->Description;
         sObjectMgr.GetItemLocaleStrings(pProto->ItemId, loc_idx, &name, &description);
 
         // guess size
-        WorldPacket data(SMSG_ITEM_QUERY_SINGLE_RESPONSE, 600);
+        std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_ITEM_QUERY_SINGLE_RESPONSE, 600);
+        WorldPacket& data = *packet;
         data << pProto->ItemId;
         data << pProto->Class;
         data << pProto->SubClass;
@@ -415,6 +423,7 @@ void WorldSession::HandleItemQuerySingleOpcode(WorldPacket& recv_data)
         data << int32(pProto->RequiredDisenchantSkill);
         data << float(pProto->ArmorDamageModifier);
         data << uint32(pProto->Duration);                   // added in 2.4.2.8209, duration (seconds)
+        sQueryResponseCache.Store(QUERY_RESPONSE_ITEM, item, loc_idx, packet);
         SendPacket(data);
     }
     else
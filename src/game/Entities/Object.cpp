@@ -17,6 +17,7 @@
  */
 
 #include "Entities/Object.h"
+#include "Entities/ObjectValuesPool.h"
 #include "Globals/SharedDefines.h"
 #include "WorldPacket.h"
 #include "Server/Opcodes.h"
@@ -55,6 +56,7 @@ Object::Object(): m_updateFlag(0), m_itsNewObject(false), m_dbGuid(0)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateListIndex = CLIENT_UPDATE_LIST_NONE;
     m_loot              = nullptr;
 }
 
@@ -73,17 +75,17 @@ Object::~Object()
         MANGOS_ASSERT(false);
     }
 
-    delete[] m_uint32Values;
+    ObjectValuesPool::Free(m_uint32Values, m_valuesCount);
 
     delete m_loot;
 }
 
 void Object::_InitValues()
 {
-    m_uint32Values = new uint32[ m_valuesCount ];
-    memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
+    m_uint32Values = ObjectValuesPool::Allocate(m_valuesCount);
 
-    m_changedValues.resize(m_valuesCount, false);
+    // items spend most of their life out of world, in bank, mail or auction, see MarkChangedValue
+    m_changedValues.SetCount(m_valuesCount, !isType(TYPEMASK_ITEM));
 
     m_objectUpdated = false;
 }
@@ -213,6 +215,50 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) c
         BuildValuesUpdateBlockForPlayer(data, updateMask, target);
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, ValuesUpdateCache& cache) const
+{
+    uint16 const* flags = nullptr;
+    uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
+
+    for (auto const& entry : cache)
+    {
+        if (entry.visibleFlags == visibleFlag)
+        {
+            if (!entry.block.empty())
+                data.AddUpdateBlock(entry.block);
+            return;
+        }
+    }
+
+    UpdateMask const* visibilityMask = UpdateFields::GetUpdateFieldVisibilityMask(GetTypeId(), visibleFlag);
+    MANGOS_ASSERT(visibilityMask);
+
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+    updateMask.SetMaskedBlocks(m_changedValues, *visibilityMask);
+
+    if (!updateMask.HasData())
+    {
+        cache.push_back({ visibleFlag, ByteBuffer(0) });
+        return;
+    }
+
+    if (!IsValuesUpdateTargetIndependent(updateMask))
+    {
+        BuildValuesUpdateBlockForPlayer(data, updateMask, target);
+        return;
+    }
+
+    cache.push_back({ visibleFlag, ByteBuffer(500) });
+    ByteBuffer& buf = cache.back().block;
+
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetPackGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, &updateMask, target);
+    data.AddUpdateBlock(buf);
+}
+
 void Object::BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const
 {
     UpdateMask updateMask;
@@ -432,357 +478,369 @@ void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* u
 
     MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
 
-    *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+    // every set field is sent as 4 bytes, so the block size is known before writing
+    ByteBufferWriter writer(*data, 1 + updateMask->GetLength() + updateMask->GetSetBitCount() * sizeof(uint32));
+    writer << (uint8)updateMask->GetBlockCount();
+    writer.Append(updateMask->GetMask(), updateMask->GetLength());
 
     // 2 specialized loops for speed optimization in non-unit case
     if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == UNIT_NPC_FLAGS)
             {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+                uint32 appendValue = m_uint32Values[index];
 
-                    if (GetTypeId() == TYPEID_UNIT)
+                if (GetTypeId() == TYPEID_UNIT)
+                {
+                    if (appendValue & UNIT_NPC_FLAG_TRAINER)
                     {
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                        }
+                        if (!((Creature*)this)->IsTrainerOf(target, false))
+                            appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                        }
+                    if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
+                    {
+                        if (target->getClass() != CLASS_HUNTER)
+                            appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
+                    }
 
-                        if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    if (appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
+                    {
+                        QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
                         {
-                            QuestRelationsMapBounds bounds = sObjectMgr.GetCreatureQuestRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanSeeStartQuest(pQuest))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanSeeStartQuest(pQuest))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
+                        }
 
-                            bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
-                            for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        bounds = sObjectMgr.GetCreatureQuestInvolvedRelationsMapBounds(((Creature*)this)->GetEntry());
+                        for (QuestRelationsMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
+                        {
+                            Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
+                            if (target->CanRewardQuest(pQuest, false))
                             {
-                                Quest const* pQuest = sObjectMgr.GetQuestTemplate(itr->second);
-                                if (target->CanRewardQuest(pQuest, false))
-                                {
-                                    appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
-                                    break;
-                                }
+                                appendValue &= ~UNIT_NPC_FLAG_FLIGHTMASTER;
+                                break;
                             }
                         }
                     }
+                }
 
-                    *data << uint32(appendValue);
+                writer << uint32(appendValue);
+            }
+            else if (index == UNIT_FIELD_AURASTATE)
+            {
+                if (IsPerCasterAuraState)
+                {
+                    // IsPerCasterAuraState set if related pet caster aura state set already
+                    if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+                        writer << m_uint32Values[index];
+                    else
+                        writer << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
                 }
-                else if (index == UNIT_FIELD_AURASTATE)
+                else
+                    writer << m_uint32Values[index];
+            }
+            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+            {
+                // convert from float to uint32 and send
+                writer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+            }
+
+            // there are some float values which may be negative or can't get negative due to other checks
+            else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                     (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+            {
+                writer << uint32(m_floatValues[index]);
+            }
+            else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // Fog of War: replace absolute health values with percentages for non-allied units according to settings
+                if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
+                    !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
                 {
-                    if (IsPerCasterAuraState)
+                    switch (index)
                     {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                            *data << m_uint32Values[index];
-                        else
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
+                        case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
+                        case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
                     }
-                    else
-                        *data << m_uint32Values[index];
                 }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+
+                writer << value;
+            }
+            else if (index == UNIT_FIELD_FLAGS)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // For gamemasters in GM mode:
+                if (target->IsGameMaster())
                 {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+                    // Gamemasters should be always able to select units - remove not selectable flag:
+                    value &= ~UNIT_FLAG_UNINTERACTIBLE;
                 }
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+                // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
+                // Client does not send any chat joining attempts by itself when taxi flag is on
+                if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
                 {
-                    *data << uint32(m_floatValues[index]);
+                    if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
+                        if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
+                            if (!session->IsInitialZoneUpdated())
+                                value &= ~UNIT_FLAG_TAXI_FLIGHT;
                 }
-                else if (index == UNIT_FIELD_HEALTH || index == UNIT_FIELD_MAXHEALTH)
-                {
-                    uint32 value = m_uint32Values[index];
 
-                    // Fog of War: replace absolute health values with percentages for non-allied units according to settings
-                    if (!static_cast<const Unit*>(this)->IsFogOfWarVisibleHealth(target) &&
-                        !target->CanSeeSpecialInfoOf(static_cast<const Unit*>(this)))
-                    {
-                        switch (index)
-                        {
-                            case UNIT_FIELD_HEALTH:     value = uint32(ceil((100.0 * value) / m_uint32Values[UNIT_FIELD_MAXHEALTH]));   break;
-                            case UNIT_FIELD_MAXHEALTH:  value = 100;                                                                    break;
-                        }
-                    }
+                writer << value;
+            }
+            // Hide lootable animation for unallowed players
+            // Handle tapped flag
+            // Hide special-info for non empathy-casters,
+            else if (index == UNIT_DYNAMIC_FLAGS)
+            {
+                uint32 dynflagsValue = m_uint32Values[index];
 
-                    *data << value;
-                }
-                else if (index == UNIT_FIELD_FLAGS)
+                // Checking SPELL_AURA_EMPATHY and caster
+                if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && static_cast<const Unit*>(this)->IsAlive())
                 {
-                    uint32 value = m_uint32Values[index];
-
-                    // For gamemasters in GM mode:
-                    if (target->IsGameMaster())
-                    {
-                        // Gamemasters should be always able to select units - remove not selectable flag:
-                        value &= ~UNIT_FLAG_UNINTERACTIBLE;
-                    }
-
-                    // Client bug workaround: Fix for missing chat channels when resuming taxi flight on login
-                    // Client does not send any chat joining attempts by itself when taxi flag is on
-                    if (target == this && (value & UNIT_FLAG_TAXI_FLIGHT))
+                    bool bIsEmpathy = false;
+                    bool bIsCaster = false;
+                    Unit::AuraList const& mAuraEmpathy = static_cast<const Unit*>(this)->GetAurasByType(SPELL_AURA_EMPATHY);
+                    for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
                     {
-                        if (sWorld.getConfig(CONFIG_BOOL_TAXI_FLIGHT_CHAT_FIX))
-                            if (WorldSession* session = static_cast<Player const*>(this)->GetSession())
-                                if (!session->IsInitialZoneUpdated())
-                                    value &= ~UNIT_FLAG_TAXI_FLIGHT;
+                        bIsEmpathy = true;                  // Empathy by aura set
+                        if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
+                            bIsCaster = true;               // target is the caster of an empathy aura
                     }
-
-                    *data << value;
+                    if (bIsEmpathy && !bIsCaster)           // Empathy by aura, but target is not the caster
+                        dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
                 }
+
                 // Hide lootable animation for unallowed players
                 // Handle tapped flag
-                // Hide special-info for non empathy-casters,
-                else if (index == UNIT_DYNAMIC_FLAGS)
+                if (GetTypeId() == TYPEID_UNIT)
                 {
-                    uint32 dynflagsValue = m_uint32Values[index];
+                    Creature* creature = (Creature*)this;
+                    bool setTapFlags = false;
 
-                    // Checking SPELL_AURA_EMPATHY and caster
-                    if (dynflagsValue & UNIT_DYNFLAG_SPECIALINFO && static_cast<const Unit*>(this)->IsAlive())
+                    if (creature->IsAlive())
                     {
-                        bool bIsEmpathy = false;
-                        bool bIsCaster = false;
-                        Unit::AuraList const& mAuraEmpathy = static_cast<const Unit*>(this)->GetAurasByType(SPELL_AURA_EMPATHY);
-                        for (Unit::AuraList::const_iterator itr = mAuraEmpathy.begin(); !bIsCaster && itr != mAuraEmpathy.end(); ++itr)
+                        // creature is alive so, not lootable
+                        dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+
+                        if (creature->IsInCombat())
+                        {
+                            // as creature is in combat we have to manage tap flags
+                            setTapFlags = true;
+                        }
+                        else
                         {
-                            bIsEmpathy = true;              // Empathy by aura set
-                            if ((*itr)->GetCasterGuid() == target->GetObjectGuid())
-                                bIsCaster = true;           // target is the caster of an empathy aura
+                            // creature is not in combat so its not tapped
+                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                            //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                         }
-                        if (bIsEmpathy && !bIsCaster)       // Empathy by aura, but target is not the caster
-                            dynflagsValue &= ~UNIT_DYNFLAG_SPECIALINFO;
                     }
-
-                    // Hide lootable animation for unallowed players
-                    // Handle tapped flag
-                    if (GetTypeId() == TYPEID_UNIT)
+                    else
                     {
-                        Creature* creature = (Creature*)this;
-                        bool setTapFlags = false;
-
-                        if (creature->IsAlive())
+                        // check m_loot flag
+                        if (creature->m_loot && creature->m_loot->CanLoot(target))
                         {
-                            // creature is alive so, not lootable
-                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-
-                            if (creature->IsInCombat())
-                            {
-                                // as creature is in combat we have to manage tap flags
-                                setTapFlags = true;
-                            }
-                            else
-                            {
-                                // creature is not in combat so its not tapped
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is not in combat so not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
+                            // creature is dead and this player can loot it
+                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
+                            //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                         }
                         else
                         {
-                            // check m_loot flag
-                            if (creature->m_loot && creature->m_loot->CanLoot(target))
-                            {
-                                // creature is dead and this player can loot it
-                                dynflagsValue = dynflagsValue | UNIT_DYNFLAG_LOOTABLE;
-                                //sLog.outString(">> %s is lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                            else
-                            {
-                                // creature is dead but this player cannot loot it
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
-                                //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-
-                            // as creature is died we have to manage tap flags
-                            setTapFlags = true;
+                            // creature is dead but this player cannot loot it
+                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_LOOTABLE;
+                            //sLog.outString(">> %s is not lootable for %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
                         }
 
-                        // check tap flags
-                        if (setTapFlags)
-                        {
-                            if (creature->IsTappedBy(target))
-                            {
-                                // creature is in combat or died and tapped by this player
-                                dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                            else
-                            {
-                                // creature is in combat or died but not tapped by this player
-                                dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
-                                //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
-                            }
-                        }
+                        // as creature is died we have to manage tap flags
+                        setTapFlags = true;
                     }
 
-                    if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                    // check tap flags
+                    if (setTapFlags)
                     {
-                        Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
-                        if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
-                            dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                        if (creature->IsTappedBy(target))
+                        {
+                            // creature is in combat or died and tapped by this player
+                            dynflagsValue = dynflagsValue & ~UNIT_DYNFLAG_TAPPED;
+                            //sLog.outString(">> %s is tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                        }
+                        else
+                        {
+                            // creature is in combat or died but not tapped by this player
+                            dynflagsValue = dynflagsValue | UNIT_DYNFLAG_TAPPED;
+                            //sLog.outString(">> %s is not tapped by %s", this->GetGuidStr().c_str(), target->GetGuidStr().c_str());
+                        }
                     }
+                }
 
-                    *data << dynflagsValue;
+                if (GetTypeId() == TYPEID_UNIT || GetTypeId() == TYPEID_PLAYER)
+                {
+                    Unit const* unit = static_cast<const Unit*>(this); // hunters mark effects should only be visible to owners and not all players
+                    if (!unit->HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetObjectGuid()))
+                        dynflagsValue &= ~UNIT_DYNFLAG_TRACK_UNIT;
                 }
-                else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+
+                writer << dynflagsValue;
+            }
+            else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+            {
+                uint32 value = m_uint32Values[index];
+
+                // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
+                if (this != target && GetTypeId() == TYPEID_PLAYER)
                 {
-                    uint32 value = m_uint32Values[index];
+                    Player const* thisPlayer = static_cast<Player const*>(this);
 
-                    // [XFACTION]: Alter faction if detected crossfaction group interaction when updating faction field:
-                    if (this != target && GetTypeId() == TYPEID_PLAYER)
+                    if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
                     {
-                        Player const* thisPlayer = static_cast<Player const*>(this);
+                        const uint32 targetTeam = target->GetTeam();
 
-                        if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP) && target->IsInGroup(thisPlayer))
+                        if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
                         {
-                            const uint32 targetTeam = target->GetTeam();
-
-                            if (thisPlayer->GetTeam() != targetTeam && value == Player::getFactionForRace(thisPlayer->getRace()))
+                            switch (targetTeam)
                             {
-                                switch (targetTeam)
-                                {
-                                    case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
-                                    case HORDE:     value = 1495;   break;  // "Horde Generic"
-                                }
+                                case ALLIANCE:  value = 1054;   break;  // "Alliance Generic"
+                                case HORDE:     value = 1495;   break;  // "Horde Generic"
                             }
                         }
                     }
-
-                    *data << value;
-                }
-                else                                        // Unhandled index, just send
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
                 }
+
+                writer << value;
+            }
+            else                                            // Unhandled index, just send
+            {
+                // send in current format (float as float, uint32 as uint32)
+                writer << m_uint32Values[index];
             }
         }
     }
     else if (isType(TYPEMASK_CORPSE))                       // corpse case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            if (index == CORPSE_FIELD_BYTES_1)
             {
-                if (index == CORPSE_FIELD_BYTES_1)
+                uint32 value = m_uint32Values[index];
+
+                // [XFACTION]: Alter race field if detected crossfaction group interaction:
+                if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
                 {
-                    uint32 value = m_uint32Values[index];
+                    Corpse const* thisCorpse = static_cast<Corpse const*>(this);
+                    ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
+                    Group const* targetGroup = target->GetGroup();
 
-                    // [XFACTION]: Alter race field if detected crossfaction group interaction:
-                    if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_GROUP))
+                    if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
                     {
-                        Corpse const* thisCorpse = static_cast<Corpse const*>(this);
-                        ObjectGuid const& ownerGuid = thisCorpse->GetOwnerGuid();
-                        Group const* targetGroup = target->GetGroup();
+                        const uint8 targetRace = target->getRace();
 
-                        if (ownerGuid != target->GetObjectGuid() && targetGroup && targetGroup->IsMember(ownerGuid))
-                        {
-                            const uint8 targetRace = target->getRace();
-
-                            if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
-                                value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
-                        }
+                        if (Player::TeamForRace(thisCorpse->getRace()) != Player::TeamForRace(targetRace))
+                            value = ((value &~ uint32(0xFF << 8)) | (uint32(targetRace) << 8));
                     }
-
-                    *data << value;
                 }
-                else
-                    *data << m_uint32Values[index];         // other cases
+
+                writer << value;
             }
+            else
+                writer << m_uint32Values[index];             // other cases
         }
     }
     else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
+            // send in current format (float as float, uint32 as uint32)
+            if (index == GAMEOBJECT_DYN_FLAGS)
             {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYN_FLAGS)
-                {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
+                // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+                //      most likely related to "can enter map" and then should be 0 if can not enter
 
-                    if (IsActivateToQuest)
+                if (IsActivateToQuest)
+                {
+                    GameObject const* gameObject = static_cast<GameObject const*>(this);
+                    switch (((GameObject*)this)->GetGoType())
                     {
-                        GameObject const* gameObject = static_cast<GameObject const*>(this);
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                                if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
-                                    *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                else
-                                    *data << uint16(0);
-                                *data << uint16(0);
-                                break;
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(0);
-                                break;
-                            default:
-                                *data << uint32(0);         // unknown, not happen.
-                                break;
-                        }
+                        case GAMEOBJECT_TYPE_QUESTGIVER:
+                            writer << uint16(GO_DYNFLAG_LO_ACTIVATE);
+                            writer << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_CHEST:
+                            if (gameObject->GetLootState() == GO_READY || gameObject->GetLootState() == GO_ACTIVATED)
+                                writer << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            else
+                                writer << uint16(0);
+                            writer << uint16(0);
+                            break;
+                        case GAMEOBJECT_TYPE_GENERIC:
+                        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                        case GAMEOBJECT_TYPE_GOOBER:
+                            writer << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
+                            writer << uint16(0);
+                            break;
+                        default:
+                            writer << uint32(0);             // unknown, not happen.
+                            break;
                     }
-                    else
-                        *data << uint32(0);                 // disable quest object
                 }
                 else
-                    *data << m_uint32Values[index];         // other cases
+                    writer << uint32(0);                     // disable quest object
             }
+            else
+                writer << m_uint32Values[index];             // other cases
         }
     }
     else                                                    // other objects case (no special index checks)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
+        for (uint16 index = updateMask->GetNextSetBit(0); index < m_valuesCount; index = updateMask->GetNextSetBit(index + 1))
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            writer << m_uint32Values[index];
         }
     }
 }
 
+// must match every per target special case of BuildValuesUpdate
+bool Object::IsValuesUpdateTargetIndependent(UpdateMask const& updateMask) const
+{
+    if (isType(TYPEMASK_GAMEOBJECT))
+        return ((GameObject*)this)->IsTransport();
+
+    if (isType(TYPEMASK_UNIT))
+    {
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            return false;
+
+        return !updateMask.GetBit(UNIT_NPC_FLAGS) && !updateMask.GetBit(UNIT_FIELD_AURASTATE) &&
+               !updateMask.GetBit(UNIT_FIELD_HEALTH) && !updateMask.GetBit(UNIT_FIELD_MAXHEALTH) &&
+               !updateMask.GetBit(UNIT_FIELD_FLAGS) && !updateMask.GetBit(UNIT_DYNAMIC_FLAGS) &&
+               !updateMask.GetBit(UNIT_FIELD_FACTIONTEMPLATE);
+    }
+
+    if (isType(TYPEMASK_CORPSE))
+        return !updateMask.GetBit(CORPSE_FIELD_BYTES_1);
+
+    return true;
+}
+
 void Object::ClearUpdateMask(bool remove)
 {
     if (m_uint32Values)
     {
-        for (uint16 index = 0; index < m_valuesCount; ++index)
-            m_changedValues[index] = false;
+        m_changedValues.Clear();
     }
 
     if (m_objectUpdated)
@@ -861,14 +919,12 @@ void Object::_LoadIntoDataField(const char* data, uint32 startOffset, uint32 cou
 
 void Object::MarkUpdateFieldsWithFlagForUpdate(UpdateMask& updateMask, uint16 flag) const
 {
-    uint16 const* flags = UpdateFields::GetUpdateFieldFlagsArray(GetTypeId());
-    MANGOS_ASSERT(flags);
+    UpdateMask const* visibilityMask = UpdateFields::GetUpdateFieldVisibilityMask(GetTypeId(), flag);
+    MANGOS_ASSERT(visibilityMask);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (GetUInt32Value(index) != 0 && (flags[index] & flag))
+    for (uint32 index = visibilityMask->GetNextSetBit(0); index < m_valuesCount; index = visibilityMask->GetNextSetBit(index + 1))
+        if (GetUInt32Value(index) != 0)
             updateMask.SetBit(index);
-    }
 }
 
 void Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
@@ -877,9 +933,10 @@ void Object::_SetUpdateBits(UpdateMask& updateMask, Player* target) const
     uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
     MANGOS_ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (m_changedValues[index] && (flags[index] & visibleFlag))
-            updateMask.SetBit(index);
+    UpdateMask const* visibilityMask = UpdateFields::GetUpdateFieldVisibilityMask(GetTypeId(), visibleFlag);
+    MANGOS_ASSERT(visibilityMask);
+
+    updateMask.SetMaskedBlocks(m_changedValues, *visibilityMask);
 }
 
 void Object::_SetCreateBits(UpdateMask& updateMask, Player* target) const
@@ -888,8 +945,11 @@ void Object::_SetCreateBits(UpdateMask& updateMask, Player* target) const
     uint16 visibleFlag = GetUpdateFieldFlagsForTarget(target, flags);
     MANGOS_ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-        if (GetUInt32Value(index) != 0 && (flags[index] & visibleFlag))
+    UpdateMask const* visibilityMask = UpdateFields::GetUpdateFieldVisibilityMask(GetTypeId(), visibleFlag);
+    MANGOS_ASSERT(visibilityMask);
+
+    for (uint32 index = visibilityMask->GetNextSetBit(0); index < m_valuesCount; index = visibilityMask->GetNextSetBit(index + 1))
+        if (GetUInt32Value(index) != 0)
             updateMask.SetBit(index);
 }
 
@@ -900,7 +960,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -912,7 +972,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -924,8 +984,8 @@ void Object::SetUInt64Value(uint16 index, const uint64& value)
     {
         m_uint32Values[index] = *((uint32*)&value);
         m_uint32Values[index + 1] = *(((uint32*)&value) + 1);
-        m_changedValues[index] = true;
-        m_changedValues[index + 1] = true;
+        MarkChangedValue(index);
+        MarkChangedValue(index + 1);
         MarkForClientUpdate();
     }
 }
@@ -937,7 +997,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -956,7 +1016,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << (offset * 8));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -975,7 +1035,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << (offset * 16));
         m_uint32Values[index] |= uint32(uint32(value) << (offset * 16));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1037,7 +1097,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1051,7 +1111,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1069,7 +1129,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> (offset * 8)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1087,7 +1147,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> (offset * 8)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (offset * 8));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1099,7 +1159,7 @@ void Object::SetShortFlag(uint16 index, bool highpart, uint16 newFlag)
     if (!(uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1111,7 +1171,7 @@ void Object::RemoveShortFlag(uint16 index, bool highpart, uint16 oldFlag)
     if (uint16(m_uint32Values[index] >> (highpart ? 16 : 0)) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << (highpart ? 16 : 0));
-        m_changedValues[index] = true;
+        MarkChangedValue(index);
         MarkForClientUpdate();
     }
 }
@@ -1135,6 +1195,12 @@ bool Object::PrintEntryError(char const* descr) const
 
 void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const
 {
+#ifdef BUILD_PLAYERBOT
+    // never sent, see UpdateData::SendData
+    if (pl->GetPlayerbotAI())
+        return;
+#endif
+
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
     if (iter == update_players.end())
@@ -1147,6 +1213,26 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
     BuildValuesUpdateBlockForPlayer(iter->second, iter->first);
 }
 
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache& cache) const
+{
+#ifdef BUILD_PLAYERBOT
+    // never sent, see UpdateData::SendData
+    if (pl->GetPlayerbotAI())
+        return;
+#endif
+
+    UpdateDataMapType::iterator iter = update_players.find(pl);
+
+    if (iter == update_players.end())
+    {
+        std::pair<UpdateDataMapType::iterator, bool> p = update_players.insert(UpdateDataMapType::value_type(pl, UpdateData()));
+        MANGOS_ASSERT(p.second);
+        iter = p.first;
+    }
+
+    BuildValuesUpdateBlockForPlayer(iter->second, iter->first, cache);
+}
+
 void Object::AddToClientUpdateList()
 {
     sLog.outError("Unexpected call of Object::AddToClientUpdateList for object (TypeId: %u Update fields: %u)", GetTypeId(), m_valuesCount);
@@ -1179,7 +1265,7 @@ void Object::MarkForClientUpdate()
 
 void Object::ForceValuesUpdateAtIndex(uint16 index)
 {
-    m_changedValues[index] = true;
+    MarkChangedValue(index);
     if (m_inWorld && !m_objectUpdated)
     {
         AddToClientUpdateList();
@@ -1189,10 +1275,18 @@ void Object::ForceValuesUpdateAtIndex(uint16 index)
 
 WorldObject::WorldObject() :
     m_transportInfo(nullptr), m_isOnEventNotified(false),
-    m_visibilityData(this), m_currMap(nullptr),
+    m_visibilityData(this), m_deferredUpdateTime(0), m_deferredUpdateTicks(0), m_currMap(nullptr),
     m_mapId(0), m_InstanceId(0), m_phaseMask(1),
     m_isActiveObject(false), m_debugFlags(0), m_transport(nullptr), m_castCounter(0)
 {
+    m_cellPositionIndex = nullptr;
+    m_cellPositionSlot = 0;
+}
+
+WorldObject::~WorldObject()
+{
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->RemoveObject(this);
 }
 
 void WorldObject::CleanupsBeforeDelete()
@@ -1226,6 +1320,9 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
 
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, orientation);
+
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->Relocate(this);
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1236,6 +1333,23 @@ void WorldObject::Relocate(float x, float y, float z)
 
     if (isType(TYPEMASK_UNIT))
         m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->Relocate(this);
+}
+
+bool WorldObject::DeferLowDetailUpdate()
+{
+    if (!GetMap()->IsLowDetailArea(GetPositionX(), GetPositionY()))
+        return false;
+
+    return ++m_deferredUpdateTicks < sWorld.getConfig(CONFIG_UINT32_VISIBILITY_LOW_DETAIL_UPDATE_TICKS);
+}
+
+void WorldObject::UpdateCellPositionIndex()
+{
+    if (m_cellPositionIndex)
+        m_cellPositionIndex->Relocate(this);
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1946,6 +2060,16 @@ void WorldObject::SendMessageToSetExcept(WorldPacket const& data, Player const*
     // if object is in world, map for it already created!
     if (IsInWorld())
     {
+        if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS))
+        {
+            SharedWorldPacket sharedData(data);
+            for (ObjectGuid guid : m_clientGUIDsIAmAt)
+                if (Player* player = GetMap()->GetPlayer(guid))
+                    if (player != skipped_receiver)
+                        player->GetSession()->SendPacket(sharedData);
+            return;
+        }
+
         MaNGOS::MessageDelivererExcept notifier(data, skipped_receiver);
         Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
     }
@@ -1954,9 +2078,44 @@ void WorldObject::SendMessageToSetExcept(WorldPacket const& data, Player const*
 void WorldObject::SendMessageToAllWhoSeeMe(WorldPacket const& data, bool /*self*/) const
 {
     if (IsInWorld())
+    {
+        SharedWorldPacket sharedData(data);
         for (ObjectGuid guid : m_clientGUIDsIAmAt)
             if (Player* player = GetMap()->GetPlayer(guid))
-                player->GetSession()->SendPacket(data);
+                player->GetSession()->SendPacket(sharedData);
+    }
+}
+
+void WorldObject::SendCombatLogToSet(WorldPacket& data) const
+{
+    if (IsInWorld() && sWorld.getConfig(CONFIG_BOOL_NETWORK_AGGREGATE_COMBAT_LOG))
+    {
+        GetMap()->QueueCombatLog(this, std::move(data));
+        return;
+    }
+
+    if (float range = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_COMBAT_LOG_RANGE))
+        SendMessageToSetInRange(data, range, true);
+    else
+        SendMessageToSet(data, true);
+}
+
+void WorldObject::SendMonsterMoveToAllWhoSeeMe(WorldPacket const& data) const
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_NETWORK_BATCH_MONSTER_MOVES))
+    {
+        SendMessageToAllWhoSeeMe(data, true);
+        return;
+    }
+
+    if (IsInWorld())
+        for (ObjectGuid guid : m_clientGUIDsIAmAt)
+            if (Player* player = GetMap()->GetPlayer(guid))
+                player->GetSession()->QueueMonsterMove(data);
+
+    // own moves are not held, the client of a player has to see them in order with its other packets
+    if (GetTypeId() == TYPEID_PLAYER)
+        static_cast<Player const*>(this)->GetSession()->SendPacket(data);
 }
 
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid) const
@@ -2505,12 +2664,13 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateCache i_valuesCache;                        // observers with the same visibility get the same block
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
         // with new camera system when player's camera too far from player, camera wouldn't receive packets and changes from player
         if (i_object.isType(TYPEMASK_PLAYER))
-            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas);
+            i_object.BuildUpdateDataForPlayer((Player*)&i_object, i_updateDatas, i_valuesCache);
     }
 
     void Visit(CameraMapType& m)
@@ -2519,7 +2679,7 @@ struct WorldObjectChangeAccumulator
         {
             Player* owner = iter.getSource()->GetOwner();
             if (owner != &i_object && owner->HasAtClient(&i_object))
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, i_valuesCache);
         }
     }
 
@@ -24,6 +24,7 @@
 #include "ByteBuffer.h"
 #include "Entities/UpdateFields.h"
 #include "Entities/UpdateData.h"
+#include "Entities/UpdateMask.h"
 #include "Entities/ObjectGuid.h"
 #include "Entities/EntitiesMgr.h"
 #include "Globals/SharedDefines.h"
@@ -102,9 +103,9 @@ class Player;
 class Unit;
 class Group;
 class Map;
-class UpdateMask;
 class InstanceData;
 class TerrainInfo;
+class CellPositionIndex;
 class TransportInfo;
 struct MangosStringLocale;
 class Loot;
@@ -116,6 +117,14 @@ class GenericTransport;
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
+// values block of one object already serialized for a visibility flag set, reused by all viewers sharing that set
+struct ValuesUpdateCacheEntry
+{
+    uint16 visibleFlags;
+    ByteBuffer block;                                       // empty if nothing visible changed
+};
+typedef std::vector<ValuesUpdateCacheEntry> ValuesUpdateCache;
+
 // Spell cooldown flags sent in SMSG_SPELL_COOLDOWN
 enum SpellCooldownFlags
 {
@@ -184,6 +193,17 @@ class CooldownData
             return false;
         }
 
+        // return false if permanent, otherwise the first time at which the container has to look at this cooldown again
+        bool GetNextExpireTime(TimePoint& expireTime) const
+        {
+            if (m_typePermanent)
+                return false;
+
+            // the spell cooldown is only removed once the category cooldown is gone too
+            expireTime = m_category ? m_catExpireTime : m_expireTime;
+            return true;
+        }
+
         bool IsPermanent() const { return m_typePermanent; }
         uint32 GetItemId() const { return m_itemId; }
         uint32 GetSpellId() const { return m_spellId; }
@@ -212,6 +232,11 @@ class CooldownContainer
 
         void Update(TimePoint const& now)
         {
+            // nothing can expire before the earliest known expire time
+            if (now < m_nextExpireTime)
+                return;
+
+            m_nextExpireTime = TimePoint::max();
             auto spellCDItr = m_spellIdMap.begin();
             while (spellCDItr != m_spellIdMap.end())
             {
@@ -224,7 +249,9 @@ class CooldownContainer
                     {
                         m_categoryMap.erase(cd->m_category);
                         cd->m_category = 0;
+                        ++m_version;
                     }
+                    UpdateNextExpireTime(*cd);
                     ++spellCDItr;
                 }
             }
@@ -233,6 +260,7 @@ class CooldownContainer
         bool AddCooldown(TimePoint clockNow, uint32 spellId, uint32 duration, uint32 spellCategory = 0, uint32 categoryDuration = 0, uint32 itemId = 0, bool onHold = false)
         {
             RemoveBySpellId(spellId);
+            ++m_version;
             auto resultItr = m_spellIdMap.emplace(spellId, std::move(std::unique_ptr<CooldownData>(new CooldownData(clockNow, spellId, duration, spellCategory, categoryDuration, itemId, onHold))));
             // do not overwrite one permanent category cooldown with another permanent category cooldown
             if (resultItr.second && spellCategory && categoryDuration)
@@ -246,6 +274,7 @@ class CooldownContainer
                         catItr->second->SetCatCDExpireTime(std::chrono::milliseconds(categoryDuration) + clockNow);
                         catItr->second->m_typePermanent = false;
                         resultItr.first->second->m_category = 0;
+                        UpdateNextExpireTime(*catItr->second);
                     }
                     else
                         m_categoryMap.emplace(spellCategory, resultItr.first);
@@ -254,6 +283,9 @@ class CooldownContainer
                     resultItr.first->second->m_category = 0;
             }
 
+            if (resultItr.second)
+                UpdateNextExpireTime(*resultItr.first->second);
+
             return resultItr.second;
         }
 
@@ -270,6 +302,7 @@ class CooldownContainer
                         m_categoryMap.erase(catCDItr);
                 }
                 m_spellIdMap.erase(spellCDItr);
+                ++m_version;
             }
         }
 
@@ -280,6 +313,7 @@ class CooldownContainer
             {
                 spellCDItr->second->second->m_category = 0;
                 m_categoryMap.erase(spellCDItr);
+                ++m_version;
             }
         }
 
@@ -292,6 +326,7 @@ class CooldownContainer
                 if (catCDItr != m_categoryMap.end())
                     m_categoryMap.erase(catCDItr);
             }
+            ++m_version;
             return m_spellIdMap.erase(spellCDItr);
         }
 
@@ -303,16 +338,27 @@ class CooldownContainer
             return itr != m_categoryMap.end() ? itr->second : end();
         }
 
-        void clear() { m_spellIdMap.clear(); m_categoryMap.clear(); }
+        void clear() { m_spellIdMap.clear(); m_categoryMap.clear(); m_nextExpireTime = TimePoint::max(); ++m_version; }
 
         ConstIterator begin() const { return m_spellIdMap.begin(); }
         ConstIterator end() const { return m_spellIdMap.end(); }
         bool IsEmpty() const { return m_spellIdMap.empty(); }
         size_t size() const { return m_spellIdMap.size(); }
+        // changes on every modification, lets saves skip an unchanged container
+        uint32 GetVersion() const { return m_version; }
 
     private:
+        void UpdateNextExpireTime(CooldownData const& cdData)
+        {
+            TimePoint expireTime;
+            if (cdData.GetNextExpireTime(expireTime) && expireTime < m_nextExpireTime)
+                m_nextExpireTime = expireTime;
+        }
+
         spellIdMap m_spellIdMap;
         categoryMap m_categoryMap;
+        TimePoint m_nextExpireTime = TimePoint::max();      // removals are not tracked, it may be earlier than needed
+        uint32 m_version = 0;
 };
 
 struct Position
@@ -370,6 +416,8 @@ class WorldUpdateCounter
         uint32 m_tmStart;
 };
 
+#define CLIENT_UPDATE_LIST_NONE 0xFFFFFFFF                  // object is not in any map client update list
+
 class Object
 {
     public:
@@ -391,6 +439,9 @@ class Object
             // if we remove from world then sending changes not required
             ClearUpdateMask(true);
             m_inWorld = false;
+
+            if (isType(TYPEMASK_ITEM) && m_uint32Values)
+                m_changedValues.SetCount(m_valuesCount, false);
         }
 
         ObjectGuid const& GetObjectGuid() const { return GetGuidValue(OBJECT_FIELD_GUID); }
@@ -424,6 +475,10 @@ class Object
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
+        // slot in the map client update list, maintained by Map::AddUpdateObject/RemoveUpdateObject
+        uint32 GetClientUpdateListIndex() const { return m_clientUpdateListIndex; }
+        void SetClientUpdateListIndex(uint32 index) { m_clientUpdateListIndex = index; }
+
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target) const;
         void BuildValuesUpdateBlockForPlayerWithFlags(UpdateData& data, Player* target, UpdateFieldFlags flags) const;
         void BuildValuesUpdateBlockForPlayer(UpdateData& data, UpdateMask& updateMask, Player* target) const;
@@ -637,9 +692,19 @@ class Object
         void _SetUpdateBits(UpdateMask& updateMask, Player* target) const;
         void _SetCreateBits(UpdateMask& updateMask, Player* target) const;
 
+        // out of world changes of an object without a changed values mask are carried by the create block sent when it enters the world
+        void MarkChangedValue(uint16 index)
+        {
+            if (m_inWorld || m_changedValues.IsAllocated())
+                m_changedValues.SetBit(index);
+        }
+
         void BuildMovementUpdate(ByteBuffer* data, uint8 updateFlags) const;
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
+        bool IsValuesUpdateTargetIndependent(UpdateMask const& updateMask) const;
         void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateCache& cache) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData& data, Player* target, ValuesUpdateCache& cache) const;
 
         uint16 m_objectType;
 
@@ -653,13 +718,14 @@ class Object
             float*  m_floatValues;
         };
 
-        std::vector<bool> m_changedValues;
+        UpdateMask m_changedValues;
 
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
 
     private:
+        uint32 m_clientUpdateListIndex;
         bool m_inWorld;
         bool m_itsNewObject;
 
@@ -893,9 +959,10 @@ inline ByteBuffer& operator>> (ByteBuffer& buf, MovementInfo& mi)
 class WorldObject : public Object
 {
         friend struct WorldObjectChangeAccumulator;
+        friend class CellPositionIndex;
 
     public:
-        virtual ~WorldObject() {}
+        virtual ~WorldObject();
 
         virtual void Update(const uint32 /*diff*/);
         virtual void Heartbeat() {}
@@ -909,6 +976,8 @@ class WorldObject : public Object
 
         void Relocate(float x, float y, float z, float orientation);
         void Relocate(float x, float y, float z);
+        // combat reach or bounding radius changed, keeps radius searches of the cell exact
+        void UpdateCellPositionIndex();
 
         void SetOrientation(float orientation);
 
@@ -1075,6 +1144,11 @@ class WorldObject : public Object
         virtual void SendMessageToSetInRange(WorldPacket const& data, float dist, bool self) const;
         void SendMessageToSetExcept(WorldPacket const& data, Player const* skipped_receiver) const;
         virtual void SendMessageToAllWhoSeeMe(WorldPacket const& data, bool self) const;
+        // damage, heal, miss and energize logs, limited to Visibility.CombatLogRange and held until the end of the
+        // map update when Network.AggregateCombatLog is on; data is left empty
+        void SendCombatLogToSet(WorldPacket& data) const;
+        // spline packets, collected per client until the end of the map update when Network.BatchMonsterMoves is on
+        void SendMonsterMoveToAllWhoSeeMe(WorldPacket const& data) const;
 
         void MonsterSay(const char* text, uint32 language, Unit const* target = nullptr) const;
         void MonsterYell(const char* text, uint32 language, Unit const* target = nullptr) const;
@@ -1195,6 +1269,7 @@ class WorldObject : public Object
         void AddClientIAmAt(Player const* player);
         void RemoveClientIAmAt(Player const* player);
         GuidSet& GetClientGuidsIAmAt() { return m_clientGUIDsIAmAt; }
+        GuidSet const& GetClientGuidsIAmAt() const { return m_clientGUIDsIAmAt; }
 
         // Event handler
         EventProcessor m_events;
@@ -1237,6 +1312,19 @@ class WorldObject : public Object
         VisibilityData m_visibilityData;
 
         ShortTimeTracker m_heartBeatTimer;
+
+        // reduced rate updates of objects away from players, the skipped time is applied at the next real update
+        bool DeferLowDetailUpdate();
+        uint32 TakeDeferredUpdateTime()
+        {
+            uint32 time = m_deferredUpdateTime;
+            m_deferredUpdateTime = 0;
+            m_deferredUpdateTicks = 0;
+            return time;
+        }
+
+        uint32 m_deferredUpdateTime;
+        uint32 m_deferredUpdateTicks;
     private:
         Map* m_currMap;                                     // current object's Map location
 
@@ -1245,6 +1333,8 @@ class WorldObject : public Object
         uint32 m_phaseMask;                                 // in area phase state
 
         Position m_position;
+        CellPositionIndex* m_cellPositionIndex;             // position index of the cell holding the unit, see Grid
+        uint32 m_cellPositionSlot;
         ViewPoint m_viewPoint;
         bool m_isActiveObject;
         uint64 m_debugFlags;
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/ObjectValuesPool.h"
+#include "Entities/UpdateFields.h"
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    // arrays per slab
+    uint32 const SLAB_SIZE = 256;
+
+    class SizeClass
+    {
+        public:
+            explicit SizeClass(uint16 count) : m_count(count), m_free(nullptr) {}
+
+            uint16 GetCount() const { return m_count; }
+
+            uint32* Allocate()
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                if (!m_free)
+                    AddSlab();
+
+                uint32* values = m_free;
+                std::memcpy(&m_free, values, sizeof(m_free));
+                return values;
+            }
+
+            void Free(uint32* values)
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                std::memcpy(values, &m_free, sizeof(m_free));
+                m_free = values;
+            }
+
+        private:
+            void AddSlab()
+            {
+                m_slabs.emplace_back(new uint32[m_count * SLAB_SIZE]);
+                uint32* slab = m_slabs.back().get();
+
+                // link the new arrays into the free list, the first one is handed out first
+                for (uint32 i = SLAB_SIZE; i > 0; --i)
+                {
+                    uint32* values = slab + (i - 1) * m_count;
+                    std::memcpy(values, &m_free, sizeof(m_free));
+                    m_free = values;
+                }
+            }
+
+            uint16 const m_count;
+            std::mutex m_lock;
+            uint32* m_free;                                 ///< free arrays, each starts with the pointer to the next one
+            std::vector<std::unique_ptr<uint32[]>> m_slabs;
+    };
+
+    SizeClass* GetSizeClass(uint16 count)
+    {
+        // never destroyed, items may still be freed during static destruction
+        static SizeClass* items = new SizeClass(ITEM_END);
+        static SizeClass* containers = new SizeClass(CONTAINER_END);
+
+        switch (count)
+        {
+            case ITEM_END: return items;
+            case CONTAINER_END: return containers;
+            default: return nullptr;
+        }
+    }
+}
+
+namespace ObjectValuesPool
+{
+    uint32* Allocate(uint16 count)
+    {
+        uint32* values;
+        if (SizeClass* sizeClass = GetSizeClass(count))
+            values = sizeClass->Allocate();
+        else
+            values = new uint32[count];
+
+        std::memset(values, 0, count * sizeof(uint32));
+        return values;
+    }
+
+    void Free(uint32* values, uint16 count)
+    {
+        if (!values)
+            return;
+
+        if (SizeClass* sizeClass = GetSizeClass(count))
+            sizeClass->Free(values);
+        else
+            delete[] values;
+    }
+}
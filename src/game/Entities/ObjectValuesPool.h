@@ -0,0 +1,38 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OBJECT_VALUES_POOL_H
+#define MANGOS_OBJECT_VALUES_POOL_H
+
+#include "Common.h"
+
+/**
+ * Storage of Object::m_uint32Values
+ *
+ * Item and bag value arrays come from slabs shared by all owners and are reused after the item is deleted,
+ * as a player login or logout creates and deletes a hundred of them. Slabs are never given back.
+ * Other sizes use the default allocator.
+ */
+namespace ObjectValuesPool
+{
+    /// Zero filled array of count values
+    uint32* Allocate(uint16 count);
+    void Free(uint32* values, uint16 count);
+}
+
+#endif
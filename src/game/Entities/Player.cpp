@@ -47,6 +47,7 @@
 #include "Entities/Pet.h"
 #include "Util.h"
 #include "Entities/Transports.h"
+#include "Entities/PlayerSaveScheduler.h"
 #include "Weather/Weather.h"
 #include "BattleGround/BattleGround.h"
 #include "BattleGround/BattleGroundMgr.h"
@@ -64,6 +65,7 @@
 #include "World/WorldStateDefines.h"
 #include "World/WorldState.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/CharacterLoginCache.h"
 
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
@@ -514,6 +516,11 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     // randomize first save time in range [CONFIG_UINT32_INTERVAL_SAVE] around [CONFIG_UINT32_INTERVAL_SAVE]
     // this must help in case next save after mass player load after server startup
     m_nextSave = urand(m_nextSave / 2, m_nextSave * 3 / 2);
+    m_saveDelay = 0;
+    m_valuableSave = false;
+
+    memset(m_conditionStateVersions, 0, sizeof(m_conditionStateVersions));
+    m_itemEntryIndexVersion = UINT32_MAX;
 
     clearResurrectRequestData();
 
@@ -555,6 +562,8 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     m_DailyQuestChanged = false;
     m_WeeklyQuestChanged = false;
     m_MonthlyQuestChanged = false;
+    m_savedCooldownVersion = std::numeric_limits<uint32>::max();   // cooldowns added at aura loading are not in the DB yet
+    m_enteredInstancesChanged = false;
 
     m_lastLiquid = nullptr;
 
@@ -596,10 +605,15 @@ Player::Player(WorldSession* session): Unit(), m_taxiTracker(*this), m_mover(thi
     m_mailsUpdated = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
+    m_mailLoadState = PLAYER_MAIL_NOT_LOADED;
+    m_mailQueryId = 0;
+    m_mailItemsLoading = false;
+    m_mailUsedTime = 0;
 
     m_resetTalentsCost = 0;
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
+    m_lastCraftedStack = { 0, 0 };
 
     for (unsigned char& m_forced_speed_change : m_forced_speed_changes)
         m_forced_speed_change = 0;
@@ -1399,6 +1413,14 @@ void Player::Update(const uint32 diff)
         m_nextMailDelivereTime = 0;
     }
 
+    // Unused mailbox
+    if (m_mailLoadState == PLAYER_MAIL_LOADED && !m_mailItemsLoading)
+    {
+        uint32 unloadDelay = sWorld.getConfig(CONFIG_UINT32_MAIL_UNLOAD_DELAY);
+        if (unloadDelay && m_mailUsedTime + unloadDelay <= time(nullptr))
+            UnloadMails();
+    }
+
     // Update cinematic location
     if (m_cinematicMgr)
     {
@@ -1428,8 +1450,6 @@ void Player::Update(const uint32 diff)
 
     UpdatePvPContestedFlagTimer(diff);
 
-    UpdateDuelFlag(now);
-
     CheckDuelDistance(now);
 
     UpdateAfkReport(now);
@@ -1533,9 +1553,20 @@ void Player::Update(const uint32 diff)
     {
         if (diff >= m_nextSave)
         {
-            // m_nextSave reseted in SaveToDB call
-            SaveToDB();
-            DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            // valuable changes and saves already refused for a whole interval do not wait for a token
+            m_saveDelay += diff - m_nextSave;
+            bool force = m_valuableSave || m_saveDelay >= sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+            if (sPlayerSaveScheduler.TryAcquire(force))
+            {
+                // m_nextSave reseted in SaveToDB call
+                SaveToDB();
+                DETAIL_LOG("Player '%s' (GUID: %u) saved", GetName(), GetGUIDLow());
+            }
+            else
+            {
+                m_saveDelay += PLAYER_SAVE_RETRY_DELAY;
+                m_nextSave = PLAYER_SAVE_RETRY_DELAY;
+            }
         }
         else
             m_nextSave -= diff;
@@ -2704,6 +2735,8 @@ void Player::GiveLevel(uint32 level)
     if (level == GetLevel())
         return;
 
+    ConditionStateChanged(CONDITION_STATE_LEVEL);
+
     uint32 plClass = getClass();
 
     PlayerLevelInfo info;
@@ -3186,6 +3219,8 @@ static inline bool IsUnlearnSpellsPacketNeededForSpell(uint32 spellId)
 
 bool Player::addSpell(uint32 spell_id, bool active, bool learning, bool dependent, bool disabled)
 {
+    ConditionStateChanged(CONDITION_STATE_SPELLS);
+
     SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(spell_id);
     if (!spellInfo)
     {
@@ -3555,6 +3590,8 @@ void Player::learnSpell(uint32 spell_id, bool dependent, bool talent)
 
 void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank, bool sendUpdate)
 {
+    ConditionStateChanged(CONDITION_STATE_SPELLS);
+
     PlayerSpellMap::iterator itr = m_spells.find(spell_id);
     if (itr == m_spells.end())
         return;
@@ -3786,6 +3823,11 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 
 void Player::_SaveSpellCooldowns()
 {
+    if (m_cooldownMap.GetVersion() == m_savedCooldownVersion)
+        return;
+
+    m_savedCooldownVersion = m_cooldownMap.GetVersion();
+
     static SqlStatementID deleteSpellCooldown;
 
     // delete all old cooldown
@@ -3794,10 +3836,12 @@ void Player::_SaveSpellCooldowns()
 
     static SqlStatementID insertSpellCooldown;
 
+    // expired cooldowns are only swept at the next world object update
+    TimePoint now = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     for (auto& cdItr : m_cooldownMap)
     {
         auto& cdData = cdItr.second;
-        if (!cdData->IsPermanent())
+        if (!cdData->IsPermanent() && (!cdData->IsSpellCDExpired(now) || !cdData->IsCatCDExpired(now)))
         {
             TimePoint sTime = TimePoint::min();
             TimePoint cTime = TimePoint::min();
@@ -3906,6 +3950,26 @@ bool Player::resetTalents(bool no_cost)
     return true;
 }
 
+void Player::UnloadMails()
+{
+    if (m_mailsUpdated)
+    {
+        CharacterDatabase.BeginTransaction();
+        _SaveMail();
+        CharacterDatabase.CommitTransaction();
+    }
+
+    for (PlayerMails::const_iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
+        delete *itr;
+    m_mail.clear();
+
+    for (ItemMap::const_iterator iter = mMitems.begin(); iter != mMitems.end(); ++iter)
+        delete iter->second;
+    mMitems.clear();
+
+    m_mailLoadState = PLAYER_MAIL_NOT_LOADED;
+}
+
 Mail* Player::GetMail(uint32 id)
 {
     for (PlayerMails::iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
@@ -4123,6 +4187,8 @@ TrainerSpellState Player::GetTrainerSpellState(TrainerSpell const* trainer_spell
  */
 void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRealmChars, bool deleteFinally)
 {
+    sCharacterLoginCache.Invalidate(playerguid);
+
     // for nonexistent account avoid update realm
     if (accountId == 0)
         updateRealmChars = false;
@@ -4136,6 +4202,8 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
 
     uint32 lowguid = playerguid.GetCounter();
 
+    sObjectMgr.RemovePlayerDataCache(lowguid);
+
     // convert corpse to bones if exist (to prevent exiting Corpse in World without DB entry)
     // bones will be deleted by corpse/bones deleting thread shortly
     sObjectAccessor.ConvertCorpseForPlayer(playerguid);
@@ -4265,7 +4333,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
             QueryResult* resultFriend = CharacterDatabase.PQuery("SELECT DISTINCT guid FROM character_social WHERE friend = '%u'", lowguid);
 
             // NOW we can finally clear other DB data related to character
-            CharacterDatabase.BeginTransaction();
+            CharacterDatabase.BeginTransaction(lowguid);
             if (resultPets)
             {
                 do
@@ -6925,17 +6993,11 @@ uint32 Player::GetZoneIdFromDB(ObjectGuid guid)
 
 uint32 Player::GetLevelFromDB(ObjectGuid guid)
 {
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT level FROM characters WHERE guid='%u'", lowguid);
-    if (!result)
+    PlayerDataCache data;
+    if (!sObjectMgr.GetPlayerDataCache(guid, data))
         return 0;
 
-    Field* fields = result->Fetch();
-    uint32 level = fields[0].GetUInt32();
-    delete result;
-
-    return level;
+    return data.level;
 }
 
 void Player::UpdateArea(uint32 newArea)
@@ -7077,9 +7139,12 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea, bool force)
 // If players are too far way of duel flag... then player loose the duel
 void Player::CheckDuelDistance(time_t currTime)
 {
-    if (!duel)
+    // standing players can only leave the bounds by the flee timer
+    if (!duel || (!duel->moved && !duel->outOfBound))
         return;
 
+    duel->moved = false;
+
     GameObject* obj = GetMap()->GetGameObject(GetGuidValue(PLAYER_DUEL_ARBITER));
     if (!obj)
     {
@@ -7226,6 +7291,8 @@ void Player::_ApplyItemBonuses(ItemPrototype const* proto, uint8 slot, bool appl
     if (slot >= INVENTORY_SLOT_BAG_END || !proto)
         return;
 
+    StatModifierBatch statBatch(*this);
+
     for (uint32 i = 0; i < MAX_ITEM_PROTO_STATS; ++i)
     {
         float val = float(proto->ItemStat[i].ItemStatValue);
@@ -8530,27 +8597,53 @@ InventoryResult Player::CanUnequipItems(uint32 item, uint32 count) const
     return res;
 }
 
-uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
+void Player::RebuildItemEntryIndex() const
 {
-    uint32 count = 0;
-    for (int i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-    {
-        Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-        if (pItem && pItem != skipItem &&  pItem->GetEntry() == item)
-            count += pItem->GetCount();
-    }
-    for (int i = KEYRING_SLOT_START; i < KEYRING_SLOT_END; ++i)
+    for (auto& itr : m_itemEntryIndex)
+        itr.second.clear();
+
+    auto addSlots = [this](uint8 begin, uint8 end, bool inBank)
     {
-        Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-        if (pItem && pItem != skipItem && pItem->GetEntry() == item)
-            count += pItem->GetCount();
-    }
-    for (int i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
+        for (uint8 i = begin; i < end; ++i)
+            if (Item* pItem = m_items[i])
+                m_itemEntryIndex[pItem->GetEntry()].push_back({ pItem, inBank });
+    };
+    auto addBags = [this](uint8 begin, uint8 end, bool inBank)
     {
-        Bag* pBag = (Bag*)GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-        if (pBag)
-            count += pBag->GetItemCount(item, skipItem);
-    }
+        for (uint8 i = begin; i < end; ++i)
+            if (Bag* pBag = (Bag*)m_items[i])
+                for (uint32 j = 0; j < pBag->GetBagSize(); ++j)
+                    if (Item* pItem = pBag->GetItemByPos(uint8(j)))
+                        m_itemEntryIndex[pItem->GetEntry()].push_back({ pItem, inBank });
+    };
+
+    addSlots(EQUIPMENT_SLOT_START, INVENTORY_SLOT_ITEM_END, false);
+    addSlots(KEYRING_SLOT_START, KEYRING_SLOT_END, false);
+    addBags(INVENTORY_SLOT_BAG_START, INVENTORY_SLOT_BAG_END, false);
+    addSlots(BANK_SLOT_ITEM_START, BANK_SLOT_ITEM_END, true);
+    addSlots(BANK_SLOT_BAG_START, BANK_SLOT_BAG_END, true);
+    addBags(BANK_SLOT_BAG_START, BANK_SLOT_BAG_END, true);
+
+    m_itemEntryIndexVersion = GetConditionStateVersion(CONDITION_STATE_ITEMS);
+}
+
+IndexedItemList const& Player::GetIndexedItems(uint32 item) const
+{
+    static IndexedItemList const emptyList;
+
+    if (m_itemEntryIndexVersion != GetConditionStateVersion(CONDITION_STATE_ITEMS))
+        RebuildItemEntryIndex();
+
+    auto itr = m_itemEntryIndex.find(item);
+    return itr != m_itemEntryIndex.end() ? itr->second : emptyList;
+}
+
+uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
+{
+    uint32 count = 0;
+    for (IndexedItem const& indexed : GetIndexedItems(item))
+        if (indexed.item != skipItem && (inBankAlso || !indexed.inBank))
+            count += indexed.item->GetCount();
 
     if (skipItem && skipItem->GetProto()->GemProperties)
     {
@@ -8562,29 +8655,13 @@ uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
         }
     }
 
-    if (inBankAlso)
+    if (inBankAlso && skipItem && skipItem->GetProto()->GemProperties)
     {
         for (int i = BANK_SLOT_ITEM_START; i < BANK_SLOT_ITEM_END; ++i)
         {
             Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-            if (pItem && pItem != skipItem && pItem->GetEntry() == item)
-                count += pItem->GetCount();
-        }
-        for (int i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            Bag* pBag = (Bag*)GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-            if (pBag)
-                count += pBag->GetItemCount(item, skipItem);
-        }
-
-        if (skipItem && skipItem->GetProto()->GemProperties)
-        {
-            for (int i = BANK_SLOT_ITEM_START; i < BANK_SLOT_ITEM_END; ++i)
-            {
-                Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-                if (pItem && pItem != skipItem && pItem->GetProto()->Socket[0].Color)
-                    count += pItem->GetGemCountWithID(item);
-            }
+            if (pItem && pItem != skipItem && pItem->GetProto()->Socket[0].Color)
+                count += pItem->GetGemCountWithID(item);
         }
     }
 
@@ -8825,72 +8902,15 @@ bool Player::IsValidPos(uint8 bag, uint8 slot, bool explicit_pos) const
 bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
 {
     uint32 tempcount = 0;
-    for (int i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
+    for (IndexedItem const& indexed : GetIndexedItems(item))
     {
-        Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-        if (pItem && pItem->GetEntry() == item && !pItem->IsInTrade())
+        if ((inBankAlso || !indexed.inBank) && !indexed.item->IsInTrade())
         {
-            tempcount += pItem->GetCount();
+            tempcount += indexed.item->GetCount();
             if (tempcount >= count)
                 return true;
         }
     }
-    for (int i = KEYRING_SLOT_START; i < KEYRING_SLOT_END; ++i)
-    {
-        Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-        if (pItem && pItem->GetEntry() == item && !pItem->IsInTrade())
-        {
-            tempcount += pItem->GetCount();
-            if (tempcount >= count)
-                return true;
-        }
-    }
-    for (int i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-    {
-        if (Bag* pBag = (Bag*)GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-        {
-            for (uint32 j = 0; j < pBag->GetBagSize(); ++j)
-            {
-                Item* pItem = GetItemByPos(i, j);
-                if (pItem && pItem->GetEntry() == item && !pItem->IsInTrade())
-                {
-                    tempcount += pItem->GetCount();
-                    if (tempcount >= count)
-                        return true;
-                }
-            }
-        }
-    }
-
-    if (inBankAlso)
-    {
-        for (int i = BANK_SLOT_ITEM_START; i < BANK_SLOT_ITEM_END; ++i)
-        {
-            Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i);
-            if (pItem && pItem->GetEntry() == item && !pItem->IsInTrade())
-            {
-                tempcount += pItem->GetCount();
-                if (tempcount >= count)
-                    return true;
-            }
-        }
-        for (int i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        {
-            if (Bag* pBag = (Bag*)GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            {
-                for (uint32 j = 0; j < pBag->GetBagSize(); ++j)
-                {
-                    Item* pItem = GetItemByPos(i, j);
-                    if (pItem && pItem->GetEntry() == item && !pItem->IsInTrade())
-                    {
-                        tempcount += pItem->GetCount();
-                        if (tempcount >= count)
-                            return true;
-                    }
-                }
-            }
-        }
-    }
 
     return false;
 }
@@ -9214,6 +9234,20 @@ InventoryResult Player::_CanStoreItem(uint8 bag, uint8 slot, ItemPosCountVec& de
         count -= no_similar_count;
     }
 
+    // stacks to merge with can only exist if the index knows an item of this entry outside the bank
+    bool mergeable = false;
+    if (pProto->Stackable > 1)
+    {
+        for (IndexedItem const& indexed : GetIndexedItems(entry))
+        {
+            if (!indexed.inBank && indexed.item != pItem)
+            {
+                mergeable = true;
+                break;
+            }
+        }
+    }
+
     // in specific slot
     if (bag != NULL_BAG && slot != NULL_SLOT)
     {
@@ -9242,7 +9276,7 @@ InventoryResult Player::_CanStoreItem(uint8 bag, uint8 slot, ItemPosCountVec& de
     if (bag != NULL_BAG)
     {
         // search stack in bag for merge to
-        if (pProto->Stackable > 1)
+        if (mergeable)
         {
             if (bag == INVENTORY_SLOT_BAG_0)               // inventory
             {
@@ -9380,7 +9414,7 @@ InventoryResult Player::_CanStoreItem(uint8 bag, uint8 slot, ItemPosCountVec& de
     // not specific bag or have space for partly store only in specific bag
 
     // search stack for merge to
-    if (pProto->Stackable > 1)
+    if (mergeable)
     {
         res = _CanStoreItem_InInventorySlots(KEYRING_SLOT_START, KEYRING_SLOT_END, dest, pProto, count, true, pItem, bag, slot);
         if (res != EQUIP_ERR_OK)
@@ -10274,8 +10308,23 @@ void Player::RemoveAmmo()
 Item* Player::StoreNewItem(ItemPosCountVec const& dest, uint32 item, bool update, int32 randomPropertyId)
 {
     uint32 count = 0;
+    bool mergeOnly = !dest.empty();
     for (auto itr : dest)
+    {
         count += itr.count;
+        if (mergeOnly && !GetItemByPos(itr.pos))
+            mergeOnly = false;
+    }
+
+    // only added to existing stacks, no need to create and destroy a temporary item with its own guid
+    if (mergeOnly)
+    {
+        ItemAddedQuestCheck(item, count);
+        Item* lastItem = nullptr;
+        for (auto itr : dest)
+            lastItem = _MergeIntoStack(itr.pos, GetItemByPos(itr.pos), itr.count, update);
+        return lastItem;
+    }
 
     Item* pItem = Item::CreateItem(item, count, this, randomPropertyId);
     if (pItem)
@@ -10380,15 +10429,8 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
 
         return pItem;
     }
-    ItemPrototype const* itemProto = pItem2->GetProto();
-    if (itemProto->Bonding == BIND_WHEN_PICKED_UP
-        || itemProto->Bonding == BIND_QUEST_ITEM
-        || (itemProto->Bonding == BIND_WHEN_EQUIPPED && IsBagPos(pos)))
-        pItem2->SetBinding(true);
 
-    pItem2->SetCount(pItem2->GetCount() + count);
-    if (IsInWorld() && update)
-        pItem2->SendCreateUpdateToPlayer(this);
+    _MergeIntoStack(pos, pItem2, count, update);
 
     if (!clone)
     {
@@ -10406,6 +10448,21 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
         pItem->SetState(ITEM_REMOVED, this);
     }
 
+    return pItem2;
+}
+
+Item* Player::_MergeIntoStack(uint16 pos, Item* pItem2, uint32 count, bool update)
+{
+    ItemPrototype const* itemProto = pItem2->GetProto();
+    if (itemProto->Bonding == BIND_WHEN_PICKED_UP
+        || itemProto->Bonding == BIND_QUEST_ITEM
+        || (itemProto->Bonding == BIND_WHEN_EQUIPPED && IsBagPos(pos)))
+        pItem2->SetBinding(true);
+
+    pItem2->SetCount(pItem2->GetCount() + count);
+    if (IsInWorld() && update)
+        pItem2->SendCreateUpdateToPlayer(this);
+
     // AddItemDurations(pItem2); - pItem2 already have duration listed for player
     AddEnchantmentDurations(pItem2);
 
@@ -10414,6 +10471,24 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
     return pItem2;
 }
 
+InventoryResult Player::CanStoreCraftedItem(ItemPosCountVec& dest, uint32 entry, uint32 count, uint32* no_space_count) const
+{
+    // "Create All" crafts the same item again and again, try the stack the previous one went to first
+    if (m_lastCraftedStack.first == entry)
+    {
+        ItemPrototype const* pProto = ObjectMgr::GetItemPrototype(entry);
+        Item* pItem2 = GetItemByPos(m_lastCraftedStack.second);
+        if (pProto && pItem2 && IsInventoryPos(m_lastCraftedStack.second) && pItem2->CanBeMergedPartlyWith(pProto) == EQUIP_ERR_OK
+                && pItem2->GetCount() + count <= pProto->GetMaxStackSize() && _CanTakeMoreSimilarItems(entry, count, nullptr) == EQUIP_ERR_OK)
+        {
+            dest.push_back(ItemPosCount(m_lastCraftedStack.second, count));
+            return EQUIP_ERR_OK;
+        }
+    }
+
+    return CanStoreNewItem(NULL_BAG, NULL_SLOT, dest, entry, count, no_space_count);
+}
+
 Item* Player::EquipNewItem(uint16 pos, uint32 item, bool update)
 {
     if (Item* pItem = Item::CreateItem(item, 1, this))
@@ -10600,6 +10675,9 @@ void Player::RemoveItem(uint8 bag, uint8 slot, bool update)
     {
         DEBUG_LOG("STORAGE: RemoveItem bag = %u, slot = %u, item = %u", bag, slot, pItem->GetEntry());
 
+        // the item may be stored again before its state changes
+        ConditionStateChanged(CONDITION_STATE_ITEMS);
+
         RemoveEnchantmentDurations(pItem);
         RemoveItemDurations(pItem);
 
@@ -10718,6 +10796,8 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
     {
         DEBUG_LOG("STORAGE: DestroyItem bag = %u, slot = %u, item = %u", bag, slot, pItem->GetEntry());
 
+        ConditionStateChanged(CONDITION_STATE_ITEMS);
+
         // start from destroy contained items (only equipped bag can have its)
         if (pItem->IsBag() && pItem->IsEquipped())          // this also prevent infinity loop if empty bag stored in bag==slot
         {
@@ -12243,17 +12323,20 @@ void Player::PrepareGossipMenu(WorldObject* pSource, uint32 menuId, bool forceQu
                 case GOSSIP_OPTION_BOT:
                 {
 #ifdef BUILD_PLAYERBOT
-                    if (botConfig.GetBoolDefault("PlayerbotAI.DisableBots", false) && !pCreature->isInnkeeper())
+                    static Config::Key const disableBotsKey = botConfig.Intern("PlayerbotAI.DisableBots");
+                    if (botConfig.GetBool(disableBotsKey, false) && !pCreature->isInnkeeper())
                     {
                         ChatHandler(this).PSendSysMessage("|cffff0000Playerbot system is currently disabled!");
                         hasMenuItem = false;
                         break;
                     }
 
-                    int32 cost = botConfig.GetIntDefault("PlayerbotAI.BotguyCost", 0);
+                    static Config::Key const botguyCostKey = botConfig.Intern("PlayerbotAI.BotguyCost");
+                    int32 cost = botConfig.GetInt(botguyCostKey, 0);
                     if (cost >= 0)
                     {
-                        std::string reqQuestIds = botConfig.GetStringDefault("PlayerbotAI.BotguyQuests", "");
+                        static Config::Key const botguyQuestsKey = botConfig.Intern("PlayerbotAI.BotguyQuests");
+                        std::string reqQuestIds = botConfig.GetString(botguyQuestsKey, "");
                         if ((reqQuestIds == "" || requiredQuests(reqQuestIds.c_str())) && !pCreature->isInnkeeper() && this->GetMoney() >= (uint32)cost)
                             pCreature->LoadBotMenu(this);
                     }
@@ -12320,11 +12403,11 @@ void Player::PrepareGossipMenu(WorldObject* pSource, uint32 menuId, bool forceQu
 
                     if (GossipMenuItemsLocale const* no = sObjectMgr.GetGossipMenuItemsLocale(idxEntry))
                     {
-                        if (no->OptionText.size() > (size_t)loc_idx && !no->OptionText[loc_idx].empty())
-                            strOptionText = no->OptionText[loc_idx];
+                        if (char const* optionText = sObjectMgr.GetLocaleString(no->OptionText, loc_idx))
+                            strOptionText = optionText;
 
-                        if (no->BoxText.size() > (size_t)loc_idx && !no->BoxText[loc_idx].empty())
-                            strBoxText = no->BoxText[loc_idx];
+                        if (char const* boxText = sObjectMgr.GetLocaleString(no->BoxText, loc_idx))
+                            strBoxText = boxText;
                     }
                 }
             }
@@ -12526,7 +12609,8 @@ void Player::OnGossipSelect(WorldObject* pSource, uint32 gossipListId, uint32 me
             // DEBUG_LOG("GOSSIP_OPTION_BOT");
             m_playerMenu->CloseGossip();
             uint32 guidlo = m_playerMenu->GossipOptionSender(gossipListId);
-            int32 cost = botConfig.GetIntDefault("PlayerbotAI.BotguyCost", 0);
+            static Config::Key const botguyCostKey = botConfig.Intern("PlayerbotAI.BotguyCost");
+            int32 cost = botConfig.GetInt(botguyCostKey, 0);
 
             if (!GetPlayerbotMgr())
                 SetPlayerbotMgr(new PlayerbotMgr(this));
@@ -12541,7 +12625,8 @@ void Player::OnGossipSelect(WorldObject* pSource, uint32 gossipListId, uint32 me
                 if (resultchar)
                 {
                     Field* fields = resultchar->Fetch();
-                    int maxnum = botConfig.GetIntDefault("PlayerbotAI.MaxNumBots", 9);
+                    static Config::Key const maxNumBotsKey = botConfig.Intern("PlayerbotAI.MaxNumBots");
+                    int maxnum = botConfig.GetInt(maxNumBotsKey, 9);
                     int acctcharcount = fields[0].GetUInt32();
                     if (!(m_session->GetSecurity() > SEC_PLAYER))
                         if (acctcharcount > maxnum)
@@ -12557,7 +12642,8 @@ void Player::OnGossipSelect(WorldObject* pSource, uint32 gossipListId, uint32 me
                 if (resultlvl)
                 {
                     Field* fields = resultlvl->Fetch();
-                    int maxlvl = botConfig.GetIntDefault("PlayerbotAI.RestrictBotLevel", 80);
+                    static Config::Key const restrictBotLevelKey = botConfig.Intern("PlayerbotAI.RestrictBotLevel");
+                    int maxlvl = botConfig.GetInt(restrictBotLevelKey, 80);
                     int charlvl = fields[0].GetUInt32();
                     if (!(m_session->GetSecurity() > SEC_PLAYER))
                         if (charlvl > maxlvl)
@@ -13104,6 +13190,8 @@ void Player::SendPetTameFailure(PetTameFailureReason reason) const
 
 void Player::AddQuest(Quest const* pQuest, Object* questGiver)
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     uint16 log_slot = FindQuestSlot(0);
     MANGOS_ASSERT(log_slot < MAX_QUEST_LOG_SIZE);
 
@@ -13203,18 +13291,13 @@ void Player::AddQuest(Quest const* pQuest, Object* questGiver)
     // Some spells applied at quest activation
     uint32 zone, area;
     GetZoneAndAreaId(zone, area);
-    SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(zone);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
+    for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(zone, true))
+        spellArea->ApplyOrRemoveSpellIfCan(this, zone, area, true);
     if (area != zone)
     {
-        saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(area);
-        for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-            itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
+        for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(area, true))
+            spellArea->ApplyOrRemoveSpellIfCan(this, zone, area, true);
     }
-    saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(0);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, true);
 
     UpdateForQuestWorldObjects();
 }
@@ -13251,6 +13334,8 @@ void Player::IncompleteQuest(uint32 quest_id)
 
 void Player::RewardQuest(Quest const* pQuest, uint32 reward, Object* questGiver, bool announce)
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     uint32 quest_id = pQuest->GetQuestId();
 
     for (int i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
@@ -13408,18 +13493,13 @@ void Player::RewardQuest(Quest const* pQuest, uint32 reward, Object* questGiver,
     // Some spells applied at quest reward
     uint32 zone, area;
     GetZoneAndAreaId(zone, area);
-    SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(zone);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
+    for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(zone, false))
+        spellArea->ApplyOrRemoveSpellIfCan(this, zone, area, false);
     if (area != zone)
     {
-        saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(area);
-        for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-            itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
+        for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(area, false))
+            spellArea->ApplyOrRemoveSpellIfCan(this, zone, area, false);
     }
-    saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(0);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, zone, area, false);
 
     // resend quests status directly
     SendQuestGiverStatusMultiple();
@@ -14035,6 +14115,8 @@ bool Player::CanShareQuest(uint32 quest_id) const
 
 void Player::SetQuestStatus(uint32 quest_id, QuestStatus status)
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     if (sObjectMgr.GetQuestTemplate(quest_id))
     {
         QuestStatusData& q_status = mQuestStatus[quest_id];
@@ -14452,6 +14534,8 @@ enum TitleFactions
 
 void Player::ReputationChanged(FactionEntry const* factionEntry)
 {
+    ConditionStateChanged(CONDITION_STATE_REPUTATION);
+
     ReputationMgr const& repMgr = GetReputationMgr();
     for (int i = 0; i < MAX_QUEST_LOG_SIZE; ++i)
     {
@@ -14713,6 +14797,46 @@ void Player::SendQuestUpdateAddCreatureOrGo(Quest const* pQuest, ObjectGuid guid
         SetQuestSlotCounter(slot, uint8(creatureOrGO_idx), uint8(count));
 }
 
+void Player::ConditionStateChanged(uint32 stateFlags)
+{
+    for (uint32 i = 0; i < MAX_CONDITION_STATE; ++i)
+        if (stateFlags & (1 << i))
+            ++m_conditionStateVersions[i];
+
+    // quest marks read these besides quest conditions
+    if (stateFlags & (CONDITION_STATE_QUESTS | CONDITION_STATE_REPUTATION | CONDITION_STATE_LEVEL))
+        ResetQuestGiverStatusCache();
+}
+
+uint32 Player::GetConditionStateVersion(uint32 stateFlags) const
+{
+    // counters only grow, so the sum changes with any of them
+    uint32 version = 0;
+    for (uint32 i = 0; i < MAX_CONDITION_STATE; ++i)
+        if (stateFlags & (1 << i))
+            version += m_conditionStateVersions[i];
+    return version;
+}
+
+uint32 Player::GetQuestGiverDialogStatus(Object const* questgiver) const
+{
+    uint32 cacheTime = sWorld.getConfig(CONFIG_UINT32_QUESTGIVER_STATUS_CACHE_TIME);
+    if (!cacheTime)
+        return GetSession()->getDialogStatus(this, questgiver, DIALOG_STATUS_NONE);
+
+    // the status only depends on the quest relations of the entry and this player
+    uint64 key = (uint64(questgiver->GetTypeId()) << 32) | questgiver->GetEntry();
+    uint32 now = WorldTimer::getMSTime();
+
+    auto itr = m_questGiverStatusCache.find(key);
+    if (itr != m_questGiverStatusCache.end() && WorldTimer::getMSTimeDiff(itr->second.time, now) < cacheTime)
+        return itr->second.status;
+
+    uint32 dialogStatus = GetSession()->getDialogStatus(this, questgiver, DIALOG_STATUS_NONE);
+    m_questGiverStatusCache[key] = { dialogStatus, now };
+    return dialogStatus;
+}
+
 void Player::SendQuestGiverStatusMultiple() const
 {
     uint32 count = 0;
@@ -14736,7 +14860,7 @@ void Player::SendQuestGiverStatusMultiple() const
             uint8 dialogStatus = sScriptDevAIMgr.GetDialogStatus(this, questgiver);
 
             if (dialogStatus == DIALOG_STATUS_UNDEFINED)
-                dialogStatus = GetSession()->getDialogStatus(this, questgiver, DIALOG_STATUS_NONE);
+                dialogStatus = GetQuestGiverDialogStatus(questgiver);
 
             data << questgiver->GetObjectGuid();
             data << uint8(dialogStatus);
@@ -14755,7 +14879,7 @@ void Player::SendQuestGiverStatusMultiple() const
             uint8 dialogStatus = sScriptDevAIMgr.GetDialogStatus(this, questgiver);
 
             if (dialogStatus == DIALOG_STATUS_UNDEFINED)
-                dialogStatus = GetSession()->getDialogStatus(this, questgiver, DIALOG_STATUS_NONE);
+                dialogStatus = GetQuestGiverDialogStatus(questgiver);
 
             data << questgiver->GetObjectGuid();
             data << uint8(dialogStatus);
@@ -15336,10 +15460,8 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
 
     // apply original stats mods before spell loading or item equipment that call before equip _RemoveStatsMods()
 
-    // Mail
-    _LoadMails(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILS));
-    _LoadMailedItems(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS));
-    UpdateNextMailTimeAndUnreads();
+    // Mail, the mails self are loaded at first mailbox open
+    _LoadMailStatus(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILSTATUS));
 
     _LoadSpells(holder->GetResult(PLAYER_LOGIN_QUERY_LOADSPELLS));
 
@@ -15859,6 +15981,9 @@ void Player::_LoadInventory(QueryResult* result, uint32 timediff)
         }
     }
 
+    // items were put in place without state changes
+    ConditionStateChanged(CONDITION_STATE_ITEMS);
+
     // if(IsAlive())
     _ApplyAllItemMods();
 }
@@ -15894,11 +16019,41 @@ void Player::_LoadItemLoot(QueryResult* result)
     }
 }
 
-// load mailed item which should receive current player
+// load mail status needed before the mails self are loaded at first mailbox open
+void Player::_LoadMailStatus(QueryResult* result)
+{
+    //        0            1
+    // SELECT deliver_time,checked FROM mail WHERE receiver = '%u'
+    m_nextMailDelivereTime = 0;
+    unReadMails = 0;
+    if (!result)
+        return;
+
+    time_t cTime = time(nullptr);
+    do
+    {
+        Field* fields = result->Fetch();
+        time_t deliver_time = (time_t)fields[0].GetUInt64();
+        uint32 checked = fields[1].GetUInt32();
+
+        if (deliver_time > cTime)
+        {
+            if (!m_nextMailDelivereTime || m_nextMailDelivereTime > deliver_time)
+                m_nextMailDelivereTime = deliver_time;
+        }
+        else if ((checked & MAIL_CHECK_MASK_READ) == 0)
+            ++unReadMails;
+    }
+    while (result->NextRow());
+
+    delete result;
+}
+
+// load mailed item which should receive current player, only for mails which items are not loaded yet
 void Player::_LoadMailedItems(QueryResult* result)
 {
     //        0          1            2                3      4         5        6      7             8                 9           10          11       12         13
-    // SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE receiver = '%u'", m_guid.GetCounter());
+    // SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE mail_id IN (...)
     if (!result)
         return;
 
@@ -15910,9 +16065,8 @@ void Player::_LoadMailedItems(QueryResult* result)
         uint32 item_template = fields[13].GetUInt32();
 
         Mail* mail = GetMail(mail_id);
-        if (!mail)
+        if (!mail || mail->itemsLoaded || GetMItem(item_guid_low))
             continue;
-        mail->AddItem(item_guid_low, item_template);
 
         ItemPrototype const* proto = ObjectMgr::GetItemPrototype(item_template);
 
@@ -15942,9 +16096,31 @@ void Player::_LoadMailedItems(QueryResult* result)
     delete result;
 }
 
+// load the attached item list of the mails, the items self are loaded only when the mail is listed
+void Player::_LoadMailItemInfos(QueryResult* result)
+{
+    //        0       1         2
+    // SELECT mail_id,item_guid,item_template FROM mail_items WHERE receiver = '%u'
+    if (!result)
+        return;
+
+    do
+    {
+        Field* fields = result->Fetch();
+
+        Mail* mail = GetMail(fields[0].GetUInt32());
+        if (!mail || mail->itemsLoaded)                     // mail received while loading already knows its items
+            continue;
+
+        mail->AddItem(fields[1].GetUInt32(), fields[2].GetUInt32());
+    }
+    while (result->NextRow());
+
+    delete result;
+}
+
 void Player::_LoadMails(QueryResult* result)
 {
-    m_mail.clear();
     //        0  1           2      3        4       5          6           7            8     9   10      11         12             13
     //"SELECT id,messageType,sender,receiver,subject,itemTextId,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC",GetGUIDLow()
     if (!result)
@@ -15953,8 +16129,12 @@ void Player::_LoadMails(QueryResult* result)
     do
     {
         Field* fields = result->Fetch();
+        uint32 messageID = fields[0].GetUInt32();
+        if (GetMail(messageID))                             // received while loading
+            continue;
+
         Mail* m = new Mail;
-        m->messageID = fields[0].GetUInt32();
+        m->messageID = messageID;
         m->messageType = fields[1].GetUInt8();
         m->sender = fields[2].GetUInt32();
         m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
@@ -15968,6 +16148,7 @@ void Player::_LoadMails(QueryResult* result)
         m->stationery = fields[11].GetUInt8();
         m->mailTemplateId = fields[12].GetInt16();
         m->has_items = fields[13].GetBool();                // true, if mail have items or mail have template and items generated (maybe none)
+        m->itemsLoaded = !m->has_items;
 
         if (m->mailTemplateId && !sMailTemplateStore.LookupEntry(m->mailTemplateId))
         {
@@ -15980,7 +16161,7 @@ void Player::_LoadMails(QueryResult* result)
         m_mail.push_back(m);
 
         if (m->mailTemplateId && !m->has_items)
-            m->prepareTemplateItems(this);
+            m->prepareTemplateItems(this);                  // generated items are created in memory already
     }
     while (result->NextRow());
     delete result;
@@ -16599,11 +16780,24 @@ bool Player::_LoadHomeBind(QueryResult* result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+void Player::ScheduleValuableSave()
+{
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE_VALUABLE);
+    if (!interval || !m_nextSave)                           // disabled, or periodic saves are off
+        return;
+
+    m_valuableSave = true;
+    if (m_nextSave > interval)
+        m_nextSave = interval;
+}
+
 void Player::SaveToDB()
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    m_saveDelay = 0;
+    m_valuableSave = false;
 
     // lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -16618,7 +16812,7 @@ void Player::SaveToDB()
     DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_STATS, "The value of player %s at save: ", m_name.c_str());
     outDebugStatsValues();
 
-    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.BeginTransaction(GetGUIDLow());
 
     static SqlStatementID delChar ;
     static SqlStatementID insChar ;
@@ -16802,6 +16996,8 @@ void Player::SaveToDB()
 
     CharacterDatabase.CommitTransaction();
 
+    sObjectMgr.UpdatePlayerDataCache({ GetGUIDLow(), GetSession()->GetAccountId(), m_name, getRace(), getClass(), getGender(), GetLevel() });
+
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld.getConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT))
@@ -17270,13 +17466,15 @@ void Player::_SaveSpells()
     SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM character_spell WHERE guid = ? and spell = ?");
     SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO character_spell (guid,spell,active,disabled) VALUES (?, ?, ?, ?)");
 
+    // all deletes before the inserts, so each kind can be sent as one multi-row request
+    for (auto& spell : m_spells)
+        if (spell.second.state == PLAYERSPELL_REMOVED || spell.second.state == PLAYERSPELL_CHANGED)
+            stmtDel.PExecute(GetGUIDLow(), spell.first);
+
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
         PlayerSpell& playerSpell = itr->second;
 
-        if (playerSpell.state == PLAYERSPELL_REMOVED || playerSpell.state == PLAYERSPELL_CHANGED)
-            stmtDel.PExecute(GetGUIDLow(), itr->first);
-
         // add only changed/new not dependent spells
         if (!playerSpell.dependent && (playerSpell.state == PLAYERSPELL_NEW || playerSpell.state == PLAYERSPELL_CHANGED))
             stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(playerSpell.active ? 1 : 0), uint8(playerSpell.disabled ? 1 : 0));
@@ -17403,6 +17601,8 @@ void Player::SendAttackSwingNotInRange() const
 
 void Player::SavePositionInDB(ObjectGuid guid, uint32 mapid, float x, float y, float z, float o, uint32 zone)
 {
+    sCharacterLoginCache.Invalidate(guid);
+
     std::ostringstream ss;
     ss << "UPDATE characters SET position_x='" << x << "',position_y='" << y
        << "',position_z='" << z << "',orientation='" << o << "',map='" << mapid
@@ -17879,6 +18079,14 @@ bool Player::IsAffectedBySpellmod(SpellEntry const* spellInfo, SpellModifier* mo
     if (!mod || !spellInfo)
         return false;
 
+    if (!IsSpellModAvailable(mod, consumedMods))
+        return false;
+
+    return mod->isAffectedOnSpell(spellInfo);
+}
+
+bool Player::IsSpellModAvailable(SpellModifier const* mod, std::set<SpellModifierPair>* consumedMods) const
+{
     if (mod->charges == -1)            // marked as expired but locked until spell casting finish
     {
         // prevent apply to any spell except spell that trigger expire
@@ -17889,7 +18097,21 @@ bool Player::IsAffectedBySpellmod(SpellEntry const* spellInfo, SpellModifier* mo
         }
     }
 
-    return mod->isAffectedOnSpell(spellInfo);
+    return true;
+}
+
+SpellModVector const& Player::GetSpellModsAffecting(SpellEntry const* spellInfo, SpellModOp op)
+{
+    auto result = m_spellModsBySpell[op].emplace(spellInfo->Id, SpellModVector());
+    SpellModVector& mods = result.first->second;
+    if (result.second)
+    {
+        // family mask match does not change while the mod is in the list, charges are still checked per use
+        for (SpellModifier* mod : m_spellMods[op])
+            if (mod->isAffectedOnSpell(spellInfo))
+                mods.push_back(mod);
+    }
+    return mods;
 }
 
 void Player::AddSpellMod(SpellModifier* mod, bool apply)
@@ -17916,6 +18138,8 @@ void Player::AddSpellMod(SpellModifier* mod, bool apply)
         }
     }
 
+    m_spellModsBySpell[mod->op].clear();
+
     if (apply)
     {
         m_spellMods[mod->op].push_back(mod);
@@ -19862,6 +20086,8 @@ void Player::SetMonthlyQuestStatus(uint32 quest_id)
 
 void Player::ResetDailyQuestStatus()
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     for (uint32 quest_daily_idx = 0; quest_daily_idx < PLAYER_MAX_DAILY_QUESTS; ++quest_daily_idx)
         SetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx, 0);
 
@@ -19871,6 +20097,8 @@ void Player::ResetDailyQuestStatus()
 
 void Player::ResetWeeklyQuestStatus()
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     if (m_weeklyquests.empty())
         return;
 
@@ -19881,6 +20109,8 @@ void Player::ResetWeeklyQuestStatus()
 
 void Player::ResetMonthlyQuestStatus()
 {
+    ConditionStateChanged(CONDITION_STATE_QUESTS);
+
     if (m_monthlyquests.empty())
         return;
 
@@ -20504,30 +20734,33 @@ void Player::UpdateClientControl(Unit const* target, bool enabled, bool forced)
 void Player::UpdateZoneDependentAuras()
 {
     // Some spells applied at enter into zone (with subzones), aura removed in UpdateAreaDependentAuras that called always at zone->area update
-    SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(m_zoneUpdateId);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, 0, true);
+    for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(m_zoneUpdateId, true))
+        spellArea->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, 0, true);
 }
 
 void Player::UpdateAreaDependentAuras()
 {
     // remove auras from spells with area limitations
-    for (SpellAuraHolderMap::iterator iter = m_spellAuraHolders.begin(); iter != m_spellAuraHolders.end();)
+    // the check only depends on the spell, so collect the spells first instead of restarting the scan after every removal
+    std::vector<uint32> removedSpells;
+    uint32 lastSpellId = 0;
+    for (SpellAuraHolderMap::const_iterator iter = m_spellAuraHolders.begin(); iter != m_spellAuraHolders.end(); ++iter)
     {
+        if (iter->first == lastSpellId)
+            continue;                                       // holders are ordered by spell id
+        lastSpellId = iter->first;
+
         // use m_zoneUpdateId for speed: UpdateArea called from UpdateZone or instead UpdateZone in both cases m_zoneUpdateId up-to-date
         if (sSpellMgr.GetSpellAllowedInLocationError(iter->second->GetSpellProto(), GetMapId(), m_zoneUpdateId, m_areaUpdateId, this) != SPELL_CAST_OK)
-        {
-            RemoveSpellAuraHolder(iter->second);
-            iter = m_spellAuraHolders.begin();
-        }
-        else
-            ++iter;
+            removedSpells.push_back(iter->first);
     }
 
+    for (uint32 spellId : removedSpells)
+        RemoveAurasDueToSpell(spellId);
+
     // some auras applied at subzone enter
-    SpellAreaForAreaMapBounds saBounds = sSpellMgr.GetSpellAreaForAreaMapBounds(m_areaUpdateId);
-    for (SpellAreaForAreaMap::const_iterator itr = saBounds.first; itr != saBounds.second; ++itr)
-        itr->second->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, m_areaUpdateId, true);
+    for (SpellArea const* spellArea : sSpellMgr.GetSpellAreasForArea(m_areaUpdateId, true))
+        spellArea->ApplyOrRemoveSpellIfCan(this, m_zoneUpdateId, m_areaUpdateId, true);
 }
 
 struct UpdateZoneDependentPetsHelper
@@ -21993,7 +22226,10 @@ bool Player::CanEnterNewInstance(uint32 instanceId)
 void Player::AddNewInstanceId(uint32 instanceId)
 {
     if (m_enteredInstances.find(instanceId) == m_enteredInstances.end())
+    {
         m_enteredInstances.emplace(instanceId, std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now() + std::chrono::hours(1)));
+        m_enteredInstancesChanged = true;
+    }
 }
 
 void Player::_LoadCreatedInstanceTimers()
@@ -22020,6 +22256,11 @@ void Player::_LoadCreatedInstanceTimers()
 
 void Player::_SaveNewInstanceIdTimer()
 {
+    if (!m_enteredInstancesChanged)
+        return;
+
+    m_enteredInstancesChanged = false;
+
     CharacterDatabase.PExecute("DELETE FROM account_instances_entered WHERE AccountId = '%u'", m_session->GetAccountId());
 
     if (m_enteredInstances.empty())
@@ -22044,7 +22285,10 @@ void Player::UpdateNewInstanceIdTimers(TimePoint const& now)
     for (auto iter = m_enteredInstances.begin(); iter != m_enteredInstances.end();)
     {
         if ((*iter).second < now)
+        {
             iter = m_enteredInstances.erase(iter);
+            m_enteredInstancesChanged = true;
+        }
         else
             ++iter;
     }
@@ -41,6 +41,7 @@
 #include "Server/SQLStorages.h"
 #include "Loot/LootMgr.h"
 #include "Cinematics/CinematicMgr.h"
+#include "Globals/Conditions.h"
 
 #include <functional>
 #include <vector>
@@ -68,6 +69,13 @@ struct AreaTrigger;
 
 typedef std::deque<Mail*> PlayerMails;
 
+enum PlayerMailLoadState
+{
+    PLAYER_MAIL_NOT_LOADED      = 0,                        // only unread count and next delivery time are known
+    PLAYER_MAIL_LOADING         = 1,                        // headers requested at first mailbox open
+    PLAYER_MAIL_LOADED          = 2,                        // headers loaded, attached items are loaded per listed mail
+};
+
 #define PLAYER_MAX_SKILLS           127
 #define PLAYER_MAX_DAILY_QUESTS     25
 #define PLAYER_EXPLORED_ZONES_SIZE  128
@@ -270,13 +278,14 @@ struct PvPInfo
 
 struct DuelInfo
 {
-    DuelInfo() : initiator(nullptr), opponent(nullptr), startTimer(0), startTime(0), outOfBound(0) {}
+    DuelInfo() : initiator(nullptr), opponent(nullptr), startTimer(0), startTime(0), outOfBound(0), moved(true) {}
 
     Player* initiator;
     Player* opponent;
     time_t startTimer;
     time_t startTime;
     time_t outOfBound;
+    bool moved;                                             // relocated since the last arbiter distance check
 };
 
 struct Areas
@@ -651,6 +660,13 @@ struct ItemPosCount
 };
 typedef std::vector<ItemPosCount> ItemPosCountVec;
 
+struct IndexedItem
+{
+    Item* item;
+    bool inBank;
+};
+typedef std::vector<IndexedItem> IndexedItemList;
+
 enum TradeSlots
 {
     TRADE_SLOT_COUNT            = 7,
@@ -755,8 +771,7 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADBGDATA,
     PLAYER_LOGIN_QUERY_LOADACCOUNTDATA,
     PLAYER_LOGIN_QUERY_LOADSKILLS,
-    PLAYER_LOGIN_QUERY_LOADMAILS,
-    PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,
+    PLAYER_LOGIN_QUERY_LOADMAILSTATUS,
     PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS,
 
@@ -1133,6 +1148,8 @@ class Player : public Unit
         bool ViableEquipSlots(ItemPrototype const* proto, uint8* viable_slots) const;
         uint8 FindEquipSlot(ItemPrototype const* proto, uint32 slot, bool swap) const;
         uint32 GetItemCount(uint32 item, bool inBankAlso = false, Item* skipItem = nullptr) const;
+        // equipped, inventory, keyring, bag and bank items of one entry, see RebuildItemEntryIndex
+        IndexedItemList const& GetIndexedItems(uint32 item) const;
         Item* GetItemByGuid(ObjectGuid guid) const;
         Item* GetItemByPos(uint16 pos) const;
         Item* GetItemByPos(uint8 bag, uint8 slot) const;
@@ -1171,6 +1188,8 @@ class Player : public Unit
             return _CanStoreItem(bag, slot, dest, pItem->GetEntry(), count, pItem, swap, nullptr);
         }
         InventoryResult CanStoreItems(Item** pItems, int count) const;
+        InventoryResult CanStoreCraftedItem(ItemPosCountVec& dest, uint32 entry, uint32 count, uint32* no_space_count = nullptr) const;
+        void SetLastCraftedStack(Item const* pItem) { m_lastCraftedStack = { pItem->GetEntry(), pItem->GetPos() }; }
         InventoryResult CanEquipNewItem(uint8 slot, uint16& dest, uint32 item, bool swap) const;
         InventoryResult CanEquipItem(uint8 slot, uint16& dest, Item* pItem, bool swap, bool direct_action = true) const;
 
@@ -1401,6 +1420,13 @@ class Player : public Unit
         void SendQuestUpdateAddItem(Quest const* pQuest, uint32 item_idx, uint32 current, uint32 count);
         void SendQuestUpdateAddCreatureOrGo(Quest const* pQuest, ObjectGuid guid, uint32 creatureOrGO_idx, uint32 count);
         void SendQuestGiverStatusMultiple() const;
+        // quest marks of a questgiver without dialog status script, see Quests.StatusCacheTime
+        uint32 GetQuestGiverDialogStatus(Object const* questgiver) const;
+        void ResetQuestGiverStatusCache() { m_questGiverStatusCache.clear(); }
+
+        // drops memoized condition results and quest marks reading the changed state, see ConditionStateFlags
+        void ConditionStateChanged(uint32 stateFlags);
+        uint32 GetConditionStateVersion(uint32 stateFlags) const;
 
         ObjectGuid GetDividerGuid() const { return m_dividerGuid; }
         void SetDividerGuid(ObjectGuid guid) { m_dividerGuid = guid; }
@@ -1498,6 +1524,11 @@ class Player : public Unit
         size_t GetMailSize() const { return m_mail.size(); }
         Mail* GetMail(uint32 id);
 
+        // mails are loaded at first mailbox open and unloaded again after MailUnloadDelay without mail use
+        PlayerMailLoadState GetMailLoadState() const { return m_mailLoadState; }
+        bool IsMailLoaded() const { return m_mailLoadState == PLAYER_MAIL_LOADED; }
+        void UnloadMails();
+
         PlayerMails::iterator GetMailBegin() { return m_mail.begin();}
         PlayerMails::iterator GetMailEnd() { return m_mail.end();}
 
@@ -1577,6 +1608,8 @@ class Player : public Unit
         void AddSpellMod(SpellModifier* mod, bool apply);
         void SendAllSpellMods(SpellModType modType);
         bool IsAffectedBySpellmod(SpellEntry const* spellInfo, SpellModifier* mod, std::set<SpellModifierPair>* consumedMods);
+        bool IsSpellModAvailable(SpellModifier const* mod, std::set<SpellModifierPair>* consumedMods) const;
+        SpellModVector const& GetSpellModsAffecting(SpellEntry const* spellInfo, SpellModOp op);
         template <class T> void ApplySpellMod(uint32 spellId, SpellModOp op, T& basevalue, bool finalUse = true);
         SpellModifier* GetSpellMod(SpellModOp op, uint32 spellId) const;
         void RemoveSpellMods(std::set<SpellModifierPair>& usedAuraCharges);
@@ -1618,6 +1651,7 @@ class Player : public Unit
         void UpdateZone(uint32 newZone, uint32 newArea, bool force = false);
         void UpdateArea(uint32 newArea);
         uint32 GetCachedZoneId() const { return m_zoneUpdateId; }
+        uint32 GetCachedAreaId() const { return m_areaUpdateId; }
 
         void UpdateZoneDependentAuras();
         void UpdateAreaDependentAuras();                    // subzones
@@ -2130,6 +2164,8 @@ class Player : public Unit
 
         uint32 GetSaveTimer() const { return m_nextSave; }
         void   SetSaveTimer(uint32 timer) { m_nextSave = timer; }
+        /// Brings the next save closer after changes worth not losing, see PlayerSave.ValuableInterval
+        void   ScheduleValuableSave();
 
         // Recall position
         uint32 m_recallMap;
@@ -2342,6 +2378,22 @@ class Player : public Unit
         QuestSet m_weeklyquests;
         QuestSet m_monthlyquests;
 
+        struct QuestGiverStatusCacheEntry
+        {
+            uint32 status;
+            uint32 time;                                    // WorldTimer ms when computed
+        };
+        // by type id << 32 | entry
+        mutable std::unordered_map<uint64, QuestGiverStatusCacheEntry> m_questGiverStatusCache;
+
+        uint32 m_conditionStateVersions[MAX_CONDITION_STATE];   // change counters by ConditionStateFlags bit
+
+        // item entry -> items in storage, rebuilt on first use after the CONDITION_STATE_ITEMS version changed
+        // only membership is kept, stack counts and trade state are read from the items
+        void RebuildItemEntryIndex() const;
+        mutable std::unordered_map<uint32, IndexedItemList> m_itemEntryIndex;
+        mutable uint32 m_itemEntryIndexVersion;
+
         ObjectGuid m_dividerGuid;
         uint32 m_ingametime;
 
@@ -2354,7 +2406,9 @@ class Player : public Unit
         void _LoadBoundInstances(QueryResult* result);
         void _LoadInventory(QueryResult* result, uint32 timediff);
         void _LoadItemLoot(QueryResult* result);
+        void _LoadMailStatus(QueryResult* result);
         void _LoadMails(QueryResult* result);
+        void _LoadMailItemInfos(QueryResult* result);
         void _LoadMailedItems(QueryResult* result);
         void _LoadQuestStatus(QueryResult* result);
         void _LoadDailyQuestStatus(QueryResult* result);
@@ -2420,6 +2474,8 @@ class Player : public Unit
 
         Team m_team;
         uint32 m_nextSave;
+        uint32 m_saveDelay;                                 // time the periodic save waited for PlayerSaveScheduler
+        bool m_valuableSave;
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
@@ -2431,6 +2487,7 @@ class Player : public Unit
 
         std::vector<Item*> m_itemUpdateQueue;
         bool m_itemUpdateQueueBlocked;
+        std::pair<uint32 /*entry*/, uint16 /*pos*/> m_lastCraftedStack;
 
         uint32 m_ExtraFlags;
         ObjectGuid m_curSelectionGuid;
@@ -2443,6 +2500,10 @@ class Player : public Unit
         uint32 m_ArenaTeamIdInvited;
 
         PlayerMails m_mail;
+        PlayerMailLoadState m_mailLoadState;
+        uint32 m_mailQueryId;                               // identifies the newest mail query, older callbacks are dropped
+        bool m_mailItemsLoading;
+        time_t m_mailUsedTime;
         PlayerSpellMap m_spells;
 
         ActionButtonList m_actionButtons;
@@ -2453,6 +2514,8 @@ class Player : public Unit
         uint32 m_enchantmentFlatMod[MAX_ATTACK]; // TODO: Stat system - incorporate generically, exposes a required hidden weapon stat that does not apply when unarmed
 
         SpellModList m_spellMods[MAX_SPELLMOD];
+        // mods of m_spellMods matching a spell family mask, per op and spell id, dropped when the op list changes
+        std::unordered_map<uint32, SpellModVector> m_spellModsBySpell[MAX_SPELLMOD];
         int32 m_SpellModRemoveCount;
         SpellFamily m_spellClassName; // s_spellClassSet
         EnchantDurationList m_enchantDuration;
@@ -2475,6 +2538,7 @@ class Player : public Unit
         bool   m_DailyQuestChanged;
         bool   m_WeeklyQuestChanged;
         bool   m_MonthlyQuestChanged;
+        uint32 m_savedCooldownVersion;                      // m_cooldownMap version at the last save
 
         uint32 m_drunkTimer;
         uint16 m_drunk;
@@ -2532,6 +2596,7 @@ class Player : public Unit
         InventoryResult _CanStoreItem_InBag(uint8 bag, ItemPosCountVec& dest, ItemPrototype const* pProto, uint32& count, bool merge, bool non_specialized, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         InventoryResult _CanStoreItem_InInventorySlots(uint8 slot_begin, uint8 slot_end, ItemPosCountVec& dest, ItemPrototype const* pProto, uint32& count, bool merge, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         Item* _StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool update);
+        Item* _MergeIntoStack(uint16 pos, Item* pItem2, uint32 count, bool update);
 
         CinematicMgrUPtr m_cinematicMgr;
 
@@ -2632,6 +2697,7 @@ class Player : public Unit
         uint8 m_grantableLevels;
 
         std::unordered_map<uint32, TimePoint> m_enteredInstances;
+        bool m_enteredInstancesChanged;
         uint32 m_createdInstanceClearTimer;
 
         std::map<uint32, ObjectGuid> m_followAngles;
@@ -2652,13 +2718,13 @@ template <class T> void Player::ApplySpellMod(uint32 spellId, SpellModOp op, T&
     int32 totalpct = 100;
     int32 totalflat = 0;
     std::vector<SpellModifier*> consumedFiniteMods;
-    for (SpellModifier* mod : m_spellMods[op])
+    for (SpellModifier* mod : GetSpellModsAffecting(spellInfo, op))
     {
         if (mod->op == SPELLMOD_CASTING_TIME || mod->op == SPELLMOD_COST)
             if (T((basevalue + totalflat) * std::max(0, totalpct) / 100) <= 0)
                 break;
 
-        if (!IsAffectedBySpellmod(spellInfo, mod, m_consumedMods))
+        if (!IsSpellModAvailable(mod, m_consumedMods))
             continue;
         if (mod->type == SPELLMOD_FLAT)
             totalflat += mod->value;
@@ -0,0 +1,91 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Entities/PlayerSaveScheduler.h"
+#include "Policies/Singleton.h"
+#include "Database/DatabaseEnv.h"
+#include "World/World.h"
+
+INSTANTIATE_SINGLETON_1(PlayerSaveScheduler);
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    if (!sWorld.getConfig(CONFIG_BOOL_PLAYER_SAVE_SPREAD) || !interval)
+        return;
+
+    // adaptive throttle: half rate above half of the limit, no refill above it
+    uint64 refillTime = diff;
+    bool throttled = false;
+    if (uint32 maxQueue = sWorld.getConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_ASYNC_QUEUE))
+    {
+        std::vector<uint32> sizes;
+        CharacterDatabase.GetAsyncQueueSizes(sizes);
+
+        uint32 queued = 0;
+        for (uint32 size : sizes)
+            queued += size;
+
+        if (queued > maxQueue)
+        {
+            refillTime = 0;
+            throttled = true;
+        }
+        else if (queued > maxQueue / 2)
+            refillTime /= 2;
+    }
+
+    if (throttled != m_throttled)
+    {
+        m_throttled = throttled;
+        DETAIL_LOG("PlayerSaveScheduler: periodic player saves %s", throttled ? "paused, character database async queues are full" : "resumed");
+    }
+
+    uint64 players = sWorld.GetActiveSessionCount();
+    m_refillRemainder += players * refillTime;
+    int32 refill = int32(m_refillRemainder / interval);
+    m_refillRemainder %= interval;
+
+    // allow a burst of the saves due in one second
+    int32 burst = std::max(int32(players * IN_MILLISECONDS / interval), 1);
+
+    int32 tokens = m_tokens;
+    int32 newTokens;
+    do
+        newTokens = std::min(tokens + refill, burst);
+    while (!m_tokens.compare_exchange_weak(tokens, newTokens));
+}
+
+bool PlayerSaveScheduler::TryAcquire(bool force)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_PLAYER_SAVE_SPREAD))
+        return true;
+
+    if (force)
+    {
+        --m_tokens;
+        return true;
+    }
+
+    int32 tokens = m_tokens;
+    while (tokens > 0)
+        if (m_tokens.compare_exchange_weak(tokens, tokens - 1))
+            return true;
+
+    return false;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PLAYER_SAVE_SCHEDULER_H
+#define MANGOS_PLAYER_SAVE_SCHEDULER_H
+
+#include "Common.h"
+
+#include <atomic>
+
+/// Delay before a player whose periodic save was refused asks again
+#define PLAYER_SAVE_RETRY_DELAY (1 * IN_MILLISECONDS)
+
+/**
+ * Realm wide rate limit of the periodic player saves, see PlayerSave.Spread
+ *
+ * A token bucket refilled by the world thread at online players / PlayerSave.Interval saves,
+ * so the saves do not cluster after mass logins. The refill slows down and stops while the
+ * character database async queues are above PlayerSave.MaxAsyncQueue.
+ */
+class PlayerSaveScheduler
+{
+    public:
+        PlayerSaveScheduler() : m_tokens(0), m_refillRemainder(0), m_throttled(false) {}
+
+        /// World thread only
+        void Update(uint32 diff);
+
+        /// Takes a token for a periodic save, force takes it even when the bucket is empty. Thread safe
+        bool TryAcquire(bool force);
+
+        bool IsThrottled() const { return m_throttled; }
+
+    private:
+        std::atomic<int32> m_tokens;                        ///< negative after forced saves
+        uint64 m_refillRemainder;                           ///< players * ms not yet turned into a token
+        std::atomic<bool> m_throttled;
+};
+
+#define sPlayerSaveScheduler MaNGOS::Singleton<PlayerSaveScheduler>::Instance()
+
+#endif
@@ -31,11 +31,13 @@
 #include "Entities/NPCHandler.h"
 #include "Server/SQLStorages.h"
 #include "Maps/GridDefines.h"
+#include "Server/QueryResponseCache.h"
 
 void WorldSession::SendNameQueryResponse(CharacterNameQueryResponse& response) const
 {
     // guess size
-    WorldPacket data(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 4 + 4 + 4 + 10));
+    std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_NAME_QUERY_RESPONSE, (8 + 1 + 4 + 4 + 4 + 10));
+    WorldPacket& data = *packet;
     data << response.guid;
     data << (!response.name.empty() ? response.name : GetMangosString(LANG_NON_EXIST_CHARACTER));
 
@@ -59,12 +61,36 @@ void WorldSession::SendNameQueryResponse(CharacterNameQueryResponse& response) c
             data << i;
     }
 
+    // the unknown character text is in the session locale
+    if (!response.name.empty())
+        sObjectMgr.StoreNameQueryResponse(response.guid, packet);
+
     SendPacket(data, true);
 }
 
-void WorldSession::SendNameQueryResponseFromDB(ObjectGuid guid) const
+void WorldSession::SendNameQueryResponseFromDB(ObjectGuid guid)
 {
-    CharacterDatabase.AsyncPQuery(&WorldSession::SendNameQueryResponseFromDBCallBack, GetAccountId(),
+    // declined names are not cached, cache misses are queried async below
+    PlayerDataCache cached;
+    if (!sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) && sObjectMgr.GetPlayerDataCache(guid, cached, false))
+    {
+        CharacterNameQueryResponse response;
+
+        response.guid = guid;
+        response.name = cached.name;
+        response.realm = "";
+        response.race = cached.race;
+        response.gender = cached.gender;
+        response.classid = cached.class_;
+
+        if (m_sessionState != WORLD_SESSION_STATE_READY)
+            m_offlineNameResponses.push_back(response);
+        else
+            SendNameQueryResponse(response);
+        return;
+    }
+
+    CharacterDatabase.AsyncPQuery(SqlResultRoute(GetAccountId()), &WorldSession::SendNameQueryResponseFromDBCallBack, GetAccountId(),
                                   !sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED) ?
                                   //   ------- Query Without Declined Names --------
                                   //          0     1     2     3       4
@@ -136,6 +162,11 @@ void WorldSession::HandleNameQueryOpcode(WorldPacket& recv_data)
         if (!result.second)
             return;
     }
+    else if (std::shared_ptr<WorldPacket const> response = sObjectMgr.GetNameQueryResponse(guid))
+    {
+        SendPacket(*response, true);
+        return;
+    }
 
     Player* pChar = sObjectMgr.GetPlayer(guid);
 
@@ -183,13 +214,20 @@ void WorldSession::HandleCreatureQueryOpcode(WorldPacket& recv_data)
     {
         int loc_idx = GetSessionDbLocaleIndex();
 
+        if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_CREATURE, entry, loc_idx))
+        {
+            SendPacket(*response);
+            return;
+        }
+
         char const* name = ci->Name;
         char const* subName = ci->SubName;
         sObjectMgr.GetCreatureLocaleStrings(entry, loc_idx, &name, &subName);
 
         DETAIL_LOG("WORLD: CMSG_CREATURE_QUERY '%s' - Entry: %u.", ci->Name, entry);
         // guess size
-        WorldPacket data(SMSG_CREATURE_QUERY_RESPONSE, 100);
+        std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_CREATURE_QUERY_RESPONSE, 100);
+        WorldPacket& data = *packet;
         data << uint32(entry);                              // creature entry
         data << name;
         data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4, always empty
@@ -208,6 +246,7 @@ void WorldSession::HandleCreatureQueryOpcode(WorldPacket& recv_data)
         data << float(ci->HealthMultiplier);                 // health multiplier
         data << float(ci->PowerMultiplier);                   // mana multiplier
         data << uint8(ci->RacialLeader);
+        sQueryResponseCache.Store(QUERY_RESPONSE_CREATURE, entry, loc_idx, packet);
         SendPacket(data);
         DEBUG_LOG("WORLD: Sent SMSG_CREATURE_QUERY_RESPONSE");
     }
@@ -233,11 +272,18 @@ void WorldSession::HandleGameObjectQueryOpcode(WorldPacket& recv_data)
     const GameObjectInfo* info = ObjectMgr::GetGameObjectInfo(entryID);
     if (info)
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+
+        if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_GAMEOBJECT, entryID, loc_idx))
+        {
+            SendPacket(*response);
+            return;
+        }
+
         std::string Name = info->name;
         std::string IconName = info->IconName;
         std::string CastBarCaption = info->castBarCaption;
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             GameObjectLocale const* gl = sObjectMgr.GetGameObjectLocale(entryID);
@@ -250,7 +296,8 @@ void WorldSession::HandleGameObjectQueryOpcode(WorldPacket& recv_data)
             }
         }
         DETAIL_LOG("WORLD: CMSG_GAMEOBJECT_QUERY '%s' - Entry: %u. ", info->name, entryID);
-        WorldPacket data(SMSG_GAMEOBJECT_QUERY_RESPONSE, 150);
+        std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_GAMEOBJECT_QUERY_RESPONSE, 150);
+        WorldPacket& data = *packet;
         data << uint32(entryID);
         data << uint32(info->type);
         data << uint32(info->displayId);
@@ -261,6 +308,7 @@ void WorldSession::HandleGameObjectQueryOpcode(WorldPacket& recv_data)
         data << uint8(0);                                   // 2.0.3, string
         data.append(info->raw.data, 24);
         data << float(info->size);                          // go size
+        sQueryResponseCache.Store(QUERY_RESPONSE_GAMEOBJECT, entryID, loc_idx, packet);
         SendPacket(data);
         DEBUG_LOG("WORLD: Sent SMSG_GAMEOBJECT_QUERY_RESPONSE");
     }
@@ -336,8 +384,19 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recv_data)
     DETAIL_LOG("WORLD: CMSG_NPC_TEXT_QUERY ID '%u'", textID);
 
     GossipText const* gossip = sObjectMgr.GetGossipText(textID);
+    int loc_idx = GetSessionDbLocaleIndex();
 
-    WorldPacket data(SMSG_NPC_TEXT_UPDATE, 100);            // guess size
+    if (gossip)
+    {
+        if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_NPC_TEXT, textID, loc_idx))
+        {
+            SendPacket(*response);
+            return;
+        }
+    }
+
+    std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_NPC_TEXT_UPDATE, 100);  // guess size
+    WorldPacket& data = *packet;
     data << textID;
 
     if (!gossip)
@@ -360,7 +419,6 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recv_data)
     {
         std::string Text_0[MAX_GOSSIP_TEXT_OPTIONS], Text_1[MAX_GOSSIP_TEXT_OPTIONS];
         bool locales = true;
-        int loc_idx = GetSessionDbLocaleIndex();
         for (int i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
         {
             if (gossip->Options[i].broadcastTextId)
@@ -401,6 +459,8 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recv_data)
                 data << Emote._Emote;
             }
         }
+
+        sQueryResponseCache.Store(QUERY_RESPONSE_NPC_TEXT, textID, loc_idx, packet);
     }
 
     SendPacket(data);
@@ -415,11 +475,25 @@ void WorldSession::HandlePageTextQueryOpcode(WorldPacket& recv_data)
     uint32 pageID;
     recv_data >> pageID;
 
+    int loc_idx = GetSessionDbLocaleIndex();
+
     while (pageID)
     {
         PageText const* pPage = sPageTextStore.LookupEntry<PageText>(pageID);
+
+        if (pPage)
+        {
+            if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_PAGE_TEXT, pageID, loc_idx))
+            {
+                SendPacket(*response);
+                pageID = pPage->Next_Page;
+                continue;
+            }
+        }
+
         // guess size
-        WorldPacket data(SMSG_PAGE_TEXT_QUERY_RESPONSE, 50);
+        std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_PAGE_TEXT_QUERY_RESPONSE, 50);
+        WorldPacket& data = *packet;
         data << pageID;
 
         if (!pPage)
@@ -432,7 +506,6 @@ void WorldSession::HandlePageTextQueryOpcode(WorldPacket& recv_data)
         {
             std::string Text = pPage->Text;
 
-            int loc_idx = GetSessionDbLocaleIndex();
             if (loc_idx >= 0)
             {
                 PageTextLocale const* pl = sObjectMgr.GetPageTextLocale(pageID);
@@ -445,6 +518,7 @@ void WorldSession::HandlePageTextQueryOpcode(WorldPacket& recv_data)
 
             data << Text;
             data << uint32(pPage->Next_Page);
+            sQueryResponseCache.Store(QUERY_RESPONSE_PAGE_TEXT, pageID, loc_idx, packet);
             pageID = pPage->Next_Page;
         }
         SendPacket(data);
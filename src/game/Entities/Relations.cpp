@@ -97,6 +97,10 @@ Player const* Unit::GetControllingPlayer(bool ignoreCharms/* = false*/) const
     return nullptr;
 }
 
+// Reactions of all faction template pairs, filled by Unit::InitializeFactionReactions with the original logic below
+static std::vector<uint8> s_factionReactions;
+static uint32 s_factionTemplateCount = 0;
+
 /////////////////////////////////////////////////
 /// Get faction template to faction tenplate reaction
 ///
@@ -109,6 +113,10 @@ static inline ReputationRank GetFactionReaction(FactionTemplateEntry const* this
     MANGOS_ASSERT(thisTemplate)
     MANGOS_ASSERT(otherTemplate)
 
+    // Precomputed at startup, templates only depend on DBC data
+    if (thisTemplate->ID < s_factionTemplateCount && otherTemplate->ID < s_factionTemplateCount)
+        return ReputationRank(s_factionReactions[thisTemplate->ID * s_factionTemplateCount + otherTemplate->ID]);
+
     // Original logic begins
 
     if (otherTemplate->factionGroupMask & thisTemplate->enemyGroupMask)
@@ -999,6 +1007,36 @@ bool Player::IsInGroup(Unit const* other, bool party/* = false*/, bool ignoreCha
 ########            ########
 ##########################*/
 
+/////////////////////////////////////////////////
+/// [Serverside] Precompute faction template to faction template reactions
+///
+/// @note Relations API Tier 3
+///
+/// Fills the table consulted by GetFactionReaction for every pair of faction templates.
+/// Must be called once at startup, after DBC data has been loaded and before any map is updated.
+/////////////////////////////////////////////////
+void Unit::InitializeFactionReactions()
+{
+    uint32 const count = sFactionTemplateStore.GetNumRows();
+
+    std::vector<uint8> reactions(size_t(count) * count, uint8(REP_NEUTRAL));
+    for (uint32 i = 0; i < count; ++i)
+    {
+        FactionTemplateEntry const* thisTemplate = sFactionTemplateStore.LookupEntry(i);
+        if (!thisTemplate)
+            continue;
+
+        for (uint32 j = 0; j < count; ++j)
+        {
+            if (FactionTemplateEntry const* otherTemplate = sFactionTemplateStore.LookupEntry(j))
+                reactions[size_t(i) * count + j] = uint8(GetFactionReaction(thisTemplate, otherTemplate));
+        }
+    }
+
+    s_factionReactions = std::move(reactions);
+    s_factionTemplateCount = count;
+}
+
 /////////////////////////////////////////////////
 /// [Serverside] Get player to corpse reaction
 ///
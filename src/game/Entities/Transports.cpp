@@ -20,6 +20,7 @@
 
 #include "Entities/Transports.h"
 #include "Maps/MapManager.h"
+#include "World/World.h"
 #include "Globals/ObjectMgr.h"
 #include "Entities/ObjectGuid.h"
 #include "MotionGenerators/Path.h"
@@ -354,7 +355,8 @@ bool GenericTransport::AddPetToTransport(Unit* passenger, Pet* pet)
 
 void Transport::Update(const uint32 /*diff*/)
 {
-    uint32 const positionUpdateDelay = 50;
+    // without passengers only the collision model follows the path, at a slower pace
+    uint32 const positionUpdateDelay = GetPassengers().empty() ? TRANSPORT_PASSIVE_UPDATE_DELAY : TRANSPORT_TIMETABLE_STEP;
 
     if (GetKeyFrames().size() <= 1)
         return;
@@ -402,53 +404,17 @@ void Transport::Update(const uint32 /*diff*/)
         DETAIL_FILTER_LOG(LOG_FILTER_TRANSPORT_MOVES, "%s moved to %f %f %f %d", GetName(), m_currentFrame->Node->x, m_currentFrame->Node->y, m_currentFrame->Node->z, m_currentFrame->Node->mapid);
     }
 
-    // Set position
+    // Set position, a passenger boarding a passive transport gets it up to date at once
     m_positionChangeTimer.Update(diff);
-    if (m_positionChangeTimer.Passed())
+    if (m_positionChangeTimer.Passed() || m_positionChangeTimer.GetExpiry() > positionUpdateDelay)
     {
         m_positionChangeTimer.Reset(positionUpdateDelay);
-        if (IsMoving() && pathProgress)
-        {
-            float t = CalculateSegmentPos(float(pathProgress) * 0.001f);
-            G3D::Vector3 pos, dir;
-            m_currentFrame->Spline->evaluate_percent(m_currentFrame->Index, t, pos);
-            m_currentFrame->Spline->evaluate_derivative(m_currentFrame->Index, t, dir);
-            UpdatePosition(pos.x, pos.y, pos.z, atan2(dir.y, dir.x) + M_PI);
-        }
+        float x, y, z, o;
+        if (IsMoving() && pathProgress && m_transportTemplate.timetable.GetPosition(pathProgress, x, y, z, o))
+            UpdatePosition(x, y, z, o);
     }
 }
 
-float Transport::CalculateSegmentPos(float now)
-{
-    KeyFrame const& frame = *m_currentFrame;
-    float const speed = float(m_goInfo->moTransport.moveSpeed);
-    float const accel = float(m_goInfo->moTransport.accelRate);
-    float timeSinceStop = frame.TimeFrom + (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
-    float timeUntilStop = frame.TimeTo - (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
-    float segmentPos, dist;
-    float accelTime = m_transportTemplate.accelTime;
-    float accelDist = m_transportTemplate.accelDist;
-    // calculate from nearest stop, less confusing calculation...
-    if (timeSinceStop < timeUntilStop)
-    {
-        if (timeSinceStop < accelTime)
-            dist = 0.5f * accel * timeSinceStop * timeSinceStop;
-        else
-            dist = accelDist + (timeSinceStop - accelTime) * speed;
-        segmentPos = dist - frame.DistSinceStop;
-    }
-    else
-    {
-        if (timeUntilStop < m_transportTemplate.accelTime)
-            dist = 0.5f * accel * timeUntilStop * timeUntilStop;
-        else
-            dist = accelDist + (timeUntilStop - accelTime) * speed;
-        segmentPos = frame.DistUntilStop - dist;
-    }
-
-    return segmentPos / frame.NextDistFromPrev;
-}
-
 bool ElevatorTransport::Create(uint32 dbGuid, uint32 guidlow, uint32 name_id, Map* map, float x, float y, float z, float ang, float rotation0, float rotation1, float rotation2, float rotation3, uint32 animprogress, GOState go_state)
 {
     if (GenericTransport::Create(dbGuid, guidlow, name_id, map, x, y, z, ang, rotation0, rotation1, rotation2, rotation3, animprogress, go_state))
@@ -507,11 +473,30 @@ void GenericTransport::UpdatePosition(float x, float y, float z, float o)
 
 void GenericTransport::UpdatePassengerPositions(PassengerSet& passengers)
 {
+    // passengers keep their transport offsets, move all of them first
+    for (const auto passenger : passengers)
+        UpdatePassengerPosition(passenger, false);
+
+    // then update visibility once the transport moved far enough, instead of a check per passenger
+    float dx = m_passengersNotifiedPosition.x - GetPositionX();
+    float dy = m_passengersNotifiedPosition.y - GetPositionY();
+    float dz = m_passengersNotifiedPosition.z - GetPositionZ();
+    bool updateVisibility = dx * dx + dy * dy + dz * dz > World::GetRelocationLowerLimitSq();
+    if (updateVisibility)
+    {
+        m_passengersNotifiedPosition.x = GetPositionX();
+        m_passengersNotifiedPosition.y = GetPositionY();
+        m_passengersNotifiedPosition.z = GetPositionZ();
+    }
+
+    m_relocatingPassengers = true;
     for (const auto passenger : passengers)
-        UpdatePassengerPosition(passenger);
+        if (passenger->IsUnit() && passenger->IsInWorld() && passenger->GetMap() == GetMap())
+            static_cast<Unit*>(passenger)->OnTransportRelocated(updateVisibility);
+    m_relocatingPassengers = false;
 }
 
-void GenericTransport::UpdatePassengerPosition(WorldObject* passenger)
+void GenericTransport::UpdatePassengerPosition(WorldObject* passenger, bool notify)
 {
     // transport teleported but passenger not yet (can happen for players)
     if (passenger->IsInWorld() && passenger->GetMap() != GetMap())
@@ -541,7 +526,7 @@ void GenericTransport::UpdatePassengerPosition(WorldObject* passenger)
         {
             Creature* creature = dynamic_cast<Creature*>(passenger);
             if (passenger->IsInWorld())
-                GetMap()->CreatureRelocation(creature, x, y, z, o);
+                GetMap()->CreatureRelocation(creature, x, y, z, o, notify);
             else
                 passenger->Relocate(x, y, z, o);
             creature->m_movementInfo.t_time = GetPathProgress();
@@ -550,7 +535,7 @@ void GenericTransport::UpdatePassengerPosition(WorldObject* passenger)
         case TYPEID_PLAYER:
             //relocate only passengers in world and skip any player that might be still logging in/teleporting
             if (passenger->IsInWorld())
-                GetMap()->PlayerRelocation(dynamic_cast<Player*>(passenger), x, y, z, o);
+                GetMap()->PlayerRelocation(dynamic_cast<Player*>(passenger), x, y, z, o, notify);
             else
             {
                 passenger->Relocate(x, y, z, o);
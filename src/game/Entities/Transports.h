@@ -27,16 +27,21 @@
 
 typedef std::set<WorldObject*> PassengerSet;
 
+#define TRANSPORT_PASSIVE_UPDATE_DELAY 1000                 // ms between position updates of a transport without passengers
+
 class GenericTransport : public GameObject
 {
     public:
-        GenericTransport() : m_passengerTeleportIterator(m_passengers.end()), m_pathProgress(0), m_movementStarted(0) {}
+        GenericTransport() : m_passengerTeleportIterator(m_passengers.end()), m_pathProgress(0), m_movementStarted(0), m_relocatingPassengers(false) {}
         bool AddPassenger(Unit* passenger, bool adjustCoords = true);
         bool RemovePassenger(Unit* passenger);
         bool AddPetToTransport(Unit* passenger, Pet* pet);
 
         void UpdatePosition(float x, float y, float z, float o);
-        void UpdatePassengerPosition(WorldObject* object);
+        void UpdatePassengerPosition(WorldObject* object, bool notify = true);
+
+        // passengers moved by the transport are notified as a group, their visibility between each other is unchanged
+        bool IsRelocatingPassengers() const { return m_relocatingPassengers; }
 
         typedef std::set<Player*> PlayerSet;
         PassengerSet& GetPassengers() { return m_passengers; }
@@ -67,6 +72,9 @@ class GenericTransport : public GameObject
 
         uint32 m_pathProgress; // for MO transport its full time since start for normal time in cycle
         uint32 m_movementStarted;
+
+        Position m_passengersNotifiedPosition;               // transport position at the last visibility update of the passengers
+        bool m_relocatingPassengers;
 };
 
 class ElevatorTransport : public GenericTransport
@@ -99,7 +107,6 @@ class Transport : public GenericTransport
         void UpdateForMap(Map const* targetMap, bool newMap);
         void DoEventIfAny(TaxiPathNodeEntry const& node, bool departure);
         void MoveToNextWayPoint();                          // move m_next/m_cur to next points
-        float CalculateSegmentPos(float perc);
 
         bool IsMoving() const { return m_isMoving; }
         void SetMoving(bool val) { m_isMoving = val; }
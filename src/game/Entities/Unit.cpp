@@ -50,6 +50,8 @@
 #include "Tools/Formulas.h"
 #include "Entities/Transports.h"
 #include "Anticheat/Anticheat.hpp"
+#include "AI/ScriptDevAI/ScriptProfiler.h"
+#include "Maps/ZoneStats.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
@@ -269,42 +271,45 @@ void MovementInfo::Read(ByteBuffer& data)
 
 void MovementInfo::Write(ByteBuffer& data) const
 {
-    data << moveFlags;
-    data << moveFlags2;
-    data << stime;
-    data << pos.x;
-    data << pos.y;
-    data << pos.z;
-    data << pos.o;
+    // flags, time, position, transport, pitch, fall time, jump, spline elevation
+    ByteBufferWriter writer(data, (4 + 1 + 4 + 16) + (8 + 16 + 4) + 4 + 4 + 16 + 4);
+
+    writer << moveFlags;
+    writer << moveFlags2;
+    writer << stime;
+    writer << pos.x;
+    writer << pos.y;
+    writer << pos.z;
+    writer << pos.o;
 
     if (HasMovementFlag(MOVEFLAG_ONTRANSPORT))
     {
-        data << t_guid;
-        data << t_pos.x;
-        data << t_pos.y;
-        data << t_pos.z;
-        data << t_pos.o;
-        data << t_time;
+        writer << t_guid.GetRawValue();
+        writer << t_pos.x;
+        writer << t_pos.y;
+        writer << t_pos.z;
+        writer << t_pos.o;
+        writer << t_time;
     }
 
     if (HasMovementFlag(MovementFlags(MOVEFLAG_SWIMMING | MOVEFLAG_FLYING2)))
     {
-        data << s_pitch;
+        writer << s_pitch;
     }
 
-    data << fallTime;
+    writer << fallTime;
 
     if (HasMovementFlag(MOVEFLAG_FALLING))
     {
-        data << jump.zspeed;
-        data << jump.cosAngle;
-        data << jump.sinAngle;
-        data << jump.xyspeed;
+        writer << jump.zspeed;
+        writer << jump.cosAngle;
+        writer << jump.sinAngle;
+        writer << jump.xyspeed;
     }
 
     if (HasMovementFlag(MOVEFLAG_SPLINE_ELEVATION))
     {
-        data << u_unk1;
+        writer << u_unk1;
     }
 }
 
@@ -363,6 +368,9 @@ Unit::Unit() :
     // m_AurasCheck = 2000;
     // m_removeAuraTimer = 4;
     m_spellAuraHoldersUpdateIterator = m_spellAuraHolders.end();
+    memset(m_procFlagHolderCount, 0, sizeof(m_procFlagHolderCount));
+    m_auraProcFlags = 0;
+    m_auraModifierEpoch = 1;
     m_AuraFlags = 0;
 
     m_Visibility = VISIBILITY_ON;
@@ -370,6 +378,8 @@ Unit::Unit() :
 
     m_transform = 0;
     m_canModifyStats = false;
+    m_statModifierBatch = 0;
+    m_dirtyUnitModsMask = 0;
 
     for (auto& i : m_spellImmune)
         i.clear();
@@ -470,13 +480,13 @@ void Unit::Update(const uint32 diff)
     if (!IsInWorld())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update", {
+    auto meas = metric::make_slow_span<std::chrono::microseconds>("unit.update", 1000, [&] { return std::map<std::string, std::string> {
         { "entry", std::to_string(GetEntry()) },
         { "guid", std::to_string(GetGUIDLow()) },
         { "unit_type", std::to_string(GetGUIDHigh()) },
         { "map_id", std::to_string(GetMapId()) },
         { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    }; });
 #endif
 
     /*if(p_time > m_AurasCheck)
@@ -491,9 +501,12 @@ void Unit::Update(const uint32 diff)
     // Or else we may have some SPELL_STATE_FINISHED spells stalled in pointers, that is bad.
     m_spellUpdateHappening = true;
 
-    UpdateCooldowns(GetMap()->GetCurrentClockTime());
-    m_events.Update(diff);
-    _UpdateSpells(diff);
+    {
+        ZoneStatsScope zoneStats(ZONE_STATS_SPELLS, this);
+        UpdateCooldowns(GetMap()->GetCurrentClockTime());
+        m_events.Update(diff);
+        _UpdateSpells(diff);
+    }
     m_spellUpdateHappening = false;
 
     CleanupDeletedAuras();
@@ -521,15 +534,17 @@ void Unit::Update(const uint32 diff)
     if (AI() && IsAlive())
     {
 #ifdef BUILD_METRICS
-        metric::duration<std::chrono::microseconds> meas_ai("unit.update.ai", {
+        auto meas_ai = metric::make_slow_span<std::chrono::microseconds>("unit.update.ai", 1000, [&] { return std::map<std::string, std::string> {
             { "entry", std::to_string(GetEntry()) },
             { "guid", std::to_string(GetGUIDLow()) },
             { "unit_type", std::to_string(GetGUIDHigh()) },
             { "map_id", std::to_string(GetMapId()) },
             { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
+        }; });
 #endif
 
+        ScriptProfileScope profile(SCRIPT_PROFILE_UPDATE_AI, GetTypeId() == TYPEID_UNIT ? static_cast<Creature*>(this)->GetScriptId() : 0, GetMapId());
+        ZoneStatsScope zoneStats(ZONE_STATS_AI, this);
         AI()->UpdateAI(diff);   // AI not react good at real update delays (while freeze in non-active part of map)
     }
 
@@ -1394,7 +1409,10 @@ void Unit::JustKilledCreature(Unit* killer, Creature* victim, Player* responsibl
     /* ******************************* Inform various hooks ************************************ */
     // Inform victim's AI
     if (victim->AI())
+    {
+        ScriptProfileScope profile(SCRIPT_PROFILE_JUST_DIED, victim->GetTypeId() == TYPEID_UNIT ? static_cast<Creature*>(victim)->GetScriptId() : 0, victim->GetMapId());
         victim->AI()->JustDied(killer);
+    }
 
     // Inform Owner
     Unit* pOwner = victim->GetMaster();
@@ -2611,6 +2629,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* caster, SpellSchoolMask schoolMa
             mod->m_amount -= currentAbsorb;
             if ((*i)->GetHolder()->DropAuraCharge())
                 mod->m_amount = 0;
+            InvalidateAuraModifierCache();
             // Need remove it later
             if (mod->m_amount <= 0)
                 existExpired = true;
@@ -2670,6 +2689,7 @@ void Unit::CalculateDamageAbsorbAndResist(Unit* caster, SpellSchoolMask schoolMa
         (*i)->OnManaAbsorb(currentAbsorb);
 
         (*i)->GetModifier()->m_amount -= currentAbsorb;
+        InvalidateAuraModifierCache();
         if ((*i)->GetModifier()->m_amount <= 0)
         {
             RemoveAurasDueToSpell((*i)->GetId());
@@ -3007,7 +3027,7 @@ void Unit::SendMeleeAttackStart(Unit* pVictim) const
 
 void Unit::SendMeleeAttackStop(Unit* victim) const
 {
-    WorldPacket data(SMSG_ATTACKSTOP, (4 + 16));            // we guess size
+    WorldPacket data(SMSG_ATTACKSTOP, (9 + 9 + 4));
     data << GetPackGUID();
     data << (victim ? victim->GetPackGUID() : PackedGuid());
     data << uint32(IsDead() ? 1 : 0);
@@ -4409,13 +4429,13 @@ uint32 Unit::GetWeaponSkillValue(WeaponAttackType attType, Unit const* target) c
 void Unit::_UpdateSpells(uint32 time)
 {
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.update.spells", {
+    auto meas = metric::make_slow_span<std::chrono::microseconds>("unit.update.spells", 1000, [&] { return std::map<std::string, std::string> {
         { "entry", std::to_string(GetEntry()) },
         { "guid", std::to_string(GetGUIDLow()) },
         { "unit_type", std::to_string(GetGUIDHigh()) },
         { "map_id", std::to_string(GetMapId()) },
         { "instance_id", std::to_string(GetInstanceId()) }
-        }, 1000);
+        }; });
 
     std::vector<uint32> updatedSpellIds;
 #endif
@@ -4459,10 +4479,13 @@ void Unit::_UpdateSpells(uint32 time)
             ++iter;
     }
 #ifdef BUILD_METRICS
-    std::string logging;
-    for (uint32 spellId : updatedSpellIds)
-        logging += std::to_string(spellId) + ",";
-    meas.add_field("spells", "\"" + logging + "\"");
+    if (meas.slow())
+    {
+        std::string logging;
+        for (uint32 spellId : updatedSpellIds)
+            logging += std::to_string(spellId) + ",";
+        meas.add_field("spells", "\"" + logging + "\"");
+    }
 #endif
 }
 
@@ -4825,94 +4848,167 @@ void Unit::DeMorph()
     SetDisplayId(GetNativeDisplayId());
 }
 
+Unit::AuraModifierCacheEntry& Unit::GetAuraModifierCacheEntry(AuraType auratype, AuraModifierCacheKind kind, int32 misc) const
+{
+    uint32 hash = (uint32(auratype) * AURA_MODIFIER_CACHE_KIND_MAX + kind) * 2654435761u ^ uint32(misc);
+    return m_auraModifierCache[(hash >> 16) % AURA_MODIFIER_CACHE_SIZE];
+}
+
+bool Unit::IsAuraModifierCached(AuraModifierCacheEntry const& entry, AuraType auratype, AuraModifierCacheKind kind, int32 misc) const
+{
+    return entry.epoch == m_auraModifierEpoch && entry.auraType == auratype && entry.kind == kind && entry.misc == misc;
+}
+
+void Unit::StoreAuraModifierCache(AuraModifierCacheEntry& entry, AuraType auratype, AuraModifierCacheKind kind, int32 misc) const
+{
+    entry.epoch = m_auraModifierEpoch;
+    entry.auraType = uint16(auratype);
+    entry.kind = uint8(kind);
+    entry.misc = misc;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_TOTAL, 0);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_TOTAL, 0))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
         modifier += i->GetModifier()->m_amount;
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_TOTAL, 0);
+    cache.amount = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MULTIPLIER, 0);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER, 0))
+        return cache.multiplier;
+
     float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
         multiplier *= (100.0f + i->GetModifier()->m_amount) / 100.0f;
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER, 0);
+    cache.multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE, 0);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE, 0))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
         if (i->GetModifier()->m_amount > modifier)
             modifier = i->GetModifier()->m_amount;
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE, 0);
+    cache.amount = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE, 0);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE, 0))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
         if (i->GetModifier()->m_amount < modifier)
             modifier = i->GetModifier()->m_amount;
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE, 0);
+    cache.amount = modifier;
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (!misc_mask || mTotalAuraList.empty())
         return 0;
 
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_TOTAL_BY_MASK, int32(misc_mask));
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_TOTAL_BY_MASK, int32(misc_mask)))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
         if (mod->m_miscvalue & misc_mask)
             modifier += mod->m_amount;
     }
+
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_TOTAL_BY_MASK, int32(misc_mask));
+    cache.amount = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (!misc_mask || mTotalAuraList.empty())
         return 1.0f;
 
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MASK, int32(misc_mask));
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MASK, int32(misc_mask)))
+        return cache.multiplier;
+
     float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
         if (mod->m_miscvalue & misc_mask)
             multiplier *= (100.0f + mod->m_amount) / 100.0f;
     }
+
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_MASK, int32(misc_mask));
+    cache.multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (!misc_mask || mTotalAuraList.empty())
         return 0;
 
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MASK, int32(misc_mask));
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MASK, int32(misc_mask)))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
@@ -4920,17 +5016,23 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = mod->m_amount;
     }
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MASK, int32(misc_mask));
+    cache.amount = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    if (!misc_mask)
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (!misc_mask || mTotalAuraList.empty())
         return 0;
 
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MASK, int32(misc_mask));
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MASK, int32(misc_mask)))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
@@ -4938,42 +5040,71 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_
             modifier = mod->m_amount;
     }
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MASK, int32(misc_mask));
+    cache.amount = modifier;
     return modifier;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_TOTAL_BY_VALUE, misc_value);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_TOTAL_BY_VALUE, misc_value))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
         if (mod->m_miscvalue == misc_value)
             modifier += mod->m_amount;
     }
+
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_TOTAL_BY_VALUE, misc_value);
+    cache.amount = modifier;
     return modifier;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 1.0f;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_VALUE, misc_value);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_VALUE, misc_value))
+        return cache.multiplier;
+
     float multiplier = 1.0f;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
         if (mod->m_miscvalue == misc_value)
             multiplier *= (100.0f + mod->m_amount) / 100.0f;
     }
+
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MULTIPLIER_BY_VALUE, misc_value);
+    cache.multiplier = multiplier;
     return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_VALUE, misc_value);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_VALUE, misc_value))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
@@ -4981,14 +5112,23 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = mod->m_amount;
     }
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_VALUE, misc_value);
+    cache.amount = modifier;
     return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
+    AuraList const& mTotalAuraList = GetAurasByType(auratype);
+    if (mTotalAuraList.empty())
+        return 0;
+
+    AuraModifierCacheEntry& cache = GetAuraModifierCacheEntry(auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_VALUE, misc_value);
+    if (IsAuraModifierCached(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_VALUE, misc_value))
+        return cache.amount;
+
     int32 modifier = 0;
 
-    AuraList const& mTotalAuraList = GetAurasByType(auratype);
     for (auto i : mTotalAuraList)
     {
         Modifier* mod = i->GetModifier();
@@ -4996,6 +5136,8 @@ int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_
             modifier = mod->m_amount;
     }
 
+    StoreAuraModifierCache(cache, auratype, AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_VALUE, misc_value);
+    cache.amount = modifier;
     return modifier;
 }
 
@@ -5164,6 +5306,10 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
     holder->_AddSpellAuraHolder();
     holder->SetCreationDelayFlag();
     m_spellAuraHolders.insert(SpellAuraHolderMap::value_type(holder->GetId(), holder));
+    UpdateAuraProcFlags(holder, true);
+
+    if (GetTypeId() == TYPEID_PLAYER)
+        static_cast<Player*>(this)->ConditionStateChanged(CONDITION_STATE_AURAS);
 
     for (int32 i = 0; i < MAX_EFFECT_INDEX; ++i)
         if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
@@ -5188,7 +5334,10 @@ bool Unit::AddSpellAuraHolder(SpellAuraHolder* holder)
 void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
+    {
         m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        InvalidateAuraModifierCache();
+    }
 }
 
 void Unit::RemoveRankAurasDueToSpell(uint32 spellId)
@@ -5705,10 +5854,31 @@ void Unit::RemoveNotOwnTrackedTargetAuras()
     }
 }
 
+void Unit::UpdateAuraProcFlags(SpellAuraHolder const* holder, bool add)
+{
+    for (uint32 flags = holder->GetProcFlags(); flags; flags &= flags - 1)
+    {
+        uint32 bit = 0;
+        while (!(flags & (1u << bit)))
+            ++bit;
+
+        if (add)
+        {
+            if (m_procFlagHolderCount[bit]++ == 0)
+                m_auraProcFlags |= 1u << bit;
+        }
+        else if (--m_procFlagHolderCount[bit] == 0)
+            m_auraProcFlags &= ~(1u << bit);
+    }
+}
+
 void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
 {
     MANGOS_ASSERT(!holder->IsDeleted());
 
+    if (GetTypeId() == TYPEID_PLAYER)
+        static_cast<Player*>(this)->ConditionStateChanged(CONDITION_STATE_AURAS);
+
     // Statue unsummoned at holder remove
     SpellEntry const* aurSpellInfo = holder->GetSpellProto();
     Totem* statue = nullptr;
@@ -5726,6 +5896,7 @@ void Unit::RemoveSpellAuraHolder(SpellAuraHolder* holder, AuraRemoveMode mode)
         if (itr->second == holder)
         {
             m_spellAuraHolders.erase(itr);
+            UpdateAuraProcFlags(holder, false);
             break;
         }
     }
@@ -5789,6 +5960,7 @@ void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
     if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
     {
         m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        InvalidateAuraModifierCache();
     }
 
     // Set remove mode
@@ -6273,7 +6445,7 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
         }
     }
 
-    log->attacker->SendMessageToSet(data, true);
+    log->attacker->SendCombatLogToSet(data);
 }
 
 void Unit::SendSpellNonMeleeDamageLog(WorldObject* attacker, Unit* target, uint32 spellID, uint32 damage, SpellSchoolMask damageSchoolMask, uint32 absorbedDamage, int32 resist, bool isPeriodic, uint32 blocked, bool criticalHit, bool split)
@@ -6333,7 +6505,7 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo) const
             return;
     }
 
-    aura->GetTarget()->SendMessageToSet(data, true);
+    aura->GetTarget()->SendCombatLogToSet(data);
 }
 
 void Unit::SendSpellMiss(WorldObject* caster, Unit* target, uint32 spellID, SpellMissInfo missInfo)
@@ -6347,7 +6519,7 @@ void Unit::SendSpellMiss(WorldObject* caster, Unit* target, uint32 spellID, Spel
     data << target->GetObjectGuid();                        // target GUID
     data << uint8(missInfo);
     // end loop
-    caster->SendMessageToSet(data, true);
+    caster->SendCombatLogToSet(data);
 }
 
 void Unit::SendSpellDamageResist(Unit* target, uint32 spellId) const
@@ -6526,7 +6698,7 @@ void Unit::SendAttackStateUpdate(CalcDamageInfo* calcDamageInfo) const
         data << uint32(0);
     }
 
-    SendMessageToSet(data, true);
+    SendCombatLogToSet(data);
 }
 
 void Unit::SendAttackStateUpdate(uint32 HitInfo, Unit* target, SpellSchoolMask damageSchoolMask, uint32 Damage,
@@ -7375,7 +7547,7 @@ void Unit::SendHealSpellLog(Unit* pVictim, uint32 SpellID, uint32 Damage, bool c
     data << uint32(Damage);
     data << uint8(critical ? 1 : 0);
     data << uint8(0);                                       // unused in client?
-    SendMessageToSet(data, true);
+    SendCombatLogToSet(data);
 }
 
 void Unit::SendEnergizeSpellLog(Unit* pVictim, uint32 SpellID, uint32 Damage, Powers powertype) const
@@ -7386,7 +7558,7 @@ void Unit::SendEnergizeSpellLog(Unit* pVictim, uint32 SpellID, uint32 Damage, Po
     data << uint32(SpellID);
     data << uint32(powertype);
     data << uint32(Damage);
-    SendMessageToSet(data, true);
+    SendCombatLogToSet(data);
 }
 
 void Unit::SendEnvironmentalDamageLog(uint8 type, uint32 damage, uint32 absorb, int32 resist) const
@@ -9714,6 +9886,36 @@ bool Unit::HandleStatModifier(UnitMods unitMod, UnitModifierType modifierType, f
     if (!CanModifyStats())
         return false;
 
+    if (m_statModifierBatch)
+    {
+        m_dirtyUnitModsMask |= (1 << unitMod);
+        return true;
+    }
+
+    UpdateUnitModDerivedStats(unitMod);
+    return true;
+}
+
+void Unit::EndStatModifierBatch()
+{
+    MANGOS_ASSERT(m_statModifierBatch);
+
+    if (--m_statModifierBatch || !m_dirtyUnitModsMask)
+        return;
+
+    uint32 dirtyMask = m_dirtyUnitModsMask;
+    m_dirtyUnitModsMask = 0;
+
+    if (!CanModifyStats())
+        return;
+
+    for (uint32 i = 0; i < UNIT_MOD_END; ++i)
+        if (dirtyMask & (1 << i))
+            UpdateUnitModDerivedStats(UnitMods(i));
+}
+
+void Unit::UpdateUnitModDerivedStats(UnitMods unitMod)
+{
     switch (unitMod)
     {
         case UNIT_MOD_STAT_STRENGTH:
@@ -9748,8 +9950,6 @@ bool Unit::HandleStatModifier(UnitMods unitMod, UnitModifierType modifierType, f
         default:
             break;
     }
-
-    return true;
 }
 
 float Unit::GetModifierValue(UnitMods unitMod, UnitModifierType modifierType) const
@@ -10961,6 +11161,7 @@ void Unit::UpdateModelData()
         SetFloatValue(UNIT_FIELD_BOUNDINGRADIUS, GetObjectScale() * modelInfo->bounding_radius);
 
         SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+        UpdateCellPositionIndex();
 
         SetBaseWalkSpeed(modelInfo->SpeedWalk);
         SetBaseRunSpeed(modelInfo->SpeedRun, false);
@@ -11737,12 +11938,36 @@ void Unit::OnRelocated()
         m_last_notified_position.y = GetPositionY();
         m_last_notified_position.z = GetPositionZ();
 
-        GetViewPoint().Call_UpdateVisibilityForOwner();
-        UpdateObjectVisibility();
+        if (sWorld.getConfig(CONFIG_UINT32_RELOCATION_NOTIFY_BUDGET))
+            GetMap()->ScheduleRelocationNotify(this);
+        else
+            NotifyRelocation();
     }
     ScheduleAINotify(World::GetRelocationAINotifyDelay());
 }
 
+void Unit::OnTransportRelocated(bool updateVisibility)
+{
+    if (updateVisibility)
+    {
+        m_last_notified_position.x = GetPositionX();
+        m_last_notified_position.y = GetPositionY();
+        m_last_notified_position.z = GetPositionZ();
+
+        if (sWorld.getConfig(CONFIG_UINT32_RELOCATION_NOTIFY_BUDGET))
+            GetMap()->ScheduleRelocationNotify(this);
+        else
+            NotifyRelocation();
+    }
+    ScheduleAINotify(World::GetRelocationAINotifyDelay());
+}
+
+void Unit::NotifyRelocation()
+{
+    GetViewPoint().Call_UpdateVisibilityAfterMove();
+    UpdateObjectVisibility();
+}
+
 void Unit::UpdateSplineMovement(uint32 t_diff)
 {
     enum
@@ -11753,13 +11978,13 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     if (movespline->Finalized())
         return;
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("unit.updatesplinemovement", {
+    auto meas = metric::make_slow_span<std::chrono::microseconds>("unit.updatesplinemovement", 1000, [&] { return std::map<std::string, std::string> {
         { "entry", std::to_string(GetEntry()) },
         { "guid", std::to_string(GetGUIDLow()) },
         { "unit_type", std::to_string(GetGUIDHigh()) },
         { "map_id", std::to_string(GetMapId()) },
         { "instance_id", std::to_string(GetInstanceId()) }
-    }, 1000);
+    }; });
 #endif
     movespline->updateState(t_diff);
     bool arrived = movespline->Finalized();
@@ -11770,7 +11995,7 @@ void Unit::UpdateSplineMovement(uint32 t_diff)
     m_movesplineTimer.Update(t_diff);
     if (m_movesplineTimer.Passed() || arrived)
     {
-        m_movesplineTimer.Reset(POSITION_UPDATE_DELAY);
+        m_movesplineTimer.Reset(IsTaxiFlying() ? sWorld.getConfig(CONFIG_UINT32_TAXI_POSITION_UPDATE_INTERVAL) : uint32(POSITION_UPDATE_DELAY));
         UpdateSplinePosition();
     }
 }
@@ -12549,11 +12774,16 @@ void Unit::InterruptSpellsCastedOnMe(bool killDelayed)
         if (!killDelayed)
             continue;
         // 2/ Interrupt spells that are not referenced but that still have an event (like delayed spell)
-        for (auto i_events = target->m_events.GetEvents().begin(); i_events != target->m_events.GetEvents().end(); ++i_events)
-            if (SpellEvent* event = dynamic_cast<SpellEvent*>(i_events->second))
-                if (event && event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
+        std::vector<Spell*> delayedSpells;
+        target->m_events.ForEachEvent([&](BasicEvent* basicEvent)
+        {
+            if (SpellEvent* event = dynamic_cast<SpellEvent*>(basicEvent))
+                if (event->GetSpell()->m_targets.getUnitTargetGuid() == GetObjectGuid())
                     if (event->GetSpell()->getState() != SPELL_STATE_FINISHED)
-                        event->GetSpell()->cancel();
+                        delayedSpells.push_back(event->GetSpell());
+        });
+        for (Spell* spell : delayedSpells)
+            spell->cancel();
     }
 }
 
@@ -13151,7 +13381,7 @@ void Unit::SetSwim(bool enable)
     if (!IsInWorld()) // is sent on add to map
         return;
 
-    WorldPacket data(enable ? SMSG_SPLINE_MOVE_START_SWIM : SMSG_SPLINE_MOVE_STOP_SWIM);
+    WorldPacket data(enable ? SMSG_SPLINE_MOVE_START_SWIM : SMSG_SPLINE_MOVE_STOP_SWIM, 9);
     data << GetPackGUID();
     SendMessageToSet(data, true);
 }
@@ -13229,7 +13459,7 @@ void Unit::SetFeatherFall(bool enable)
         }
     }
 
-    WorldPacket data(enable ? SMSG_SPLINE_MOVE_FEATHER_FALL : SMSG_SPLINE_MOVE_NORMAL_FALL);
+    WorldPacket data(enable ? SMSG_SPLINE_MOVE_FEATHER_FALL : SMSG_SPLINE_MOVE_NORMAL_FALL, 9);
     data << GetPackGUID();
     SendMessageToSet(data, true);
 }
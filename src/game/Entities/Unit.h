@@ -39,6 +39,7 @@
 #include "MotionGenerators/FollowerReference.h"
 #include "MotionGenerators/FollowerRefManager.h"
 #include "Utilities/EventProcessor.h"
+#include "Utilities/ObjectPool.h"
 #include "MotionGenerators/MotionMaster.h"
 #include "Server/DBCStructure.h"
 #include "WorldPacket.h"
@@ -1100,7 +1101,8 @@ class Unit : public WorldObject
 {
     public:
         typedef std::set<Unit*> AttackerSet;
-        typedef std::multimap<uint32 /*spellId*/, SpellAuraHolder*> SpellAuraHolderMap;
+        // tree nodes come from thread free lists, holders are added and removed all the time
+        typedef std::multimap<uint32 /*spellId*/, SpellAuraHolder*, std::less<uint32>, MaNGOS::PoolAllocator<std::pair<const uint32, SpellAuraHolder*>>> SpellAuraHolderMap;
         typedef std::pair<SpellAuraHolderMap::iterator, SpellAuraHolderMap::iterator> SpellAuraHolderBounds;
         typedef std::pair<SpellAuraHolderMap::const_iterator, SpellAuraHolderMap::const_iterator> SpellAuraHolderConstBounds;
         typedef std::list<SpellAuraHolder*> SpellAuraHolderList;
@@ -1399,6 +1401,8 @@ class Unit : public WorldObject
 
         Player const* GetControllingPlayer(bool ignoreCharms = false) const;
 
+        static void InitializeFactionReactions();
+
         ReputationRank GetReactionTo(Unit const* unit) const override;
         ReputationRank GetReactionTo(Corpse const* corpse) const override;
 
@@ -2014,6 +2018,9 @@ class Unit : public WorldObject
         Powers GetPowerTypeByAuraGroup(UnitMods unitMod) const;
         bool CanModifyStats() const { return m_canModifyStats; }
         void SetCanModifyStats(bool modifyStats) { m_canModifyStats = modifyStats; }
+        // while a batch is open stat modifier changes only mark their group, derived values are recomputed once when it closes
+        void BeginStatModifierBatch() { ++m_statModifierBatch; }
+        void EndStatModifierBatch();
         virtual bool UpdateStats(Stats stat) = 0;
         virtual bool UpdateAllStats() = 0;
         virtual void UpdateResistances(uint32 school) = 0;
@@ -2113,6 +2120,9 @@ class Unit : public WorldObject
         int32 GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const;
         int32 GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const;
 
+        // drops the cached aura totals, needed after changing Modifier::m_amount of an applied aura directly
+        void InvalidateAuraModifierCache() { ++m_auraModifierEpoch; }
+
         Aura* GetDummyAura(uint32 spell_id) const;
 
         uint32 m_AuraFlags;
@@ -2337,6 +2347,10 @@ class Unit : public WorldObject
         void FinalizeAINotifyEvent() { m_AINotifyEvent = nullptr; }
         void AbortAINotifyEvent();
         void OnRelocated();
+        // moved with the transport it is on, the transport decides for all its passengers when visibility is updated
+        void OnTransportRelocated(bool updateVisibility);
+        // visibility updates for the moved unit, immediately or from Map::ProcessRelocationNotifies
+        void NotifyRelocation();
 
         bool IsLinkingEventTrigger() const { return m_isCreatureLinkingTrigger; }
         void TriggerAggroLinkingEvent(Unit* enemy);
@@ -2479,6 +2493,43 @@ class Unit : public WorldObject
 
         SpellAuraHolderMap m_spellAuraHolders;
         SpellAuraHolderMap::iterator m_spellAuraHoldersUpdateIterator; // != end() in Unit::m_spellAuraHolders update and point to next element
+        // holders per proc flag bit and the union of their flags, hits matching none of them skip the proc scan
+        uint16 m_procFlagHolderCount[32];
+        uint32 m_auraProcFlags;
+        void UpdateAuraProcFlags(SpellAuraHolder const* holder, bool add);
+
+        // results of the GetTotalAuraModifier family, direct mapped and valid while the epoch is unchanged
+        enum AuraModifierCacheKind : uint8
+        {
+            AURA_MODIFIER_CACHE_TOTAL,
+            AURA_MODIFIER_CACHE_MULTIPLIER,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE,
+            AURA_MODIFIER_CACHE_TOTAL_BY_MASK,
+            AURA_MODIFIER_CACHE_MULTIPLIER_BY_MASK,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_MASK,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_MASK,
+            AURA_MODIFIER_CACHE_TOTAL_BY_VALUE,
+            AURA_MODIFIER_CACHE_MULTIPLIER_BY_VALUE,
+            AURA_MODIFIER_CACHE_MAX_POSITIVE_BY_VALUE,
+            AURA_MODIFIER_CACHE_MAX_NEGATIVE_BY_VALUE,
+            AURA_MODIFIER_CACHE_KIND_MAX
+        };
+        struct AuraModifierCacheEntry
+        {
+            uint32 epoch = 0;
+            int32 misc = 0;
+            uint16 auraType = 0;
+            uint8 kind = 0;
+            int32 amount = 0;
+            float multiplier = 1.0f;
+        };
+        static constexpr uint32 AURA_MODIFIER_CACHE_SIZE = 16;
+        AuraModifierCacheEntry& GetAuraModifierCacheEntry(AuraType auratype, AuraModifierCacheKind kind, int32 misc) const;
+        bool IsAuraModifierCached(AuraModifierCacheEntry const& entry, AuraType auratype, AuraModifierCacheKind kind, int32 misc) const;
+        void StoreAuraModifierCache(AuraModifierCacheEntry& entry, AuraType auratype, AuraModifierCacheKind kind, int32 misc) const;
+        mutable AuraModifierCacheEntry m_auraModifierCache[AURA_MODIFIER_CACHE_SIZE];
+        uint32 m_auraModifierEpoch;
         AuraList m_deletedAuras;                            // auras removed while in ApplyModifier and waiting deleted
         SpellAuraHolderList m_deletedHolders;
         std::map<uint32, Aura*> m_classScripts;
@@ -2504,6 +2555,10 @@ class Unit : public WorldObject
         WeaponDamageInfo m_weaponDamageInfo;
 
         bool m_canModifyStats;
+        uint32 m_statModifierBatch;                         // nesting depth of open stat modifier batches
+        uint32 m_dirtyUnitModsMask;                         // UnitMods changed inside the open batch
+
+        void UpdateUnitModDerivedStats(UnitMods unitMod);
         // std::list< spellEffectPair > AuraSpells[TOTAL_AURAS];  // TODO: use this if ok for mem
 
         float m_speed_rate[MAX_MOVE_TYPE];
@@ -2778,6 +2833,20 @@ struct LowestHPNearestOrder
     }
 };
 
+// coalesces the stat recalculation of all modifier changes made during its lifetime
+class StatModifierBatch
+{
+    public:
+        explicit StatModifierBatch(Unit& unit) : m_unit(unit) { m_unit.BeginStatModifierBatch(); }
+        ~StatModifierBatch() { m_unit.EndStatModifierBatch(); }
+
+        StatModifierBatch(StatModifierBatch const&) = delete;
+        StatModifierBatch& operator=(StatModifierBatch const&) = delete;
+
+    private:
+        Unit& m_unit;
+};
+
 class UnitLambdaEvent : public BasicEvent
 {
     public:
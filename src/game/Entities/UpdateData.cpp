@@ -27,6 +27,9 @@
 #include "World/World.h"
 #include "Entities/ObjectGuid.h"
 #include "Server/WorldSession.h"
+#ifdef BUILD_PLAYERBOT
+#include "Entities/Player.h"
+#endif
 
 UpdateData::UpdateData() : m_data(1), m_currentIndex(0)
 {
@@ -61,16 +64,62 @@ void UpdateData::AddUpdateBlock(const ByteBuffer& block)
     }
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+std::atomic<uint64> UpdateData::m_compressedBytesIn(0);
+std::atomic<uint64> UpdateData::m_compressedBytesOut(0);
+
+namespace
 {
-    z_stream c_stream;
+    // deflate state is ~256KB, keep one per thread and reset it between packets instead of reallocating
+    struct DeflateStream
+    {
+        DeflateStream() : initialized(false), level(0)
+        {
+            stream.zalloc = (alloc_func)nullptr;
+            stream.zfree = (free_func)nullptr;
+            stream.opaque = (voidpf)nullptr;
+        }
+
+        ~DeflateStream()
+        {
+            if (initialized)
+                deflateEnd(&stream);
+        }
+
+        // (re)initialize on first use and when the configured level changed on reload
+        int Prepare(int compressionLevel)
+        {
+            if (initialized && level == compressionLevel)
+                return deflateReset(&stream);
+
+            if (initialized)
+            {
+                deflateEnd(&stream);
+                initialized = false;
+            }
+
+            int z_res = deflateInit(&stream, compressionLevel);
+            if (z_res == Z_OK)
+            {
+                initialized = true;
+                level = compressionLevel;
+            }
+            return z_res;
+        }
+
+        z_stream stream;
+        bool initialized;
+        int level;
+    };
+
+    thread_local DeflateStream t_deflateStream;
+}
 
-    c_stream.zalloc = (alloc_func)nullptr;
-    c_stream.zfree = (free_func)nullptr;
-    c_stream.opaque = (voidpf)nullptr;
+void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+{
+    z_stream& c_stream = t_deflateStream.stream;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
+    int z_res = t_deflateStream.Prepare(sWorld.getConfig(CONFIG_UINT32_COMPRESSION));
     if (z_res != Z_OK)
     {
         sLog.outError("Can't compress update packet (zlib: deflateInit) Error code: %i (%s)", z_res, zError(z_res));
@@ -106,15 +155,24 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
         return;
     }
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
+    *dst_size = c_stream.total_out;
+
+    m_compressedBytesIn.fetch_add(src_size, std::memory_order_relaxed);
+    m_compressedBytesOut.fetch_add(*dst_size, std::memory_order_relaxed);
+}
+
+void UpdateData::GetCompressionStats(uint64& bytesIn, uint64& bytesOut, bool reset)
+{
+    if (reset)
     {
-        sLog.outError("Can't compress update packet (zlib: deflateEnd) Error code: %i (%s)", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
+        bytesIn = m_compressedBytesIn.exchange(0, std::memory_order_relaxed);
+        bytesOut = m_compressedBytesOut.exchange(0, std::memory_order_relaxed);
+    }
+    else
+    {
+        bytesIn = m_compressedBytesIn.load(std::memory_order_relaxed);
+        bytesOut = m_compressedBytesOut.load(std::memory_order_relaxed);
     }
-
-    *dst_size = c_stream.total_out;
 }
 
 WorldPacket UpdateData::BuildPacket(size_t index, bool hasTransport)
@@ -170,6 +228,12 @@ void UpdateData::Clear()
 
 void UpdateData::SendData(WorldSession& session)
 {
+#ifdef BUILD_PLAYERBOT
+    // bots have no client, their AI never reads update objects - skip building and compressing them
+    if (session.GetPlayer() && session.GetPlayer()->GetPlayerbotAI())
+        return;
+#endif
+
     for (size_t i = 0; i < GetPacketCount(); ++i)
     {
         WorldPacket packet = BuildPacket(i);
@@ -22,6 +22,8 @@
 #include "ByteBuffer.h"
 #include "Entities/ObjectGuid.h"
 
+#include <atomic>
+
 class WorldPacket;
 class WorldSession;
 
@@ -70,11 +72,18 @@ class UpdateData
 
         void SendData(WorldSession& session);
 
+        // uncompressed and compressed size of all SMSG_COMPRESSED_UPDATE_OBJECT since start or last reset
+        static void GetCompressionStats(uint64& bytesIn, uint64& bytesOut, bool reset);
+
+        // zlib deflate with the thread stream and configured level, dst_size is 0 on failure
+        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+
     protected:
         GuidSet m_outOfRangeGUIDs;
         std::vector<BufferPair> m_data;
         uint32 m_currentIndex;
 
-        static void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        static std::atomic<uint64> m_compressedBytesIn;
+        static std::atomic<uint64> m_compressedBytesOut;
 };
 #endif
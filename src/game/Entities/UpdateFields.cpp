@@ -17,6 +17,7 @@
  */
 
 #include "UpdateFields.h"
+#include "UpdateMask.h"
 #include "Log.h"
 #include "ObjectGuid.h"
 #include <array>
@@ -460,6 +461,26 @@ static std::array<uint16, GAMEOBJECT_END> const g_gameObjectUpdateFieldFlags = S
 static std::array<uint16, DYNAMICOBJECT_END> const g_dynamicObjectUpdateFieldFlags = SetupUpdateFieldFlagsArray<DYNAMICOBJECT_END>(TYPEMASK_OBJECT | TYPEMASK_DYNAMICOBJECT);
 static std::array<uint16, CORPSE_END> const g_corpseUpdateFieldFlags = SetupUpdateFieldFlagsArray<CORPSE_END>(TYPEMASK_OBJECT | TYPEMASK_CORPSE);
 
+template<std::size_t SIZE>
+static std::vector<UpdateMask> SetupUpdateFieldVisibilityMasks(std::array<uint16, SIZE> const& flagsArray)
+{
+    std::vector<UpdateMask> masks(UF_FLAG_COMBINATIONS);
+    for (uint16 visibleFlags = 0; visibleFlags < UF_FLAG_COMBINATIONS; ++visibleFlags)
+    {
+        masks[visibleFlags].SetCount(SIZE);
+        for (uint16 i = 0; i < SIZE; ++i)
+            if (flagsArray[i] & visibleFlags)
+                masks[visibleFlags].SetBit(i);
+    }
+    return masks;
+}
+
+static std::vector<UpdateMask> const g_containerVisibilityMasks = SetupUpdateFieldVisibilityMasks(g_containerUpdateFieldFlags);
+static std::vector<UpdateMask> const g_playerVisibilityMasks = SetupUpdateFieldVisibilityMasks(g_playerUpdateFieldFlags);
+static std::vector<UpdateMask> const g_gameObjectVisibilityMasks = SetupUpdateFieldVisibilityMasks(g_gameObjectUpdateFieldFlags);
+static std::vector<UpdateMask> const g_dynamicObjectVisibilityMasks = SetupUpdateFieldVisibilityMasks(g_dynamicObjectUpdateFieldFlags);
+static std::vector<UpdateMask> const g_corpseVisibilityMasks = SetupUpdateFieldVisibilityMasks(g_corpseUpdateFieldFlags);
+
 uint16 const* UpdateFields::GetUpdateFieldFlagsArray(uint8 objectTypeId)
 {
     switch (objectTypeId)
@@ -491,6 +512,29 @@ uint16 const* UpdateFields::GetUpdateFieldFlagsArray(uint8 objectTypeId)
     return 0;
 }
 
+UpdateMask const* UpdateFields::GetUpdateFieldVisibilityMask(uint8 objectTypeId, uint16 visibleFlags)
+{
+    MANGOS_ASSERT(visibleFlags < UF_FLAG_COMBINATIONS);
+
+    switch (objectTypeId)
+    {
+        case TYPEID_ITEM:
+        case TYPEID_CONTAINER:
+            return &g_containerVisibilityMasks[visibleFlags];
+        case TYPEID_UNIT:
+        case TYPEID_PLAYER:
+            return &g_playerVisibilityMasks[visibleFlags];
+        case TYPEID_GAMEOBJECT:
+            return &g_gameObjectVisibilityMasks[visibleFlags];
+        case TYPEID_DYNAMICOBJECT:
+            return &g_dynamicObjectVisibilityMasks[visibleFlags];
+        case TYPEID_CORPSE:
+            return &g_corpseVisibilityMasks[visibleFlags];
+    }
+    sLog.outError("Unhandled object type id (%hhu) in GetUpdateFieldVisibilityMask!", objectTypeId);
+    return nullptr;
+}
+
 UpdateFieldData const* UpdateFields::GetUpdateFieldDataByName(char const* name)
 {
     for (const auto& itr : g_updateFieldsData)
@@ -474,6 +474,8 @@ enum UpdateFieldFlags : uint16
 	UF_FLAG_GROUP_ONLY   = 0x040,   // only visible to raid group members
 	UF_FLAG_UNK5         = 0x080,   // meaning unknown, not used in vanilla
 	UF_FLAG_DYNAMIC      = 0x100,   // visible to everyone, but different values can be sent to different observers
+
+	UF_FLAG_COMBINATIONS = 0x200,   // number of distinct visibility flag sets
 };
 
 struct UpdateFieldData
@@ -489,9 +491,13 @@ struct UpdateFieldData
     uint16 flags = UF_FLAG_NONE;
 };
 
+class UpdateMask;
+
 namespace UpdateFields
 {
     uint16 const* GetUpdateFieldFlagsArray(uint8 objectTypeId);
+    // bits of all fields of the object type having any of visibleFlags, precomputed for every flag combination
+    UpdateMask const* GetUpdateFieldVisibilityMask(uint8 objectTypeId, uint16 visibleFlags);
     UpdateFieldData const* GetUpdateFieldDataByName(char const* name);
     UpdateFieldData const* GetUpdateFieldDataByTypeMaskAndOffset(uint8 objectTypeMask, uint16 offset);
 };
@@ -21,6 +21,8 @@
 
 #include "Errors.h"
 
+#include <bitset>
+
 class UpdateMask
 {
     public:
@@ -34,35 +36,104 @@ class UpdateMask
 
         void SetBit(uint32 index)
         {
+            if (!mUpdateMask)
+                Allocate();
+
             ((uint8*)mUpdateMask)[ index >> 3 ] |= 1 << (index & 0x7);
             mHasData = true;
         }
 
         void UnsetBit(uint32 index)
         {
+            if (!mUpdateMask)
+                return;
+
             ((uint8*)mUpdateMask)[ index >> 3 ] &= (0xff ^ (1 << (index & 0x7)));
         }
 
         bool GetBit(uint32 index) const
         {
+            if (!mUpdateMask)
+                return false;
+
             return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
         }
 
+        // first set bit at or after index, GetCount() if there is none; empty blocks are skipped a word at a time
+        uint32 GetNextSetBit(uint32 index) const
+        {
+            if (!mUpdateMask)
+                return mCount;
+
+            while (index < mCount)
+            {
+                if (!mUpdateMask[index >> 5])
+                {
+                    index = (index | 31) + 1;
+                    continue;
+                }
+
+                if (GetBit(index))
+                    return index;
+                ++index;
+            }
+            return mCount;
+        }
+
+        // this = left & right, block by block
+        void SetMaskedBlocks(const UpdateMask& left, const UpdateMask& right)
+        {
+            MANGOS_ASSERT(left.mCount >= mCount && right.mCount >= mCount);
+
+            if (!left.mUpdateMask || !right.mUpdateMask)
+            {
+                Clear();
+                return;
+            }
+
+            if (!mUpdateMask)
+                Allocate();
+
+            uint32 any = 0;
+            for (uint32 i = 0; i < mBlocks; ++i)
+            {
+                mUpdateMask[i] = left.mUpdateMask[i] & right.mUpdateMask[i];
+                any |= mUpdateMask[i];
+            }
+            mHasData = any != 0;
+        }
+
+        uint32 GetSetBitCount() const
+        {
+            if (!mUpdateMask)
+                return 0;
+
+            uint32 count = 0;
+            for (uint32 i = 0; i < mBlocks; ++i)
+                if (mUpdateMask[i])
+                    count += uint32(std::bitset<32>(mUpdateMask[i]).count());
+            return count;
+        }
+
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
         uint8* GetMask() const { return (uint8*)mUpdateMask; }
         bool HasData() const { return mHasData; }
+        bool IsAllocated() const { return mUpdateMask != nullptr; }
 
-        void SetCount(uint32 valuesCount)
+        // not allocated masks read as empty and are allocated at the first SetBit
+        void SetCount(uint32 valuesCount, bool allocate = true)
         {
             delete[] mUpdateMask;
+            mUpdateMask = nullptr;
+            mHasData = false;
 
             mCount = valuesCount;
             mBlocks = (valuesCount + 31) / 32;
 
-            mUpdateMask = new uint32[mBlocks];
-            memset(mUpdateMask, 0, mBlocks << 2);
+            if (allocate)
+                Allocate();
         }
 
         void Clear()
@@ -74,8 +145,13 @@ class UpdateMask
 
         UpdateMask& operator = (const UpdateMask& mask)
         {
-            SetCount(mask.mCount);
-            memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
+            if (this == &mask)
+                return *this;
+
+            SetCount(mask.mCount, mask.mUpdateMask != nullptr);
+            if (mUpdateMask)
+                memcpy(mUpdateMask, mask.mUpdateMask, mBlocks << 2);
+            mHasData = mask.mHasData;
 
             return *this;
         }
@@ -83,6 +159,15 @@ class UpdateMask
         void operator &= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
+            if (!mask.mUpdateMask)
+            {
+                Clear();
+                return;
+            }
+
+            if (!mUpdateMask)
+                return;
+
             for (uint32 i = 0; i < mBlocks; ++i)
                 mUpdateMask[i] &= mask.mUpdateMask[i];
         }
@@ -90,6 +175,12 @@ class UpdateMask
         void operator |= (const UpdateMask& mask)
         {
             MANGOS_ASSERT(mask.mCount <= mCount);
+            if (!mask.mUpdateMask)
+                return;
+
+            if (!mUpdateMask)
+                Allocate();
+
             for (uint32 i = 0; i < mBlocks; ++i)
                 mUpdateMask[i] |= mask.mUpdateMask[i];
         }
@@ -115,6 +206,12 @@ class UpdateMask
         }
 
     private:
+        void Allocate()
+        {
+            mUpdateMask = new uint32[mBlocks];
+            memset(mUpdateMask, 0, mBlocks << 2);
+        }
+
         bool mHasData;
         uint32 mCount;
         uint32 mBlocks;
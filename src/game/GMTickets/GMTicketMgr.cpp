@@ -153,6 +153,9 @@ void GMTicket::Save(SqlStatement& stmt) const
 
 void GMTicketMgr::Save(const GMTicket* ticket)
 {
+    // queued as one unit for the async writer
+    CharacterDatabase.BeginTransaction();
+
     CharacterDatabase.PExecute("DELETE FROM gm_tickets WHERE id=%u", ticket->GetId());
 
     static SqlStatementID id;
@@ -166,6 +169,8 @@ void GMTicketMgr::Save(const GMTicket* ticket)
     ticket->Save(stmt);
 
     stmt.Execute();
+
+    CharacterDatabase.CommitTransaction();
 }
 
 void GMTicket::Recycle(Player* player, std::string message, uint8 category, time_t when/* = time(nullptr)*/)
@@ -363,8 +368,6 @@ void GMTicketMgr::LoadGMTickets()
         Add(ticket, true);
     } while (result->NextRow());
 
-    m_list.sort(GMTicket::Compare);
-
     sLog.outString(">> Loaded " SIZEFMTD " GM tickets", GetTicketCount());
     sLog.outString();
 }
@@ -554,6 +557,8 @@ void GMTicketMgr::PrintTicketList(WorldSession* session, std::ostringstream& out
     size_t count = 0;
     std::ostringstream tickets;
 
+    SortList();
+
     for (auto itr = m_list.begin(); (itr != m_list.end() && count < max); ++itr)
     {
         if ((*itr)->IsOpen() && (!category || (*itr)->GetCategory() == category->ID))
@@ -857,12 +862,11 @@ GMTicket* GMTicketMgr::GetTicketByPlayer(ObjectGuid playerGuid, GMTicketState st
 {
     if (playerGuid.IsPlayer())
     {
-        GMTicket* ticket;
-
-        for (auto itr = m_tickets.begin(); itr != m_tickets.end(); ++itr)
+        auto bounds = m_ticketsByAuthor.equal_range(playerGuid);
+        for (auto itr = bounds.first; itr != bounds.second; ++itr)
         {
-            ticket = itr->second;
-            if (ticket && ticket->GetState() == state && ticket->GetAuthorGuid() == playerGuid && (!assigneeGuid.IsPlayer() || (ticket->IsAssigned() && ticket->IsAssignedTo(assigneeGuid))))
+            GMTicket* ticket = itr->second;
+            if (ticket->GetState() == state && (!assigneeGuid.IsPlayer() || (ticket->IsAssigned() && ticket->IsAssignedTo(assigneeGuid))))
                 return ticket;
         }
     }
@@ -903,7 +907,9 @@ bool GMTicketMgr::Add(GMTicket* ticket, bool loading/* = false*/)
     if (!m_tickets.insert({ticket->GetId(), ticket}).second)
         return true;
 
+    m_ticketsByAuthor.insert({ticket->GetAuthorGuid(), ticket});
     m_list.push_back(ticket);
+    InvalidateListOrder();
 
     if (ticket->IsOpen())
         ++m_currentTicketCountOpen;
@@ -932,7 +938,7 @@ bool GMTicketMgr::Recycle(GMTicket* ticket)
 
     Save(ticket);
 
-    m_list.sort(GMTicket::Compare);
+    InvalidateListOrder();
 
     sWorld.SendWorldTextToAcceptingTickets(LANG_TICKET_BROADCAST_NEW, ticket->GetIdTag().c_str(), ticket->GetAuthorName());
 
@@ -1012,7 +1018,7 @@ GMTicketMgr::CommandResult GMTicketMgr::Escalate(GMTicket* ticket, WorldSession*
 
     if (initial)
     {
-        m_list.sort(GMTicket::Compare);
+        InvalidateListOrder();
 
         if (Player* character = sObjectMgr.GetPlayer(ticket->GetAuthorGuid()))
             character->GetSession()->SendGMTicketResult(SMSG_GM_TICKET_STATUS_UPDATE, GMTICKET_STATUS_UPDATED);
@@ -1062,7 +1068,7 @@ GMTicketMgr::CommandResult GMTicketMgr::Read(GMTicket* ticket)
 
     if (unread)
     {
-        m_list.sort(GMTicket::Compare);
+        InvalidateListOrder();
 
         if (Player* character = sObjectMgr.GetPlayer(ticket->GetAuthorGuid()))
             character->GetSession()->SendGMTicketResult(SMSG_GM_TICKET_STATUS_UPDATE, GMTICKET_STATUS_UPDATED);
@@ -1109,7 +1115,7 @@ GMTicketMgr::CommandResult GMTicketMgr::Update(GMTicket* ticket, const std::stri
 
     Save(ticket);
 
-    m_list.sort(GMTicket::Compare);
+    InvalidateListOrder();
 
     if (deescalation)
          sWorld.SendWorldTextToAcceptingTickets(LANG_TICKET_BROADCAST_DEESCALATION, ticket->GetIdTag().c_str());
@@ -1250,6 +1256,16 @@ bool GMTicketMgr::Remove(GMTicket& ticket)
 {
     m_list.remove(&ticket);
 
+    auto bounds = m_ticketsByAuthor.equal_range(ticket.GetAuthorGuid());
+    for (auto itr = bounds.first; itr != bounds.second; ++itr)
+    {
+        if (itr->second == &ticket)
+        {
+            m_ticketsByAuthor.erase(itr);
+            break;
+        }
+    }
+
     auto itr = m_tickets.find(ticket.GetId());
 
     if (itr != m_tickets.end())
@@ -1272,7 +1288,9 @@ void GMTicketMgr::RemoveAll()
         delete itr->second;
 
     m_tickets.clear();
+    m_ticketsByAuthor.clear();
     m_list.clear();
+    m_listSorted = true;
 
     m_currentTicketCountOpen = 0;
 }
@@ -1337,6 +1355,15 @@ GMTicketMgr::CommandResult GMTicketMgr::Close(GMTicket* ticket, const std::strin
     return COMMAND_RESULT_SUCCESS;
 }
 
+void GMTicketMgr::SortList() const
+{
+    if (m_listSorted)
+        return;
+
+    m_list.sort(GMTicket::Compare);
+    m_listSorted = true;
+}
+
 float GMTicketMgr::GetOldestTicketAgeLastUpdateDays(time_t now) const
 {
     return (m_statsOldestTicketAgeLastUpdate ? GetDaysPassed(now, m_statsOldestTicketAgeLastUpdate) : -1);
@@ -1351,6 +1378,7 @@ void GMTicketMgr::UpdateTicketQueueStats(GMTicket& closed, time_t when)
 
     // Order of the list is the FIFO queue's order, declared in GMTicket::Compare
     // Do loop over queued tickets, record first (oldest) new non-escalated queued ticket's time since creation
+    SortList();
     for (auto itr = m_list.begin(); itr != m_list.end(); ++itr)
     {
         if ((*itr) && (*itr)->IsOpen() && !(*itr)->IsEscalated() && !(*itr)->IsSeen())
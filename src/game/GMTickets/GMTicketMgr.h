@@ -189,6 +189,7 @@ class GMTicket
 };
 
 typedef std::map<uint32, GMTicket*> GMTicketMap;
+typedef std::multimap<ObjectGuid, GMTicket*> GMTicketAuthorMap;
 typedef std::list<GMTicket*> GMTicketList;
 
 class GMSurveyResult
@@ -298,6 +299,10 @@ class GMTicketMgr
         void UpdateTicketQueueStats(GMTicket& closed, time_t when);
         inline void UpdateTicketQueueTimers(GMTicket* except = nullptr) const;
 
+        // the list is sorted by GMTicket::Compare when it is read, not on every ticket change
+        inline void InvalidateListOrder() { m_listSorted = false; }
+        void SortList() const;
+
         inline float GetAverageResolutionDays() const { return m_statsAverageResolutionDays; }
         inline size_t GetTicketCount() const { return m_tickets.size(); }
 
@@ -305,7 +310,9 @@ class GMTicketMgr
         GMTicketSystemStatus m_status;
 
         GMTicketMap m_tickets;
-        GMTicketList m_list;
+        GMTicketAuthorMap m_ticketsByAuthor;
+        mutable GMTicketList m_list;
+        mutable bool m_listSorted               = true;
 
         uint32 m_lastTicketId                   = 0;
         uint32 m_currentTicketCountOpen         = 0;
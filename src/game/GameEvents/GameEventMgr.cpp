@@ -771,6 +771,35 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id, bool resume)
     OnEventHappened(event_id, true, resume);
 }
 
+// Spawn (or remove) an event object in all maps of its map id, deferred to the map updates when Event.SpawnBudget is set
+void GameEventMgr::SpawnInMaps(uint32 dbGuid, CreatureData const* data, bool spawn)
+{
+    if (!sWorld.getConfig(CONFIG_UINT32_EVENT_SPAWN_BUDGET))
+    {
+        if (spawn)
+            Creature::SpawnInMaps(dbGuid, data);
+        else
+            Creature::AddToRemoveListInMaps(dbGuid, data);
+        return;
+    }
+
+    sMapMgr.DoForAllMapsWithMapId(data->mapid, [dbGuid, spawn](Map* map) { map->AddGameEventSpawnAction(dbGuid, HIGHGUID_UNIT, spawn); });
+}
+
+void GameEventMgr::SpawnInMaps(uint32 dbGuid, GameObjectData const* data, bool spawn)
+{
+    if (!sWorld.getConfig(CONFIG_UINT32_EVENT_SPAWN_BUDGET))
+    {
+        if (spawn)
+            GameObject::SpawnInMaps(dbGuid, data);
+        else
+            GameObject::AddToRemoveListInMaps(dbGuid, data);
+        return;
+    }
+
+    sMapMgr.DoForAllMapsWithMapId(data->mapid, [dbGuid, spawn](Map* map) { map->AddGameEventSpawnAction(dbGuid, HIGHGUID_GAMEOBJECT, spawn); });
+}
+
 void GameEventMgr::GameEventSpawn(int16 event_id)
 {
     int32 internal_event_id = m_gameEvents.size() + event_id - 1;
@@ -801,7 +830,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddCreatureToGrid(itr, data);
 
-            Creature::SpawnInMaps(itr, data);
+            SpawnInMaps(itr, data, true);
         }
     }
 
@@ -831,7 +860,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 
             sObjectMgr.AddGameobjectToGrid(itr, data);
 
-            GameObject::SpawnInMaps(itr, data);
+            SpawnInMaps(itr, data, true);
         }
     }
 
@@ -878,7 +907,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveCreatureFromGrid(itr, data);
 
             // Remove spawned cases
-            Creature::AddToRemoveListInMaps(itr, data);
+            SpawnInMaps(itr, data, false);
         }
     }
 
@@ -908,7 +937,7 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
             sObjectMgr.RemoveGameobjectFromGrid(itr, data);
 
             // Remove spawned cases
-            GameObject::AddToRemoveListInMaps(itr, data);
+            SpawnInMaps(itr, data, false);
         }
     }
 
@@ -28,6 +28,8 @@
 
 class Creature;
 class GameObject;
+struct CreatureData;
+struct GameObjectData;
 class MapPersistentState;
 
 enum GameEventScheduleType
@@ -124,6 +126,8 @@ class GameEventMgr
         void UnApplyEvent(uint16 event_id);
         void GameEventSpawn(int16 event_id);
         void GameEventUnspawn(int16 event_id);
+        void SpawnInMaps(uint32 dbGuid, CreatureData const* data, bool spawn);
+        void SpawnInMaps(uint32 dbGuid, GameObjectData const* data, bool spawn);
         void UpdateCreatureData(int16 event_id, bool activate);
         void UpdateEventQuests(uint16 event_id, bool Activate);
         void SendEventMails(int16 event_id);
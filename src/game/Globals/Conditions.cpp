@@ -31,6 +31,8 @@
 #include "OutdoorPvP/OutdoorPvPMgr.h"
 #include "OutdoorPvP/OutdoorPvP.h"
 
+#include <unordered_map>
+
 // Attention: make sure to keep this list in sync with ConditionSource to avoid array
 //            out of bounds access! It is accessed with ConditionSource as index!
 char const* conditionSourceToStr[] =
@@ -104,6 +106,123 @@ uint8 const ConditionTargetsInternal[] =
 // Starts from 4th element so that -3 will return first element.
 uint8 const* ConditionTargets = &ConditionTargetsInternal[3];
 
+// Stores which player state each condition type reads, see ConditionStateFlags
+// Combined conditions get the flags of their parts in ConditionEntry::CompileAll
+uint8 const ConditionStateInternal[] =
+{
+    CONDITION_STATE_NONE,             // -3
+    CONDITION_STATE_NONE,             // -2
+    CONDITION_STATE_NONE,             // -1
+    CONDITION_STATE_NONE,             //  0
+    CONDITION_STATE_AURAS,            //  1
+    CONDITION_STATE_ITEMS,            //  2
+    CONDITION_STATE_ITEMS,            //  3
+    CONDITION_STATE_UNCACHED,         //  4 position, may be of source
+    CONDITION_STATE_REPUTATION,       //  5
+    CONDITION_STATE_UNCACHED,         //  6 depends on condition source
+    CONDITION_STATE_UNCACHED,         //  7 skill values are not tracked
+    CONDITION_STATE_QUESTS,           //  8
+    CONDITION_STATE_QUESTS,           //  9
+    CONDITION_STATE_AURAS,            //  10
+    CONDITION_STATE_NONE,             //  11
+    CONDITION_STATE_UNCACHED,         //  12
+    CONDITION_STATE_UNCACHED,         //  13
+    CONDITION_STATE_NONE,             //  14
+    CONDITION_STATE_LEVEL,            //  15
+    CONDITION_STATE_NONE,             //  16
+    CONDITION_STATE_SPELLS,           //  17
+    CONDITION_STATE_UNCACHED,         //  18
+    CONDITION_STATE_UNCACHED,         //  19 quest requirements read almost anything
+    CONDITION_STATE_NONE,             //  20
+    CONDITION_STATE_NONE,             //  21
+    CONDITION_STATE_QUESTS,           //  22
+    CONDITION_STATE_ITEMS,            //  23
+    CONDITION_STATE_NONE,             //  24
+    CONDITION_STATE_NONE,             //  25
+    CONDITION_STATE_UNCACHED,         //  26
+    CONDITION_STATE_NONE,             //  27
+    CONDITION_STATE_UNCACHED,         //  28
+    CONDITION_STATE_UNCACHED,         //  29
+    CONDITION_STATE_REPUTATION,       //  30
+    CONDITION_STATE_UNCACHED,         //  31
+    CONDITION_STATE_NONE,             //  32
+    CONDITION_STATE_UNCACHED,         //  33
+    CONDITION_STATE_NONE,             //  34
+    CONDITION_STATE_NONE,             //  35
+    CONDITION_STATE_UNCACHED,         //  36
+    CONDITION_STATE_UNCACHED,         //  37
+    CONDITION_STATE_UNCACHED,         //  38
+    CONDITION_STATE_UNCACHED,         //  39
+    CONDITION_STATE_UNCACHED,         //  40
+    CONDITION_STATE_NONE,             //  41
+    CONDITION_STATE_UNCACHED,         //  42
+};
+
+uint8 const* ConditionStates = &ConditionStateInternal[3];
+
+namespace
+{
+    // by condition entry, filled by ConditionEntry::CompileAll
+    std::vector<uint8> conditionStateFlags;
+    uint32 conditionCompileGeneration = 0;
+
+    struct ConditionMemo
+    {
+        struct Result
+        {
+            uint32 version;                                 // Player::GetConditionStateVersion when evaluated
+            bool result;
+        };
+
+        uint32 tick = 0;
+        uint32 generation = 0;
+        std::unordered_map<uint64, Result> results;         // by condition entry << 32 | player guid counter
+    };
+
+    // map threads evaluate conditions for their own players, so every thread keeps its own results
+    thread_local ConditionMemo conditionMemo;
+}
+
+uint8 ConditionEntry::CompileStateFlags(uint32 entry, uint32 depth)
+{
+    if (entry < conditionStateFlags.size() && conditionStateFlags[entry] != 0xFF)
+        return conditionStateFlags[entry];
+
+    ConditionEntry const* condition = sConditionStorage.LookupEntry<ConditionEntry>(entry);
+    if (!condition || depth > 32)                           // missing or looping combination
+        return CONDITION_STATE_UNCACHED;
+
+    uint8 flags = condition->m_condition <= CONDITION_WORLDSTATE ? ConditionStates[condition->m_condition] : uint8(CONDITION_STATE_UNCACHED);
+    switch (condition->m_condition)
+    {
+        case CONDITION_NOT:
+            flags |= CompileStateFlags(condition->m_value1, depth + 1);
+            break;
+        case CONDITION_OR:
+        case CONDITION_AND:
+            flags |= CompileStateFlags(condition->m_value1, depth + 1) | CompileStateFlags(condition->m_value2, depth + 1);
+            if (condition->m_value3)
+                flags |= CompileStateFlags(condition->m_value3, depth + 1);
+            if (condition->m_value4)
+                flags |= CompileStateFlags(condition->m_value4, depth + 1);
+            break;
+        default:
+            break;
+    }
+
+    conditionStateFlags[entry] = flags;
+    return flags;
+}
+
+void ConditionEntry::CompileAll()
+{
+    conditionStateFlags.assign(sConditionStorage.GetMaxEntry(), 0xFF);
+    for (uint32 i = 0; i < sConditionStorage.GetMaxEntry(); ++i)
+        CompileStateFlags(i, 0);
+
+    ++conditionCompileGeneration;
+}
+
 // Checks if player meets the condition
 bool ConditionEntry::Meets(WorldObject const* target, Map const* map, WorldObject const* source, ConditionSource conditionSourceType) const
 {
@@ -120,6 +239,30 @@ bool ConditionEntry::Meets(WorldObject const* target, Map const* map, WorldObjec
         return false;
     } 
 
+    // memoized per world tick for player targets if only player state tracked by ConditionStateFlags is read
+    uint8 stateFlags = m_entry < conditionStateFlags.size() ? conditionStateFlags[m_entry] : uint8(CONDITION_STATE_UNCACHED);
+    if (!(stateFlags & CONDITION_STATE_UNCACHED) && target && target->IsPlayer())
+    {
+        if (conditionMemo.tick != World::GetCurrentMSTime() || conditionMemo.generation != conditionCompileGeneration)
+        {
+            conditionMemo.results.clear();
+            conditionMemo.tick = World::GetCurrentMSTime();
+            conditionMemo.generation = conditionCompileGeneration;
+        }
+
+        uint32 version = static_cast<Player const*>(target)->GetConditionStateVersion(stateFlags);
+        ConditionMemo::Result& memo = conditionMemo.results[(uint64(m_entry) << 32) | target->GetGUIDLow()];
+        if (memo.version == version + 1)                    // 0 - not evaluated yet
+            return memo.result;
+
+        bool result = Evaluate(target, map, source, conditionSourceType);
+        if (m_flags & CONDITION_FLAG_REVERSE_RESULT)
+            result = !result;
+
+        memo = { version + 1, result };
+        return result;
+    }
+
     bool result = Evaluate(target, map, source, conditionSourceType);
 
     if (m_flags & CONDITION_FLAG_REVERSE_RESULT)
@@ -87,6 +87,22 @@ enum ConditionFlags
     CONDITION_FLAG_SWAP_TARGETS   = 0x2
 };
 
+// Player state a condition type reads. Results of conditions only reading such state of a player target
+// are memoized for the current world tick, until the player reports a change with Player::ConditionStateChanged
+enum ConditionStateFlags
+{
+    CONDITION_STATE_NONE        = 0x00,                     // static player data (race, class, gender)
+    CONDITION_STATE_AURAS       = 0x01,
+    CONDITION_STATE_ITEMS       = 0x02,
+    CONDITION_STATE_QUESTS      = 0x04,
+    CONDITION_STATE_REPUTATION  = 0x08,
+    CONDITION_STATE_SPELLS      = 0x10,
+    CONDITION_STATE_LEVEL       = 0x20,
+    CONDITION_STATE_UNCACHED    = 0x40,                     // reads source, map, world or untracked player state - never memoized
+};
+
+#define MAX_CONDITION_STATE 6                               // tracked state flags, without CONDITION_STATE_UNCACHED
+
 enum ConditionSource                                        // From where was the condition called?
 {
     CONDITION_FROM_LOOT                 = 0,                    // Used to check a *_loot_template entry
@@ -153,7 +169,11 @@ class ConditionEntry
 
         // Checks if the condition is met
         bool Meets(WorldObject const* target, Map const* map, WorldObject const* source, ConditionSource conditionSourceType) const;
+
+        // Precomputes the state flags of all loaded conditions, including the ones of combined conditions
+        static void CompileAll();
     private:
+        static uint8 CompileStateFlags(uint32 entry, uint32 depth);
         void DisableCondition() { m_condition = CONDITION_NONE; m_flags ^= CONDITION_FLAG_REVERSE_RESULT; }
         bool CheckParamRequirements(WorldObject const* target, Map const* map, WorldObject const* source) const;
         bool inline Evaluate(WorldObject const* target, Map const* map, WorldObject const* source, ConditionSource conditionSourceType) const;
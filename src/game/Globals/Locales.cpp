@@ -29,6 +29,24 @@ LocaleNameStr const fullLocaleNameList[] =
     { nullptr,  LOCALE_enUS }
 };
 
+uint32 LocaleStringPool::Intern(std::string const& str)
+{
+    if (str.empty())
+        return 0;
+
+    size_t hash = std::hash<std::string>()(str);
+    auto bounds = m_offsetsByHash.equal_range(hash);
+    for (auto itr = bounds.first; itr != bounds.second; ++itr)
+        if (str == Get(itr->second))
+            return itr->second;
+
+    uint32 offset = uint32(m_buffer.size());
+    m_buffer.insert(m_buffer.end(), str.begin(), str.end());
+    m_buffer.push_back('\0');
+    m_offsetsByHash.emplace(hash, offset);
+    return offset;
+}
+
 LocaleConstant GetLocaleByName(const std::string& name)
 {
     for (LocaleNameStr const* itr = &fullLocaleNameList[0]; itr->name; ++itr)
@@ -22,6 +22,8 @@
 #include "Platform/Define.h"
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 enum LocaleConstant : uint8
 {
@@ -52,4 +54,28 @@ struct LocaleNameStr
 // used for iterate all names including alternative
 extern LocaleNameStr const fullLocaleNameList[];
 
+// Localized DB texts stored once each in one contiguous buffer, locale structs keep 32 bit
+// offsets into it instead of their own strings. Offset 0 is the empty string (no text).
+class LocaleStringPool
+{
+    public:
+        LocaleStringPool() : m_buffer(1, '\0') {}
+
+        // returns the offset of an equal string already stored or appends it
+        uint32 Intern(std::string const& str);
+        char const* Get(uint32 offset) const { return &m_buffer[offset]; }
+
+        // offset stored for a storage locale index in a localized field, 0 if there is none
+        static uint32 GetOffset(std::vector<uint32> const& field, int32 locIdx)
+        {
+            return locIdx >= 0 && size_t(locIdx) < field.size() ? field[locIdx] : 0;
+        }
+
+        size_t GetSize() const { return m_buffer.size(); }
+
+    private:
+        std::vector<char> m_buffer;
+        std::unordered_multimap<size_t, uint32> m_offsetsByHash;
+};
+
 #endif
@@ -38,23 +38,30 @@ INSTANTIATE_CLASS_MUTEX(ObjectAccessor, std::mutex);
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
+    Shard& shard = GetShard(o->GetObjectGuid());
     WriteGuard guard(i_lock);
+    WriteGuard shardGuard(shard.lock);
     m_objectMap[o->GetObjectGuid()] = o;
+    shard.objects[o->GetObjectGuid()] = o;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
+    Shard& shard = GetShard(o->GetObjectGuid());
     WriteGuard guard(i_lock);
+    WriteGuard shardGuard(shard.lock);
     m_objectMap.erase(o->GetObjectGuid());
+    shard.objects.erase(o->GetObjectGuid());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    ReadGuard guard(i_lock);
-    typename MapType::iterator itr = m_objectMap.find(guid);
-    return (itr != m_objectMap.end()) ? itr->second : nullptr;
+    Shard& shard = GetShard(guid);
+    ReadGuard guard(shard.lock);
+    typename MapType::iterator itr = shard.objects.find(guid);
+    return (itr != shard.objects.end()) ? itr->second : nullptr;
 }
 
 template<class T>
@@ -198,6 +205,7 @@ ObjectAccessor::AddCorpse(Corpse* corpse)
     Guard guard(i_corpseGuard);
     MANGOS_ASSERT(i_player2corpse.find(corpse->GetOwnerGuid()) == i_player2corpse.end());
     i_player2corpse[corpse->GetOwnerGuid()] = corpse;
+    i_corpseExpiry.emplace(corpse->GetExpiryTime(), corpse->GetOwnerGuid());
 
     // build mapid*cellid -> guid_set map
     CellPair cell_pair = MaNGOS::ComputeCellPair(corpse->GetPositionX(), corpse->GetPositionY());
@@ -296,23 +304,61 @@ ObjectAccessor::ConvertCorpseForPlayer(ObjectGuid player_guid, bool insignia)
 void ObjectAccessor::RemoveOldCorpses()
 {
     time_t now = time(nullptr);
-    Player2CorpsesMapType::iterator next;
-    for (Player2CorpsesMapType::iterator itr = i_player2corpse.begin(); itr != i_player2corpse.end(); itr = next)
+    std::vector<ObjectGuid> expired;
+
     {
-        next = itr;
-        ++next;
+        Guard guard(i_corpseGuard);
+        while (!i_corpseExpiry.empty() && i_corpseExpiry.top().first < now)
+        {
+            ObjectGuid ownerGuid = i_corpseExpiry.top().second;
+            i_corpseExpiry.pop();
+
+            // corpse already converted or replaced by a newer one which has its own entry
+            Player2CorpsesMapType::const_iterator itr = i_player2corpse.find(ownerGuid);
+            if (itr == i_player2corpse.end())
+                continue;
+
+            // ghost time was reset since the entry was queued
+            if (!itr->second->IsExpired(now))
+            {
+                i_corpseExpiry.emplace(itr->second->GetExpiryTime(), ownerGuid);
+                continue;
+            }
+
+            expired.push_back(ownerGuid);
+        }
+    }
 
-        if (!itr->second->IsExpired(now))
+    for (ObjectGuid const& ownerGuid : expired)
+    {
+        Corpse* corpse = GetCorpseForPlayerGUID(ownerGuid);
+        if (!corpse)
             continue;
 
-        ConvertCorpseForPlayer(itr->first);
+        // bones are created by the map owning the corpse, in its own update
+        if (Map* map = sMapMgr.FindMap(corpse->GetMapId(), corpse->GetInstanceId()))
+        {
+            map->GetMessager().AddMessage([ownerGuid](Map* /*map*/)
+            {
+                Corpse* corpse = sObjectAccessor.GetCorpseForPlayerGUID(ownerGuid);
+                if (corpse && corpse->IsExpired(time(nullptr)))
+                    sObjectAccessor.ConvertCorpseForPlayer(ownerGuid);
+            });
+
+            // checked again next time in case the map is unloaded before handling the message
+            Guard guard(i_corpseGuard);
+            i_corpseExpiry.emplace(now, ownerGuid);
+        }
+        else
+            ConvertCorpseForPlayer(ownerGuid);
     }
 }
 
 /// Define the static member of HashMapHolder
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
-template <class T> std::mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::LockType HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::i_shards[HashMapHolder<T>::SHARD_COUNT];
 
 /// Global definitions for the hashmap storage
 
@@ -33,6 +33,8 @@
 
 #include <functional>
 #include <mutex>
+#include <queue>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
@@ -44,9 +46,9 @@ class HashMapHolder
     public:
 
         typedef std::unordered_map<ObjectGuid, T*>   MapType;
-        typedef std::mutex LockType;
-        typedef std::lock_guard<std::mutex> ReadGuard;
-        typedef std::lock_guard<std::mutex> WriteGuard;
+        typedef std::shared_mutex LockType;
+        typedef std::shared_lock<std::shared_mutex> ReadGuard;
+        typedef std::unique_lock<std::shared_mutex> WriteGuard;
 
         static void Insert(T* o);
 
@@ -63,8 +65,21 @@ class HashMapHolder
         // Non instanceable only static
         HashMapHolder() {}
 
+        // Find is served by guid sharded copies of the map so lookups from map threads
+        // only share a lock with lookups of the same shard and never with full iterations
+        static uint32 const SHARD_COUNT = 16;
+
+        struct alignas(64) Shard
+        {
+            LockType lock;
+            MapType  objects;
+        };
+
+        static Shard& GetShard(ObjectGuid guid) { return i_shards[guid.GetCounter() % SHARD_COUNT]; }
+
         static LockType i_lock;
         static MapType  m_objectMap;
+        static Shard    i_shards[SHARD_COUNT];
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, std::mutex> >
@@ -115,6 +130,11 @@ class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLev
 
         Player2CorpsesMapType   i_player2corpse;
 
+        // expiry time -> corpse owner, entries are checked against the current corpse when they come due
+        typedef std::pair<time_t, ObjectGuid> CorpseExpiry;
+        typedef std::priority_queue<CorpseExpiry, std::vector<CorpseExpiry>, std::greater<CorpseExpiry> > CorpseExpiryQueue;
+        CorpseExpiryQueue       i_corpseExpiry;
+
         typedef std::mutex LockType;
         typedef MaNGOS::GeneralLock<LockType > Guard;
 
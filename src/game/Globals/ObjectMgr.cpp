@@ -251,7 +251,7 @@ void ObjectMgr::LoadCreatureLocales()
                     if ((int32)data.Name.size() <= idx)
                         data.Name.resize(idx + 1);
 
-                    data.Name[idx] = str;
+                    data.Name[idx] = m_localeStrings.Intern(str);
                 }
             }
             str = fields[1 + 2 * (i - 1) + 1].GetCppString();
@@ -263,7 +263,7 @@ void ObjectMgr::LoadCreatureLocales()
                     if ((int32)data.SubName.size() <= idx)
                         data.SubName.resize(idx + 1);
 
-                    data.SubName[idx] = str;
+                    data.SubName[idx] = m_localeStrings.Intern(str);
                 }
             }
         }
@@ -339,7 +339,7 @@ void ObjectMgr::LoadGossipMenuItemsLocales()
                     if ((int32)data.OptionText.size() <= idx)
                         data.OptionText.resize(idx + 1);
 
-                    data.OptionText[idx] = str;
+                    data.OptionText[idx] = m_localeStrings.Intern(str);
                 }
             }
             str = fields[2 + 2 * (i - 1) + 1].GetCppString();
@@ -351,7 +351,7 @@ void ObjectMgr::LoadGossipMenuItemsLocales()
                     if ((int32)data.BoxText.size() <= idx)
                         data.BoxText.resize(idx + 1);
 
-                    data.BoxText[idx] = str;
+                    data.BoxText[idx] = m_localeStrings.Intern(str);
                 }
             }
         }
@@ -407,7 +407,7 @@ void ObjectMgr::LoadPointOfInterestLocales()
                 if ((int32)data.IconName.size() <= idx)
                     data.IconName.resize(idx + 1);
 
-                data.IconName[idx] = str;
+                data.IconName[idx] = m_localeStrings.Intern(str);
             }
         }
     }
@@ -426,6 +426,8 @@ struct SQLCreatureLoader : public SQLStorageLoaderBase<SQLCreatureLoader, SQLSto
     {
         dst = D(sScriptDevAIMgr.GetScriptId(src));
     }
+
+    std::string GetCacheKeyExtra() const { return sScriptDevAIMgr.GetScriptNamesKey(); }
 };
 
 void ObjectMgr::LoadCreatureTemplates()
@@ -1912,7 +1914,7 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 count = 0;
     //                                                0                       1   2    3
-    QueryResult* result = WorldDatabase.Query("SELECT creature.guid, creature.id, map, modelid,"
+    QueryResult* result = WorldDatabase.QueryStream("SELECT creature.guid, creature.id, map, modelid,"
                           //   4             5           6           7           8            9              10               11         12
                           "equipment_id, position_x, position_y, position_z, orientation, spawntimesecsmin, spawntimesecsmax, spawndist, currentwaypoint,"
                           //   13         14       15          16            17         18
@@ -2140,6 +2142,19 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
     }
 }
 
+CellObjectGuids const& ObjectMgr::GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id) const
+{
+    // read from map threads, so lookups must not add entries, most cells have no spawns at all
+    static CellObjectGuids const emptyCell;
+
+    MapObjectGuids::const_iterator mapItr = mMapObjectGuids.find(MAKE_PAIR32(mapid, spawnMode));
+    if (mapItr == mMapObjectGuids.end())
+        return emptyCell;
+
+    CellObjectGuidsMap::const_iterator cellItr = mapItr->second.find(cell_id);
+    return cellItr != mapItr->second.end() ? cellItr->second : emptyCell;
+}
+
 void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -2161,7 +2176,7 @@ void ObjectMgr::LoadGameObjects()
     uint32 count = 0;
 
     //                                                0                           1   2    3           4           5           6
-    QueryResult* result = WorldDatabase.Query("SELECT gameobject.guid, gameobject.id, map, round(position_x, 20), round(position_y, 20), round(position_z, 20), round(orientation, 20),"
+    QueryResult* result = WorldDatabase.QueryStream("SELECT gameobject.guid, gameobject.id, map, round(position_x, 20), round(position_y, 20), round(position_z, 20), round(orientation, 20),"
                           //   7          8          9          10         11             12               13            14     15         16
                           "round(rotation0, 20), round(rotation1, 20), round(rotation2, 20), round(rotation3, 20), spawntimesecsmin, spawntimesecsmax, animprogress, state, spawnMask, event,"
                           //   17                          18
@@ -2481,20 +2496,11 @@ int32 ObjectMgr::GetPlayerMapIdByGUID(ObjectGuid const& guid) const
 // name must be checked to correctness (if received) before call this function
 ObjectGuid ObjectMgr::GetPlayerGuidByName(std::string name) const
 {
-    ObjectGuid guid;
-
-    CharacterDatabase.escape_string(name);
-
-    // Player name safe to sending to DB (checked at login) and this function using
-    QueryResult* result = CharacterDatabase.PQuery("SELECT guid FROM characters WHERE name = '%s'", name.c_str());
-    if (result)
-    {
-        guid = ObjectGuid(HIGHGUID_PLAYER, (*result)[0].GetUInt32());
-
-        delete result;
-    }
+    PlayerDataCache data;
+    if (!GetPlayerDataCacheByName(name, data))
+        return ObjectGuid();
 
-    return guid;
+    return ObjectGuid(HIGHGUID_PLAYER, data.lowguid);
 }
 
 bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
@@ -2506,18 +2512,12 @@ bool ObjectMgr::GetPlayerNameByGUID(ObjectGuid guid, std::string& name) const
         return true;
     }
 
-    uint32 lowguid = guid.GetCounter();
-
-    QueryResult* result = CharacterDatabase.PQuery("SELECT name FROM characters WHERE guid = '%u'", lowguid);
-
-    if (result)
-    {
-        name = (*result)[0].GetCppString();
-        delete result;
-        return true;
-    }
+    PlayerDataCache data;
+    if (!GetPlayerDataCache(guid, data))
+        return false;
 
-    return false;
+    name = data.name;
+    return true;
 }
 
 Team ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
@@ -2526,18 +2526,11 @@ Team ObjectMgr::GetPlayerTeamByGUID(ObjectGuid guid) const
     if (Player* player = GetPlayer(guid))
         return Player::TeamForRace(player->getRace());
 
-    uint32 lowguid = guid.GetCounter();
+    PlayerDataCache data;
+    if (!GetPlayerDataCache(guid, data))
+        return TEAM_NONE;
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT race FROM characters WHERE guid = '%u'", lowguid);
-
-    if (result)
-    {
-        uint8 race = (*result)[0].GetUInt8();
-        delete result;
-        return Player::TeamForRace(race);
-    }
-
-    return TEAM_NONE;
+    return Player::TeamForRace(data.race);
 }
 
 uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
@@ -2549,30 +2542,225 @@ uint32 ObjectMgr::GetPlayerAccountIdByGUID(ObjectGuid guid) const
     if (Player* player = GetPlayer(guid))
         return player->GetSession()->GetAccountId();
 
-    uint32 lowguid = guid.GetCounter();
+    PlayerDataCache data;
+    if (!GetPlayerDataCache(guid, data))
+        return 0;
 
-    QueryResult* result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE guid = '%u'", lowguid);
-    if (result)
+    return data.account;
+}
+
+uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
+{
+    PlayerDataCache data;
+    if (!GetPlayerDataCacheByName(name, data))
+        return 0;
+
+    return data.account;
+}
+
+// names are compared case insensitive, as the characters.name column is
+static std::string PlayerDataCacheKey(std::string const& name)
+{
+    std::wstring wname;
+    if (!Utf8toWStr(name, wname))
+        return name;
+
+    wstrToLower(wname);
+
+    std::string key;
+    if (!WStrToUtf8(wname, key))
+        return name;
+
+    return key;
+}
+
+void ObjectMgr::LoadPlayerDataCache()
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+
+    m_playerDataCache.clear();
+    m_playerDataCacheByName.clear();
+
+    //                                                    0     1        2     3     4      5       6
+    QueryResult* result = CharacterDatabase.Query("SELECT guid, account, name, race, class, gender, level FROM characters");
+    if (!result)
     {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
+        BarGoLink bar(1);
+        bar.step();
+        sLog.outString(">> Loaded 0 character names");
+        sLog.outString();
+        return;
     }
 
-    return 0;
+    BarGoLink bar(result->GetRowCount());
+
+    do
+    {
+        bar.step();
+        Field* fields = result->Fetch();
+
+        PlayerDataCache data;
+        data.lowguid = fields[0].GetUInt32();
+        data.account = fields[1].GetUInt32();
+        data.name    = fields[2].GetCppString();
+        data.race    = fields[3].GetUInt8();
+        data.class_  = fields[4].GetUInt8();
+        data.gender  = fields[5].GetUInt8();
+        data.level   = fields[6].GetUInt32();
+
+        // deleted characters kept by CharDelete.Method have no name and account
+        if (data.name.empty())
+            continue;
+
+        UpdatePlayerDataCacheLocked(data);
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    sLog.outString(">> Loaded " SIZEFMTD " character names", m_playerDataCache.size());
+    sLog.outString();
 }
 
-uint32 ObjectMgr::GetPlayerAccountIdByPlayerName(const std::string& name) const
+bool ObjectMgr::LoadPlayerDataCacheFromDB(char const* where, PlayerDataCache& data) const
 {
-    QueryResult* result = CharacterDatabase.PQuery("SELECT account FROM characters WHERE name = '%s'", name.c_str());
-    if (result)
+    QueryResult* result = CharacterDatabase.PQuery("SELECT guid, account, name, race, class, gender, level FROM characters WHERE %s", where);
+    if (!result)
+        return false;
+
+    Field* fields = result->Fetch();
+    data.lowguid = fields[0].GetUInt32();
+    data.account = fields[1].GetUInt32();
+    data.name    = fields[2].GetCppString();
+    data.race    = fields[3].GetUInt8();
+    data.class_  = fields[4].GetUInt8();
+    data.gender  = fields[5].GetUInt8();
+    data.level   = fields[6].GetUInt32();
+    delete result;
+
+    if (data.name.empty())
+        return false;
+
+    // characters not known yet, like restored or imported ones
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    UpdatePlayerDataCacheLocked(data);
+    return true;
+}
+
+void ObjectMgr::UpdatePlayerDataCacheLocked(PlayerDataCache const& data) const
+{
+    auto itr = m_playerDataCache.find(data.lowguid);
+    if (itr != m_playerDataCache.end() && itr->second.name != data.name)
+        m_playerDataCacheByName.erase(PlayerDataCacheKey(itr->second.name));
+
+    m_playerDataCache[data.lowguid] = data;
+    m_playerDataCacheByName[PlayerDataCacheKey(data.name)] = data.lowguid;
+}
+
+void ObjectMgr::UpdatePlayerDataCache(PlayerDataCache const& data)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    UpdatePlayerDataCacheLocked(data);
+}
+
+void ObjectMgr::UpdatePlayerDataCacheName(uint32 lowguid, std::string const& name)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    auto itr = m_playerDataCache.find(lowguid);
+    if (itr == m_playerDataCache.end())
+        return;
+
+    PlayerDataCache data = itr->second;
+    data.name = name;
+    UpdatePlayerDataCacheLocked(data);
+}
+
+void ObjectMgr::UpdatePlayerDataCacheLevel(uint32 lowguid, uint32 level)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    auto itr = m_playerDataCache.find(lowguid);
+    if (itr != m_playerDataCache.end())
+        itr->second.level = level;
+}
+
+void ObjectMgr::RemovePlayerDataCache(uint32 lowguid)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    auto itr = m_playerDataCache.find(lowguid);
+    if (itr == m_playerDataCache.end())
+        return;
+
+    m_playerDataCacheByName.erase(PlayerDataCacheKey(itr->second.name));
+    m_playerDataCache.erase(itr);
+    m_nameQueryResponses.erase(lowguid);
+}
+
+bool ObjectMgr::GetPlayerDataCache(ObjectGuid guid, PlayerDataCache& data, bool loadFromDB /*= true*/) const
+{
+    if (!guid.IsPlayer())
+        return false;
+
     {
-        uint32 acc = (*result)[0].GetUInt32();
-        delete result;
-        return acc;
+        std::shared_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+        auto itr = m_playerDataCache.find(guid.GetCounter());
+        if (itr != m_playerDataCache.end())
+        {
+            data = itr->second;
+            return true;
+        }
     }
 
-    return 0;
+    if (!loadFromDB)
+        return false;
+
+    return LoadPlayerDataCacheFromDB(("guid = " + std::to_string(guid.GetCounter())).c_str(), data);
+}
+
+std::shared_ptr<WorldPacket const> ObjectMgr::GetNameQueryResponse(ObjectGuid guid) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    auto itr = m_nameQueryResponses.find(guid.GetCounter());
+    if (itr == m_nameQueryResponses.end() || itr->second.first != sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED))
+        return nullptr;
+
+    return itr->second.second;
+}
+
+void ObjectMgr::StoreNameQueryResponse(ObjectGuid guid, std::shared_ptr<WorldPacket const> const& packet)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    m_nameQueryResponses[guid.GetCounter()] = { sWorld.getConfig(CONFIG_BOOL_DECLINED_NAMES_USED), packet };
+}
+
+void ObjectMgr::InvalidateNameQueryResponse(ObjectGuid guid)
+{
+    std::unique_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+    m_nameQueryResponses.erase(guid.GetCounter());
+}
+
+bool ObjectMgr::GetPlayerDataCacheByName(std::string const& name, PlayerDataCache& data) const
+{
+    if (name.empty())
+        return false;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_playerDataCacheLock);
+        auto nameItr = m_playerDataCacheByName.find(PlayerDataCacheKey(name));
+        if (nameItr != m_playerDataCacheByName.end())
+        {
+            auto itr = m_playerDataCache.find(nameItr->second);
+            if (itr != m_playerDataCache.end())
+            {
+                data = itr->second;
+                return true;
+            }
+        }
+    }
+
+    // Player name safe to sending to DB (checked at login) and this function using
+    std::string safeName = name;
+    CharacterDatabase.escape_string(safeName);
+    return LoadPlayerDataCacheFromDB(("name = '" + safeName + "'").c_str(), data);
 }
 
 void ObjectMgr::LoadItemLocales()
@@ -2650,6 +2838,8 @@ struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader, SQLStorage>
     {
         dst = D(sScriptDevAIMgr.GetScriptId(src));
     }
+
+    std::string GetCacheKeyExtra() const { return sScriptDevAIMgr.GetScriptNamesKey(); }
 };
 
 void ObjectMgr::LoadItemPrototypes()
@@ -5544,6 +5734,8 @@ struct SQLInstanceLoader : public SQLStorageLoaderBase<SQLInstanceLoader, SQLSto
     {
         dst = D(sScriptDevAIMgr.GetScriptId(src));
     }
+
+    std::string GetCacheKeyExtra() const { return sScriptDevAIMgr.GetScriptNamesKey(); }
 };
 
 void ObjectMgr::LoadInstanceTemplate()
@@ -5623,6 +5815,8 @@ struct SQLWorldLoader : public SQLStorageLoaderBase<SQLWorldLoader, SQLStorage>
     {
         dst = D(sScriptDevAIMgr.GetScriptId(src));
     }
+
+    std::string GetCacheKeyExtra() const { return sScriptDevAIMgr.GetScriptNamesKey(); }
 };
 
 void ObjectMgr::LoadWorldTemplate()
@@ -5712,6 +5906,8 @@ void ObjectMgr::LoadConditions()
         }
     }
 
+    ConditionEntry::CompileAll();
+
     for (auto& mQuestTemplate : mQuestTemplates) // needs to be checked after loading conditions
     {
         Quest* qinfo = mQuestTemplate.second;
@@ -6231,7 +6427,7 @@ void ObjectMgr::LoadAreatriggerLocales()
                     if (var.StatusFailed.size() <= static_cast<size_t>(idx))
                         var.StatusFailed.resize(idx + 1);
 
-                    var.StatusFailed[idx] = str;
+                    var.StatusFailed[idx] = m_localeStrings.Intern(str);
                 }
             }
         }
@@ -7128,6 +7324,8 @@ struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQ
     {
         dst = D(sScriptDevAIMgr.GetScriptId(src));
     }
+
+    std::string GetCacheKeyExtra() const { return sScriptDevAIMgr.GetScriptNamesKey(); }
 };
 
 inline void CheckGOLockId(GameObjectInfo const* goInfo, uint32 dataN, uint32 N)
@@ -8461,6 +8659,8 @@ int ObjectMgr::GetStorageLocaleIndexFor(LocaleConstant loc)
     if (loc == DEFAULT_LOCALE)
         return -1;
 
+    std::lock_guard<std::mutex> guard(m_localeIndexLock);
+
     for (size_t i = 0; i < m_LocalForIndex.size(); ++i)
         if (m_LocalForIndex[i] == loc)
             return i;
@@ -8473,6 +8673,8 @@ int ObjectMgr::GetOrNewStorageLocaleIndexFor(LocaleConstant loc)
     if (loc == DEFAULT_LOCALE)
         return -1;
 
+    std::lock_guard<std::mutex> guard(m_localeIndexLock);
+
     for (size_t i = 0; i < m_LocalForIndex.size(); ++i)
         if (m_LocalForIndex[i] == loc)
             return i;
@@ -9368,6 +9570,13 @@ void ObjectMgr::LoadActiveEntities(Map* _map)
     // Load active objects for _map
     if (sWorld.isForceLoadMap(_map->GetId()))
     {
+        // read the terrain of all grids at once before loading them one by one
+        std::vector<GridPair> grids;
+        for (CreatureDataMap::const_iterator itr = mCreatureDataMap.begin(); itr != mCreatureDataMap.end(); ++itr)
+            if (itr->second.mapid == _map->GetId())
+                grids.push_back(MaNGOS::ComputeGridPair(itr->second.posX, itr->second.posY));
+        _map->PreloadTerrain(grids);
+
         for (CreatureDataMap::const_iterator itr = mCreatureDataMap.begin(); itr != mCreatureDataMap.end(); ++itr)
         {
             if (itr->second.mapid == _map->GetId())
@@ -9904,11 +10113,13 @@ void ObjectMgr::GetCreatureLocaleStrings(uint32 entry, int32 loc_idx, char const
     {
         if (CreatureLocale const* il = GetCreatureLocale(entry))
         {
-            if (namePtr && il->Name.size() > size_t(loc_idx) && !il->Name[loc_idx].empty())
-                *namePtr = il->Name[loc_idx].c_str();
+            if (namePtr)
+                if (char const* name = GetLocaleString(il->Name, loc_idx))
+                    *namePtr = name;
 
-            if (subnamePtr && il->SubName.size() > size_t(loc_idx) && !il->SubName[loc_idx].empty())
-                *subnamePtr = il->SubName[loc_idx].c_str();
+            if (subnamePtr)
+                if (char const* subName = GetLocaleString(il->SubName, loc_idx))
+                    *subnamePtr = subName;
         }
     }
 }
@@ -10009,8 +10220,8 @@ void ObjectMgr::GetAreaTriggerLocales(uint32 entry, int32 loc_idx, std::string*
         if (AreaTriggerLocale const* atL = GetAreaTriggerLocale(entry))
         {
             if (titlePtr)
-                if (atL->StatusFailed.size() > (size_t)loc_idx && !atL->StatusFailed[loc_idx].empty())
-                    *titlePtr = atL->StatusFailed[loc_idx];
+                if (char const* title = GetLocaleString(atL->StatusFailed, loc_idx))
+                    *titlePtr = title;
         }
     }
 }
@@ -38,6 +38,7 @@
 
 #include <map>
 #include <climits>
+#include <shared_mutex>
 
 class Group;
 class ArenaTeam;
@@ -57,6 +58,18 @@ struct GameTele
 
 typedef std::unordered_map<uint32, GameTele > GameTeleMap;
 
+// characters table data that does not change while the character is offline, for lookups without DB access
+struct PlayerDataCache
+{
+    uint32 lowguid;
+    uint32 account;
+    std::string name;
+    uint8 race;
+    uint8 class_;
+    uint8 gender;
+    uint32 level;
+};
+
 struct AreaTrigger
 {
     uint32 entry;
@@ -522,6 +535,20 @@ class ObjectMgr
         uint32 GetPlayerAccountIdByGUID(ObjectGuid guid) const;
         uint32 GetPlayerAccountIdByPlayerName(const std::string& name) const;
 
+        // filled at startup and kept up to date by character save, rename and delete, misses fall back to the DB
+        void LoadPlayerDataCache();
+        void UpdatePlayerDataCache(PlayerDataCache const& data);
+        void UpdatePlayerDataCacheName(uint32 lowguid, std::string const& name);
+        void UpdatePlayerDataCacheLevel(uint32 lowguid, uint32 level);
+        void RemovePlayerDataCache(uint32 lowguid);
+        bool GetPlayerDataCache(ObjectGuid guid, PlayerDataCache& data, bool loadFromDB = true) const;
+        bool GetPlayerDataCacheByName(std::string const& name, PlayerDataCache& data) const;
+
+        // built SMSG_NAME_QUERY_RESPONSE of existing characters, sent as is to every session querying them
+        std::shared_ptr<WorldPacket const> GetNameQueryResponse(ObjectGuid guid) const;
+        void StoreNameQueryResponse(ObjectGuid guid, std::shared_ptr<WorldPacket const> const& packet);
+        void InvalidateNameQueryResponse(ObjectGuid guid);
+
         bool AddTaxiShortcut(const TaxiPathEntry* path, uint32 lengthTakeoff, uint32 lengthLanding);
         bool GetTaxiShortcut(uint32 pathid, TaxiShortcutData& data);
         void LoadTaxiShortcuts();
@@ -862,6 +889,13 @@ class ObjectMgr
 
         void GetCreatureLocaleStrings(uint32 entry, int32 loc_idx, char const** namePtr, char const** subnamePtr = nullptr) const;
 
+        // text of a pooled localized field for a storage locale index, nullptr if it has none
+        char const* GetLocaleString(std::vector<uint32> const& field, int32 loc_idx) const
+        {
+            uint32 offset = LocaleStringPool::GetOffset(field, loc_idx);
+            return offset ? m_localeStrings.Get(offset) : nullptr;
+        }
+
         GameObjectLocale const* GetGameObjectLocale(uint32 entry) const
         {
             GameObjectLocaleMap::const_iterator itr = mGameObjectLocaleMap.find(entry);
@@ -1003,10 +1037,7 @@ class ObjectMgr
         int GetOrNewStorageLocaleIndexFor(LocaleConstant loc);
 
         // global grid objects state (static DB spawns, global spawn mods from gameevent system)
-        CellObjectGuids const& GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id)
-        {
-            return mMapObjectGuids[MAKE_PAIR32(mapid, spawnMode)][cell_id];
-        }
+        CellObjectGuids const& GetCellObjectGuids(uint16 mapid, uint8 spawnMode, uint32 cell_id) const;
 
         // modifiers for global grid objects state (static DB spawns, global spawn mods from gameevent system)
         // Don't must be used for modify instance specific spawn state modifications
@@ -1280,6 +1311,7 @@ class ObjectMgr
 
         typedef             std::vector<LocaleConstant> LocalForIndex;
         LocalForIndex        m_LocalForIndex;
+        std::mutex           m_localeIndexLock;             // locale tables are loaded by several threads at startup
 
         ExclusiveQuestGroupsMap m_ExclusiveQuestGroups;
 
@@ -1345,6 +1377,7 @@ class ObjectMgr
         GossipMenuItemsLocaleMap mGossipMenuItemsLocaleMap;
         PointOfInterestLocaleMap mPointOfInterestLocaleMap;
         AreaTriggerLocaleMap m_areaTriggerLocaleMap;
+        LocaleStringPool m_localeStrings;                   // creature, gossip option, POI and area trigger locale texts
 
         DungeonEncounterMap m_DungeonEncounters;
         DungeonEncounterMap m_DungeonEncountersByMap;
@@ -1371,6 +1404,15 @@ class ObjectMgr
         std::shared_ptr<SpawnGroupEntryContainer> m_spawnGroupEntries;
 
         std::map<int32, WorldStateName> m_worldStateNames;
+
+        // read by map threads and sessions, written on character save and by lookups missing the cache
+        bool LoadPlayerDataCacheFromDB(char const* where, PlayerDataCache& data) const;
+        void UpdatePlayerDataCacheLocked(PlayerDataCache const& data) const;
+        mutable std::unordered_map<uint32 /*lowguid*/, PlayerDataCache> m_playerDataCache;
+        mutable std::unordered_map<std::string /*lowercase name*/, uint32 /*lowguid*/> m_playerDataCacheByName;
+        // response content depends on Declinedname, kept with the setting it was built with
+        std::unordered_map<uint32 /*lowguid*/, std::pair<bool /*declined names*/, std::shared_ptr<WorldPacket const>>> m_nameQueryResponses;
+        mutable std::shared_mutex m_playerDataCacheLock;
 };
 
 #define sObjectMgr MaNGOS::Singleton<ObjectMgr>::Instance()
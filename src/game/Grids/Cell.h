@@ -117,6 +117,9 @@ struct Cell
         template<class T> static void VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
         template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
+        // calls visitor.Visit(Unit*) for the players and creatures of loaded cells found in range by the cell position indexes
+        template<class T> static void VisitUnits(float x, float y, Map* map, T& visitor, float radius);
+
     private:
         template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER>&, Map&, const CellPair&, const CellPair&) const;
 };
@@ -23,6 +23,7 @@
 #include "Grids/Cell.h"
 #include "Maps/Map.h"
 #include <cmath>
+#include <vector>
 
 inline Cell::Cell(CellPair const& p)
 {
@@ -61,6 +62,10 @@ template<class T, class CONTAINER>
 inline void
 Cell::Visit(const CellPair& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& m, float x, float y, float radius) const
 {
+    // none of the container types is in the visitor's VisitMask
+    if constexpr (!TypeContainerVisitor<T, CONTAINER>::IsNeeded)
+        return;
+
     if (standing_cell.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || standing_cell.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
         return;
 
@@ -244,4 +249,27 @@ inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float
     cell.Visit(p, wnotifier, *map, x, y, radius);
 }
 
+template<class T>
+inline void Cell::VisitUnits(float x, float y, Map* map, T& visitor, float radius)
+{
+    // lets limit the upper value for search radius
+    if (radius > MAX_VISIBILITY_DISTANCE)
+        radius = MAX_VISIBILITY_DISTANCE;
+
+    std::vector<Unit*> units;
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+    for (uint32 i = area.low_bound.x_coord; i <= area.high_bound.x_coord; ++i)
+    {
+        for (uint32 j = area.low_bound.y_coord; j <= area.high_bound.y_coord; ++j)
+        {
+            Cell cell(CellPair(i, j));
+            if (CellPositionIndex const* index = map->GetCellPositionIndex(cell))
+                index->Collect(x, y, radius, units);
+        }
+    }
+
+    for (Unit* unit : units)
+        visitor.Visit(unit);
+}
+
 #endif
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Grids/CellPositionIndex.h"
+#include "Entities/Player.h"
+#include "Entities/Creature.h"
+
+CellPositionIndex::~CellPositionIndex()
+{
+    for (WorldObject* obj : m_objects)
+        obj->m_cellPositionIndex = nullptr;
+}
+
+void CellPositionIndex::Insert(Player* obj)
+{
+    InsertObject(obj);
+}
+
+void CellPositionIndex::Insert(Creature* obj)
+{
+    InsertObject(obj);
+}
+
+void CellPositionIndex::Remove(Player* obj)
+{
+    RemoveObject(obj);
+}
+
+void CellPositionIndex::Remove(Creature* obj)
+{
+    RemoveObject(obj);
+}
+
+void CellPositionIndex::InsertObject(WorldObject* obj)
+{
+    if (obj->m_cellPositionIndex)
+        obj->m_cellPositionIndex->RemoveObject(obj);
+
+    obj->m_cellPositionIndex = this;
+    obj->m_cellPositionSlot = uint32(m_objects.size());
+    m_objects.push_back(obj);
+    m_x.push_back(0.f);
+    m_y.push_back(0.f);
+    m_extent.push_back(0.f);
+    Relocate(obj);
+}
+
+void CellPositionIndex::RemoveObject(WorldObject* obj)
+{
+    if (obj->m_cellPositionIndex != this)
+        return;
+
+    // move the last entry into the freed slot
+    uint32 slot = obj->m_cellPositionSlot;
+    uint32 last = uint32(m_objects.size()) - 1;
+    if (slot != last)
+    {
+        m_objects[slot] = m_objects[last];
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_extent[slot] = m_extent[last];
+        m_objects[slot]->m_cellPositionSlot = slot;
+    }
+
+    m_objects.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_extent.pop_back();
+    obj->m_cellPositionIndex = nullptr;
+}
+
+void CellPositionIndex::Relocate(WorldObject const* obj)
+{
+    uint32 slot = obj->m_cellPositionSlot;
+    m_x[slot] = obj->GetPositionX();
+    m_y[slot] = obj->GetPositionY();
+    m_extent[slot] = std::max(obj->GetCombatReach(), obj->GetObjectBoundingRadius());
+}
+
+void CellPositionIndex::Collect(float x, float y, float radius, std::vector<Unit*>& units) const
+{
+    // the distance pass only reads the coordinate arrays and writes flags, compilers vectorize it
+    const uint32 BLOCK_SIZE = 64;
+    uint8 inRange[BLOCK_SIZE];
+
+    uint32 count = uint32(m_objects.size());
+    for (uint32 start = 0; start < count; start += BLOCK_SIZE)
+    {
+        uint32 blockSize = std::min(BLOCK_SIZE, count - start);
+        float const* posX = &m_x[start];
+        float const* posY = &m_y[start];
+        float const* extent = &m_extent[start];
+        for (uint32 i = 0; i < blockSize; ++i)
+        {
+            float dx = posX[i] - x;
+            float dy = posY[i] - y;
+            float reach = radius + extent[i];
+            inRange[i] = (dx * dx + dy * dy) <= reach * reach;
+        }
+
+        for (uint32 i = 0; i < blockSize; ++i)
+            if (inRange[i])
+                units.push_back(static_cast<Unit*>(m_objects[start + i]));
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_CELL_POSITION_INDEX_H
+#define MANGOS_CELL_POSITION_INDEX_H
+
+#include "Common.h"
+
+#include <vector>
+
+class Creature;
+class Player;
+class Unit;
+class WorldObject;
+
+// Packed positions of the units within one cell, kept in sync by the cell containers and WorldObject::Relocate.
+// Radius searches filter the plain coordinate arrays first and only touch the units that can be in range,
+// instead of following the object lists and dereferencing every unit of the cell.
+class CellPositionIndex
+{
+    public:
+        CellPositionIndex() {}
+        CellPositionIndex(CellPositionIndex const&) = delete;
+        CellPositionIndex& operator=(CellPositionIndex const&) = delete;
+        ~CellPositionIndex();
+
+        // grid container hooks, only units are indexed
+        void Insert(Player* obj);
+        void Insert(Creature* obj);
+        template<class T> void Insert(T*) {}
+        void Remove(Player* obj);
+        void Remove(Creature* obj);
+        template<class T> void Remove(T*) {}
+
+        void Relocate(WorldObject const* obj);
+        void RemoveObject(WorldObject* obj);
+
+        // appends the units whose 2d distance to x, y minus their own combat reach or bounding radius is at most radius
+        void Collect(float x, float y, float radius, std::vector<Unit*>& units) const;
+
+        uint32 size() const { return uint32(m_objects.size()); }
+
+    private:
+        void InsertObject(WorldObject* obj);
+
+        std::vector<float> m_x;
+        std::vector<float> m_y;
+        std::vector<float> m_extent;
+        std::vector<WorldObject*> m_objects;
+};
+
+#endif
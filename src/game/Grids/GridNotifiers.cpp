@@ -26,18 +26,40 @@
 #include "Globals/ObjectAccessor.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "AI/BaseAI/UnitAI.h"
+#include "World/World.h"
 
 using namespace MaNGOS;
 
 void VisibleChangesNotifier::Visit(CameraMapType& m)
 {
+    // fellow passengers of a transport moving its passengers see no change between each other
+    GenericTransport* transport = i_object.GetTransport();
+    if (transport && !transport->IsRelocatingPassengers())
+        transport = nullptr;
+
     for (auto& iter : m)
     {
-        iter.getSource()->UpdateVisibilityOf(&i_object);
-        m_unvisitedGuids.erase(iter.getSource()->GetOwner()->GetObjectGuid());
+        Camera* camera = iter.getSource();
+        if (!transport || camera->GetBody() != camera->GetOwner() || camera->GetOwner()->GetTransport() != transport)
+            camera->UpdateVisibilityOf(&i_object);
+        m_unvisitedGuids.erase(camera->GetOwner()->GetObjectGuid());
     }
 }
 
+bool VisibleNotifier::IsUnchangedByMove(WorldObject* target) const
+{
+    if (!i_camera.GetOwner()->HasAtClient(target))
+        return false;
+
+    // trap detection depends on the distance
+    if (target->GetTypeId() == TYPEID_GAMEOBJECT && static_cast<GameObject*>(target)->GetGoType() == GAMEOBJECT_TYPE_TRAP)
+        return false;
+
+    // the center distance is never larger than the one the full check compares
+    float visibleDistance = target->GetVisibilityData().GetVisibilityDistance();
+    return target->GetDistance(i_camera.GetBody(), true, DIST_CALC_NONE) < visibleDistance * visibleDistance;
+}
+
 void VisibleNotifier::Notify()
 {
     Player& player = *i_camera.GetOwner();
@@ -45,14 +67,19 @@ void VisibleNotifier::Notify()
     // but exist one case when this possible and object not out of range: transports
     if (GenericTransport* transport = player.GetTransport())
     {
+        // passengers moved together by the transport keep their visibility between each other
+        bool groupMove = transport->IsRelocatingPassengers() && i_camera.GetBody() == &player;
         for (auto itr : transport->GetPassengers())
         {
             if (i_clientGUIDs.find(itr->GetObjectGuid()) != i_clientGUIDs.end())
             {
-                // ignore far sight case
-                if (itr->IsPlayer())
-                    static_cast<Player*>(itr)->UpdateVisibilityOf(static_cast<Player*>(itr), &player);
-                player.UpdateVisibilityOf(&player, itr, i_data, i_visibleNow);
+                if (!groupMove)
+                {
+                    // ignore far sight case
+                    if (itr->IsPlayer())
+                        static_cast<Player*>(itr)->UpdateVisibilityOf(static_cast<Player*>(itr), &player);
+                    player.UpdateVisibilityOf(&player, itr, i_data, i_visibleNow);
+                }
                 i_clientGUIDs.erase(itr->GetObjectGuid());
             }
         }
@@ -194,6 +221,14 @@ void ObjectUpdater::Visit(GridRefManager<T>& m)
         m_objectToUpdateSet.emplace(iter.getSource());
 }
 
+void ObjectUpdater::Visit(GameObjectMapType& m)
+{
+    time_t const now = sWorld.GetGameTime();
+    for (auto& iter : m)
+        if (!iter.getSource()->IsUpdateSleeping(now))
+            m_objectToUpdateSet.emplace(iter.getSource());
+}
+
 bool CannibalizeObjectCheck::operator()(Corpse* u)
 {
     // ignore bones
@@ -297,5 +332,4 @@ bool MaNGOS::AnyAssistCreatureInRangeCheck::operator()(Creature* u)
     return true;
 }
 
-template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
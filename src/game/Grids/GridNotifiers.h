@@ -35,19 +35,27 @@ namespace MaNGOS
 {
     struct VisibleNotifier
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_ALL & ~GRID_MAP_TYPE_MASK_CAMERA;
+
         Camera& i_camera;
         UpdateData i_data;
         GuidSet i_clientGUIDs;
         WorldObjectSet i_visibleNow;
+        bool i_afterMove;
 
-        explicit VisibleNotifier(Camera& c) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()) {}
+        VisibleNotifier(Camera& c, bool afterMove) : i_camera(c), i_clientGUIDs(c.GetOwner()->GetClientGuids()), i_afterMove(afterMove) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(CameraMapType& /*m*/) {}
         void Notify(void);
+
+        // target is at the client and stays in range, so moving the viewpoint did not change its visibility
+        bool IsUnchangedByMove(WorldObject* target) const;
     };
 
     struct VisibleChangesNotifier
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObject& i_object;
 
         explicit VisibleChangesNotifier(WorldObject& object) : i_object(object), m_unvisitedGuids(i_object.GetClientGuidsIAmAt()) {}
@@ -61,6 +69,8 @@ namespace MaNGOS
 
     struct MessageDeliverer
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         Player const& i_player;
         WorldPacket const& i_message;
         bool i_toSelf;
@@ -71,6 +81,8 @@ namespace MaNGOS
 
     struct MessageDelivererExcept
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldPacket const& i_message;
         Player const* i_skipped_receiver;
 
@@ -83,6 +95,8 @@ namespace MaNGOS
 
     struct ObjectMessageDeliverer
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldPacket const& i_message;
         explicit ObjectMessageDeliverer(WorldPacket const& msg) : i_message(msg) {}
         void Visit(CameraMapType& m);
@@ -91,6 +105,8 @@ namespace MaNGOS
 
     struct MessageDistDeliverer
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         Player const& i_player;
         WorldPacket const& i_message;
         bool i_toSelf;
@@ -105,6 +121,8 @@ namespace MaNGOS
 
     struct ObjectMessageDistDeliverer
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObject const& i_object;
         WorldPacket const& i_message;
         float i_dist;
@@ -115,12 +133,15 @@ namespace MaNGOS
 
     struct ObjectUpdater
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_GAMEOBJECT | GRID_MAP_TYPE_MASK_DYNAMICOBJECT;
+
         ObjectUpdater(WorldObjectUnSet& otus, const uint32& diff) : m_objectToUpdateSet(otus), m_timeDiff(diff) {}
         template<class T> void Visit(GridRefManager<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
         void Visit(CameraMapType&) {}
         void Visit(CreatureMapType&);
+        void Visit(GameObjectMapType&);
 
         private:
             WorldObjectUnSet& m_objectToUpdateSet;
@@ -129,6 +150,8 @@ namespace MaNGOS
 
     struct PlayerVisitObjectsNotifier
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         Player& i_player;
         PlayerVisitObjectsNotifier(Player& pl) : i_player(pl) {}
         template<class T> void Visit(GridRefManager<T>&) {}
@@ -140,6 +163,8 @@ namespace MaNGOS
 
     struct CreatureVisitObjectsNotifier
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         Creature& i_creature;
         CreatureVisitObjectsNotifier(Creature& c) : i_creature(c) {}
         template<class T> void Visit(GridRefManager<T>&) {}
@@ -151,6 +176,8 @@ namespace MaNGOS
 
     struct DynamicObjectUpdater
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         DynamicObject& i_dynobject;
         Unit* i_check;
         bool i_positive;
@@ -203,6 +230,8 @@ namespace MaNGOS
     template<class Check>
     struct WorldObjectSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_ALL & ~GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObject*& i_object;
         Check& i_check;
 
@@ -220,6 +249,8 @@ namespace MaNGOS
     template<class Check>
     struct WorldObjectListSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_ALL & ~GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObjectList& i_objects;
         Check& i_check;
 
@@ -237,6 +268,8 @@ namespace MaNGOS
     template<class Do>
     struct WorldObjectWorker
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_ALL & ~GRID_MAP_TYPE_MASK_CAMERA;
+
         Do const& i_do;
 
         explicit WorldObjectWorker(Do const& _do) : i_do(_do) {}
@@ -278,6 +311,8 @@ namespace MaNGOS
     template<class Check>
     struct GameObjectSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+
         GameObject*& i_object;
         Check& i_check;
 
@@ -292,6 +327,8 @@ namespace MaNGOS
     template<class Check>
     struct GameObjectLastSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+
         GameObject*& i_object;
         Check& i_check;
 
@@ -305,6 +342,8 @@ namespace MaNGOS
     template<class Check>
     struct GameObjectListSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_GAMEOBJECT;
+
         GameObjectList& i_objects;
         Check& i_check;
 
@@ -321,6 +360,8 @@ namespace MaNGOS
     template<class Check>
     struct UnitSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         Unit*& i_object;
         Check& i_check;
 
@@ -336,6 +377,8 @@ namespace MaNGOS
     template<class Check>
     struct UnitLastSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         Unit*& i_object;
         Check& i_check;
 
@@ -351,6 +394,8 @@ namespace MaNGOS
     template<class Check>
     struct UnitListSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER | GRID_MAP_TYPE_MASK_CREATURE;
+
         UnitList& i_objects;
         Check& i_check;
 
@@ -367,6 +412,8 @@ namespace MaNGOS
     template<class Check>
     struct CreatureSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CREATURE;
+
         Creature*& i_object;
         Check& i_check;
 
@@ -381,6 +428,8 @@ namespace MaNGOS
     template<class Check>
     struct CreatureLastSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CREATURE;
+
         Creature*& i_object;
         Check& i_check;
 
@@ -394,6 +443,8 @@ namespace MaNGOS
     template<class Check>
     struct CreatureListSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CREATURE;
+
         CreatureList& i_objects;
         Check& i_check;
 
@@ -407,6 +458,8 @@ namespace MaNGOS
     template<class Do>
     struct CreatureWorker
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CREATURE;
+
         Do& i_do;
 
         CreatureWorker(WorldObject const* /*searcher*/, Do& _do) : i_do(_do) {}
@@ -425,6 +478,8 @@ namespace MaNGOS
     template<class Check>
     struct PlayerSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER;
+
         Player*& i_object;
         Check& i_check;
 
@@ -438,6 +493,8 @@ namespace MaNGOS
     template<class Check>
     struct PlayerListSearcher
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER;
+
         PlayerList& i_objects;
         Check& i_check;
 
@@ -452,6 +509,8 @@ namespace MaNGOS
     template<class Do>
     struct PlayerWorker
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_PLAYER;
+
         Do& i_do;
 
         explicit PlayerWorker(Do& _do) : i_do(_do) {}
@@ -468,6 +527,8 @@ namespace MaNGOS
     template<class Do>
     struct CameraDistWorker
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObject const* i_searcher;
         float i_dist;
         Do& i_do;
@@ -489,6 +550,8 @@ namespace MaNGOS
 
     struct CameraDistLambdaWorker
     {
+        static constexpr uint32 VisitMask = GRID_MAP_TYPE_MASK_CAMERA;
+
         WorldObject const* i_searcher;
         float i_dist;
         std::function<void(Player*)> const& i_do;
@@ -35,7 +35,8 @@ inline void MaNGOS::VisibleNotifier::Visit(GridRefManager<T>& m)
 {
     for (typename GridRefManager<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
+        if (!i_afterMove || !IsUnchangedByMove(iter->getSource()))
+            i_camera.UpdateVisibilityOf(iter->getSource(), i_data, i_visibleNow);
         i_clientGUIDs.erase(iter->getSource()->GetObjectGuid());
     }
 }
@@ -205,6 +206,26 @@ inline void MaNGOS::DynamicObjectUpdater::VisitHelper(Unit* target)
     if (i_dynobject.GetDistance(target, true, DIST_CALC_NONE) > radius * radius)
         return;
 
+    SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(i_dynobject.GetSpellId());
+    SpellEffectIndex eff_index = i_dynobject.GetEffIndex();
+
+    // Already affected target still having the aura, only the duration may need a refresh from an overlapping dynobject
+    if (i_dynobject.IsAffecting(target))
+    {
+        if (SpellAuraHolder* holder = target->GetSpellAuraHolder(spellInfo->Id, i_dynobject.GetCasterGuid()))
+        {
+            if (holder->GetAuraByEffectIndex(eff_index))
+            {
+                if (holder->GetAuraDuration() >= 0 && uint32(holder->GetAuraDuration()) < i_dynobject.GetDuration())
+                {
+                    holder->SetAuraDuration(i_dynobject.GetDuration());
+                    holder->UpdateAuraDuration();
+                }
+                return;
+            }
+        }
+    }
+
     // Evade target
     if (target->GetCombatManager().IsInEvadeMode())
         return;
@@ -213,9 +234,6 @@ inline void MaNGOS::DynamicObjectUpdater::VisitHelper(Unit* target)
     if (target->GetTypeId() == TYPEID_PLAYER && target != i_check && (((Player*)target)->IsGameMaster() || ((Player*)target)->GetVisibility() == VISIBILITY_OFF))
         return;
 
-    SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(i_dynobject.GetSpellId());
-    SpellEffectIndex eff_index = i_dynobject.GetEffIndex();
-
     SQLMultiStorage::SQLMSIteratorBounds<SpellTargetEntry> bounds = sSpellScriptTargetStorage.getBounds<SpellTargetEntry>(spellInfo->Id);
     if (bounds.first != bounds.second)
     {
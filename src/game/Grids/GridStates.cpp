@@ -59,7 +59,8 @@ RemovalState::Update(Map& m, NGridType& grid, GridInfo& info, const uint32& x, c
     if (!info.getUnloadLock())
     {
         info.UpdateTimeTracker(t_diff);
-        if (info.getTimeTracker().Passed())
+        // an expired grid left over by the unload budget stays expired and is taken in a later update
+        if (info.getTimeTracker().Passed() && m.HasGridUnloadBudget())
         {
             if (!m.UnloadGrid(x, y, false))
             {
@@ -26,6 +26,7 @@
 #include "World/World.h"
 #include "Grids/CellImpl.h"
 #include "Maps/GridDefines.h"
+#include "Trace.h"
 
 class ObjectGridRespawnMover
 {
@@ -114,9 +115,14 @@ template<> void addUnitState(Creature* obj, CellPair const& cell_pair)
 template <class T>
 void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>& /*m*/, uint32& count, Map* map, GridType& grid)
 {
+    if (guid_set.empty())
+        return;
+
     BattleGround* bg = map->IsBattleGroundOrArena() ? ((BattleGroundMap*)map)->GetBG() : nullptr;
 
-    for (uint32 guid : guid_set)
+    // loading may spawn pooled objects into the same cell, which moves the guids of a CellGuidSet
+    std::vector<uint32> const guids(guid_set.begin(), guid_set.end());
+    for (uint32 guid : guids)
     {
         T* obj;
         if constexpr (std::is_same_v<T, GameObject>)
@@ -243,6 +249,7 @@ ObjectGridLoader::Load(GridType& grid)
 
 void ObjectGridLoader::LoadN(void)
 {
+    TRACE_ZONE_ID("ObjectGridLoader::LoadN", i_map->GetId());
     i_gameObjects = 0; i_creatures = 0; i_corpses = 0;
     i_cell.data.Part.cell_y = 0;
     for (unsigned int x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
@@ -251,7 +258,7 @@ void ObjectGridLoader::LoadN(void)
         for (unsigned int y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
         {
             i_cell.data.Part.cell_y = y;
-            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+            GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> loader;
             loader.Load(i_grid(x, y), *this);
         }
     }
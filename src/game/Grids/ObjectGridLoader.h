@@ -66,7 +66,7 @@ class ObjectGridUnloader
             {
                 for (unsigned int y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
                 {
-                    GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+                    GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> loader;
                     loader.Unload(i_grid(x, y), *this);
                 }
             }
@@ -89,7 +89,7 @@ class ObjectGridStoper
             {
                 for (unsigned int y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
                 {
-                    GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> loader;
+                    GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> loader;
                     loader.Stop(i_grid(x, y), *this);
                 }
             }
@@ -103,6 +103,6 @@ class ObjectGridStoper
         NGridType& i_grid;
 };
 
-typedef GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes> GridLoaderType;
+typedef GridLoader<Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> GridLoaderType;
 
 #endif
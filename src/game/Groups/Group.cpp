@@ -32,6 +32,7 @@
 #include "Maps/MapManager.h"
 #include "Maps/MapPersistentStateMgr.h"
 #include "Spells/SpellAuras.h"
+#include "Entities/CharacterLoginCache.h"
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotMgr.h"
 #endif
@@ -470,7 +471,10 @@ void Group::Disband(bool hideDestroy)
     {
         Player* player = sObjectMgr.GetPlayer(citr->guid);
         if (!player)
+        {
+            sCharacterLoginCache.Invalidate(citr->guid);
             continue;
+        }
 
         // we cannot call _removeMember because it would invalidate member iterator
         // if we are removing player from battleground raid
@@ -730,6 +734,8 @@ void Group::UpdateOfflineLeader(time_t time, uint32 delay)
 
 void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore) const
 {
+    SharedWorldPacket sharedPacket(packet);
+
     for (auto itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -737,12 +743,14 @@ void Group::BroadcastPacket(WorldPacket const& packet, bool ignorePlayersInBGRai
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            pl->GetSession()->SendPacket(sharedPacket);
     }
 }
 
 void Group::BroadcastPacketInRange(WorldObject const* who, WorldPacket const& packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore) const
 {
+    SharedWorldPacket sharedPacket(packet);
+
     for (auto itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* pl = itr->getSource();
@@ -753,7 +761,7 @@ void Group::BroadcastPacketInRange(WorldObject const* who, WorldPacket const& pa
             continue;
 
         if (pl->GetSession() && (group == -1 || itr->getSubGroup() == group))
-            pl->GetSession()->SendPacket(packet);
+            pl->GetSession()->SendPacket(sharedPacket);
     }
 }
 
@@ -897,7 +905,10 @@ bool Group::_removeMember(ObjectGuid guid)
     }
 
     if (!IsBattleGroup())
+    {
         CharacterDatabase.PExecute("DELETE FROM group_member WHERE memberGuid='%u'", guid.GetCounter());
+        sCharacterLoginCache.Invalidate(guid);
+    }
 
     if (m_leaderGuid == guid)                               // leader was removed
     {
@@ -30,6 +30,7 @@
 #include "Tools/Language.h"
 #include "World/World.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/CharacterLoginCache.h"
 
 //// MemberSlot ////////////////////////////////////////////
 void MemberSlot::SetMemberStats(Player* player)
@@ -72,6 +73,8 @@ void MemberSlot::ChangeRank(uint32 newRank)
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
         player->SetRank(newRank);
+    else
+        sCharacterLoginCache.Invalidate(guid);
 
     CharacterDatabase.PExecute("UPDATE guild_member SET `rank`='%u' WHERE guid='%u'", newRank, guid.GetCounter());
 }
@@ -101,6 +104,16 @@ Guild::Guild()
     m_GuildBankEventLogNextGuid_Money = 0;
     for (unsigned int& i : m_GuildBankEventLogNextGuid_Item)
         i = 0;
+
+    m_GuildEventLog.set_capacity(GUILD_EVENTLOG_MAX_RECORDS);
+    m_GuildBankEventLog_Money.set_capacity(GUILD_BANK_MAX_LOGS);
+    for (GuildBankEventLog& log : m_GuildBankEventLog_Item)
+        log.set_capacity(GUILD_BANK_MAX_LOGS);
+
+    m_bankLoaded = false;
+    m_eventLogLoaded = false;
+    m_bankEventLogLoaded = false;
+    m_dataAccessTime = 0;
 }
 
 Guild::~Guild()
@@ -256,6 +269,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         pl->SetInGuild(m_Id);
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
+        MemberLoggedIn(pl);
     }
 
     UpdateAccountsNumber();
@@ -531,6 +545,8 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
 {
     uint32 lowguid = guid.GetCounter();
 
+    sCharacterLoginCache.Invalidate(guid);
+
     // guild master can be deleted when loading guild and guid doesn't exist in characters table
     // or when he is removed from guild by gm command
     if (m_LeaderGuid == guid && !isDisbanding)
@@ -571,6 +587,7 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     members.erase(lowguid);
+    MemberLoggedOut(guid);
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -599,13 +616,15 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
 
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    SharedWorldPacket sharedData(data);
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
-            pl->GetSession()->SendPacket(data);
+        if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+            pl->GetSession()->SendPacket(sharedData);
     }
 }
 
@@ -618,41 +637,58 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
     if (!player || !HasRankRight(player->GetRank(), GR_RIGHT_OFFCHATSPEAK))
         return;
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    SharedWorldPacket sharedData(data);
 
-        Player* pl = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        Player* pl = itr->second;
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
-            pl->GetSession()->SendPacket(data);
+        if (pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+            pl->GetSession()->SendPacket(sharedData);
     }
 }
 
 void Guild::BroadcastPacket(WorldPacket const& packet) const
 {
-    for (MemberList::const_iterator itr = members.cbegin(); itr != members.cend(); ++itr)
-    {
-        Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
-            player->GetSession()->SendPacket(packet);
-    }
+    SharedWorldPacket sharedPacket(packet);
+
+    std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.cbegin(); itr != m_onlineMembers.cend(); ++itr)
+        if (itr->second->GetSession())
+            itr->second->GetSession()->SendPacket(sharedPacket);
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket const& packet, uint32 rankId) const
 {
-    for (MemberList::const_iterator itr = members.cbegin(); itr != members.cend(); ++itr)
+    SharedWorldPacket sharedPacket(packet);
+
+    std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.cbegin(); itr != m_onlineMembers.cend(); ++itr)
     {
-        if (itr->second.RankId == rankId)
-        {
-            Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
-                player->GetSession()->SendPacket(packet);
-        }
+        MemberList::const_iterator member = members.find(itr->first);
+        if (member != members.end() && member->second.RankId == rankId && itr->second->GetSession())
+            itr->second->GetSession()->SendPacket(sharedPacket);
     }
 }
 
+void Guild::MemberLoggedIn(Player* player)
+{
+    if (!GetMemberSlot(player->GetObjectGuid()))
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    m_onlineMembers[player->GetGUIDLow()] = player;
+}
+
+void Guild::MemberLoggedOut(ObjectGuid guid)
+{
+    std::unique_lock<std::shared_mutex> lock(m_onlineMembersLock);
+    m_onlineMembers.erase(guid.GetCounter());
+}
+
 void Guild::CreateRank(std::string name_, uint32 rights)
 {
     if (m_Ranks.size() >= GUILD_RANKS_MAX_COUNT)
@@ -753,6 +789,7 @@ void Guild::Disband()
     CharacterDatabase.PExecute("DELETE FROM guild_bank_tab WHERE guildid = '%u'", m_Id);
 
     // Free bank tab used memory and delete items stored in them
+    EnsureGuildBankLoaded();
     DeleteGuildBankItems(true);
 
     CharacterDatabase.PExecute("DELETE FROM guild_bank_item WHERE guildid = '%u'", m_Id);
@@ -881,6 +918,8 @@ uint32 Guild::GetAccountsNumber()
 // Display guild eventlog
 void Guild::DisplayGuildEventLog(WorldSession* session)
 {
+    EnsureGuildEventLogLoaded();
+
     // Sending result
     WorldPacket data(MSG_GUILD_EVENT_LOG_QUERY, 0);
     // count, max count == 100
@@ -944,6 +983,8 @@ void Guild::LoadGuildEventLogFromDB()
 // Add entry to guild eventlog
 void Guild::LogGuildEvent(uint8 EventType, ObjectGuid playerGuid1, ObjectGuid playerGuid2, uint8 newRank)
 {
+    EnsureGuildEventLogLoaded();                            // LogGuid continues from the stored records
+
     GuildEventLogEntry NewEvent;
     // Create event
     NewEvent.EventType = EventType;
@@ -953,10 +994,7 @@ void Guild::LogGuildEvent(uint8 EventType, ObjectGuid playerGuid1, ObjectGuid pl
     NewEvent.TimeStamp = uint32(time(nullptr));
     // Count new LogGuid
     m_GuildEventLogNextGuid = (m_GuildEventLogNextGuid + 1) % sWorld.getConfig(CONFIG_UINT32_GUILD_EVENT_LOG_COUNT);
-    // Check max records limit
-    if (m_GuildEventLog.size() >= GUILD_EVENTLOG_MAX_RECORDS)
-        m_GuildEventLog.pop_front();
-    // Add event to list
+    // Add event to list, drops the oldest one at max records limit
     m_GuildEventLog.push_back(NewEvent);
     // Save event to DB
     CharacterDatabase.PExecute("DELETE FROM guild_eventlog WHERE guildid='%u' AND LogGuid='%u'", m_Id, m_GuildEventLogNextGuid);
@@ -970,6 +1008,8 @@ void Guild::LogGuildEvent(uint8 EventType, ObjectGuid playerGuid1, ObjectGuid pl
 // Bank content related
 void Guild::DisplayGuildBankContent(WorldSession* session, uint8 TabId)
 {
+    EnsureGuildBankLoaded();
+
     GuildBankTab const* tab = m_TabListMap[TabId];
 
     if (!IsMemberHaveRights(session->GetPlayer()->GetGUIDLow(), TabId, GUILD_BANK_RIGHT_VIEW_TAB))
@@ -1101,6 +1141,8 @@ Item* Guild::GetItem(uint8 TabId, uint8 SlotId)
 
 void Guild::DisplayGuildBankTabsInfo(WorldSession* session)
 {
+    EnsureGuildBankLoaded();
+
     WorldPacket data(SMSG_GUILD_BANK_LIST, 500);
 
     data << uint64(GetGuildBankMoney());
@@ -1126,6 +1168,8 @@ void Guild::CreateNewBankTab()
     if (GetPurchasedTabs() >= GUILD_BANK_MAX_TABS)
         return;
 
+    EnsureGuildBankLoaded();
+
     uint32 tabId = GetPurchasedTabs();                      // next free id
     m_TabListMap.push_back(new GuildBankTab);
 
@@ -1137,6 +1181,8 @@ void Guild::CreateNewBankTab()
 
 void Guild::SetGuildBankTabInfo(uint8 TabId, std::string Name, std::string Icon)
 {
+    EnsureGuildBankLoaded();
+
     if (m_TabListMap[TabId]->Name == Name && m_TabListMap[TabId]->Icon == Icon)
         return;
 
@@ -1159,14 +1205,13 @@ uint32 Guild::GetBankRights(uint32 rankId, uint8 TabId) const
 // *************************************************
 // Guild bank loading related
 
-// This load should be called on startup only
 void Guild::LoadGuildBankFromDB()
 {
     //                                                     0      1        2        3
     QueryResult* result = CharacterDatabase.PQuery("SELECT TabId, TabName, TabIcon, TabText FROM guild_bank_tab WHERE guildid='%u' ORDER BY TabId", m_Id);
     if (!result)
     {
-        m_TabListMap.clear();
+        DeleteGuildBankItems();
         return;
     }
 
@@ -1180,13 +1225,11 @@ void Guild::LoadGuildBankFromDB()
             continue;
         }
 
-        GuildBankTab* NewTab = new GuildBankTab;
-
-        NewTab->Name = fields[1].GetCppString();
-        NewTab->Icon = fields[2].GetCppString();
-        NewTab->Text = fields[3].GetCppString();
+        GuildBankTab* tab = m_TabListMap[tabId];            // created empty by LoadGuildFromDB
 
-        m_TabListMap[tabId] = NewTab;
+        tab->Name = fields[1].GetCppString();
+        tab->Icon = fields[2].GetCppString();
+        tab->Text = fields[3].GetCppString();
     }
     while (result->NextRow());
 
@@ -1572,6 +1615,8 @@ void Guild::DisplayGuildBankLogs(WorldSession* session, uint8 TabId)
     if (TabId > GUILD_BANK_MAX_TABS)
         return;
 
+    EnsureGuildBankEventLogLoaded();
+
     if (TabId == GUILD_BANK_MAX_TABS)
     {
         // Here we display money logs
@@ -1611,6 +1656,8 @@ void Guild::DisplayGuildBankLogs(WorldSession* session, uint8 TabId)
 
 void Guild::LogBankEvent(uint8 EventType, uint8 TabId, uint32 PlayerGuidLow, uint32 ItemOrMoney, uint8 ItemStackCount, uint8 DestTabId)
 {
+    EnsureGuildBankEventLogLoaded();                        // LogGuid continues from the stored records
+
     // create Event
     GuildBankEventLogEntry NewEvent;
     NewEvent.EventType = EventType;
@@ -1628,18 +1675,12 @@ void Guild::LogBankEvent(uint8 EventType, uint8 TabId, uint32 PlayerGuidLow, uin
         m_GuildBankEventLogNextGuid_Money = (m_GuildBankEventLogNextGuid_Money + 1) % sWorld.getConfig(CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT);
         currentLogGuid = m_GuildBankEventLogNextGuid_Money;
         currentTabId = GUILD_BANK_MONEY_LOGS_TAB;
-        if (m_GuildBankEventLog_Money.size() >= GUILD_BANK_MAX_LOGS)
-            m_GuildBankEventLog_Money.pop_front();
-
-        m_GuildBankEventLog_Money.push_back(NewEvent);
+        m_GuildBankEventLog_Money.push_back(NewEvent);      // drops the oldest one at GUILD_BANK_MAX_LOGS
     }
     else
     {
         m_GuildBankEventLogNextGuid_Item[TabId] = ((m_GuildBankEventLogNextGuid_Item[TabId]) + 1) % sWorld.getConfig(CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT);
         currentLogGuid = m_GuildBankEventLogNextGuid_Item[TabId];
-        if (m_GuildBankEventLog_Item[TabId].size() >= GUILD_BANK_MAX_LOGS)
-            m_GuildBankEventLog_Item[TabId].pop_front();
-
         m_GuildBankEventLog_Item[TabId].push_back(NewEvent);
     }
 
@@ -1921,6 +1962,8 @@ void Guild::SetGuildBankTabText(uint8 TabId, std::string text)
     if (TabId >= GetPurchasedTabs())
         return;
 
+    EnsureGuildBankLoaded();
+
     if (!m_TabListMap[TabId])
         return;
 
@@ -1940,6 +1983,8 @@ void Guild::SetGuildBankTabText(uint8 TabId, std::string text)
 
 void Guild::SendGuildBankTabText(WorldSession* session, uint8 TabId)
 {
+    EnsureGuildBankLoaded();
+
     GuildBankTab const* tab = m_TabListMap[TabId];
 
     WorldPacket data(MSG_QUERY_GUILD_BANK_TEXT, 1 + tab->Text.size() + 1);
@@ -1958,6 +2003,8 @@ void Guild::SwapItems(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankTa
     if (BankTab == BankTabDst && BankTabSlot == BankTabSlotDst)
         return;
 
+    EnsureGuildBankLoaded();
+
     Item* pItemSrc = GetItem(BankTab, BankTabSlot);
     if (!pItemSrc)                                      // may prevent crash
         return;
@@ -2080,6 +2127,8 @@ void Guild::SwapItems(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 BankTa
 
 void Guild::MoveFromBankToChar(Player* pl, uint8 BankTab, uint8 BankTabSlot, uint8 PlayerBag, uint8 PlayerSlot, uint32 SplitedAmount)
 {
+    EnsureGuildBankLoaded();
+
     Item* pItemBank = GetItem(BankTab, BankTabSlot);
     Item* pItemChar = pl->GetItemByPos(PlayerBag, PlayerSlot);
 
@@ -2229,6 +2278,8 @@ void Guild::MoveFromBankToChar(Player* pl, uint8 BankTab, uint8 BankTabSlot, uin
 
 void Guild::MoveFromCharToBank(Player* pl, uint8 PlayerBag, uint8 PlayerSlot, uint8 BankTab, uint8 BankTabSlot, uint32 SplitedAmount)
 {
+    EnsureGuildBankLoaded();
+
     Item* pItemBank = GetItem(BankTab, BankTabSlot);
     Item* pItemChar = pl->GetItemByPos(PlayerBag, PlayerSlot);
 
@@ -2377,8 +2428,10 @@ void Guild::MoveFromCharToBank(Player* pl, uint8 PlayerBag, uint8 PlayerSlot, ui
     }
 }
 
-ObjectGuid Guild::GetGuildInviter(ObjectGuid playerGuid) const
+ObjectGuid Guild::GetGuildInviter(ObjectGuid playerGuid)
 {
+    EnsureGuildEventLogLoaded();
+
     for (auto const& itr : m_GuildEventLog)
     {
         if (itr.EventType == GUILD_EVENT_LOG_INVITE_PLAYER &&
@@ -2439,6 +2492,100 @@ void Guild::DeleteGuildBankItems(bool alsoInDB /*= false*/)
     m_TabListMap.clear();
 }
 
+void Guild::EnsureGuildBankLoaded()
+{
+    m_dataAccessTime = time(nullptr);
+    if (m_bankLoaded)
+        return;
+
+    m_bankLoaded = true;
+    LoadGuildBankFromDB();
+}
+
+void Guild::EnsureGuildEventLogLoaded()
+{
+    m_dataAccessTime = time(nullptr);
+    if (m_eventLogLoaded)
+        return;
+
+    m_eventLogLoaded = true;
+    LoadGuildEventLogFromDB();
+}
+
+void Guild::EnsureGuildBankEventLogLoaded()
+{
+    m_dataAccessTime = time(nullptr);
+    if (m_bankEventLogLoaded)
+        return;
+
+    m_bankEventLogLoaded = true;
+    LoadGuildBankEventLogFromDB();
+}
+
+// keeps the purchased tabs, only their content is dropped
+void Guild::UnloadGuildBank()
+{
+    for (GuildBankTab* tab : m_TabListMap)
+    {
+        for (Item*& pItem : tab->Slots)
+        {
+            if (!pItem)
+                continue;
+
+            pItem->RemoveFromWorld();
+            delete pItem;
+            pItem = nullptr;
+        }
+        tab->Name.clear();
+        tab->Icon.clear();
+        tab->Text.clear();
+    }
+}
+
+void Guild::UnloadIdleData(time_t now, uint32 delay)
+{
+    if (!m_bankLoaded && !m_eventLogLoaded && !m_bankEventLogLoaded)
+        return;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+        if (!m_onlineMembers.empty())
+        {
+            m_dataAccessTime = now;
+            return;
+        }
+    }
+
+    if (now < m_dataAccessTime + time_t(delay))
+        return;
+
+    if (m_bankLoaded)
+    {
+        UnloadGuildBank();
+        m_bankLoaded = false;
+    }
+
+    // the next LogGuid values are read again with the records
+    if (m_eventLogLoaded)
+    {
+        m_GuildEventLog.clear();
+        m_GuildEventLogNextGuid = 0;
+        m_eventLogLoaded = false;
+    }
+
+    if (m_bankEventLogLoaded)
+    {
+        m_GuildBankEventLog_Money.clear();
+        m_GuildBankEventLogNextGuid_Money = 0;
+        for (uint8 i = 0; i < GUILD_BANK_MAX_TABS; ++i)
+        {
+            m_GuildBankEventLog_Item[i].clear();
+            m_GuildBankEventLogNextGuid_Item[i] = 0;
+        }
+        m_bankEventLogLoaded = false;
+    }
+}
+
 bool GuildItemPosCount::isContainedIn(GuildItemPosCountVec const& vec) const
 {
     for (auto itr : vec)
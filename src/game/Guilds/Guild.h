@@ -27,6 +27,9 @@
 #include "Globals/ObjectAccessor.h"
 #include "Globals/SharedDefines.h"
 
+#include <boost/circular_buffer.hpp>
+#include <shared_mutex>
+
 class Item;
 
 #define GUILD_RANKS_MIN_COUNT   5
@@ -353,12 +356,16 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = nullptr)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
-                    if (player != except)
-                        _do(player);
+            std::shared_lock<std::shared_mutex> lock(m_onlineMembersLock);
+            for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (itr->second != except)
+                    _do(itr->second);
         }
 
+        // online members are tracked at login/logout so broadcasts do not look up every member
+        void MemberLoggedIn(Player* player);
+        void MemberLoggedOut(ObjectGuid guid);
+
         void CreateRank(std::string name_, uint32 rights);
         void DelRank();
         std::string GetRankName(uint32 rankId);
@@ -397,10 +404,9 @@ class Guild
         void Query(WorldSession* session);
 
         // Guild EventLog
-        void   LoadGuildEventLogFromDB();
         void   DisplayGuildEventLog(WorldSession* session);
         void   LogGuildEvent(uint8 EventType, ObjectGuid playerGuid1, ObjectGuid playerGuid2 = ObjectGuid(), uint8 newRank = 0);
-        ObjectGuid GetGuildInviter(ObjectGuid playerGuid) const;
+        ObjectGuid GetGuildInviter(ObjectGuid playerGuid);
 
         // ** Guild bank **
         // Content & item deposit/withdraw
@@ -420,8 +426,6 @@ class Guild
         uint8  GetPurchasedTabs() const { return m_TabListMap.size(); }
         uint32 GetBankRights(uint32 rankId, uint8 TabId) const;
         bool   IsMemberHaveRights(uint32 LowGuid, uint8 TabId, uint32 rights) const;
-        // Load
-        void   LoadGuildBankFromDB();
         // Money deposit/withdraw
         void   SendMoneyInfo(WorldSession* session, uint32 LowGuid);
         bool   MemberMoneyWithdraw(uint32 amount, uint32 LowGuid);
@@ -438,11 +442,13 @@ class Guild
         // rights per day
         bool   LoadBankRightsFromDB(QueryResult* guildBankTabRightsResult);
         // Guild Bank Event Logs
-        void   LoadGuildBankEventLogFromDB();
         void   DisplayGuildBankLogs(WorldSession* session, uint8 TabId);
         void   LogBankEvent(uint8 EventType, uint8 TabId, uint32 PlayerGuidLow, uint32 ItemOrMoney, uint8 ItemStackCount = 0, uint8 DestTabId = 0);
         bool   AddGBankItemToDB(uint32 GuildId, uint32 BankTab, uint32 BankTabSlot, uint32 GUIDLow, uint32 Entry) const;
 
+        // bank content and logs are loaded at first use, drops them again once no member was online for delay seconds
+        void   UnloadIdleData(time_t now, uint32 delay);
+
     protected:
         void AddRank(const std::string& name_, uint32 rights, uint32 money);
 
@@ -466,12 +472,16 @@ class Guild
 
         MemberList members;
 
+        typedef std::unordered_map<uint32, Player*> OnlineMemberList;
+        OnlineMemberList m_onlineMembers;                   // subset of members that is in world, by low guid
+        mutable std::shared_mutex m_onlineMembersLock;      // broadcasts come from map threads
+
         typedef std::vector<GuildBankTab*> TabListMap;
         TabListMap m_TabListMap;
 
-        /** These are actually ordered lists. The first element is the oldest entry.*/
-        typedef std::list<GuildEventLogEntry> GuildEventLog;
-        typedef std::list<GuildBankEventLogEntry> GuildBankEventLog;
+        /** These are actually ordered lists. The first element is the oldest entry, a full log drops it on insert.*/
+        typedef boost::circular_buffer<GuildEventLogEntry> GuildEventLog;
+        typedef boost::circular_buffer<GuildBankEventLogEntry> GuildBankEventLog;
         GuildEventLog m_GuildEventLog;
         GuildBankEventLog m_GuildBankEventLog_Money;
         GuildBankEventLog m_GuildBankEventLog_Item[GUILD_BANK_MAX_TABS];
@@ -482,9 +492,23 @@ class Guild
 
         uint64 m_GuildBankMoney;
 
+        bool   m_bankLoaded;
+        bool   m_eventLogLoaded;
+        bool   m_bankEventLogLoaded;
+        time_t m_dataAccessTime;                            // last use of the lazily loaded data or last time a member was seen online
+
     private:
         void UpdateAccountsNumber() { m_accountsNumber = 0;}// mark for lazy calculation at request in GetAccountsNumber
 
+        // lazy loading, the Ensure functions must be called before touching bank tab content or the logs
+        void   EnsureGuildBankLoaded();
+        void   EnsureGuildEventLogLoaded();
+        void   EnsureGuildBankEventLogLoaded();
+        void   LoadGuildBankFromDB();
+        void   LoadGuildEventLogFromDB();
+        void   LoadGuildBankEventLogFromDB();
+        void   UnloadGuildBank();
+
         // used only from high level Swap/Move functions
         Item*  GetItem(uint8 TabId, uint8 SlotId);
         InventoryResult CanStoreItem(uint8 tab, uint8 slot, GuildItemPosCountVec& dest, uint32 count, Item* pItem, bool swap = false) const;
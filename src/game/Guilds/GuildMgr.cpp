@@ -143,9 +143,7 @@ void GuildMgr::LoadGuilds()
             continue;
         }
 
-        newGuild->LoadGuildEventLogFromDB();
-        newGuild->LoadGuildBankEventLogFromDB();
-        newGuild->LoadGuildBankFromDB();
+        // bank content and logs are loaded at first use
         AddGuild(newGuild);
     }
     while (result->NextRow());
@@ -163,3 +161,14 @@ void GuildMgr::LoadGuilds()
     sLog.outString(">> Loaded %u guild definitions", count);
     sLog.outString();
 }
+
+void GuildMgr::UnloadIdleGuildData()
+{
+    uint32 delay = sWorld.getConfig(CONFIG_UINT32_GUILD_DATA_UNLOAD_DELAY);
+    if (!delay)
+        return;
+
+    time_t now = time(nullptr);
+    for (auto& itr : m_GuildMap)
+        itr.second->UnloadIdleData(now, delay);
+}
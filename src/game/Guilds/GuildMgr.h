@@ -42,6 +42,9 @@ class GuildMgr
         std::string GetGuildNameById(uint32 guildId) const;
 
         void LoadGuilds();
+
+        // drops lazily loaded bank content and logs of guilds without online members, see Guild.DataUnloadDelay
+        void UnloadIdleGuildData();
 };
 
 #define sGuildMgr MaNGOS::Singleton<GuildMgr>::Instance()
@@ -68,11 +68,20 @@ class LootTemplate::LootGroup                               // A set of loot def
 
         void Verify(LootStore const& lootstore, uint32 id, uint32 group_id) const;
         void CheckLootRefs(LootIdSet* ref_set) const;
+        LootGroup() : ExplicitlyChancedTotal(0.0f), ExplicitlyChancedConditions(false), EqualChancedConditions(false) {}
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Built at loading stage for rolls without shuffling the entries
+        std::vector<float> ExplicitlyChancedCumulative;     // Running sum of ExplicitlyChanced chances
+        float ExplicitlyChancedTotal;
+        bool ExplicitlyChancedConditions;                   // Some explicitly chanced entry has a condition
+        bool EqualChancedConditions;                        // Some equal chanced entry has a condition
+
         LootStoreItem const* Roll(Loot const& loot, Player const* lootOwner) const; // Rolls an item from the group, returns nullptr if all miss their chances
+        LootStoreItem const* RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const;
+        LootStoreItem const* RollEqualChanced(Loot const& loot, Player const* lootOwner, LootStoreItem const* first) const;
 };
 
 // Remove all data and free all memory
@@ -102,7 +111,7 @@ void LootStore::LoadLootTable()
     Clear();
 
     //                                                 0      1     2                    3        4              5         6
-    QueryResult* result = WorldDatabase.PQuery("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
+    QueryResult* result = WorldDatabase.PQueryStream("SELECT entry, item, ChanceOrQuestChance, groupid, mincountOrRef, maxcount, condition_id FROM %s", GetName());
 
     if (result)
     {
@@ -583,17 +592,7 @@ void GroupLootRoll::SendAllPassed()
     data << uint32(m_lootItem->randomSuffix);               // randomSuffix
     data << uint32(m_lootItem->randomPropertyId);           // item random property ID
 
-    for (RollVoteMap::const_iterator itr = m_rollVoteMap.begin(); itr != m_rollVoteMap.end(); ++itr)
-    {
-        if (itr->second.vote == ROLL_NOT_VALID)
-            continue;
-
-        Player* plr = sObjectMgr.GetPlayer(itr->first);
-        if (!plr || !plr->GetSession())
-            continue;
-
-        plr->GetSession()->SendPacket(data);
-    }
+    SendToVoters(data);
 }
 
 // Send roll 'value' of the whole group and the winner to the whole group
@@ -628,16 +627,7 @@ void GroupLootRoll::SendLootRollWon(ObjectGuid const& targetGuid, uint32 rollNum
         }
     }
 
-    for (RollVoteMap::const_iterator itr = m_rollVoteMap.begin(); itr != m_rollVoteMap.end(); ++itr)
-    {
-        if (itr->second.vote == ROLL_NOT_VALID)
-            continue;
-
-        Player* plr = sObjectMgr.GetPlayer(itr->first);
-        if (!plr || !plr->GetSession())
-            continue;
-        plr->GetSession()->SendPacket(data);
-    }
+    SendToVoters(data);
 }
 
 // Send roll of targetGuid to the whole group (included targuetGuid)
@@ -654,6 +644,12 @@ void GroupLootRoll::SendRoll(ObjectGuid const& targetGuid, uint32 rollNumber, ui
     data << uint8(rollType);                                // 0: "Need for: [item name]" 0: "You have selected need for [item name] 1: need roll 2: greed roll
     data << uint8(0);                                       // auto pass on loot
 
+    SendToVoters(data);
+}
+
+// Send a packet to every group member taking part in the roll
+void GroupLootRoll::SendToVoters(WorldPacket const& data) const
+{
     for (RollVoteMap::const_iterator itr = m_rollVoteMap.begin(); itr != m_rollVoteMap.end(); ++itr)
     {
         if (itr->second.vote == ROLL_NOT_VALID)
@@ -714,6 +710,7 @@ bool GroupLootRoll::TryToStart(Loot& loot, uint32 itemSlot)
             SendStartRoll();
             m_endTime = time(nullptr) + (LOOT_ROLL_TIMEOUT / 1000);
             m_isStarted = true;
+            m_voteChanged = true;
             return true;
         }
         // no need to start roll if one or less player can loot this item so place it under threshold
@@ -732,6 +729,7 @@ bool GroupLootRoll::PlayerVote(Player* player, RollVote vote)
         return false;
 
     voterItr->second.vote = vote;
+    m_voteChanged = true;
 
     if (vote != ROLL_PASS && vote != ROLL_NOT_VALID)
         voterItr->second.number = urand(1, 100);
@@ -764,6 +762,12 @@ bool GroupLootRoll::UpdateRoll()
 {
     RollVoteMap::const_iterator winnerItr = m_rollVoteMap.end();
 
+    // nothing to count while nobody voted since the last update, only the timer can end the roll then
+    if (!m_voteChanged && m_endTime > time(nullptr))
+        return false;
+
+    m_voteChanged = false;
+
     if (AllPlayerVoted(winnerItr) || m_endTime <= time(nullptr))
     {
         Finish(winnerItr);
@@ -1020,6 +1024,10 @@ bool Loot::CanLoot(Player const* player)
     if (itr == m_ownerSet.end())
         return false;
 
+    // content not rolled yet, every owner is shown the corpse as lootable
+    if (m_isDeferred)
+        return true;
+
     uint32 lootStatus = GetLootStatusFor(player);
 
     // is already looted?
@@ -1598,10 +1606,65 @@ void Loot::SetGroupLootRight(Player* player)
     m_lootMethod = NOT_GROUP_TYPE_LOOT;
 }
 
+void Loot::FillCorpseLoot(Creature* creature, Player* player)
+{
+    CreatureInfo const* creatureInfo = creature->GetCreatureInfo();
+    if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+    {
+        GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
+        // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
+        bool isLootedForAll = IsLootedForAll();
+        if (isLootedForAll)
+        {
+            // show sometimes an empty window
+            if (sWorld.getConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW) && urand(0, 2) == 1)
+            {
+                m_isFakeLoot = true;
+                isLootedForAll = false;
+            }
+        }
+
+        if (!isLootedForAll)
+            creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+        else
+            creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+        ForceLootAnimationClientUpdate();
+        return;
+    }
+
+    sLog.outDebug("Loot::CreateLoot> cannot create corpse loot, FillLoot failed with loot id(%u)!", creatureInfo->LootId);
+    creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+}
+
+// Roll the content of a corpse loot deferred by Corpse.DeferredLoot
+void Loot::GenerateDeferred(Player* looter)
+{
+    if (!m_isDeferred)
+        return;
+
+    m_isDeferred = false;
+
+    Creature* creature = static_cast<Creature*>(m_lootTarget);
+
+    // conditions are checked against the killer while still on the map, else against the first looter
+    Player* owner = ObjectAccessor::FindPlayer(m_deferredOwnerGuid);
+    if (!owner || !owner->IsInMap(creature))
+        owner = looter;
+
+    // same content whoever asks first, the thread random state is restored after the roll
+    std::mt19937& generator = *GetRandomGenerator();
+    std::mt19937 const savedState = generator;
+    generator.seed(m_deferredSeed);
+
+    FillCorpseLoot(creature, owner);
+
+    generator = savedState;
+}
+
 Loot::Loot(Player* player, Creature* creature, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1628,31 +1691,18 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
             SetGroupLootRight(player);
             m_clientLootType = CLIENT_LOOT_CORPSE;
 
-            if ((creatureInfo->LootId && FillLoot(creatureInfo->LootId, LootTemplates_Creature, player, false)) || creatureInfo->MaxLootGold > 0)
+            // content is rolled by the first loot request, with the random state taken now
+            if (sWorld.getConfig(CONFIG_BOOL_CORPSE_DEFERRED_LOOT) && (creatureInfo->LootId || creatureInfo->MaxLootGold > 0))
             {
-                GenerateMoneyLoot(creatureInfo->MinLootGold, creatureInfo->MaxLootGold);
-                // loot may be anyway empty (loot may be empty or contain items that no one have right to loot)
-                bool isLootedForAll = IsLootedForAll();
-                if (isLootedForAll)
-                {
-                    // show sometimes an empty window
-                    if (sWorld.getConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW) && urand(0, 2) == 1)
-                    {
-                        m_isFakeLoot = true;
-                        isLootedForAll = false;
-                    }
-                }
-
-                if (!isLootedForAll)
-                    creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                else
-                    creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+                m_isDeferred = true;
+                m_deferredSeed = urand();
+                m_deferredOwnerGuid = player->GetObjectGuid();
+                creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
                 ForceLootAnimationClientUpdate();
                 break;
             }
 
-            sLog.outDebug("Loot::CreateLoot> cannot create corpse loot, FillLoot failed with loot id(%u)!", creatureInfo->LootId);
-            creature->SetLootStatus(CREATURE_LOOT_STATUS_LOOTED);
+            FillCorpseLoot(creature, player);
             break;
         }
         case LOOT_PICKPOCKETING:
@@ -1700,7 +1750,7 @@ Loot::Loot(Player* player, Creature* creature, LootType type) :
 Loot::Loot(Player* player, GameObject* gameObject, LootType type, bool lootSnapshot) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1791,7 +1841,7 @@ Loot::Loot(Player* player, GameObject* gameObject, LootType type, bool lootSnaps
 Loot::Loot(Player* player, Corpse* corpse, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1840,7 +1890,7 @@ Loot::Loot(Player* player, Corpse* corpse, LootType type) :
 Loot::Loot(Player* player, Item* item, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     // the player whose group may loot the corpse
     if (!player)
@@ -1883,7 +1933,7 @@ Loot::Loot(Player* player, Item* item, LootType type) :
 Loot::Loot(Unit* unit, Item* item) :
     m_lootTarget(nullptr), m_itemTarget(item), m_gold(0), m_maxSlot(0),
     m_lootType(LOOT_SKINNING), m_clientLootType(CLIENT_LOOT_PICKPOCKETING), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0),
-    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_haveItemOverThreshold(false), m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(unit->GetObjectGuid());
     m_guidTarget = item->GetObjectGuid();
@@ -1892,7 +1942,7 @@ Loot::Loot(Unit* unit, Item* item) :
 Loot::Loot(Player* player, uint32 id, LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
     m_ownerSet.insert(player->GetObjectGuid());
     switch (type)
@@ -1914,7 +1964,7 @@ Loot::Loot(Player* player, uint32 id, LootType type) :
 Loot::Loot(LootType type) :
     m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(type),
     m_clientLootType(CLIENT_LOOT_CORPSE), m_lootMethod(NOT_GROUP_TYPE_LOOT), m_threshold(ITEM_QUALITY_UNCOMMON), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_createTime(World::GetCurrentClockTime())
+    m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0), m_createTime(World::GetCurrentClockTime())
 {
 
 }
@@ -1966,6 +2016,7 @@ InventoryResult Loot::SendItem(Player* target, LootItem* lootItem, bool sendErro
         if (msg == EQUIP_ERR_OK)
         {
             Item* newItem = target->StoreNewItem(dest, lootItem->itemId, true, lootItem->randomPropertyId);
+            target->ScheduleValuableSave();
 
             if (lootItem->freeForAll)
             {
@@ -2062,6 +2113,7 @@ bool Loot::AutoStore(Player* player, bool broadcast /*= false*/, uint32 bag /*=
 
         Item* pItem = player->StoreNewItem(dest, lootItem->itemId, true, lootItem->randomPropertyId);
         player->SendNewItem(pItem, lootItem->count, false, false, broadcast);
+        player->ScheduleValuableSave();
         m_isChanged = true;
     }
 
@@ -2170,6 +2222,7 @@ void Loot::SendGold(Player* player)
                 continue;
 
             plr->ModifyMoney(money_per_player);
+            plr->ScheduleValuableSave();
 
             WorldPacket data(SMSG_LOOT_MONEY_NOTIFY, 4);
             data << uint32(money_per_player);
@@ -2180,6 +2233,7 @@ void Loot::SendGold(Player* player)
     else
     {
         player->ModifyMoney(m_gold);
+        player->ScheduleValuableSave();
 
         if (m_guidTarget.IsItem())
         {
@@ -2296,9 +2350,19 @@ ByteBuffer& operator<<(ByteBuffer& b, LootItem const& li)
 void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
 {
     if (item.chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+        ExplicitlyChancedTotal += item.chance;
+        ExplicitlyChancedCumulative.push_back(ExplicitlyChancedTotal);
+        if (item.conditionId)
+            ExplicitlyChancedConditions = true;
+    }
     else
+    {
         EqualChanced.push_back(item);
+        if (item.conditionId)
+            EqualChancedConditions = true;
+    }
 }
 
 // Rolls an item from the group, returns nullptr if all miss their chances
@@ -2306,73 +2370,105 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, Player cons
 {
     if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
     {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+        // Without conditions and overlapping chances every entry is hit with its own chance in any order,
+        // so the shuffled walk below equals a lookup of the roll in the running sum
+        if (!ExplicitlyChancedConditions && ExplicitlyChancedTotal <= 100.0f)
+        {
+            float chance = rand_chance_f();
+            auto itr = std::upper_bound(ExplicitlyChancedCumulative.begin(), ExplicitlyChancedCumulative.end(), chance);
+            if (itr != ExplicitlyChancedCumulative.end())
+                return &ExplicitlyChanced[itr - ExplicitlyChancedCumulative.begin()];
+        }
+        else if (LootStoreItem const* lsi = RollExplicitlyChanced(loot, lootOwner))
+            return lsi;
+    }
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : ExplicitlyChanced)
-            lootStoreItemVector.push_back(&itr);
+    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+    {
+        // The first entry of the shuffled walk is a uniform pick, only go on walking when it is not taken right away
+        LootStoreItem const* lsi = &EqualChanced[urand(0, EqualChanced.size() - 1)];
+        if (!EqualChancedConditions && !loot.IsItemAlreadyIn(lsi->itemid))
+            return lsi;
 
-        // randomize the new vector
-        shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+        return RollEqualChanced(loot, lootOwner, lsi);
+    }
 
-        float chance = rand_chance_f();
+    return nullptr;                                            // Empty drop from the group
+}
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
-        {
-            LootStoreItem const* lsi = *itr;
+LootStoreItem const* LootTemplate::LootGroup::RollExplicitlyChanced(Loot const& loot, Player const* lootOwner) const
+{
+    std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
+    // fill the new vector with correct pointer to our item list
+    for (auto& itr : ExplicitlyChanced)
+        lootStoreItemVector.push_back(&itr);
 
-            if (lsi->chance >= 100.0f)
-                return lsi;
+    // randomize the new vector
+    shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+
+    float chance = rand_chance_f();
+
+    // as the new vector is randomized we can start from first element and stop at first one that meet the condition
+    for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+    {
+        LootStoreItem const* lsi = *itr;
 
-            chance -= lsi->chance;
-            if (chance < 0)
-                return lsi;
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In explicit chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
         }
+
+        if (lsi->chance >= 100.0f)
+            return lsi;
+
+        chance -= lsi->chance;
+        if (chance < 0)
+            return lsi;
     }
 
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-    {
-        std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+    return nullptr;
+}
 
-        // fill the new vector with correct pointer to our item list
-        for (auto& itr : EqualChanced)
+// Continues the shuffled walk of the equal chanced entries after its first entry
+LootStoreItem const* LootTemplate::LootGroup::RollEqualChanced(Loot const& loot, Player const* lootOwner, LootStoreItem const* first) const
+{
+    std::vector <LootStoreItem const*> lootStoreItemVector; // we'll use new vector to make easy the randomization
+
+    // fill the new vector with correct pointer to our item list
+    for (auto& itr : EqualChanced)
+        if (&itr != first)
             lootStoreItemVector.push_back(&itr);
 
-        // randomize the new vector
-        std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+    // randomize the new vector
+    std::shuffle(lootStoreItemVector.begin(), lootStoreItemVector.end(), *GetRandomGenerator());
+    lootStoreItemVector.insert(lootStoreItemVector.begin(), first);
 
-        // as the new vector is randomized we can start from first element and stop at first one that meet the condition
-        for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
-        {
-            LootStoreItem const* lsi = *itr;
+    // as the new vector is randomized we can start from first element and stop at first one that meet the condition
+    for (std::vector <LootStoreItem const*>::const_iterator itr = lootStoreItemVector.begin(); itr != lootStoreItemVector.end(); ++itr)
+    {
+        LootStoreItem const* lsi = *itr;
 
-            //check if we already have that item in the loot list
-            if (loot.IsItemAlreadyIn(lsi->itemid))
-            {
-                // the item is already looted, let's give a 50%  chance to pick another one
-                uint32 chance = urand(0, 1);
+        //check if we already have that item in the loot list
+        if (loot.IsItemAlreadyIn(lsi->itemid))
+        {
+            // the item is already looted, let's give a 50%  chance to pick another one
+            uint32 chance = urand(0, 1);
 
-                if (chance)
-                    continue;                               // pass this item
-            }
+            if (chance)
+                continue;                               // pass this item
+        }
 
-            if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
-            {
-                sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
-                continue;
-            }
-            return lsi;
+        if (lsi->conditionId && lootOwner && !LootTemplate::PlayerOrGroupFulfilsCondition(loot, lootOwner, lsi->conditionId))
+        {
+            sLog.outDebug("In equal chance -> This item cannot be added! (%u)", lsi->itemid);
+            continue;
         }
+        return lsi;
     }
 
-    return nullptr;                                            // Empty drop from the group
+    return nullptr;
 }
 
 // True if group includes at least 1 quest drop entry
@@ -2949,8 +3045,11 @@ Loot* LootMgr::GetLoot(Player* player, ObjectGuid const& targetGuid) const
         {
             Creature* creature = player->GetMap()->GetCreature(lguid);
 
-            if (creature)
+            if (creature && creature->m_loot)
+            {
                 loot = creature->m_loot;
+                loot->GenerateDeferred(player);
+            }
 
             break;
         }
@@ -136,7 +136,7 @@ class GroupLootRoll
     public:
         typedef std::unordered_map<ObjectGuid, PlayerRollVote> RollVoteMap;
 
-        GroupLootRoll() : m_rollVoteMap(ROLL_VOTE_MASK_ALL), m_isStarted(false), m_lootItem(nullptr), m_loot(nullptr), m_itemSlot(0), m_voteMask(), m_endTime(0)
+        GroupLootRoll() : m_rollVoteMap(ROLL_VOTE_MASK_ALL), m_isStarted(false), m_lootItem(nullptr), m_loot(nullptr), m_itemSlot(0), m_voteMask(), m_endTime(0), m_voteChanged(false)
         {}
         ~GroupLootRoll();
 
@@ -149,6 +149,7 @@ class GroupLootRoll
         void SendAllPassed();
         void SendRoll(ObjectGuid const& targetGuid, uint32 rollNumber, uint32 rollType);
         void SendLootRollWon(ObjectGuid const& targetGuid, uint32 rollNumber, RollVote rollType);
+        void SendToVoters(WorldPacket const& data) const;
         void Finish(RollVoteMap::const_iterator& winnerItr);
         bool AllPlayerVoted(RollVoteMap::const_iterator& winnerItr);
         RollVoteMap           m_rollVoteMap;
@@ -158,6 +159,7 @@ class GroupLootRoll
         uint32                m_itemSlot;
         RollVoteMask          m_voteMask;
         time_t                m_endTime;
+        bool                  m_voteChanged;              // votes are only counted again after one of them changed
 };
 typedef std::unordered_map<uint32, GroupLootRoll> GroupLootRollMap;
 
@@ -327,11 +329,12 @@ class Loot
         ObjectGuid const& GetMasterLootGuid() const { return m_masterOwnerGuid; }
         GuidSet const& GetOwnerSet() const { return m_ownerSet; }
         TimePoint const& GetCreateTime() const { return m_createTime; }
+        void GenerateDeferred(Player* looter);
 
     private:
         Loot(): m_lootTarget(nullptr), m_itemTarget(nullptr), m_gold(0), m_maxSlot(0), m_lootType(),
             m_clientLootType(), m_lootMethod(), m_threshold(), m_maxEnchantSkill(0), m_haveItemOverThreshold(false),
-            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false)
+            m_isChecked(false), m_isChest(false), m_isChanged(false), m_isFakeLoot(false), m_isDeferred(false), m_deferredSeed(0)
         {}
         void Clear();
         bool IsLootedFor(Player const* player) const;
@@ -346,6 +349,7 @@ class Loot
         void SetGroupLootRight(Player* player);
         void GenerateMoneyLoot(uint32 minAmount, uint32 maxAmount);
         bool FillLoot(uint32 loot_id, LootStore const& store, Player* lootOwner, bool personal, bool noEmptyError = false);
+        void FillCorpseLoot(Creature* creature, Player* player);
         void ForceLootAnimationClientUpdate() const;
         void SetPlayerIsLooting(Player* player);
         void SetPlayerIsNotLooting(Player* player);
@@ -374,6 +378,9 @@ class Loot
         bool             m_isChest;                       // chest type object have special loot right
         bool             m_isChanged;                     // true if at least one item is looted
         bool             m_isFakeLoot;                    // nothing to loot but will sparkle for empty windows
+        bool             m_isDeferred;                    // corpse content not rolled yet (Corpse.DeferredLoot)
+        uint32           m_deferredSeed;                  // random seed taken at kill time for the deferred roll
+        ObjectGuid       m_deferredOwnerGuid;             // killer used for the conditions of the deferred roll
         GroupLootRollMap m_roll;                          // used if an item is under rolling
         GuidSet          m_playersLooting;                // player who opened loot windows
         GuidSet          m_playersOpened;                 // players that have released the corpse
@@ -34,6 +34,7 @@
 #include "World/World.h"
 #include "BattleGround/BattleGroundMgr.h"
 #include "Loot/LootMgr.h"
+#include "Entities/CharacterLoginCache.h"
 
 /**
  * Creates a new MailSender object.
@@ -259,6 +260,23 @@ void MailDraft::SendReturnToSender(uint32 sender_acc, ObjectGuid sender_guid, Ob
     // will delete item or place to receiver mail list
     SendMailTo(MailReceiver(receiver, receiver_guid), MailSender(MAIL_NORMAL, sender_guid.GetCounter()), MAIL_CHECK_MASK_RETURNED, deliver_delay);
 }
+/**
+ * Returns the time a mail stays in the mailbox after delivery.
+ *
+ * @param sender               The MailSender from which this mail is originated.
+ * @returns the expire delay in seconds.
+ */
+uint32 MailDraft::GetExpireDelay(MailSender const& sender) const
+{
+    // auction mail without any items and money (auction sale note) pending 1 hour
+    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
+        return HOUR;
+    // mail from battlemaster (rewardmarks) should last only one day
+    if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
+        return DAY;
+    // default case: expire time if COD 3 days, if no COD 30 days
+    return (m_COD > 0) ? 3 * DAY : 30 * DAY;
+}
 /**
  * Sends a mail.
  *
@@ -281,6 +299,9 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         return;
     }
 
+    if (!pReceiver)
+        sCharacterLoginCache.Invalidate(receiver.GetPlayerGuid());
+
     bool has_items = !m_items.empty();
 
     // generate mail template items for online player, for offline player items will generated at open
@@ -294,19 +315,7 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
 
     time_t deliver_time = time(nullptr) + deliver_delay;
 
-    // expire time if COD 3 days, if no COD 30 days, if auction sale pending 1 hour
-    uint32 expire_delay;
-    // auction mail without any items and money (auction sale note) pending 1 hour
-    if (sender.GetMailMessageType() == MAIL_AUCTION && m_items.empty() && !m_money)
-        expire_delay = HOUR;
-    // mail from battlemaster (rewardmarks) should last only one day
-    else if (sender.GetMailMessageType() == MAIL_CREATURE && sBattleGroundMgr.GetBattleMasterBG(sender.GetSenderId()) != BATTLEGROUND_TYPE_NONE)
-        expire_delay = DAY;
-    // default case: expire time if COD 3 days, if no COD 30 days
-    else
-        expire_delay = (m_COD > 0) ? 3 * DAY : 30 * DAY;
-
-    time_t expire_time = deliver_time + expire_delay;
+    time_t expire_time = deliver_time + GetExpireDelay(sender);
 
     // Add to DB
     std::string safe_subject = GetSubject();
@@ -327,9 +336,11 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
 
     // For online receiver update in game mail status and data
     if (pReceiver)
-    {
         pReceiver->AddNewMailDeliverTime(deliver_time);
 
+    // mails not loaded yet are read from DB at next mailbox open, a mail load already requested can't see this mail anymore
+    if (pReceiver && pReceiver->GetMailLoadState() != PLAYER_MAIL_NOT_LOADED)
+    {
         Mail* m = new Mail;
         m->messageID = mailId;
         m->mailTemplateId = GetMailTemplateId();
@@ -352,6 +363,7 @@ void MailDraft::SendMailTo(MailReceiver const& receiver, MailSender const& sende
         m->deliver_time = deliver_time;
         m->checked = checked;
         m->state = MAIL_STATE_UNCHANGED;
+        m->itemsLoaded = true;
 
         pReceiver->AddMail(m);                           // to insert new mail to beginning of maillist
 
@@ -227,6 +227,10 @@ class MailDraft
         uint32 GetMoney() const { return m_money; }
         /// Returns the Cost of delivery of this MailDraft.
         uint32 GetCOD() const { return m_COD; }
+        /// Returns the amount of items attached to this MailDraft.
+        uint32 GetItemCount() const { return m_items.size(); }
+        /// Returns the time in seconds this MailDraft stays in the mailbox after delivery.
+        uint32 GetExpireDelay(MailSender const& sender) const;
     public:                                                 // modifiers
 
         // this two modifiers expected to be applied in normal case to blank draft and exclusively, It DON'T must overwrite already set itemTextId, in other cases it will work and with mixed cases but this will be not normal way use.
@@ -308,6 +312,8 @@ struct Mail
     uint32 itemTextId;
     /// flag mark mail that already has items, or already generate none items for template
     bool has_items;
+    /// flag mark mail whose attached item objects are loaded into the receiver mailed items
+    bool itemsLoaded;
     /// A vector containing Information about the items in this mail.
     MailItemInfoVec items;
     /// A vector containing Information about the items that where already take from this mail.
@@ -33,6 +33,7 @@
 #include "Entities/Item.h"
 #include "Entities/Player.h"
 #include "World/World.h"
+#include "Database/DatabaseImpl.h"
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Server/Opcodes.h"
@@ -41,6 +42,61 @@
 
 #define MAX_INBOX_CLIENT_UI_CAPACITY 50
 
+enum MailQueryIndex
+{
+    MAIL_QUERY_MAILS            = 0,
+    MAIL_QUERY_MAIL_ITEM_INFOS  = 1,
+    MAX_MAIL_QUERY_HEADERS,
+
+    MAIL_QUERY_MAILED_ITEMS     = 0,
+    MAX_MAIL_QUERY_ITEMS,
+};
+
+class MailQueryHolder : public SqlQueryHolder
+{
+    private:
+        uint32 m_accountId;
+        uint32 m_queryId;
+        std::vector<uint32> m_mailIds;
+    public:
+        MailQueryHolder(uint32 accountId, ObjectGuid guid, uint32 queryId)
+            : m_accountId(accountId), m_queryId(queryId) { SetSerialKey(guid.GetCounter()); }   // must see the last save of the mails
+        uint32 GetAccountId() const { return m_accountId; }
+        uint32 GetQueryId() const { return m_queryId; }
+        std::vector<uint32>& GetMailIds() { return m_mailIds; }
+};
+
+// don't call WorldSession directly
+// it may get deleted before the query callbacks get executed
+// instead pass an account id to this handler
+class MailQueryHandler
+{
+    public:
+        void HandleMailsCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder)
+                return;
+
+            MailQueryHolder* mqh = (MailQueryHolder*)holder;
+            if (WorldSession* session = sWorld.FindSession(mqh->GetAccountId()))
+                session->HandleMailsLoaded(mqh);
+            delete holder;
+        }
+
+        void HandleMailListItemsCallback(QueryResult* /*dummy*/, SqlQueryHolder* holder)
+        {
+            if (!holder)
+                return;
+
+            MailQueryHolder* mqh = (MailQueryHolder*)holder;
+            if (WorldSession* session = sWorld.FindSession(mqh->GetAccountId()))
+                session->HandleMailListItemsLoaded(mqh);
+            delete holder;
+        }
+} mailQueryHandler;
+
+static uint32 s_mailQueryId = 0;                            // unique over relogins, callbacks of older queries are dropped
+
 bool WorldSession::CheckMailBox(ObjectGuid guid) const
 {
     if (!GetPlayer()->GetGameObjectIfCanInteractWith(guid, GAMEOBJECT_TYPE_MAILBOX))
@@ -49,6 +105,8 @@ bool WorldSession::CheckMailBox(ObjectGuid guid) const
         return false;
     }
 
+    // keep loaded mails while the mailbox is in use
+    GetPlayer()->m_mailUsedTime = time(nullptr);
     return true;
 }
 
@@ -162,19 +220,18 @@ void WorldSession::HandleSendMail(WorldPacket& recv_data)
     uint8 mails_count = 0;                                  // do not allow to send to one player more than 100 mails
 
     if (receive)
-    {
         rc_team = receive->GetTeam();
-        mails_count = receive->GetMailSize();
-    }
     else
-    {
         rc_team = sObjectMgr.GetPlayerTeamByGUID(rc);
-        if (QueryResult* result = CharacterDatabase.PQuery("SELECT COUNT(*) FROM mail WHERE receiver = '%u'", rc.GetCounter()))
-        {
-            Field* fields = result->Fetch();
-            mails_count = fields[0].GetUInt32();
-            delete result;
-        }
+
+    // online receivers keep their mailbox in DB until it is opened
+    if (receive && receive->IsMailLoaded())
+        mails_count = receive->GetMailSize();
+    else if (QueryResult* result = CharacterDatabase.PQuery("SELECT COUNT(*) FROM mail WHERE receiver = '%u'", rc.GetCounter()))
+    {
+        Field* fields = result->Fetch();
+        mails_count = fields[0].GetUInt32();
+        delete result;
     }
 
     // do not allow to have more than 100 mails in mailbox.. mails count is in opcode uint8!!! - so max can be 255..
@@ -393,7 +450,7 @@ void WorldSession::HandleMailReturnToSender(WorldPacket& recv_data)
 
     Player* pl = _player;
     Mail* m = pl->GetMail(mailId);
-    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > time(nullptr))
+    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > time(nullptr) || !m->itemsLoaded)
     {
         pl->SendMailResult(mailId, MAIL_RETURNED_TO_SENDER, MAIL_ERR_INTERNAL_ERROR);
         return;
@@ -467,6 +524,11 @@ void WorldSession::HandleMailTakeItem(WorldPacket& recv_data)
     }
 
     Item* it = pl->GetMItem(itemId);
+    if (!it)                                                // not loaded yet or not attached to this mail
+    {
+        pl->SendMailResult(mailId, MAIL_ITEM_TAKEN, MAIL_ERR_INTERNAL_ERROR);
+        return;
+    }
 
     ItemPosCountVec dest;
     InventoryResult msg = _player->CanStoreItem(NULL_BAG, NULL_SLOT, dest, it, false);
@@ -581,6 +643,136 @@ void WorldSession::HandleGetMailList(WorldPacket& recv_data)
     if (!CheckMailBox(mailboxGuid))
         return;
 
+    // the list is sent from the query callbacks when mails or their items have to be loaded first
+    switch (_player->GetMailLoadState())
+    {
+        case PLAYER_MAIL_NOT_LOADED:
+            LoadMails();
+            return;
+        case PLAYER_MAIL_LOADING:
+            return;
+        default:
+            break;
+    }
+
+    if (_player->m_mailItemsLoading || LoadMailListItems())
+        return;
+
+    SendMailList();
+}
+
+/**
+ * Requests the mails of the player from DB, the list is sent when they are loaded.
+ */
+void WorldSession::LoadMails()
+{
+    Player* pl = _player;
+
+    MailQueryHolder* holder = new MailQueryHolder(GetAccountId(), pl->GetObjectGuid(), ++s_mailQueryId);
+    holder->SetSize(MAX_MAIL_QUERY_HEADERS);
+    holder->SetPQuery(MAIL_QUERY_MAILS, "SELECT id,messageType,sender,receiver,subject,itemTextId,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", pl->GetGUIDLow());
+    holder->SetPQuery(MAIL_QUERY_MAIL_ITEM_INFOS, "SELECT mail_id,item_guid,item_template FROM mail_items WHERE receiver = '%u'", pl->GetGUIDLow());
+
+    pl->m_mailLoadState = PLAYER_MAIL_LOADING;
+    pl->m_mailQueryId = holder->GetQueryId();
+    CharacterDatabase.DelayQueryHolder(SqlResultRoute(GetAccountId()), &mailQueryHandler, &MailQueryHandler::HandleMailsCallback, holder);
+}
+
+void WorldSession::HandleMailsLoaded(MailQueryHolder* holder)
+{
+    Player* pl = _player;
+    if (!pl || pl->m_mailLoadState != PLAYER_MAIL_LOADING || pl->m_mailQueryId != holder->GetQueryId())
+        return;
+
+    pl->_LoadMails(holder->GetResult(MAIL_QUERY_MAILS));
+    pl->_LoadMailItemInfos(holder->GetResult(MAIL_QUERY_MAIL_ITEM_INFOS));
+    pl->m_mailLoadState = PLAYER_MAIL_LOADED;
+    pl->m_mailUsedTime = time(nullptr);
+
+    if (!LoadMailListItems())
+        SendMailList();
+}
+
+/**
+ * Requests the attached items of the mails fitting into the client inbox.
+ *
+ * @returns true if items have to be loaded before the list can be sent, false otherwise.
+ */
+bool WorldSession::LoadMailListItems()
+{
+    Player* pl = _player;
+
+    MailQueryHolder* holder = nullptr;
+    std::ostringstream mailIds;
+
+    uint32 mailsCount = 0;
+    time_t cur_time = time(nullptr);
+
+    for (PlayerMails::iterator itr = pl->GetMailBegin(); itr != pl->GetMailEnd() && mailsCount < MAX_INBOX_CLIENT_UI_CAPACITY; ++itr)
+    {
+        // same selection as in SendMailList
+        if ((*itr)->state == MAIL_STATE_DELETED || cur_time < (*itr)->deliver_time)
+            continue;
+
+        ++mailsCount;
+
+        if ((*itr)->itemsLoaded)
+            continue;
+
+        if (!holder)
+            holder = new MailQueryHolder(GetAccountId(), pl->GetObjectGuid(), pl->m_mailQueryId);
+        else
+            mailIds << ",";
+
+        mailIds << (*itr)->messageID;
+        holder->GetMailIds().push_back((*itr)->messageID);
+    }
+
+    if (!holder)
+        return false;
+
+    holder->SetSize(MAX_MAIL_QUERY_ITEMS);
+    holder->SetPQuery(MAIL_QUERY_MAILED_ITEMS, "SELECT itemEntry, creatorGuid, giftCreatorGuid, count, duration, charges, flags, enchantments, randomPropertyId, durability, itemTextId, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE mail_id IN (%s)", mailIds.str().c_str());
+
+    pl->m_mailItemsLoading = true;
+    CharacterDatabase.DelayQueryHolder(SqlResultRoute(GetAccountId()), &mailQueryHandler, &MailQueryHandler::HandleMailListItemsCallback, holder);
+    return true;
+}
+
+void WorldSession::HandleMailListItemsLoaded(MailQueryHolder* holder)
+{
+    Player* pl = _player;
+    if (!pl || !pl->m_mailItemsLoading || pl->m_mailQueryId != holder->GetQueryId())
+        return;
+
+    pl->_LoadMailedItems(holder->GetResult(MAIL_QUERY_MAILED_ITEMS));
+
+    for (uint32 mailId : holder->GetMailIds())
+    {
+        Mail* m = pl->GetMail(mailId);
+        if (!m || m->itemsLoaded)
+            continue;
+
+        // drop items without item_instance data, they can't be listed or taken
+        for (MailItemInfoVec::iterator itr = m->items.begin(); itr != m->items.end();)
+        {
+            if (pl->GetMItem(itr->item_guid))
+                ++itr;
+            else
+                itr = m->items.erase(itr);
+        }
+        m->itemsLoaded = true;
+    }
+
+    pl->m_mailItemsLoading = false;
+    SendMailList();
+}
+
+/**
+ * Sends the mails fitting into the client inbox, their attached items have to be loaded already.
+ */
+void WorldSession::SendMailList()
+{
     uint32 mailsCount = 0;                                  // send to client mails amount
 
     WorldPacket data(SMSG_MAIL_LIST_RESULT, (200));         // guess size
@@ -786,6 +978,7 @@ void WorldSession::HandleQueryNextMailTime(WorldPacket& /**recv_data*/)
         data << uint32(0);                                  // float
         data << uint32(0);                                  // count
 
+        // senders are only known while the mails are loaded
         uint32 count = 0;
         time_t now = time(nullptr);
         for (PlayerMails::iterator itr = _player->GetMailBegin(); itr != _player->GetMailEnd(); ++itr)
@@ -27,11 +27,15 @@
 
 #include "Mails/MassMailMgr.h"
 #include "Policies/Singleton.h"
+#include "Log.h"
 #include "Database/DatabaseEnv.h"
 #include "Database/DatabaseImpl.h"
 #include "Globals/SharedDefines.h"
 #include "World/World.h"
 #include "Globals/ObjectMgr.h"
+#include "Entities/Player.h"
+#include "Timer.h"
+#include "Entities/CharacterLoginCache.h"
 
 INSTANTIATE_SINGLETON_1(MassMailMgr);
 
@@ -64,15 +68,241 @@ struct MassMailerQueryHandler
         while (result->NextRow());
         delete result;
     }
+
+    void HandleStreamCountCallback(QueryResult* result, MailDraft* mailProto, MailSender sender, std::string query)
+    {
+        uint32 total = 0;
+        if (result)
+        {
+            total = (*result)[0].GetUInt32();
+            delete result;
+        }
+
+        sMassMailMgr.AddStreamedTask(mailProto, sender, query, total);
+    }
+
+    void HandleStreamPageCallback(QueryResult* result, uint32 taskId)
+    {
+        sMassMailMgr.AddStreamedReceivers(taskId, result);
+    }
 } massMailerQueryHandler;
 
 void MassMailMgr::AddMassMailTask(MailDraft* mailProto, const MailSender& sender, char const* query)
 {
-    CharacterDatabase.AsyncPQuery(&massMailerQueryHandler, &MassMailerQueryHandler::HandleQueryCallback, mailProto, sender, "%s", query);
+    if (sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_WRITES_PER_SECOND))
+        CharacterDatabase.AsyncPQuery(&massMailerQueryHandler, &MassMailerQueryHandler::HandleStreamCountCallback, mailProto, sender, std::string(query), "SELECT COUNT(*) FROM (%s) receivers", query);
+    else
+        CharacterDatabase.AsyncPQuery(&massMailerQueryHandler, &MassMailerQueryHandler::HandleQueryCallback, mailProto, sender, "%s", query);
+}
+
+void MassMailMgr::AddStreamedTask(MailDraft* mailProto, MailSender const& sender, std::string const& query, uint32 total)
+{
+    if (!total)
+    {
+        delete mailProto;
+        return;
+    }
+
+    m_streamedMails.emplace_back(++m_lastStreamId, mailProto, sender, query, total);
+    sLog.outString("MassMailMgr: Streamed mass mail task %u started for %u receivers", m_lastStreamId, total);
+}
+
+void MassMailMgr::AddStreamedReceivers(uint32 taskId, QueryResult* result)
+{
+    for (auto& task : m_streamedMails)
+    {
+        if (task.m_id != taskId)
+            continue;
+
+        task.m_pageLoading = false;
+        uint32 count = 0;
+        if (result)
+        {
+            do
+            {
+                Field* fields = result->Fetch();
+                task.m_receivers.push_back(fields[0].GetUInt32());
+                ++count;
+            }
+            while (result->NextRow());
+            task.m_lastGuid = task.m_receivers.back();
+        }
+
+        task.m_lastPage = count < MASS_MAIL_STREAM_PAGE_SIZE;
+        break;
+    }
+
+    delete result;
+}
+
+void MassMailMgr::RequestStreamPage(StreamedMassMail& task)
+{
+    task.m_pageLoading = true;
+    CharacterDatabase.AsyncPQuery(&massMailerQueryHandler, &MassMailerQueryHandler::HandleStreamPageCallback, task.m_id,
+                                  "SELECT receivers.guid FROM (%s) receivers WHERE receivers.guid > %u ORDER BY receivers.guid LIMIT %u", task.m_query.c_str(), task.m_lastGuid, MASS_MAIL_STREAM_PAGE_SIZE);
+}
+
+uint32 MassMailMgr::GetStreamedWritesPerMail(MailDraft const& mailProto)
+{
+    // mail row, body text copy, and item instance plus mail item row per attached item
+    return 1 + (mailProto.GetBodyId() ? 1 : 0) + 2 * mailProto.GetItemCount();
+}
+
+void MassMailMgr::UpdateStreamed()
+{
+    uint32 now = WorldTimer::getMSTime();
+    uint32 diff = WorldTimer::getMSTimeDiff(m_lastStreamUpdate, now);
+    m_lastStreamUpdate = now;
+
+    if (m_streamedMails.empty())
+    {
+        m_writeBudget = 0.0f;
+        return;
+    }
+
+    StreamedMassMail& task = m_streamedMails.front();
+
+    // keep the next page ready while the current one is sent
+    if (!task.m_lastPage && !task.m_pageLoading && task.m_receivers.size() < MASS_MAIL_STREAM_PAGE_SIZE / 2)
+        RequestStreamPage(task);
+
+    if (task.m_receivers.empty())
+    {
+        if (task.m_lastPage)
+        {
+            sLog.outString("MassMailMgr: Streamed mass mail task %u finished, %u mails sent", task.m_id, task.m_sent);
+            m_streamedMails.pop_front();
+        }
+        return;
+    }
+
+    // unused budget is not saved beyond one batch, to not burst after idle or long ticks
+    uint32 writesPerMail = GetStreamedWritesPerMail(*task.m_protoMail);
+    float writesPerSecond = float(sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_WRITES_PER_SECOND));
+    m_writeBudget = std::min(m_writeBudget + writesPerSecond * diff / IN_MILLISECONDS, float(MASS_MAIL_STREAM_BATCH_SIZE * writesPerMail));
+
+    uint32 count = std::min(uint32(m_writeBudget / writesPerMail), uint32(task.m_receivers.size()));
+    if (!count)
+        return;
+
+    m_writeBudget -= count * writesPerMail;
+    SendStreamedBatch(task, count);
+}
+
+void MassMailMgr::SendStreamedBatch(StreamedMassMail& task, uint32 count)
+{
+    MailDraft const& proto = *task.m_protoMail;
+
+    // mails with items need their own item copies, these are sent one by one
+    if (proto.GetItemCount())
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 receiverLowGuid = task.m_receivers.front();
+            task.m_receivers.pop_front();
+            SendStreamedMail(task, receiverLowGuid, task.m_lastPage && task.m_receivers.empty());
+        }
+        return;
+    }
+
+    std::string subject = proto.GetSubject();
+    CharacterDatabase.escape_string(subject);
+
+    std::string body;
+    std::string safeBody;
+    if (proto.GetBodyId())
+    {
+        body = sObjectMgr.GetItemText(proto.GetBodyId());
+        safeBody = body;
+        CharacterDatabase.escape_string(safeBody);
+    }
+
+    time_t deliverTime = time(nullptr);
+    time_t expireTime = deliverTime + proto.GetExpireDelay(task.m_sender);
+
+    std::ostringstream mailInsert;
+    std::ostringstream textInsert;
+    uint32 mailRows = 0;
+    uint32 textRows = 0;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 receiverLowGuid = task.m_receivers.front();
+        task.m_receivers.pop_front();
+        bool last = task.m_lastPage && task.m_receivers.empty();
+
+        ObjectGuid receiverGuid = ObjectGuid(HIGHGUID_PLAYER, receiverLowGuid);
+        Player* receiver = sObjectMgr.GetPlayer(receiverGuid);
+
+        if (!receiver)
+            sCharacterLoginCache.Invalidate(receiverGuid);
+
+        // receivers with mails in memory need the mail object too
+        if (receiver && receiver->GetMailLoadState() != PLAYER_MAIL_NOT_LOADED)
+        {
+            SendStreamedMail(task, receiverLowGuid, last);
+            continue;
+        }
+
+        // each mail needs an own body copy, it is deleted with the mail, the last one takes the prototype body
+        uint32 itemTextId = 0;
+        if (proto.GetBodyId())
+        {
+            if (last)
+                itemTextId = proto.GetBodyId();
+            else
+            {
+                itemTextId = sObjectMgr.GenerateItemTextID();
+                sObjectMgr.AddItemText(itemTextId, body);
+
+                textInsert << (textRows++ ? "," : "INSERT INTO item_text (id,text) VALUES ") << "(" << itemTextId << ",'" << safeBody << "')";
+            }
+        }
+
+        mailInsert << (mailRows++ ? "," : "INSERT INTO mail (id,messageType,stationery,mailTemplateId,sender,receiver,subject,itemTextId,has_items,expire_time,deliver_time,money,cod,checked) VALUES ")
+                   << "(" << sObjectMgr.GenerateMailID() << "," << uint32(task.m_sender.GetMailMessageType()) << "," << uint32(task.m_sender.GetStationery())
+                   << "," << uint32(proto.GetMailTemplateId()) << "," << task.m_sender.GetSenderId() << "," << receiverLowGuid << ",'" << subject << "'," << itemTextId
+                   << ",0," << uint64(expireTime) << "," << uint64(deliverTime) << "," << proto.GetMoney() << "," << proto.GetCOD() << "," << uint32(MAIL_CHECK_MASK_RETURNED) << ")";
+
+        // template items are generated at mailbox open, as for offline receivers
+        if (receiver)
+            receiver->AddNewMailDeliverTime(deliverTime);
+
+        ++task.m_sent;
+    }
+
+    if (!mailRows)
+        return;
+
+    CharacterDatabase.BeginTransaction();
+    if (textRows)
+        CharacterDatabase.Execute(textInsert.str().c_str());
+    CharacterDatabase.Execute(mailInsert.str().c_str());
+    CharacterDatabase.CommitTransaction();
+}
+
+void MassMailMgr::SendStreamedMail(StreamedMassMail& task, uint32 receiverLowGuid, bool last)
+{
+    ObjectGuid receiverGuid = ObjectGuid(HIGHGUID_PLAYER, receiverLowGuid);
+    Player* receiver = sObjectMgr.GetPlayer(receiverGuid);
+
+    // prevent mail return
+    if (last)
+        task.m_protoMail->SendMailTo(MailReceiver(receiver, receiverGuid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+    else
+    {
+        MailDraft draft;
+        draft.CloneFrom(*task.m_protoMail);
+        draft.SendMailTo(MailReceiver(receiver, receiverGuid), task.m_sender, MAIL_CHECK_MASK_RETURNED);
+    }
+
+    ++task.m_sent;
 }
 
 void MassMailMgr::Update(bool sendall /*= false*/)
 {
+    UpdateStreamed();
+
     if (m_massMails.empty())
         return;
 
@@ -130,6 +360,30 @@ void MassMailMgr::GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) c
 
     // 50 msecs is tick length
     needTime = 50 * mailsCount / sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK) / IN_MILLISECONDS;
+
+    // streamed tasks are limited by the DB writes budget instead
+    if (m_streamedMails.empty())
+        return;
+
+    tasks += m_streamedMails.size();
+
+    uint32 writes = 0;
+    for (const auto& task : m_streamedMails)
+    {
+        uint32 left = task.m_total > task.m_sent ? task.m_total - task.m_sent : 0;
+        mails += left;
+        writes += left * GetStreamedWritesPerMail(*task.m_protoMail);
+    }
+
+    if (uint32 writesPerSecond = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_WRITES_PER_SECOND))
+        needTime += writes / writesPerSecond;
+}
+
+void MassMailMgr::GetStreamProgress(std::vector<StreamProgress>& progress) const
+{
+    progress.clear();
+    for (const auto& task : m_streamedMails)
+        progress.push_back({ task.m_sent, task.m_total });
 }
 
 
@@ -37,6 +37,13 @@
 #include "Common.h"
 #include "Mails/Mail.h"
 
+#include <deque>
+
+class QueryResult;
+
+#define MASS_MAIL_STREAM_PAGE_SIZE   1000                   ///< receivers requested from DB at once by a streamed task
+#define MASS_MAIL_STREAM_BATCH_SIZE  100                    ///< max mails written by one multi-row insert
+
 /**
  * A class to represent the mail send factory to multiple (often all existing) characters.
  *
@@ -45,11 +52,19 @@
 class MassMailMgr
 {
     public:                                                 // Constructors
-        MassMailMgr() {}
+        MassMailMgr() : m_lastStreamId(0), m_lastStreamUpdate(0), m_writeBudget(0.0f) {}
 
     public:                                                 // Accessors
         void GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) const;
 
+        /// Progress of a streamed task, total is 0 while the receivers are still counted
+        struct StreamProgress
+        {
+            uint32 sent;
+            uint32 total;
+        };
+        void GetStreamProgress(std::vector<StreamProgress>& progress) const;
+
     public:                                                 // modifiers
         typedef std::unordered_set<uint32> ReceiversList;
 
@@ -65,9 +80,10 @@ class MassMailMgr
 
         /**
          * And new mass mail task with SQL query text for fill receivers list.
+         * With MassMailer.WritesPerSecond set the receivers are paged from DB instead, see StreamedMassMail.
          *
          * @param mailProto     prepared mail for clone and send to characters, will deleted in result call
-         * @param queryStr      SQL query for get guid list of receivers, first field in query result must be uint32 low guids list.
+         * @param queryStr      SQL query for get guid list of receivers, first field in query result must be uint32 low guids list named guid.
          *
          * Note: this function safe to be called from Map::Update content/etc, real data add will executed in next tick after query results ready
          */
@@ -92,6 +108,10 @@ class MassMailMgr
          */
         void Update(bool sendall = false);
 
+        /// Query callbacks of streamed tasks, only for call from MassMailerQueryHandler
+        void AddStreamedTask(MailDraft* mailProto, MailSender const& sender, std::string const& query, uint32 total);
+        void AddStreamedReceivers(uint32 taskId, QueryResult* result);
+
     private:
 
         /// Mass mail task store mail prototype and receivers list who not get mail yet
@@ -112,8 +132,45 @@ class MassMailMgr
 
         typedef std::list<MassMail> MassMailList;
 
+        /// Mass mail task paging its receivers from DB and writing mails without items by multi-row inserts
+        struct StreamedMassMail
+        {
+            explicit StreamedMassMail(uint32 id, MailDraft* mailProto, MailSender sender, std::string const& query, uint32 total)
+                : m_id(id), m_protoMail(mailProto), m_sender(sender), m_query(query), m_lastGuid(0), m_pageLoading(false), m_lastPage(false), m_sent(0), m_total(total)
+            {
+                MANGOS_ASSERT(mailProto);
+            }
+            StreamedMassMail(StreamedMassMail const&) = delete;
+
+            uint32 m_id;
+            std::unique_ptr<MailDraft> m_protoMail;
+
+            MailSender m_sender;
+            std::string m_query;
+            std::deque<uint32> m_receivers;                 ///< loaded pages not sent yet, in guid order
+            uint32 m_lastGuid;                              ///< last guid of the loaded pages
+            bool m_pageLoading;
+            bool m_lastPage;
+            uint32 m_sent;
+            uint32 m_total;
+        };
+
+        typedef std::list<StreamedMassMail> StreamedMassMailList;
+
+        void UpdateStreamed();
+        void RequestStreamPage(StreamedMassMail& task);
+        void SendStreamedBatch(StreamedMassMail& task, uint32 count);
+        void SendStreamedMail(StreamedMassMail& task, uint32 receiverLowGuid, bool last);
+        static uint32 GetStreamedWritesPerMail(MailDraft const& mailProto);
+
         /// List of current queued mass mail tasks
         MassMailList m_massMails;
+
+        /// List of current streamed mass mail tasks, sent one after another
+        StreamedMassMailList m_streamedMails;
+        uint32 m_lastStreamId;
+        uint32 m_lastStreamUpdate;
+        float m_writeBudget;                                ///< DB writes allowed now by MassMailer.WritesPerSecond
 };
 
 #define sMassMailMgr MaNGOS::Singleton<MassMailMgr>::Instance()
@@ -21,6 +21,7 @@
 
 #include "Common.h"
 #include "GameSystem/NGrid.h"
+#include "Grids/CellPositionIndex.h"
 #include <cmath>
 
 // Forward class definitions
@@ -75,8 +76,27 @@ typedef GridRefManager<DynamicObject>   DynamicObjectMapType;
 typedef GridRefManager<GameObject>      GameObjectMapType;
 typedef GridRefManager<Player>          PlayerMapType;
 
-typedef Grid<Player, AllWorldObjectTypes, AllGridObjectTypes> GridType;
-typedef NGrid<MAX_NUMBER_OF_CELLS, Player, AllWorldObjectTypes, AllGridObjectTypes> NGridType;
+// VisitMask bits of grid notifiers, see ContainerTypeMask
+enum GridMapTypeMask
+{
+    GRID_MAP_TYPE_MASK_CORPSE        = 0x01,
+    GRID_MAP_TYPE_MASK_CREATURE      = 0x02,
+    GRID_MAP_TYPE_MASK_DYNAMICOBJECT = 0x04,
+    GRID_MAP_TYPE_MASK_GAMEOBJECT    = 0x08,
+    GRID_MAP_TYPE_MASK_PLAYER        = 0x10,
+    GRID_MAP_TYPE_MASK_CAMERA        = 0x20,
+    GRID_MAP_TYPE_MASK_ALL           = 0x3F
+};
+
+template<> struct ContainerTypeMask<Corpse>        { static constexpr uint32 value = GRID_MAP_TYPE_MASK_CORPSE; };
+template<> struct ContainerTypeMask<Creature>      { static constexpr uint32 value = GRID_MAP_TYPE_MASK_CREATURE; };
+template<> struct ContainerTypeMask<DynamicObject> { static constexpr uint32 value = GRID_MAP_TYPE_MASK_DYNAMICOBJECT; };
+template<> struct ContainerTypeMask<GameObject>    { static constexpr uint32 value = GRID_MAP_TYPE_MASK_GAMEOBJECT; };
+template<> struct ContainerTypeMask<Player>        { static constexpr uint32 value = GRID_MAP_TYPE_MASK_PLAYER; };
+template<> struct ContainerTypeMask<Camera>        { static constexpr uint32 value = GRID_MAP_TYPE_MASK_CAMERA; };
+
+typedef Grid<Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> GridType;
+typedef NGrid<MAX_NUMBER_OF_CELLS, Player, AllWorldObjectTypes, AllGridObjectTypes, CellPositionIndex> NGridType;
 
 typedef TypeMapContainer<AllGridObjectTypes> GridTypeMapContainer;
 typedef TypeMapContainer<AllWorldObjectTypes> WorldTypeMapContainer;
@@ -25,10 +25,14 @@
 #include "Maps/GridMap.h"
 #include "VMapFactory.h"
 #include "MotionGenerators/MoveMap.h"
+#include "vmap/MapTree.h"
 #include "World/World.h"
 #include "Policies/Singleton.h"
 #include "Util.h"
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #include <mutex>
 
 char const* MAP_MAGIC         = "MAPS";
@@ -74,75 +78,99 @@ GridMap::~GridMap()
     unloadData();
 }
 
+// points into the mapped file, the sections written by the extractor keep their arrays aligned
+template<typename T>
+static T const* MapFileArray(boost::interprocess::mapped_region const& region, size_t& pos, size_t count)
+{
+    if (pos % alignof(T) != 0 || pos + count * sizeof(T) > region.get_size())
+        return nullptr;
+
+    T const* data = reinterpret_cast<T const*>(static_cast<char const*>(region.get_address()) + pos);
+    pos += count * sizeof(T);
+    return data;
+}
+
+template<typename T>
+static bool ReadFileStruct(boost::interprocess::mapped_region const& region, size_t pos, T& out)
+{
+    if (pos + sizeof(T) > region.get_size())
+        return false;
+
+    memcpy(&out, static_cast<char const*>(region.get_address()) + pos, sizeof(T));
+    return true;
+}
+
 bool GridMap::loadData(char const* filename)
 {
     // Unload old data if exist
     unloadData();
 
-    GridMapFileHeader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    // map the whole file read only, the arrays below point into it so every process
+    // using the same file shares its pages instead of owning a heap copy
+    try
     {
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        m_mapping.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        m_mapping.reset();
+        // Not return error if file not found
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Failled to found %s", filename);
         // its a valid error only in case of no vmap files are available too
         return true;
     }
 
-    fread(&header, sizeof(header), 1, in);
-    if (header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
+    // most of the tile is read by the first height queries anyway
+    m_mapping->advise(boost::interprocess::mapped_region::advice_willneed);
+
+    GridMapFileHeader header;
+    if (ReadFileStruct(*m_mapping, 0, header) &&
+            header.mapMagic     == *((uint32 const*)(MAP_MAGIC)) &&
             header.versionMagic == *((uint32 const*)(MAP_VERSION_MAGIC)))
     {
         // loadup area data
-        if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
+        if (header.areaMapOffset && !loadAreaData(header.areaMapOffset, header.areaMapSize))
         {
             sLog.outError("Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup holes data
-        if (header.holesOffset && !loadHolesData(in, header.holesOffset, header.holesSize))
+        if (header.holesOffset && !loadHolesData(header.holesOffset, header.holesSize))
         {
             sLog.outError("Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(header.heightMapOffset, header.heightMapSize))
         {
             sLog.outError("Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
         // loadup liquid data
-        if (header.liquidMapOffset && !loadGridMapLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
+        if (header.liquidMapOffset && !loadGridMapLiquidData(header.liquidMapOffset, header.liquidMapSize))
         {
             sLog.outError("Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return false;
         }
 
-        fclose(in);
         return true;
     }
 
     sLog.outError("Map file '%s' is non-compatible version (outdated?). Please, create new using ad.exe program.", filename);
-    fclose(in);
+    unloadData();
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
-
     m_area_map = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -150,63 +178,62 @@ void GridMap::unloadData()
     m_liquidFlags = nullptr;
     m_liquid_map  = nullptr;
     m_gridGetHeight = &GridMap::getHeightFromFlat;
+
+    // all arrays above pointed into the mapping
+    m_mapping.reset();
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(uint32 offset, uint32 /*size*/)
 {
     GridMapAreaHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    if (!ReadFileStruct(*m_mapping, offset, header) || header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
         return false;
 
     m_gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        m_area_map = new uint16 [16 * 16];
-        fread(m_area_map, sizeof(uint16), 16 * 16, in);
+        size_t pos = offset + sizeof(header);
+        m_area_map = MapFileArray<uint16>(*m_mapping, pos, 16 * 16);
+        if (!m_area_map)
+            return false;
     }
 
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(uint32 offset, uint32 /*size*/)
 {
     GridMapHeightHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    if (!ReadFileStruct(*m_mapping, offset, header) || header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
         return false;
 
+    size_t pos = offset + sizeof(header);
     m_gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129 * 129];
-            m_uint16_V8 = new uint16 [128 * 128];
-            fread(m_uint16_V9, sizeof(uint16), 129 * 129, in);
-            fread(m_uint16_V8, sizeof(uint16), 128 * 128, in);
+            m_uint16_V9 = MapFileArray<uint16>(*m_mapping, pos, 129 * 129);
+            m_uint16_V8 = MapFileArray<uint16>(*m_mapping, pos, 128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             m_gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129 * 129];
-            m_uint8_V8 = new uint8 [128 * 128];
-            fread(m_uint8_V9, sizeof(uint8), 129 * 129, in);
-            fread(m_uint8_V8, sizeof(uint8), 128 * 128, in);
+            m_uint8_V9 = MapFileArray<uint8>(*m_mapping, pos, 129 * 129);
+            m_uint8_V8 = MapFileArray<uint8>(*m_mapping, pos, 128 * 128);
             m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             m_gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129 * 129];
-            m_V8 = new float [128 * 128];
-            fread(m_V9, sizeof(float), 129 * 129, in);
-            fread(m_V8, sizeof(float), 128 * 128, in);
+            m_V9 = MapFileArray<float>(*m_mapping, pos, 129 * 129);
+            m_V8 = MapFileArray<float>(*m_mapping, pos, 128 * 128);
             m_gridGetHeight = &GridMap::getHeightFromFloat;
         }
+
+        if (!m_V9 || !m_V8)
+            return false;
     }
     else
         m_gridGetHeight = &GridMap::getHeightFromFlat;
@@ -214,22 +241,15 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
-        return false;
-
-    if (fread(&m_holes, sizeof(m_holes), 1, in) != 1)
-        return false;
-    return true;
+    return ReadFileStruct(*m_mapping, offset, m_holes);
 }
 
-bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadGridMapLiquidData(uint32 offset, uint32 /*size*/)
 {
     GridMapLiquidHeader header;
-    fseek(in, offset, SEEK_SET);
-    fread(&header, sizeof(header), 1, in);
-    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    if (!ReadFileStruct(*m_mapping, offset, header) || header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
         return false;
 
     m_liquidGlobalEntry = header.liquidType;
@@ -240,19 +260,20 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     m_liquid_height = header.height;
     m_liquidLevel   = header.liquidLevel;
 
+    size_t pos = offset + sizeof(header);
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        m_liquidEntry = new uint16[16 * 16];
-        fread(m_liquidEntry, sizeof(uint16), 16 * 16, in);
-
-        m_liquidFlags = new uint8[16 * 16];
-        fread(m_liquidFlags, sizeof(uint8), 16 * 16, in);
+        m_liquidEntry = MapFileArray<uint16>(*m_mapping, pos, 16 * 16);
+        m_liquidFlags = MapFileArray<uint8>(*m_mapping, pos, 16 * 16);
+        if (!m_liquidEntry || !m_liquidFlags)
+            return false;
     }
 
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        m_liquid_map = new float [m_liquid_width * m_liquid_height];
-        fread(m_liquid_map, sizeof(float), m_liquid_width * m_liquid_height, in);
+        m_liquid_map = MapFileArray<float>(*m_mapping, pos, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
+            return false;
     }
 
     return true;
@@ -275,6 +296,28 @@ float GridMap::getHeightFromFlat(float /*x*/, float /*y*/) const
     return m_gridHeight;
 }
 
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    // resolve the storage format once, the loops call the getters directly so they get inlined
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromFloat(x[i], y[i]);
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint16)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromUint16(x[i], y[i]);
+    }
+    else if (m_gridGetHeight == &GridMap::getHeightFromUint8)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            heights[i] = getHeightFromUint8(x[i], y[i]);
+    }
+    else
+        std::fill(heights, heights + count, m_gridHeight);
+}
+
 bool GridMap::isHole(int row, int col) const
 {
     int cellRow = row / 8;     // 8 squares per cell
@@ -388,7 +431,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -456,7 +499,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
     y_int &= (MAP_RESOLUTION - 1);
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -731,9 +774,9 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y, bool mapOnly /*= fals
     // reference grid as a first step
     RefGrid(x, y);
 
-    // quick check if GridMap already loaded
+    // quick check if GridMap already loaded, it may come from a map only request or the prefetch thread
     GridMap* pMap = m_GridMaps[x][y];
-    if (!pMap)
+    if (!pMap || (!mapOnly && !pMap->IsFullyLoaded()))
     {
         pMap = LoadMapAndVMap(x, y, mapOnly);
         m_GridMapsLoadAttempted[x][y] = true;
@@ -766,6 +809,9 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     if (!i_timer.Passed())
         return;
 
+    // the prefetch thread may install a GridMap meanwhile
+    LOCK_GUARD lock(m_mutex);
+
     for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
@@ -828,12 +874,41 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
         mapHeight = gmap->getHeight(x, y);
 
+    return SelectStaticHeight(x, y, z, mapHeight, useVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeightsStatic(float const* x, float const* y, float const* z, float* heights, uint32 count, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    for (uint32 i = 0; i < count;)
+    {
+        // consecutive points of the same grid share the grid lookup and the format dispatch
+        int gx = (int)(32 - x[i] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[i] / SIZE_OF_GRIDS);
+        uint32 end = i + 1;
+        while (end < count && (int)(32 - x[end] / SIZE_OF_GRIDS) == gx && (int)(32 - y[end] / SIZE_OF_GRIDS) == gy)
+            ++end;
+
+        if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x[i], y[i]))
+            gmap->getHeights(x + i, y + i, heights + i, end - i);
+        else
+            std::fill(heights + i, heights + end, VMAP_INVALID_HEIGHT_VALUE);
+
+        i = end;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = SelectStaticHeight(x[i], y[i], z[i], heights[i], useVmaps, maxSearchDist);
+}
+
+float TerrainInfo::SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
     if (useVmaps)
     {
         if (m_vmgr->isHeightCalcEnabled())
@@ -1230,34 +1305,16 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         return m_GridMaps[x][y];
     }
 
+    std::future<GridMap*> mapLoad;
+    if (!m_GridMaps[x][y])
     {
-        LOCK_GUARD lock(m_mutex);
-        // double checked lock pattern
-        if (!m_GridMaps[x][y])
-        {
-            GridMap* map = new GridMap();
-
-            // map file name
-            int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
-            char* tmp = new char[len];
-            snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
-
-            if (!map->loadData(tmp))
-            {
-                sLog.outError("Error load map file: %s", tmp);
-                //assert(false);
-            }
+        if (mapOnly)
+            return SetGridMap(x, y, LoadGridMapFile(x, y, true));
 
-            delete[] tmp;
-            m_GridMaps[x][y] = map;
-        }
+        // parse the .map file on its own thread while this one loads the vmap and mmap tiles
+        mapLoad = std::async(std::launch::async, &TerrainInfo::LoadGridMapFile, this, x, y, true);
     }
 
-    // we'll load the rest later
-    if (mapOnly)
-        return m_GridMaps[x][y];
-
     if (!m_vmgr->IsTileLoaded(m_mapId, x, y))
     {
         // load VMAPs for current map/grid...
@@ -1284,6 +1341,11 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
         // load navmesh
         MMAP::MMapFactory::createOrGetMMapManager()->loadMap(m_mapId, x, y);
     }
+    else
+        MMAP::MMapFactory::createOrGetMMapManager()->useTile(m_mapId, x, y);
+
+    if (mapLoad.valid())
+        SetGridMap(x, y, mapLoad.get());
 
     if (m_GridMaps[x][y])
         m_GridMaps[x][y]->SetFullyLoaded();
@@ -1291,6 +1353,69 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnl
     return  m_GridMaps[x][y];
 }
 
+GridMap* TerrainInfo::LoadGridMapFile(const uint32 x, const uint32 y, bool reportError) const
+{
+    int len = sWorld.GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
+    char* tmp = new char[len];
+    snprintf(tmp, len, (char*)(sWorld.GetDataPath() + "maps/%03u%02u%02u.map").c_str(), m_mapId, x, y);
+    DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Loading map %s", tmp);
+
+    GridMap* map = new GridMap();
+    if (!map->loadData(tmp))
+    {
+        if (reportError)                                    // keep the empty GridMap, the load was attempted
+            sLog.outError("Error load map file: %s", tmp);
+        else
+        {
+            delete map;
+            map = nullptr;
+        }
+    }
+
+    delete[] tmp;
+    return map;
+}
+
+GridMap* TerrainInfo::SetGridMap(const uint32 x, const uint32 y, GridMap* map)
+{
+    LOCK_GUARD lock(m_mutex);
+    // another thread may have been faster, keep its GridMap
+    if (!m_GridMaps[x][y])
+        m_GridMaps[x][y] = map;
+    else
+        delete map;
+
+    return m_GridMaps[x][y];
+}
+
+static void ReadFileAhead(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer));
+    fclose(file);
+}
+
+void TerrainInfo::PreloadGridData(const uint32 x, const uint32 y)
+{
+    if (!m_GridMaps[x][y])
+    {
+        // a failed load is left to the map thread to report
+        if (GridMap* map = LoadGridMapFile(x, y, false))
+            SetGridMap(x, y, map);
+    }
+
+    // vmap and mmap managers are not thread safe, tiles get inserted by the map thread on grid load
+    ReadFileAhead(sWorld.GetDataPath() + "vmaps/" + VMAP::StaticMapTree::getTileFileName(m_mapId, x, y));
+
+    char mmapName[sizeof("mmaps/%03i%02i%02i.mmtile") + 4];
+    snprintf(mmapName, sizeof(mmapName), "mmaps/%03i%02i%02i.mmtile", m_mapId, x, y);
+    ReadFileAhead(sWorld.GetDataPath() + mmapName);
+}
+
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= nullptr*/) const
 {
     if (CanCheckLiquidLevel(x, y))
@@ -1318,20 +1443,28 @@ float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= n
 INSTANTIATE_SINGLETON_2(TerrainManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(TerrainManager, std::mutex);
 
-TerrainManager::TerrainManager()
+TerrainManager::TerrainManager() : m_prefetchStop(false)
 {
 }
 
 TerrainManager::~TerrainManager()
 {
+    StopPrefetch();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 }
 
 TerrainInfo* TerrainManager::LoadTerrain(const uint32 mapId)
 {
-    Guard _guard(*this);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_terrainLock);
+        TerrainDataMap::const_iterator iter = i_TerrainMap.find(mapId);
+        if (iter != i_TerrainMap.end())
+            return (*iter).second;
+    }
 
+    std::unique_lock<std::shared_mutex> lock(m_terrainLock);
     TerrainDataMap::const_iterator iter = i_TerrainMap.find(mapId);
     if (iter == i_TerrainMap.end())
     {
@@ -1347,7 +1480,7 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
     if (sWorld.getConfig(CONFIG_BOOL_GRID_UNLOAD) == 0)
         return;
 
-    Guard _guard(*this);
+    std::unique_lock<std::shared_mutex> lock(m_terrainLock);
 
     TerrainDataMap::iterator iter = i_TerrainMap.find(mapId);
     if (iter != i_TerrainMap.end())
@@ -1356,6 +1489,18 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
         // lets check if this object can be actually freed
         if (!ptr->IsReferenced())
         {
+            // dungeons are created and destroyed all the time, keep their grids, vmaps and mmaps for the next instance
+            MapEntry const* mapEntry = sMapStore.LookupEntry(mapId);
+            if (uint32 keepAlive = sWorld.getConfig(CONFIG_UINT32_INSTANCE_TERRAIN_KEEP_ALIVE))
+            {
+                if (mapEntry && mapEntry->Instanceable())
+                {
+                    m_idleTerrains[mapId] = sWorld.GetGameTime() + keepAlive;
+                    return;
+                }
+            }
+
+            m_idleTerrains.erase(mapId);
             i_TerrainMap.erase(iter);
             delete ptr;
         }
@@ -1364,17 +1509,139 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
 
 void TerrainManager::Update(const uint32 diff)
 {
-    // global garbage collection for GridMap objects and VMaps
-    for (auto& iter : i_TerrainMap)
-        iter.second->CleanUpGrids(diff);
+    std::vector<uint32> expired;
+    {
+        // global garbage collection for GridMap objects and VMaps
+        std::shared_lock<std::shared_mutex> lock(m_terrainLock);
+        for (auto& iter : i_TerrainMap)
+        {
+            // grids of an idle terrain stay loaded, they are what the next instance needs first
+            if (!iter.second->IsReferenced() && m_idleTerrains.find(iter.first) != m_idleTerrains.end())
+                continue;
+
+            iter.second->CleanUpGrids(diff);
+        }
+
+        time_t now = sWorld.GetGameTime();
+        for (auto const& idle : m_idleTerrains)
+            if (idle.second <= now)
+                expired.push_back(idle.first);
+    }
+
+    if (expired.empty())
+        return;
+
+    std::unique_lock<std::shared_mutex> lock(m_terrainLock);
+    for (uint32 mapId : expired)
+    {
+        m_idleTerrains.erase(mapId);
+
+        // used again meanwhile, the next release starts a new keep alive time
+        TerrainDataMap::iterator iter = i_TerrainMap.find(mapId);
+        if (iter == i_TerrainMap.end() || iter->second->IsReferenced())
+            continue;
+
+        delete iter->second;
+        i_TerrainMap.erase(iter);
+    }
 }
 
 void TerrainManager::UnloadAll()
 {
+    StopPrefetch();
+
     for (auto& it : i_TerrainMap)
         delete it.second;
 
     i_TerrainMap.clear();
+    m_idleTerrains.clear();
+}
+
+void TerrainManager::PrefetchGrid(TerrainInfo* terrain, const uint32 x, const uint32 y)
+{
+    MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
+    MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
+
+    // keep the queue short, requests are only useful while the player is still heading there
+    const size_t maxQueued = 64;
+
+    std::lock_guard<std::mutex> lock(m_prefetchLock);
+    if (m_prefetchStop || m_prefetchQueue.size() >= maxQueued)
+        return;
+
+    if (!m_prefetchPending.insert(terrain->GetMapId() << 12 | x << 6 | y).second)
+        return;
+
+    // the TerrainInfo must survive until the request is handled
+    terrain->AddRef();
+    m_prefetchQueue.push_back({ terrain, x, y });
+
+    if (m_prefetchThreads.empty())
+        for (uint32 i = 0; i < sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_THREADS); ++i)
+            m_prefetchThreads.emplace_back(&TerrainManager::PrefetchWorker, this);
+
+    m_prefetchCond.notify_one();
+}
+
+void TerrainManager::StopPrefetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_prefetchLock);
+        m_prefetchStop = true;
+    }
+    m_prefetchCond.notify_all();
+
+    for (auto& thread : m_prefetchThreads)
+        thread.join();
+    m_prefetchThreads.clear();
+
+    for (auto& request : m_prefetchQueue)
+        request.terrain->Release();
+
+    m_prefetchQueue.clear();
+    m_prefetchPending.clear();
+}
+
+void TerrainManager::PreloadGrids(TerrainInfo* terrain, std::vector<std::pair<uint32, uint32>> const& grids)
+{
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+        for (size_t i; (i = next++) < grids.size();)
+            terrain->PreloadGridData(grids[i].first, grids[i].second);
+    };
+
+    // grids are independent files, one job per core and the calling thread takes its share
+    size_t const jobCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), grids.size());
+    std::vector<std::future<void>> jobs;
+    for (size_t i = 1; i < jobCount; ++i)
+        jobs.push_back(std::async(std::launch::async, worker));
+
+    worker();
+
+    for (auto& job : jobs)
+        job.wait();
+}
+
+void TerrainManager::PrefetchWorker()
+{
+    std::unique_lock<std::mutex> lock(m_prefetchLock);
+    while (true)
+    {
+        m_prefetchCond.wait(lock, [this] { return m_prefetchStop || !m_prefetchQueue.empty(); });
+        if (m_prefetchStop)
+            return;
+
+        PrefetchRequest request = m_prefetchQueue.front();
+        m_prefetchQueue.pop_front();
+
+        lock.unlock();
+        request.terrain->PreloadGridData(request.x, request.y);
+        lock.lock();
+
+        m_prefetchPending.erase(request.terrain->GetMapId() << 12 | request.x << 6 | request.y);
+        request.terrain->Release();
+    }
 }
 
 uint32 TerrainManager::GetAreaIdByAreaFlag(uint16 areaflag, uint32 map_id)
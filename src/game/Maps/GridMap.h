@@ -27,7 +27,15 @@
 #include "Maps/GridMapDefines.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 class Creature;
 class Unit;
@@ -42,6 +50,8 @@ namespace VMAP
     class IVMapManager;
 };
 
+namespace boost { namespace interprocess { class mapped_region; } }
+
 class GridMap
 {
     private:
@@ -51,22 +61,22 @@ class GridMap
 
         // Area data
         uint16 m_gridArea;
-        uint16* m_area_map;
+        uint16 const* m_area_map;
 
         // Height level data
         float m_gridHeight;
         float m_gridIntHeightMultiplier;
         union
         {
-            float* m_V9;
-            uint16* m_uint16_V9;
-            uint8* m_uint8_V9;
+            float const* m_V9;
+            uint16 const* m_uint16_V9;
+            uint8 const* m_uint8_V9;
         };
         union
         {
-            float* m_V8;
-            uint16* m_uint16_V8;
-            uint8* m_uint8_V8;
+            float const* m_V8;
+            uint16 const* m_uint16_V8;
+            uint8 const* m_uint8_V8;
         };
 
         // Liquid data
@@ -77,17 +87,20 @@ class GridMap
         uint8 m_liquid_width;
         uint8 m_liquid_height;
         float m_liquidLevel;
-        uint16* m_liquidEntry;
-        uint8* m_liquidFlags;
-        float* m_liquid_map;
+        uint16 const* m_liquidEntry;
+        uint8 const* m_liquidFlags;
+        float const* m_liquid_map;
+
+        // read only view of the .map file, all data arrays above point into it
+        std::unique_ptr<boost::interprocess::mapped_region> m_mapping;
 
         // For fast check
         bool m_fullyLoaded;
 
-        bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-        bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-        bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
-        bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+        bool loadAreaData(uint32 offset, uint32 size);
+        bool loadHeightData(uint32 offset, uint32 size);
+        bool loadGridMapLiquidData(uint32 offset, uint32 size);
+        bool loadHolesData(uint32 offset, uint32 size);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -114,6 +127,8 @@ class GridMap
         uint16 getArea(float x, float y) const;
 
         inline float getHeight(float x, float y) const { return (this->*m_gridGetHeight)(x, y); }
+        // heights of count points of this grid, the storage format is dispatched once for all of them
+        void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
         float getLiquidLevel(float x, float y) const;
         uint8 getTerrainType(float x, float y) const;
         GridMapLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data = nullptr, float collisionHeight = 2.03128f);
@@ -148,6 +163,8 @@ class TerrainInfo : public Referencable<std::atomic_long>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // GetHeightStatic for count points at once, keep points of the same grid next to each other
+        void GetHeightsStatic(float const* x, float const* y, float const* z, float* heights, uint32 count, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = nullptr) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float& groundZ, bool swim = false, float minWaterDeep = DEFAULT_COLLISION_HEIGHT) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = nullptr) const;
@@ -176,6 +193,10 @@ class TerrainInfo : public Referencable<std::atomic_long>
 
         bool CanCheckLiquidLevel(float x, float y) const;
 
+        // called by the TerrainManager prefetch thread only, loads the GridMap file of a grid
+        // and reads its vmap/mmap tiles once so the map thread finds them in the page cache
+        void PreloadGridData(const uint32 x, const uint32 y);
+
     protected:
         friend class Map;
         friend class ObjectMgr;
@@ -188,7 +209,13 @@ class TerrainInfo : public Referencable<std::atomic_long>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y, bool loadOnlyMap = false);
+        // picks between the .map height and the vmap floor near z
+        float SelectStaticHeight(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y, bool mapOnly = false);
+        // reads the .map file of a grid, takes no lock, on error returns an empty GridMap or nullptr
+        GridMap* LoadGridMapFile(const uint32 x, const uint32 y, bool reportError) const;
+        // stores map unless an other thread did it first, returns the stored GridMap
+        GridMap* SetGridMap(const uint32 x, const uint32 y, GridMap* map);
 
         int RefGrid(const uint32& x, const uint32& y);
         int UnrefGrid(const uint32& x, const uint32& y);
@@ -223,6 +250,12 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         void Update(const uint32 diff);
         void UnloadAll();
 
+        // queue terrain data of a grid for loading in the background, see Map::PrefetchTerrainAhead
+        void PrefetchGrid(TerrainInfo* terrain, const uint32 x, const uint32 y);
+        void StopPrefetch();
+        // loads GridMaps and reads ahead the vmap/mmap tiles of many grids on all cores, returns when done
+        void PreloadGrids(TerrainInfo* terrain, std::vector<std::pair<uint32, uint32>> const& grids);
+
         uint16 GetAreaFlag(uint32 mapid, float x, float y, float z) const
         {
             TerrainInfo* pData = const_cast<TerrainManager*>(this)->LoadTerrain(mapid);
@@ -252,8 +285,27 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
         TerrainManager(const TerrainManager&);
         TerrainManager& operator=(const TerrainManager&);
 
-        typedef MaNGOS::ClassLevelLockable<TerrainManager, std::mutex>::Lock Guard;
+        // terrain lookups come from every map thread, only creation and unload need exclusive access
+        std::shared_mutex m_terrainLock;
         TerrainDataMap i_TerrainMap;
+        // unreferenced terrain of instanceable maps kept loaded until the given game time, see Instance.TerrainKeepAlive
+        std::unordered_map<uint32, time_t> m_idleTerrains;
+
+        void PrefetchWorker();
+
+        struct PrefetchRequest
+        {
+            TerrainInfo* terrain;
+            uint32 x;
+            uint32 y;
+        };
+
+        std::vector<std::thread> m_prefetchThreads;
+        std::mutex m_prefetchLock;
+        std::condition_variable m_prefetchCond;
+        std::deque<PrefetchRequest> m_prefetchQueue;
+        std::set<uint32> m_prefetchPending;                 // mapId << 12 | x << 6 | y of queued grids
+        bool m_prefetchStop;
 };
 
 #define sTerrainMgr TerrainManager::Instance()
@@ -19,23 +19,46 @@
 #include "Maps/InstanceData.h"
 #include "Database/DatabaseEnv.h"
 #include "Maps/Map.h"
+#include "World/World.h"
 
-void InstanceData::SaveToDB() const
+void InstanceData::UpdateSaveToDB(uint32 diff)
 {
+    m_saveTimer = m_saveTimer > diff ? m_saveTimer - diff : 0;
+
+    if (m_saveRequested && !m_saveTimer)
+    {
+        FlushSaveToDB();
+        m_saveTimer = sWorld.getConfig(CONFIG_UINT32_INSTANCE_DATA_SAVE_INTERVAL);
+    }
+}
+
+void InstanceData::FlushSaveToDB()
+{
+    if (!m_saveRequested)
+        return;
+
+    m_saveRequested = false;
+
     // no reason to save BGs/Arenas
     if (instance->IsBattleGroundOrArena())
         return;
 
-    if (!Save())
+    char const* data = Save();
+    if (!data)
         return;
 
-    std::string data = Save();
-    CharacterDatabase.escape_string(data);
-
     if (instance->Instanceable())
-        CharacterDatabase.PExecute("UPDATE instance SET data = '%s' WHERE id = '%u'", data.c_str(), instance->GetInstanceId());
+    {
+        static SqlStatementID updateInstanceData;
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updateInstanceData, "UPDATE instance SET data = ? WHERE id = ?");
+        stmt.PExecute(data, instance->GetInstanceId());
+    }
     else
-        CharacterDatabase.PExecute("UPDATE world SET data = '%s' WHERE map = '%u'", data.c_str(), instance->GetId());
+    {
+        static SqlStatementID updateWorldData;
+        SqlStatement stmt = CharacterDatabase.CreateStatement(updateWorldData, "UPDATE world SET data = ? WHERE map = ?");
+        stmt.PExecute(data, instance->GetId());
+    }
 }
 
 bool InstanceData::CheckConditionCriteriaMeet(Player const* /*source*/, uint32 instance_condition_id, WorldObject const* /*conditionSource*/, uint32 conditionSourceType) const
@@ -88,7 +88,7 @@ class InstanceData
 {
     public:
 
-        explicit InstanceData(Map* map) : instance(map) {}
+        explicit InstanceData(Map* map) : instance(map), m_saveRequested(false), m_saveTimer(0) {}
         virtual ~InstanceData() {}
 
         Map* instance;
@@ -102,7 +102,12 @@ class InstanceData
         // When save is needed, this function generates the data
         virtual const char* Save() const { return ""; }
 
-        void SaveToDB() const;
+        // requests a save, the data is written by the map after its update (see Instance.DataSaveInterval)
+        void SaveToDB() const { m_saveRequested = true; }
+        // called by the map, writes a requested save once the interval since the last write passed
+        void UpdateSaveToDB(uint32 diff);
+        // writes a requested save right away
+        void FlushSaveToDB();
 
         // Called every map update
         virtual void Update(const uint32 /*diff*/) {}
@@ -188,6 +193,10 @@ class InstanceData
 
         virtual void ShowChatCommands(ChatHandler* /*handler*/) {}
         virtual void ExecuteChatCommand(ChatHandler* /*handler*/, char* /*args*/) {}
+
+    private:
+        mutable bool m_saveRequested;
+        uint32 m_saveTimer;
 };
 
 #endif
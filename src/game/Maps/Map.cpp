@@ -18,6 +18,7 @@
 
 #include "Maps/Map.h"
 #include "Maps/MapManager.h"
+#include "Maps/MapWorkers.h"
 #include "Entities/Player.h"
 #include "Grids/GridNotifiers.h"
 #include "Log.h"
@@ -39,21 +40,45 @@
 #include "Chat/Chat.h"
 #include "Weather/Weather.h"
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
+#include "AI/ScriptDevAI/ScriptProfiler.h"
+#include "Maps/ZoneStats.h"
+#include "World/TickWatchdog.h"
+#include "Movement/MoveSpline.h"
+#include "AllocStats.h"
+#include "Trace.h"
 
 #ifdef BUILD_METRICS
  #include "Metric/Metric.h"
+
+// aggregated over the metric send interval instead of one measurement per update
+struct MapMetrics
+{
+    explicit MapMetrics(std::map<std::string, std::string> const& tags) :
+        update("map.update", tags), updatedObjects("map.update.objects", tags),
+        sessionUpdate("map.update.session", tags), updatedSessions("map.update.sessions", tags) {}
+
+    metric::histogram update;                               // us
+    metric::counter updatedObjects;
+    metric::histogram sessionUpdate;                        // us
+    metric::counter updatedSessions;
+};
 #endif
 
 Map::~Map()
 {
+    if (m_cellUpdater)
+        m_cellUpdater->deactivate();
+
     UnloadAll(true);
 
-    if (!m_scriptSchedule.empty())
-        sScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
+    if (m_scriptScheduleSize)
+        sScriptMgr.DecreaseScheduledScriptCount(m_scriptScheduleSize);
 
     if (m_persistentState)
         m_persistentState->SetUsedByMapState(nullptr);         // field pointer can be deleted after this
 
+    if (i_data)
+        i_data->FlushSaveToDB();
     delete i_data;
     i_data = nullptr;
 
@@ -136,13 +161,86 @@ bool Map::CanSpawn(TypeID typeId, uint32 dbGuid)
     return false;
 }
 
+void Map::AddGameEventSpawnAction(uint32 dbGuid, HighGuid high, bool spawn)
+{
+    std::lock_guard<std::mutex> guard(m_gameEventSpawnActionsLock);
+    m_gameEventSpawnActions.push_back({ dbGuid, high, spawn });
+}
+
+// Apply queued game event spawns in queue order until the Event.SpawnBudget of this update is spent
+void Map::ProcessGameEventSpawnActions()
+{
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::microseconds(sWorld.getConfig(CONFIG_UINT32_EVENT_SPAWN_BUDGET));
+    while (true)
+    {
+        GameEventSpawnAction action;
+        {
+            std::lock_guard<std::mutex> guard(m_gameEventSpawnActionsLock);
+            if (m_gameEventSpawnActions.empty())
+                return;
+
+            action = m_gameEventSpawnActions.front();
+            m_gameEventSpawnActions.pop_front();
+        }
+
+        ApplyGameEventSpawnAction(action);
+
+        // at least one action per update, a budget turned to 0 meanwhile drains the queue
+        if (budget.count() && std::chrono::steady_clock::now() - start >= budget)
+            return;
+    }
+}
+
+void Map::ApplyGameEventSpawnAction(GameEventSpawnAction const& action)
+{
+    if (action.high == HIGHGUID_UNIT)
+    {
+        if (!action.spawn)
+        {
+            if (Creature* creature = GetCreature(action.dbGuid))
+                creature->AddObjectToRemoveList();
+            return;
+        }
+
+        // grid loaded since the event change already has it
+        CreatureData const* data = sObjectMgr.GetCreatureData(action.dbGuid);
+        if (!data || !IsLoaded(data->posX, data->posY) || GetCreature(action.dbGuid))
+            return;
+
+        Creature* creature = new Creature;
+        if (!creature->LoadFromDB(action.dbGuid, this, action.dbGuid, 0))
+            delete creature;
+        return;
+    }
+
+    if (!action.spawn)
+    {
+        if (GameObject* gameobject = GetGameObject(action.dbGuid))
+            gameobject->Delete();
+        return;
+    }
+
+    GameObjectData const* data = sObjectMgr.GetGOData(action.dbGuid);
+    if (!data || !IsLoaded(data->posX, data->posY) || GetGameObject(action.dbGuid))
+        return;
+
+    GameObject* gameobject = GameObject::CreateGameObject(data->id);
+    if (!gameobject->LoadFromDB(action.dbGuid, this, action.dbGuid, 0))
+        delete gameobject;
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
     if (m_bLoadedGrids[gx][gy])
         return;
 
     if (m_TerrainData->Load(gx, gy))
+    {
         m_bLoadedGrids[gx][gy] = true;
+        // queries next to the grid border may have been answered without its vmap tile
+        m_queryCache.Clear();
+    }
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
@@ -152,9 +250,17 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_activeNonPlayersIter(m_activeNonPlayers.end()), m_onEventNotifiedIter(m_onEventNotifiedObjects.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
       i_data(nullptr), i_script_id(0), m_transportsIterator(m_transports.begin()), m_spawnManager(*this),
-      m_variableManager(this), m_defaultLight(GetDefaultMapLight(id))
+      m_variableManager(this), m_defaultLight(GetDefaultMapLight(id)), m_updateCost(0), m_updateCostAverage(0.0f), m_updatePhaseTimes(nullptr), m_homeThread(-1), m_stateSnapshotEpoch(0), m_parallelCellUpdate(false), m_dynTreeGeneration(0),
+      m_scriptScheduleSize(0)
 {
     m_weatherSystem = new WeatherSystem(this);
+
+#ifdef BUILD_METRICS
+    m_metrics.reset(new MapMetrics({
+        { "map_id", std::to_string(i_id) },
+        { "instance_id", std::to_string(i_InstanceId) }
+    }));
+#endif
 }
 
 void Map::Initialize(bool loadInstanceData /*= true*/)
@@ -172,9 +278,22 @@ void Map::Initialize(bool loadInstanceData /*= true*/)
         }
     }
 
+    m_hibernation = false;
+    m_gridUnloadStartTime = 0;
+    m_gridsUnloaded = 0;
+    m_bulkSpawnDepth = 0;
+    m_lowDetail = false;
+
     // lets initialize visibility distance for map
     InitVisibilityDistance();
 
+    if (sWorld.isQueryCacheMap(i_id))
+        m_queryCache.Configure(sWorld.getConfig(CONFIG_UINT32_VMAP_QUERY_CACHE_ENTRIES), sWorld.getConfig(CONFIG_FLOAT_VMAP_QUERY_CACHE_STEP));
+
+    if (IsContinent())
+        if (uint32 cellThreads = sWorld.getConfig(CONFIG_UINT32_NUM_MAP_CELL_THREADS))
+            m_cellUpdater.reset(new MapUpdater(cellThreads));
+
     // add reference for TerrainData object
     m_TerrainData->AddRef();
 
@@ -363,11 +482,15 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         // active object A(loaded with loader.LoadN call and added to the  map)
         // summons some active object B, while B added to map grid loading called again and so on..
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
+        ++m_bulkSpawnDepth;
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
+        --m_bulkSpawnDepth;
 
         // Add resurrectable corpses to world object list in grid
         sObjectAccessor.AddCorpsesToGrid(GridPair(cell.GridX(), cell.GridY()), (*grid)(cell.CellX(), cell.CellY()), this);
+
+        UpdateVisibilityOfLoadedGrid(cell.GridX(), cell.GridY());
         return true;
     }
 
@@ -395,6 +518,25 @@ void Map::ForceLoadGrid(float x, float y)
     }
 }
 
+void Map::PreloadTerrain(std::vector<GridPair> const& grids)
+{
+    std::vector<std::pair<uint32, uint32>> tiles;
+    for (auto const& p : grids)
+    {
+        // z coord
+        uint32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        uint32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+        if (!m_bLoadedGrids[gx][gy])
+            tiles.emplace_back(gx, gy);
+    }
+
+    std::sort(tiles.begin(), tiles.end());
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+    if (!tiles.empty())
+        sTerrainMgr.PreloadGrids(m_TerrainData, tiles);
+}
+
 void Map::CreatePlayerOnClient(Player* player)
 {
     // update player state for other player and visa-versa
@@ -452,6 +594,10 @@ void Map::Add(T* obj)
 
     obj->SetMap(this);
 
+    std::unique_lock<std::recursive_mutex> guard(m_parallelCellLock, std::defer_lock);
+    if (m_parallelCellUpdate)
+        guard.lock();
+
     Cell cell(p);
     if (obj->isActiveObject())
         EnsureGridLoadedAtEnter(cell);
@@ -470,13 +616,50 @@ void Map::Add(T* obj)
     DEBUG_FILTER_LOG(LOG_FILTER_CREATURE_MOVES, "%s enters grid[%u,%u]", obj->GetGuidStr().c_str(), cell.GridX(), cell.GridY());
 
     obj->GetViewPoint().Event_AddedToWorld(&(*grid)(cell.CellX(), cell.CellY()));
+
+    // spawns of a loading grid are shown in one pass per nearby player once the grid is done, see EnsureGridLoaded
+    if (m_bulkSpawnDepth && obj->GetVisibilityData().GetVisibilityDistance() <= GetVisibilityDistance())
+        return;
+
     obj->SetItsNewObject(true);
     UpdateObjectVisibility(obj, cell, p);
     obj->SetItsNewObject(false);
 }
 
+// sends msg to the players having obj at their client and passing accept, kept up to date by the visibility updates
+template<class Accept>
+static void BroadcastToObservers(Map& map, WorldObject const* obj, WorldPacket const& msg, Accept accept)
+{
+    GuidSet const& observers = obj->GetClientGuidsIAmAt();
+    if (observers.empty())
+        return;
+
+    SharedWorldPacket sharedMsg(msg);
+    for (ObjectGuid guid : observers)
+        if (Player* player = map.GetPlayer(guid))
+            if (accept(player))
+                if (WorldSession* session = player->GetSession())
+                    session->SendPacket(sharedMsg);
+}
+
+// within dist of the view point of the observer, as checked by MessageDistDeliverer
+static bool IsObserverInRange(Player* observer, WorldObject const* obj, float dist)
+{
+    return !dist || observer->GetCamera().GetBody()->IsWithinDist(obj, dist);
+}
+
 void Map::MessageBroadcast(Player const* player, WorldPacket const& msg, bool to_self)
 {
+    if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS))
+    {
+        BroadcastToObservers(*this, player, msg, [](Player*) { return true; });
+        if (to_self)
+            if (WorldSession* session = player->GetSession())
+                session->SendPacket(msg);
+        return;
+    }
+
+
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -498,6 +681,12 @@ void Map::MessageBroadcast(Player const* player, WorldPacket const& msg, bool to
 
 void Map::MessageBroadcast(WorldObject const* obj, WorldPacket const& msg)
 {
+    if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS))
+    {
+        BroadcastToObservers(*this, obj, msg, [](Player*) { return true; });
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -521,6 +710,19 @@ void Map::MessageBroadcast(WorldObject const* obj, WorldPacket const& msg)
 
 void Map::MessageDistBroadcast(Player const* player, WorldPacket const& msg, float dist, bool to_self, bool own_team_only)
 {
+    // players further than the visibility distance do not have the sender at their client
+    if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS) && dist <= player->GetVisibilityData().GetVisibilityDistance())
+    {
+        BroadcastToObservers(*this, player, msg, [player, dist, own_team_only](Player* observer)
+        {
+            return (!own_team_only || observer->GetTeam() == player->GetTeam()) && IsObserverInRange(observer, player, dist);
+        });
+        if (to_self)
+            if (WorldSession* session = player->GetSession())
+                session->SendPacket(msg);
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -542,6 +744,12 @@ void Map::MessageDistBroadcast(Player const* player, WorldPacket const& msg, flo
 
 void Map::MessageDistBroadcast(WorldObject const* obj, WorldPacket const& msg, float dist)
 {
+    if (sWorld.getConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS) && dist <= obj->GetVisibilityData().GetVisibilityDistance())
+    {
+        BroadcastToObservers(*this, obj, msg, [obj, dist](Player* observer) { return IsObserverInRange(observer, obj, dist); });
+        return;
+    }
+
     CellPair p = MaNGOS::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
 
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
@@ -561,6 +769,37 @@ void Map::MessageDistBroadcast(WorldObject const* obj, WorldPacket const& msg, f
     cell.Visit(p, message, *this, *obj, dist);
 }
 
+void Map::QueueCombatLog(WorldObject const* source, WorldPacket&& msg)
+{
+    float range = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_COMBAT_LOG_RANGE);
+    std::shared_ptr<WorldPacket const> packet = std::make_shared<WorldPacket const>(std::move(msg));
+
+    std::lock_guard<std::mutex> guard(m_combatLogLock);
+    for (ObjectGuid guid : source->GetClientGuidsIAmAt())
+        if (Player* player = GetPlayer(guid))
+            if (IsObserverInRange(player, source, range))
+                m_pendingCombatLogs[guid].push_back(packet);
+
+    if (source->GetTypeId() == TYPEID_PLAYER)
+        m_pendingCombatLogs[source->GetObjectGuid()].push_back(packet);
+}
+
+// before the object updates, as the logs were sent before the changed health or power
+void Map::SendCombatLogs()
+{
+    std::unordered_map<ObjectGuid, std::vector<std::shared_ptr<WorldPacket const>>> pending;
+    {
+        std::lock_guard<std::mutex> guard(m_combatLogLock);
+        if (m_pendingCombatLogs.empty())
+            return;
+        pending.swap(m_pendingCombatLogs);
+    }
+
+    for (auto const& playerLogs : pending)
+        if (Player* player = GetPlayer(playerLogs.first))
+            player->GetSession()->SendPackets(playerLogs.second);
+}
+
 void Map::MessageMapBroadcast(WorldObject const* /*obj*/, WorldPacket const& msg)
 {
     Map::PlayerList const& pList = GetPlayers();
@@ -633,6 +872,14 @@ bool Map::loaded(const GridPair& p) const
     return (getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord));
 }
 
+CellPositionIndex const* Map::GetCellPositionIndex(const Cell& cell) const
+{
+    if (!loaded(GridPair(cell.GridX(), cell.GridY())))
+        return nullptr;
+
+    return &(*getNGrid(cell.GridX(), cell.GridY()))(cell.CellX(), cell.CellY()).GetPositionIndex();
+}
+
 #define MAP_METRICS
 
 void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor)
@@ -660,26 +907,235 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::Obje
     }
 }
 
+void Map::CollectNearbyCellsOf(WorldObject* obj, float radius)
+{
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), radius);
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+    {
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+        {
+            uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+            if (isCellMarked(cell_id))
+                continue;
+
+            markCell(cell_id);
+            CellPair pair(x, y);
+            Cell cell(pair);
+            cell.SetNoCreate();
+
+            // grid object data must be loaded here, crawlers are not allowed to load grids
+            if (!loaded(GridPair(cell.GridX(), cell.GridY())))
+                continue;
+
+            EnsureGridLoaded(cell);
+            m_cellsToUpdate[(x & 1) | ((y & 1) << 1)].push_back(cell);
+        }
+    }
+}
+
+void Map::MarkAwakeCells()
+{
+    float const hibernateDistance = sWorld.getConfig(CONFIG_FLOAT_CREATURE_HIBERNATE_DISTANCE);
+    m_hibernation = hibernateDistance > 0.0f && !Instanceable();
+    if (m_hibernation)
+        MarkAwakeCells(m_awakeCells, hibernateDistance);
+
+    float const detailDistance = sWorld.getConfig(CONFIG_FLOAT_VISIBILITY_FULL_DETAIL_DISTANCE);
+    m_lowDetail = detailDistance > 0.0f && !Instanceable();
+    if (m_lowDetail)
+        MarkAwakeCells(m_fullDetailCells, detailDistance);
+}
+
+void Map::MarkAwakeCells(CellMarks& cells, float radius)
+{
+    cells.reset();
+
+    for (auto& ref : m_mapRefManager)
+    {
+        Player* player = ref.getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        MarkCellsOf(cells, player, radius);
+
+        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+            MarkCellsOf(cells, viewPoint, radius);
+    }
+
+    for (auto obj : m_activeNonPlayers)
+        if (obj->IsInWorld() && obj->IsPositionValid())
+            MarkCellsOf(cells, obj, radius);
+}
+
+void Map::MarkCellsOf(CellMarks& cells, WorldObject const* obj, float radius)
+{
+    CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), radius);
+
+    for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+        for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+            cells.set((y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x);
+}
+
+void Map::UpdateCellsParallel(uint32 diff)
+{
+    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    {
+        Player* player = m_mapRefIter->getSource();
+        if (!player->IsInWorld() || !player->IsPositionValid())
+            continue;
+
+        CollectNearbyCellsOf(player, player->GetVisibilityData().GetVisibilityDistance());
+
+        // If player is using far sight, visit that object too
+        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+            CollectNearbyCellsOf(viewPoint, viewPoint->IsInWorld() ? viewPoint->GetVisibilityData().GetVisibilityDistance() : GetVisibilityDistance());
+    }
+
+    // active objects always stand in one of their own visible cells, crawlers update them together with their cell
+    for (auto obj : m_activeNonPlayers)
+        if (obj->IsInWorld() && obj->IsPositionValid())
+            CollectNearbyCellsOf(obj, GetVisibilityDistance());
+
+    size_t const threads = sWorld.getConfig(CONFIG_UINT32_NUM_MAP_CELL_THREADS);
+
+    for (auto& cells : m_cellsToUpdate)
+    {
+        if (cells.empty())
+            continue;
+
+        // split one parity class in contiguous chunks, one crawler per chunk
+        size_t const batchCount = std::min(threads, cells.size());
+        size_t const batchSize = (cells.size() + batchCount - 1) / batchCount;
+        m_cellBatches.resize(batchCount);
+        for (size_t i = 0; i < batchCount; ++i)
+        {
+            auto first = cells.begin() + std::min(i * batchSize, cells.size());
+            auto last = cells.begin() + std::min((i + 1) * batchSize, cells.size());
+            m_cellBatches[i].assign(first, last);
+        }
+
+        m_parallelCellUpdate = true;
+        for (auto& batch : m_cellBatches)
+            if (!batch.empty())
+                m_cellUpdater->schedule_update(new GridCrawler(*this, batch, diff, *m_cellUpdater));
+        m_cellUpdater->wait();
+        m_parallelCellUpdate = false;
+
+        // barrier: apply moves requested during the batch before next parity class is processed
+        ApplyDeferredRelocations();
+        cells.clear();
+    }
+}
+
+void Map::ApplyDeferredRelocations()
+{
+    std::vector<DeferredRelocation> relocations;
+    relocations.swap(m_deferredRelocations);
+
+    for (auto& reloc : relocations)
+    {
+        WorldObject* obj = reloc.object;
+        if (!obj->IsInWorld())
+            continue;
+
+        if (obj->GetTypeId() == TYPEID_UNIT)
+            CreatureRelocation(static_cast<Creature*>(obj), reloc.x, reloc.y, reloc.z, reloc.orientation);
+        else if (obj->GetTypeId() == TYPEID_GAMEOBJECT)
+            GameObjectRelocation(static_cast<GameObject*>(obj), reloc.x, reloc.y, reloc.z, reloc.orientation, reloc.respawnRelocationOnFail);
+    }
+}
+
+void Map::UpdateAndMeasure(uint32 diff)
+{
+    WatchdogFrame frame(WATCHDOG_FRAME_MAP, nullptr, i_id, i_InstanceId);
+    auto start = std::chrono::steady_clock::now();
+    Update(diff);
+    m_updateCost = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    m_updateCostAverage += (float(m_updateCost) - m_updateCostAverage) * MAP_UPDATE_COST_SMOOTHING;
+}
+
+static_assert(ALLOC_TAG_MAP_SEND_UPDATES - ALLOC_TAG_MAP_SESSIONS == MapUpdatePhaseTimes::PHASE_SEND_UPDATES, "map allocation tags follow the update phases");
+
+// adds the time until it goes out of scope to one phase, nothing when the map is not measured
+// the phase is named in slow tick reports and its allocations are tagged either way
+class MapPhaseTimer
+{
+    public:
+        MapPhaseTimer(MapUpdatePhaseTimes* times, MapUpdatePhaseTimes::Phase phase) : m_frame(WATCHDOG_FRAME_PHASE, GetPhaseName(phase)),
+#ifdef BUILD_TRACING
+            m_zone(GetPhaseName(phase)),
+#endif
+            m_times(times), m_phase(phase), m_previousTag(AllocStats::GetThreadTag())
+        {
+            AllocStats::SetThreadTag(AllocTag(ALLOC_TAG_MAP_SESSIONS + phase));
+            if (m_times)
+                m_start = std::chrono::steady_clock::now();
+        }
+        ~MapPhaseTimer() { Stop(); }
+
+        void Stop()
+        {
+            if (m_times)
+                m_times->us[m_phase] += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+            m_times = nullptr;
+            m_frame.Pop();
+#ifdef BUILD_TRACING
+            m_zone.End();
+#endif
+            AllocStats::SetThreadTag(m_previousTag);
+        }
+
+        static char const* GetPhaseName(MapUpdatePhaseTimes::Phase phase)
+        {
+            static char const* phaseNames[MapUpdatePhaseTimes::PHASE_COUNT] = { "sessions", "players", "objects", "relocations", "send updates" };
+            return phaseNames[phase];
+        }
+
+    private:
+        WatchdogFrame m_frame;
+#ifdef BUILD_TRACING
+        TraceZone m_zone;
+#endif
+        MapUpdatePhaseTimes* m_times;
+        MapUpdatePhaseTimes::Phase m_phase;
+        AllocTag m_previousTag;
+        std::chrono::steady_clock::time_point m_start;
+};
+
 void Map::Update(const uint32& t_diff)
 {
+    TRACE_ZONE_ID("Map::Update", i_id);
 
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::milliseconds> meas("map.update", {
-        { "map_id", std::to_string(i_id) },
-        { "instance_id", std::to_string(i_InstanceId) }
-});
+    metric::span<std::chrono::microseconds> meas(m_metrics->update);
 #endif
 
 
+#ifdef BUILD_METRICS
+    if (m_queryCache.IsEnabled() && (m_queryCache.GetHits() || m_queryCache.GetMisses()))
+    {
+        metric::measurement queryMeas("map.query_cache", {
+            { "map_id", std::to_string(i_id) },
+            { "instance_id", std::to_string(i_InstanceId) }
+        });
+        queryMeas.add_field("hits", std::to_string(m_queryCache.GetHits()));
+        queryMeas.add_field("misses", std::to_string(m_queryCache.GetMisses()));
+        m_queryCache.ResetCounters();
+    }
+#endif
+
     uint64 count = 0;
 
     m_dyn_tree.update(t_diff);
 
     GetMessager().Execute(this);
     m_spawnManager.Update();
+    ProcessGameEventSpawnActions();
 
     /// update active cells around players and active objects
     resetMarkedCells();
+    MarkAwakeCells();
 
     WorldObjectUnSet objToUpdate;
     MaNGOS::ObjectUpdater obj_updater(objToUpdate, t_diff);
@@ -696,12 +1152,10 @@ void Map::Update(const uint32& t_diff)
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
     {
+        MapPhaseTimer phaseTimer(m_updatePhaseTimes, MapUpdatePhaseTimes::PHASE_SESSIONS);
 #ifdef BUILD_METRICS
         uint32 updatedSessions = 0;
-        metric::duration<std::chrono::milliseconds> sessions_meas("map.update.session", {
-            { "map_id", std::to_string(i_id) },
-            { "instance_id", std::to_string(i_InstanceId) },
-            });
+        metric::span<std::chrono::microseconds> sessions_meas(m_metrics->sessionUpdate);
 #endif
 
         for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -718,90 +1172,119 @@ void Map::Update(const uint32& t_diff)
 #endif
         }
 #ifdef BUILD_METRICS
-        sessions_meas.add_field("count", std::to_string(static_cast<int32>(updatedSessions)));
+        m_metrics->updatedSessions.add(updatedSessions);
 #endif
     }
 
     /// update players at tick
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
-            plr->Update(t_diff);
+        MapPhaseTimer phaseTimer(m_updatePhaseTimes, MapUpdatePhaseTimes::PHASE_PLAYERS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                ZoneStatsScope zoneStats(ZONE_STATS_PLAYERS, plr);
+                plr->Update(t_diff);
+            }
+        }
     }
 
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+    MapPhaseTimer objectsTimer(m_updatePhaseTimes, MapUpdatePhaseTimes::PHASE_OBJECTS);
+    if (m_cellUpdater)
+        UpdateCellsParallel(t_diff);
+    else
     {
-        Player* player = m_mapRefIter->getSource();
-        if (!player->IsInWorld() || !player->IsPositionValid())
-            continue;
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->getSource();
+            if (!player->IsInWorld() || !player->IsPositionValid())
+                continue;
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-        // If player is using far sight, visit that object too
-        if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
-    }
+            // If player is using far sight, visit that object too
+            if (WorldObject* viewPoint = GetWorldObject(player->GetFarSightGuid()))
+                VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+        }
 
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
-    {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        // non-player active objects
+        if (!m_activeNonPlayers.empty())
         {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
+            for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            {
+                // skip not in world
+                WorldObject* obj = *m_activeNonPlayersIter;
 
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
+                // step before processing, in this case if Map::Remove remove next object we correctly
+                // step to next-next, and if we step to end() then newly added objects can wait next update.
+                ++m_activeNonPlayersIter;
 
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
-                continue;
+                if (!obj->IsInWorld() || !obj->IsPositionValid())
+                    continue;
 
-            objToUpdate.insert(obj);
+                objToUpdate.insert(obj);
 
-            // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+                // lets update mobs/objects in ALL visible cells around player!
+                CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
 
-            for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-            {
-                for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
                 {
-                    // marked cells are those that have been visited
-                    // don't visit the same cell twice
-                    uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                    if (!isCellMarked(cell_id))
+                    for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
                     {
-                        markCell(cell_id);
-                        CellPair pair(x, y);
-                        Cell cell(pair);
-                        cell.SetNoCreate();
-                        Visit(cell, grid_object_update);
-                        Visit(cell, world_object_update);
+                        // marked cells are those that have been visited
+                        // don't visit the same cell twice
+                        uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                        if (!isCellMarked(cell_id))
+                        {
+                            markCell(cell_id);
+                            CellPair pair(x, y);
+                            Cell cell(pair);
+                            cell.SetNoCreate();
+                            Visit(cell, grid_object_update);
+                            Visit(cell, world_object_update);
+                        }
                     }
                 }
             }
         }
-    }
 
-    // update all objects
-    for (auto wObj : objToUpdate)
-    {
-        wObj->Update(t_diff);
-        ++count;
+        // update all objects
+        for (auto wObj : objToUpdate)
+        {
+            ZoneStatsScope zoneStats(ZONE_STATS_OBJECTS, wObj);
+            wObj->Update(t_diff);
+            ++count;
+        }
     }
+    objectsTimer.Stop();
 
 #ifdef BUILD_METRICS
-    meas.add_field("count", std::to_string(static_cast<int32>(count)));
+    m_metrics->updatedObjects.add(count);
 #endif
 
+    {
+        MapPhaseTimer phaseTimer(m_updatePhaseTimes, MapUpdatePhaseTimes::PHASE_RELOCATIONS);
+        ProcessRelocationNotifies();
+    }
+
     // Send world objects and item update field changes
-    SendObjectUpdates();
+    {
+        MapPhaseTimer phaseTimer(m_updatePhaseTimes, MapUpdatePhaseTimes::PHASE_SEND_UPDATES);
+        SendCombatLogs();
+        SendObjectUpdates();
+        FlushMonsterMoves();
+    }
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
     if (!IsBattleGroundOrArena())
     {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "grid states");
+        TRACE_ZONE("grid states");
+        m_gridUnloadStartTime = WorldTimer::getMSTime();
+        m_gridsUnloaded = 0;
+
         for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
         {
             NGridType* grid = i->getSource();
@@ -813,13 +1296,55 @@ void Map::Update(const uint32& t_diff)
     }
 
     ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
+    if (m_scriptScheduleSize)
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "db scripts");
+        TRACE_ZONE("db scripts");
         ScriptsProcess();
+    }
 
     if (i_data)
+    {
+        ScriptProfileScope profile(SCRIPT_PROFILE_INSTANCE_UPDATE, i_script_id, i_id);
         i_data->Update(t_diff);
+        i_data->UpdateSaveToDB(t_diff);
+    }
 
     m_weatherSystem->UpdateWeathers(t_diff);
+
+    if (sWorld.getConfig(CONFIG_BOOL_MAPUPDATE_STATE_SNAPSHOT))
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "state snapshot");
+        TRACE_ZONE("state snapshot");
+        PublishStateSnapshot();
+    }
+}
+
+void Map::PublishStateSnapshot()
+{
+    std::shared_ptr<MapStateSnapshot> snapshot;
+    if (m_stateSnapshotSpare && m_stateSnapshotSpare.use_count() == 1)
+        snapshot.swap(m_stateSnapshotSpare);                // keeps the capacity of two epochs ago
+    else
+        snapshot = std::make_shared<MapStateSnapshot>();
+    m_stateSnapshotSpare.reset();
+
+    snapshot->Reset(++m_stateSnapshotEpoch, WorldTimer::getMSTime());
+
+    for (auto& ref : m_mapRefManager)
+        if (Player* player = ref.getSource())
+            if (player->IsInWorld())
+                snapshot->Add(player);
+
+    // creatures only, pets are not in this store
+    auto& store = GetObjectsStore();
+    for (auto itr = store.begin<Creature>(); itr != store.end<Creature>(); ++itr)
+        snapshot->Add(itr->second);
+
+    snapshot->Finalize(GetTerrain(), m_stateSnapshot.get());
+
+    std::shared_ptr<MapStateSnapshot const> previous = std::atomic_exchange(&m_stateSnapshot, std::shared_ptr<MapStateSnapshot const>(snapshot));
+    m_stateSnapshotSpare = std::const_pointer_cast<MapStateSnapshot>(previous);
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -892,6 +1417,10 @@ void Map::Remove(T* obj, bool remove)
     if (!loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
         return;
 
+    std::unique_lock<std::recursive_mutex> guard(m_parallelCellLock, std::defer_lock);
+    if (m_parallelCellUpdate)
+        guard.lock();
+
     DEBUG_FILTER_LOG(LOG_FILTER_CREATURE_MOVES, "Remove %s from grid[%u,%u]", obj->GetGuidStr().c_str(), cell.data.Part.grid_x, cell.data.Part.grid_y);
     NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
     MANGOS_ASSERT(grid != nullptr);
@@ -920,7 +1449,7 @@ void Map::Remove(T* obj, bool remove)
         delete obj;
 }
 
-void Map::PlayerRelocation(Player* player, float x, float y, float z, float orientation)
+void Map::PlayerRelocation(Player* player, float x, float y, float z, float orientation, bool notify)
 {
     MANGOS_ASSERT(player);
 
@@ -931,8 +1460,14 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     Cell new_cell(new_val);
     bool same_cell = (new_cell == old_cell);
 
+    // flight passengers pass through the grids of their route, creating is enough until they land
+    bool const passThrough = player->IsTaxiFlying() && !sWorld.getConfig(CONFIG_BOOL_TAXI_LOAD_GRIDS);
+
     player->Relocate(x, y, z, orientation);
 
+    if (player->duel)
+        player->duel->moved = true;                         // arbiter distance is checked at the next player update
+
     if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
     {
         DEBUG_FILTER_LOG(LOG_FILTER_PLAYER_MOVES, "Player %s relocation grid[%u,%u]cell[%u,%u]->grid[%u,%u]cell[%u,%u]", player->GetName(), old_cell.GridX(), old_cell.GridY(), old_cell.CellX(), old_cell.CellY(), new_cell.GridX(), new_cell.GridY(), new_cell.CellX(), new_cell.CellY());
@@ -941,6 +1476,11 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         RemoveFromGrid(player, oldGrid, old_cell);
         if (!old_cell.DiffGrid(new_cell))
             AddToGrid(player, oldGrid, new_cell);
+        else if (passThrough)
+        {
+            EnsureGridCreated(GridPair(new_cell.GridX(), new_cell.GridY()));
+            AddToGrid(player, getNGrid(new_cell.GridX(), new_cell.GridY()), new_cell);
+        }
         else
             EnsureGridLoadedAtEnter(new_cell, player);
 
@@ -948,18 +1488,92 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
         player->GetViewPoint().Event_GridChanged(&(*newGrid)(new_cell.CellX(), new_cell.CellY()));
     }
 
-    player->OnRelocated();
+    if (notify)
+        player->OnRelocated();
+
+    if (!same_cell)
+        PrefetchTerrainAhead(player);
 
     NGridType* newGrid = getNGrid(new_cell.GridX(), new_cell.GridY());
-    if (!same_cell && newGrid->GetGridState() != GRID_STATE_ACTIVE)
+    if (!same_cell && !passThrough && newGrid->GetGridState() != GRID_STATE_ACTIVE)
     {
         ResetGridExpiry(*newGrid, 0.1f);
         newGrid->SetGridState(GRID_STATE_ACTIVE);
     }
 }
 
-void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang)
+void Map::ActivateGridAfterTaxiFlight(Player* player)
+{
+    Cell cell(MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY()));
+    bool const gridLoaded = EnsureGridLoaded(cell);
+
+    NGridType* grid = getNGrid(cell.GridX(), cell.GridY());
+    if (grid->GetGridState() != GRID_STATE_ACTIVE)
+    {
+        ResetGridExpiry(*grid, 0.1f);
+        grid->SetGridState(GRID_STATE_ACTIVE);
+    }
+
+    // objects of the freshly loaded grid were not visible to the passenger yet
+    if (gridLoaded)
+        player->OnRelocated();
+}
+
+void Map::PrefetchTerrainAhead(Player* player)
+{
+    uint32 lookAhead = sWorld.getConfig(CONFIG_UINT32_GRID_PREFETCH_TIME);
+    if (!lookAhead)
+        return;
+
+    bool onSpline = player->IsTaxiFlying() && !player->movespline->Finalized();
+    if (!onSpline && !player->IsMovingForward())
+        return;
+
+    float speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : (player->IsWalking() ? MOVE_WALK : MOVE_RUN));
+
+    // sample the predicted path every second, a grid is 533 yards wide so no grid in between gets skipped
+    int lastGx = -1, lastGy = -1;
+    for (uint32 second = 1; second <= lookAhead; ++second)
+    {
+        float x, y;
+        if (onSpline)
+        {
+            G3D::Vector3 pos = player->movespline->ComputePositionAhead(second * IN_MILLISECONDS);
+            x = pos.x;
+            y = pos.y;
+        }
+        else
+        {
+            x = player->GetPositionX() + cos(player->GetOrientation()) * speed * second;
+            y = player->GetPositionY() + sin(player->GetOrientation()) * speed * second;
+        }
+
+        GridPair p = MaNGOS::ComputeGridPair(x, y);
+        if (p.x_coord >= MAX_NUMBER_OF_GRIDS || p.y_coord >= MAX_NUMBER_OF_GRIDS)
+            break;
+
+        int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+        int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+        if (gx == lastGx && gy == lastGy)
+            continue;
+
+        lastGx = gx;
+        lastGy = gy;
+
+        if (!m_bLoadedGrids[gx][gy])
+            sTerrainMgr.PrefetchGrid(m_TerrainData, gx, gy);
+    }
+}
+
+void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool notify)
 {
+    if (m_parallelCellUpdate)
+    {
+        std::lock_guard<std::recursive_mutex> guard(m_parallelCellLock);
+        m_deferredRelocations.push_back({ creature, x, y, z, ang, true });
+        return;
+    }
+
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
 
     // do move or do move to respawn or remove creature if previous all fail
@@ -967,7 +1581,8 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     {
         // update pos
         creature->Relocate(x, y, z, ang);
-        creature->OnRelocated();
+        if (notify)
+            creature->OnRelocated();
     }
     // if creature can't be move in new cell/grid (not loaded) move it to repawn cell/grid
     // creature coordinates will be updated and notifiers send
@@ -978,8 +1593,61 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     }
 }
 
+void Map::ScheduleRelocationNotify(Unit* unit)
+{
+    if (!m_relocationNotifyPending.insert(unit->GetObjectGuid()).second)
+        return;                                             // merged with the waiting update
+
+    bool priority = unit->GetTypeId() == TYPEID_PLAYER || unit->IsInCombat();
+    m_relocationNotifyQueue[priority ? 0 : 1].push_back(unit->GetObjectGuid());
+}
+
+void Map::ProcessRelocationNotifies()
+{
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_RELOCATION_NOTIFY_BUDGET);
+    uint32 processed = 0;
+    for (auto& queue : m_relocationNotifyQueue)
+    {
+        while (!queue.empty() && (!budget || processed < budget))
+        {
+            ObjectGuid guid = queue.front();
+            queue.pop_front();
+            m_relocationNotifyPending.erase(guid);
+
+            // may have left the map meanwhile
+            Unit* unit = GetUnit(guid);
+            if (!unit || !unit->IsInWorld())
+                continue;
+
+            ZoneStatsScope zoneStats(ZONE_STATS_VISIBILITY, unit);
+            unit->NotifyRelocation();
+            ++processed;
+        }
+    }
+
+#ifdef BUILD_METRICS
+    uint32 deferred = uint32(m_relocationNotifyQueue[0].size() + m_relocationNotifyQueue[1].size());
+    if (processed || deferred)
+    {
+        metric::measurement meas("map.relocation_notify", {
+            { "map_id", std::to_string(i_id) },
+            { "instance_id", std::to_string(i_InstanceId) }
+        });
+        meas.add_field("processed", std::to_string(processed));
+        meas.add_field("deferred", std::to_string(deferred));
+    }
+#endif
+}
+
 void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float orientation, bool respawnRelocationOnFail)
 {
+    if (m_parallelCellUpdate)
+    {
+        std::lock_guard<std::recursive_mutex> guard(m_parallelCellLock);
+        m_deferredRelocations.push_back({ go, x, y, z, orientation, respawnRelocationOnFail });
+        return;
+    }
+
     Cell new_cell(MaNGOS::ComputeCellPair(x, y));
     Cell old_cell = go->GetCurrentCell();
 
@@ -1085,6 +1753,7 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
         unloader.UnloadN();
         delete getNGrid(x, y);
         setNGrid(nullptr, x, y);
+        ++m_gridsUnloaded;
     }
 
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
@@ -1096,12 +1765,19 @@ bool Map::UnloadGrid(const uint32& x, const uint32& y, bool pForce)
     {
         m_bLoadedGrids[gx][gy] = false;
         m_TerrainData->Unload(gx, gy);
+        m_queryCache.Clear();
     }
 
     DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "Unloading grid[%u,%u] for map %u finished", x, y, i_id);
     return true;
 }
 
+bool Map::HasGridUnloadBudget() const
+{
+    uint32 budget = sWorld.getConfig(CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET);
+    return !budget || !m_gridsUnloaded || WorldTimer::getMSTimeDiff(m_gridUnloadStartTime, WorldTimer::getMSTime()) < budget;
+}
+
 void Map::UnloadAll(bool pForce)
 {
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
@@ -1130,6 +1806,26 @@ const char* Map::GetMapName() const
     return i_mapEntry ? i_mapEntry->name[sWorld.GetDefaultDbcLocale()] : "UNNAMEDMAP\x0";
 }
 
+void Map::UpdateVisibilityOfLoadedGrid(uint32 gridX, uint32 gridY)
+{
+    uint32 const lowX = gridX * MAX_NUMBER_OF_CELLS, highX = lowX + MAX_NUMBER_OF_CELLS - 1;
+    uint32 const lowY = gridY * MAX_NUMBER_OF_CELLS, highY = lowY + MAX_NUMBER_OF_CELLS - 1;
+
+    for (auto& ref : m_mapRefManager)
+    {
+        Player* player = ref.getSource();
+        if (!player->IsInWorld())                           // players still entering the map see the grid at their first update
+            continue;
+
+        WorldObject const* body = player->GetCamera().GetBody();
+        CellArea area = Cell::CalculateCellArea(body->GetPositionX(), body->GetPositionY(), body->GetVisibilityData().GetVisibilityDistance());
+        if (area.high_bound.x_coord < lowX || area.low_bound.x_coord > highX || area.high_bound.y_coord < lowY || area.low_bound.y_coord > highY)
+            continue;
+
+        player->GetCamera().UpdateVisibilityForOwner();
+    }
+}
+
 void Map::UpdateObjectVisibility(WorldObject* obj, Cell cell, const CellPair& cellpair)
 {
     cell.SetNoCreate();
@@ -1256,6 +1952,10 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete();                            // remove or simplify at least cross referenced links
 
+    std::unique_lock<std::recursive_mutex> guard(m_parallelCellLock, std::defer_lock);
+    if (m_parallelCellUpdate)
+        guard.lock();
+
     i_objectsToRemove.insert(obj);
     // DEBUG_LOG("Object (GUID: %u TypeId: %u ) added to removing list.",obj->GetGUIDLow(),obj->GetTypeId());
 }
@@ -1329,6 +2029,14 @@ bool Map::SendToPlayersInZone(WorldPacket const& data, uint32 zoneId) const
     return foundPlayer;
 }
 
+bool Map::HasPlayersInZone(uint32 zoneId) const
+{
+    for (const auto& itr : m_mapRefManager)
+        if (itr.getSource()->GetCachedZoneId() == zoneId)
+            return true;
+    return false;
+}
+
 bool Map::ActiveObjectsNearGrid(uint32 x, uint32 y) const
 {
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
@@ -1942,15 +2650,12 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
 
     if (execParams)                                         // Check if the execution should be uniquely
     {
-        for (ScriptScheduleMap::const_iterator searchItr = m_scriptSchedule.begin(); searchItr != m_scriptSchedule.end(); ++searchItr)
+        if (HasScheduledScript(scripts.first, id,
+                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
+                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
         {
-            if (searchItr->second.IsSameScript(scripts.first, id,
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_SOURCE ? sourceGuid : ObjectGuid(),
-                                               execParams & SCRIPT_EXEC_PARAM_UNIQUE_BY_TARGET ? targetGuid : ObjectGuid(), ownerGuid))
-            {
-                DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scripts.first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
-                return true;
-            }
+            DETAIL_FILTER_LOG(LOG_FILTER_DB_SCRIPT, "DB-SCRIPTS: Process table `%s` id %u. Skip script as script already started for source %s, target %s - ScriptsStartParams %u", scripts.first, id, sourceGuid.GetString().c_str(), targetGuid.GetString().c_str(), execParams);
+            return true;
         }
     }
 
@@ -1973,15 +2678,18 @@ bool Map::ScriptsStart(ScriptMapMapName const& scripts, uint32 id, Object* sourc
         ++scriptInfoItr;
     }
 
-    // add delayed script to script scheduler
-    for (; scriptInfoItr != scriptMap.end(); ++scriptInfoItr)
+    // add delayed script to script scheduler, the shared counter is updated once for the whole script
+    uint32 scheduled = 0;
+    for (; scriptInfoItr != scriptMap.end(); ++scriptInfoItr, ++scheduled)
     {
         auto const& scriptInfo = scriptInfoItr->second;
         ScriptAction sa(scripts.first, this, sourceGuid, targetGuid, ownerGuid, &scriptInfo);
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(scriptInfoItr->first), sa);
-        sScriptMgr.IncreaseScheduledScriptsCount();
+        ScheduleScriptAction(GetCurrentClockTime() + std::chrono::milliseconds(scriptInfoItr->first), sa);
     }
 
+    if (scheduled)
+        sScriptMgr.IncreaseScheduledScriptsCount(scheduled);
+
     return true;
 }
 
@@ -1998,52 +2706,123 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
 
     if (delay)
     {
-        m_scriptSchedule.emplace(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
+        ScheduleScriptAction(GetCurrentClockTime() + std::chrono::milliseconds(delay), sa);
         sScriptMgr.IncreaseScheduledScriptsCount();
     }
     else
         sa.HandleScriptStep();
 }
 
+void Map::ScheduleScriptAction(TimePoint due, ScriptAction const& action)
+{
+    if (m_scriptSchedule.empty())
+        m_scriptSchedule.resize(SCRIPT_SCHEDULE_SLOTS);
+
+    // an empty wheel may be far behind, restart it at the current time
+    if (!m_scriptScheduleSize)
+        m_scriptScheduleTime = GetCurrentClockTime();
+
+    m_scriptSchedule[due.time_since_epoch().count() & (SCRIPT_SCHEDULE_SLOTS - 1)].emplace_back(due, action);
+    ++m_scriptScheduleSize;
+}
+
+bool Map::HasScheduledScript(const char* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const
+{
+    if (!m_scriptScheduleSize)
+        return false;
+
+    for (ScriptScheduleSlot const& slot : m_scriptSchedule)
+        for (ScheduledScriptAction const& scheduled : slot)
+            if (scheduled.action.IsSameScript(table, id, sourceGuid, targetGuid, ownerGuid))
+                return true;
+
+    return false;
+}
+
+uint32 Map::RemoveScheduledScript(const char* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid)
+{
+    uint32 removed = 0;
+    for (ScriptScheduleSlot& slot : m_scriptSchedule)
+    {
+        auto newEnd = std::remove_if(slot.begin(), slot.end(), [&](ScheduledScriptAction const& scheduled)
+        {
+            return scheduled.action.IsSameScript(table, id, sourceGuid, targetGuid, ownerGuid);
+        });
+        removed += uint32(slot.end() - newEnd);
+        slot.erase(newEnd, slot.end());
+    }
+
+    m_scriptScheduleSize -= removed;
+    return removed;
+}
+
 /// Process queued scripts
 void Map::ScriptsProcess()
 {
-    if (m_scriptSchedule.empty())
+    if (!m_scriptScheduleSize)
         return;
 
-    ///- Process overdue queued scripts
-    ScriptScheduleMap::iterator iter = m_scriptSchedule.begin();
-    // ok as multimap is a *sorted* associative container
-    while (!m_scriptSchedule.empty() && (iter->first <= GetCurrentClockTime()))
+    TimePoint now = GetCurrentClockTime();
+    uint32 processed = 0;
+    std::vector<ScheduledScriptAction> ready;
+
+    while (m_scriptScheduleSize && m_scriptScheduleTime <= now)
     {
-        if (iter->second.HandleScriptStep())
-        {
-            // Terminate following script steps of this script
-            const char* tableName = iter->second.GetTableName();
-            uint32 id = iter->second.GetId();
-            ObjectGuid sourceGuid = iter->second.GetSourceGuid();
-            ObjectGuid targetGuid = iter->second.GetTargetGuid();
-            ObjectGuid ownerGuid = iter->second.GetOwnerGuid();
+        ready.clear();
 
-            for (ScriptScheduleMap::iterator rmItr = m_scriptSchedule.begin(); rmItr != m_scriptSchedule.end();)
+        // after a gap longer than a turn every slot is due at least once, take all overdue steps at once in due order
+        if (now - m_scriptScheduleTime >= std::chrono::milliseconds(SCRIPT_SCHEDULE_SLOTS))
+        {
+            for (ScriptScheduleSlot& slot : m_scriptSchedule)
             {
-                if (rmItr->second.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid))
-                {
-                    m_scriptSchedule.erase(rmItr++);
-                    sScriptMgr.DecreaseScheduledScriptCount();
-                }
-                else
-                    ++rmItr;
+                auto newEnd = std::stable_partition(slot.begin(), slot.end(), [now](ScheduledScriptAction const& scheduled) { return scheduled.due > now; });
+                std::move(newEnd, slot.end(), std::back_inserter(ready));
+                slot.erase(newEnd, slot.end());
             }
+            std::stable_sort(ready.begin(), ready.end(), [](ScheduledScriptAction const& a, ScheduledScriptAction const& b) { return a.due < b.due; });
+            m_scriptScheduleTime = now + std::chrono::milliseconds(1);
         }
         else
         {
-            m_scriptSchedule.erase(iter);
+            // steps of later turns share the slot and stay in it
+            ScriptScheduleSlot& slot = m_scriptSchedule[m_scriptScheduleTime.time_since_epoch().count() & (SCRIPT_SCHEDULE_SLOTS - 1)];
+            if (!slot.empty())
+            {
+                TimePoint slotTime = m_scriptScheduleTime;
+                auto newEnd = std::stable_partition(slot.begin(), slot.end(), [slotTime](ScheduledScriptAction const& scheduled) { return scheduled.due > slotTime; });
+                std::move(newEnd, slot.end(), std::back_inserter(ready));
+                slot.erase(newEnd, slot.end());
+            }
+            m_scriptScheduleTime += std::chrono::milliseconds(1);
+        }
 
-            sScriptMgr.DecreaseScheduledScriptCount();
+        m_scriptScheduleSize -= uint32(ready.size());
+        processed += uint32(ready.size());
+
+        // steps scheduled while handling these are due later, so they never land in the batch
+        for (size_t i = 0; i < ready.size(); ++i)
+        {
+            ScriptAction& action = ready[i].action;
+            if (!action.HandleScriptStep())
+                continue;
+
+            // Terminate following script steps of this script
+            const char* tableName = action.GetTableName();
+            uint32 id = action.GetId();
+            ObjectGuid sourceGuid = action.GetSourceGuid();
+            ObjectGuid targetGuid = action.GetTargetGuid();
+            ObjectGuid ownerGuid = action.GetOwnerGuid();
+
+            processed += RemoveScheduledScript(tableName, id, sourceGuid, targetGuid, ownerGuid);
+            ready.erase(std::remove_if(ready.begin() + i + 1, ready.end(), [&](ScheduledScriptAction const& scheduled)
+            {
+                return scheduled.action.IsSameScript(tableName, id, sourceGuid, targetGuid, ownerGuid);
+            }), ready.end());
         }
-        iter = m_scriptSchedule.begin();
     }
+
+    if (processed)
+        sScriptMgr.DecreaseScheduledScriptCount(processed);
 }
 
 /**
@@ -2176,23 +2955,60 @@ void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
+    // objects marked while building are picked up by the same loop
     while (!i_objectsToClientUpdate.empty())
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
+        Object* obj = i_objectsToClientUpdate.back();
+        i_objectsToClientUpdate.pop_back();
+        obj->SetClientUpdateListIndex(CLIENT_UPDATE_LIST_NONE);
         obj->BuildUpdateData(update_players);
     }
 
+    // packet assembly and compression per player are independent, spread them over the cell updater
+    if (m_cellUpdater && update_players.size() >= MAP_PARALLEL_PACKET_MIN_PLAYERS)
+    {
+        std::vector<PlayerUpdatePackets> updatePackets;
+        updatePackets.reserve(update_players.size());
+        for (auto& update_player : update_players)
+            updatePackets.push_back({ update_player.first, &update_player.second, {} });
+
+        size_t const threads = sWorld.getConfig(CONFIG_UINT32_NUM_MAP_CELL_THREADS);
+        size_t const batchCount = std::min(threads, updatePackets.size());
+        size_t const batchSize = (updatePackets.size() + batchCount - 1) / batchCount;
+        for (size_t i = 0; i < batchCount; ++i)
+        {
+            auto first = updatePackets.begin() + std::min(i * batchSize, updatePackets.size());
+            auto last = updatePackets.begin() + std::min((i + 1) * batchSize, updatePackets.size());
+            if (first != last)
+                m_cellUpdater->schedule_update(new UpdatePacketBuilder(first, last, *m_cellUpdater));
+        }
+        m_cellUpdater->wait();
+
+        // sessions are only touched from the map thread, each player still gets its packets in build order
+        for (auto& playerPackets : updatePackets)
+            for (auto& packet : playerPackets.packets)
+                playerPackets.player->GetSession()->SendPacket(std::move(packet));
+        return;
+    }
+
     for (auto& update_player : update_players)
     {
         for (size_t i = 0; i < update_player.second.GetPacketCount(); ++i)
         {
             WorldPacket packet = update_player.second.BuildPacket(i);
-            update_player.first->GetSession()->SendPacket(packet);
+            update_player.first->GetSession()->SendPacket(std::move(packet));
         }
     }
 }
 
+// monster moves collected by Network.BatchMonsterMoves leave after the update packets of the same tick,
+// not skipped when the option is off so nothing stays held after a config reload
+void Map::FlushMonsterMoves()
+{
+    for (auto& ref : m_mapRefManager)
+        ref.getSource()->GetSession()->FlushMonsterMoves();
+}
+
 Creature* Map::GetCreature(uint32 dbguid)
 {
     auto itr = m_dbGuidObjects.find(std::make_pair(HIGHGUID_UNIT, dbguid));
@@ -2357,8 +3173,38 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, bool ignoreM2Model) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model);
+    if (!m_queryCache.IsEnabled())
+        return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model)
+               && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model);
+
+    uint32 generation = m_dynTreeGeneration;
+    MapQueryCache::Result result;
+    if (m_queryCache.FindLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model, result))
+    {
+        if (result.dynGeneration == generation)
+            return result.value != 0.f;
+    }
+    else
+        result.staticValue = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model) ? 1.f : 0.f;
+
+    // only the static result is still valid after gameobject models changed
+    bool inLoS = result.staticValue != 0.f && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model);
+    result.value = inLoS ? 1.f : 0.f;
+    result.dynGeneration = generation;
+    m_queryCache.StoreLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, ignoreM2Model, result);
+    return inLoS;
+}
+
+uint64 Map::GetLineOfSightMask(float srcX, float srcY, float srcZ, G3D::Vector3 const* targets, uint32 count, bool ignoreM2Model) const
+{
+    uint64 visible = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), G3D::Vector3(srcX, srcY, srcZ), targets, count, ignoreM2Model);
+
+    // few gameobjects have collision, only the rays the static tree let through are tested
+    for (uint32 i = 0; i < count; ++i)
+        if ((visible & (uint64(1) << i)) && !m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, targets[i].x, targets[i].y, targets[i].z, ignoreM2Model))
+            visible &= ~(uint64(1) << i);
+
+    return visible;
 }
 
 /**
@@ -2447,21 +3293,37 @@ bool Map::GetHeightInRange(float x, float y, float& z, float maxSearchDist /*= 4
 
 float Map::GetHeight(float x, float y, float z, bool swim) const
 {
-    float staticHeight = m_TerrainData->GetHeightStatic(x, y, z, true, (swim ? DEFAULT_WATER_SEARCH : DEFAULT_HEIGHT_SEARCH));
+    uint32 generation = m_dynTreeGeneration;
+    MapQueryCache::Result result;
+    bool cached = false;
+    if (m_queryCache.IsEnabled() && m_queryCache.FindHeight(x, y, z, swim, result))
+    {
+        if (result.dynGeneration == generation)
+            return result.value;
+        cached = true;
+    }
+
+    float staticHeight = cached ? result.staticValue : m_TerrainData->GetHeightStatic(x, y, z, true, (swim ? DEFAULT_WATER_SEARCH : DEFAULT_HEIGHT_SEARCH));
 
     // Get Dynamic Height around static Height (if valid)
     float dynSearchHeight = 2.0f + (z < staticHeight ? staticHeight : z);
-    return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight));
+    float height = std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight));
+
+    if (m_queryCache.IsEnabled())
+        m_queryCache.StoreHeight(x, y, z, swim, { staticHeight, height, generation });
+    return height;
 }
 
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    DynamicTreeChanged();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    DynamicTreeChanged();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
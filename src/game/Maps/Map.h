@@ -34,6 +34,9 @@
 #include "DBScripts/ScriptMgr.h"
 #include "Entities/CreatureLinkingMgr.h"
 #include "vmap/DynamicTree.h"
+#include "MotionGenerators/PathCorridorCache.h"
+#include "Maps/MapQueryCache.h"
+#include "Maps/MapStateSnapshot.h"
 #include "Multithreading/Messager.h"
 #include "Globals/GraveyardManager.h"
 #include "Maps/SpawnManager.h"
@@ -41,8 +44,11 @@
 #include "World/WorldStateVariableManager.h"
 
 #include <bitset>
+#include <deque>
 #include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 
 struct CreatureInfo;
 class Creature;
@@ -62,6 +68,8 @@ class WeatherSystem;
 class GenericTransport;
 namespace MaNGOS { struct ObjectUpdater; }
 class Transport;
+class MapUpdater;
+struct MapMetrics;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -113,9 +121,31 @@ struct ZoneDynamicInfo
 #endif
 
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
+#define MAP_UPDATE_COST_SMOOTHING 0.2f                      // weight of the newest sample in the map update cost moving average
+#define MAP_PARALLEL_PACKET_MIN_PLAYERS 8                   // below this many receivers client packets are built on the map thread
+#define SCRIPT_SCHEDULE_SLOTS 1024                          // one slot per millisecond of the db script timing wheel, must be a power of 2
 
 typedef std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo> ZoneDynamicInfoMap;
 
+/// Time spent in the parts of Map::Update, summed up while set with Map::SetUpdatePhaseTimes
+struct MapUpdatePhaseTimes
+{
+    enum Phase
+    {
+        PHASE_SESSIONS,
+        PHASE_PLAYERS,
+        PHASE_OBJECTS,
+        PHASE_RELOCATIONS,
+        PHASE_SEND_UPDATES,
+        PHASE_COUNT
+    };
+
+    MapUpdatePhaseTimes() { Reset(); }
+    void Reset() { std::fill(std::begin(us), std::end(us), 0); }
+
+    uint64 us[PHASE_COUNT];
+};
+
 class Map : public GridRefManager<NGridType>
 {
         friend class MapReference;
@@ -149,6 +179,23 @@ class Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(const uint32&);
 
+        // calls Update and stores how long it took, used to schedule costly maps first
+        void UpdateAndMeasure(uint32 diff);
+        float GetUpdateCost() const { return m_updateCostAverage; } // moving average, in microseconds
+        uint32 GetLastUpdateCost() const { return m_updateCost; }   // in microseconds
+
+        // map update thread the map sticks to, see MapUpdate.StickyMaps
+        int32 GetHomeThread() const { return m_homeThread; }
+        void SetHomeThread(int32 thread) { m_homeThread = thread; }
+
+        // units as of the end of the last update, safe to read from any thread (see MapUpdate.StateSnapshot)
+        // nullptr while disabled or before the first update
+        std::shared_ptr<MapStateSnapshot const> GetStateSnapshot() const { return std::atomic_load(&m_stateSnapshot); }
+
+        // parallel cell update, only enabled for continents (see MapUpdate.CellThreads)
+        bool IsInParallelCellUpdate() const { return m_parallelCellUpdate; }
+        std::recursive_mutex& GetParallelCellLock() { return m_parallelCellLock; }
+
         void MessageBroadcast(Player const*, WorldPacket const&, bool to_self);
         void MessageBroadcast(WorldObject const*, WorldPacket const&);
         void MessageDistBroadcast(Player const*, WorldPacket const&, float dist, bool to_self, bool own_team_only = false);
@@ -156,6 +203,8 @@ class Map : public GridRefManager<NGridType>
         void MessageMapBroadcast(WorldObject const* obj, WorldPacket const& msg);
         void MessageMapBroadcastZone(WorldObject const* obj, WorldPacket const& msg, uint32 zoneId);
         void MessageMapBroadcastArea(WorldObject const* obj, WorldPacket const& msg, uint32 areaId);
+        // combat log of source held per receiving player until the end of the update, see Network.AggregateCombatLog
+        void QueueCombatLog(WorldObject const* source, WorldPacket&& msg);
 
         void ExecuteDistWorker(WorldObject const* obj, float dist, std::function<void(Player*)> const& worker);
         void ExecuteMapWorker(std::function<void(Player*)> const& worker);
@@ -166,11 +215,18 @@ class Map : public GridRefManager<NGridType>
         // function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
 
-        void PlayerRelocation(Player*, float x, float y, float z, float orientation);
-        void CreatureRelocation(Creature* creature, float x, float y, float z, float ang);
+        // notify false leaves the visibility update to the caller (transport passengers)
+        void PlayerRelocation(Player*, float x, float y, float z, float orientation, bool notify = true);
+        // loads and activates the grid a flight ended in, passengers only create grids while TaxiFlight.LoadGrids is off
+        void ActivateGridAfterTaxiFlight(Player* player);
+        void CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool notify = true);
+        // queue visibility updates of a moved unit, see ProcessRelocationNotifies
+        void ScheduleRelocationNotify(Unit* unit);
         void GameObjectRelocation(GameObject* go, float x, float y, float z, float orientation, bool respawnRelocationOnFail = true);
 
         template<class T, class CONTAINER> void Visit(const Cell& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
+        // nullptr while the grid of the cell is not loaded
+        CellPositionIndex const* GetCellPositionIndex(const Cell& cell) const;
 
         bool IsRemovalGrid(float x, float y) const
         {
@@ -187,8 +243,12 @@ class Map : public GridRefManager<NGridType>
         bool GetUnloadLock(const GridPair& p) const { return getNGrid(p.x_coord, p.y_coord)->getUnloadLock(); }
         void SetUnloadLock(const GridPair& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadExplicitLock(on); }
         void ForceLoadGrid(float x, float y);
+        // reads the terrain of many grids in parallel ahead of loading them one by one
+        void PreloadTerrain(std::vector<GridPair> const& grids);
         bool UnloadGrid(const uint32& x, const uint32& y, bool pForce);
         virtual void UnloadAll(bool pForce);
+        // expired grids are unloaded while this update is within GridUnloadTimeBudget, at least one per update
+        bool HasGridUnloadBudget() const;
 
         void ResetGridExpiry(NGridType& grid, float factor = 1) const
         {
@@ -236,11 +296,17 @@ class Map : public GridRefManager<NGridType>
         void AddObjectToRemoveList(WorldObject* obj);
 
         void UpdateObjectVisibility(WorldObject* obj, Cell cell, const CellPair& cellpair);
+        // one visibility update per player that can see into a just loaded grid instead of one per spawn
+        void UpdateVisibilityOfLoadedGrid(uint32 gridX, uint32 gridY);
 
         void resetMarkedCells() { marked_cells.reset(); }
         bool isCellMarked(uint32 pCellId) const { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // idle objects standing outside every awake or full detail cell may skip updates, see Creature::CanDeferUpdate
+        bool IsHibernationArea(float x, float y) const { return m_hibernation && !IsCellIn(m_awakeCells, x, y); }
+        bool IsLowDetailArea(float x, float y) const { return m_lowDetail && !IsCellIn(m_fullDetailCells, x, y); }
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(uint32 x, uint32 y) const;
@@ -249,6 +315,7 @@ class Map : public GridRefManager<NGridType>
         void SendToPlayers(WorldPacket const& data) const;
         /// Send a Packet to all players in a zone. Return false if no player found
         bool SendToPlayersInZone(WorldPacket const& data, uint32 zoneId) const;
+        bool HasPlayersInZone(uint32 zoneId) const;
 
         typedef MapRefManager PlayerList;
         PlayerList const& GetPlayers() const { return m_mapRefManager; }
@@ -300,12 +367,33 @@ class Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            std::unique_lock<std::recursive_mutex> guard(m_parallelCellLock, std::defer_lock);
+            if (m_parallelCellUpdate)
+                guard.lock();
+
+            if (IsInClientUpdateList(obj))
+                return;
+
+            obj->SetClientUpdateListIndex(uint32(i_objectsToClientUpdate.size()));
+            i_objectsToClientUpdate.push_back(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            std::unique_lock<std::recursive_mutex> guard(m_parallelCellLock, std::defer_lock);
+            if (m_parallelCellUpdate)
+                guard.lock();
+
+            if (!IsInClientUpdateList(obj))
+                return;
+
+            // swap with last element, order of the list is not relevant
+            uint32 index = obj->GetClientUpdateListIndex();
+            Object* last = i_objectsToClientUpdate.back();
+            i_objectsToClientUpdate[index] = last;
+            last->SetClientUpdateListIndex(index);
+            i_objectsToClientUpdate.pop_back();
+            obj->SetClientUpdateListIndex(CLIENT_UPDATE_LIST_NONE);
         }
 
         // DynObjects currently
@@ -326,12 +414,18 @@ class Map : public GridRefManager<NGridType>
         float GetHeight(float x, float y, float z, bool swim = false) const;
         bool GetHeightInRange(float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) const;
+        // AoE target checks: bit i set when targets[i] is in line of sight of the source, at most 64 targets
+        uint64 GetLineOfSightMask(float srcX, float srcY, float srcZ, G3D::Vector3 const* targets, uint32 count, bool ignoreM2Model) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, float modifyDist) const;
 
         // Object Model insertion/remove/test for dynamic vmaps use
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        // a gameobject model was moved or toggled, cached line of sight and height results need the dynamic tree again
+        void DynamicTreeChanged() { ++m_dynTreeGeneration; }
+
+        PathCorridorCache& GetPathCorridorCache() { return m_pathCorridorCache; }
 
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
@@ -374,6 +468,9 @@ class Map : public GridRefManager<NGridType>
 
         Messager<Map>& GetMessager() { return m_messager; }
 
+        /// Used by mangos-bench, nullptr stops the measurement
+        void SetUpdatePhaseTimes(MapUpdatePhaseTimes* times) { m_updatePhaseTimes = times; }
+
         typedef std::set<Transport*> TransportSet;
         GenericTransport* GetTransport(ObjectGuid guid);
         TransportSet const& GetTransports() { return m_transports; }
@@ -387,6 +484,9 @@ class Map : public GridRefManager<NGridType>
 
         SpawnManager& GetSpawnManager() { return m_spawnManager; }
 
+        // spawn or remove a game event object in loaded grids at a later update, see Event.SpawnBudget
+        void AddGameEventSpawnAction(uint32 dbGuid, HighGuid high, bool spawn);
+
         MapDataContainer& GetMapDataContainer() { return m_dataContainer; }
         MapDataContainer const& GetMapDataContainer() const { return m_dataContainer; }
         WorldStateVariableManager& GetVariableManager() { return m_variableManager; }
@@ -397,6 +497,7 @@ class Map : public GridRefManager<NGridType>
 
     private:
         void LoadMapAndVMap(int gx, int gy);
+        void PrefetchTerrainAhead(Player* player);
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -427,9 +528,41 @@ class Map : public GridRefManager<NGridType>
 
         void setNGrid(NGridType* grid, uint32 x, uint32 y);
         void ScriptsProcess();
+        void ScheduleScriptAction(TimePoint due, ScriptAction const& action);
+        bool HasScheduledScript(const char* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid) const;
+        uint32 RemoveScheduledScript(const char* table, uint32 id, ObjectGuid sourceGuid, ObjectGuid targetGuid, ObjectGuid ownerGuid);
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        void FlushMonsterMoves();
+        void SendCombatLogs();
+        void ProcessRelocationNotifies();
+        bool IsInClientUpdateList(Object const* obj) const
+        {
+            uint32 index = obj->GetClientUpdateListIndex();
+            return index < i_objectsToClientUpdate.size() && i_objectsToClientUpdate[index] == obj;
+        }
+        std::vector<Object*> i_objectsToClientUpdate;
+
+        void CollectNearbyCellsOf(WorldObject* obj, float radius);
+        typedef std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> CellMarks;
+
+        void MarkAwakeCells();
+        void MarkAwakeCells(CellMarks& cells, float radius);
+        static void MarkCellsOf(CellMarks& cells, WorldObject const* obj, float radius);
+        static bool IsCellIn(CellMarks const& cells, float x, float y)
+        {
+            CellPair p = MaNGOS::ComputeCellPair(x, y);
+            return cells.test(p.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP + p.x_coord);
+        }
+        void UpdateCellsParallel(uint32 diff);
+        void ApplyDeferredRelocations();
+
+        struct DeferredRelocation
+        {
+            WorldObject* object;
+            float x, y, z, orientation;
+            bool respawnRelocationOnFail;
+        };
 
     protected:
         MapEntry const* i_mapEntry;
@@ -467,11 +600,28 @@ class Map : public GridRefManager<NGridType>
         bool m_bLoadedGrids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
 
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        CellMarks m_awakeCells;
+        CellMarks m_fullDetailCells;
+        bool m_hibernation;
+        uint32 m_gridUnloadStartTime;                       // of the grid state pass of the current update
+        uint32 m_gridsUnloaded;                             // by that pass
+        uint32 m_bulkSpawnDepth;                            // grid loads in progress, nested when spawns load more grids
+        bool m_lowDetail;
 
         WorldObjectSet i_objectsToRemove;
 
-        typedef std::multimap<TimePoint, ScriptAction> ScriptScheduleMap;
-        ScriptScheduleMap m_scriptSchedule;
+        // Delayed db script steps hashed by their due millisecond, steps of one slot are kept in scheduling order
+        struct ScheduledScriptAction
+        {
+            ScheduledScriptAction(TimePoint _due, ScriptAction const& _action) : due(_due), action(_action) {}
+
+            TimePoint due;
+            ScriptAction action;
+        };
+        typedef std::vector<ScheduledScriptAction> ScriptScheduleSlot;
+        std::vector<ScriptScheduleSlot> m_scriptSchedule;   // SCRIPT_SCHEDULE_SLOTS slots, allocated on first use
+        TimePoint m_scriptScheduleTime;                     // next millisecond processed by the wheel
+        uint32 m_scriptScheduleSize;
 
         InstanceData* i_data;
         uint32 i_script_id;
@@ -495,6 +645,17 @@ class Map : public GridRefManager<NGridType>
         // Dynamic Map tree object
         DynamicMapTree m_dyn_tree;
 
+        // navmesh corridors shared between path searches, see PathFinder::BuildPolyPath
+        PathCorridorCache m_pathCorridorCache;
+
+        // moved units waiting for their visibility update, players and units in combat first
+        GuidSet m_relocationNotifyPending;
+        std::deque<ObjectGuid> m_relocationNotifyQueue[2];
+
+        // line of sight and height results, see IsInLineOfSight and GetHeight
+        mutable MapQueryCache m_queryCache;
+        std::atomic<uint32> m_dynTreeGeneration;
+
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
@@ -507,6 +668,19 @@ class Map : public GridRefManager<NGridType>
         // spawning
         SpawnManager m_spawnManager;
 
+        struct GameEventSpawnAction
+        {
+            uint32 dbGuid;
+            HighGuid high;
+            bool spawn;
+        };
+
+        void ProcessGameEventSpawnActions();
+        void ApplyGameEventSpawnAction(GameEventSpawnAction const& action);
+
+        std::deque<GameEventSpawnAction> m_gameEventSpawnActions;  // filled by the world thread, applied in map update order
+        std::mutex m_gameEventSpawnActionsLock;
+
         MapDataContainer m_dataContainer;
         std::shared_ptr<CreatureSpellListContainer> m_spellListContainer;
 
@@ -515,6 +689,33 @@ class Map : public GridRefManager<NGridType>
         ZoneDynamicInfoMap m_zoneDynamicInfo;
         ZoneDynamicInfoMap m_areaDynamicInfo;
         uint32 m_defaultLight;
+
+        uint32 m_updateCost;
+        float m_updateCostAverage;
+        MapUpdatePhaseTimes* m_updatePhaseTimes;
+        int32 m_homeThread;
+
+        // published snapshot and the one before it, reused once no reader holds it anymore
+        void PublishStateSnapshot();
+        std::shared_ptr<MapStateSnapshot const> m_stateSnapshot;
+        std::shared_ptr<MapStateSnapshot> m_stateSnapshotSpare;
+        uint64 m_stateSnapshotEpoch;
+
+#ifdef BUILD_METRICS
+        std::unique_ptr<MapMetrics> m_metrics;
+#endif
+
+        // parallel cell update
+        std::unique_ptr<MapUpdater> m_cellUpdater;
+        std::vector<Cell> m_cellsToUpdate[4];               // indexed by cell x/y parity, cells of same parity are never adjacent
+        std::vector<std::vector<Cell>> m_cellBatches;
+        std::vector<DeferredRelocation> m_deferredRelocations;
+        std::recursive_mutex m_parallelCellLock;
+        bool m_parallelCellUpdate;
+
+        // logs shared by all their receivers, filled from the cell update threads too
+        std::mutex m_combatLogLock;
+        std::unordered_map<ObjectGuid, std::vector<std::shared_ptr<WorldPacket const>>> m_pendingCombatLogs;
 };
 
 class WorldMap : public Map
@@ -27,14 +27,22 @@
 #include "Grids/CellImpl.h"
 #include "Globals/ObjectMgr.h"
 #include "Maps/MapWorkers.h"
+#include "Config/Config.h"
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
 #include <future>
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, std::recursive_mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
 INSTANTIATE_CLASS_MUTEX(MapManager, std::recursive_mutex);
 
+// sticky maps are only moved when the busiest thread costs this much more than the idlest one
+#define MAP_HOME_REBALANCE_SKEW     1.25f
+#define MAP_HOME_REBALANCE_MIN_GAP  2000.0f                 // microseconds
+
 MapManager::MapManager()
-    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN))
+    : i_gridCleanUpDelay(sWorld.getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN)), m_updating(false)
 {
     i_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
 }
@@ -55,7 +63,10 @@ void MapManager::Initialize()
 
     int num_threads(sWorld.getConfig(CONFIG_UINT32_NUM_MAP_THREADS));
     if (num_threads > 0)
+    {
+        m_updater.set_affinity(std::strtoull(sConfig.GetStringDefault("MapUpdate.Affinity", "0").c_str(), nullptr, 0));
         m_updater.activate(num_threads);
+    }
 }
 
 void MapManager::InitStateMachine()
@@ -187,20 +198,141 @@ void MapManager::DeleteInstance(uint32 mapid, uint32 instanceId)
     }
 }
 
-void MapManager::Update(uint32 diff)
+std::vector<Map*> MapManager::GetMapsByUpdateCost() const
+{
+    std::vector<Map*> maps;
+    maps.reserve(i_maps.size());
+    for (auto& map : i_maps)
+        maps.push_back(map.second);
+
+    std::stable_sort(maps.begin(), maps.end(), [](Map const* left, Map const* right)
+    {
+        return left->GetUpdateCost() > right->GetUpdateCost();
+    });
+
+    return maps;
+}
+
+void MapManager::AssignHomeThreads()
+{
+    size_t threads = m_updater.thread_count();
+    std::vector<float> load(threads, 0.0f);
+    std::vector<uint32> count(threads, 0);
+
+    for (Map* map : m_updateOrder)
+    {
+        if (map->GetHomeThread() < 0 || size_t(map->GetHomeThread()) >= threads)
+            continue;
+
+        load[map->GetHomeThread()] += map->GetUpdateCost();
+        ++count[map->GetHomeThread()];
+    }
+
+    // m_updateOrder is most expensive first, new maps go to the least loaded thread
+    auto idlest = [&]()
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < threads; ++i)
+            if (load[i] < load[best] || (load[i] == load[best] && count[i] < count[best]))
+                best = i;
+        return best;
+    };
+
+    for (Map* map : m_updateOrder)
+    {
+        if (map->GetHomeThread() >= 0 && size_t(map->GetHomeThread()) < threads)
+            continue;
+
+        size_t thread = idlest();
+        map->SetHomeThread(int32(thread));
+        load[thread] += map->GetUpdateCost();
+        ++count[thread];
+    }
+
+    size_t busiest = std::max_element(load.begin(), load.end()) - load.begin();
+    size_t target = idlest();
+    float gap = load[busiest] - load[target];
+    if (gap < MAP_HOME_REBALANCE_MIN_GAP || load[busiest] < load[target] * MAP_HOME_REBALANCE_SKEW)
+        return;
+
+    // move the map that narrows the gap the most, maps only change thread one per tick
+    Map* moved = nullptr;
+    float bestGap = gap;
+    for (Map* map : m_updateOrder)
+    {
+        if (map->GetHomeThread() != int32(busiest))
+            continue;
+
+        float newGap = std::fabs(gap - 2 * map->GetUpdateCost());
+        if (newGap < bestGap)
+        {
+            bestGap = newGap;
+            moved = map;
+        }
+    }
+
+    if (moved)
+        moved->SetHomeThread(int32(target));
+}
+
+#ifdef BUILD_METRICS
+void MapManager::GenerateMetrics() const
+{
+    for (auto& mapData : i_maps)
+    {
+        Map const* map = mapData.second;
+        metric::measurement meas("map.update.cost", {
+            { "map_id", std::to_string(map->GetId()) },
+            { "instance_id", std::to_string(map->GetInstanceId()) }
+        });
+        meas.add_field("average", std::to_string(static_cast<uint32>(map->GetUpdateCost())));
+        meas.add_field("last", std::to_string(map->GetLastUpdateCost()));
+    }
+}
+#endif
+
+bool MapManager::StartUpdate(uint32 diff)
 {
     i_timer.Update(diff);
     if (!i_timer.Passed())
-        return;
+        return false;
 
-    for (auto& map : i_maps)
+    m_updating = true;
+    if (m_updater.activated())
     {
-        if (m_updater.activated())
-            m_updater.schedule_update(new MapUpdateWorker(*map.second, (uint32)i_timer.GetCurrent(), m_updater));
-        else
-            map.second->Update((uint32)i_timer.GetCurrent());
+        // start the costly maps first so they do not end up holding the tick alone
+        m_updateOrder = GetMapsByUpdateCost();
+
+        while (m_updateWorkers.size() < m_updateOrder.size())
+            m_updateWorkers.push_back(std::make_unique<MapUpdateWorker>(m_updater));
+
+        bool sticky = sWorld.getConfig(CONFIG_BOOL_MAPUPDATE_STICKY_MAPS);
+        if (sticky)
+            AssignHomeThreads();
+
+        for (size_t i = 0; i < m_updateOrder.size(); ++i)
+        {
+            m_updateWorkers[i]->Reset(*m_updateOrder[i], (uint32)i_timer.GetCurrent());
+            if (sticky)
+                m_updater.schedule_update(*m_updateWorkers[i], m_updateOrder[i]->GetHomeThread());
+            else
+                m_updater.schedule_update(*m_updateWorkers[i]);
+        }
     }
+    else
+    {
+        for (auto& map : i_maps)
+            map.second->UpdateAndMeasure((uint32)i_timer.GetCurrent());
+    }
+    return true;
+}
+
+void MapManager::FinishUpdate()
+{
+    if (!m_updating)
+        return;
 
+    m_updating = false;
     if (m_updater.activated())
         m_updater.wait();
 
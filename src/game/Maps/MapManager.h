@@ -31,6 +31,7 @@
 
 class Transport;
 class BattleGround;
+class MapUpdateWorker;
 struct TransportTemplate;
 
 struct MapID
@@ -74,7 +75,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void DeleteInstance(uint32 mapid, uint32 instanceId);
 
         void Initialize();
-        void Update(uint32);
+        void Update(uint32 diff) { StartUpdate(diff); FinishUpdate(); }
+        // map threads run the maps until FinishUpdate, world thread work beside them must not touch maps or their objects
+        // false when the update interval has not passed yet, FinishUpdate does nothing then
+        bool StartUpdate(uint32 diff);
+        void FinishUpdate();
 
         void SetGridCleanUpDelay(uint32 t)
         {
@@ -149,6 +154,11 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         // get list of all maps
         const MapMapType& Maps() const { return i_maps; }
+        // maps ordered as dispatched in last update, most expensive first
+        std::vector<Map*> GetMapsByUpdateCost() const;
+#ifdef BUILD_METRICS
+        void GenerateMetrics() const;
+#endif
 
         template<typename Do> void DoForAllMaps(Do& _do)
         {
@@ -179,6 +189,9 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
         void InitStateMachine();
         void DeleteStateMachine();
 
+        // gives new maps a home update thread and moves one map off the busiest thread when load skews
+        void AssignHomeThreads();
+
         Map* CreateInstance(uint32 id, Player* player);
         DungeonMap* CreateDungeonMap(uint32 id, uint32 InstanceId, Difficulty difficulty, DungeonPersistentState* save = nullptr);
         BattleGroundMap* CreateBattleGroundMap(uint32 id, uint32 InstanceId, BattleGround* bg);
@@ -190,6 +203,10 @@ class MapManager : public MaNGOS::Singleton<MapManager, MaNGOS::ClassLevelLockab
 
         uint32 i_MaxInstanceId;
         MapUpdater m_updater;
+        bool m_updating;                                    // between StartUpdate and FinishUpdate
+
+        std::vector<Map*> m_updateOrder;                    // maps sorted by previous update cost, most expensive first
+        std::vector<std::unique_ptr<MapUpdateWorker>> m_updateWorkers; // reused every tick
 };
 
 template<typename Do>
@@ -32,6 +32,7 @@
 #include "Groups/Group.h"
 #include "Maps/InstanceData.h"
 #include "ProgressBar.h"
+#include "Entities/CharacterLoginCache.h"
 
 #include <list>
 #include <cstdarg>
@@ -163,6 +164,15 @@ void MapPersistentState::ClearRespawnTimes()
     UnloadIfEmpty();
 }
 
+MapCellObjectGuids const& MapPersistentState::GetCellObjectGuids(uint32 cell_id) const
+{
+    // most cells have no map specific spawns, do not add an entry for each cell loaded
+    static MapCellObjectGuids const emptyCell;
+
+    MapCellObjectGuidsMap::const_iterator itr = m_gridObjectGuids.find(cell_id);
+    return itr != m_gridObjectGuids.end() ? itr->second : emptyCell;
+}
+
 void MapPersistentState::AddCreatureToGrid(uint32 guid, CreatureData const* data)
 {
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
@@ -176,7 +186,13 @@ void MapPersistentState::RemoveCreatureFromGrid(uint32 guid, CreatureData const*
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    m_gridObjectGuids[cell_id].creatures.erase(guid);
+    MapCellObjectGuidsMap::iterator itr = m_gridObjectGuids.find(cell_id);
+    if (itr == m_gridObjectGuids.end())
+        return;
+
+    itr->second.creatures.erase(guid);
+    if (itr->second.creatures.empty() && itr->second.gameobjects.empty())
+        m_gridObjectGuids.erase(itr);
 }
 
 void MapPersistentState::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
@@ -192,7 +208,13 @@ void MapPersistentState::RemoveGameobjectFromGrid(uint32 guid, GameObjectData co
     CellPair cell_pair = MaNGOS::ComputeCellPair(data->posX, data->posY);
     uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
-    m_gridObjectGuids[cell_id].gameobjects.erase(guid);
+    MapCellObjectGuidsMap::iterator itr = m_gridObjectGuids.find(cell_id);
+    if (itr == m_gridObjectGuids.end())
+        return;
+
+    itr->second.gameobjects.erase(guid);
+    if (itr->second.gameobjects.empty() && itr->second.creatures.empty())
+        m_gridObjectGuids.erase(itr);
 }
 
 void MapPersistentState::InitPools()
@@ -709,6 +731,8 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
 {
     if (instanceid)
     {
+        sCharacterLoginCache.Clear();                       // the characters bound to it are not known here
+
         CharacterDatabase.BeginTransaction();
         CharacterDatabase.PExecute("DELETE FROM instance WHERE id = '%u'", instanceid);
         CharacterDatabase.PExecute("DELETE FROM character_instance WHERE instance = '%u'", instanceid);
@@ -952,6 +976,7 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, bool warn, uint32
         sMapMgr.DoForAllMapsWithMapId(mapid, worker);
 
         // delete them from the DB, even if not loaded
+        sCharacterLoginCache.Clear();
         CharacterDatabase.BeginTransaction();
         CharacterDatabase.PExecute("DELETE FROM character_instance USING character_instance LEFT JOIN instance ON character_instance.instance = id WHERE map = '%u'", mapid);
         CharacterDatabase.PExecute("DELETE FROM group_instance USING group_instance LEFT JOIN instance ON group_instance.instance = id WHERE map = '%u'", mapid);
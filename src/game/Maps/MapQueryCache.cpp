@@ -0,0 +1,126 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapQueryCache.h"
+
+#include <cmath>
+
+size_t MapQueryCache::KeyHash::operator()(Key const& key) const
+{
+    size_t hash = key.type;
+    for (int32 coord : key.coords)
+        hash = hash * 31 + std::hash<int32>()(coord);
+    return hash;
+}
+
+void MapQueryCache::Configure(uint32 capacity, float step)
+{
+    m_step = step > 0.f ? step : 1.f;
+    for (Shard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.capacity = capacity ? std::max<uint32>(capacity / SHARD_COUNT, 1) : 0;
+        shard.entries.clear();
+        shard.index.clear();
+    }
+}
+
+MapQueryCache::Key MapQueryCache::MakeKey(QueryType type, float x1, float y1, float z1, float x2, float y2, float z2) const
+{
+    Key key;
+    key.type = type;
+    key.coords[0] = int32(std::floor(x1 / m_step));
+    key.coords[1] = int32(std::floor(y1 / m_step));
+    key.coords[2] = int32(std::floor(z1 / m_step));
+    key.coords[3] = int32(std::floor(x2 / m_step));
+    key.coords[4] = int32(std::floor(y2 / m_step));
+    key.coords[5] = int32(std::floor(z2 / m_step));
+    return key;
+}
+
+bool MapQueryCache::Find(Key const& key, Result& result)
+{
+    Shard& shard = m_shards[KeyHash()(key) % SHARD_COUNT];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto itr = shard.index.find(key);
+    if (itr == shard.index.end())
+    {
+        ++m_misses;
+        return false;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+    result = itr->second->second;
+    ++m_hits;
+    return true;
+}
+
+void MapQueryCache::Store(Key const& key, Result const& result)
+{
+    Shard& shard = m_shards[KeyHash()(key) % SHARD_COUNT];
+    std::lock_guard<std::mutex> guard(shard.lock);
+    if (!shard.capacity)
+        return;
+
+    auto itr = shard.index.find(key);
+    if (itr != shard.index.end())
+    {
+        itr->second->second = result;
+        shard.entries.splice(shard.entries.begin(), shard.entries, itr->second);
+        return;
+    }
+
+    if (shard.entries.size() >= shard.capacity)
+    {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+
+    shard.entries.emplace_front(key, result);
+    shard.index.emplace(key, shard.entries.begin());
+}
+
+bool MapQueryCache::FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, Result& result)
+{
+    return Find(MakeKey(ignoreM2Model ? QUERY_LOS_IGNORE_M2 : QUERY_LOS, x1, y1, z1, x2, y2, z2), result);
+}
+
+void MapQueryCache::StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, Result const& result)
+{
+    Store(MakeKey(ignoreM2Model ? QUERY_LOS_IGNORE_M2 : QUERY_LOS, x1, y1, z1, x2, y2, z2), result);
+}
+
+bool MapQueryCache::FindHeight(float x, float y, float z, bool swim, Result& result)
+{
+    return Find(MakeKey(swim ? QUERY_HEIGHT_SWIM : QUERY_HEIGHT, x, y, z), result);
+}
+
+void MapQueryCache::StoreHeight(float x, float y, float z, bool swim, Result const& result)
+{
+    Store(MakeKey(swim ? QUERY_HEIGHT_SWIM : QUERY_HEIGHT, x, y, z), result);
+}
+
+void MapQueryCache::Clear()
+{
+    for (Shard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> guard(shard.lock);
+        shard.entries.clear();
+        shard.index.clear();
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAP_QUERY_CACHE_H
+#define MANGOS_MAP_QUERY_CACHE_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// LRU cache of line of sight and height results of one map keyed by quantized positions,
+// standing casters and patrolling guards repeat the same queries over and over.
+// Every entry keeps the result of the static vmap query, which only changes when terrain tiles
+// get loaded, and the result including gameobject collision of the dynamic tree generation it was
+// computed for. After a gameobject model changed only the dynamic part is queried again.
+class MapQueryCache
+{
+    public:
+        struct Result
+        {
+            float staticValue;
+            float value;
+            uint32 dynGeneration;
+        };
+
+        MapQueryCache() : m_step(1.f), m_hits(0), m_misses(0) {}
+
+        // capacity 0 disables the cache
+        void Configure(uint32 capacity, float step);
+        bool IsEnabled() const { return m_shards[0].capacity != 0; }
+
+        bool FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, Result& result);
+        void StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model, Result const& result);
+        bool FindHeight(float x, float y, float z, bool swim, Result& result);
+        void StoreHeight(float x, float y, float z, bool swim, Result const& result);
+
+        // terrain of the map changed, static results are outdated too
+        void Clear();
+
+        uint32 GetHits() const { return m_hits; }
+        uint32 GetMisses() const { return m_misses; }
+        void ResetCounters() { m_hits = 0; m_misses = 0; }
+
+    private:
+        enum QueryType : uint8
+        {
+            QUERY_LOS,
+            QUERY_LOS_IGNORE_M2,
+            QUERY_HEIGHT,
+            QUERY_HEIGHT_SWIM,
+        };
+
+        struct Key
+        {
+            int32 coords[6];
+            uint8 type;
+
+            bool operator==(Key const& other) const
+            {
+                return type == other.type && memcmp(coords, other.coords, sizeof(coords)) == 0;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const;
+        };
+
+        typedef std::list<std::pair<Key, Result>> EntryList;
+
+        // split by key so parallel cell updates of a continent do not wait on one lock
+        struct Shard
+        {
+            Shard() : capacity(0) {}
+
+            std::mutex lock;
+            EntryList entries;                              // most recently used first
+            std::unordered_map<Key, EntryList::iterator, KeyHash> index;
+            uint32 capacity;
+        };
+
+        Key MakeKey(QueryType type, float x1, float y1, float z1, float x2 = 0.f, float y2 = 0.f, float z2 = 0.f) const;
+        bool Find(Key const& key, Result& result);
+        void Store(Key const& key, Result const& result);
+
+        static const uint32 SHARD_COUNT = 8;
+        Shard m_shards[SHARD_COUNT];
+        float m_step;
+
+        std::atomic<uint32> m_hits;
+        std::atomic<uint32> m_misses;
+};
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/MapStateSnapshot.h"
+#include "Entities/Player.h"
+#include "Maps/GridMap.h"
+
+#include <algorithm>
+
+static bool SnapshotGuidLess(MapSnapshotEntity const& entity, ObjectGuid guid)
+{
+    return entity.guid < guid;
+}
+
+MapSnapshotEntity const* MapStateSnapshot::Find(ObjectGuid guid) const
+{
+    auto itr = std::lower_bound(m_entities.begin(), m_entities.end(), guid, SnapshotGuidLess);
+    if (itr == m_entities.end() || itr->guid != guid)
+        return nullptr;
+    return &*itr;
+}
+
+void MapStateSnapshot::GetEntitiesInRange(float x, float y, float range, std::vector<MapSnapshotEntity const*>& result) const
+{
+    float const rangeSq = range * range;
+    for (MapSnapshotEntity const& entity : m_entities)
+    {
+        float const dx = entity.x - x;
+        float const dy = entity.y - y;
+        if (dx * dx + dy * dy <= rangeSq)
+            result.push_back(&entity);
+    }
+}
+
+void MapStateSnapshot::Reset(uint64 epoch, uint32 msTime)
+{
+    m_epoch = epoch;
+    m_msTime = msTime;
+    m_entities.clear();
+}
+
+void MapStateSnapshot::Add(Unit const* unit)
+{
+    MapSnapshotEntity entity;
+    entity.guid = unit->GetObjectGuid();
+    entity.x = unit->GetPositionX();
+    entity.y = unit->GetPositionY();
+    entity.z = unit->GetPositionZ();
+    entity.orientation = unit->GetOrientation();
+    entity.faction = unit->GetFaction();
+    entity.unitFlags = unit->GetUInt32Value(UNIT_FIELD_FLAGS);
+    entity.healthPct = unit->GetMaxHealth() ? uint8(unit->GetHealth() * 100 / unit->GetMaxHealth()) : 0;
+    entity.flags = 0;
+    if (unit->IsAlive())
+        entity.flags |= SNAPSHOT_FLAG_ALIVE;
+    if (unit->IsInCombat())
+        entity.flags |= SNAPSHOT_FLAG_IN_COMBAT;
+
+    // players keep their zone up to date already, for others it is a terrain lookup
+    if (unit->GetTypeId() == TYPEID_PLAYER)
+    {
+        entity.flags |= SNAPSHOT_FLAG_PLAYER;
+        entity.zoneId = static_cast<Player const*>(unit)->GetCachedZoneId();
+    }
+    else
+        entity.zoneId = 0;
+
+    m_entities.push_back(entity);
+}
+
+void MapStateSnapshot::Finalize(TerrainInfo const* terrain, MapStateSnapshot const* previous)
+{
+    std::sort(m_entities.begin(), m_entities.end(), [](MapSnapshotEntity const& a, MapSnapshotEntity const& b) { return a.guid < b.guid; });
+
+    for (MapSnapshotEntity& entity : m_entities)
+    {
+        if (entity.IsPlayer())
+            continue;
+
+        MapSnapshotEntity const* old = previous ? previous->Find(entity.guid) : nullptr;
+        if (old && old->x == entity.x && old->y == entity.y && old->z == entity.z)
+            entity.zoneId = old->zoneId;
+        else
+            entity.zoneId = terrain->GetZoneId(entity.x, entity.y, entity.z);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_MAP_STATE_SNAPSHOT_H
+#define MANGOS_MAP_STATE_SNAPSHOT_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+
+#include <vector>
+
+class Unit;
+class TerrainInfo;
+
+enum MapSnapshotEntityFlags : uint8
+{
+    SNAPSHOT_FLAG_ALIVE     = 0x01,
+    SNAPSHOT_FLAG_IN_COMBAT = 0x02,
+    SNAPSHOT_FLAG_PLAYER    = 0x04,
+};
+
+// Cheap state of one unit as it was at the end of a map update
+struct MapSnapshotEntity
+{
+    ObjectGuid guid;
+    float x, y, z, orientation;
+    uint32 zoneId;
+    uint32 faction;
+    uint32 unitFlags;
+    uint8 healthPct;
+    uint8 flags;                                            // MapSnapshotEntityFlags
+
+    bool IsAlive() const { return (flags & SNAPSHOT_FLAG_ALIVE) != 0; }
+    bool IsInCombat() const { return (flags & SNAPSHOT_FLAG_IN_COMBAT) != 0; }
+    bool IsPlayer() const { return (flags & SNAPSHOT_FLAG_PLAYER) != 0; }
+};
+
+// Immutable copy of the units of one map, published by the map thread at the end of Map::Update.
+// Other threads get it with Map::GetStateSnapshot and may keep and read it as long as they like
+// without any map lock, it is never changed again once published. Data is up to one tick old.
+class MapStateSnapshot
+{
+    public:
+        MapStateSnapshot() : m_epoch(0), m_msTime(0) {}
+
+        uint64 GetEpoch() const { return m_epoch; }
+        uint32 GetMSTime() const { return m_msTime; }
+        std::vector<MapSnapshotEntity> const& GetEntities() const { return m_entities; }
+
+        MapSnapshotEntity const* Find(ObjectGuid guid) const;
+        // appends the entities within range in 2d, unordered
+        void GetEntitiesInRange(float x, float y, float range, std::vector<MapSnapshotEntity const*>& result) const;
+
+        // building, map thread only and only before the snapshot is published
+        void Reset(uint64 epoch, uint32 msTime);
+        void Add(Unit const* unit);
+        // sorts the entities and fills in the zones, reusing the zone of previous when a unit did not move
+        void Finalize(TerrainInfo const* terrain, MapStateSnapshot const* previous);
+
+    private:
+        uint64 m_epoch;
+        uint32 m_msTime;
+        std::vector<MapSnapshotEntity> m_entities;          // sorted by guid
+};
+
+#endif
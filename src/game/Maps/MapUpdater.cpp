@@ -18,11 +18,18 @@
 
 #include "MapUpdater.h"
 #include "MapWorkers.h"
+#include "AllocStats.h"
+#include "Log.h"
 
-MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0)
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+MapUpdater::MapUpdater(size_t num_threads) : _cancelationToken(false), pending_requests(0), _nextQueue(0), _queuedJobs(0), _affinityMask(0)
 {
-    for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+    activate(num_threads);
 }
 
 void MapUpdater::activate(size_t num_threads)
@@ -30,18 +37,66 @@ void MapUpdater::activate(size_t num_threads)
     if (activated())
         return;
 
+    _cancelationToken = false;
+
+    for (size_t i = 0; i < num_threads; ++i)
+        _queues.push_back(std::make_unique<WorkQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
+
+    if (_affinityMask)
+    {
+        uint32 cpu = 0;
+        for (auto& thread : _workerThreads)
+        {
+            while (!(_affinityMask & (uint64(1) << cpu)))
+                cpu = (cpu + 1) % 64;
+
+            BindThread(thread, cpu);
+            cpu = (cpu + 1) % 64;
+        }
+    }
 }
 
-void MapUpdater::deactivate()
+void MapUpdater::BindThread(std::thread& thread, uint32 cpu)
 {
-    _cancelationToken = true;
+#ifdef _WIN32
+    if (!SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << cpu))
+        sLog.outError("MapUpdater: can't bind update thread to processor %u", cpu);
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet) != 0)
+        sLog.outError("MapUpdater: can't bind update thread to processor %u", cpu);
+#else
+    (void)thread;
+    sLog.outError("MapUpdater: thread affinity is not supported on this platform, processor %u ignored", cpu);
+#endif
+}
 
-    _queue.Cancel();
+void MapUpdater::deactivate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        _cancelationToken = true;
+    }
+    _sleepCondition.notify_all();
 
     for (auto& thread : _workerThreads)
         thread.join();
+
+    _workerThreads.clear();
+
+    // delete jobs never executed
+    for (auto& queue : _queues)
+        for (auto& job : queue->jobs)
+            if (job.owned)
+                delete job.worker;
+
+    _queues.clear();
+    _queuedJobs = 0;
 }
 
 void MapUpdater::wait()
@@ -73,28 +128,108 @@ void MapUpdater::update_finished()
 
 void MapUpdater::schedule_update(Worker* worker)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    Push({ worker, true, false }, _nextQueue++ % _queues.size());
+}
 
-    ++pending_requests;
-    _queue.Push(std::move(worker));
+void MapUpdater::schedule_update(Worker& worker)
+{
+    Push({ &worker, false, false }, _nextQueue++ % _queues.size());
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::schedule_update(Worker& worker, size_t thread)
 {
-    while (true)
+    Push({ &worker, false, true }, thread % _queues.size());
+}
+
+void MapUpdater::Push(Job job, size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        ++pending_requests;
+    }
+
+    WorkQueue& queue = *_queues[index];
+
+    // counted before push so a thread never sees a job it was not told about
+    {
+        std::lock_guard<std::mutex> lock(_sleepLock);
+        if (job.pinned)
+            ++queue.pinnedJobs;
+        else
+            ++_queuedJobs;
+    }
+
     {
-        Worker* request = nullptr;
+        std::lock_guard<std::mutex> lock(queue.lock);
+        queue.jobs.push_back(job);
+    }
 
-        _queue.WaitAndPop(request);
+    // a pinned job has to wake its own thread, any thread will do for the others
+    if (job.pinned)
+        _sleepCondition.notify_all();
+    else
+        _sleepCondition.notify_one();
+}
 
-        if (_cancelationToken)
+bool MapUpdater::Pop(size_t index, Job& job)
+{
+    {
+        WorkQueue& own = *_queues[index];
+        std::lock_guard<std::mutex> lock(own.lock);
+        if (!own.jobs.empty())
         {
-            delete request;
-            return;
+            job = own.jobs.front();
+            own.jobs.pop_front();
+            if (job.pinned)
+                --own.pinnedJobs;
+            else
+                --_queuedJobs;
+            return true;
         }
+    }
 
-        request->execute();
+    for (size_t i = 1; i < _queues.size(); ++i)
+    {
+        WorkQueue& victim = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.lock);
+        for (auto itr = victim.jobs.rbegin(); itr != victim.jobs.rend(); ++itr)
+        {
+            if (itr->pinned)
+                continue;
 
-        delete request;
+            job = *itr;
+            victim.jobs.erase(std::next(itr).base());
+            --_queuedJobs;
+            return true;
+        }
     }
-}
\ No newline at end of file
+
+    return false;
+}
+
+void MapUpdater::WorkerThread(size_t index)
+{
+    AllocStats::InitThreadArena();
+
+    while (true)
+    {
+        Job job;
+
+        if (!Pop(index, job))
+        {
+            std::unique_lock<std::mutex> lock(_sleepLock);
+            while (_queuedJobs == 0 && _queues[index]->pinnedJobs == 0 && !_cancelationToken)
+                _sleepCondition.wait(lock);
+
+            if (_cancelationToken)
+                return;
+
+            continue;
+        }
+
+        job.worker->execute();
+
+        if (job.owned)
+            delete job.worker;
+    }
+}
@@ -20,11 +20,12 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Platform/Define.h"
-#include "ProducerConsumerQueue.h"
 
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <condition_variable>
 
@@ -33,7 +34,7 @@ class Worker;
 class MapUpdater
 {
     public:
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
+        MapUpdater() : _cancelationToken(false), pending_requests(0), _nextQueue(0), _queuedJobs(0), _affinityMask(0) {}
         MapUpdater(size_t num_threads);
         MapUpdater(const MapUpdater&) = delete;
         
@@ -43,10 +44,37 @@ class MapUpdater
         void join();
         bool activated();
         void update_finished();
+        size_t thread_count() const { return _workerThreads.size(); }
+
+        // processors bitmask the threads are bound to on activate, each thread takes the next set bit in turn
+        void set_affinity(uint64 mask) { _affinityMask = mask; }
+
+        // updater takes ownership of the worker and deletes it after execution
         void schedule_update(Worker* worker);
+        // worker is owned by the caller and can be scheduled again after wait()
+        void schedule_update(Worker& worker);
+        // same, but the job runs on the given thread only and is never stolen by the others
+        void schedule_update(Worker& worker, size_t thread);
 
     private:
-        ProducerConsumerQueue<Worker *> _queue;
+        struct Job
+        {
+            Worker* worker;
+            bool owned;
+            bool pinned;
+        };
+
+        // every thread pops from the front of its own queue and steals from the back of the others
+        struct WorkQueue
+        {
+            WorkQueue() : pinnedJobs(0) {}
+
+            std::mutex lock;
+            std::deque<Job> jobs;
+            std::atomic<size_t> pinnedJobs;                 // only this queue's thread can run them
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> _queues;
 
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
@@ -55,7 +83,17 @@ class MapUpdater
         std::condition_variable _condition;
         size_t pending_requests;
 
-        void WorkerThread();
+        std::atomic<size_t> _nextQueue;
+        std::atomic<size_t> _queuedJobs;                    // jobs any thread can run
+        std::mutex _sleepLock;
+        std::condition_variable _sleepCondition;
+
+        uint64 _affinityMask;
+
+        void Push(Job job, size_t index);
+        bool Pop(size_t index, Job& job);
+        static void BindThread(std::thread& thread, uint32 cpu);
+        void WorkerThread(size_t index);
 };
 
-#endif //_MAP_UPDATER_H_INCLUDED
\ No newline at end of file
+#endif //_MAP_UPDATER_H_INCLUDED
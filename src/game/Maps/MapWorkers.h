@@ -24,6 +24,13 @@
 #include "MapUpdater.h"
 #include "MotionGenerators/MovementGenerator.h"
 #include "Entities/Object.h"
+#include "Entities/UpdateData.h"
+#include "Maps/Map.h"
+#include "Maps/ZoneStats.h"
+#include "World/TickWatchdog.h"
+#include "WorldPacket.h"
+#include "AllocStats.h"
+#include "Trace.h"
 #include "Platform/Define.h"
 
 class Worker
@@ -44,17 +51,28 @@ class MapUpdateWorker : public Worker
 {
     public:
         MapUpdateWorker(Map& map, uint32 diff, MapUpdater& updater) :
-            Worker(updater), m_map(map), m_diff(diff)
+            Worker(updater), m_map(&map), m_diff(diff)
         {}
 
+        // pooled worker, assign a map with Reset() before each schedule
+        explicit MapUpdateWorker(MapUpdater& updater) :
+            Worker(updater), m_map(nullptr), m_diff(0)
+        {}
+
+        void Reset(Map& map, uint32 diff)
+        {
+            m_map = &map;
+            m_diff = diff;
+        }
+
         void execute() override
         {
-            m_map.Update(m_diff);
+            m_map->UpdateAndMeasure(m_diff);
             GetWorker().update_finished();
         }
 
     private:
-        Map& m_map;
+        Map* m_map;
         uint32 m_diff;
 };
 
@@ -67,21 +85,40 @@ class GridCrawler : public Worker
 
         void execute() override
         {
+            UpdateCells();
+            GetWorker().update_finished();
+        }
+
+    private:
+        void UpdateCells()
+        {
+            WatchdogFrame mapFrame(WATCHDOG_FRAME_MAP, nullptr, m_map.GetId(), m_map.GetInstanceId());
+            WatchdogFrame phaseFrame(WATCHDOG_FRAME_PHASE, "cell objects");
+            TRACE_ZONE_ID("cell objects", m_map.GetId());
+            AllocTagScope allocTag(ALLOC_TAG_MAP_OBJECTS);
+
             WorldObjectUnSet objToUpdate;
             MaNGOS::ObjectUpdater obj_updater(objToUpdate, m_diff);
             TypeContainerVisitor<MaNGOS::ObjectUpdater, GridTypeMapContainer  > grid_object_update(obj_updater);    // For creature
             TypeContainerVisitor<MaNGOS::ObjectUpdater, WorldTypeMapContainer > world_object_update(obj_updater);   // For pets
 
-            for (auto &cell : m_cells)
             {
-                m_map.Visit(cell, grid_object_update);
-                m_map.Visit(cell, world_object_update);
+                // other crawlers may add or remove objects from grid while we collect ours
+                std::lock_guard<std::recursive_mutex> guard(m_map.GetParallelCellLock());
+                for (auto &cell : m_cells)
+                {
+                    m_map.Visit(cell, grid_object_update);
+                    m_map.Visit(cell, world_object_update);
+                }
             }
 
-            GetWorker().update_finished();
+            for (auto obj : objToUpdate)
+            {
+                ZoneStatsScope zoneStats(ZONE_STATS_OBJECTS, obj);
+                obj->Update(m_diff);
+            }
         }
 
-    private:
         Map& m_map;
         std::vector<Cell> &m_cells;
         uint32 m_diff;
@@ -98,7 +135,10 @@ class ObjectUpdateWorker : public Worker
         void execute() override
         {
             for (WorldObject* const &object : m_objects)
+            {
+                ZoneStatsScope zoneStats(ZONE_STATS_OBJECTS, object);
                 object->Update(m_diff);
+            }
 
             GetWorker().update_finished();
         }
@@ -108,4 +148,39 @@ class ObjectUpdateWorker : public Worker
         uint32 m_diff;
 };
 
+// packets of one player, built off the map thread and sent in index order by the map thread
+struct PlayerUpdatePackets
+{
+    Player* player;
+    UpdateData* data;
+    std::vector<WorldPacket> packets;
+};
+
+class UpdatePacketBuilder : public Worker
+{
+    public:
+        typedef std::vector<PlayerUpdatePackets>::iterator Iterator;
+
+        UpdatePacketBuilder(Iterator first, Iterator last, MapUpdater& updater) :
+            Worker(updater), m_first(first), m_last(last)
+        {}
+
+        void execute() override
+        {
+            // BuildPacket only reads the player's own UpdateData, no lock needed
+            for (Iterator itr = m_first; itr != m_last; ++itr)
+            {
+                itr->packets.reserve(itr->data->GetPacketCount());
+                for (size_t i = 0; i < itr->data->GetPacketCount(); ++i)
+                    itr->packets.push_back(itr->data->BuildPacket(i));
+            }
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        Iterator m_first;
+        Iterator m_last;
+};
+
 #endif //_MAP_WORKERS_H_INCLUDED
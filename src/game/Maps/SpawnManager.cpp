@@ -77,101 +77,142 @@ void SpawnManager::Initialize()
 
 void SpawnManager::AddCreature(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_UNIT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    ScheduleSpawn(dbguid, HIGHGUID_UNIT, m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
 }
 
 void SpawnManager::AddGameObject(uint32 respawnDelay, uint32 dbguid)
 {
-    m_spawns.emplace_back(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay), dbguid, HIGHGUID_GAMEOBJECT);
-    std::sort(m_spawns.begin(), m_spawns.end());
+    ScheduleSpawn(dbguid, HIGHGUID_GAMEOBJECT, m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
 }
 
-void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
+void SpawnManager::ScheduleSpawn(uint32 dbguid, HighGuid high, TimePoint const& when)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    uint64 key = GetSpawnKey(dbguid, high);
+    auto result = m_spawns.emplace(key, SpawnInfo(when, dbguid, high));
+    SpawnInfo& spawnInfo = result.first->second;
+    if (!result.second)
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
+        // object is being spawned right now
+        if (spawnInfo.IsUsed())
+            return;
+
+        spawnInfo.SetRespawnTime(when);
     }
-    if (!found)
-        AddCreature(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
-    if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+
+    m_spawnQueue.push({ when, key, spawnInfo.GetGeneration() });
 }
 
-void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
+// Try to spawn a pending object now, removes it from the pending list on success
+bool SpawnManager::ConstructSpawn(uint64 key)
+{
+    auto itr = m_spawns.find(key);
+    if (itr == m_spawns.end() || itr->second.IsUsed())
+        return false;
+
+    uint32 generation = itr->second.GetGeneration();
+    if (!itr->second.ConstructForMap(m_map))
+        return false;
+
+    // spawning may have added pending objects, lookup again and keep it if it was rescheduled meanwhile
+    itr = m_spawns.find(key);
+    if (itr != m_spawns.end() && itr->second.GetGeneration() == generation)
+        m_spawns.erase(itr);
+    return true;
+}
+
+void SpawnManager::RespawnObject(uint32 dbguid, HighGuid high, uint32 respawnDelay)
 {
-    bool found = false;
-    auto itr = m_spawns.begin();
-    for (; itr != m_spawns.end(); )
+    uint64 key = GetSpawnKey(dbguid, high);
+    auto itr = m_spawns.find(key);
+    if (itr == m_spawns.end() || itr->second.IsUsed())
     {
-        auto& spawnInfo = *itr;
-        if (!spawnInfo.IsUsed() && spawnInfo.GetDbGuid() == dbguid && spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
-        {
-            found = true;
-            m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
-            if (respawnDelay > 0)
-                spawnInfo.SetRespawnTime(m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
-            break;
-        }
-        ++itr;
+        ScheduleSpawn(dbguid, high, m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+        return;
     }
-    if (!found)
-        AddGameObject(respawnDelay, dbguid);
-    else if (respawnDelay == 0)
-        (*itr).ConstructForMap(m_map);
+
+    if (high == HIGHGUID_UNIT)
+        m_map.GetPersistentState()->SaveCreatureRespawnTime(dbguid, time(nullptr) + respawnDelay);
+    else
+        m_map.GetPersistentState()->SaveGORespawnTime(dbguid, time(nullptr) + respawnDelay);
+
     if (respawnDelay > 0)
-        std::sort(m_spawns.begin(), m_spawns.end());
+        ScheduleSpawn(dbguid, high, m_map.GetCurrentClockTime() + std::chrono::seconds(respawnDelay));
+    else
+        ConstructSpawn(key);
+}
+
+void SpawnManager::RespawnCreature(uint32 dbguid, uint32 respawnDelay)
+{
+    RespawnObject(dbguid, HIGHGUID_UNIT, respawnDelay);
+}
+
+void SpawnManager::RespawnGameObject(uint32 dbguid, uint32 respawnDelay)
+{
+    RespawnObject(dbguid, HIGHGUID_GAMEOBJECT, respawnDelay);
 }
 
 void SpawnManager::RespawnAll()
 {
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+    // spawning can add pending objects, so work on a copy of the keys
+    std::vector<uint64> keys;
+    keys.reserve(m_spawns.size());
+    for (auto& spawn : m_spawns)
+        keys.push_back(spawn.first);
+
+    for (uint64 key : keys)
     {
-        auto& spawnInfo = *itr;
+        auto itr = m_spawns.find(key);
+        if (itr == m_spawns.end())
+            continue;
+
+        SpawnInfo const& spawnInfo = itr->second;
         if (spawnInfo.GetHighGuid() == HIGHGUID_GAMEOBJECT)
             m_map.GetPersistentState()->SaveGORespawnTime(spawnInfo.GetDbGuid(), 0);
         if (spawnInfo.GetHighGuid() == HIGHGUID_UNIT)
             m_map.GetPersistentState()->SaveCreatureRespawnTime(spawnInfo.GetDbGuid(), 0);
-        spawnInfo.ConstructForMap(m_map);
+        ConstructSpawn(key);
     }
 }
 
 void SpawnManager::Update()
 {
     auto now = m_map.GetCurrentClockTime();
-    for (auto itr = m_spawns.begin(); itr != m_spawns.end();)
+
+    std::vector<SpawnQueueEntry> failed;
+    while (!m_spawnQueue.empty() && m_spawnQueue.top().respawnTime <= now)
     {
-        auto& spawnInfo = *itr;
-        if (spawnInfo.IsUsed() ||
-            (spawnInfo.GetRespawnTime() <= now && spawnInfo.ConstructForMap(m_map)))
-            itr = m_spawns.erase(itr);
-        else
-            ++itr;
+        SpawnQueueEntry entry = m_spawnQueue.top();
+        m_spawnQueue.pop();
+
+        // already spawned or rescheduled
+        auto itr = m_spawns.find(entry.key);
+        if (itr == m_spawns.end() || itr->second.GetGeneration() != entry.generation)
+            continue;
+
+        // can fail due to linking, retried at next update
+        if (!ConstructSpawn(entry.key))
+            failed.push_back(entry);
     }
 
+    for (auto& entry : failed)
+        m_spawnQueue.push(entry);
+
     for (auto& group : m_spawnGroups)
         group.second->Update();
 }
 
 std::string SpawnManager::GetRespawnList()
 {
+    std::vector<SpawnInfo const*> spawns;
+    spawns.reserve(m_spawns.size());
+    for (auto& spawn : m_spawns)
+        spawns.push_back(&spawn.second);
+    std::sort(spawns.begin(), spawns.end(), [](SpawnInfo const* lhs, SpawnInfo const* rhs) { return *lhs < *rhs; });
+
     std::string output = "";
-    for (auto& data : m_spawns)
+    for (SpawnInfo const* spawn : spawns)
     {
+        SpawnInfo const& data = *spawn;
         output += "DBGuid: " + std::to_string(data.GetDbGuid()) + "HighGuid: " + (data.GetHighGuid() == HIGHGUID_UNIT ? "Creature" : "GameObject") + "Respawn Time ";
         auto diff = (data.GetRespawnTime() - m_map.GetCurrentClockTime()).count();
         if (auto hours = diff / (HOUR * IN_MILLISECONDS))
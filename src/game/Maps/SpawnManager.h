@@ -23,6 +23,7 @@
 #include "Entities/ObjectGuid.h"
 #include "Maps/SpawnGroup.h"
 
+#include <queue>
 #include <string>
 
 class Map;
@@ -30,9 +31,10 @@ class Map;
 class SpawnInfo
 {
     public:
-        SpawnInfo(TimePoint when, uint32 dbguid, HighGuid high) : m_respawnTime(when), m_dbguid(dbguid), m_high(high), m_used(false), m_inUse(false){}
+        SpawnInfo(TimePoint when, uint32 dbguid, HighGuid high) : m_respawnTime(when), m_dbguid(dbguid), m_high(high), m_used(false), m_inUse(false), m_generation(0) {}
         TimePoint const& GetRespawnTime() const { return m_respawnTime; }
-        void SetRespawnTime(TimePoint const& time) { m_respawnTime = time; }
+        void SetRespawnTime(TimePoint const& time) { m_respawnTime = time; ++m_generation; }
+        uint32 GetGeneration() const { return m_generation; }
         bool ConstructForMap(Map& map); // can fail due to linking, pooling not supported
         uint32 GetDbGuid() const { return m_dbguid; }
         HighGuid GetHighGuid() const { return m_high; }
@@ -44,6 +46,7 @@ class SpawnInfo
         HighGuid m_high;
         bool m_used;
         bool m_inUse;
+        uint32 m_generation;                                // bumped at each reschedule, older queue entries are skipped
 };
 
 bool operator<(SpawnInfo const& lhs, SpawnInfo const& rhs);
@@ -71,9 +74,25 @@ class SpawnManager
 
         void RespawnSpawnGroupsInVicinity(Position pos, float range);
     private:
+        struct SpawnQueueEntry
+        {
+            TimePoint respawnTime;
+            uint64 key;
+            uint32 generation;
+
+            // earliest respawn on top of the priority queue
+            bool operator<(SpawnQueueEntry const& other) const { return respawnTime > other.respawnTime; }
+        };
+
+        static uint64 GetSpawnKey(uint32 dbguid, HighGuid high) { return (uint64(high) << 32) | dbguid; }
+        void ScheduleSpawn(uint32 dbguid, HighGuid high, TimePoint const& when);
+        void RespawnObject(uint32 dbguid, HighGuid high, uint32 respawnDelay);
+        bool ConstructSpawn(uint64 key);
+
         Map& m_map;
 
-        std::vector<SpawnInfo> m_spawns; // must only be erased from in Update
+        std::unordered_map<uint64, SpawnInfo> m_spawns;    // one pending respawn per object
+        std::priority_queue<SpawnQueueEntry> m_spawnQueue;  // due times of m_spawns, only the due ones are touched by Update
         std::map<uint32, SpawnGroup*> m_spawnGroups;
 };
 
@@ -52,6 +52,8 @@ void TransportMgr::LoadTransportTemplates()
             transportTemplate.entry = entry;
             if (!GenerateWaypoints(data, transportTemplate))
                 m_transportTemplates.erase(entry);
+            else
+                GenerateTimetable(data, transportTemplate);
         }
     }
 }
@@ -302,6 +304,112 @@ bool TransportMgr::GenerateWaypoints(GameObjectInfo const* goinfo, TransportTemp
     return true;
 }
 
+// position on the spline segment of the frame at the given time in seconds, see KeyFrame times
+static float CalculateSegmentPos(KeyFrame const& frame, TransportTemplate const& transportTemplate, float speed, float accel, float now)
+{
+    float timeSinceStop = frame.TimeFrom + (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
+    float timeUntilStop = frame.TimeTo - (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
+    float segmentPos, dist;
+    float accelTime = transportTemplate.accelTime;
+    float accelDist = transportTemplate.accelDist;
+    // calculate from nearest stop, less confusing calculation...
+    if (timeSinceStop < timeUntilStop)
+    {
+        if (timeSinceStop < accelTime)
+            dist = 0.5f * accel * timeSinceStop * timeSinceStop;
+        else
+            dist = accelDist + (timeSinceStop - accelTime) * speed;
+        segmentPos = dist - frame.DistSinceStop;
+    }
+    else
+    {
+        if (timeUntilStop < accelTime)
+            dist = 0.5f * accel * timeUntilStop * timeUntilStop;
+        else
+            dist = accelDist + (timeUntilStop - accelTime) * speed;
+        segmentPos = frame.DistUntilStop - dist;
+    }
+
+    return segmentPos / frame.NextDistFromPrev;
+}
+
+void TransportMgr::GenerateTimetable(GameObjectInfo const* goinfo, TransportTemplate& transportTemplate)
+{
+    KeyFrameVec const& keyFrames = transportTemplate.keyFrames;
+    std::vector<TransportTimetable::Sample>& samples = transportTemplate.timetable.samples;
+    if (keyFrames.size() <= 1 || !transportTemplate.pathTime)
+        return;
+
+    float const speed = float(goinfo->moTransport.moveSpeed);
+    float const accel = float(goinfo->moTransport.accelRate);
+
+    // one spline evaluation per step at startup, shared by all transports of the path
+    samples.reserve(transportTemplate.pathTime / TRANSPORT_TIMETABLE_STEP + 1);
+    size_t current = 0;
+    for (uint32 time = 0; time < transportTemplate.pathTime; time += TRANSPORT_TIMETABLE_STEP)
+    {
+        while (current + 1 < keyFrames.size() && time >= keyFrames[current].NextArriveTime)
+            ++current;
+
+        KeyFrame const& frame = keyFrames[current];
+        TransportTimetable::Sample sample;
+        sample.frame = current;
+        sample.moving = time >= frame.DepartureTime && frame.NextDistFromPrev > 0.0f;
+        if (sample.moving)
+        {
+            float t = CalculateSegmentPos(frame, transportTemplate, speed, accel, float(time) * 0.001f);
+            G3D::Vector3 pos, dir;
+            frame.Spline->evaluate_percent(frame.Index, t, pos);
+            frame.Spline->evaluate_derivative(frame.Index, t, dir);
+            sample.x = pos.x;
+            sample.y = pos.y;
+            sample.z = pos.z;
+            sample.o = atan2(dir.y, dir.x) + M_PI;
+        }
+        else
+        {
+            sample.x = frame.Node->x;
+            sample.y = frame.Node->y;
+            sample.z = frame.Node->z;
+            sample.o = frame.InitialOrientation;
+        }
+        samples.push_back(sample);
+    }
+}
+
+bool TransportTimetable::GetPosition(uint32 pathProgress, float& x, float& y, float& z, float& o) const
+{
+    if (samples.empty())
+        return false;
+
+    uint32 index = pathProgress / TRANSPORT_TIMETABLE_STEP;
+    if (index >= samples.size())
+        index = samples.size() - 1;
+
+    Sample const& sample = samples[index];
+    if (!sample.moving)
+        return false;
+
+    x = sample.x;
+    y = sample.y;
+    z = sample.z;
+    o = sample.o;
+
+    // samples of one segment lie on the same spline, anything else (stops, teleports) is not interpolated
+    if (index + 1 < samples.size())
+    {
+        Sample const& next = samples[index + 1];
+        if (next.moving && next.frame == sample.frame)
+        {
+            float factor = float(pathProgress - index * TRANSPORT_TIMETABLE_STEP) / TRANSPORT_TIMETABLE_STEP;
+            x += (next.x - sample.x) * factor;
+            y += (next.y - sample.y) * factor;
+            z += (next.z - sample.z) * factor;
+        }
+    }
+    return true;
+}
+
 void TransportMgr::AddPathNodeToTransport(uint32 transportEntry, uint32 timeSeg, TransportAnimationEntry const* node)
 {
     TransportAnimation& animNode = m_transportAnimations[transportEntry];
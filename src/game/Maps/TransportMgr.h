@@ -80,6 +80,24 @@ struct KeyFrame
 
 typedef std::vector<KeyFrame>  KeyFrameVec;
 
+#define TRANSPORT_TIMETABLE_STEP 50                         // ms between two positions of a timetable
+
+// Positions of a transport over one period, its movement is a pure function of the path progress
+struct TransportTimetable
+{
+    struct Sample
+    {
+        float x, y, z, o;
+        uint32 frame;                                       // keyframe index the position belongs to
+        bool moving;
+    };
+
+    std::vector<Sample> samples;
+
+    // interpolated position at the path progress, false while the transport waits at a stop
+    bool GetPosition(uint32 pathProgress, float& x, float& y, float& z, float& o) const;
+};
+
 struct TransportTemplate
 {
     TransportTemplate() : inInstance(false), pathTime(0), accelTime(0.0f), accelDist(0.0f), entry(0) { }
@@ -92,6 +110,7 @@ struct TransportTemplate
     float accelTime;
     float accelDist;
     uint32 entry;
+    TransportTimetable timetable;
 };
 
 class TransportMgr
@@ -116,6 +135,7 @@ class TransportMgr
     private:
         void AddPathNodeToTransport(uint32 transportEntry, uint32 timeSeg, TransportAnimationEntry const* node);
         bool GenerateWaypoints(GameObjectInfo const* goinfo, TransportTemplate& transportTemplate);
+        void GenerateTimetable(GameObjectInfo const* goinfo, TransportTemplate& transportTemplate);
 
         TransportAnimationContainer m_transportAnimations;
         std::unordered_map<uint32, TransportTemplate> m_transportTemplates;
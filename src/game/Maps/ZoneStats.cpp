@@ -0,0 +1,116 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Maps/ZoneStats.h"
+#include "Entities/Player.h"
+#include "World/World.h"
+#include "Util.h"
+
+#include <algorithm>
+
+ZoneStats& ZoneStats::Instance()
+{
+    static ZoneStats instance;
+    return instance;
+}
+
+bool ZoneStats::ShouldSample(uint32 counter)
+{
+    uint32 rate = sWorld.getConfig(CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE);
+    if (!rate)
+        return false;
+
+    // every thread counts down its own events to a random gap averaging the rate,
+    // a fixed gap would pick the same objects each tick when their count is a multiple of it
+    static thread_local uint32 countdown[ZONE_STATS_CATEGORY_COUNT + 1] = {};
+    if (countdown[counter] > 1)
+    {
+        --countdown[counter];
+        return false;
+    }
+
+    countdown[counter] = urand(1, 2 * rate - 1);
+    return true;
+}
+
+ZoneStatsKey ZoneStats::GetKey(WorldObject const* object)
+{
+    ZoneStatsKey key;
+    key.mapId = object->GetMapId();
+    if (object->GetTypeId() == TYPEID_PLAYER)
+    {
+        Player const* player = static_cast<Player const*>(object);
+        key.zoneId = player->GetCachedZoneId();
+        key.areaId = player->GetCachedAreaId();
+    }
+    else
+        object->GetZoneAndAreaId(key.zoneId, key.areaId);
+    return key;
+}
+
+void ZoneStats::RecordTime(ZoneStatsKey const& key, ZoneStatsCategory category, uint64 us)
+{
+    uint32 rate = std::max(sWorld.getConfig(CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE), 1u);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_current[key].us[category] += us * rate;
+}
+
+void ZoneStats::RecordPacket(Player const* player, size_t bytes)
+{
+    if (!ShouldSample(uint32(ZONE_STATS_CATEGORY_COUNT)))
+        return;
+
+    uint32 rate = std::max(sWorld.getConfig(CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE), 1u);
+    ZoneStatsKey key = GetKey(player);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    ZoneStatsCounters& counters = m_current[key];
+    counters.packets += rate;
+    counters.bytes += uint64(bytes) * rate;
+}
+
+void ZoneStats::CloseInterval()
+{
+    Snapshot snapshot;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        snapshot.assign(m_current.begin(), m_current.end());
+        m_current.clear();
+    }
+
+    std::sort(snapshot.begin(), snapshot.end(), [](Snapshot::value_type const& a, Snapshot::value_type const& b)
+    {
+        return a.second.GetUpdateUs() > b.second.GetUpdateUs();
+    });
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_lastInterval.swap(snapshot);
+}
+
+void ZoneStats::GetLastInterval(Snapshot& snapshot) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    snapshot = m_lastInterval;
+}
+
+char const* ZoneStats::GetCategoryName(ZoneStatsCategory category)
+{
+    static char const* categoryNames[ZONE_STATS_CATEGORY_COUNT] = { "players", "objects", "spells", "ai", "visibility" };
+    return category < ZONE_STATS_CATEGORY_COUNT ? categoryNames[category] : "unknown";
+}
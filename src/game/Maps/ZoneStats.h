@@ -0,0 +1,137 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_ZONESTATS_H
+#define MANGOS_ZONESTATS_H
+
+#include "Common.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+class Player;
+class WorldObject;
+
+// parts of the map update attributed to the zone of the updated object
+enum ZoneStatsCategory
+{
+    ZONE_STATS_PLAYERS,                                     // Player::Update
+    ZONE_STATS_OBJECTS,                                     // update of creatures, gameobjects and other grid objects
+    ZONE_STATS_SPELLS,                                      // events and spells of units, part of players and objects
+    ZONE_STATS_AI,                                          // UpdateAI of units, part of players and objects
+    ZONE_STATS_VISIBILITY,                                  // relocation notifies
+    ZONE_STATS_CATEGORY_COUNT
+};
+
+struct ZoneStatsKey
+{
+    uint32 mapId;
+    uint32 zoneId;
+    uint32 areaId;
+
+    bool operator<(ZoneStatsKey const& other) const
+    {
+        if (mapId != other.mapId)
+            return mapId < other.mapId;
+        if (zoneId != other.zoneId)
+            return zoneId < other.zoneId;
+        return areaId < other.areaId;
+    }
+};
+
+// estimates, every sample counts for ZoneStats.SampleRate events
+struct ZoneStatsCounters
+{
+    uint64 us[ZONE_STATS_CATEGORY_COUNT];
+    uint64 packets;
+    uint64 bytes;
+
+    ZoneStatsCounters() : us(), packets(0), bytes(0) {}
+
+    // players and objects include spells and AI
+    uint64 GetUpdateUs() const { return us[ZONE_STATS_PLAYERS] + us[ZONE_STATS_OBJECTS] + us[ZONE_STATS_VISIBILITY]; }
+};
+
+// Sampled map thread time and outbound traffic per map, zone and area, see ZoneStats.SampleRate.
+// Samples are summed up for one minute, the last complete minute is shown by .server zonestats and sent to metrics.
+class ZoneStats
+{
+    public:
+        typedef std::vector<std::pair<ZoneStatsKey, ZoneStatsCounters>> Snapshot;
+
+        static ZoneStats& Instance();
+
+        // true for the events picked by the sample rate on the calling thread, counted per category
+        static bool ShouldSample(ZoneStatsCategory category) { return ShouldSample(uint32(category)); }
+        static ZoneStatsKey GetKey(WorldObject const* object);
+
+        void RecordTime(ZoneStatsKey const& key, ZoneStatsCategory category, uint64 us);
+        // any thread, for a packet sent to the session of player
+        void RecordPacket(Player const* player, size_t bytes);
+
+        // world thread, every minute
+        void CloseInterval();
+        // last complete minute, largest update time first
+        void GetLastInterval(Snapshot& snapshot) const;
+
+        static char const* GetCategoryName(ZoneStatsCategory category);
+
+    private:
+        ZoneStats() {}
+
+        static bool ShouldSample(uint32 counter);
+
+        std::map<ZoneStatsKey, ZoneStatsCounters> m_current;
+        Snapshot m_lastInterval;
+        mutable std::mutex m_lock;                          // samples are rare enough for one lock
+};
+
+#define sZoneStats ZoneStats::Instance()
+
+// Measures the enclosing scope for the zone of object when the event is sampled
+class ZoneStatsScope
+{
+    public:
+        ZoneStatsScope(ZoneStatsCategory category, WorldObject const* object) : m_sampled(ZoneStats::ShouldSample(category)), m_category(category)
+        {
+            if (!m_sampled)
+                return;
+
+            // taken before the update, which may move the object out of the map
+            m_key = ZoneStats::GetKey(object);
+            m_start = std::chrono::steady_clock::now();
+        }
+
+        ~ZoneStatsScope()
+        {
+            if (m_sampled)
+                sZoneStats.RecordTime(m_key, m_category, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+        ZoneStatsScope(ZoneStatsScope const&) = delete;
+        ZoneStatsScope& operator=(ZoneStatsScope const&) = delete;
+
+    private:
+        bool m_sampled;
+        ZoneStatsCategory m_category;
+        ZoneStatsKey m_key;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+#endif
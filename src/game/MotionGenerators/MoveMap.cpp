@@ -21,6 +21,11 @@
 #include "Entities/Creature.h"
 #include "MotionGenerators/MoveMap.h"
 #include "MoveMapSharedDefines.h"
+#include "Util.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <zlib.h>
 
 namespace MMAP
 {
@@ -115,6 +120,19 @@ namespace MMAP
         return false;
     }
 
+    MMapData::MMapData(dtNavMesh* mesh) : navMesh(mesh), preloaded(false) {}
+
+    MMapData::~MMapData()
+    {
+        for (auto& instanceQueries : navMeshQueries)
+            for (auto& navMeshQuerie : instanceQueries.second)
+                dtFreeNavMeshQuery(navMeshQuerie.second);
+
+        // mapped tiles are not owned by the navmesh, their views are released after it
+        if (navMesh)
+            dtFreeNavMesh(navMesh);
+    }
+
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
     {
@@ -216,21 +234,19 @@ namespace MMAP
         uint32 pathLen = sWorld.GetDataPath().length() + strlen("mmaps/%03i%02i%02i.mmtile") + 1;
         char* fileName = new char[pathLen];
         snprintf(fileName, pathLen, (sWorld.GetDataPath() + "mmaps/%03i%02i%02i.mmtile").c_str(), mapId, x, y);
+        std::string tileFile(fileName);
+        delete[] fileName;
 
-        FILE* file = fopen(fileName, "rb");
+        FILE* file = fopen(tileFile.c_str(), "rb");
         if (!file)
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", fileName);
-            delete[] fileName;
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "ERROR: MMAP:loadMap: Could not open mmtile file '%s'", tileFile.c_str());
             return false;
         }
-        delete[] fileName;
 
         // read header
         MmapTileHeader fileHeader;
-        fread(&fileHeader, sizeof(MmapTileHeader), 1, file);
-
-        if (fileHeader.mmapMagic != MMAP_MAGIC)
+        if (fread(&fileHeader, sizeof(MmapTileHeader), 1, file) != 1 || (fileHeader.mmapMagic != MMAP_MAGIC && fileHeader.mmapMagic != MMAP_COMPRESSED_MAGIC))
         {
             sLog.outError("MMAP:loadMap: Bad header in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
@@ -245,37 +261,167 @@ namespace MMAP
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        MANGOS_ASSERT(data);
+        unsigned char* data = nullptr;
+        int tileFlags = DT_TILE_FREE_DATA;
+        std::unique_ptr<boost::interprocess::mapped_region> mapping;
 
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        // compressed tiles cannot be mapped, they are read
+        if (sWorld.getConfig(CONFIG_BOOL_MMAP_MAPPED_TILES) && fileHeader.mmapMagic == MMAP_MAGIC)
         {
-            sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
             fclose(file);
-            return false;
+
+            // detour writes the links of the tile into its data, a private mapping only copies those
+            // pages while vertices, detail meshes and bv tree stay shared with the page cache
+            try
+            {
+                boost::interprocess::file_mapping tileMapping(tileFile.c_str(), boost::interprocess::read_only);
+                mapping.reset(new boost::interprocess::mapped_region(tileMapping, boost::interprocess::copy_on_write, sizeof(MmapTileHeader), fileHeader.size));
+            }
+            catch (boost::interprocess::interprocess_exception const& e)
+            {
+                sLog.outError("MMAP:loadMap: Could not map %03u%02i%02i.mmtile: %s", mapId, x, y, e.what());
+                return false;
+            }
+
+            data = static_cast<unsigned char*>(mapping->get_address());
+            tileFlags = 0;                                  // the mapping owns the data
         }
+        else
+        {
+            data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+            MANGOS_ASSERT(data);
 
-        fclose(file);
+            if (!readTileData(file, fileHeader, data))
+            {
+                sLog.outError("MMAP:loadMap: Bad header or data in mmap %03u%02i%02i.mmtile", mapId, x, y);
+                fclose(file);
+                dtFree(data);
+                return false;
+            }
+
+            fclose(file);
+        }
 
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef);
+        dtStatus dtResult = mmap->navMesh->addTile(data, fileHeader.size, tileFlags, 0, &tileRef);
         if (dtStatusFailed(dtResult))
         {
             sLog.outError("MMAP:loadMap: Could not load %03u%02i%02i.mmtile into navmesh", mapId, x, y);
-            dtFree(data);
+            if (!mapping)
+                dtFree(data);
             return false;
         }
 
+        if (mapping)
+            mmap->tileMappings.emplace(packedGridPos, std::move(mapping));
+
         mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
         ++loadedTiles;
+        loadedTileBytes += fileHeader.size;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
+
+        evictIdleTiles(mmap, mapId);
         return true;
     }
 
+    bool MMapManager::readTileData(FILE* file, MmapTileHeader const& fileHeader, unsigned char* data) const
+    {
+        if (fileHeader.mmapMagic != MMAP_COMPRESSED_MAGIC)
+            return fread(data, fileHeader.size, 1, file) == 1;
+
+        uint32 compressedSize;
+        if (fread(&compressedSize, sizeof(uint32), 1, file) != 1)
+            return false;
+
+        std::vector<Bytef> compressed(compressedSize);
+        if (!compressedSize || fread(compressed.data(), compressedSize, 1, file) != 1)
+            return false;
+
+        uLongf size = fileHeader.size;
+        return uncompress(data, &size, compressed.data(), compressedSize) == Z_OK && size == fileHeader.size;
+    }
+
+    void MMapManager::useTile(uint32 mapId, int32 x, int32 y)
+    {
+        auto itr = loadedMMaps.find(mapId);
+        if (itr != loadedMMaps.end())
+            setTileIdle(itr->second, packTileID(x, y), false);
+    }
+
+    void MMapManager::setTileIdle(MMapData* mmap, uint32 packedGridPos, bool idle)
+    {
+        auto itr = mmap->idleTilePositions.find(packedGridPos);
+        if (itr != mmap->idleTilePositions.end())
+        {
+            mmap->idleTiles.erase(itr->second);
+            mmap->idleTilePositions.erase(itr);
+        }
+
+        if (idle)
+            mmap->idleTilePositions[packedGridPos] = mmap->idleTiles.insert(mmap->idleTiles.end(), packedGridPos);
+    }
+
+    void MMapManager::evictIdleTiles(MMapData* mmap, uint32 mapId)
+    {
+        // only tiles of this map, the navmeshes of other maps may be in use by their map threads now
+        uint64 limit = uint64(sWorld.getConfig(CONFIG_UINT32_MMAP_TILE_MEMORY_LIMIT)) * 1024 * 1024;
+        while (limit && loadedTileBytes > limit && !mmap->idleTiles.empty())
+            removeTile(mmap, mapId, mmap->idleTiles.front());
+    }
+
+    void MMapManager::releaseTile(MMapData* mmap, uint32 packedGridPos)
+    {
+        if (dtMeshTile const* tile = mmap->navMesh->getTileByRef(mmap->mmapLoadedTiles[packedGridPos]))
+            loadedTileBytes -= tile->dataSize;
+
+        // removeTile does not free data of mapped tiles, their view goes now
+        mmap->tileMappings.erase(packedGridPos);
+    }
+
+    void MMapManager::preloadMaps(std::string const& mapIds, uint64 memoryLimit)
+    {
+        std::vector<uint32> maps;
+        for (auto& idStr : StrSplit(mapIds, ","))
+            if (!idStr.empty())
+                maps.push_back(uint32(atoi(idStr.c_str())));
+
+        if (maps.empty())
+            return;
+
+        uint64 startBytes = loadedTileBytes;
+        uint32 startTiles = loadedTiles;
+        for (uint32 mapId : maps)
+        {
+            if (!loadMapData(mapId))
+                continue;
+
+            MMapData* mmap = loadedMMaps[mapId];
+            for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+            {
+                for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+                {
+                    if (memoryLimit && loadedTileBytes - startBytes >= memoryLimit)
+                    {
+                        sLog.outError("MMAP:preloadMaps: Memory limit of " UI64FMTD " bytes reached at map %03u, remaining tiles load on demand", memoryLimit, mapId);
+                        sLog.outString(">> Preloaded %u navmesh tiles using " UI64FMTD " bytes", loadedTiles - startTiles, loadedTileBytes - startBytes);
+                        return;
+                    }
+
+                    // no grid uses the tile yet
+                    if (mmap->mmapLoadedTiles.find(packTileID(x, y)) == mmap->mmapLoadedTiles.end() && loadMap(mapId, x, y))
+                        setTileIdle(mmap, packTileID(x, y), true);
+                }
+            }
+
+            mmap->preloaded = true;
+        }
+
+        sLog.outString(">> Preloaded %u navmesh tiles using " UI64FMTD " bytes", loadedTiles - startTiles, loadedTileBytes - startBytes);
+    }
+
     void MMapManager::loadAllGameObjectModels(std::vector<uint32> const& displayIds)
     {
         for (uint32 displayId : displayIds)
@@ -370,7 +516,25 @@ namespace MMAP
             return false;
         }
 
+        if (mmap->preloaded)
+        {
+            // stays loaded while tiles use less than mmap.tileMemoryLimit
+            setTileIdle(mmap, packedGridPos, true);
+            evictIdleTiles(mmap, mapId);
+            return false;
+        }
+
+        return removeTile(mmap, mapId, packedGridPos);
+    }
+
+    bool MMapManager::removeTile(MMapData* mmap, uint32 mapId, uint32 packedGridPos)
+    {
+        uint32 x = (packedGridPos >> 16);
+        uint32 y = (packedGridPos & 0x0000FFFF);
+
         dtTileRef tileRef = mmap->mmapLoadedTiles[packedGridPos];
+        releaseTile(mmap, packedGridPos);
+        setTileIdle(mmap, packedGridPos, false);
 
         // unload, and mark as non loaded
         dtStatus dtResult = mmap->navMesh->removeTile(tileRef, nullptr, nullptr);
@@ -404,10 +568,15 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = loadedMMaps[mapId];
+        if (mmap->preloaded)
+            return false;
+
         for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
         {
             uint32 x = (i->first >> 16);
             uint32 y = (i->first & 0x0000FFFF);
+            if (dtMeshTile const* tile = mmap->navMesh->getTileByRef(i->second))
+                loadedTileBytes -= tile->dataSize;
             dtStatus dtResult = mmap->navMesh->removeTile(i->second, nullptr, nullptr);
             if (dtStatusFailed(dtResult))
                 sLog.outError("MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
@@ -436,16 +605,18 @@ namespace MMAP
         }
 
         MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        std::lock_guard<std::mutex> guard(mmap->navMeshQueriesLock);
+        auto itr = mmap->navMeshQueries.find(instanceId);
+        if (itr == mmap->navMeshQueries.end())
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
             return false;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
+        for (auto& threadQuery : itr->second)
+            dtFreeNavMeshQuery(threadQuery.second);
 
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
+        mmap->navMeshQueries.erase(itr);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
 
         return true;
@@ -473,7 +644,13 @@ namespace MMAP
             return nullptr;
 
         MMapData* mmap = loadedMMaps[mapId];
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        auto threadId = std::this_thread::get_id();
+
+        // held only for the lookup, the query itself is used by this thread alone
+        std::lock_guard<std::mutex> guard(mmap->navMeshQueriesLock);
+        NavMeshThreadQuerySet& threadQueries = mmap->navMeshQueries[instanceId];
+        auto itr = threadQueries.find(threadId);
+        if (itr == threadQueries.end())
         {
             // allocate mesh query
             dtNavMeshQuery* query = dtAllocNavMeshQuery();
@@ -486,11 +663,11 @@ namespace MMAP
                 return nullptr;
             }
 
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u (%u threads)", mapId, instanceId, uint32(threadQueries.size() + 1));
+            itr = threadQueries.emplace(threadId, query).first;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        return itr->second;
     }
 
     dtNavMeshQuery const* MMapManager::GetModelNavMeshQuery(uint32 displayId)
@@ -23,9 +23,15 @@
 #include <Detour/Include/DetourAlloc.h>
 #include <Detour/Include/DetourNavMesh.h>
 #include <Detour/Include/DetourNavMeshQuery.h>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 class Unit;
+struct MmapTileHeader;
+
+namespace boost { namespace interprocess { class mapped_region; } }
 
 //  memory management
 inline void* dtCustomAlloc(size_t size, dtAllocHint /*hint*/)
@@ -42,27 +48,29 @@ inline void dtCustomFree(void* ptr)
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint32, std::unique_ptr<boost::interprocess::mapped_region>> MMapTileMappingSet;
+    typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshThreadQuerySet;
+    typedef std::unordered_map<uint32, NavMeshThreadQuerySet> NavMeshQuerySet;
     typedef std::unordered_map<std::thread::id, dtNavMeshQuery*> NavMeshGOQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
-        ~MMapData()
-        {
-            for (auto& navMeshQuerie : navMeshQueries)
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-
-            if (navMesh)
-                dtFreeNavMesh(navMesh);
-        }
+        MMapData(dtNavMesh* mesh);
+        ~MMapData();
 
         dtNavMesh* navMesh;
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery is not thread safe, every thread pathing in an instance gets its own one
+        NavMeshQuerySet navMeshQueries;     // instanceId to thread to query
+        std::mutex navMeshQueriesLock;
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        MMapTileMappingSet tileMappings;    // maps [map grid coords] to the file view a mapped tile lives in
+        bool preloaded;                     // all tiles loaded at startup, they stay until shutdown or mmap.tileMemoryLimit
+
+        // preloaded tiles whose grid is not loaded, least recently used first - the ones mmap.tileMemoryLimit may unload
+        std::list<uint32> idleTiles;
+        std::unordered_map<uint32, std::list<uint32>::iterator> idleTilePositions;
     };
 
     struct MMapGOData
@@ -91,7 +99,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0) {}
+            MMapManager() : loadedTiles(0), loadedTileBytes(0) {}
             ~MMapManager();
 
             bool loadMap(uint32 mapId, int32 x, int32 y);
@@ -101,8 +109,13 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 mapId, uint32 instanceId);
             bool IsMMapIsLoaded(uint32 mapId, uint32 x, uint32 y) const;
+            // the grid of an already loaded tile was loaded
+            void useTile(uint32 mapId, int32 x, int32 y);
+
+            // load every tile of the listed maps now, stops once memoryLimit bytes are used
+            void preloadMaps(std::string const& mapIds, uint64 memoryLimit);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread, do not pass it to another one
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
@@ -113,9 +126,15 @@ namespace MMAP
         private:
             bool loadMapData(uint32 mapId);
             uint32 packTileID(int32 x, int32 y) const;
+            void releaseTile(MMapData* mmap, uint32 packedGridPos);
+            bool removeTile(MMapData* mmap, uint32 mapId, uint32 packedGridPos);
+            void setTileIdle(MMapData* mmap, uint32 packedGridPos, bool idle);
+            void evictIdleTiles(MMapData* mmap, uint32 mapId);
+            bool readTileData(FILE* file, MmapTileHeader const& fileHeader, unsigned char* data) const;
 
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            uint64 loadedTileBytes;
 
             std::unordered_map<uint32, MMapGOData*> m_loadedModels;
             std::mutex m_modelsMutex;
@@ -23,8 +23,10 @@
 #include <Detour/Include/DetourNavMesh.h>
 
 #define MMAP_MAGIC 0x4d4d4150   // 'MMAP'
+#define MMAP_COMPRESSED_MAGIC 0x4d4d415a   // 'MMAZ' - a uint32 with the zlib compressed size and the compressed data follow the header
 #define MMAP_VERSION 6
 
+// size is always the size of the Detour tile data, also for compressed tiles
 struct MmapTileHeader
 {
     uint32 mmapMagic;
@@ -19,10 +19,53 @@
 #include "MotionGenerators/MovementGenerator.h"
 #include "Entities/Unit.h"
 
+template <size_t Size>
+using MovementGeneratorPool = MaNGOS::BlockPool<MovementGenerator, Size, 1024>;
+
 MovementGenerator::~MovementGenerator()
 {
 }
 
+void* MovementGenerator::operator new(size_t size)
+{
+    if (size <= 128)
+        return MovementGeneratorPool<128>::Allocate();
+    if (size <= 256)
+        return MovementGeneratorPool<256>::Allocate();
+    if (size <= 512)
+        return MovementGeneratorPool<512>::Allocate();
+    return ::operator new(size);
+}
+
+void MovementGenerator::operator delete(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    // size is the one of the dynamic type, the destructor is virtual
+    if (size <= 128)
+        MovementGeneratorPool<128>::Deallocate(ptr);
+    else if (size <= 256)
+        MovementGeneratorPool<256>::Deallocate(ptr);
+    else if (size <= 512)
+        MovementGeneratorPool<512>::Deallocate(ptr);
+    else
+        ::operator delete(ptr);
+}
+
+MaNGOS::ObjectPoolStats MovementGenerator::GetPoolStats()
+{
+    MaNGOS::ObjectPoolStats stats = MovementGeneratorPool<128>::GetStats();
+    for (MaNGOS::ObjectPoolStats const& classStats : { MovementGeneratorPool<256>::GetStats(), MovementGeneratorPool<512>::GetStats() })
+    {
+        stats.inUse += classStats.inUse;
+        stats.cached += classStats.cached;
+        stats.systemAllocations += classStats.systemAllocations;
+        stats.reuses += classStats.reuses;
+    }
+    return stats;
+}
+
 bool MovementGenerator::IsActive(Unit& u)
 {
     // When movement generator list modified from Update movegen object erase delayed,
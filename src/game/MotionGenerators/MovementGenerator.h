@@ -24,6 +24,7 @@
 #include "MotionGenerators/MotionMaster.h"
 #include "Timer.h"
 #include "Globals/SharedDefines.h"
+#include "Utilities/ObjectPool.h"
 
 class Unit;
 class Creature;
@@ -34,6 +35,12 @@ class MovementGenerator
     public:
         virtual ~MovementGenerator();
 
+        // generators are created and dropped on every chase, evade and reset, so all types take their memory
+        // from per thread free lists of a few size classes, larger ones use the global allocator
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr, size_t size);
+        static MaNGOS::ObjectPoolStats GetPoolStats();
+
         // called before adding movement generator to motion stack
         virtual void Initialize(Unit&) = 0;
         // called aftre remove movement generator from motion stack
@@ -331,12 +331,28 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
     recv_data >> movementInfo;
     /*----------------*/
 
+    size_t const payloadSize = recv_data.rpos();
+    MovementFlags const receivedFlags = movementInfo.GetMovementFlags();
+    Position const receivedPos = movementInfo.GetPos();
+
     if (!ProcessMovementInfo(movementInfo, mover, plMover, recv_data))
         return;
 
-    WorldPacket data(opcode, recv_data.size());
+    WorldPacket data(opcode, mover->GetPackGUID().size() + recv_data.size());
     data << mover->GetPackGUID();                           // write guid
-    movementInfo.Write(data);                               // write data
+
+    // relay the client payload as read unless processing corrected it, Write would produce the same bytes
+    // except for the time, client time is replaced by server time behind the movement flags
+    Position const& pos = movementInfo.GetPos();
+    if (movementInfo.GetMovementFlags() == receivedFlags && pos.x == receivedPos.x && pos.y == receivedPos.y && pos.z == receivedPos.z && pos.o == receivedPos.o)
+    {
+        size_t const timePos = data.wpos() + sizeof(uint32) + sizeof(uint8);
+        data.append(recv_data.contents(), payloadSize);
+        data.put<uint32>(timePos, movementInfo.stime);
+    }
+    else
+        movementInfo.Write(data);                           // write data
+
     mover->SendMessageToSetExcept(data, _player);
 }
 
@@ -603,7 +619,7 @@ void WorldSession::HandleMoveRootAck(WorldPacket& recv_data)
     if (!ProcessMovementInfo(movementInfo, mover, _player, recv_data))
         return;
 
-    WorldPacket data(recv_data.GetOpcode() == CMSG_FORCE_MOVE_UNROOT_ACK ? MSG_MOVE_UNROOT : MSG_MOVE_ROOT);
+    WorldPacket data(recv_data.GetOpcode() == CMSG_FORCE_MOVE_UNROOT_ACK ? MSG_MOVE_UNROOT : MSG_MOVE_ROOT, 9 + recv_data.size());
     data << guid.WriteAsPacked();
     data << movementInfo;
     mover->SendMessageToSetExcept(data, _player);
@@ -0,0 +1,118 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "MotionGenerators/PathCorridorCache.h"
+#include "Policies/Singleton.h"
+#include "World/World.h"
+
+#include <algorithm>
+
+// keep the lists short, the polygon search in them is linear
+static const size_t MAX_CORRIDORS_PER_END = 4;
+static const size_t MAX_CORRIDOR_ENDS = 256;
+
+size_t PathCorridorCache::KeyHash::operator()(Key const& key) const
+{
+    size_t hash = std::hash<dtNavMesh const*>()(key.navMesh);
+    hash = hash * 31 + std::hash<dtPolyRef>()(key.endPoly);
+    hash = hash * 31 + (key.includeFlags << 16 | key.excludeFlags);
+    return hash * 31 + key.maxLength;
+}
+
+bool PathCorridorCache::Find(Key const& key, dtPolyRef startPoly, dtPolyRef* path, uint32& length)
+{
+    uint32 lifetime = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_LIFETIME);
+    if (!lifetime)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    auto itr = m_corridors.find(key);
+    if (itr == m_corridors.end())
+        return false;
+
+    uint32 now = World::GetCurrentMSTime();
+    CorridorList& list = itr->second;
+    for (auto corridor = list.begin(); corridor != list.end();)
+    {
+        if (WorldTimer::getMSTimeDiff(corridor->time, now) > lifetime)
+        {
+            // the list is ordered by age, all following ones are older
+            list.erase(corridor, list.end());
+            break;
+        }
+
+        auto start = std::find(corridor->path.begin(), corridor->path.end(), startPoly);
+        if (start == corridor->path.end())
+        {
+            ++corridor;
+            continue;
+        }
+
+        // refs of an unloaded tile fail here thanks to their salt
+        if (!std::all_of(start, corridor->path.end(), [&key](dtPolyRef ref) { return key.navMesh->isValidPolyRef(ref); }))
+        {
+            corridor = list.erase(corridor);
+            continue;
+        }
+
+        std::copy(start, corridor->path.end(), path);
+        length = uint32(corridor->path.end() - start);
+        return true;
+    }
+
+    if (list.empty())
+        m_corridors.erase(itr);
+
+    return false;
+}
+
+void PathCorridorCache::Store(Key const& key, dtPolyRef const* path, uint32 length)
+{
+    uint32 lifetime = sWorld.getConfig(CONFIG_UINT32_PATH_FIND_CACHE_LIFETIME);
+    if (!lifetime || !length)
+        return;
+
+    uint32 now = World::GetCurrentMSTime();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_corridors.size() >= MAX_CORRIDOR_ENDS && m_corridors.find(key) == m_corridors.end())
+    {
+        for (auto itr = m_corridors.begin(); itr != m_corridors.end();)
+        {
+            if (itr->second.empty() || WorldTimer::getMSTimeDiff(itr->second.front().time, now) > lifetime)
+                itr = m_corridors.erase(itr);
+            else
+                ++itr;
+        }
+
+        if (m_corridors.size() >= MAX_CORRIDOR_ENDS)
+            return;
+    }
+
+    CorridorList& list = m_corridors[key];
+    if (list.size() >= MAX_CORRIDORS_PER_END)
+        list.pop_back();
+
+    list.insert(list.begin(), Corridor{ std::vector<dtPolyRef>(path, path + length), now });
+}
+
+void PathCorridorCache::Invalidate()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_corridors.clear();
+}
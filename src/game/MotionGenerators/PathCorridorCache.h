@@ -0,0 +1,77 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_PATH_CORRIDOR_CACHE_H
+#define MANGOS_PATH_CORRIDOR_CACHE_H
+
+#include "Common.h"
+
+#include <Detour/Include/DetourNavMesh.h>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// corridors found by recent findPath searches on one map, a pack of creatures chasing the same target
+// ends on the same polygon and mostly starts on a polygon of a corridor found for another one of them,
+// the A* search is then replaced by taking the tail of that corridor
+class PathCorridorCache
+{
+    public:
+        struct Key
+        {
+            dtNavMesh const* navMesh;
+            dtPolyRef endPoly;
+            uint16 includeFlags;
+            uint16 excludeFlags;
+            uint32 maxLength;
+
+            bool operator==(Key const& other) const
+            {
+                return navMesh == other.navMesh && endPoly == other.endPoly && includeFlags == other.includeFlags &&
+                    excludeFlags == other.excludeFlags && maxLength == other.maxLength;
+            }
+        };
+
+        // copies the part from startPoly to the end of a recent corridor ending as described by key
+        bool Find(Key const& key, dtPolyRef startPoly, dtPolyRef* path, uint32& length);
+        void Store(Key const& key, dtPolyRef const* path, uint32 length);
+
+        // gameobject collision changed, corridors may now lead through a closed door
+        void Invalidate();
+
+    private:
+        struct KeyHash
+        {
+            size_t operator()(Key const& key) const;
+        };
+
+        struct Corridor
+        {
+            std::vector<dtPolyRef> path;
+            uint32 time;
+        };
+
+        // newest first, several creatures coming from different sides keep their own corridor
+        typedef std::vector<Corridor> CorridorList;
+
+        std::mutex m_lock;                                  // parallel cell updates search paths concurrently
+        std::unordered_map<Key, CorridorList, KeyHash> m_corridors;
+};
+
+#endif
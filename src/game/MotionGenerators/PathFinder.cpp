@@ -20,9 +20,12 @@
 #include "Maps/GridMap.h"
 #include "Entities/Creature.h"
 #include "MotionGenerators/PathFinder.h"
+#include "MotionGenerators/PathCorridorCache.h"
+#include "Maps/Map.h"
 #include "Log.h"
 #include "World/World.h"
 #include "Entities/Transports.h"
+#include "Trace.h"
 #include <Detour/Include/DetourCommon.h>
 #include <Detour/Include/DetourMath.h>
 
@@ -85,6 +88,7 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
 bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool forceDest/* = false*/, bool straightLine/* = false*/)
 {
+    TRACE_ZONE_ID("PathFinder::calculate", m_sourceUnit->GetEntry());
     if (!MaNGOS::IsValidMapCoord(dest.x, dest.y, dest.z))
         return false;
 
@@ -92,13 +96,13 @@ bool PathFinder::calculate(Vector3 const& start, Vector3 const& dest, bool force
         return false;
 
 #ifdef BUILD_METRICS
-    metric::duration<std::chrono::microseconds> meas("pathfinder.calculate", {
+    auto meas = metric::make_slow_span<std::chrono::microseconds>("pathfinder.calculate", 1000, [&] { return std::map<std::string, std::string> {
         { "entry", std::to_string(m_sourceUnit->GetEntry()) },
         { "guid", std::to_string(m_sourceUnit->GetGUIDLow()) },
         { "unit_type", std::to_string(m_sourceUnit->GetGUIDHigh()) },
         { "map_id", std::to_string(m_sourceUnit->GetMapId()) },
         { "instance_id", std::to_string(m_sourceUnit->GetInstanceId()) }
-    }, 1000);
+    }; });
 #endif
 
     //if (GenericTransport* transport = m_sourceUnit->GetTransport())
@@ -455,15 +459,30 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
 
         if (!m_straightLine)
         {
-            dtResult = m_navMeshQuery->findPath(
-                    startPoly,          // start polygon
-                    endPoly,            // end polygon
-                    startPoint,         // start position
-                    endPoint,           // end position
-                    &m_filter,          // polygon search filter
-                    m_pathPolyRefs.data(), // [out] path
-                    (int*)&m_polyLength,
-                    m_pointPathLimit);   // max number of polygons in output path
+            // the tail of a corridor found by another unit of this map is only smoothed by BuildPointPath
+            PathCorridorCache& corridorCache = m_sourceUnit->GetMap()->GetPathCorridorCache();
+            PathCorridorCache::Key cacheKey = { m_navMesh, endPoly, m_filter.getIncludeFlags(), m_filter.getExcludeFlags(), m_pointPathLimit };
+            if (corridorCache.Find(cacheKey, startPoly, m_pathPolyRefs.data(), m_polyLength))
+            {
+                DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: corridor of %u polys taken from cache\n", m_polyLength);
+                dtResult = DT_SUCCESS;
+            }
+            else
+            {
+                dtResult = m_navMeshQuery->findPath(
+                        startPoly,          // start polygon
+                        endPoly,            // end polygon
+                        startPoint,         // start position
+                        endPoint,           // end position
+                        &m_filter,          // polygon search filter
+                        m_pathPolyRefs.data(), // [out] path
+                        (int*)&m_polyLength,
+                        m_pointPathLimit);   // max number of polygons in output path
+
+                // partial corridors depend on where the search gave up, only share complete ones
+                if (dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) && m_polyLength && m_pathPolyRefs[m_polyLength - 1] == endPoly)
+                    corridorCache.Store(cacheKey, m_pathPolyRefs.data(), m_polyLength);
+            }
         }
         else
         {
@@ -23,6 +23,8 @@
 #include "Entities/TemporarySpawn.h"
 #include "AI/BaseAI/UnitAI.h"
 #include "Entities/Player.h"
+#include "Maps/Map.h"
+#include "World/World.h"
 
 #include <algorithm>
 
@@ -326,8 +328,13 @@ void TaxiMovementGenerator::Finalize(Unit& unit)
     unit.RemoveFlag(UNIT_FIELD_FLAGS, (UNIT_FLAG_CLIENT_CONTROL_LOST | UNIT_FLAG_TAXI_FLIGHT));
 
     if (unit.GetTypeId() == TYPEID_PLAYER)
+    {
         unit.RemoveFlag(PLAYER_FLAGS, PLAYER_FLAGS_TAXI_BENCHMARK);
 
+        if (unit.IsInWorld() && !sWorld.getConfig(CONFIG_BOOL_TAXI_LOAD_GRIDS))
+            unit.GetMap()->ActivateGridAfterTaxiFlight(static_cast<Player*>(&unit));
+    }
+
     // Client-controlled unit should have control restored
     if (const Player* controllingClientPlayer = unit.GetClientControlling())
         controllingClientPlayer->UpdateClientControl(&unit, true);
@@ -43,7 +43,118 @@ struct WaypointNode
         : x(_x), y(_y), z(_z), orientation(_o), delay(_delay), script_id(_script_id) {}
 };
 
-typedef std::map<uint32 /*pointId*/, WaypointNode> WaypointPath;
+// Nodes of a path ordered by point id in one array, with the map interface the movement generators and .wp commands use.
+// Iterators are positions in the array, so stepping to the next node is an index increment, std::next is constant time,
+// and an iterator held by a movement generator stays in range of the path when .wp commands add nodes meanwhile.
+class WaypointPath
+{
+    public:
+        typedef std::pair<uint32 /*pointId*/, WaypointNode> value_type;
+
+        template<typename PathType, typename ValueType>
+        class Iterator
+        {
+            public:
+                typedef std::random_access_iterator_tag iterator_category;
+                typedef WaypointPath::value_type value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef ValueType* pointer;
+                typedef ValueType& reference;
+
+                Iterator() : m_path(nullptr), m_index(0) {}
+                Iterator(PathType* path, size_t index) : m_path(path), m_index(index) {}
+                // iterator to const_iterator
+                template<typename OtherPath, typename OtherValue>
+                Iterator(Iterator<OtherPath, OtherValue> const& other) : m_path(other.m_path), m_index(other.m_index) {}
+
+                reference operator*() const { return m_path->m_nodes[m_index]; }
+                pointer operator->() const { return &m_path->m_nodes[m_index]; }
+                reference operator[](difference_type n) const { return m_path->m_nodes[m_index + n]; }
+
+                Iterator& operator++() { ++m_index; return *this; }
+                Iterator& operator--() { --m_index; return *this; }
+                Iterator operator++(int) { Iterator tmp = *this; ++m_index; return tmp; }
+                Iterator operator--(int) { Iterator tmp = *this; --m_index; return tmp; }
+                Iterator& operator+=(difference_type n) { m_index += n; return *this; }
+                Iterator& operator-=(difference_type n) { m_index -= n; return *this; }
+                Iterator operator+(difference_type n) const { return Iterator(m_path, m_index + n); }
+                Iterator operator-(difference_type n) const { return Iterator(m_path, m_index - n); }
+                difference_type operator-(Iterator const& other) const { return difference_type(m_index) - difference_type(other.m_index); }
+
+                bool operator==(Iterator const& other) const { return m_index == other.m_index && m_path == other.m_path; }
+                bool operator!=(Iterator const& other) const { return !(*this == other); }
+                bool operator<(Iterator const& other) const { return m_index < other.m_index; }
+                bool operator>(Iterator const& other) const { return m_index > other.m_index; }
+                bool operator<=(Iterator const& other) const { return m_index <= other.m_index; }
+                bool operator>=(Iterator const& other) const { return m_index >= other.m_index; }
+
+            private:
+                template<typename, typename> friend class Iterator;
+
+                PathType* m_path;
+                size_t m_index;
+        };
+
+        typedef Iterator<WaypointPath, value_type> iterator;
+        typedef Iterator<WaypointPath const, value_type const> const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, m_nodes.size()); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_nodes.size()); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+        size_t size() const { return m_nodes.size(); }
+        bool empty() const { return m_nodes.empty(); }
+        void clear() { m_nodes.clear(); }
+
+        iterator lower_bound(uint32 pointId) { return iterator(this, LowerBound(pointId)); }
+        const_iterator lower_bound(uint32 pointId) const { return const_iterator(this, LowerBound(pointId)); }
+        iterator find(uint32 pointId) { return iterator(this, Find(pointId)); }
+        const_iterator find(uint32 pointId) const { return const_iterator(this, Find(pointId)); }
+
+        // nodes are loaded in point order, so adding them appends
+        WaypointNode& operator[](uint32 pointId) { return emplace(pointId, WaypointNode()).first->second; }
+
+        std::pair<iterator, bool> emplace(uint32 pointId, WaypointNode const& node)
+        {
+            size_t index = LowerBound(pointId);
+            if (index < m_nodes.size() && m_nodes[index].first == pointId)
+                return std::make_pair(iterator(this, index), false);
+
+            m_nodes.emplace(m_nodes.begin() + index, pointId, node);
+            return std::make_pair(iterator(this, index), true);
+        }
+
+        size_t erase(uint32 pointId)
+        {
+            size_t index = Find(pointId);
+            if (index == m_nodes.size())
+                return 0;
+
+            m_nodes.erase(m_nodes.begin() + index);
+            return 1;
+        }
+
+    private:
+        size_t LowerBound(uint32 pointId) const
+        {
+            return std::lower_bound(m_nodes.begin(), m_nodes.end(), pointId, [](value_type const& node, uint32 id) { return node.first < id; }) - m_nodes.begin();
+        }
+
+        size_t Find(uint32 pointId) const
+        {
+            size_t index = LowerBound(pointId);
+            return index < m_nodes.size() && m_nodes[index].first == pointId ? index : m_nodes.size();
+        }
+
+        std::vector<value_type> m_nodes;
+};
 
 class WaypointManager
 {
@@ -58,6 +58,19 @@ namespace Movement
         return c;
     }
 
+    Vector3 MoveSpline::ComputePositionAhead(int32 msAhead) const
+    {
+        MANGOS_ASSERT(Initialized());
+
+        int32 duration = Duration();
+        if (duration <= 0)
+            return ComputePosition();
+
+        Vector3 c;
+        spline.evaluate_percent(std::min(1.f, float(time_passed + msAhead) / duration), c);
+        return c;
+    }
+
     void MoveSpline::computeFallElevation(float& el) const
     {
         float z_now = spline.getPoint(spline.first()).z - Movement::computeFallElevation(MSToSec(time_passed));
@@ -118,6 +118,8 @@ namespace Movement
             }
 
             Location ComputePosition() const;
+            // position on the path after moving for another msAhead, ignores vertical and cyclic motion
+            Vector3 ComputePositionAhead(int32 msAhead) const;
 
             uint32 GetId() const { return m_Id;}
             bool Finalized() const { return splineflags.done; }
@@ -123,7 +123,7 @@ namespace Movement
         }
 
         PacketBuilder::WriteMonsterMove(move_spline, data);
-        unit.SendMessageToAllWhoSeeMe(data, true);
+        unit.SendMonsterMoveToAllWhoSeeMe(data);
 
         return move_spline.Duration();
     }
@@ -183,7 +183,7 @@ namespace Movement
         data << real_position.x << real_position.y << real_position.z;
         data << move_spline.GetId();
         data << uint8(MonsterMoveStop);
-        unit.SendMessageToAllWhoSeeMe(data, true);
+        unit.SendMonsterMoveToAllWhoSeeMe(data);
     }
 
     MoveSplineInit::MoveSplineInit(Unit& m) : unit(m)
@@ -27,12 +27,20 @@ namespace Movement
         b << v.x << v.y << v.z;
     }
 
+    inline void operator << (ByteBufferWriter& b, const Vector3& v)
+    {
+        b << v.x << v.y << v.z;
+    }
+
     inline void operator >> (ByteBuffer& b, Vector3& v)
     {
         b >> v.x >> v.y >> v.z;
     }
 
-    void PacketBuilder::WriteCommonMonsterMovePart(const MoveSpline& move_spline, WorldPacket& data)
+    // start point, id, facing of at most a point, flags and duration
+    static const size_t MONSTER_MOVE_COMMON_MAX_SIZE = 12 + 4 + 1 + 12 + 4 + 4;
+
+    void PacketBuilder::WriteCommonMonsterMovePart(const MoveSpline& move_spline, ByteBufferWriter& data)
     {
         MoveSplineFlag splineflags = move_spline.splineflags;
 
@@ -69,7 +77,7 @@ namespace Movement
         data << move_spline.Duration();
     }
 
-    void WriteLinearPath(const Spline<int32>& spline, ByteBuffer& data)
+    void WriteLinearPath(const Spline<int32>& spline, ByteBufferWriter& data)
     {
         uint32 last_idx = spline.getPointCount() - 3;
         const Vector3* real_path = &spline.getPoint(1);
@@ -83,30 +91,33 @@ namespace Movement
             for (uint32 i = 1; i < last_idx; ++i)
             {
                 Vector3 offset = middle - real_path[i];
-                data.appendPackXYZ(offset.x, offset.y, offset.z);
+                data.AppendPackXYZ(offset.x, offset.y, offset.z);
             }
         }
     }
 
-    void WriteCatmullRomPath(const Spline<int32>& spline, ByteBuffer& data)
+    void WriteCatmullRomPath(const Spline<int32>& spline, ByteBufferWriter& data)
     {
         uint32 count = spline.getPointCount() - 3;
         data << count;
-        data.append<Vector3>(&spline.getPoint(2), count);
+        data.Append(&spline.getPoint(2), count * sizeof(Vector3));
     }
 
-    void WriteCatmullRomCyclicPath(Spline<int32> const& spline, ByteBuffer& data)
+    void WriteCatmullRomCyclicPath(Spline<int32> const& spline, ByteBufferWriter& data)
     {
         uint32 count = spline.getPointCount() - 4;
         data << count;
-        data.append<Vector3>(&spline.getPoint(2), count);
+        data.Append(&spline.getPoint(2), count * sizeof(Vector3));
     }
 
-    void PacketBuilder::WriteMonsterMove(const MoveSpline& move_spline, WorldPacket& data)
+    void PacketBuilder::WriteMonsterMove(const MoveSpline& move_spline, WorldPacket& packet)
     {
+        const Spline<int32>& spline = move_spline.spline;
+
+        // a path takes at most a count, the destination and a full point for every spline point
+        ByteBufferWriter data(packet, MONSTER_MOVE_COMMON_MAX_SIZE + 4 + 12 + spline.getPointCount() * sizeof(Vector3));
         WriteCommonMonsterMovePart(move_spline, data);
 
-        const Spline<int32>& spline = move_spline.spline;
         MoveSplineFlag splineflags = move_spline.splineflags;
         if (splineflags & MoveSplineFlag::Mask_CatmullRom)
         {
@@ -119,8 +130,11 @@ namespace Movement
             WriteLinearPath(spline, data);
     }
 
-    void PacketBuilder::WriteCreate(const MoveSpline& move_spline, ByteBuffer& data)
+    void PacketBuilder::WriteCreate(const MoveSpline& move_spline, ByteBuffer& buffer)
     {
+        // flags, facing of at most a point, times, id, node count, nodes and destination
+        ByteBufferWriter data(buffer, 4 + 12 + 4 + 4 + 4 + 4 + move_spline.getPath().size() * sizeof(Vector3) + 12);
+
         // WriteClientStatus(mov,data);
         // data.append<float>(&mov.m_float_values[SpeedWalk], SpeedMaxCount);
         // if (mov.SplineEnabled())
@@ -148,7 +162,7 @@ namespace Movement
 
             uint32 nodes = move_spline.getPath().size();
             data << nodes;
-            data.append<Vector3>(&move_spline.getPath()[0], nodes);
+            data.Append(&move_spline.getPath()[0], nodes * sizeof(Vector3));
             data << (move_spline.isCyclic() ? Vector3::zero() : move_spline.FinalDestination());
         }
     }
@@ -20,6 +20,7 @@
 #define MANGOSSERVER_PACKET_BUILDER_H
 
 class ByteBuffer;
+class ByteBufferWriter;
 class WorldPacket;
 
 namespace Movement
@@ -27,7 +28,7 @@ namespace Movement
     class MoveSpline;
     class PacketBuilder
     {
-            static void WriteCommonMonsterMovePart(const MoveSpline& move_spline, WorldPacket& data);
+            static void WriteCommonMonsterMovePart(const MoveSpline& move_spline, ByteBufferWriter& data);
         public:
 
             static void WriteMonsterMove(const MoveSpline& move_spline, WorldPacket& data);
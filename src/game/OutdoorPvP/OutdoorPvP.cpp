@@ -37,7 +37,19 @@ void OutdoorPvP::SetGraveYardLinkTeam(uint32 id, uint32 locKey, Team team, uint3
 
 void OutdoorPvP::HandlePlayerEnterZone(Player* player, bool isMainZone)
 {
-    m_zonePlayers[player->GetObjectGuid()] = isMainZone;
+    auto result = m_zonePlayers.insert(GuidZoneMap::value_type(player->GetObjectGuid(), isMainZone));
+    if (!result.second)
+    {
+        if (result.first->second == isMainZone)
+            return;
+
+        if (result.first->second)
+            --m_mainZonePlayerCount;
+        result.first->second = isMainZone;
+    }
+
+    if (isMainZone)
+        ++m_mainZonePlayerCount;
 }
 
 /**
@@ -48,8 +60,13 @@ void OutdoorPvP::HandlePlayerEnterZone(Player* player, bool isMainZone)
  */
 void OutdoorPvP::HandlePlayerLeaveZone(Player* player, bool isMainZone)
 {
-    if (m_zonePlayers.erase(player->GetObjectGuid()))
+    GuidZoneMap::iterator itr = m_zonePlayers.find(player->GetObjectGuid());
+    if (itr != m_zonePlayers.end())
     {
+        if (itr->second)
+            --m_mainZonePlayerCount;
+        m_zonePlayers.erase(itr);
+
         // remove the world state information from the player
         if (isMainZone && !player->GetSession()->PlayerLogout())
             SendRemoveWorldStates(player);
@@ -66,6 +83,10 @@ void OutdoorPvP::HandlePlayerLeaveZone(Player* player, bool isMainZone)
  */
 void OutdoorPvP::SendUpdateWorldState(uint32 field, uint32 value)
 {
+    WorldPacket data(SMSG_UPDATE_WORLD_STATE, 8);
+    data << field;
+    data << value;
+
     for (GuidZoneMap::const_iterator itr = m_zonePlayers.begin(); itr != m_zonePlayers.end(); ++itr)
     {
         // only send world state update to main zone
@@ -73,7 +94,7 @@ void OutdoorPvP::SendUpdateWorldState(uint32 field, uint32 value)
             continue;
 
         if (Player* player = sObjectMgr.GetPlayer(itr->first))
-            player->SendUpdateWorldState(field, value);
+            player->GetSession()->SendPacket(data);
     }
 }
 
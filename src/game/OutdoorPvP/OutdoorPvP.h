@@ -25,6 +25,8 @@
 #include "Globals/SharedDefines.h"
 #include "OutdoorPvPMgr.h"
 
+#include <atomic>
+
 class WorldPacket;
 
 enum CapturePointArtKits
@@ -48,7 +50,7 @@ class OutdoorPvP
         friend class OutdoorPvPMgr;
 
     public:
-        OutdoorPvP() {}
+        OutdoorPvP() : m_mainZonePlayerCount(0) {}
         virtual ~OutdoorPvP() {}
 
         // called when the zone is initialized
@@ -93,6 +95,9 @@ class OutdoorPvP
 
         void SetGraveYardLinkTeam(uint32 id, uint32 locKey, Team team, uint32 mapId);
 
+        // true while a player is in the main zone, capture points of an empty zone are not ticked
+        bool HasPlayersInZone() const { return m_mainZonePlayerCount.load(std::memory_order_relaxed) != 0; }
+
     protected:
 
         // Player related stuff
@@ -123,6 +128,9 @@ class OutdoorPvP
 
         // store the players inside the area
         GuidZoneMap m_zonePlayers;
+
+    private:
+        std::atomic<uint32> m_mainZonePlayerCount;          // players of m_zonePlayers in the main zone
 };
 
 #endif
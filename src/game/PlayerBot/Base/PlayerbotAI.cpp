@@ -19,6 +19,7 @@
 #include <stdarg.h>
 #include "Common.h"
 #include "Log.h"
+#include "Config/Config.h"
 #include "Spells/SpellDefines.h"
 #include "WorldPacket.h"
 #include "Database/DatabaseEnv.h"
@@ -62,6 +63,8 @@
 #include <iomanip>
 #include <iostream>
 
+extern Config botConfig;
+
 // returns a float in range of..
 float rand_float(float low, float high)
 {
@@ -95,7 +98,9 @@ PlayerbotAI::PlayerbotAI(PlayerbotMgr &mgr, Player* const bot, bool debugWhisper
     m_taxiMaster(ObjectGuid()),
     m_ignoreNeutralizeEffect(false),
     m_bDebugCommandChat(false),
-    m_debugWhisper(debugWhisper)
+    m_debugWhisper(debugWhisper),
+    m_lastAIUpdateTime(0),
+    m_aiUpdateDeferred(false)
 {
     // set bot state
     m_botState = BOTSTATE_LOADING;
@@ -1943,12 +1948,9 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
         // Handle chat messages here
         case SMSG_MESSAGECHAT:
         {
-            WorldPacket p(packet);
-            uint8 msgtype;
-            uint32 language;
-
-            p >> msgtype;           // 1 type
-            p >> language;          // 4 language
+            // most chat reaching a bot is not for it, check the header in place before copying the packet
+            uint8 msgtype = packet.read<uint8>(0);          // 1 type
+            uint32 language = packet.read<uint32>(1);       // 4 language
 
             if (language == LANG_ADDON)
                 return;
@@ -1960,6 +1962,10 @@ void PlayerbotAI::HandleBotOutgoingPacket(const WorldPacket& packet)
                 case CHAT_MSG_PARTY:
                 case CHAT_MSG_WHISPER:
                 {
+                    WorldPacket p(packet);
+                    p.read_skip<uint8>();
+                    p.read_skip<uint32>();
+
                     ObjectGuid senderGuid;
                     std::string channelName;
                     uint32 length;
@@ -4964,6 +4970,45 @@ void PlayerbotAI::Announce(AnnounceFlags msg)
 // hasUnitState(FLAG) FLAG like: UNIT_STAT_ROOT, UNIT_STAT_CONFUSED, UNIT_STAT_STUNNED
 // hasAuraType
 
+bool PlayerbotAI::CanUpdateThisTick()
+{
+    uint32 now = WorldTimer::getMSTime();
+
+    // bots in combat ask for an update every tick, this spaces them out
+    static Config::Key const minUpdateIntervalKey = botConfig.Intern("PlayerbotAI.MinUpdateInterval");
+    int32 minInterval = botConfig.GetInt(minUpdateIntervalKey, 0);
+    if (minInterval > 0 && m_lastAIUpdateTime && WorldTimer::getMSTimeDiff(m_lastAIUpdateTime, now) < uint32(minInterval))
+        return false;
+
+    // bots are updated by the map thread of their master, every thread keeps its own budget
+    struct TickBudget
+    {
+        uint32 tick;
+        uint32 used;
+    };
+    static thread_local TickBudget budget = { 0, 0 };
+    if (budget.tick != World::GetCurrentMSTime())
+    {
+        budget.tick = World::GetCurrentMSTime();
+        budget.used = 0;
+    }
+
+    static Config::Key const maxUpdatesPerTickKey = botConfig.Intern("PlayerbotAI.MaxUpdatesPerTick");
+    int32 maxUpdates = botConfig.GetInt(maxUpdatesPerTickKey, 0);
+
+    // a bot deferred once is not deferred again so none of them starves
+    if (maxUpdates > 0 && budget.used >= uint32(maxUpdates) && !m_aiUpdateDeferred)
+    {
+        m_aiUpdateDeferred = true;
+        return false;
+    }
+
+    ++budget.used;
+    m_aiUpdateDeferred = false;
+    m_lastAIUpdateTime = now;
+    return true;
+}
+
 void PlayerbotAI::UpdateAI(const uint32 /*p_time*/)
 {
     if (GetClassAI()->GetWaitUntil() <= CurrentTime())
@@ -4972,8 +5017,12 @@ void PlayerbotAI::UpdateAI(const uint32 /*p_time*/)
     if (CurrentTime() < m_ignoreAIUpdatesUntilTime)
         return;
 
+    if (!CanUpdateThisTick())
+        return;
+
     // default updates occur every two seconds
-    SetIgnoreUpdateTime(2);
+    static Config::Key const idleUpdateIntervalKey = botConfig.Intern("PlayerbotAI.IdleUpdateInterval");
+    SetIgnoreUpdateTime(uint8(std::min(std::max(botConfig.GetInt(idleUpdateIntervalKey, 2), 0), 255)));
 
     if (m_botState == BOTSTATE_LOADING)
     {
@@ -7322,9 +7371,9 @@ void PlayerbotAI::CreatureLocalization(std::string& creatureName, const uint32 e
 
     CreatureLocale const* pCreatureInfo = sObjectMgr.GetCreatureLocale(entry);
     if (pCreatureInfo)
-        if (pCreatureInfo->Name.size() > loc && !pCreatureInfo->Name[loc].empty())
+        if (char const* localeName = sObjectMgr.GetLocaleString(pCreatureInfo->Name, loc))
         {
-            const std::string title = pCreatureInfo->Name[loc];
+            const std::string title = localeName;
             if (Utf8FitTo(title, wnamepart))
                 creatureName = title.c_str();
         }
@@ -9027,6 +9076,15 @@ void PlayerbotAI::_HandleCommandMail(std::string& text, Player& fromPlayer)
             return;
         }
 
+        // mails are loaded from DB at first mailbox open
+        if (!m_bot->IsMailLoaded())
+        {
+            if (m_bot->GetMailLoadState() == PLAYER_MAIL_NOT_LOADED)
+                m_bot->GetSession()->LoadMails();
+            TellMaster("I'm checking my mailbox, ask me again in a moment.");
+            return;
+        }
+
         TellMaster("Inbox:\n");
 
         for (PlayerMails::reverse_iterator itr = m_bot->GetMailRBegin(); itr != m_bot->GetMailREnd(); ++itr)
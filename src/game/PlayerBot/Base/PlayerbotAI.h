@@ -728,6 +728,11 @@ class PlayerbotAI
         // no need to waste CPU cycles during casting etc
         time_t m_ignoreAIUpdatesUntilTime;
 
+        // see PlayerbotAI.MinUpdateInterval and PlayerbotAI.MaxUpdatesPerTick
+        bool CanUpdateThisTick();
+        uint32 m_lastAIUpdateTime;
+        bool m_aiUpdateDeferred;
+
         CombatStyle m_combatStyle;
         CombatOrderType m_combatOrder;
         ResistType m_resistType;
@@ -621,7 +621,8 @@ void PlayerbotMgr::HandleMasterIncomingPacket(const WorldPacket& packet)
                         case GOSSIP_OPTION_VENDOR:
                         {
                             // bot->GetPlayerbotAI()->TellMaster("PlayerbotMgr:GOSSIP_OPTION_VENDOR");
-                            if (!botConfig.GetBoolDefault("PlayerbotAI.SellGarbage", true))
+                            static Config::Key const sellGarbageKey = botConfig.Intern("PlayerbotAI.SellGarbage");
+                            if (!botConfig.GetBool(sellGarbageKey, true))
                                 continue;
 
                             // changed the SellGarbage() function to support ch.SendSysMessaage()
@@ -669,7 +670,8 @@ void PlayerbotMgr::HandleMasterIncomingPacket(const WorldPacket& packet)
 
         case CMSG_LIST_INVENTORY:
         {
-            if (!botConfig.GetBoolDefault("PlayerbotAI.SellGarbage", true))
+            static Config::Key const sellGarbageKey = botConfig.Intern("PlayerbotAI.SellGarbage");
+            if (!botConfig.GetBool(sellGarbageKey, true))
                 return;
 
             WorldPacket p(packet);
@@ -1115,7 +1117,8 @@ bool ChatHandler::HandlePlayerbotCommand(char* args)
 {
     if (!(m_session->GetSecurity() > SEC_PLAYER))
     {
-        if (botConfig.GetBoolDefault("PlayerbotAI.DisableBots", false))
+        static Config::Key const disableBotsKey = botConfig.Intern("PlayerbotAI.DisableBots");
+        if (botConfig.GetBool(disableBotsKey, false))
         {
             PSendSysMessage("|cffff0000Playerbot system is currently disabled!");
             SetSentErrorMessage(true);
@@ -1181,7 +1184,8 @@ bool ChatHandler::HandlePlayerbotCommand(char* args)
     {
         Field* fields = resultchar->Fetch();
         int acctcharcount = fields[0].GetUInt32();
-        int maxnum = botConfig.GetIntDefault("PlayerbotAI.MaxNumBots", 9);
+        static Config::Key const maxNumBotsKey = botConfig.Intern("PlayerbotAI.MaxNumBots");
+        int maxnum = botConfig.GetInt(maxNumBotsKey, 9);
         if (!(m_session->GetSecurity() > SEC_PLAYER))
             if (acctcharcount > maxnum && (cmdStr == "add" || cmdStr == "login"))
             {
@@ -1198,7 +1202,8 @@ bool ChatHandler::HandlePlayerbotCommand(char* args)
     {
         Field* fields = resultlvl->Fetch();
         int charlvl = fields[0].GetUInt32();
-        int maxlvl = botConfig.GetIntDefault("PlayerbotAI.RestrictBotLevel", 80);
+        static Config::Key const restrictBotLevelKey = botConfig.Intern("PlayerbotAI.RestrictBotLevel");
+        int maxlvl = botConfig.GetInt(restrictBotLevelKey, 80);
         uint8 race = fields[2].GetUInt8();
         uint32 team = 0;
 
@@ -28,6 +28,47 @@
 
 INSTANTIATE_SINGLETON_1(PoolManager);
 
+////////////////////////////////////////////////////////////
+// class PoolIdSet
+
+bool PoolIdSet::Insert(uint32 id)
+{
+    if (!m_positions.emplace(id, uint32(m_ids.size())).second)
+        return false;
+
+    m_ids.push_back(id);
+    return true;
+}
+
+bool PoolIdSet::Erase(uint32 id)
+{
+    auto itr = m_positions.find(id);
+    if (itr == m_positions.end())
+        return false;
+
+    // move the last id in the freed slot
+    uint32 pos = itr->second;
+    uint32 lastId = m_ids.back();
+    m_ids[pos] = lastId;
+    m_positions[lastId] = pos;
+
+    m_ids.pop_back();
+    m_positions.erase(id);
+    return true;
+}
+
+uint32 PoolIdSet::PickFrom(uint32 pos)
+{
+    uint32 picked = urand(pos, uint32(m_ids.size()) - 1);
+    if (picked != pos)
+    {
+        std::swap(m_ids[pos], m_ids[picked]);
+        m_positions[m_ids[pos]] = pos;
+        m_positions[m_ids[picked]] = picked;
+    }
+    return m_ids[pos];
+}
+
 ////////////////////////////////////////////////////////////
 // template class SpawnedPoolData
 
@@ -42,14 +83,14 @@ uint32 SpawnedPoolData::GetSpawnedObjects(uint32 pool_id) const
 template<>
 bool SpawnedPoolData::IsSpawnedObject<Creature>(uint32 db_guid) const
 {
-    return mSpawnedCreatures.find(db_guid) != mSpawnedCreatures.end();
+    return mSpawnedCreatures.Contains(db_guid);
 }
 
 // Method that tell if a gameobject is spawned currently
 template<>
 bool SpawnedPoolData::IsSpawnedObject<GameObject>(uint32 db_guid) const
 {
-    return mSpawnedGameobjects.find(db_guid) != mSpawnedGameobjects.end();
+    return mSpawnedGameobjects.Contains(db_guid);
 }
 
 // Method that tell if a pool is spawned currently
@@ -62,14 +103,14 @@ bool SpawnedPoolData::IsSpawnedObject<Pool>(uint32 sub_pool_id) const
 template<>
 void SpawnedPoolData::AddSpawn<Creature>(uint32 db_guid, uint32 pool_id)
 {
-    mSpawnedCreatures.insert(db_guid);
+    mSpawnedCreatures.Insert(db_guid);
     ++mSpawnedPools[pool_id];
 }
 
 template<>
 void SpawnedPoolData::AddSpawn<GameObject>(uint32 db_guid, uint32 pool_id)
 {
-    mSpawnedGameobjects.insert(db_guid);
+    mSpawnedGameobjects.Insert(db_guid);
     ++mSpawnedPools[pool_id];
 }
 
@@ -83,7 +124,7 @@ void SpawnedPoolData::AddSpawn<Pool>(uint32 sub_pool_id, uint32 pool_id)
 template<>
 void SpawnedPoolData::RemoveSpawn<Creature>(uint32 db_guid, uint32 pool_id)
 {
-    mSpawnedCreatures.erase(db_guid);
+    mSpawnedCreatures.Erase(db_guid);
     uint32& val = mSpawnedPools[pool_id];
     if (val > 0)
         --val;
@@ -92,7 +133,7 @@ void SpawnedPoolData::RemoveSpawn<Creature>(uint32 db_guid, uint32 pool_id)
 template<>
 void SpawnedPoolData::RemoveSpawn<GameObject>(uint32 db_guid, uint32 pool_id)
 {
-    mSpawnedGameobjects.erase(db_guid);
+    mSpawnedGameobjects.Erase(db_guid);
     uint32& val = mSpawnedPools[pool_id];
     if (val > 0)
         --val;
@@ -107,6 +148,33 @@ void SpawnedPoolData::RemoveSpawn<Pool>(uint32 sub_pool_id, uint32 pool_id)
         --val;
 }
 
+template<>
+PoolEligibleIndex* SpawnedPoolData::GetEligibleIndex<Creature>(uint32 pool_id, bool create)
+{
+    if (create)
+        return &mEligibleCreatures[pool_id];
+
+    auto itr = mEligibleCreatures.find(pool_id);
+    return itr != mEligibleCreatures.end() ? &itr->second : nullptr;
+}
+
+template<>
+PoolEligibleIndex* SpawnedPoolData::GetEligibleIndex<GameObject>(uint32 pool_id, bool create)
+{
+    if (create)
+        return &mEligibleGameobjects[pool_id];
+
+    auto itr = mEligibleGameobjects.find(pool_id);
+    return itr != mEligibleGameobjects.end() ? &itr->second : nullptr;
+}
+
+// spawned state of a child pool also follows the spawns of its own members, so pools of pools are not indexed
+template<>
+PoolEligibleIndex* SpawnedPoolData::GetEligibleIndex<Pool>(uint32 /*sub_pool_id*/, bool /*create*/)
+{
+    return nullptr;
+}
+
 ////////////////////////////////////////////////////////////
 // Methods of class PoolObject
 template<>
@@ -139,9 +207,85 @@ template <class T>
 void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
 {
     if (poolitem.chance != 0 && maxentries == 1)
+    {
+        MemberSlots[poolitem.guid] = uint32(ExplicitlyChanced.size());
         ExplicitlyChanced.push_back(poolitem);
+    }
     else
+    {
+        MemberSlots[poolitem.guid] = uint32(EqualChanced.size()) | POOL_SLOT_EQUAL_CHANCED;
         EqualChanced.push_back(poolitem);
+    }
+}
+
+template <class T>
+void PoolGroup<T>::RebuildMemberSlots()
+{
+    MemberSlots.clear();
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        MemberSlots[ExplicitlyChanced[i].guid] = i;
+    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+        MemberSlots[EqualChanced[i].guid] = i | POOL_SLOT_EQUAL_CHANCED;
+}
+
+template <class T>
+PoolObject* PoolGroup<T>::FindMember(uint32 guid)
+{
+    auto itr = MemberSlots.find(guid);
+    if (itr == MemberSlots.end())
+        return nullptr;
+
+    if (itr->second & POOL_SLOT_EQUAL_CHANCED)
+        return &EqualChanced[itr->second & ~POOL_SLOT_EQUAL_CHANCED];
+
+    return &ExplicitlyChanced[itr->second];
+}
+
+// Not spawned members of the pool in the map, filled from the spawned state at first use
+template <class T>
+PoolEligibleIndex& PoolGroup<T>::GetEligibleIndex(SpawnedPoolData& spawns)
+{
+    PoolEligibleIndex& index = *spawns.GetEligibleIndex<T>(poolId, true);
+    if (index.isBuilt)
+        return index;
+
+    for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i)
+        if (!spawns.IsSpawnedObject<T>(ExplicitlyChanced[i].guid))
+            index.explicitlyChanced.Insert(i);
+
+    for (uint32 i = 0; i < EqualChanced.size(); ++i)
+        if (!spawns.IsSpawnedObject<T>(EqualChanced[i].guid))
+            index.equalChanced.Insert(i);
+
+    index.isBuilt = true;
+    return index;
+}
+
+// Keep the eligible index of the map in sync with a spawn (state false) or despawn (state true) of a member
+template <class T>
+void PoolGroup<T>::SetEligible(SpawnedPoolData& spawns, PoolObject const* obj, bool state)
+{
+    PoolEligibleIndex* index = spawns.GetEligibleIndex<T>(poolId, false);
+    if (!index || !index->isBuilt)
+        return;
+
+    PoolIdSet* members;
+    uint32 slot;
+    if (!ExplicitlyChanced.empty() && obj >= &ExplicitlyChanced.front() && obj <= &ExplicitlyChanced.back())
+    {
+        members = &index->explicitlyChanced;
+        slot = uint32(obj - &ExplicitlyChanced.front());
+    }
+    else
+    {
+        members = &index->equalChanced;
+        slot = uint32(obj - &EqualChanced.front());
+    }
+
+    if (state)
+        members->Insert(slot);
+    else
+        members->Erase(slot);
 }
 
 // Method to check the chances are proper in this object pool
@@ -195,35 +339,40 @@ void PoolGroup<T>::SetExcludeObject(uint32 guid, bool state)
 template <class T>
 PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, MapPersistentState& mapState)
 {
-    PoolObject* explicitlyObjFound = nullptr;
-    auto gen = GetRandomGenerator();
+    PoolEligibleIndex& index = GetEligibleIndex(spawns);
 
-    if (!ExplicitlyChanced.empty())
-    {
-        float roll = (float)rand_chance();
+    // the object being respawned is still marked as spawned but can be picked again
+    PoolObject* triggerObj = triggerFrom ? FindMember(triggerFrom) : nullptr;
+    if (triggerObj)
+        SetEligible(spawns, triggerObj, true);
 
-        std::vector <PoolObject*> explicitlyChancedVector;
+    PoolObject* obj = RollOneEligible(index, mapState);
 
-        // call memory manager once to reserve enough memory for performance
-        explicitlyChancedVector.reserve(ExplicitlyChanced.size());
+    if (triggerObj)
+        SetEligible(spawns, triggerObj, false);
 
-        // fill new vector with address of object in EqualChanced list
-        std::transform(ExplicitlyChanced.begin(), ExplicitlyChanced.end(), std::back_inserter(explicitlyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
+    return obj;
+}
 
-        // randomize the new vector
-        std::shuffle(explicitlyChancedVector.begin(), explicitlyChancedVector.end(), *gen);
+template <class T>
+PoolObject* PoolGroup<T>::RollOneEligible(PoolEligibleIndex& index, MapPersistentState& mapState)
+{
+    PoolObject* explicitlyObjFound = nullptr;
 
-        for (auto obj : explicitlyChancedVector)
+    if (!index.explicitlyChanced.empty())
+    {
+        float roll = (float)rand_chance();
+
+        // members are visited in random order, only as many as needed
+        for (uint32 i = 0; i < index.explicitlyChanced.size(); ++i)
         {
+            PoolObject* obj = &ExplicitlyChanced[index.explicitlyChanced.PickFrom(i)];
             if (obj->exclude)
                 continue;
 
             if (!CanSpawn(obj, mapState))
                 continue;
 
-            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<T>(obj->guid))
-                continue;
-
             // we found an object but it may have no luck to be picked so we save it in case of no other object have been picked.
             if (!explicitlyObjFound)
                 explicitlyObjFound = obj;
@@ -233,32 +382,16 @@ PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, M
         }
     }
 
-    if (!EqualChanced.empty())
+    for (uint32 i = 0; i < index.equalChanced.size(); ++i)
     {
-        std::vector <PoolObject*> equalyChancedVector;
-
-        // call memory manager once to reserve enough memory for performance
-        equalyChancedVector.reserve(EqualChanced.size());
-
-        // fill new vector with address of object in EqualChanced list
-        std::transform(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(equalyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
-
-        // randomize the new vector
-        std::shuffle(equalyChancedVector.begin(), equalyChancedVector.end(), *gen);
-
-        for (auto obj : equalyChancedVector)
-        {
-            if (obj->exclude)
-                continue;
-
-            if (!CanSpawn(obj, mapState))
-                continue;
+        PoolObject* obj = &EqualChanced[index.equalChanced.PickFrom(i)];
+        if (obj->exclude)
+            continue;
 
-            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<T>(obj->guid))
-                continue;
+        if (!CanSpawn(obj, mapState))
+            continue;
 
-            return obj;
-        }
+        return obj;
     }
 
     // return first explicitly chanced object if there is one
@@ -271,31 +404,39 @@ PoolObject* PoolGroup<T>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, M
 template<class T>
 void PoolGroup<T>::DespawnObject(MapPersistentState& mapState, uint32 guid)
 {
+    SpawnedPoolData& spawns = mapState.GetSpawnedPoolData();
+
+    if (guid)
+    {
+        PoolObject* obj = FindMember(guid);
+        if (obj && spawns.IsSpawnedObject<T>(guid))
+        {
+            Despawn1Object(mapState, guid);
+            spawns.RemoveSpawn<T>(guid, poolId);
+            SetEligible(spawns, obj, true);
+        }
+        return;
+    }
+
     for (size_t i = 0; i < EqualChanced.size(); ++i)
     {
         // if spawned
-        if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(EqualChanced[i].guid))
+        if (spawns.IsSpawnedObject<T>(EqualChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || EqualChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, EqualChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(EqualChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, EqualChanced[i].guid);
+            spawns.RemoveSpawn<T>(EqualChanced[i].guid, poolId);
+            SetEligible(spawns, &EqualChanced[i], true);
         }
     }
 
     for (size_t i = 0; i < ExplicitlyChanced.size(); ++i)
     {
         // spawned
-        if (mapState.GetSpawnedPoolData().IsSpawnedObject<T>(ExplicitlyChanced[i].guid))
+        if (spawns.IsSpawnedObject<T>(ExplicitlyChanced[i].guid))
         {
-            // any or specially requested
-            if (!guid || ExplicitlyChanced[i].guid == guid)
-            {
-                Despawn1Object(mapState, ExplicitlyChanced[i].guid);
-                mapState.GetSpawnedPoolData().RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
-            }
+            Despawn1Object(mapState, ExplicitlyChanced[i].guid);
+            spawns.RemoveSpawn<T>(ExplicitlyChanced[i].guid, poolId);
+            SetEligible(spawns, &ExplicitlyChanced[i], true);
         }
     }
 }
@@ -363,6 +504,8 @@ void PoolGroup<Pool>::RemoveOneRelation(uint16 child_pool_id)
             break;
         }
     }
+
+    RebuildMemberSlots();
 }
 
 template<>
@@ -387,6 +530,80 @@ bool PoolGroup<Pool>::CanSpawn(PoolObject* /*object*/, MapPersistentState& /*map
     return true;
 }
 
+// Pools of pools are small and not indexed, every member is checked
+template <>
+PoolObject* PoolGroup<Pool>::RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, MapPersistentState& mapState)
+{
+    PoolObject* explicitlyObjFound = nullptr;
+    auto gen = GetRandomGenerator();
+
+    if (!ExplicitlyChanced.empty())
+    {
+        float roll = (float)rand_chance();
+
+        std::vector <PoolObject*> explicitlyChancedVector;
+
+        // call memory manager once to reserve enough memory for performance
+        explicitlyChancedVector.reserve(ExplicitlyChanced.size());
+
+        // fill new vector with address of object in EqualChanced list
+        std::transform(ExplicitlyChanced.begin(), ExplicitlyChanced.end(), std::back_inserter(explicitlyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
+
+        // randomize the new vector
+        std::shuffle(explicitlyChancedVector.begin(), explicitlyChancedVector.end(), *gen);
+
+        for (auto obj : explicitlyChancedVector)
+        {
+            if (obj->exclude)
+                continue;
+
+            if (!CanSpawn(obj, mapState))
+                continue;
+
+            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<Pool>(obj->guid))
+                continue;
+
+            // we found an object but it may have no luck to be picked so we save it in case of no other object have been picked.
+            if (!explicitlyObjFound)
+                explicitlyObjFound = obj;
+
+            if (roll < obj->chance)
+                return obj;
+        }
+    }
+
+    if (!EqualChanced.empty())
+    {
+        std::vector <PoolObject*> equalyChancedVector;
+
+        // call memory manager once to reserve enough memory for performance
+        equalyChancedVector.reserve(EqualChanced.size());
+
+        // fill new vector with address of object in EqualChanced list
+        std::transform(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(equalyChancedVector), [](PoolObject& objPtr) { return &objPtr; });
+
+        // randomize the new vector
+        std::shuffle(equalyChancedVector.begin(), equalyChancedVector.end(), *gen);
+
+        for (auto obj : equalyChancedVector)
+        {
+            if (obj->exclude)
+                continue;
+
+            if (!CanSpawn(obj, mapState))
+                continue;
+
+            if (obj->guid != triggerFrom && spawns.IsSpawnedObject<Pool>(obj->guid))
+                continue;
+
+            return obj;
+        }
+    }
+
+    // return first explicitly chanced object if there is one
+    return explicitlyObjFound;
+}
+
 template <class T>
 void PoolGroup<T>::SpawnObject(MapPersistentState& mapState, uint32 limit, uint32 triggerFrom, bool instantly)
 {
@@ -425,6 +642,7 @@ void PoolGroup<T>::SpawnObject(MapPersistentState& mapState, uint32 limit, uint3
         }
 
         spawns.AddSpawn<T>(obj->guid, poolId);
+        SetEligible(spawns, obj, false);
         Spawn1Object(mapState, obj, instantly);
 
         if (triggerFrom)
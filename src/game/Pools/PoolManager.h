@@ -61,8 +61,43 @@ class Pool                                                  // for Pool of Pool
 {
 };
 
-typedef std::set<uint32> SpawnedPoolObjects;
+// Set of ids kept in a dense array, with constant time insert, erase, lookup and random pick
+class PoolIdSet
+{
+    public:
+        typedef std::vector<uint32>::const_iterator const_iterator;
+
+        bool Contains(uint32 id) const { return m_positions.find(id) != m_positions.end(); }
+        bool Insert(uint32 id);
+        bool Erase(uint32 id);
+
+        // swaps a random id of the slots [pos, size) into pos and returns it, a walk over all positions
+        // is a shuffle done only as far as needed
+        uint32 PickFrom(uint32 pos);
+
+        uint32 size() const { return uint32(m_ids.size()); }
+        bool empty() const { return m_ids.empty(); }
+        const_iterator begin() const { return m_ids.begin(); }
+        const_iterator end() const { return m_ids.end(); }
+
+    private:
+        std::vector<uint32> m_ids;
+        std::unordered_map<uint32, uint32> m_positions;     // id -> index in m_ids
+};
+
+// Pool members not spawned in a map, as indexes in the PoolGroup lists
+struct PoolEligibleIndex
+{
+    PoolEligibleIndex() : isBuilt(false) {}
+
+    PoolIdSet explicitlyChanced;
+    PoolIdSet equalChanced;
+    bool isBuilt;                                           // filled at the first roll of the pool in the map
+};
+
+typedef PoolIdSet SpawnedPoolObjects;
 typedef std::map<uint32, uint32> SpawnedPoolPools;
+typedef std::unordered_map<uint32, PoolEligibleIndex> PoolEligibleIndexMap;
 
 class SpawnedPoolData
 {
@@ -86,15 +121,23 @@ class SpawnedPoolData
         SpawnedPoolObjects const& GetSpawnedCreatures() const { return mSpawnedCreatures; }
         SpawnedPoolObjects const& GetSpawnedGameobjects() const { return mSpawnedGameobjects; }
         SpawnedPoolPools const& GetSpawnedPools() const { return mSpawnedPools; }
+
+        // not spawned members of a creature or gameobject pool, nullptr for pools of pools
+        template<typename T>
+        PoolEligibleIndex* GetEligibleIndex(uint32 pool_id, bool create);
     private:
         SpawnedPoolObjects mSpawnedCreatures;
         SpawnedPoolObjects mSpawnedGameobjects;
         SpawnedPoolPools   mSpawnedPools;
+        PoolEligibleIndexMap mEligibleCreatures;
+        PoolEligibleIndexMap mEligibleGameobjects;
         bool m_isInitialized;
 };
 
 typedef std::vector<PoolObject> PoolObjectList;
 
+#define POOL_SLOT_EQUAL_CHANCED 0x80000000
+
 template <class T>
 class PoolGroup
 {
@@ -107,6 +150,7 @@ class PoolGroup
         bool CheckPool() const;
         void CheckEventLinkAndReport(int16 event_id, std::map<uint32, int16> const& creature2event, std::map<uint32, int16> const& go2event) const;
         PoolObject* RollOne(SpawnedPoolData& spawns, uint32 triggerFrom, MapPersistentState& mapState);
+        PoolObject* RollOneEligible(PoolEligibleIndex& index, MapPersistentState& mapState);
         void DespawnObject(MapPersistentState& mapState, uint32 guid = 0);
         void Despawn1Object(MapPersistentState& mapState, uint32 guid);
         void SpawnObject(MapPersistentState& mapState, uint32 limit, uint32 triggerFrom, bool instantly);
@@ -122,10 +166,15 @@ class PoolGroup
         size_t size() const { return ExplicitlyChanced.size() + EqualChanced.size(); }
     private:
         bool CanSpawn(PoolObject* object, MapPersistentState& mapState);
-        
+        PoolObject* FindMember(uint32 guid);
+        PoolEligibleIndex& GetEligibleIndex(SpawnedPoolData& spawns);
+        void SetEligible(SpawnedPoolData& spawns, PoolObject const* obj, bool state);
+        void RebuildMemberSlots();
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
         PoolObjectList EqualChanced;
+        std::unordered_map<uint32, uint32> MemberSlots;     // guid -> index in ExplicitlyChanced, or in EqualChanced with POOL_SLOT_EQUAL_CHANCED
 };
 
 class PoolManager
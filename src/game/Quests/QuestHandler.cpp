@@ -30,6 +30,7 @@
 #include "AI/ScriptDevAI/ScriptDevAIMgr.h"
 #include "Groups/Group.h"
 #include "Tools/Formulas.h"
+#include "Server/QueryResponseCache.h"
 
 #ifdef BUILD_PLAYERBOT
 #include "PlayerBot/Base/PlayerbotAI.h"
@@ -61,7 +62,7 @@ void WorldSession::HandleQuestgiverStatusQueryOpcode(WorldPacket& recv_data)
                 dialogStatus = sScriptDevAIMgr.GetDialogStatus(_player, cr_questgiver);
 
                 if (dialogStatus == DIALOG_STATUS_UNDEFINED)
-                    dialogStatus = getDialogStatus(_player, cr_questgiver, DIALOG_STATUS_NONE);
+                    dialogStatus = _player->GetQuestGiverDialogStatus(cr_questgiver);
             }
             break;
         }
@@ -74,7 +75,7 @@ void WorldSession::HandleQuestgiverStatusQueryOpcode(WorldPacket& recv_data)
                 dialogStatus = sScriptDevAIMgr.GetDialogStatus(_player, go_questgiver);
 
                 if (dialogStatus == DIALOG_STATUS_UNDEFINED)
-                    dialogStatus = getDialogStatus(_player, go_questgiver, DIALOG_STATUS_NONE);
+                    dialogStatus = _player->GetQuestGiverDialogStatus(go_questgiver);
             }
             break;
         }
@@ -225,6 +226,19 @@ void WorldSession::HandleQuestQueryOpcode(WorldPacket& recv_data)
     Quest const* pQuest = sObjectMgr.GetQuestTemplate(quest);
     if (pQuest)
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+
+        // rewarded honor depends on the level of the player
+        bool const cacheable = !pQuest->GetRewHonorableKills();
+        if (cacheable)
+        {
+            if (std::shared_ptr<WorldPacket const> response = sQueryResponseCache.Get(QUERY_RESPONSE_QUEST, quest, loc_idx))
+            {
+                SendPacket(*response);
+                return;
+            }
+        }
+
         std::string ObjectiveText[QUEST_OBJECTIVES_COUNT];
         std::string Title = pQuest->GetTitle();
         std::string Details = pQuest->GetDetails();
@@ -234,7 +248,6 @@ void WorldSession::HandleQuestQueryOpcode(WorldPacket& recv_data)
         for (int i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
             ObjectiveText[i] = pQuest->ObjectiveText[i];
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             if (QuestLocale const* ql = sObjectMgr.GetQuestLocale(pQuest->GetQuestId()))
@@ -254,7 +267,8 @@ void WorldSession::HandleQuestQueryOpcode(WorldPacket& recv_data)
             }
         }
 
-        WorldPacket data(SMSG_QUEST_QUERY_RESPONSE, 100);       // guess size
+        std::shared_ptr<WorldPacket> packet = std::make_shared<WorldPacket>(SMSG_QUEST_QUERY_RESPONSE, 100);  // guess size
+        WorldPacket& data = *packet;
 
         data << uint32(pQuest->GetQuestId());                   // quest id
         data << uint32(pQuest->GetQuestMethod());               // Accepted values: 0, 1 or 2. 0==IsAutoComplete() (skip objectives/details)
@@ -339,6 +353,9 @@ void WorldSession::HandleQuestQueryOpcode(WorldPacket& recv_data)
         for (iI = 0; iI < QUEST_OBJECTIVES_COUNT; ++iI)
             data << ObjectiveText[iI];
 
+        if (cacheable)
+            sQueryResponseCache.Store(QUERY_RESPONSE_QUEST, quest, loc_idx, packet);
+
         SendPacket(data);
 
         DEBUG_LOG("WORLD: Sent SMSG_QUEST_QUERY_RESPONSE questid=%u", pQuest->GetQuestId());
@@ -110,6 +110,9 @@ bool ReputationMgr::IsAtWar(FactionEntry const* factionEntry) const
 
 ReputationRank ReputationMgr::GetRank(FactionEntry const* factionEntry) const
 {
+    if (factionEntry && factionEntry->HasReputation() && uint32(factionEntry->reputationListID) < m_ranks.size())
+        return m_ranks[factionEntry->reputationListID];
+
     int32 reputation = GetReputation(factionEntry);
     return ReputationToRank(reputation);
 }
@@ -122,7 +125,7 @@ ReputationRank ReputationMgr::GetBaseRank(FactionEntry const* factionEntry) cons
 
 ReputationRank const* ReputationMgr::GetForcedRankIfAny(FactionTemplateEntry const* factionTemplateEntry) const
 {
-    if (!factionTemplateEntry)
+    if (!factionTemplateEntry || m_forcedReactions.empty())
         return nullptr;
 
     ForcedReactions::const_iterator forceItr = m_forcedReactions.find(factionTemplateEntry->faction);
@@ -242,9 +245,18 @@ void ReputationMgr::SendVisible(FactionState const* faction) const
     m_player->SendDirectMessage(data);
 }
 
+void ReputationMgr::SetRank(RepListID repListID, ReputationRank rank)
+{
+    if (repListID >= m_ranks.size())
+        m_ranks.resize(repListID + 1, REP_NEUTRAL);         // no standing counts as 0
+
+    m_ranks[repListID] = rank;
+}
+
 void ReputationMgr::Initialize()
 {
     m_factions.clear();
+    m_ranks.clear();
 
     for (unsigned int i = 1; i < sFactionStore.GetMaxEntry(); ++i)
     {
@@ -261,6 +273,7 @@ void ReputationMgr::Initialize()
             newFaction.needSave = true;
 
             m_factions[newFaction.ReputationListID] = newFaction;
+            SetRank(newFaction.ReputationListID, GetBaseRank(factionEntry));
         }
     }
 }
@@ -365,6 +378,7 @@ bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, in
         ReputationRank rankNew = ReputationToRank(standing);
 
         faction.Standing = standing - BaseRep;
+        SetRank(faction.ReputationListID, rankNew);
         faction.needSend = true;
         faction.needSave = true;
 
@@ -516,6 +530,7 @@ void ReputationMgr::LoadFromDB(QueryResult* result)
 
                 // update standing to current
                 faction->Standing = int32(fields[1].GetUInt32());
+                SetRank(faction->ReputationListID, ReputationToRank(GetBaseReputation(factionEntry) + faction->Standing));
 
                 uint32 dbFactionFlags = fields[2].GetUInt32();
 
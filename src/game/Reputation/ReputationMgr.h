@@ -23,6 +23,7 @@
 #include "Globals/SharedDefines.h"
 #include "Server/DBCStructure.h"
 #include <map>
+#include <vector>
 
 enum FactionFlags
 {
@@ -118,10 +119,12 @@ class ReputationMgr
         void SetAtWar(FactionState* faction, bool atWar);
         void SetInactive(FactionState* faction, bool inactive);
         void SendVisible(FactionState const* faction) const;
+        void SetRank(RepListID repListID, ReputationRank rank);
     private:
         Player* m_player;
         FactionStateList m_factions;
         ForcedReactions m_forcedReactions;
+        std::vector<ReputationRank> m_ranks;                // by RepListID, kept with the standing for reaction checks
 };
 
 #endif
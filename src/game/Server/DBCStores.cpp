@@ -27,7 +27,13 @@
 
 #include "DBCfmt.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <thread>
 
 typedef std::map<uint16, uint32> AreaFlagByAreaID;
 typedef std::map<uint32, uint32> AreaFlagByMapID;
@@ -207,41 +213,106 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
-template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, BarGoLink& bar, StoreProblemList& errlist, DBCStorage<T>& storage, const std::string& dbc_path, const std::string& filename)
+// DBC files do not depend on each other, so they are read and converted on several threads,
+// the lookup tables built from them are filled after all files are loaded
+class DBCLoader
 {
-    // compatibility format and C++ structure sizes
-    MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
+    public:
+        DBCLoader(std::string const& dbcPath, BarGoLink& bar, StoreProblemList& errlist)
+            : m_dbcPath(dbcPath), m_bar(bar), m_errlist(errlist), m_availableDbcLocales(0xFFFFFFFF) {}
 
-    std::string dbc_filename = dbc_path + filename;
-    if (storage.Load(dbc_filename.c_str()))
-    {
-        bar.step();
-        for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
+        template<class T>
+        void Add(DBCStorage<T>& storage, const std::string& filename)
         {
-            if (!(availableDbcLocales & (1 << i)))
-                continue;
+            // compatibility format and C++ structure sizes
+            MANGOS_ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
-            std::string dbc_filename_loc = dbc_path + fullLocaleNameList[i].name + "/" + filename;
-            if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
-                availableDbcLocales &= ~(1 << i);           // mark as not available for speedup next checks
+            m_files.push_back({ filename, [this, &storage, filename]() { return Load(storage, filename); }, 0 });
         }
-    }
-    else
-    {
-        // sort problematic dbc to (1) non compatible and (2) nonexistent
-        FILE* f = fopen(dbc_filename.c_str(), "rb");
-        if (f)
+
+        void Run()
+        {
+            std::atomic<size_t> next(0);
+            auto worker = [this, &next]()
+            {
+                for (size_t i = next++; i < m_files.size(); i = next++)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    bool loaded = m_files[i].load();
+                    m_files[i].loadTime = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+                    std::lock_guard<std::mutex> guard(m_lock);
+                    if (loaded)
+                        m_bar.step();
+                }
+            };
+
+            uint32 threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), uint32(m_files.size())));
+            std::vector<std::thread> threads;
+            for (uint32 i = 1; i < threadCount; ++i)
+                threads.emplace_back(worker);
+            worker();
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        // slowest files first
+        void LogLoadTimes()
         {
-            char buf[100];
-            snprintf(buf, 100, " (exist, but have %u fields instead " SIZEFMTD ") Wrong client version DBC file?", storage.GetFieldCount(), strlen(storage.GetFormat()));
-            errlist.push_back(dbc_filename + buf);
-            fclose(f);
+            std::sort(m_files.begin(), m_files.end(), [](File const& a, File const& b) { return a.loadTime > b.loadTime; });
+            for (auto const& file : m_files)
+                DETAIL_LOG("Loaded %s in %u ms", file.filename.c_str(), file.loadTime);
         }
-        else
-            errlist.push_back(dbc_filename);
-    }
-}
+
+    private:
+        struct File
+        {
+            std::string filename;
+            std::function<bool()> load;
+            uint32 loadTime;
+        };
+
+        template<class T>
+        bool Load(DBCStorage<T>& storage, const std::string& filename)
+        {
+            std::string dbc_filename = m_dbcPath + filename;
+            if (storage.Load(dbc_filename.c_str()))
+            {
+                for (uint8 i = 0; fullLocaleNameList[i].name; ++i)
+                {
+                    if (!(m_availableDbcLocales & (1 << i)))
+                        continue;
+
+                    std::string dbc_filename_loc = m_dbcPath + fullLocaleNameList[i].name + "/" + filename;
+                    if (!storage.LoadStringsFrom(dbc_filename_loc.c_str()))
+                        m_availableDbcLocales &= ~(1 << i);     // mark as not available for speedup next checks
+                }
+                return true;
+            }
+
+            // sort problematic dbc to (1) non compatible and (2) nonexistent
+            std::string problem = dbc_filename;
+            FILE* f = fopen(dbc_filename.c_str(), "rb");
+            if (f)
+            {
+                char buf[100];
+                snprintf(buf, 100, " (exist, but have %u fields instead " SIZEFMTD ") Wrong client version DBC file?", storage.GetFieldCount(), strlen(storage.GetFormat()));
+                problem += buf;
+                fclose(f);
+            }
+
+            std::lock_guard<std::mutex> guard(m_lock);
+            m_errlist.push_back(problem);
+            return false;
+        }
+
+        std::string m_dbcPath;
+        BarGoLink& m_bar;
+        StoreProblemList& m_errlist;
+        std::mutex m_lock;                                  // guards m_bar and m_errlist
+        std::atomic<uint32> m_availableDbcLocales;          // bitmask for index of fullLocaleNameList
+        std::vector<File> m_files;
+};
 
 void LoadDBCStores(const std::string& dataPath)
 {
@@ -260,10 +331,99 @@ void LoadDBCStores(const std::string& dataPath)
 
     StoreProblemList bad_dbc_files;
 
-    // bitmask for index of fullLocaleNameList
-    uint32 availableDbcLocales = 0xFFFFFFFF;
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaStore,                dbcPath, "AreaTable.dbc");
+    auto loadStart = std::chrono::steady_clock::now();
+
+    DBCLoader loader(dbcPath, bar, bad_dbc_files);
+
+    loader.Add(sAreaStore,                "AreaTable.dbc");
+    loader.Add(sAreaTriggerStore,         "AreaTrigger.dbc");
+    loader.Add(sAuctionHouseStore,        "AuctionHouse.dbc");
+    loader.Add(sBankBagSlotPricesStore,   "BankBagSlotPrices.dbc");
+    loader.Add(sBattlemasterListStore,    "BattlemasterList.dbc");
+    loader.Add(sCharStartOutfitStore,     "CharStartOutfit.dbc");
+    loader.Add(sCharTitlesStore,          "CharTitles.dbc");
+    loader.Add(sChatChannelsStore,        "ChatChannels.dbc");
+    loader.Add(sCharacterFacialHairStylesStore, "CharacterFacialHairStyles.dbc");
+    loader.Add(sCharSectionsStore, "CharSections.dbc");
+    loader.Add(sChrClassesStore,          "ChrClasses.dbc");
+    loader.Add(sChrRacesStore,            "ChrRaces.dbc");
+    loader.Add(sCinematicCameraStore,     "CinematicCamera.dbc");
+    loader.Add(sCinematicSequencesStore,  "CinematicSequences.dbc");
+    loader.Add(sCreatureDisplayInfoStore, "CreatureDisplayInfo.dbc");
+    loader.Add(sCreatureDisplayInfoExtraStore, "CreatureDisplayInfoExtra.dbc");
+    loader.Add(sCreatureFamilyStore,      "CreatureFamily.dbc");
+    loader.Add(sCreatureModelDataStore,   "CreatureModelData.dbc");
+    loader.Add(sCreatureSpellDataStore,   "CreatureSpellData.dbc");
+    loader.Add(sCreatureTypeStore,        "CreatureType.dbc");
+    loader.Add(sDurabilityCostsStore,     "DurabilityCosts.dbc");
+    loader.Add(sDurabilityQualityStore,   "DurabilityQuality.dbc");
+    loader.Add(sEmotesStore,              "Emotes.dbc");
+    loader.Add(sEmotesTextStore,          "EmotesText.dbc");
+    // loader.Add(sFactionStore,             "Faction.dbc");
+    loader.Add(sFactionTemplateStore,     "FactionTemplate.dbc");
+    loader.Add(sGameObjectArtKitStore,    "GameObjectArtKit.dbc");
+    loader.Add(sGameObjectDisplayInfoStore, "GameObjectDisplayInfo.dbc");
+    loader.Add(sGemPropertiesStore,       "GemProperties.dbc");
+    loader.Add(sGMSurveyCurrentSurveyStore,  "GMSurveyCurrentSurvey.dbc");
+    loader.Add(sGMSurveyQuestionsStore,  "GMSurveyQuestions.dbc");
+    loader.Add(sGMSurveySurveysStore,  "GMSurveySurveys.dbc");
+    loader.Add(sGMTicketCategoryStore, "GMTicketCategory.dbc");
+    loader.Add(sGtCombatRatingsStore,     "gtCombatRatings.dbc");
+    loader.Add(sGtChanceToMeleeCritBaseStore, "gtChanceToMeleeCritBase.dbc");
+    loader.Add(sGtChanceToMeleeCritStore, "gtChanceToMeleeCrit.dbc");
+    loader.Add(sGtChanceToSpellCritBaseStore, "gtChanceToSpellCritBase.dbc");
+    loader.Add(sGtChanceToSpellCritStore, "gtChanceToSpellCrit.dbc");
+    loader.Add(sGtOCTRegenHPStore,        "gtOCTRegenHP.dbc");
+    loader.Add(sGtNPCManaCostScalerStore, "gtNPCManaCostScaler.dbc");
+    // loader.Add(sGtOCTRegenMPStore,        "gtOCTRegenMP.dbc");       -- not used currently
+    loader.Add(sGtRegenHPPerSptStore,     "gtRegenHPPerSpt.dbc");
+    loader.Add(sGtRegenMPPerSptStore,     "gtRegenMPPerSpt.dbc");
+    loader.Add(sItemStore,                "Item.dbc");
+    loader.Add(sItemBagFamilyStore,       "ItemBagFamily.dbc");
+    loader.Add(sItemClassStore,           "ItemClass.dbc");
+    // loader.Add(sItemDisplayInfoStore,     "ItemDisplayInfo.dbc");     -- not used currently
+    // loader.Add(sItemCondExtCostsStore,    "ItemCondExtCosts.dbc");
+    loader.Add(sItemExtendedCostStore,    "ItemExtendedCost.dbc");
+    loader.Add(sItemRandomPropertiesStore, "ItemRandomProperties.dbc");
+    loader.Add(sItemRandomSuffixStore,    "ItemRandomSuffix.dbc");
+    loader.Add(sItemSetStore,             "ItemSet.dbc");
+    loader.Add(sLightStore,               "Light.dbc");
+    loader.Add(sLiquidTypeStore,          "LiquidType.dbc");
+    loader.Add(sLockStore,                "Lock.dbc");
+    loader.Add(sMailTemplateStore,        "MailTemplate.dbc");
+    loader.Add(sMapStore,                 "Map.dbc");
+    loader.Add(sQuestSortStore,           "QuestSort.dbc");
+    loader.Add(sRandomPropertiesPointsStore, "RandPropPoints.dbc");
+    loader.Add(sSkillLineStore,           "SkillLine.dbc");
+    loader.Add(sSkillLineAbilityStore,    "SkillLineAbility.dbc");
+    loader.Add(sSkillRaceClassInfoStore,  "SkillRaceClassInfo.dbc");
+    loader.Add(sSkillTiersStore,          "SkillTiers.dbc");
+    loader.Add(sSoundEntriesStore,        "SoundEntries.dbc");
+    loader.Add(sSpellCastTimesStore,      "SpellCastTimes.dbc");
+    loader.Add(sSpellDurationStore,       "SpellDuration.dbc");
+    loader.Add(sSpellFocusObjectStore,    "SpellFocusObject.dbc");
+    loader.Add(sSpellItemEnchantmentStore, "SpellItemEnchantment.dbc");
+    loader.Add(sSpellItemEnchantmentConditionStore, "SpellItemEnchantmentCondition.dbc");
+    loader.Add(sSpellRadiusStore,         "SpellRadius.dbc");
+    loader.Add(sSpellRangeStore,          "SpellRange.dbc");
+    loader.Add(sSpellShapeshiftFormStore, "SpellShapeshiftForm.dbc");
+    loader.Add(sSpellVisualStore,         "SpellVisual.dbc");
+    loader.Add(sStableSlotPricesStore,    "StableSlotPrices.dbc");
+    loader.Add(sSummonPropertiesStore,    "SummonProperties.dbc");
+    loader.Add(sTalentStore,              "Talent.dbc");
+    loader.Add(sTalentTabStore,           "TalentTab.dbc");
+    loader.Add(sTaxiNodesStore,           "TaxiNodes.dbc");
+    loader.Add(sTaxiPathStore,            "TaxiPath.dbc");
+    loader.Add(sTaxiPathNodeStore,        "TaxiPathNode.dbc");
+    loader.Add(sTransportAnimationStore,  "TransportAnimation.dbc");
+    loader.Add(sTotemCategoryStore,       "TotemCategory.dbc");
+    loader.Add(sWorldMapAreaStore,        "WorldMapArea.dbc");
+    loader.Add(sWMOAreaTableStore,        "WMOAreaTable.dbc");
+    // loader.Add(sWorldMapOverlayStore,     "WorldMapOverlay.dbc");
+    // loader.Add(sWorldSafeLocsStore,       "WorldSafeLocs.dbc");
+
+    loader.Run();
+    loader.LogLoadTimes();
 
     // must be after sAreaStore loading
     for (uint32 i = 0; i < sAreaStore.GetNumRows(); ++i)    // areaflag numbered from 0
@@ -279,79 +439,16 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAreaTriggerStore,         dbcPath, "AreaTrigger.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sAuctionHouseStore,        dbcPath, "AuctionHouse.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBankBagSlotPricesStore,   dbcPath, "BankBagSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sBattlemasterListStore,    dbcPath, "BattlemasterList.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharStartOutfitStore,     dbcPath, "CharStartOutfit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharTitlesStore,          dbcPath, "CharTitles.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChatChannelsStore,        dbcPath, "ChatChannels.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharacterFacialHairStylesStore, dbcPath, "CharacterFacialHairStyles.dbc");
     for (uint32 i = 0; i < sCharacterFacialHairStylesStore.GetNumRows(); ++i)
         if (CharacterFacialHairStylesEntry const* entry = sCharacterFacialHairStylesStore.LookupEntry(i))
             if (entry->RaceID && ((1 << (entry->RaceID - 1)) & RACEMASK_ALL_PLAYABLE) != 0) // ignore nonplayable races
                 sCharFacialHairMap.insert({ entry->RaceID | (entry->SexID << 8) | (entry->VariationID << 16), entry });
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCharSectionsStore, dbcPath, "CharSections.dbc");
     for (uint32 i = 0; i < sCharSectionsStore.GetNumRows(); ++i)
         if (CharSectionsEntry const* entry = sCharSectionsStore.LookupEntry(i))
             if (entry->Race && ((1 << (entry->Race - 1)) & RACEMASK_ALL_PLAYABLE) != 0) //ignore Nonplayable races
                 sCharSectionMap.emplace(uint8(entry->BaseSection) | (uint8(entry->Gender) << 8) | (uint8(entry->Race) << 16), entry);
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrClassesStore,          dbcPath, "ChrClasses.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sChrRacesStore,            dbcPath, "ChrRaces.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicCameraStore,     dbcPath, "CinematicCamera.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCinematicSequencesStore,  dbcPath, "CinematicSequences.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoStore, dbcPath, "CreatureDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureDisplayInfoExtraStore, dbcPath, "CreatureDisplayInfoExtra.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureFamilyStore,      dbcPath, "CreatureFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureModelDataStore,   dbcPath, "CreatureModelData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureSpellDataStore,   dbcPath, "CreatureSpellData.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sCreatureTypeStore,        dbcPath, "CreatureType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityCostsStore,     dbcPath, "DurabilityCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sDurabilityQualityStore,   dbcPath, "DurabilityQuality.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesStore,              dbcPath, "Emotes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sEmotesTextStore,          dbcPath, "EmotesText.dbc");
-    // LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionStore,             dbcPath, "Faction.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sFactionTemplateStore,     dbcPath, "FactionTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectArtKitStore,    dbcPath, "GameObjectArtKit.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGameObjectDisplayInfoStore, dbcPath, "GameObjectDisplayInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGemPropertiesStore,       dbcPath, "GemProperties.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveyCurrentSurveyStore,  dbcPath, "GMSurveyCurrentSurvey.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveyQuestionsStore,  dbcPath, "GMSurveyQuestions.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMSurveySurveysStore,  dbcPath, "GMSurveySurveys.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGMTicketCategoryStore, dbcPath, "GMTicketCategory.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtCombatRatingsStore,     dbcPath, "gtCombatRatings.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritBaseStore, dbcPath, "gtChanceToMeleeCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToMeleeCritStore, dbcPath, "gtChanceToMeleeCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritBaseStore, dbcPath, "gtChanceToSpellCritBase.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtChanceToSpellCritStore, dbcPath, "gtChanceToSpellCrit.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtOCTRegenHPStore,        dbcPath, "gtOCTRegenHP.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtNPCManaCostScalerStore, dbcPath, "gtNPCManaCostScaler.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sGtOCTRegenMPStore,        dbcPath,"gtOCTRegenMP.dbc");       -- not used currently
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenHPPerSptStore,     dbcPath, "gtRegenHPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sGtRegenMPPerSptStore,     dbcPath, "gtRegenMPPerSpt.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemStore,                dbcPath, "Item.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemBagFamilyStore,       dbcPath, "ItemBagFamily.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemClassStore,           dbcPath, "ItemClass.dbc");
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemDisplayInfoStore,     dbcPath,"ItemDisplayInfo.dbc");     -- not used currently
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sItemCondExtCostsStore,    dbcPath,"ItemCondExtCosts.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemExtendedCostStore,    dbcPath, "ItemExtendedCost.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomPropertiesStore, dbcPath, "ItemRandomProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemRandomSuffixStore,    dbcPath, "ItemRandomSuffix.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sItemSetStore,             dbcPath, "ItemSet.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLightStore,               dbcPath, "Light.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLiquidTypeStore,          dbcPath, "LiquidType.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sLockStore,                dbcPath, "Lock.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMailTemplateStore,        dbcPath, "MailTemplate.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sMapStore,                 dbcPath, "Map.dbc");
     {
         // repairs entry for netherstorm - should be moved to SQL
         MapEntry const* mEntry = sMapStore.LookupEntry(550);
@@ -360,13 +457,6 @@ void LoadDBCStores(const std::string& dataPath)
         sMapStore.EraseEntry(550);
         sMapStore.InsertEntry(tempestKeepMap, 550);
     }
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sQuestSortStore,           dbcPath, "QuestSort.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sRandomPropertiesPointsStore, dbcPath, "RandPropPoints.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineStore,           dbcPath, "SkillLine.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillLineAbilityStore,    dbcPath, "SkillLineAbility.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillRaceClassInfoStore,  dbcPath, "SkillRaceClassInfo.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSkillTiersStore,          dbcPath, "SkillTiers.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSoundEntriesStore,        dbcPath, "SoundEntries.dbc");
 
     for (uint32 j = 0; j < sSkillLineAbilityStore.GetNumRows(); ++j)
     {
@@ -403,10 +493,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellCastTimesStore,      dbcPath, "SpellCastTimes.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellDurationStore,       dbcPath, "SpellDuration.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellFocusObjectStore,    dbcPath, "SpellFocusObject.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentStore, dbcPath, "SpellItemEnchantment.dbc");
     //for (uint32 i = 0; i < sSpellItemEnchantmentStore.GetNumRows(); ++i)
     //{
     //    SpellItemEnchantmentEntry const* enchantEntry = sSpellItemEnchantmentStore.LookupEntry(i);
@@ -419,14 +505,6 @@ void LoadDBCStores(const std::string& dataPath)
     //                sLog.outErrorDb("Spell ID %u found in spell item enchant %u does not exist.", enchantEntry->spellid[k], i);
     //    }
     //}
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellItemEnchantmentConditionStore, dbcPath, "SpellItemEnchantmentCondition.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRadiusStore,         dbcPath, "SpellRadius.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellRangeStore,          dbcPath, "SpellRange.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellShapeshiftFormStore, dbcPath, "SpellShapeshiftForm.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSpellVisualStore,         dbcPath, "SpellVisual.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sStableSlotPricesStore,    dbcPath, "StableSlotPrices.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sSummonPropertiesStore,    dbcPath, "SummonProperties.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentStore,              dbcPath, "Talent.dbc");
 
     // create talent spells set
     for (unsigned int i = 0; i < sTalentStore.GetNumRows(); ++i)
@@ -438,8 +516,6 @@ void LoadDBCStores(const std::string& dataPath)
                 sTalentSpellPosMap[talentInfo->RankID[j]] = TalentSpellPos(i, j);
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTalentTabStore,           dbcPath, "TalentTab.dbc");
-
     // prepare fast data access to bit pos of talent ranks for use at inspecting
     {
         // fill table by amount of talent ranks and fill sTalentTabBitSizeInInspect
@@ -505,16 +581,12 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiNodesStore,           dbcPath, "TaxiNodes.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathStore,            dbcPath, "TaxiPath.dbc");
     for (uint32 i = 1; i < sTaxiPathStore.GetNumRows(); ++i)
         if (TaxiPathEntry const* entry = sTaxiPathStore.LookupEntry(i))
             sTaxiPathSetBySource[entry->from][entry->to] = TaxiPathBySourceAndDestination(entry->ID, entry->price);
     uint32 pathCount = sTaxiPathStore.GetNumRows();
 
     //## TaxiPathNode.dbc ## Loaded only for initialization different structures
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTaxiPathNodeStore,        dbcPath, "TaxiPathNode.dbc");
     // Calculate path nodes count
     std::vector<uint32> pathLength;
     pathLength.resize(pathCount);                           // 0 and some other indexes not used
@@ -575,11 +647,6 @@ void LoadDBCStores(const std::string& dataPath)
         }
     }
 
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTransportAnimationStore,  dbcPath, "TransportAnimation.dbc");
-
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sTotemCategoryStore,       dbcPath, "TotemCategory.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldMapAreaStore,        dbcPath, "WorldMapArea.dbc");
-    LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWMOAreaTableStore,        dbcPath, "WMOAreaTable.dbc");
     for (uint32 i = 0; i < sWMOAreaTableStore.GetNumRows(); ++i)
     {
         if (WMOAreaTableEntry const* entry = sWMOAreaTableStore.LookupEntry(i))
@@ -587,9 +654,6 @@ void LoadDBCStores(const std::string& dataPath)
             sWMOAreaInfoByTripple[WMOAreaTableTripple(entry->rootId, entry->adtId, entry->groupId)].push_back(entry);
         }
     }
-    // LoadDBC(availableDbcLocales,bar,bad_dbc_files,sWorldMapOverlayStore,     dbcPath,"WorldMapOverlay.dbc");
-    // LoadDBC(availableDbcLocales, bar, bad_dbc_files, sWorldSafeLocsStore,       dbcPath, "WorldSafeLocs.dbc");
-
     // error checks
     if (bad_dbc_files.size() >= DBCFilesCount)
     {
@@ -621,7 +685,7 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
-    sLog.outString(">> Initialized %d data stores", DBCFilesCount);
+    sLog.outString(">> Initialized %d data stores in %u ms", DBCFilesCount, uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count()));
     sLog.outString();
 }
 
@@ -0,0 +1,160 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/OpcodeStats.h"
+
+uint32 LatencyHistogram::GetBucket(uint64 us)
+{
+    if (us < SUB_BUCKETS)
+        return uint32(us);
+
+    uint32 exponent = 3;                                    // SUB_BUCKETS == 1 << 3
+    while ((us >> (exponent + 1)) && exponent < 30)
+        ++exponent;
+
+    uint32 sub = uint32(us >> (exponent - 3)) & (SUB_BUCKETS - 1);
+    return std::min((exponent - 2) * SUB_BUCKETS + sub, BUCKET_COUNT - 1);
+}
+
+uint64 LatencyHistogram::GetBucketUpperBound(uint32 bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    uint32 exponent = bucket / SUB_BUCKETS + 2;
+    uint32 sub = bucket % SUB_BUCKETS;
+    return ((uint64(SUB_BUCKETS + sub + 1)) << (exponent - 3)) - 1;
+}
+
+void LatencyHistogram::Record(uint64 us)
+{
+    m_buckets[GetBucket(us)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalUs.fetch_add(us, std::memory_order_relaxed);
+
+    uint64 max = m_maxUs.load(std::memory_order_relaxed);
+    while (us > max && !m_maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed));
+}
+
+void LatencyHistogram::GetSnapshot(Snapshot& snapshot, bool reset)
+{
+    // not an atomic snapshot, a concurrent record may be split between two reports
+    if (reset)
+    {
+        snapshot.count = m_count.exchange(0, std::memory_order_relaxed);
+        snapshot.totalUs = m_totalUs.exchange(0, std::memory_order_relaxed);
+        snapshot.maxUs = m_maxUs.exchange(0, std::memory_order_relaxed);
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+            snapshot.buckets[i] = m_buckets[i].exchange(0, std::memory_order_relaxed);
+    }
+    else
+    {
+        snapshot.count = m_count.load(std::memory_order_relaxed);
+        snapshot.totalUs = m_totalUs.load(std::memory_order_relaxed);
+        snapshot.maxUs = m_maxUs.load(std::memory_order_relaxed);
+        for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+            snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::Reset()
+{
+    m_count = 0;
+    m_totalUs = 0;
+    m_maxUs = 0;
+    for (auto& bucket : m_buckets)
+        bucket = 0;
+}
+
+uint64 LatencyHistogram::Snapshot::Percentile(double percent) const
+{
+    uint64 total = 0;
+    for (uint32 bucket : buckets)
+        total += bucket;
+
+    if (!total)
+        return 0;
+
+    uint64 const rank = std::max<uint64>(1, uint64(total * percent / 100.0 + 0.5));
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(GetBucketUpperBound(i), maxUs);
+    }
+
+    return maxUs;
+}
+
+OpcodeStats& OpcodeStats::Instance()
+{
+    static OpcodeStats instance;
+    return instance;
+}
+
+OpcodeStats::OpcodeStats()
+{
+    for (auto& entry : m_entries)
+        entry = nullptr;
+}
+
+OpcodeStats::~OpcodeStats()
+{
+    for (auto& entry : m_entries)
+        delete entry.load();
+}
+
+void OpcodeStats::Record(uint16 opcode, uint64 us)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return;
+
+    Entry* entry = m_entries[opcode].load(std::memory_order_acquire);
+    if (!entry)
+    {
+        Entry* created = new Entry();
+        if (m_entries[opcode].compare_exchange_strong(entry, created, std::memory_order_acq_rel))
+            entry = created;
+        else
+            delete created;                                 // another thread won, entry holds its pointer
+    }
+
+    for (auto& histogram : entry->histograms)
+        histogram.Record(us);
+}
+
+bool OpcodeStats::GetSnapshot(uint16 opcode, Range range, LatencyHistogram::Snapshot& snapshot, bool reset)
+{
+    if (opcode >= NUM_MSG_TYPES)
+        return false;
+
+    Entry* entry = m_entries[opcode].load(std::memory_order_acquire);
+    if (!entry)
+        return false;
+
+    entry->histograms[range].GetSnapshot(snapshot, reset);
+    return snapshot.count != 0;
+}
+
+void OpcodeStats::Reset()
+{
+    for (auto& entryPtr : m_entries)
+        if (Entry* entry = entryPtr.load(std::memory_order_acquire))
+            entry->histograms[RANGE_TOTAL].Reset();
+}
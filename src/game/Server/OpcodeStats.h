@@ -0,0 +1,93 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_OPCODESTATS_H
+#define MANGOS_OPCODESTATS_H
+
+#include "Common.h"
+#include "Server/Opcodes.h"
+
+#include <atomic>
+#include <memory>
+
+// Log-linear latency histogram in microseconds, every power of two is split into 8 linear buckets (12.5% resolution)
+class LatencyHistogram
+{
+    public:
+        static uint32 const SUB_BUCKETS = 8;
+        static uint32 const BUCKET_COUNT = SUB_BUCKETS * 29;    // up to 2^31 us
+
+        struct Snapshot
+        {
+            uint64 count = 0;
+            uint64 totalUs = 0;
+            uint64 maxUs = 0;
+            uint32 buckets[BUCKET_COUNT] = {};
+
+            uint64 Percentile(double percent) const;
+        };
+
+        LatencyHistogram() { Reset(); }
+
+        void Record(uint64 us);
+        void GetSnapshot(Snapshot& snapshot, bool reset);
+        void Reset();
+
+        static uint32 GetBucket(uint64 us);
+        static uint64 GetBucketUpperBound(uint32 bucket);
+
+    private:
+        std::atomic<uint64> m_count;
+        std::atomic<uint64> m_totalUs;
+        std::atomic<uint64> m_maxUs;
+        std::atomic<uint32> m_buckets[BUCKET_COUNT];
+};
+
+// Handler execution time per opcode, histograms are allocated on the first packet of an opcode
+class OpcodeStats
+{
+    public:
+        static OpcodeStats& Instance();
+
+        // total - since the last reset, interval - since the last metrics report
+        enum Range
+        {
+            RANGE_TOTAL,
+            RANGE_INTERVAL,
+            RANGE_COUNT
+        };
+
+        void Record(uint16 opcode, uint64 us);
+        bool GetSnapshot(uint16 opcode, Range range, LatencyHistogram::Snapshot& snapshot, bool reset);
+        void Reset();
+
+    private:
+        struct Entry
+        {
+            LatencyHistogram histograms[RANGE_COUNT];
+        };
+
+        OpcodeStats();
+        ~OpcodeStats();
+
+        std::atomic<Entry*> m_entries[NUM_MSG_TYPES];
+};
+
+#define sOpcodeStats OpcodeStats::Instance()
+
+#endif
@@ -1117,6 +1117,7 @@ enum PacketProcessing
     PROCESS_THREADSAFE,                                     // packet is thread-safe - process it in Map::Update()
     PROCESS_MAP_THREAD,                                     // packet is map thread safe
     PROCESS_IMMEDIATE,                                      // packet is network thread safe
+    PROCESS_SESSION_PARALLEL,                               // packet only reads shared data and changes its own session - process it in parallel in World::UpdateSessions()
 };
 
 class WorldPacket;
@@ -20,50 +20,83 @@
 #include "WorldPacket.h"
 #include "Config/Config.h"
 #include "Globals/SharedDefines.h"
+#include "Server/Opcodes.h"
+#include "Log.h"
+#include "Util.h"
 
-#pragma pack(push, 1)
-
-// Packet logging structures in PKT 3.1 format
-struct LogHeader
+// Single producer single consumer byte ring, records are stored in file format so the writer copies them verbatim
+class PacketLogRing
 {
-    char Signature[3];
-    uint16 FormatVersion;
-    uint8 SnifferId;
-    uint32 Build;
-    char Locale[4];
-    uint8 SessionKey[40];
-    uint32 SniffStartUnixtime;
-    uint32 SniffStartTicks;
-    uint32 OptionalDataSize;
-};
+    public:
+        explicit PacketLogRing(size_t size) : m_data(size), m_writePos(0), m_readPos(0), m_dropped(0) {}
 
-struct PacketHeader
-{
-    // used to uniquely identify a connection
-    struct OptionalData
-    {
-        uint8 SocketIPBytes[16];
-        uint32 SocketPort;
-    };
-
-    uint32 Direction;
-    uint32 ConnectionId;
-    uint32 ArrivalTicks;
-    uint32 OptionalDataSize;
-    uint32 Length;
-    OptionalData OptionalData;
-    uint32 Opcode;
-};
+        // owner thread only
+        bool Push(void const* header, size_t headerSize, uint8 const* payload, size_t payloadSize)
+        {
+            size_t const size = headerSize + payloadSize;
+            size_t const write = m_writePos.load(std::memory_order_relaxed);
+            size_t const read = m_readPos.load(std::memory_order_acquire);
+            if (m_data.size() - (write - read) < size)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            Copy(write, static_cast<uint8 const*>(header), headerSize);
+            Copy(write + headerSize, payload, payloadSize);
+            m_writePos.store(write + size, std::memory_order_release);
+            return true;
+        }
+
+        // writer thread only
+        void Drain(FILE* file)
+        {
+            size_t const read = m_readPos.load(std::memory_order_relaxed);
+            size_t const write = m_writePos.load(std::memory_order_acquire);
+            if (read == write)
+                return;
 
-#pragma pack(pop)
+            size_t const begin = read % m_data.size();
+            size_t const length = write - read;
+            size_t const first = std::min(length, m_data.size() - begin);
+            fwrite(&m_data[begin], 1, first, file);
+            if (first < length)
+                fwrite(&m_data[0], 1, length - first, file);
 
-PacketLog::PacketLog() : _file(nullptr)
+            m_readPos.store(write, std::memory_order_release);
+        }
+
+        uint32 TakeDropped() { return m_dropped.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        void Copy(size_t pos, uint8 const* src, size_t size)
+        {
+            if (!size)
+                return;
+
+            size_t const begin = pos % m_data.size();
+            size_t const first = std::min(size, m_data.size() - begin);
+            memcpy(&m_data[begin], src, first);
+            if (first < size)
+                memcpy(&m_data[0], src + first, size - first);
+        }
+
+        std::vector<uint8> m_data;
+        std::atomic<size_t> m_writePos;                     // total bytes pushed
+        std::atomic<size_t> m_readPos;                      // total bytes written to the file
+        std::atomic<uint32> m_dropped;
+};
+
+PacketLog::PacketLog() : _file(nullptr), _enabled(false), _filter(std::make_shared<Filter const>()), _ringSize(0), _writerStop(false)
 {
     std::call_once(_initializeFlag, &PacketLog::Initialize, this);
 }
 
 PacketLog::~PacketLog()
 {
+    _enabled = false;
+    StopWriter();
+
     if (_file)
         fclose(_file);
 
@@ -85,6 +118,43 @@ void PacketLog::Initialize()
         if ((logsDir.at(logsDir.length() - 1) != '/') && (logsDir.at(logsDir.length() - 1) != '\\'))
             logsDir.push_back('/');
 
+    std::shared_ptr<Filter> filter = std::make_shared<Filter>();
+
+    for (std::string const& token : StrSplit(sConfig.GetStringDefault("PacketLogAccounts", ""), " ,"))
+        if (uint32 accountId = uint32(strtoul(token.c_str(), nullptr, 10)))
+            filter->accounts.insert(accountId);
+
+    Tokens opcodes = StrSplit(sConfig.GetStringDefault("PacketLogOpcodes", ""), " ,");
+    if (!opcodes.empty())
+    {
+        filter->opcodes.assign(NUM_MSG_TYPES, false);
+        for (std::string const& token : opcodes)
+        {
+            uint32 opcode = NUM_MSG_TYPES;
+            if (isdigit(token[0]))
+                opcode = uint32(strtoul(token.c_str(), nullptr, 0));
+            else
+            {
+                for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+                {
+                    if (token == LookupOpcodeName(i))
+                    {
+                        opcode = i;
+                        break;
+                    }
+                }
+            }
+
+            if (opcode < NUM_MSG_TYPES)
+                filter->opcodes[opcode] = true;
+            else
+                sLog.outError("PacketLogOpcodes: unknown opcode '%s' ignored.", token.c_str());
+        }
+    }
+
+    std::atomic_store(&_filter, std::shared_ptr<Filter const>(std::move(filter)));
+    _ringSize = std::max(sConfig.GetIntDefault("PacketLogBufferSize", 1024), 64) * 1024;
+
     std::string logname = sConfig.GetStringDefault("PacketLogFile", "");
     if (!logname.empty())
     {
@@ -101,15 +171,21 @@ void PacketLog::Initialize()
         header.SniffStartTicks = WorldTimer::getMSTime();
         header.OptionalDataSize = 0;
 
-        if (CanLogPacket())
+        if (_file)
+        {
             fwrite(&header, sizeof(header), 1, _file);
+            StartWriter();
+            _enabled = true;
+        }
     }
 }
 
 void PacketLog::Reinitialize()
 {
     std::lock_guard<std::mutex> lock(_logPacketLock);
-    if (CanLogPacket())
+    _enabled = false;
+    StopWriter();
+    if (_file)
     {
         fclose(_file);
         _file = nullptr;
@@ -117,10 +193,18 @@ void PacketLog::Reinitialize()
     Initialize();
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port)
+bool PacketLog::ShouldLogPacket(uint32 accountId, uint16 opcode, bool sessionLogging) const
 {
-    std::lock_guard<std::mutex> lock(_logPacketLock);
+    std::shared_ptr<Filter const> filter = std::atomic_load(&_filter);
+
+    if (!sessionLogging && (!accountId || filter->accounts.find(accountId) == filter->accounts.end()))
+        return false;
 
+    return filter->opcodes.empty() || (opcode < filter->opcodes.size() && filter->opcodes[opcode]);
+}
+
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port)
+{
     PacketHeader header;
     header.Direction = direction == CLIENT_TO_SERVER ? 0x47534d43 : 0x47534d53;
     header.ConnectionId = 0;
@@ -143,9 +227,72 @@ void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost:
     header.Length = packet.size() + sizeof(header.Opcode);
     header.Opcode = packet.GetOpcode();
 
-    fwrite(&header, sizeof(header), 1, _file);
-    if (!packet.empty())
-        fwrite(packet.contents(), 1, packet.size(), _file);
+    GetThreadRing()->Push(&header, sizeof(header), packet.empty() ? nullptr : packet.contents(), packet.size());
+}
+
+PacketLogRing* PacketLog::GetThreadRing()
+{
+    thread_local PacketLogRing* ring = nullptr;
+    if (!ring)
+    {
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        _rings.emplace_back(new PacketLogRing(_ringSize));
+        ring = _rings.back().get();
+    }
+    return ring;
+}
+
+void PacketLog::StartWriter()
+{
+    _writerStop = false;
+    _writer = std::thread(&PacketLog::WriterThread, this);
+}
+
+void PacketLog::StopWriter()
+{
+    if (!_writer.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_writerLock);
+        _writerStop = true;
+    }
+    _writerCondition.notify_one();
+    _writer.join();
+}
+
+void PacketLog::WriterThread()
+{
+    while (true)
+    {
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(_writerLock);
+            _writerCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return _writerStop; });
+            stop = _writerStop;
+        }
+
+        DrainRings();
+
+        if (stop)
+            break;
+    }
+}
+
+void PacketLog::DrainRings()
+{
+    uint32 dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        for (auto& ring : _rings)
+        {
+            ring->Drain(_file);
+            dropped += ring->TakeDropped();
+        }
+    }
 
     fflush(_file);
+
+    if (dropped)
+        sLog.outError("PacketLog: %u packets dropped, raise PacketLogBufferSize or narrow the PacketLog filters.", dropped);
 }
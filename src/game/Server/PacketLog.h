@@ -21,7 +21,13 @@
 #include "Common.h"
 
 #include <boost/asio/ip/address.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 enum Direction
 {
@@ -29,8 +35,47 @@ enum Direction
     SERVER_TO_CLIENT
 };
 
+#pragma pack(push, 1)
+
+// Packet logging structures in PKT 3.1 format, also read by mangos-replay
+struct LogHeader
+{
+    char Signature[3];
+    uint16 FormatVersion;
+    uint8 SnifferId;
+    uint32 Build;
+    char Locale[4];
+    uint8 SessionKey[40];
+    uint32 SniffStartUnixtime;
+    uint32 SniffStartTicks;
+    uint32 OptionalDataSize;
+};
+
+struct PacketHeader
+{
+    // used to uniquely identify a connection
+    struct OptionalData
+    {
+        uint8 SocketIPBytes[16];
+        uint32 SocketPort;
+    };
+
+    uint32 Direction;
+    uint32 ConnectionId;
+    uint32 ArrivalTicks;
+    uint32 OptionalDataSize;
+    uint32 Length;
+    OptionalData OptionalData;
+    uint32 Opcode;
+};
+
+#pragma pack(pop)
+
 class WorldPacket;
+class PacketLogRing;
 
+// Packets are serialized into a ring buffer owned by the calling thread and written to the file by a background thread.
+// A full ring drops packets instead of blocking the caller, the drops are reported in the server log.
 class PacketLog
 {
     private:
@@ -39,16 +84,40 @@ class PacketLog
         std::mutex _logPacketLock;
         std::once_flag _initializeFlag;
 
+        struct Filter
+        {
+            std::set<uint32> accounts;                      // logged even without .debug packetlog
+            std::vector<bool> opcodes;                      // empty - log all opcodes
+        };
+
     public:
         static PacketLog* instance();
 
         void Initialize();
         void Reinitialize();
-        bool CanLogPacket() const { return (_file != nullptr); }
+        bool CanLogPacket() const { return _enabled.load(std::memory_order_relaxed); }
+        bool ShouldLogPacket(uint32 accountId, uint16 opcode, bool sessionLogging) const;
         void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port);
 
     private:
+        void StartWriter();
+        void StopWriter();
+        void WriterThread();
+        void DrainRings();
+        PacketLogRing* GetThreadRing();
+
         FILE* _file;
+        std::atomic<bool> _enabled;
+        std::shared_ptr<Filter const> _filter;
+        std::atomic<uint32> _ringSize;                      // bytes, applies to rings created afterwards
+
+        std::mutex _ringsLock;                              // guards ring registration, held by the writer while draining
+        std::vector<std::unique_ptr<PacketLogRing>> _rings;
+
+        std::thread _writer;
+        std::mutex _writerLock;
+        std::condition_variable _writerCondition;
+        bool _writerStop;
 };
 
 #define sPacketLog PacketLog::instance()
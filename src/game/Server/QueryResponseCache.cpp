@@ -0,0 +1,45 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server/QueryResponseCache.h"
+#include "Policies/Singleton.h"
+
+INSTANTIATE_SINGLETON_1(QueryResponseCache);
+
+std::shared_ptr<WorldPacket const> QueryResponseCache::Get(QueryResponseType type, uint32 entry, int localeIndex) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_lock);
+    Responses const& responses = m_responses[type];
+    auto itr = responses.find(MakeKey(entry, localeIndex));
+    if (itr == responses.end())
+        return nullptr;
+
+    return itr->second;
+}
+
+void QueryResponseCache::Store(QueryResponseType type, uint32 entry, int localeIndex, std::shared_ptr<WorldPacket const> const& packet)
+{
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_responses[type][MakeKey(entry, localeIndex)] = packet;
+}
+
+void QueryResponseCache::Clear(QueryResponseType type)
+{
+    std::unique_lock<std::shared_mutex> lock(m_lock);
+    m_responses[type].clear();
+}
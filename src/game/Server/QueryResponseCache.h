@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_QUERY_RESPONSE_CACHE_H
+#define MANGOS_QUERY_RESPONSE_CACHE_H
+
+#include "Common.h"
+#include "WorldPacket.h"
+#include "Policies/Singleton.h"
+
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+enum QueryResponseType
+{
+    QUERY_RESPONSE_ITEM,
+    QUERY_RESPONSE_CREATURE,
+    QUERY_RESPONSE_GAMEOBJECT,
+    QUERY_RESPONSE_QUEST,
+    QUERY_RESPONSE_NPC_TEXT,
+    QUERY_RESPONSE_PAGE_TEXT,
+    MAX_QUERY_RESPONSE_TYPE
+};
+
+/**
+ * Built responses to the static data queries of clients, by entry and session DB locale index
+ *
+ * Responses are built by the first query and then sent as is. They must depend on the template and
+ * its locales only, reloads of these must call Clear.
+ */
+class QueryResponseCache
+{
+    public:
+        /// nullptr when not built yet
+        std::shared_ptr<WorldPacket const> Get(QueryResponseType type, uint32 entry, int localeIndex) const;
+        void Store(QueryResponseType type, uint32 entry, int localeIndex, std::shared_ptr<WorldPacket const> const& packet);
+
+        void Clear(QueryResponseType type);
+
+    private:
+        typedef std::unordered_map<uint64 /*entry, locale index*/, std::shared_ptr<WorldPacket const>> Responses;
+
+        static uint64 MakeKey(uint32 entry, int localeIndex) { return (uint64(entry) << 32) | uint32(localeIndex + 1); }
+
+        mutable std::shared_mutex m_lock;                   ///< queries are handled by the network threads
+        Responses m_responses[MAX_QUERY_RESPONSE_TYPE];
+};
+
+#define sQueryResponseCache MaNGOS::Singleton<QueryResponseCache>::Instance()
+
+#endif
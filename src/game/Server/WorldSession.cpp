@@ -25,6 +25,7 @@
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "Server/Opcodes.h"
+#include "Server/OpcodeStats.h"
 #include "WorldPacket.h"
 #include "Server/WorldSession.h"
 #include "Entities/Player.h"
@@ -38,8 +39,13 @@
 #include "GMTickets/GMTicketMgr.h"
 #include "Loot/LootMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Entities/UpdateData.h"
+#include "Maps/ZoneStats.h"
+#include "World/TickWatchdog.h"
+#include "Trace.h"
 
 #include <openssl/md5.h>
+#include <zlib.h>
 
 #include <mutex>
 #include <deque>
@@ -103,7 +109,8 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetStorageLocaleIndexFor(locale)),
     m_latency(0), m_tutorialState(TUTORIALDATA_UNCHANGED),
     m_timeSyncClockDeltaQueue(6), m_timeSyncClockDelta(0), m_pendingTimeSyncRequests(), m_timeSyncNextCounter(0), m_timeSyncTimer(0),
-    m_accountFlags(accountFlags), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter)
+    m_accountFlags(accountFlags), m_recruitingFriendId(recruitingFriend), m_isRecruiter(isARecruiter),
+    m_recvPacketPoolSize(0), m_pendingMoves(0), m_pendingMoveCount(0)
     {}
 
 /// WorldSession destructor
@@ -113,6 +120,9 @@ WorldSession::~WorldSession()
     if (_player)
         LogoutPlayer();
 
+    // the routed callbacks left look the session up again and free their results when it is gone
+    ProcessQueryCallbacks();
+
     // marks this session as finalized in the socket which references (BUT DOES NOT OWN) it.
     // this lets the socket handling code know that the socket can be safely deleted
     if (m_Socket)
@@ -203,6 +213,95 @@ void WorldSession::SetExpansion(uint8 expansion)
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= false*/) const
+{
+    if (CanSendPacket(packet, forcedSend))
+        m_Socket->SendPacket(packet);
+}
+
+/// Send a packet to the client, large packets reach the socket without a copy of their content
+void WorldSession::SendPacket(WorldPacket&& packet, bool forcedSend /*= false*/) const
+{
+    if (CanSendPacket(packet, forcedSend))
+        m_Socket->SendPacket(std::move(packet));
+}
+
+/// Send a packet broadcast to many sessions, large packets share one copy of their content between all sockets
+void WorldSession::SendPacket(SharedWorldPacket const& packet, bool forcedSend /*= false*/) const
+{
+    if (CanSendPacket(packet.GetPacket(), forcedSend))
+        m_Socket->SendPacket(packet);
+}
+
+/// Send a batch of packets, the socket is locked once for all that pass CanSendPacket
+void WorldSession::SendPackets(std::vector<std::shared_ptr<WorldPacket const>> const& packets) const
+{
+    std::vector<WorldPacket const*> toSend;
+    toSend.reserve(packets.size());
+    for (auto const& packet : packets)
+        if (CanSendPacket(*packet, false))
+            toSend.push_back(packet.get());
+
+    if (!toSend.empty())
+        m_Socket->SendPackets(toSend);
+}
+
+/// Hold a monster move until FlushMonsterMoves, moves too large for an entry are sent after the held ones
+void WorldSession::QueueMonsterMove(WorldPacket const& packet)
+{
+    if (!CanSendPacket(packet, false))
+        return;
+
+    if (packet.size() + 2 > 0xFF)
+    {
+        FlushMonsterMoves();
+        m_Socket->SendPacket(packet);
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_pendingMovesLock);
+    if (!m_pendingMoveCount)
+        m_pendingMoves.reserve(512);
+    m_pendingMoves << uint8(packet.size() + 2);
+    m_pendingMoves << uint16(packet.GetOpcode());
+    m_pendingMoves.append(packet.contents(), packet.size());
+    ++m_pendingMoveCount;
+}
+
+/// Send the held monster moves, a single one as it is and more compressed into one SMSG_COMPRESSED_MOVES
+void WorldSession::FlushMonsterMoves()
+{
+    std::lock_guard<std::mutex> guard(m_pendingMovesLock);
+    if (!m_pendingMoveCount)
+        return;
+
+    if (m_Socket && !m_Socket->IsClosed())
+    {
+        if (m_pendingMoveCount == 1)
+        {
+            WorldPacket data(Opcodes(m_pendingMoves.read<uint16>(1)), m_pendingMoves.size() - 3);
+            data.append(m_pendingMoves.contents() + 3, m_pendingMoves.size() - 3);
+            m_Socket->SendPacket(std::move(data));
+        }
+        else
+        {
+            uint32 destSize = compressBound(m_pendingMoves.size());
+            WorldPacket data(SMSG_COMPRESSED_MOVES, sizeof(uint32) + destSize);
+            data.resize(sizeof(uint32) + destSize);
+            data.put<uint32>(0, uint32(m_pendingMoves.size()));
+            UpdateData::Compress(const_cast<uint8*>(data.contents()) + sizeof(uint32), &destSize, (void*)m_pendingMoves.contents(), int(m_pendingMoves.size()));
+            if (destSize)
+            {
+                data.resize(sizeof(uint32) + destSize);
+                m_Socket->SendPacket(std::move(data));
+            }
+        }
+    }
+
+    m_pendingMoves.clear();
+    m_pendingMoveCount = 0;
+}
+
+bool WorldSession::CanSendPacket(WorldPacket const& packet, bool forcedSend) const
 {
 #ifdef BUILD_PLAYERBOT
     // Send packet to bot AI
@@ -218,7 +317,7 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
     if (!m_Socket || (m_sessionState != WORLD_SESSION_STATE_READY && !forcedSend))
     {
         //sLog.outDebug("Refused to send %s to %s", packet.GetOpcodeName(), _player ? _player->GetName() : "UKNOWN");
-        return;
+        return false;
     }
 
 #ifdef MANGOS_DEBUG
@@ -257,7 +356,10 @@ void WorldSession::SendPacket(WorldPacket const& packet, bool forcedSend /*= fal
 
 #endif                                                  // !MANGOS_DEBUG
 
-    m_Socket->SendPacket(packet);
+    if (_player && _player->IsInWorld())
+        sZoneStats.RecordPacket(_player, packet.size());
+
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -267,35 +369,70 @@ void WorldSession::QueuePacket(std::unique_ptr<WorldPacket> new_packet)
     OpcodeHandler const& opHandle = opcodeTable[new_packet->GetOpcode()];
     if (opHandle.packetProcessing == PROCESS_IMMEDIATE)
     {
+        bool const measure = sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS);
+        std::chrono::steady_clock::time_point const start = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
         (this->*opHandle.handler)(*new_packet);
+
+        if (measure)
+            sOpcodeStats.Record(new_packet->GetOpcode(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
         if (new_packet->rpos() < new_packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
             LogUnprocessedTail(*new_packet);
         return;
     }
 
     if (opHandle.packetProcessing == PROCESS_MAP_THREAD)
-    {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        m_recvQueueMap.push_back(std::move(new_packet));
-    }
+        m_recvQueueMap.Enqueue(std::move(new_packet));
+    else if (opHandle.packetProcessing == PROCESS_SESSION_PARALLEL)
+        m_recvQueueParallel.Enqueue(std::move(new_packet));
     else
+        m_recvQueue.Enqueue(std::move(new_packet));
+}
+
+std::unique_ptr<WorldPacket> WorldSession::AcquireRecvPacket(uint16 opcode, size_t size)
+{
+    std::unique_ptr<WorldPacket> packet;
+
+    // a reconnecting client can briefly have two sockets reading, only one of them may consume the pool
+    if (!m_recvPacketPoolConsumer.test_and_set(std::memory_order_acquire))
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        m_recvQueue.push_back(std::move(new_packet));
+        if (m_recvPacketPool.Dequeue(packet))
+            --m_recvPacketPoolSize;
+        m_recvPacketPoolConsumer.clear(std::memory_order_release);
     }
+
+    if (!packet)
+        return std::unique_ptr<WorldPacket>(new WorldPacket(Opcodes(opcode), size));
+
+    packet->Initialize(Opcodes(opcode), size);
+    return packet;
+}
+
+void WorldSession::RecycleRecvPacket(std::unique_ptr<WorldPacket> packet)
+{
+    // bound what an idle session keeps around, the rest goes back to the heap
+    if (m_recvPacketPoolSize >= RECV_PACKET_POOL_SIZE)
+        return;
+
+    ++m_recvPacketPoolSize;
+    m_recvPacketPool.Enqueue(std::move(packet));
 }
 
 void WorldSession::DeleteMovementPackets()
 {
-    std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-    for (auto itr = m_recvQueueMap.begin(); itr != m_recvQueueMap.end();)
+    // called from the map thread, the consumer of m_recvQueueMap
+    std::unique_ptr<WorldPacket> packet;
+    while (m_recvQueueMap.Dequeue(packet))
+        m_recvQueueMapPending.push_back(std::move(packet));
+
+    for (auto itr = m_recvQueueMapPending.begin(); itr != m_recvQueueMapPending.end();)
     {
         switch ((*itr)->GetOpcode())
         {
             case MSG_MOVE_SET_FACING:
             case MSG_MOVE_HEARTBEAT:
             {
-                itr = m_recvQueueMap.erase(itr);
+                itr = m_recvQueueMapPending.erase(itr);
                 break;
             }
             default:
@@ -349,12 +486,22 @@ void WorldSession::ProcessByteBufferException(WorldPacket const& packet)
 /// Update the WorldSession (triggered by World update)
 bool WorldSession::Update(uint32 /*diff*/)
 {
+    TRACE_ZONE_ID("WorldSession::Update", GetAccountId());
     GetMessager().Execute(this);
 
+    // with a player in world they wait for the map update
+    if (!_player || !_player->IsInWorld())
+        ProcessQueryCallbacks();
+
+    // only packets received until now, later ones wait for the next update
+    // parallel packets not taken by UpdateParallel (no player in world or no session update threads) go first
     std::deque<std::unique_ptr<WorldPacket>> recvQueueCopy;
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueLock);
-        std::swap(recvQueueCopy, m_recvQueue);
+        std::unique_ptr<WorldPacket> packet;
+        while (m_recvQueueParallel.Dequeue(packet))
+            recvQueueCopy.push_back(std::move(packet));
+        while (m_recvQueue.Dequeue(packet))
+            recvQueueCopy.push_back(std::move(packet));
     }
 
     if (m_Socket && !m_Socket->IsClosed() && m_anticheat)
@@ -370,7 +517,7 @@ bool WorldSession::Update(uint32 /*diff*/)
     {
         // sLog.outError("MOEP: %s (0x%.4X)", packet->GetOpcodeName(), packet->GetOpcode());
 
-        auto const packet = std::move(recvQueueCopy.front());
+        auto packet = std::move(recvQueueCopy.front());
         recvQueueCopy.pop_front();
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
@@ -448,6 +595,8 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             ProcessByteBufferException(*packet);
         }
+
+        RecycleRecvPacket(std::move(packet));
     }
 
 #ifdef BUILD_PLAYERBOT
@@ -462,10 +611,11 @@ bool WorldSession::Update(uint32 /*diff*/)
         {
             Player* const botPlayer = itr->second;
             WorldSession* const pBotWorldSession = botPlayer->GetSession();
-            while(!pBotWorldSession->m_recvQueue.empty())
+            std::unique_ptr<WorldPacket> botpacket;
+            while (pBotWorldSession->m_recvQueueParallel.Dequeue(botpacket))
+                pBotWorldSession->ExecuteOpcode(opcodeTable[botpacket->GetOpcode()], *botpacket);
+            while (pBotWorldSession->m_recvQueue.Dequeue(botpacket))
             {
-                auto const botpacket = std::move(pBotWorldSession->m_recvQueue.front());
-                pBotWorldSession->m_recvQueue.pop_front();
 
                 OpcodeHandler const& opHandle = opcodeTable[botpacket->GetOpcode()];
                 pBotWorldSession->ExecuteOpcode(opHandle, *botpacket);
@@ -557,6 +707,35 @@ bool WorldSession::Update(uint32 /*diff*/)
     return true;
 }
 
+void WorldSession::ProcessQueryCallbacks()
+{
+    std::unique_ptr<MaNGOS::IQueryCallback> callback;
+    while (m_queryCallbacks.Dequeue(callback))
+        callback->Execute();
+}
+
+void WorldSession::UpdateParallel()
+{
+    // status checks of Update are all passed by a player in world, until then the packets wait for Update
+    if (!_player || !_player->IsInWorld() || !m_Socket || m_Socket->IsClosed())
+        return;
+
+    std::unique_ptr<WorldPacket> packet;
+    while (m_recvQueueParallel.Dequeue(packet))
+    {
+        try
+        {
+            ExecuteOpcode(opcodeTable[packet->GetOpcode()], *packet);
+        }
+        catch (ByteBufferException&)
+        {
+            ProcessByteBufferException(*packet);
+        }
+
+        RecycleRecvPacket(std::move(packet));
+    }
+}
+
 void WorldSession::UpdateMap(uint32 diff)
 {
     // Send time sync packet every 10s.
@@ -568,15 +747,19 @@ void WorldSession::UpdateMap(uint32 diff)
             m_timeSyncTimer -= diff;
     }
 
+    ProcessQueryCallbacks();
+
     std::deque<std::unique_ptr<WorldPacket>> recvQueueMapCopy;
+    std::swap(recvQueueMapCopy, m_recvQueueMapPending);
     {
-        std::lock_guard<std::mutex> guard(m_recvQueueMapLock);
-        std::swap(recvQueueMapCopy, m_recvQueueMap);
+        std::unique_ptr<WorldPacket> packet;
+        while (m_recvQueueMap.Dequeue(packet))
+            recvQueueMapCopy.push_back(std::move(packet));
     }
 
     while (m_Socket && !m_Socket->IsClosed() && recvQueueMapCopy.size())
     {
-        auto const packet = std::move(recvQueueMapCopy.front());
+        auto packet = std::move(recvQueueMapCopy.front());
         recvQueueMapCopy.pop_front();
 
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
@@ -592,6 +775,8 @@ void WorldSession::UpdateMap(uint32 diff)
         {
             ProcessByteBufferException(*packet);
         }
+
+        RecycleRecvPacket(std::move(packet));
     }
 }
 
@@ -610,6 +795,8 @@ void WorldSession::LogoutPlayer()
 
     if (_player)
     {
+        ObjectGuid playerGuid = _player->GetObjectGuid();
+
 #ifdef BUILD_PLAYERBOT
         // Log out all player bots owned by this toon
         if (_player->GetPlayerbotMgr())
@@ -692,6 +879,7 @@ void WorldSession::LogoutPlayer()
             }
 
             guild->BroadcastEvent(GE_SIGNED_OFF, _player->GetObjectGuid(), _player->GetName());
+            guild->MemberLoggedOut(_player->GetObjectGuid());
         }
 
         ///- Remove pet
@@ -768,6 +956,10 @@ void WorldSession::LogoutPlayer()
         stmt.PExecute(GetAccountId());
 #endif
 
+        // queued after all logout writes
+        if (m_playerSave)
+            FillCharacterLoginCache(playerGuid);
+
         DEBUG_LOG("SESSION: Sent SMSG_LOGOUT_COMPLETE Message");
     }
 
@@ -1175,7 +1367,15 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& pac
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    bool const measure = sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS);
+    std::chrono::steady_clock::time_point const start = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    WatchdogFrame frame(WATCHDOG_FRAME_OPCODE, nullptr, packet.GetOpcode());
     (this->*opHandle.handler)(packet);
+    frame.Pop();
+
+    if (measure)
+        sOpcodeStats.Record(packet.GetOpcode(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
 
     if (_player)
     {
@@ -1300,15 +1500,11 @@ void WorldSession::SetDelayedAnticheat(std::unique_ptr<SessionAnticheatInterface
     m_delayedAnticheat = std::move(anticheat);
 }
 
-#ifdef BUILD_PLAYERBOT
-
 void WorldSession::SetNoAnticheat()
 {
     m_anticheat.reset(new NullSessionAnticheat(this));
 }
 
-#endif
-
 void WorldSession::HandleWardenDataOpcode(WorldPacket& recv_data)
 {
     m_anticheat->WardenPacket(recv_data);
@@ -31,6 +31,8 @@
 #include "Entities/Item.h"
 #include "WorldSocket.h"
 #include "Multithreading/Messager.h"
+#include "Multithreading/MPSCQueue.h"
+#include "Utilities/Callback.h"
 
 #include <map>
 #include <deque>
@@ -52,9 +54,14 @@ class Object;
 class Player;
 class Unit;
 class WorldPacket;
+class SharedWorldPacket;
 class QueryResult;
 class LoginQueryHolder;
+class MailQueryHolder;
 class CharacterHandler;
+class AuctionHouseObject;
+struct AuctionListQuery;
+struct AuctionListResult;
 class GMTicket;
 class MovementInfo;
 class WorldSession;
@@ -78,6 +85,8 @@ enum AccountDataType
 #define GLOBAL_CACHE_MASK           0x15
 #define PER_CHARACTER_CACHE_MASK    0xEA
 
+#define RECV_PACKET_POOL_SIZE       32                      // processed client packets kept per session for reuse
+
 struct AccountData
 {
     AccountData() : Time(0), Data("") {}
@@ -237,6 +246,13 @@ class WorldSession
         void SizeError(WorldPacket const& packet, uint32 size) const;
 
         void SendPacket(WorldPacket const& packet, bool forcedSend = false) const;
+        void SendPacket(WorldPacket&& packet, bool forcedSend = false) const;
+        void SendPacket(SharedWorldPacket const& packet, bool forcedSend = false) const;
+        // monster moves are held until FlushMonsterMoves and then sent in one SMSG_COMPRESSED_MOVES
+        void QueueMonsterMove(WorldPacket const& packet);
+        void FlushMonsterMoves();
+        // packets collected for this session during a map update, sent under one socket lock
+        void SendPackets(std::vector<std::shared_ptr<WorldPacket const>> const& packets) const;
         void SendExpectedSpamRecords();
         void SendMotd();
         void SendOfflineNameQueryResponses();
@@ -278,9 +294,8 @@ class WorldSession
         void SetDelayedAnticheat(std::unique_ptr<SessionAnticheatInterface>&& anticheat);
         SessionAnticheatInterface* GetAnticheat() const { return m_anticheat.get(); }
 
-#ifdef BUILD_PLAYERBOT
+        /// For sessions without a client, playerbots and mangos-bench
         void SetNoAnticheat();
-#endif
 
         /// Session in auth.queue currently
         void SetInQueue(bool state) { m_inQueue = state; }
@@ -311,17 +326,26 @@ class WorldSession
         void KickPlayer(bool save = false, bool inPlace = false); // inplace variable needed for shutdown
 
         void QueuePacket(std::unique_ptr<WorldPacket> new_packet);
+        // reuses an already processed packet of this session if one is pooled, only called from the socket's network thread
+        std::unique_ptr<WorldPacket> AcquireRecvPacket(uint16 opcode, size_t size);
 
         void DeleteMovementPackets();
 
         bool Update(uint32 diff);
         void UpdateMap(uint32 diff);
+        // PROCESS_SESSION_PARALLEL packets of a player in world, run for many sessions at once before the serial updates
+        void UpdateParallel();
+
+        // async query results routed to this account, see World::InitResultQueue
+        // run by the map thread of the player in world, else by Update
+        void QueueQueryCallback(std::unique_ptr<MaNGOS::IQueryCallback> callback) { m_queryCallbacks.Enqueue(std::move(callback)); }
+        void ProcessQueryCallbacks();
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position) const;
 
         void SendNameQueryResponse(CharacterNameQueryResponse& response) const;
-        void SendNameQueryResponseFromDB(ObjectGuid guid) const;
+        void SendNameQueryResponseFromDB(ObjectGuid guid);
         static void SendNameQueryResponseFromDBCallBack(QueryResult* result, uint32 accountId);
 
         void SendTrainerList(ObjectGuid guid) const;
@@ -383,8 +407,15 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction) const;
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         static void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-                                   uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull) const;
+
+        // mail
+        void SendMailList();
+        void LoadMails();
+        bool LoadMailListItems();
+        void HandleMailsLoaded(MailQueryHolder* holder);
+        void HandleMailListItemsLoaded(MailQueryHolder* holder);
+        void BuildListAuctionItems(AuctionHouseObject* auctionHouse, AuctionListQuery const& query, uint32 usable, uint32 listfrom, WorldPacket& data, uint32& count, uint32& totalcount) const;
+        void FillListAuctionItems(AuctionHouseObject* auctionHouse, AuctionListResult& result, uint32 usable) const;
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid) const;
 
@@ -473,6 +504,8 @@ class WorldSession
         void HandlePlayerLoginOpcode(WorldPacket& recvPacket);
         void HandleCharEnum(QueryResult* result);
         void HandlePlayerLogin(LoginQueryHolder* holder);
+        // read back the login data after the logout save, see CharacterLoginCache
+        void FillCharacterLoginCache(ObjectGuid playerGuid);
         void HandlePlayerReconnect();
 
         // played time
@@ -912,6 +945,7 @@ class WorldSession
         void HandleMoverRelocation(MovementInfo& movementInfo);
 
         void ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket& packet);
+        bool CanSendPacket(WorldPacket const& packet, bool forcedSend) const;
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket const& packet, const char* reason) const;
@@ -975,15 +1009,29 @@ class WorldSession
         uint32 m_recruitingFriendId;
         bool m_isRecruiter;
 
+        void RecycleRecvPacket(std::unique_ptr<WorldPacket> packet);
+
         // Thread safety mechanisms
-        std::mutex m_recvQueueLock;
-        std::mutex m_recvQueueMapLock;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueue;
-        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMap;
+        std::mutex m_recvQueueLock;                         // guards socket requests, the queues below are lock-free
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueue;        // consumed by the world thread
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueueMap;     // consumed by the map thread of the player
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvQueueParallel; // consumed by a session update thread, else by the world thread
+        MPSCQueue<std::unique_ptr<MaNGOS::IQueryCallback>> m_queryCallbacks; // consumed by the map thread of the player, else by the world thread
+        std::deque<std::unique_ptr<WorldPacket>> m_recvQueueMapPending; // map thread only, left over by DeleteMovementPackets
+
+        // processed packets handed back to the network thread, keeps their buffers between reads
+        MPSCQueue<std::unique_ptr<WorldPacket>> m_recvPacketPool;
+        std::atomic<uint32> m_recvPacketPoolSize;
+        std::atomic_flag m_recvPacketPoolConsumer = ATOMIC_FLAG_INIT;
 
         Messager<WorldSession> m_messager;
 
         std::atomic<uint32> m_currentPlayerLevel;
+
+        // entries of SMSG_COMPRESSED_MOVES: uint8 size, uint16 opcode, content
+        std::mutex m_pendingMovesLock;
+        ByteBuffer m_pendingMoves;
+        uint32 m_pendingMoveCount;
 };
 #endif
 /// @}
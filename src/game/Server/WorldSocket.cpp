@@ -72,6 +72,27 @@ std::vector<uint32> InitOpcodeCooldowns()
 
 std::vector<uint32> WorldSocket::m_packetCooldowns = InitOpcodeCooldowns();
 
+std::vector<bool> InitLatencyCriticalOpcodes()
+{
+    std::vector<bool> data(NUM_MSG_TYPES, false);
+
+    // movement broadcasts and splines
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        char const* name = LookupOpcodeName(i);
+        if (!strncmp(name, "MSG_MOVE_", 9) || !strncmp(name, "SMSG_MONSTER_MOVE", 17) || !strncmp(name, "SMSG_SPLINE_", 12))
+            data[i] = true;
+    }
+
+    data[SMSG_COMPRESSED_MOVES] = true;
+    data[SMSG_SPELL_GO] = true;
+    data[SMSG_ATTACKERSTATEUPDATE] = true;
+
+    return data;
+}
+
+std::vector<bool> WorldSocket::m_latencyCriticalOpcodes = InitLatencyCriticalOpcodes();
+
 std::deque<uint32> WorldSocket::GetOutOpcodeHistory()
 {
     std::lock_guard<std::mutex> guard(m_worldSocketMutex);
@@ -94,34 +115,97 @@ void WorldSocket::SendPacket(const WorldPacket& pct, bool immediate)
     if (IsClosed())
         return;
 
-    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+    LogOutgoingPacket(pct);
+    WriteOutgoingPacket(pct.GetOpcode(), pct.size(), pct.contents(), nullptr, immediate);
+}
+
+void WorldSocket::SendPacket(WorldPacket&& pct, bool immediate)
+{
+    // small packets are cheaper to copy next to their header than to queue as an own buffer
+    if (pct.size() < ZERO_COPY_MIN_PACKET_SIZE)
+    {
+        SendPacket(static_cast<const WorldPacket&>(pct), immediate);
+        return;
+    }
+
+    if (IsClosed())
+        return;
+
+    LogOutgoingPacket(pct);
+
+    size_t const size = pct.size();
+    std::shared_ptr<const std::vector<uint8>> content = std::make_shared<const std::vector<uint8>>(pct.ReleaseStorage());
+    WriteOutgoingPacket(pct.GetOpcode(), size, nullptr, std::move(content), immediate);
+}
+
+void WorldSocket::SendPacket(const SharedWorldPacket& pct, bool immediate)
+{
+    if (!pct.GetContent())
+    {
+        SendPacket(pct.GetPacket(), immediate);
+        return;
+    }
+
+    if (IsClosed())
+        return;
+
+    LogOutgoingPacket(pct.GetPacket());
+    WriteOutgoingPacket(pct.GetPacket().GetOpcode(), pct.GetPacket().size(), nullptr, pct.GetContent(), immediate);
+}
+
+void WorldSocket::LogOutgoingPacket(const WorldPacket& pct)
+{
+    if (sPacketLog->CanLogPacket() && sPacketLog->ShouldLogPacket(m_session ? m_session->GetAccountId() : 0, pct.GetOpcode(), IsLoggingPackets()))
         sPacketLog->LogPacket(pct, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
     // Dump outgoing packet.
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct.GetOpcode(), pct.GetOpcodeName(), pct, false);
+}
 
+void WorldSocket::SendPackets(std::vector<WorldPacket const*> const& packets)
+{
+    if (IsClosed())
+        return;
+
+    for (WorldPacket const* packet : packets)
+        LogOutgoingPacket(*packet);
+
+    std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+    for (WorldPacket const* packet : packets)
+        WriteOutgoingPacketLocked(packet->GetOpcode(), packet->size(), packet->contents(), nullptr, false);
+}
+
+void WorldSocket::WriteOutgoingPacket(uint16 opcode, size_t size, const uint8* contents, std::shared_ptr<const std::vector<uint8>> sharedContents, bool immediate)
+{
     // encrypt thread unsafe due to being executed from map contexts frequently - TODO: move to post service context in future
     std::lock_guard<std::mutex> guard(m_worldSocketMutex);
+    WriteOutgoingPacketLocked(opcode, size, contents, std::move(sharedContents), immediate);
+}
 
+void WorldSocket::WriteOutgoingPacketLocked(uint16 opcode, size_t size, const uint8* contents, std::shared_ptr<const std::vector<uint8>> sharedContents, bool immediate)
+{
     ServerPktHeader header;
 
-    header.cmd = pct.GetOpcode();
+    header.cmd = opcode;
     EndianConvert(header.cmd);
 
-    header.size = static_cast<uint16>(pct.size() + 2);
+    header.size = static_cast<uint16>(size + 2);
     EndianConvertReverse(header.size);
 
+    // header is encrypted in place, only the payload is shared
     m_crypt.EncryptSend(reinterpret_cast<uint8*>(&header), sizeof(header));
 
-    if (pct.size() > 0)
-        Write(reinterpret_cast<const char*>(&header), sizeof(header), reinterpret_cast<const char*>(pct.contents()), pct.size());
+    if (sharedContents)
+        Write(reinterpret_cast<const char*>(&header), sizeof(header), std::move(sharedContents));
+    else if (size > 0)
+        Write(reinterpret_cast<const char*>(&header), sizeof(header), reinterpret_cast<const char*>(contents), size);
     else
         Write(reinterpret_cast<const char*>(&header), sizeof(header));
 
-    if (immediate)
+    if (immediate || (m_latencyCriticalOpcodes[opcode] && sWorld.getConfig(CONFIG_BOOL_NETWORK_FLUSH_LATENCY_CRITICAL)))
         ForceFlushOut();
 
-    m_opcodeHistoryOut.push_front(uint32(pct.GetOpcode()));
+    m_opcodeHistoryOut.push_front(uint32(opcode));
     if (m_opcodeHistoryOut.size() > 50)
         m_opcodeHistoryOut.resize(30);
 }
@@ -207,7 +291,7 @@ bool WorldSocket::ProcessIncomingData()
     if (IsClosed())
         return false;
 
-    std::unique_ptr<WorldPacket> pct(new WorldPacket(opcode, validBytesRemaining));
+    std::unique_ptr<WorldPacket> pct = m_session ? m_session->AcquireRecvPacket(opcode, validBytesRemaining) : std::unique_ptr<WorldPacket>(new WorldPacket(opcode, validBytesRemaining));
 
     if (validBytesRemaining)
     {
@@ -215,7 +299,7 @@ bool WorldSocket::ProcessIncomingData()
         ReadSkip(validBytesRemaining);
     }
 
-    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+    if (sPacketLog->CanLogPacket() && sPacketLog->ShouldLogPacket(m_session ? m_session->GetAccountId() : 0, opcode, IsLoggingPackets()))
         sPacketLog->LogPacket(*pct, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort());
 
     sLog.outWorldPacketDump(GetRemoteEndpoint().c_str(), pct->GetOpcode(), pct->GetOpcodeName(), *pct, true);
@@ -33,8 +33,11 @@
 #include <chrono>
 #include <functional>
 #include <deque>
+#include <memory>
+#include <vector>
 
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSession;
 
 /**
@@ -123,6 +126,11 @@ class WorldSocket : public MaNGOS::Socket
 
         std::mutex m_worldSocketMutex;
 
+        void LogOutgoingPacket(const WorldPacket& pct);
+        void WriteOutgoingPacket(uint16 opcode, size_t size, const uint8* contents, std::shared_ptr<const std::vector<uint8>> sharedContents, bool immediate);
+        // m_worldSocketMutex held by the caller
+        void WriteOutgoingPacketLocked(uint16 opcode, size_t size, const uint8* contents, std::shared_ptr<const std::vector<uint8>> sharedContents, bool immediate);
+
         std::deque<uint32> m_opcodeHistoryOut;
         std::deque<uint32> m_opcodeHistoryInc;
 
@@ -133,6 +141,12 @@ class WorldSocket : public MaNGOS::Socket
 
         // send a packet \o/
         void SendPacket(const WorldPacket& pct, bool immediate = false);
+        // large packets are queued without copying their content, the packet is left empty
+        void SendPacket(WorldPacket&& pct, bool immediate = false);
+        // content of a broadcast packet shared with other sockets, queued without copying
+        void SendPacket(const SharedWorldPacket& pct, bool immediate = false);
+        // several packets under one lock of the socket, in order
+        void SendPackets(std::vector<WorldPacket const*> const& packets);
 
         void FinalizeSession() { m_session = nullptr; }
 
@@ -145,6 +159,7 @@ class WorldSocket : public MaNGOS::Socket
         std::deque<uint32> GetIncOpcodeHistory();
 
         static std::vector<uint32> m_packetCooldowns;
+        static std::vector<bool> m_latencyCriticalOpcodes;  // flushed at once instead of waiting for the coalescing delay
         std::map<uint32, TimePoint> m_lastPacket;
 
         bool IsLoggingPackets() const { return m_loggingPackets; }
@@ -72,6 +72,8 @@ struct FriendInfo
 
 typedef std::map<uint32, FriendInfo> PlayerSocialMap;
 typedef std::map<uint32, PlayerSocial> SocialMap;
+typedef std::unordered_set<uint32> FriendListerSet;
+typedef std::unordered_map<uint32, FriendListerSet> FriendListerMap;
 
 /// Results of friend related commands
 enum FriendsResult
@@ -136,7 +138,10 @@ class SocialMgr
         SocialMgr();
         ~SocialMgr();
         // Misc
-        void RemovePlayerSocial(uint32 guid) { m_socialMap.erase(guid); }
+        void RemovePlayerSocial(uint32 guid);
+        // reverse index of friend lists, kept for the players with a loaded social list
+        void AddFriendLister(uint32 friend_lowguid, uint32 lister_lowguid) { m_friendListers[friend_lowguid].insert(lister_lowguid); }
+        void RemoveFriendLister(uint32 friend_lowguid, uint32 lister_lowguid);
 
         void GetFriendInfo(Player* player, uint32 friend_lowguid, FriendInfo& friendInfo) const;
         // Packet management
@@ -147,6 +152,7 @@ class SocialMgr
         PlayerSocial* LoadFromDB(QueryResult* result, ObjectGuid guid);
     private:
         SocialMap m_socialMap;
+        FriendListerMap m_friendListers;                    // friend guid -> guids of the loaded players having him as friend
 };
 
 #define sSocialMgr MaNGOS::Singleton<SocialMgr>::Instance()
@@ -46,6 +46,7 @@
 #include "MotionGenerators/PathFinder.h"
 #include "Spells/Scripts/SpellScript.h"
 #include "Entities/ObjectGuid.h"
+#include "Trace.h"
 
 extern pEffect SpellEffects[MAX_SPELL_EFFECTS];
 
@@ -476,6 +477,7 @@ Spell::Spell(WorldObject* caster, SpellEntry const* info, uint32 triggeredFlags,
     m_travellingStart = UINT32_MAX;
 
     m_targetlessMask = 0;
+    m_cacheAreaTargets = false;
 
     m_overrideSpeed = false;
 
@@ -512,6 +514,18 @@ WorldObject* Spell::FindCorpseUsing()
 
 void Spell::FillTargetMap()
 {
+    // candidates are only shared between the effects of this fill, the units may be gone by the next one
+    struct AreaTargetsCacheScope
+    {
+        explicit AreaTargetsCacheScope(Spell& spell) : m_spell(spell) { m_spell.m_cacheAreaTargets = true; }
+        ~AreaTargetsCacheScope()
+        {
+            m_spell.m_cacheAreaTargets = false;
+            m_spell.m_areaTargetsCache.clear();
+        }
+        Spell& m_spell;
+    } areaTargetsCacheScope(*this);
+
     // TODO: ADD the correct target FILLS!!!!!!
     TempTargetingData targetingData;
     uint8 effToIndex[MAX_EFFECT_INDEX] = {0, 1, 2};         // Helper array, to link to another tmpUnitList, if the targets for both effects match
@@ -3194,6 +3208,7 @@ void Spell::cancel()
 
 SpellCastResult Spell::cast(bool skipCheck)
 {
+    TRACE_ZONE_ID("Spell::cast", m_spellInfo->Id);
     SetExecutedCurrently(true);
     SpellModRAII spellModController(this, m_trueCaster->GetSpellModOwner());
 
@@ -4047,7 +4062,8 @@ void Spell::SendSpellGo()
     if (m_CastItem)
         castFlags |= CAST_FLAG_UNKNOWN7;
 
-    WorldPacket data(SMSG_SPELL_GO, 50);                    // guess size
+    // two packed guids, spell, flags, time, hit and miss lists, targets and ammo
+    WorldPacket data(SMSG_SPELL_GO, (9 + 9 + 4 + 2 + 4) + (1 + 1 + (m_UniqueTargetInfo.size() + m_UniqueGOTargetInfo.size()) * (8 + 1)) + 32 + (4 + 4));
 
     if (m_CastItem)
         data << m_CastItem->GetPackGUID();
@@ -7597,8 +7613,28 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
  */
 void Spell::FillAreaTargets(UnitList& targetUnitMap, float radius, float cone, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=nullptr*/)
 {
-    MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, cone, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_trueCaster->GetMap(), notifier, radius);
+    if (!m_cacheAreaTargets)
+    {
+        MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, cone, pushType, spellTargets, originalCaster);
+        Cell::VisitUnits(notifier.GetCenterX(), notifier.GetCenterY(), m_trueCaster->GetMap(), notifier, radius);
+        return;
+    }
+
+    UnitList units;
+    MaNGOS::SpellNotifierCreatureAndPlayer notifier(*this, units, radius, cone, pushType, spellTargets, originalCaster);
+    for (AreaTargetsCacheEntry const& entry : m_areaTargetsCache)
+    {
+        if (entry.radius == radius && entry.cone == cone && entry.pushType == pushType && entry.spellTargets == spellTargets &&
+            entry.originalCaster == notifier.i_originalCaster && entry.x == notifier.i_centerX && entry.y == notifier.i_centerY && entry.z == notifier.i_centerZ)
+        {
+            targetUnitMap.insert(targetUnitMap.end(), entry.units.begin(), entry.units.end());
+            return;
+        }
+    }
+
+    Cell::VisitUnits(notifier.GetCenterX(), notifier.GetCenterY(), m_trueCaster->GetMap(), notifier, radius);
+    targetUnitMap.insert(targetUnitMap.end(), units.begin(), units.end());
+    m_areaTargetsCache.push_back({ radius, cone, pushType, spellTargets, notifier.i_originalCaster, notifier.i_centerX, notifier.i_centerY, notifier.i_centerZ, std::move(units) });
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList& targetUnitMap, Unit* member, float radius, bool raid, bool withPets, bool withcaster) const
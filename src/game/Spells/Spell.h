@@ -28,6 +28,7 @@
 #include "Entities/Player.h"
 #include "Server/SQLStorages.h"
 #include "Spells/SpellEffectDefines.h"
+#include "Utilities/ObjectPool.h"
 
 class WorldSession;
 class WorldPacket;
@@ -340,7 +341,7 @@ class SpellCastArgs
         Position m_destination;
 };
 
-class Spell
+class Spell : public MaNGOS::PooledObject<Spell>
 {
         friend struct MaNGOS::SpellNotifierPlayer;
         friend struct MaNGOS::SpellNotifierCreatureAndPlayer;
@@ -952,6 +953,20 @@ class Spell
         float m_jumpRadius;
         SpellTargetFilterScheme m_filteringScheme[MAX_EFFECT_INDEX][2];
 
+        // area searches done while filling the target map, effects asking for the same area reuse the candidates
+        struct AreaTargetsCacheEntry
+        {
+            float radius;
+            float cone;
+            SpellNotifyPushType pushType;
+            SpellTargets spellTargets;
+            WorldObject* originalCaster;
+            float x, y, z;
+            UnitList units;
+        };
+        std::vector<AreaTargetsCacheEntry> m_areaTargetsCache;
+        bool m_cacheAreaTargets;
+
         std::set<Aura*> m_procOnceHolder;
 
         struct EffectSkillInfo
@@ -1088,84 +1103,87 @@ namespace MaNGOS
         }
 
         template<class T> inline void Visit(GridRefManager<T>& m)
+        {
+            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                Visit(itr->getSource());
+        }
+
+        // also called directly by Cell::VisitUnits
+        inline void Visit(Unit* target)
         {
             if (!i_originalCaster || !i_castingObject)
                 return;
 
-            for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            // mostly phase check
+            if (i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT))
             {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                // mostly phase check
-                if (i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX6_IGNORE_PHASE_SHIFT))
-                {
-                    if (!itr->getSource()->IsInMapIgnorePhase(i_originalCaster))
-                        continue;
-                }
-                else if (!itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+                if (!target->IsInMapIgnorePhase(i_originalCaster))
+                    return;
+            }
+            else if (!target->IsInMap(i_originalCaster))
+                return;
 
-                if (itr->getSource()->IsTaxiFlying())
-                    continue;
+            if (target->IsTaxiFlying())
+                return;
 
-                if (itr->getSource()->IsAOEImmune())
-                    continue;
+            if (target->IsAOEImmune())
+                return;
 
-                switch (i_TargetType)
-                {
-                    case SPELL_TARGETS_ASSISTABLE:
-                        if (!i_originalCaster->CanAssistSpell(itr->getSource(), i_spell.m_spellInfo))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_ATTACKABLE:
-                    {
-                        if (!i_originalCaster->CanAttackSpell(itr->getSource(), i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK)))
-                            continue;
-                    }
+            if (!IsInArea(target))
+                return;
+
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_ASSISTABLE:
+                    if (!i_originalCaster->CanAssistSpell(target, i_spell.m_spellInfo))
+                        return;
                     break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
+                case SPELL_TARGETS_AOE_ATTACKABLE:
+                {
+                    if (!i_originalCaster->CanAttackSpell(target, i_spell.m_spellInfo, !i_spell.m_spellInfo->HasAttribute(SPELL_ATTR_EX5_IGNORE_AREA_EFFECT_PVP_CHECK)))
+                        return;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch (i_push_type)
+            i_data.push_back(target);
+        }
+
+        // geometric part of the checks, done before the faction checks as it rejects most of the visited units
+        inline bool IsInArea(Unit* target) const
+        {
+            switch (i_push_type)
+            {
+                case PUSH_CONE:
                 {
-                    case PUSH_CONE:
-                    {
-                        float heightDifference = std::abs(itr->getSource()->GetPositionZ() - i_centerZ);
-                        float maxHeight = i_radius / 2;
-                        float distance = std::min(sqrtf(itr->getSource()->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
-                        float ratio = distance / i_radius;
-                        float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
-                        if (!i_originalCaster->IsControlledByPlayer() && itr->getSource()->IsControlledByPlayer())
-                            conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
-                        if (i_cone >= 0.f)
-                        {
-                            if (i_castingObject->isInFront(itr->getSource(), i_radius, i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        else
-                        {
-                            if (i_castingObject->isInBack(itr->getSource(), i_radius, -i_cone) &&
-                                std::abs(itr->getSource()->GetPositionZ() - i_centerZ) - itr->getSource()->GetCombatReach() <= conalMaxHeight)
-                                i_data.push_back(itr->getSource());
-                        }
-                        break;
-                    }
-                    case PUSH_SELF_CENTER:
-                    case PUSH_SRC_CENTER:
-                    case PUSH_DEST_CENTER:
-                    case PUSH_TARGET_CENTER:
-                        float radius = i_radius;
-                        if (i_originalCaster->IsControlledByPlayer() && !itr->getSource()->IsControlledByPlayer())
-                            radius += itr->getSource()->GetCombatReach();
-                        if (itr->getSource()->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius)
-                            i_data.push_back(itr->getSource());
-                        break;
+                    float heightDifference = std::abs(target->GetPositionZ() - i_centerZ);
+                    float maxHeight = i_radius / 2;
+                    float distance = std::min(sqrtf(target->GetDistance2d(i_centerX, i_centerY, DIST_CALC_NONE)), i_radius);
+                    float ratio = distance / i_radius;
+                    float conalMaxHeight = maxHeight * ratio; // pvp combat uses true cone from roughly model
+                    if (!i_originalCaster->IsControlledByPlayer() && target->IsControlledByPlayer())
+                        conalMaxHeight = maxHeight; // npcs just do a conal max Z aoe
+                    if (i_cone >= 0.f)
+                        return i_castingObject->isInFront(target, i_radius, i_cone) &&
+                            std::abs(target->GetPositionZ() - i_centerZ) - target->GetCombatReach() <= conalMaxHeight;
+                    return i_castingObject->isInBack(target, i_radius, -i_cone) &&
+                        std::abs(target->GetPositionZ() - i_centerZ) - target->GetCombatReach() <= conalMaxHeight;
                 }
+                case PUSH_SELF_CENTER:
+                case PUSH_SRC_CENTER:
+                case PUSH_DEST_CENTER:
+                case PUSH_TARGET_CENTER:
+                    float radius = i_radius;
+                    if (i_originalCaster->IsControlledByPlayer() && !target->IsControlledByPlayer())
+                        radius += target->GetCombatReach();
+                    return target->GetDistance(i_centerX, i_centerY, i_centerZ, DIST_CALC_NONE) <= radius * radius;
             }
+            return false;
         }
 
 #ifdef _MSC_VER
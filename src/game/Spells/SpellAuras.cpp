@@ -429,7 +429,7 @@ Aura::~Aura()
 
 AreaAura::AreaAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target,
                    Unit* caster, Item* castItem, uint32 originalRankSpellId)
-    : Aura(spellproto, eff, currentDamage, currentBasePoints, holder, target, caster, castItem), m_originalRankSpellId(originalRankSpellId)
+    : Aura(spellproto, eff, currentDamage, currentBasePoints, holder, target, caster, castItem), m_originalRankSpellId(originalRankSpellId), m_updateTimer(0)
 {
     m_isAreaAura = true;
 
@@ -524,19 +524,28 @@ void Aura::Update(uint32 diff)
             // update before applying (aura can be removed in TriggerSpell or PeriodicTick calls)
             m_periodicTimer += m_modifier.periodictime;
             ++m_periodicTick;                               // for some infinity auras in some cases can overflow and reset
+            Unit* target = GetTarget();
             PeriodicTick();
+            target->InvalidateAuraModifierCache();          // ticks may change the amount in place
         }
     }
 }
 
 void AreaAura::Update(uint32 diff)
 {
+    // scans and checks below only run every AREA_AURA_UPDATE_INTERVAL, the first update does them
+    bool const checkTargets = m_updateTimer <= diff;
+    if (checkTargets)
+        m_updateTimer = AREA_AURA_UPDATE_INTERVAL;
+    else
+        m_updateTimer -= diff;
+
     // update for the caster of the aura
     if (GetCasterGuid() == GetTarget()->GetObjectGuid())
     {
         Unit* caster = GetTarget();
 
-        if (!caster->hasUnitState(UNIT_STAT_ISOLATED))
+        if (checkTargets && !caster->hasUnitState(UNIT_STAT_ISOLATED))
         {
             Unit* owner = caster->GetMaster();
             if (!owner)
@@ -735,6 +744,9 @@ void AreaAura::Update(uint32 diff)
 
         Aura::Update(diff);
 
+        if (!checkTargets)
+            return;
+
         // remove aura if out-of-range from caster (after teleport for example)
         // or caster is isolated or caster no longer has the aura
         // or caster is (no longer) friendly
@@ -835,6 +847,14 @@ void Aura::ApplyModifier(bool apply, bool Real)
 
     if (GetSpellProto()->HasAttribute(SPELL_ATTR_EX4_OWNER_POWER_SCALING) && m_removeMode != AURA_REMOVE_BY_GAINED_STACK)
         GetTarget()->RegisterScalingAura(this, apply);
+
+    GetTarget()->InvalidateAuraModifierCache();
+}
+
+void Aura::SetAmount(int32 amount)
+{
+    m_modifier.m_amount = amount;
+    GetTarget()->InvalidateAuraModifierCache();
 }
 
 void Aura::UpdateAuraScaling()
@@ -5328,6 +5348,7 @@ void Aura::HandleAuraModResistanceExclusive(bool apply, bool /*Real*/)
         return;
 
     Unit* target = GetTarget();
+    StatModifierBatch statBatch(*target);
 
     for (uint32 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
     {
@@ -5375,6 +5396,7 @@ void Aura::HandleAuraModResistance(bool apply, bool /*Real*/)
         return;
 
     Unit* target = GetTarget();
+    StatModifierBatch statBatch(*target);
 
     for (uint32 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
     {
@@ -5394,6 +5416,7 @@ void Aura::HandleModResistancePercent(bool apply, bool /*Real*/)
         return;
 
     Unit* target = GetTarget();
+    StatModifierBatch statBatch(*target);
 
     for (uint32 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
     {
@@ -5414,6 +5437,7 @@ void Aura::HandleModBaseResistance(bool apply, bool /*Real*/)
         return;
 
     Unit* target = GetTarget();
+    StatModifierBatch statBatch(*target);
 
     for (uint32 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
     {
@@ -5428,6 +5452,7 @@ void Aura::HandleAuraModBaseResistancePercent(bool apply, bool /*Real*/)
         return;
 
     Unit* target = GetTarget();
+    StatModifierBatch statBatch(*target);
 
     for (uint32 i = SPELL_SCHOOL_NORMAL; i < MAX_SPELL_SCHOOL; ++i)
     {
@@ -5477,6 +5502,8 @@ void Aura::HandleAuraModStat(bool apply, bool /*Real*/)
             target->RemoveAurasTriggeredBySpell(GetId(), GetCasterGuid()); // just do it every time, lookup is too time consuming
     }
 
+    StatModifierBatch statBatch(*target);
+
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         // -1 or -2 is all stats ( misc < -2 checked in function beginning )
@@ -5503,6 +5530,8 @@ void Aura::HandleModPercentStat(bool apply, bool /*Real*/)
     if (GetTarget()->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    StatModifierBatch statBatch(*GetTarget());
+
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (m_modifier.m_miscvalue == i || m_modifier.m_miscvalue == -1)
@@ -5579,13 +5608,17 @@ void Aura::HandleModTotalPercentStat(bool apply, bool /*Real*/)
     uint32 curHPValue = target->GetHealth();
     uint32 maxHPValue = target->GetMaxHealth();
 
-    for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
-        if (m_modifier.m_miscvalue == i || m_modifier.m_miscvalue == -1)
+        StatModifierBatch statBatch(*target);
+
+        for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
         {
-            target->HandleStatModifier(UnitMods(UNIT_MOD_STAT_START + i), TOTAL_PCT, float(m_modifier.m_amount), apply);
-            if (target->GetTypeId() == TYPEID_PLAYER || ((Creature*)target)->IsPet())
-                target->ApplyStatPercentBuffMod(Stats(i), float(m_modifier.m_amount), apply);
+            if (m_modifier.m_miscvalue == i || m_modifier.m_miscvalue == -1)
+            {
+                target->HandleStatModifier(UnitMods(UNIT_MOD_STAT_START + i), TOTAL_PCT, float(m_modifier.m_amount), apply);
+                if (target->GetTypeId() == TYPEID_PLAYER || ((Creature*)target)->IsPet())
+                    target->ApplyStatPercentBuffMod(Stats(i), float(m_modifier.m_amount), apply);
+            }
         }
     }
 
@@ -7827,6 +7860,9 @@ SpellAuraHolder::SpellAuraHolder(SpellEntry const* spellproto, Unit* target, Wor
     m_trackedAuraType = sSpellMgr.IsSingleTargetSpell(spellproto) ? TRACK_AURA_TYPE_SINGLE_TARGET : TRACK_AURA_TYPE_NOT_TRACKED;
     m_procCharges    = spellproto->procCharges;
 
+    SpellProcEventEntry const* spellProcEvent = sSpellMgr.GetSpellProcEvent(spellproto->Id);
+    m_procFlags = spellProcEvent && spellProcEvent->procFlags ? spellProcEvent->procFlags : spellproto->procFlags;
+
     m_isRemovedOnShapeLost = IsRemovedOnShapeshiftLost(m_spellProto, GetCasterGuid(), target->GetObjectGuid());
 
     Unit* unitCaster = caster && caster->isType(TYPEMASK_UNIT) ? (Unit*)caster : nullptr;
@@ -22,6 +22,7 @@
 #include "Server/DBCEnums.h"
 #include "Entities/ObjectGuid.h"
 #include "Spells/Scripts/SpellScript.h"
+#include "Utilities/ObjectPool.h"
 
 /**
  * Used to modify what an Aura does to a player/npc.
@@ -90,7 +91,7 @@ enum SpellAuraHolderState
     SPELLAURAHOLDER_STATE_DB_LOAD       = 3                 // during db load some events must not be executed
 };
 
-class SpellAuraHolder
+class SpellAuraHolder : public MaNGOS::PooledObject<SpellAuraHolder>
 {
     public:
         SpellAuraHolder(SpellEntry const* spellproto, Unit* target, WorldObject* caster, Item* castItem, SpellEntry const* triggeredBy);
@@ -164,6 +165,7 @@ class SpellAuraHolder
         uint8 GetAuraLevel() const { return m_auraLevel; }
         void SetAuraLevel(uint8 level) { m_auraLevel = level; }
         uint32 GetAuraCharges() const { return m_procCharges; }
+        uint32 GetProcFlags() const { return m_procFlags; }  // spell_proc_event flags if set, else the spell ones
         void SetAuraCharges(uint32 charges, bool update = true);
 
         // SpellMods
@@ -229,6 +231,7 @@ class SpellAuraHolder
         uint8 m_auraSlot;                                   // Aura slot on unit (for show in client)
         uint8 m_auraLevel;                                  // Aura level (store caster level for correct show level dep amount)
         uint32 m_procCharges;                               // Aura charges (0 for infinite)
+        uint32 m_procFlags;                                 // flags the holder can proc from, resolved once at creation
         uint32 m_stackAmount;                               // Aura stack amount
         int32 m_maxDuration;                                // Max aura duration
         int32 m_duration;                                   // Current time
@@ -269,7 +272,7 @@ typedef void(Aura::*pAuraHandler)(bool Apply, bool Real);
 //      each setting object update field code line moved under if(Real) check is significant mangos speedup, and less server->client data sends
 //      each packet sending code moved under if(Real) check is _large_ mangos speedup, and lot less server->client data sends
 
-class Aura
+class Aura : public MaNGOS::PooledObject<Aura>
 {
         friend struct ReapplyAffectedPassiveAurasHelper;
         friend Aura* CreateAura(SpellEntry const* spellproto, SpellEffectIndex eff, int32 const* currentDamage, int32 const* currentBasePoints, SpellAuraHolder* holder, Unit* target, Unit* caster, Item* castItem, uint64 scriptValue);
@@ -451,7 +454,7 @@ class Aura
         SpellEffectIndex GetEffIndex() const { return m_effIndex; }
         int32 GetBasePoints() const { return m_currentBasePoints; }
         int32 GetAmount() const { return m_modifier.m_amount; }
-        void SetAmount(int32 amount) { m_modifier.m_amount = amount; }
+        void SetAmount(int32 amount);
 
         int32 GetAuraMaxDuration() const { return GetHolder()->GetAuraMaxDuration(); }
         int32 GetAuraDuration() const { return GetHolder()->GetAuraDuration(); }
@@ -584,6 +587,8 @@ class Aura
         void ReapplyAffectedPassiveAuras(Unit* target, bool owner_mode);
 };
 
+#define AREA_AURA_UPDATE_INTERVAL 500                       // ms between target scans of the caster and range checks of the targets
+
 class AreaAura : public Aura
 {
     public:
@@ -595,6 +600,7 @@ class AreaAura : public Aura
         float m_radius;
         AreaAuraType m_areaAuraType;
         uint32       m_originalRankSpellId;
+        uint32       m_updateTimer;
 };
 
 class PersistentAreaAura : public Aura
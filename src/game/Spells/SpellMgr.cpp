@@ -27,6 +27,9 @@
 #include "Entities/Unit.h"
 #include "World/World.h"
 
+#include <atomic>
+#include <thread>
+
 bool IsPrimaryProfessionSkill(uint32 skill)
 {
     SkillLineEntry const* pSkill = sSkillLineStore.LookupEntry(skill);
@@ -2348,10 +2351,57 @@ bool SpellMgr::IsSpellValid(SpellEntry const* spellInfo, Player* pl, bool msg)
     return true;
 }
 
+void SpellMgr::LoadSpellMetadata()
+{
+    uint32 maxEntry = sSpellTemplate.GetMaxEntry();
+    std::vector<uint8> metadata(maxEntry, 0);
+    // filled into a local table, the helpers below must not see half computed entries of the live one
+    m_spellMetadata.clear();
+
+    std::atomic<uint32> nextSpell(1);
+    auto worker = [&]()
+    {
+        const uint32 batch = 256;
+        for (uint32 first = nextSpell.fetch_add(batch); first < maxEntry; first = nextSpell.fetch_add(batch))
+        {
+            for (uint32 spellId = first; spellId < std::min(first + batch, maxEntry); ++spellId)
+            {
+                SpellEntry const* spellInfo = sSpellTemplate.LookupEntry<SpellEntry>(spellId);
+                if (!spellInfo)
+                    continue;
+
+                uint8 flags = SPELL_METADATA_COMPUTED;
+                if (IsPositiveSpell(spellInfo))
+                    flags |= SPELL_METADATA_POSITIVE;
+                for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
+                    if (IsPositiveEffect(spellInfo, SpellEffectIndex(i)))
+                        flags |= SPELL_METADATA_POSITIVE_EFFECT_0 << i;
+                if (IsAreaOfEffectSpell(spellInfo))
+                    flags |= SPELL_METADATA_AREA_OF_EFFECT;
+                metadata[spellId] = flags;
+            }
+        }
+    };
+
+    uint32 threadCount = std::max(1u, std::min(std::thread::hardware_concurrency(), 8u));
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threadCount; ++i)
+        workers.emplace_back(worker);
+    worker();
+    for (std::thread& thread : workers)
+        thread.join();
+
+    m_spellMetadata = std::move(metadata);
+
+    sLog.outString(">> Precomputed metadata of %u spells with %u threads", sSpellTemplate.GetRecordCount(), threadCount);
+    sLog.outString();
+}
+
 void SpellMgr::LoadSpellAreas()
 {
     mSpellAreaMap.clear();                                  // need for reload case
     mSpellAreaForAuraMap.clear();
+    mSpellAreaForArea.clear();
 
     uint32 count = 0;
 
@@ -2546,7 +2596,14 @@ void SpellMgr::LoadSpellAreas()
 
         // for search by current zone/subzone at zone/subzone change
         if (spellArea.areaId)
-            mSpellAreaForAreaMap.insert(SpellAreaForAreaMap::value_type(spellArea.areaId, sa));
+        {
+            if (spellArea.areaId >= mSpellAreaForArea.size())
+                mSpellAreaForArea.resize(spellArea.areaId + 1);
+
+            mSpellAreaForArea[spellArea.areaId].all.push_back(sa);
+            if (spellArea.autocast)
+                mSpellAreaForArea[spellArea.areaId].autocast.push_back(sa);
+        }
 
         // for search at aura apply
         if (spellArea.auraSpell)
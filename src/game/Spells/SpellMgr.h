@@ -44,6 +44,17 @@ class Spell;
 class Unit;
 struct SpellModifier;
 
+// per spell bits precomputed at startup by SpellMgr::LoadSpellMetadata, zero while not computed
+enum SpellMetadataFlags
+{
+    SPELL_METADATA_COMPUTED         = 0x01,
+    SPELL_METADATA_POSITIVE         = 0x02,                 // IsPositiveSpell without caster and target
+    SPELL_METADATA_POSITIVE_EFFECT_0 = 0x04,                // IsPositiveEffect without caster and target, one bit per effect
+    SPELL_METADATA_AREA_OF_EFFECT   = 0x20,
+};
+
+inline uint32 GetSpellMetadataFlags(uint32 spellId);
+
 // only used in code
 enum SpellCategories
 {
@@ -1088,6 +1099,9 @@ inline bool IsAreaEffectTarget(SpellTarget target)
 
 inline bool IsAreaOfEffectSpell(SpellEntry const* spellInfo)
 {
+    if (uint32 metadata = GetSpellMetadataFlags(spellInfo->Id))
+        return (metadata & SPELL_METADATA_AREA_OF_EFFECT) != 0;
+
     if (IsAreaEffectTarget(SpellTarget(spellInfo->EffectImplicitTargetA[EFFECT_INDEX_0])) || IsAreaEffectTarget(SpellTarget(spellInfo->EffectImplicitTargetB[EFFECT_INDEX_0])))
         return true;
     if (IsAreaEffectTarget(SpellTarget(spellInfo->EffectImplicitTargetA[EFFECT_INDEX_1])) || IsAreaEffectTarget(SpellTarget(spellInfo->EffectImplicitTargetB[EFFECT_INDEX_1])))
@@ -1373,6 +1387,10 @@ inline bool IsPositiveEffectTargetMode(const SpellEntry* entry, SpellEffectIndex
 
 inline bool IsPositiveEffect(const SpellEntry* spellproto, SpellEffectIndex effIndex, const WorldObject* caster = nullptr, const WorldObject* target = nullptr)
 {
+    if (!caster && !target)
+        if (uint32 metadata = GetSpellMetadataFlags(spellproto->Id))
+            return (metadata & (SPELL_METADATA_POSITIVE_EFFECT_0 << effIndex)) != 0;
+
     if (!spellproto)
         return false;
 
@@ -1585,6 +1603,9 @@ inline bool IsPositiveSpell(const SpellEntry* entry, const WorldObject* caster =
 {
     if (!entry)
         return false;
+    if (!caster && !target)
+        if (uint32 metadata = GetSpellMetadataFlags(entry->Id))
+            return (metadata & SPELL_METADATA_POSITIVE) != 0;
     // spells with at least one negative effect are considered negative
     // some self-applied spells have negative effects but in self casting case negative check ignored.
     for (int i = 0; i < MAX_EFFECT_INDEX; ++i)
@@ -2613,6 +2634,14 @@ typedef std::multimap<uint32 /*areaOrZoneId*/, SpellArea const*> SpellAreaForAre
 typedef std::pair<SpellAreaMap::const_iterator, SpellAreaMap::const_iterator> SpellAreaMapBounds;
 typedef std::pair<SpellAreaForAuraMap::const_iterator, SpellAreaForAuraMap::const_iterator>  SpellAreaForAuraMapBounds;
 typedef std::pair<SpellAreaForAreaMap::const_iterator, SpellAreaForAreaMap::const_iterator>  SpellAreaForAreaMapBounds;
+typedef std::vector<SpellArea const*> SpellAreaList;
+
+// spell_area entries of one zone or subzone
+struct SpellAreaForArea
+{
+    SpellAreaList all;
+    SpellAreaList autocast;                                 // the only ones doing anything when auras are only applied (area enter, quest accept)
+};
 
 
 // Spell rank chain  (accessed using SpellMgr functions)
@@ -3222,9 +3251,13 @@ class SpellMgr
             return mSpellAreaForAuraMap.equal_range(spell_id);
         }
 
-        SpellAreaForAreaMapBounds GetSpellAreaForAreaMapBounds(uint32 area_id) const
+        // entries limited to zone/subzone area_id, onlyApply - for ApplyOrRemoveSpellIfCan called with onlyApply
+        SpellAreaList const& GetSpellAreasForArea(uint32 area_id, bool onlyApply) const
         {
-            return mSpellAreaForAreaMap.equal_range(area_id);
+            static SpellAreaList const empty;
+            if (area_id >= mSpellAreaForArea.size())
+                return empty;
+            return onlyApply ? mSpellAreaForArea[area_id].autocast : mSpellAreaForArea[area_id].all;
         }
 
         // Modifiers
@@ -3249,6 +3282,9 @@ class SpellMgr
         void LoadSkillRaceClassInfoMap();
         void LoadSpellPetAuras();
         void LoadSpellAreas();
+        void LoadSpellMetadata();
+
+        uint32 GetSpellMetadata(uint32 spellId) const { return spellId < m_spellMetadata.size() ? m_spellMetadata[spellId] : 0; }
 
     private:
         SpellChainMap      mSpellChains;
@@ -3268,8 +3304,14 @@ class SpellMgr
         SpellPetAuraMap     mSpellPetAuraMap;
         SpellAreaMap         mSpellAreaMap;
         SpellAreaForAuraMap  mSpellAreaForAuraMap;
-        SpellAreaForAreaMap  mSpellAreaForAreaMap;
+        std::vector<SpellAreaForArea> mSpellAreaForArea;    // by zone/subzone id
+        std::vector<uint8>   m_spellMetadata;
 };
 
 #define sSpellMgr SpellMgr::Instance()
+
+inline uint32 GetSpellMetadataFlags(uint32 spellId)
+{
+    return sSpellMgr.GetSpellMetadata(spellId);
+}
 #endif
@@ -493,6 +493,10 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
 {
     ProcExecutionData execData(argData, isVictim);
 
+    // no holder can proc from this hit, IsTriggeredAtSpellProcEvent would fail all of them on the flags
+    if (!(execData.procFlags & m_auraProcFlags))
+        return;
+
     ProcTriggeredList procTriggered;
     std::vector<SpellAuraHolder*> holdersForDeletion;
     // Fill procTriggered list
@@ -503,6 +507,9 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
         if (holder->GetState() != SPELLAURAHOLDER_STATE_READY || holder->IsDeleted())
             continue;
 
+        if (!(execData.procFlags & holder->GetProcFlags()))
+            continue;
+
         SpellProcEventEntry const* spellProcEvent = nullptr;
         SpellProcEventTriggerCheck result = IsTriggeredAtSpellProcEvent(execData, holder, spellProcEvent);
         if (holder->GetSpellProto()->HasAttribute(SPELL_ATTR_PROC_FAILURE_BURNS_CHARGE) &&
@@ -589,6 +596,7 @@ void Unit::ProcDamageAndSpellFor(ProcSystemArguments& argData, bool isVictim)
             SpellAuraProcResult procResult = execData.triggeredByAura->OnProc(execData);
             if (procResult == SPELL_AURA_PROC_OK)
                 procResult = (*this.*AuraProcHandler[auraModifier->m_auraname])(execData);
+            InvalidateAuraModifierCache();                  // proc handlers may change the amount in place
             switch (procResult)
             {
                 case SPELL_AURA_PROC_CANT_TRIGGER:
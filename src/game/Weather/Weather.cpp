@@ -37,27 +37,22 @@ Weather::Weather(uint32 zone, WeatherZoneChances const* weatherChances) :
     m_weatherChances(weatherChances),
     m_isPermanentWeather(false)
 {
-    m_timer.SetInterval(sWorld.getConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER));
-    DETAIL_FILTER_LOG(LOG_FILTER_WEATHER, "WORLD: Starting weather system for zone %u (change every %u minutes).", m_zone, (m_timer.GetInterval() / (MINUTE * IN_MILLISECONDS)));
+    DETAIL_FILTER_LOG(LOG_FILTER_WEATHER, "WORLD: Starting weather system for zone %u (change every %u minutes).", m_zone, (sWorld.getConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER) / (MINUTE * IN_MILLISECONDS)));
 }
 
 /// Launch a weather update
-bool Weather::Update(uint32 diff, Map const* _map)
+bool Weather::Update(Map const* _map)
 {
-    m_timer.Update(diff);
+    if (m_isPermanentWeather)
+        return true;
 
-    ///- If the timer has passed, ReGenerate the weather
-    if (m_timer.Passed())
-    {
-        m_timer.Reset();
-        // update only if Regenerate has changed the weather
-        if (ReGenerate())
-        {
-            ///- Weather will be removed if not updated (no players in zone anymore)
-            if (!SendWeatherForPlayersInZone(_map))
-                return false;
-        }
-    }
+    ///- Weather is removed when no player is in the zone anymore, the first player entering it again starts a new one
+    if (!_map->HasPlayersInZone(m_zone))
+        return false;
+
+    // update only if Regenerate has changed the weather
+    if (ReGenerate())
+        SendWeatherForPlayersInZone(_map);
     return true;
 }
 
@@ -336,7 +331,7 @@ void Weather::LogWeatherState(WeatherState state) const
 //                  Weather System
 // ---------------------------------------------------------
 
-WeatherSystem::WeatherSystem(Map const* _map) : m_map(_map)
+WeatherSystem::WeatherSystem(Map const* _map) : m_map(_map), m_time(0)
 {}
 
 WeatherSystem::~WeatherSystem()
@@ -358,24 +353,39 @@ Weather* WeatherSystem::FindOrCreateWeather(uint32 zoneId)
     // Create
     Weather* w = new Weather(zoneId, sWeatherMgr.GetWeatherChances(zoneId));
     m_weathers[zoneId] = w;
+    ScheduleChange(zoneId);
     return w;
 }
 
+void WeatherSystem::ScheduleChange(uint32 zoneId)
+{
+    m_changes.push(ScheduledChange(m_time + sWorld.getConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER), zoneId));
+}
+
 /// Update Weathers for the different zones
 void WeatherSystem::UpdateWeathers(uint32 diff)
 {
-    ///- Send an update signal to Weather objects
-    for (WeatherMap::iterator itr = m_weathers.begin(); itr != m_weathers.end();)
+    m_time += diff;
+
+    ///- Only the weathers due for a change are updated
+    while (!m_changes.empty() && m_changes.top().first <= m_time)
     {
-        ///- and remove Weather objects for zones with no player
-        // As interval > WorldTick
-        if (!itr->second->Update(diff, m_map))
+        uint32 zoneId = m_changes.top().second;
+        m_changes.pop();
+
+        WeatherMap::iterator itr = m_weathers.find(zoneId);
+        if (itr == m_weathers.end())
+            continue;
+
+        ///- and Weather objects for zones with no player are removed
+        if (!itr->second->Update(m_map))
         {
             delete itr->second;
-            m_weathers.erase(itr++);
+            m_weathers.erase(itr);
+            continue;
         }
-        else
-            ++itr;
+
+        ScheduleChange(zoneId);
     }
 }
 
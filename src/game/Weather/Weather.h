@@ -27,6 +27,8 @@
 #include "Globals/SharedDefines.h"
 #include "Timer.h"
 
+#include <queue>
+
 class Player;
 class Map;
 
@@ -63,8 +65,8 @@ class Weather
         void SendWeatherUpdateToPlayer(Player* player);
         /// Set the weather
         void SetWeather(WeatherType type, float grade, Map const* _map, bool isPermanent);
-        /// Update the weather in this zone, when the timer is expired the weather will be rolled again
-        bool Update(uint32 diff, Map const* _map);
+        /// Roll the weather of this zone again, false when it can be removed because no player is left in the zone
+        bool Update(Map const* _map);
         /// Check if a type is valid
         static bool IsValidWeatherType(uint32 type)
         {
@@ -97,7 +99,6 @@ class Weather
         uint32 m_zone;
         WeatherType m_type;
         float m_grade;
-        ShortIntervalTimer m_timer;
         WeatherZoneChances const* m_weatherChances;
         bool m_isPermanentWeather;
 };
@@ -117,10 +118,17 @@ class WeatherSystem
         void UpdateWeathers(uint32 diff);
 
     private:
+        void ScheduleChange(uint32 zoneId);
+
         Map const* const m_map;
 
         typedef std::unordered_map<uint32 /*zoneId*/, Weather*> WeatherMap;
         WeatherMap m_weathers;
+
+        // next weather change of the zones, earliest first
+        typedef std::pair<uint64 /*time*/, uint32 /*zoneId*/> ScheduledChange;
+        std::priority_queue<ScheduledChange, std::vector<ScheduledChange>, std::greater<ScheduledChange>> m_changes;
+        uint64 m_time;                                      // ms summed up by UpdateWeathers
 };
 
 // ---------------------------------------------------------
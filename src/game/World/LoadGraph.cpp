@@ -0,0 +1,174 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/LoadGraph.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <thread>
+
+void LoadGraph::AddStep(char const* name, LoadFunc func, std::initializer_list<char const*> dependsOn /*= {}*/)
+{
+    Step step;
+    step.name = name;
+    step.func = std::move(func);
+    step.pending = 0;
+    step.startTime = 0;
+    step.endTime = 0;
+
+    uint32 index = m_steps.size();
+    for (char const* depName : dependsOn)
+    {
+        auto itr = std::find_if(m_steps.begin(), m_steps.end(), [depName](Step const& s) { return s.name == depName; });
+        MANGOS_ASSERT(itr != m_steps.end() && "load step depends on unknown step");
+        itr->dependents.push_back(index);
+        step.dependsOn.push_back(uint32(itr - m_steps.begin()));
+        ++step.pending;
+    }
+
+    m_steps.push_back(std::move(step));
+}
+
+void LoadGraph::RunStep(uint32 index, uint32 runStart)
+{
+    Step& step = m_steps[index];
+    step.startTime = WorldTimer::getMSTimeDiff(runStart, WorldTimer::getMSTime());
+    step.func();
+    step.endTime = WorldTimer::getMSTimeDiff(runStart, WorldTimer::getMSTime());
+}
+
+void LoadGraph::Run(uint32 threads)
+{
+    uint32 runStart = WorldTimer::getMSTime();
+
+    if (threads <= 1)
+    {
+        for (uint32 i = 0; i < m_steps.size(); ++i)
+            RunStep(i, runStart);
+    }
+    else
+    {
+        // interleaved progress bars of parallel steps are unreadable
+        bool showBars = BarGoLink::GetOutputState();
+        BarGoLink::SetOutputState(false);
+
+        m_remaining = m_steps.size();
+        for (uint32 i = 0; i < m_steps.size(); ++i)
+            if (!m_steps[i].pending)
+                m_ready.push_back(i);
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 0; i < threads; ++i)
+            workers.emplace_back(&LoadGraph::WorkerThread, this, runStart);
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        BarGoLink::SetOutputState(showBars);
+    }
+
+    ReportTimings(WorldTimer::getMSTimeDiff(runStart, WorldTimer::getMSTime()));
+    m_steps.clear();
+}
+
+void LoadGraph::WorkerThread(uint32 runStart)
+{
+    WorldDatabase.ThreadStart();                            // let thread do safe mySQL requests (one connection call enough)
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (m_remaining)
+    {
+        if (m_ready.empty())
+        {
+            m_cond.wait(guard);
+            continue;
+        }
+
+        uint32 index = m_ready.front();
+        m_ready.pop_front();
+
+        guard.unlock();
+        RunStep(index, runStart);
+        guard.lock();
+
+        --m_remaining;
+        for (uint32 dependent : m_steps[index].dependents)
+            if (!--m_steps[dependent].pending)
+                m_ready.push_back(dependent);
+
+        m_cond.notify_all();
+    }
+
+    guard.unlock();
+    WorldDatabase.ThreadEnd();
+}
+
+void LoadGraph::ReportTimings(uint32 wallTime) const
+{
+    if (m_steps.empty())
+        return;
+
+    // longest chain of dependent steps ending at each step, the overall longest one bounds the wall time
+    std::vector<uint32> pathTime(m_steps.size());
+    std::vector<int32> pathPrev(m_steps.size(), -1);
+    uint32 last = 0;
+    for (uint32 i = 0; i < m_steps.size(); ++i)
+    {
+        Step const& step = m_steps[i];
+        uint32 before = 0;
+        for (uint32 dep : step.dependsOn)
+        {
+            if (pathTime[dep] > before)
+            {
+                before = pathTime[dep];
+                pathPrev[i] = dep;
+            }
+        }
+        pathTime[i] = before + (step.endTime - step.startTime);
+        if (pathTime[i] > pathTime[last])
+            last = i;
+    }
+
+    std::vector<uint32> order(m_steps.size());
+    for (uint32 i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [this](uint32 a, uint32 b)
+    {
+        return m_steps[a].endTime - m_steps[a].startTime > m_steps[b].endTime - m_steps[b].startTime;
+    });
+
+    uint32 totalTime = 0;
+    for (Step const& step : m_steps)
+        totalTime += step.endTime - step.startTime;
+
+    sLog.outString(">> Load steps: " SIZEFMTD " steps, %u ms wall time, %u ms summed step time", m_steps.size(), wallTime, totalTime);
+    for (uint32 index : order)
+    {
+        Step const& step = m_steps[index];
+        sLog.outString("   %-32s %6u ms (started at %u ms)", step.name.c_str(), step.endTime - step.startTime, step.startTime);
+    }
+
+    std::string path;
+    for (int32 i = last; i >= 0; i = pathPrev[i])
+        path = m_steps[i].name + (path.empty() ? "" : " -> ") + path;
+    sLog.outString(">> Critical path %u ms: %s", pathTime[last], path.c_str());
+    sLog.outString();
+}
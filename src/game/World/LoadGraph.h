@@ -0,0 +1,67 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_LOADGRAPH_H
+#define MANGOS_LOADGRAPH_H
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+
+// Runs startup load steps on several threads, a step starts once all steps it depends on have finished.
+// Steps without a dependency between them must not touch the same data.
+class LoadGraph
+{
+    public:
+        typedef std::function<void()> LoadFunc;
+
+        // dependencies are given by name and must be added before the step depending on them
+        void AddStep(char const* name, LoadFunc func, std::initializer_list<char const*> dependsOn = {});
+
+        // threads <= 1 runs the steps one after another in the order they were added
+        void Run(uint32 threads);
+
+    private:
+        struct Step
+        {
+            std::string name;
+            LoadFunc func;
+            std::vector<uint32> dependsOn;
+            std::vector<uint32> dependents;
+            uint32 pending;                                 // dependencies not finished yet
+            uint32 startTime;                               // ms since Run start
+            uint32 endTime;
+        };
+
+        void RunStep(uint32 index, uint32 runStart);
+        void WorkerThread(uint32 runStart);
+        void ReportTimings(uint32 wallTime) const;
+
+        std::vector<Step> m_steps;
+
+        std::mutex m_lock;
+        std::condition_variable m_cond;
+        std::deque<uint32> m_ready;
+        uint32 m_remaining = 0;
+};
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/TickWatchdog.h"
+#include "AI/ScriptDevAI/ScriptDevAIMgr.h"
+#include "Server/Opcodes.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+
+#define WATCHDOG_REPORT_STACKS 3                            // most sampled stacks reported per thread
+
+std::atomic<bool> TickWatchdog::s_running(false);
+
+TickWatchdog& TickWatchdog::Instance()
+{
+    static TickWatchdog instance;
+    return instance;
+}
+
+void TickWatchdog::Start(uint32 thresholdMs)
+{
+    if (!thresholdMs || m_thread.joinable())
+        return;
+
+    sLog.outString("Starting up tick watchdog thread (reports world ticks over %u ms)...", thresholdMs);
+    m_thresholdMs = thresholdMs;
+    m_stop = false;
+    s_running = true;
+    m_thread = std::thread(&TickWatchdog::Run, this);
+}
+
+void TickWatchdog::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    m_stop = true;
+    m_thread.join();
+    s_running = false;
+}
+
+void TickWatchdog::BeginTick()
+{
+    m_tickStart.store(WorldTimer::getMSTime(), std::memory_order_relaxed);
+    m_tickId.fetch_add(1, std::memory_order_relaxed);
+    m_inTick.store(true, std::memory_order_release);
+}
+
+void TickWatchdog::EndTick()
+{
+    m_inTick.store(false, std::memory_order_release);
+    m_lastTickMs.store(WorldTimer::getMSTimeDiff(m_tickStart.load(std::memory_order_relaxed), WorldTimer::getMSTime()), std::memory_order_relaxed);
+    m_lastTickId.store(m_tickId.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+TickWatchdog::ThreadRegistration::ThreadRegistration() : frames(new ThreadFrames())
+{
+    TickWatchdog& watchdog = Instance();
+    std::lock_guard<std::mutex> guard(watchdog.m_threadsLock);
+    frames->name = "thread " + std::to_string(++watchdog.m_threadCounter);
+    watchdog.m_threads.push_back(frames.get());
+}
+
+TickWatchdog::ThreadRegistration::~ThreadRegistration()
+{
+    TickWatchdog& watchdog = Instance();
+    std::lock_guard<std::mutex> guard(watchdog.m_threadsLock);
+    watchdog.m_threads.erase(std::remove(watchdog.m_threads.begin(), watchdog.m_threads.end(), frames.get()), watchdog.m_threads.end());
+}
+
+TickWatchdog::ThreadFrames& TickWatchdog::GetThreadFrames()
+{
+    static thread_local ThreadRegistration registration;
+    return *registration.frames;
+}
+
+void TickWatchdog::SetThreadName(std::string const& name)
+{
+    ThreadFrames& frames = GetThreadFrames();
+    std::lock_guard<std::mutex> guard(Instance().m_threadsLock);
+    frames.name = name;
+}
+
+bool TickWatchdog::PushFrame(WatchdogFrameType type, char const* label, uint32 id, uint32 subId)
+{
+    if (!s_running.load(std::memory_order_relaxed))
+        return false;
+
+    ThreadFrames& frames = GetThreadFrames();
+    uint32 depth = frames.depth.load(std::memory_order_relaxed);
+    if (depth < MAX_FRAMES)
+    {
+        Frame& frame = frames.frames[depth];
+        frame.type.store(type, std::memory_order_relaxed);
+        frame.label.store(label, std::memory_order_relaxed);
+        frame.id.store(id, std::memory_order_relaxed);
+        frame.subId.store(subId, std::memory_order_relaxed);
+    }
+    // published after the frame content, a sample never reads a frame not yet written
+    frames.depth.store(depth + 1, std::memory_order_release);
+    return true;
+}
+
+void TickWatchdog::PopFrame()
+{
+    ThreadFrames& frames = GetThreadFrames();
+    frames.depth.store(frames.depth.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+}
+
+std::string TickWatchdog::DescribeFrame(uint32 type, char const* label, uint32 id, uint32 subId)
+{
+    switch (type)
+    {
+        case WATCHDOG_FRAME_MAP:
+            return "map " + std::to_string(id) + " instance " + std::to_string(subId);
+        case WATCHDOG_FRAME_SCRIPT:
+            if (!id)                                        // not a ScriptDevAI script
+                return label ? label : "";
+            return std::string("script ") + sScriptDevAIMgr.GetScriptName(id) + " " + (label ? label : "");
+        case WATCHDOG_FRAME_OPCODE:
+            return std::string("handler ") + LookupOpcodeName(uint16(id));
+        default:
+            return label ? label : "";
+    }
+}
+
+void TickWatchdog::Run()
+{
+    // several samples for a tick just over the threshold, but not a busy loop for large thresholds
+    uint32 const pollMs = std::min(std::max(m_thresholdMs / 10, 5u), 100u);
+
+    SampleMap samples;
+    uint32 sampledTick = 0;
+    uint32 sampleCount = 0;
+    uint32 sampledMs = 0;
+
+    while (!m_stop)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+
+        bool inTick = m_inTick.load(std::memory_order_acquire);
+        uint32 tickId = m_tickId.load(std::memory_order_relaxed);
+
+        // the sampled tick has ended, report it with its real duration when known
+        if (sampleCount && (!inTick || tickId != sampledTick))
+        {
+            uint32 elapsedMs = m_lastTickId.load(std::memory_order_acquire) == sampledTick ? m_lastTickMs.load(std::memory_order_relaxed) : sampledMs;
+            WriteReport(sampledTick, elapsedMs, sampleCount, samples);
+            samples.clear();
+            sampleCount = 0;
+        }
+
+        if (!inTick)
+            continue;
+
+        uint32 elapsedMs = WorldTimer::getMSTimeDiff(m_tickStart.load(std::memory_order_relaxed), WorldTimer::getMSTime());
+        if (elapsedMs < m_thresholdMs)
+            continue;
+
+        Sample(samples);
+        sampledTick = tickId;
+        sampledMs = elapsedMs;
+        ++sampleCount;
+    }
+}
+
+void TickWatchdog::Sample(SampleMap& samples)
+{
+    std::lock_guard<std::mutex> guard(m_threadsLock);
+    for (ThreadFrames* frames : m_threads)
+    {
+        uint32 depth = std::min(frames->depth.load(std::memory_order_acquire), MAX_FRAMES);
+        if (!depth)
+            continue;                                       // idle
+
+        // the thread goes on meanwhile, a sample may mix frames of two neighbouring stacks
+        std::string stack;
+        for (uint32 i = 0; i < depth; ++i)
+        {
+            Frame const& frame = frames->frames[i];
+            if (i)
+                stack += " > ";
+            stack += DescribeFrame(frame.type.load(std::memory_order_relaxed), frame.label.load(std::memory_order_relaxed),
+                                   frame.id.load(std::memory_order_relaxed), frame.subId.load(std::memory_order_relaxed));
+        }
+        ++samples[frames->name][stack];
+    }
+}
+
+void TickWatchdog::WriteReport(uint32 tickId, uint32 elapsedMs, uint32 sampleCount, SampleMap const& samples) const
+{
+    sLog.outError("TickWatchdog: world tick %u took %u ms (threshold %u ms), %u samples taken after the threshold", tickId, elapsedMs, m_thresholdMs, sampleCount);
+    for (auto const& thread : samples)
+    {
+        std::vector<std::pair<std::string, uint32>> stacks(thread.second.begin(), thread.second.end());
+        std::sort(stacks.begin(), stacks.end(), [](std::pair<std::string, uint32> const& a, std::pair<std::string, uint32> const& b) { return a.second > b.second; });
+        if (stacks.size() > WATCHDOG_REPORT_STACKS)
+            stacks.resize(WATCHDOG_REPORT_STACKS);
+
+        for (auto const& stack : stacks)
+            sLog.outError("TickWatchdog:   %s %u/%u: %s", thread.first.c_str(), stack.second, sampleCount, stack.first.c_str());
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TICKWATCHDOG_H
+#define MANGOS_TICKWATCHDOG_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+enum WatchdogFrameType
+{
+    WATCHDOG_FRAME_PHASE,                                   // label only
+    WATCHDOG_FRAME_MAP,                                     // id - map id, subId - instance id
+    WATCHDOG_FRAME_SCRIPT,                                  // label - hook, id - script id
+    WATCHDOG_FRAME_OPCODE,                                  // id - opcode
+};
+
+// Watches the world tick and samples what the world and map threads are doing while a tick runs over
+// Watchdog.SlowTickThreshold. Threads describe their work with a stack of WatchdogFrame scopes, the watchdog
+// thread reads these stacks and logs the most sampled ones per thread when the slow tick has ended.
+class TickWatchdog
+{
+    public:
+        static const uint32 MAX_FRAMES = 16;                // deeper frames are not recorded
+
+        static TickWatchdog& Instance();
+
+        // starts the watchdog thread, nothing for a threshold of 0
+        void Start(uint32 thresholdMs);
+        void Stop();
+
+        // world thread, around World::Update
+        void BeginTick();
+        void EndTick();
+
+        // name of the calling thread in reports, threads not named are numbered
+        static void SetThreadName(std::string const& name);
+
+        // label must be a string literal or otherwise outlive the frame, false when the watchdog is not running
+        static bool PushFrame(WatchdogFrameType type, char const* label, uint32 id = 0, uint32 subId = 0);
+        static void PopFrame();
+
+    private:
+        struct Frame
+        {
+            std::atomic<uint32> type{ WATCHDOG_FRAME_PHASE };
+            std::atomic<char const*> label{ nullptr };
+            std::atomic<uint32> id{ 0 };
+            std::atomic<uint32> subId{ 0 };
+        };
+
+        // written by its thread only, read by the watchdog thread under m_threadsLock
+        struct ThreadFrames
+        {
+            std::string name;
+            std::atomic<uint32> depth{ 0 };
+            Frame frames[MAX_FRAMES];
+        };
+
+        // registers the thread with the watchdog for its lifetime
+        struct ThreadRegistration
+        {
+            ThreadRegistration();
+            ~ThreadRegistration();
+
+            std::unique_ptr<ThreadFrames> frames;
+        };
+
+        typedef std::map<std::string /*thread*/, std::map<std::string /*stack*/, uint32 /*samples*/>> SampleMap;
+
+        TickWatchdog() : m_thresholdMs(0), m_tickId(0), m_tickStart(0), m_inTick(false), m_lastTickId(0), m_lastTickMs(0), m_stop(false), m_threadCounter(0) {}
+
+        static ThreadFrames& GetThreadFrames();
+        static std::string DescribeFrame(uint32 type, char const* label, uint32 id, uint32 subId);
+
+        void Run();
+        void Sample(SampleMap& samples);
+        void WriteReport(uint32 tickId, uint32 elapsedMs, uint32 sampleCount, SampleMap const& samples) const;
+
+        static std::atomic<bool> s_running;
+
+        uint32 m_thresholdMs;
+
+        std::atomic<uint32> m_tickId;
+        std::atomic<uint32> m_tickStart;
+        std::atomic<bool> m_inTick;
+        std::atomic<uint32> m_lastTickId;
+        std::atomic<uint32> m_lastTickMs;
+
+        std::thread m_thread;
+        std::atomic<bool> m_stop;
+
+        std::vector<ThreadFrames*> m_threads;
+        std::mutex m_threadsLock;
+        uint32 m_threadCounter;
+};
+
+#define sTickWatchdog TickWatchdog::Instance()
+
+// Marks the enclosing scope in the stack of the calling thread
+class WatchdogFrame
+{
+    public:
+        WatchdogFrame(WatchdogFrameType type, char const* label, uint32 id = 0, uint32 subId = 0) : m_pushed(TickWatchdog::PushFrame(type, label, id, subId)) {}
+        ~WatchdogFrame() { Pop(); }
+
+        // ends the frame before the scope does
+        void Pop()
+        {
+            if (m_pushed)
+                TickWatchdog::PopFrame();
+            m_pushed = false;
+        }
+
+        WatchdogFrame(WatchdogFrame const&) = delete;
+        WatchdogFrame& operator=(WatchdogFrame const&) = delete;
+
+    private:
+        bool m_pushed;
+};
+
+#endif
@@ -0,0 +1,221 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "World/WhoListIndex.h"
+#include "World/World.h"
+#include "Entities/Player.h"
+#include "Globals/ObjectAccessor.h"
+#include "Guilds/GuildMgr.h"
+#include "Server/DBCStores.h"
+#include "Server/WorldSession.h"
+#include "WorldPacket.h"
+#include "Util.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(WhoListIndex);
+
+void WhoListIndex::Rebuild()
+{
+    std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+
+    sObjectAccessor.ExecuteOnAllPlayers([&snapshot](Player* player)
+    {
+        if (!player->IsInWorld())
+            return;
+
+        WhoListEntry entry;
+        entry.guid = player->GetObjectGuid();
+        entry.name = player->GetName();
+        entry.guildName = sGuildMgr.GetGuildNameById(player->GetGuildId());
+        if (!Utf8toWStr(entry.name, entry.nameLower) || !Utf8toWStr(entry.guildName, entry.guildNameLower))
+            return;
+        wstrToLower(entry.nameLower);
+        wstrToLower(entry.guildNameLower);
+
+        entry.team = player->GetTeam();
+        entry.security = player->GetSession()->GetSecurity();
+        entry.visibleToAll = player->GetVisibility() == VISIBILITY_ON;
+        entry.hiddenFromPlayers = player->GetVisibility() == VISIBILITY_OFF;
+        entry.level = player->GetLevel();
+        entry.classId = player->getClass();
+        entry.race = player->getRace();
+        entry.gender = player->getGender();
+        entry.zoneId = player->GetZoneId();
+
+        snapshot->entries[GetTeamIndexByTeamId(entry.team)].push_back(std::move(entry));
+    });
+
+    for (uint32 teamIndex = 0; teamIndex < PVP_TEAM_COUNT; ++teamIndex)
+    {
+        std::vector<WhoListEntry>& entries = snapshot->entries[teamIndex];
+        std::stable_sort(entries.begin(), entries.end(), [](WhoListEntry const& a, WhoListEntry const& b) { return a.level < b.level; });
+
+        for (uint32 i = 0; i < entries.size(); ++i)
+            snapshot->zoneEntries[teamIndex][entries[i].zoneId].push_back(i);
+    }
+
+    std::shared_ptr<Snapshot const> old = std::move(snapshot);
+    {
+        std::lock_guard<std::mutex> guard(m_snapshotLock);
+        m_snapshot.swap(old);
+    }
+    // the previous snapshot is freed here, outside of the lock, unless a query still holds it
+}
+
+std::shared_ptr<WhoListIndex::Snapshot const> WhoListIndex::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> guard(m_snapshotLock);
+    return m_snapshot;
+}
+
+void WhoListIndex::BuildWhoList(Player* viewer, WhoListQuery const& query, WorldPacket& data) const
+{
+    Team team = viewer->GetTeam();
+    AccountTypes security = viewer->GetSession()->GetSecurity();
+    bool allowTwoSideWhoList = sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST);
+    AccountTypes gmLevelInWhoList = (AccountTypes)sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST);
+    uint32 maxReturns = sWorld.getConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS);
+    LocaleConstant locale = viewer->GetSession()->GetSessionDbcLocale();
+
+    // the reported match count is capped by MaxWhoListReturns, so the search can stop there
+    uint32 matchLimit = maxReturns ? std::max(maxReturns, uint32(WHO_LIST_MAX_DISPLAYED)) : std::numeric_limits<uint32>::max();
+
+    uint32 matchcount = 0;
+    uint32 displaycount = 0;
+
+    size_t countPos = data.wpos();
+    data << uint32(matchcount);                             // placeholder, count of players matching criteria
+    data << uint32(displaycount);                           // placeholder, count of players displayed
+
+    // returns false once enough players matched
+    auto visit = [&](WhoListEntry const& entry) -> bool
+    {
+        if (security == SEC_PLAYER)
+        {
+            // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+            if (entry.security > gmLevelInWhoList)
+                return true;
+        }
+
+        // check if target is globally visible for player, see Player::IsVisibleGloballyFor
+        if (entry.guid != viewer->GetObjectGuid() && !entry.visibleToAll)
+        {
+            if (security > SEC_PLAYER ? entry.security > security : entry.hiddenFromPlayers)
+                return true;
+        }
+
+        if (!(query.classMask & (1 << entry.classId)))
+            return true;
+
+        if (!(query.raceMask & (1 << entry.race)))
+            return true;
+
+        if (!(query.playerName.empty() || entry.nameLower.find(query.playerName) != std::wstring::npos))
+            return true;
+
+        if (!(query.guildName.empty() || entry.guildNameLower.find(query.guildName) != std::wstring::npos))
+            return true;
+
+        bool s_show = true;
+        for (uint32 i = 0; i < query.stringCount; ++i)
+        {
+            if (!query.strings[i].empty())
+            {
+                std::string aname;
+                if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId))
+                    aname = areaEntry->area_name[locale];
+
+                if (entry.guildNameLower.find(query.strings[i]) != std::wstring::npos ||
+                        entry.nameLower.find(query.strings[i]) != std::wstring::npos ||
+                        Utf8FitTo(aname, query.strings[i]))
+                {
+                    s_show = true;
+                    break;
+                }
+                s_show = false;
+            }
+        }
+        if (!s_show)
+            return true;
+
+        if (++matchcount <= WHO_LIST_MAX_DISPLAYED)
+        {
+            ++displaycount;
+
+            data << entry.name;                             // player name
+            data << entry.guildName;                        // guild name
+            data << uint32(entry.level);                    // player level
+            data << uint32(entry.classId);                  // player class
+            data << uint32(entry.race);                     // player race
+            data << uint8(entry.gender);                    // player gender
+            data << uint32(entry.zoneId);                   // player zone id
+        }
+
+        return matchcount < matchLimit;
+    };
+
+    if (std::shared_ptr<Snapshot const> snapshot = GetSnapshot())
+    {
+        for (uint32 teamIndex = 0; teamIndex < PVP_TEAM_COUNT; ++teamIndex)
+        {
+            // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+            if (security == SEC_PLAYER && !allowTwoSideWhoList && GetTeamIdByTeamIndex(PvpTeamIndex(teamIndex)) != team)
+                continue;
+
+            std::vector<WhoListEntry> const& entries = snapshot->entries[teamIndex];
+            bool more = true;
+
+            if (query.zoneCount)
+            {
+                for (uint32 i = 0; i < query.zoneCount && more; ++i)
+                {
+                    // the same zone can be asked for twice
+                    if (std::find(query.zoneIds, query.zoneIds + i, query.zoneIds[i]) != query.zoneIds + i)
+                        continue;
+
+                    auto zone = snapshot->zoneEntries[teamIndex].find(query.zoneIds[i]);
+                    if (zone == snapshot->zoneEntries[teamIndex].end())
+                        continue;
+
+                    std::vector<uint32> const& indexes = zone->second;
+                    auto itr = std::lower_bound(indexes.begin(), indexes.end(), query.levelMin,
+                        [&entries](uint32 index, uint32 level) { return entries[index].level < level; });
+                    for (; itr != indexes.end() && entries[*itr].level <= query.levelMax && more; ++itr)
+                        more = visit(entries[*itr]);
+                }
+            }
+            else
+            {
+                auto itr = std::lower_bound(entries.begin(), entries.end(), query.levelMin,
+                    [](WhoListEntry const& entry, uint32 level) { return entry.level < level; });
+                for (; itr != entries.end() && itr->level <= query.levelMax && more; ++itr)
+                    more = visit(*itr);
+            }
+
+            if (!more)
+                break;
+        }
+    }
+
+    if (maxReturns && matchcount > maxReturns)
+        matchcount = maxReturns;
+
+    data.put(countPos, displaycount);                       // insert right count, count displayed
+    data.put(countPos + 4, matchcount);                     // insert right count, count of matches
+}
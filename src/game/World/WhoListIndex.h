@@ -0,0 +1,96 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_WHOLISTINDEX_H
+#define MANGOS_WHOLISTINDEX_H
+
+#include "Common.h"
+#include "Entities/ObjectGuid.h"
+#include "Globals/SharedDefines.h"
+#include "Policies/Singleton.h"
+
+#include <memory>
+#include <mutex>
+
+class Player;
+class WorldPacket;
+
+#define WHO_LIST_MAX_ZONES      10                          // client limit
+#define WHO_LIST_MAX_STRINGS    4                           // client limit
+#define WHO_LIST_MAX_DISPLAYED  49                          // maximum player count sent to client
+
+// search of a CMSG_WHO, names and strings already lowercase
+struct WhoListQuery
+{
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 raceMask;
+    uint32 classMask;
+    uint32 zoneCount;
+    uint32 zoneIds[WHO_LIST_MAX_ZONES];
+    uint32 stringCount;
+    std::wstring strings[WHO_LIST_MAX_STRINGS];
+    std::wstring playerName;
+    std::wstring guildName;
+};
+
+struct WhoListEntry
+{
+    ObjectGuid guid;
+    std::string name;
+    std::string guildName;
+    std::wstring nameLower;
+    std::wstring guildNameLower;
+    Team team;
+    AccountTypes security;
+    bool visibleToAll;                                      // VISIBILITY_ON
+    bool hiddenFromPlayers;                                 // VISIBILITY_OFF
+    uint32 level;
+    uint32 classId;
+    uint32 race;
+    uint8 gender;
+    uint32 zoneId;
+};
+
+// Copy of the /who relevant state of the players in world, rebuilt by the world thread every WhoListIndexInterval.
+// Queries work on an immutable snapshot, so they neither walk the player map nor take a lock map threads need.
+class WhoListIndex
+{
+    public:
+        // world thread only, while map threads are not updating
+        void Rebuild();
+
+        // appends the SMSG_WHO result of query for viewer to data
+        void BuildWhoList(Player* viewer, WhoListQuery const& query, WorldPacket& data) const;
+
+    private:
+        struct Snapshot
+        {
+            std::vector<WhoListEntry> entries[PVP_TEAM_COUNT];  // sorted by level
+            std::unordered_map<uint32, std::vector<uint32>> zoneEntries[PVP_TEAM_COUNT]; // zone -> indexes in entries, sorted by level
+        };
+
+        std::shared_ptr<Snapshot const> GetSnapshot() const;
+
+        mutable std::mutex m_snapshotLock;                  // guards only the pointer swap
+        std::shared_ptr<Snapshot const> m_snapshot;
+};
+
+#define sWhoListIndex MaNGOS::Singleton<WhoListIndex>::Instance()
+
+#endif
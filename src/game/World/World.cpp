@@ -58,6 +58,7 @@
 #include "Grids/CellImpl.h"
 #include "Maps/MapPersistentStateMgr.h"
 #include "MotionGenerators/WaypointManager.h"
+#include "MotionGenerators/MovementGenerator.h"
 #include "GMTickets/GMTicketMgr.h"
 #include "Util.h"
 #include "Tools/CharacterDatabaseCleaner.h"
@@ -67,6 +68,19 @@
 #include "Cinematics/CinematicMgr.h"
 #include "Maps/TransportMgr.h"
 #include "Anticheat/Anticheat.hpp"
+#include "Server/OpcodeStats.h"
+#include "AI/ScriptDevAI/ScriptProfiler.h"
+#include "World/LoadGraph.h"
+#include "World/WhoListIndex.h"
+#include "Maps/ZoneStats.h"
+#include "AllocStats.h"
+#include "Trace.h"
+#include "World/TickWatchdog.h"
+#include "Spells/Spell.h"
+#include "Spells/SpellAuras.h"
+#include "Entities/CharacterLoginCache.h"
+#include "Entities/PlayerSaveScheduler.h"
+#include "Maps/MapWorkers.h"
 
 #ifdef BUILD_AHBOT
  #include "AuctionHouseBot/AuctionHouseBot.h"
@@ -133,6 +147,9 @@ World::~World()
 {
     // it is assumed that no other thread is accessing this data when the destructor is called.  therefore, no locks are necessary
 
+    if (m_sessionUpdater)
+        m_sessionUpdater->deactivate();
+
     ///- Empty the kicked session set
     for (auto const session : m_sessions)
         delete session.second;
@@ -154,6 +171,7 @@ void World::CleanupsBeforeStop()
     UpdateSessions(1);                               // real players unload required UpdateSessions call
     sBattleGroundMgr.DeleteAllBattleGrounds();       // unload battleground templates before different singletons destroyed
     sMapMgr.UnloadAll();                             // unload all grids (including locked in memory)
+    sWorldState.SavePending();                       // progress not yet written by WorldState::Update
 }
 
 /// Find a session by its id
@@ -425,6 +443,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_FLOAT_RATE_AUCTION_DEPOSIT, "Rate.Auction.Deposit", 1.0f);
     setConfig(CONFIG_FLOAT_RATE_AUCTION_CUT,     "Rate.Auction.Cut", 1.0f);
     setConfig(CONFIG_UINT32_AUCTION_DEPOSIT_MIN, "Auction.Deposit.Min", 0);
+    setConfig(CONFIG_UINT32_AUCTION_SEARCH_THREADS, "Auction.SearchThreads", 0);
     setConfig(CONFIG_FLOAT_RATE_HONOR, "Rate.Honor", 1.0f);
     setConfigPos(CONFIG_FLOAT_RATE_MINING_AMOUNT, "Rate.Mining.Amount", 1.0f);
     setConfigPos(CONFIG_FLOAT_RATE_MINING_NEXT,   "Rate.Mining.Next", 1.0f);
@@ -449,6 +468,8 @@ void World::LoadConfigSettings(bool reload)
     setConfigPos(CONFIG_FLOAT_CREATURE_CHECK_FOR_HELP_RADIUS,         "CreatureCheckForHelpRadius",     5.0f);
     setConfig(CONFIG_UINT32_CREATURE_CHECK_FOR_HELP_AGGRO_DELAY,      "CreatureCheckForHelpAggroDelay",     2000);
     setConfigPos(CONFIG_FLOAT_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS, "CreatureFamilyFleeAssistanceRadius", 30.0f);
+    setConfigPos(CONFIG_FLOAT_CREATURE_HIBERNATE_DISTANCE,            "CreatureHibernateDistance",          0.0f);
+    setConfig(CONFIG_UINT32_CREATURE_HIBERNATE_INTERVAL,              "CreatureHibernateInterval",          1000);
 
     ///- Read other configuration items from the config file
     setConfigMinMax(CONFIG_UINT32_COMPRESSION, "Compression", 1, 1, 9);
@@ -456,6 +477,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
+    setConfigMin(CONFIG_UINT32_WHOLIST_INDEX_INTERVAL, "WhoListIndexInterval", 1000, 100);
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps");
     if (!forceLoadGridOnMaps.empty())
@@ -472,10 +494,22 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
+    setConfig(CONFIG_BOOL_PLAYER_SAVE_SPREAD, "PlayerSave.Spread", true);
+    setConfig(CONFIG_UINT32_PLAYER_SAVE_MAX_ASYNC_QUEUE, "PlayerSave.MaxAsyncQueue", 0);
+    setConfig(CONFIG_UINT32_INTERVAL_SAVE_VALUABLE, "PlayerSave.ValuableInterval", 0);
+    setConfig(CONFIG_UINT32_LOGIN_CACHE_SIZE, "CharacterLoginCache.Size", 0);
+    setConfig(CONFIG_UINT32_LOGIN_CACHE_TTL, "CharacterLoginCache.TTL", MINUTE);
 
     setConfigMin(CONFIG_UINT32_INTERVAL_GRIDCLEAN, "GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS, MIN_GRID_DELAY);
     if (reload)
         sMapMgr.SetGridCleanUpDelay(getConfig(CONFIG_UINT32_INTERVAL_GRIDCLEAN));
+    setConfig(CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET, "GridUnloadTimeBudget", 5);
+
+    setConfig(CONFIG_UINT32_GRID_PREFETCH_TIME, "GridPrefetchTime", 5);
+    setConfigMin(CONFIG_UINT32_GRID_PREFETCH_THREADS, "GridPrefetchThreads", 2, 1);
+
+    setConfigMin(CONFIG_UINT32_TAXI_POSITION_UPDATE_INTERVAL, "TaxiFlight.PositionUpdateInterval", 400, 100);
+    setConfig(CONFIG_BOOL_TAXI_LOAD_GRIDS, "TaxiFlight.LoadGrids", true);
 
     setConfigMin(CONFIG_UINT32_INTERVAL_MAPUPDATE, "MapUpdateInterval", 100, MIN_MAP_UPDATE_DELAY);
     if (reload)
@@ -548,6 +582,8 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR, "Instance.ResetTimeHour", 4);
     setConfig(CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,    "Instance.UnloadDelay", 30 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_INSTANCE_TERRAIN_KEEP_ALIVE, "Instance.TerrainKeepAlive", 10 * MINUTE);
+    setConfig(CONFIG_UINT32_INSTANCE_DATA_SAVE_INTERVAL, "Instance.DataSaveInterval", 0);
 
     setConfigMinMax(CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL, "MaxPrimaryTradeSkill", 2, 0, 10);
 
@@ -579,10 +615,18 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_FOGOFWAR_STEALTH, "Visibility.FogOfWar.Stealth", 0);
     setConfig(CONFIG_UINT32_FOGOFWAR_HEALTH, "Visibility.FogOfWar.Health", 0);
     setConfig(CONFIG_UINT32_FOGOFWAR_STATS, "Visibility.FogOfWar.Stats", 0);
+    setConfig(CONFIG_UINT32_VISIBILITY_FULL_SWEEP_INTERVAL, "Visibility.FullSweepInterval", 8);
+    setConfig(CONFIG_UINT32_RELOCATION_NOTIFY_BUDGET, "Visibility.RelocationNotifyBudget", 0);
+    setConfigPos(CONFIG_FLOAT_VISIBILITY_FULL_DETAIL_DISTANCE, "Visibility.FullDetailDistance", 0.0f);
+    setConfigMin(CONFIG_UINT32_VISIBILITY_LOW_DETAIL_UPDATE_TICKS, "Visibility.LowDetailUpdateTicks", 4, 1);
+    setConfig(CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS, "Visibility.BroadcastToObservers", true);
+    setConfigPos(CONFIG_FLOAT_VISIBILITY_COMBAT_LOG_RANGE, "Visibility.CombatLogRange", 0.0f);
 
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
+    setConfig(CONFIG_UINT32_MAIL_UNLOAD_DELAY, "MailUnloadDelay", 5 * MINUTE);
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
+    setConfig(CONFIG_UINT32_MASS_MAILER_WRITES_PER_SECOND, "MassMailer.WritesPerSecond", 0);
 
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
@@ -592,6 +636,16 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_NUM_MAP_THREADS, "MapUpdate.Threads", 3);
+    setConfig(CONFIG_UINT32_NUM_MAP_CELL_THREADS, "MapUpdate.CellThreads", 0);
+    setConfig(CONFIG_BOOL_MAPUPDATE_STICKY_MAPS, "MapUpdate.StickyMaps", false);
+    setConfig(CONFIG_BOOL_MAPUPDATE_STATE_SNAPSHOT, "MapUpdate.StateSnapshot", false);
+    setConfig(CONFIG_UINT32_NUM_SESSION_THREADS, "SessionUpdate.Threads", 0);
+    setConfig(CONFIG_UINT32_NUM_LOAD_THREADS, "LoadThreads", 4);
+    setConfig(CONFIG_UINT32_SCRIPT_PROFILE_SAMPLE_RATE, "ScriptProfile.SampleRate", 0);
+    setConfig(CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE, "ZoneStats.SampleRate", 0);
+    setConfig(CONFIG_BOOL_ALLOC_STATS_ENABLED, "AllocStats.Enabled", false);
+    AllocStats::SetEnabled(getConfig(CONFIG_BOOL_ALLOC_STATS_ENABLED));
+    setConfig(CONFIG_UINT32_WATCHDOG_SLOW_TICK_THRESHOLD, "Watchdog.SlowTickThreshold", 0);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_ORANGE, "SkillChance.Orange", 100);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_YELLOW, "SkillChance.Yellow", 75);
     setConfig(CONFIG_UINT32_SKILL_CHANCE_GREEN,  "SkillChance.Green",  25);
@@ -631,6 +685,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_CHATFLOOD_MUTE_TIME,     "ChatFlood.MuteTime", 10);
 
     setConfig(CONFIG_BOOL_EVENT_ANNOUNCE, "Event.Announce", false);
+    setConfig(CONFIG_UINT32_EVENT_SPAWN_BUDGET, "Event.SpawnBudget", 0);
 
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_ASSISTANCE_DELAY, "CreatureFamilyAssistanceDelay", 1500);
     setConfig(CONFIG_UINT32_CREATURE_FAMILY_FLEE_DELAY,       "CreatureFamilyFleeDelay",       10000);
@@ -645,6 +700,7 @@ void World::LoadConfigSettings(bool reload)
     setConfigMinMax(CONFIG_UINT32_QUEST_WEEKLY_RESET_HOUR, "Quests.Weekly.ResetHour", 6, 0, 23);
 
     setConfig(CONFIG_BOOL_QUEST_IGNORE_RAID, "Quests.IgnoreRaid", false);
+    setConfig(CONFIG_UINT32_QUESTGIVER_STATUS_CACHE_TIME, "Quests.StatusCacheTime", 0);
 
     setConfig(CONFIG_BOOL_DETECT_POS_COLLISION, "DetectPosCollision", true);
 
@@ -661,6 +717,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,                     "Corpse.EmptyLootShow",                  true);
     setConfig(CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT, "Corpse.AllowAllItemsShowInMasterLoot", false);
+    setConfig(CONFIG_BOOL_CORPSE_DEFERRED_LOOT,                       "Corpse.DeferredLoot",                   false);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_NORMAL,                      "Corpse.Decay.NORMAL",                    300);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_RARE,                        "Corpse.Decay.RARE",                      900);
     setConfig(CONFIG_UINT32_CORPSE_DECAY_ELITE,                       "Corpse.Decay.ELITE",                     600);
@@ -714,6 +771,14 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
 
+    setConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY, "Network.FlushDelay", 50000);
+    setConfig(CONFIG_UINT32_NETWORK_FLUSH_BYTES, "Network.FlushBytes", 0);
+    setConfig(CONFIG_BOOL_NETWORK_FLUSH_LATENCY_CRITICAL, "Network.FlushLatencyCritical", false);
+    setConfig(CONFIG_BOOL_NETWORK_BATCH_MONSTER_MOVES, "Network.BatchMonsterMoves", false);
+    setConfig(CONFIG_BOOL_NETWORK_AGGREGATE_COMBAT_LOG, "Network.AggregateCombatLog", false);
+    MaNGOS::Socket::SetWriteBufferPolicy(getConfig(CONFIG_UINT32_NETWORK_FLUSH_DELAY), getConfig(CONFIG_UINT32_NETWORK_FLUSH_BYTES));
+    setConfig(CONFIG_BOOL_OPCODE_STATS, "Network.OpcodeStats", false);
+
     setConfig(CONFIG_BOOL_PLAYER_COMMANDS, "PlayerCommands", true);
 
     setConfig(CONFIG_UINT32_INSTANT_LOGOUT, "InstantLogout", SEC_MODERATOR);
@@ -722,6 +787,7 @@ void World::LoadConfigSettings(bool reload)
 
     setConfigMin(CONFIG_UINT32_GUILD_EVENT_LOG_COUNT, "Guild.EventLogRecordsCount", GUILD_EVENTLOG_MAX_RECORDS, GUILD_EVENTLOG_MAX_RECORDS);
     setConfigMin(CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT, "Guild.BankEventLogRecordsCount", GUILD_BANK_MAX_LOGS, GUILD_BANK_MAX_LOGS);
+    setConfig(CONFIG_UINT32_GUILD_DATA_UNLOAD_DELAY, "Guild.DataUnloadDelay", 1800);
 
     setConfig(CONFIG_UINT32_MIRRORTIMER_FATIGUE_MAX,       "MirrorTimer.Fatigue.Max", 60);
     setConfig(CONFIG_UINT32_MIRRORTIMER_BREATH_MAX,        "MirrorTimer.Breath.Max", 60);
@@ -809,6 +875,8 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    SQLStorageBase::SetCacheDirectory(sConfig.GetStringDefault("TableCacheDir", ""));
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -818,6 +886,7 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapManager()->setMappedModels(sConfig.GetBoolDefault("vmap.mappedModels", false));
     sLog.outString("WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i",
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
@@ -826,9 +895,25 @@ void World::LoadConfigSettings(bool reload)
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
+    setConfig(CONFIG_BOOL_MMAP_MAPPED_TILES, "mmap.mappedTiles", false);
+    setConfig(CONFIG_UINT32_MMAP_TILE_MEMORY_LIMIT, "mmap.tileMemoryLimit", 0);
 
     setConfig(CONFIG_BOOL_PATH_FIND_OPTIMIZE, "PathFinder.OptimizePath", true);
     setConfig(CONFIG_BOOL_PATH_FIND_NORMALIZE_Z, "PathFinder.NormalizeZ", false);
+    setConfig(CONFIG_UINT32_PATH_FIND_CACHE_LIFETIME, "PathFinder.CacheLifetime", 500);
+
+    setConfig(CONFIG_UINT32_VMAP_QUERY_CACHE_ENTRIES, "vmap.queryCacheEntries", 4096);
+    setConfigPos(CONFIG_FLOAT_VMAP_QUERY_CACHE_STEP, "vmap.queryCacheStep", 0.25f);
+    m_configQueryCacheMapIds.clear();
+    std::string queryCacheMaps = sConfig.GetStringDefault("vmap.queryCacheMapIds");
+    if (!queryCacheMaps.empty())
+    {
+        unsigned int pos = 0;
+        unsigned int id;
+        VMAP::VMapFactory::chompAndTrim(queryCacheMaps);
+        while (VMAP::VMapFactory::getNextId(queryCacheMaps, pos, id))
+            m_configQueryCacheMapIds.insert(id);
+    }
 
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL, "Raf.BonusLevel", 60);
     setConfig(CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL_DIFFERENCE, "Raf.LevelDifference", 4);
@@ -893,6 +978,9 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading spell_template...");
     sObjectMgr.LoadSpellTemplate();
 
+    sLog.outString("Precomputing spell metadata...");
+    sSpellMgr.LoadSpellMetadata();
+
     // Load before DBCs
     sLog.outString("Loading faction_store...");
     sObjectMgr.LoadFactions();
@@ -908,6 +996,7 @@ void World::SetInitialWorldSettings()
     sLog.outString("Initialize DBC data stores...");
     LoadDBCStores(m_dataPath);
     DetectDBCLang();
+    Unit::InitializeFactionReactions();
     sObjectMgr.SetDbc2StorageLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
 
     // Loading cameras for characters creation cinematic
@@ -954,6 +1043,17 @@ void World::SetInitialWorldSettings()
     LoadGameObjectModelList();
     sLog.outString();
 
+    if (getConfig(CONFIG_BOOL_MMAP_ENABLED))
+    {
+        std::string preloadMapIds = sConfig.GetStringDefault("mmap.preloadMapIds");
+        if (!preloadMapIds.empty())
+        {
+            sLog.outString("Preloading navmesh tiles...");
+            MMAP::MMapFactory::createOrGetMMapManager()->preloadMaps(preloadMapIds, uint64(sConfig.GetIntDefault("mmap.preloadMemoryLimit", 0)) * 1024 * 1024);
+            sLog.outString();
+        }
+    }
+
     // loads GO data
     sTransportMgr.LoadTransportAnimationAndRotation();
 
@@ -1177,98 +1277,177 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Player level dependent mail rewards...");
     sObjectMgr.LoadMailLevelRewards();
 
-    sLog.outString("Loading Loot Tables...");
+    ///- Independent world tables, every step names the steps whose data it checks
     LootIdSet ids_set;
-    LoadLootTables(ids_set);
-    sLog.outString(">>> Loot Tables loaded");
-    sLog.outString();
+    LoadGraph loadGraph;
 
-    sLog.outString("Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
-
-    sLog.outString("Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
-
-    sLog.outString("Loading Skill Fishing base level requirements...");
-    sObjectMgr.LoadFishingBaseSkillLevel();
-
-    sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
-    sObjectMgr.LoadInstanceEncounters();
-
-    sLog.outString("Loading Npc Text Id...");
-    sObjectMgr.LoadNpcGossips();                            // must be after load Creature and LoadGossipText
-
-    sLog.outString("Loading Scripts random templates...");  // must be before String calls
-    sScriptMgr.LoadDbScriptRandomTemplates();
-    ///- Load and initialize DBScripts Engine
-    sLog.outString("Loading DB-Scripts Engine...");
-    sScriptMgr.LoadRelayScripts();                          // must be first in dbscripts loading
-    sScriptMgr.LoadGossipScripts();                         // must be before gossip menu options
-    sScriptMgr.LoadQuestStartScripts();                     // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadQuestEndScripts();                       // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptMgr.LoadSpellScripts();                          // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadGameObjectScripts();                     // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadGameObjectTemplateScripts();             // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadEventScripts();                          // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadCreatureDeathScripts();                  // must be after load Creature/Gameobject(Template/Data)
-    sScriptMgr.LoadCreatureMovementScripts();               // before loading from creature_movement
-    sObjectMgr.LoadAreatriggerLocales();
-    sLog.outString(">>> Scripts loaded");
-    sLog.outString();
+    loadGraph.AddStep("loot", [&ids_set]()
+    {
+        sLog.outString("Loading Loot Tables...");
+        LoadLootTables(ids_set);
+        sLog.outString(">>> Loot Tables loaded");
+        sLog.outString();
+    });
 
-    sLog.outString("Loading Scripts text locales...");      // must be after Load*Scripts calls
-    sScriptMgr.LoadDbScriptStrings();
+    loadGraph.AddStep("skill_discovery", []()
+    {
+        sLog.outString("Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    sLog.outString("Loading Gossip Menus...");
-    sObjectMgr.LoadGossipMenus();
+    loadGraph.AddStep("skill_extra_item", []()
+    {
+        sLog.outString("Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    sLog.outString("Loading Vendors...");
-    sObjectMgr.LoadVendorTemplates();                       // must be after load ItemTemplate
-    sObjectMgr.LoadVendors();                               // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    loadGraph.AddStep("fishing_skill", []()
+    {
+        sLog.outString("Loading Skill Fishing base level requirements...");
+        sObjectMgr.LoadFishingBaseSkillLevel();
+    });
+
+    loadGraph.AddStep("instance_encounters", []()
+    {
+        sLog.outString("Loading Instance encounters data...");  // must be after Creature loading
+        sObjectMgr.LoadInstanceEncounters();
+    });
+
+    loadGraph.AddStep("npc_gossips", []()
+    {
+        sLog.outString("Loading Npc Text Id...");
+        sObjectMgr.LoadNpcGossips();                        // must be after load Creature and LoadGossipText
+    });
+
+    loadGraph.AddStep("dbscripts", []()
+    {
+        sLog.outString("Loading Scripts random templates...");  // must be before String calls
+        sScriptMgr.LoadDbScriptRandomTemplates();
+        ///- Load and initialize DBScripts Engine
+        sLog.outString("Loading DB-Scripts Engine...");
+        sScriptMgr.LoadRelayScripts();                      // must be first in dbscripts loading
+        sScriptMgr.LoadGossipScripts();                     // must be before gossip menu options
+        sScriptMgr.LoadQuestStartScripts();                 // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadQuestEndScripts();                   // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptMgr.LoadSpellScripts();                      // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadGameObjectScripts();                 // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadGameObjectTemplateScripts();         // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadEventScripts();                      // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadCreatureDeathScripts();              // must be after load Creature/Gameobject(Template/Data)
+        sScriptMgr.LoadCreatureMovementScripts();           // before loading from creature_movement
+        sObjectMgr.LoadAreatriggerLocales();
+        sLog.outString(">>> Scripts loaded");
+        sLog.outString();
+
+        sLog.outString("Loading Scripts text locales...");  // must be after Load*Scripts calls
+        sScriptMgr.LoadDbScriptStrings();
+    });
 
-    sLog.outString("Loading Trainers...");
-    sObjectMgr.LoadTrainerTemplates();                      // must be after load CreatureTemplate
-    sObjectMgr.LoadTrainers();                              // must be after load CreatureTemplate, TrainerTemplate
+    loadGraph.AddStep("gossip_menus", []()
+    {
+        sLog.outString("Loading Gossip Menus...");
+        sObjectMgr.LoadGossipMenus();
+    }, { "dbscripts" });
+
+    loadGraph.AddStep("vendors", []()
+    {
+        sLog.outString("Loading Vendors...");
+        sObjectMgr.LoadVendorTemplates();                   // must be after load ItemTemplate
+        sObjectMgr.LoadVendors();                           // must be after load CreatureTemplate, VendorTemplate, and ItemTemplate
+    });
 
-    sLog.outString("Loading Waypoint scripts...");
+    loadGraph.AddStep("trainers", []()
+    {
+        sLog.outString("Loading Trainers...");
+        sObjectMgr.LoadTrainerTemplates();                  // must be after load CreatureTemplate
+        sObjectMgr.LoadTrainers();                          // must be after load CreatureTemplate, TrainerTemplate
+    });
 
-    sLog.outString("Loading Waypoints...");
-    sWaypointMgr.Load();
+    loadGraph.AddStep("waypoints", []()
+    {
+        sLog.outString("Loading Waypoints...");
+        sWaypointMgr.Load();
+    }, { "dbscripts" });
 
-    sLog.outString("Loading ReservedNames...");
-    sObjectMgr.LoadReservedPlayersNames();
+    loadGraph.AddStep("reserved_names", []()
+    {
+        sLog.outString("Loading ReservedNames...");
+        sObjectMgr.LoadReservedPlayersNames();
+    });
 
-    sLog.outString("Loading GameObjects for quests...");
-    sObjectMgr.LoadGameObjectForQuests();
+    loadGraph.AddStep("gameobject_for_quests", []()
+    {
+        sLog.outString("Loading GameObjects for quests...");
+        sObjectMgr.LoadGameObjectForQuests();
+    }, { "loot" });
 
-    sLog.outString("Loading BattleMasters...");
-    sBattleGroundMgr.LoadBattleMastersEntry();
+    loadGraph.AddStep("battlemasters", []()
+    {
+        sLog.outString("Loading BattleMasters...");
+        sBattleGroundMgr.LoadBattleMastersEntry();
 
-    sLog.outString("Loading BattleGround event indexes...");
-    sBattleGroundMgr.LoadBattleEventIndexes();
+        sLog.outString("Loading BattleGround event indexes...");
+        sBattleGroundMgr.LoadBattleEventIndexes();
+    });
 
-    sLog.outString("Loading GameTeleports...");
-    sObjectMgr.LoadGameTele();
+    loadGraph.AddStep("game_tele", []()
+    {
+        sLog.outString("Loading GameTeleports...");
+        sObjectMgr.LoadGameTele();
+    });
 
-    sLog.outString("Loading Questgiver Greetings...");
-    sObjectMgr.LoadQuestgiverGreeting();
+    loadGraph.AddStep("questgiver_greetings", []()
+    {
+        sLog.outString("Loading Questgiver Greetings...");
+        sObjectMgr.LoadQuestgiverGreeting();
+    });
 
-    sLog.outString("Loading Trainer Greetings...");
-    sObjectMgr.LoadTrainerGreetings();
+    loadGraph.AddStep("trainer_greetings", []()
+    {
+        sLog.outString("Loading Trainer Greetings...");
+        sObjectMgr.LoadTrainerGreetings();
+    });
 
     ///- Loading localization data
-    sLog.outString("Loading Localization strings...");
-    sObjectMgr.LoadCreatureLocales();                       // must be after CreatureInfo loading
-    sObjectMgr.LoadGameObjectLocales();                     // must be after GameobjectInfo loading
-    sObjectMgr.LoadItemLocales();                           // must be after ItemPrototypes loading
-    sObjectMgr.LoadQuestLocales();                          // must be after QuestTemplates loading
-    sObjectMgr.LoadGossipTextLocales();                     // must be after LoadGossipText
-    sObjectMgr.LoadPageTextLocales();                       // must be after PageText loading
-    sObjectMgr.LoadGossipMenuItemsLocales();                // must be after gossip menu items loading
-    sObjectMgr.LoadPointOfInterestLocales();                // must be after POI loading
-    sObjectMgr.LoadQuestgiverGreetingLocales();
-    sObjectMgr.LoadTrainerGreetingLocales();                // must be after CreatureInfo loading
-    sObjectMgr.LoadBroadcastTextLocales();
+    loadGraph.AddStep("creature_locales", []() { sObjectMgr.LoadCreatureLocales(); });                 // must be after CreatureInfo loading
+    loadGraph.AddStep("gameobject_locales", []() { sObjectMgr.LoadGameObjectLocales(); });             // must be after GameobjectInfo loading
+    loadGraph.AddStep("item_locales", []() { sObjectMgr.LoadItemLocales(); });                         // must be after ItemPrototypes loading
+    loadGraph.AddStep("quest_locales", []() { sObjectMgr.LoadQuestLocales(); });                       // must be after QuestTemplates loading
+    loadGraph.AddStep("gossip_text_locales", []() { sObjectMgr.LoadGossipTextLocales(); });            // must be after LoadGossipText
+    loadGraph.AddStep("page_text_locales", []() { sObjectMgr.LoadPageTextLocales(); });                // must be after PageText loading
+    loadGraph.AddStep("gossip_menu_locales", []() { sObjectMgr.LoadGossipMenuItemsLocales(); }, { "gossip_menus" });
+    loadGraph.AddStep("poi_locales", []() { sObjectMgr.LoadPointOfInterestLocales(); });               // must be after POI loading
+    loadGraph.AddStep("questgiver_greeting_locales", []() { sObjectMgr.LoadQuestgiverGreetingLocales(); }, { "questgiver_greetings" });
+    loadGraph.AddStep("trainer_greeting_locales", []() { sObjectMgr.LoadTrainerGreetingLocales(); }, { "trainer_greetings" });
+
+    // social structures only read character tables and static data loaded above
+    loadGraph.AddStep("player_data_cache", []()
+    {
+        sLog.outString("Loading character names...");
+        sObjectMgr.LoadPlayerDataCache();
+    });
+
+    loadGraph.AddStep("guilds", []()
+    {
+        sLog.outString("Loading Guilds...");
+        sGuildMgr.LoadGuilds();
+    });
+
+    loadGraph.AddStep("arena_teams", []()
+    {
+        sLog.outString("Loading ArenaTeams...");
+        sObjectMgr.LoadArenaTeams();
+    });
+
+    loadGraph.AddStep("groups", []()
+    {
+        sLog.outString("Loading Groups...");
+        sObjectMgr.LoadGroups();
+    }, { "player_data_cache" });                            // member names and maps come from the cache
+
+    loadGraph.Run(getConfig(CONFIG_UINT32_NUM_LOAD_THREADS));
+
+    sObjectMgr.LoadBroadcastTextLocales();                  // adds entries to the broadcast text map the steps above look up
     sLog.outString(">>> Localization strings loaded");
     sLog.outString();
 
@@ -1276,18 +1455,10 @@ void World::SetInitialWorldSettings()
     sLog.outString("Loading Auctions...");
     sAuctionMgr.LoadAuctionItems();
     sAuctionMgr.LoadAuctions();
+    sAuctionMgr.InitializeSearchThreads(getConfig(CONFIG_UINT32_AUCTION_SEARCH_THREADS));
     sLog.outString(">>> Auctions loaded");
     sLog.outString();
 
-    sLog.outString("Loading Guilds...");
-    sGuildMgr.LoadGuilds();
-
-    sLog.outString("Loading ArenaTeams...");
-    sObjectMgr.LoadArenaTeams();
-
-    sLog.outString("Loading Groups...");
-    sObjectMgr.LoadGroups();
-
     sLog.outString("Returning old mails...");
     sObjectMgr.ReturnOrDeleteOldMails(false);
 
@@ -1342,6 +1513,15 @@ void World::SetInitialWorldSettings()
     // Update groups with offline leader after delay in seconds
     m_timers[WUPDATE_GROUPS].SetInterval(IN_MILLISECONDS);
 
+    // rebuild the /who search copy of the online players
+    m_timers[WUPDATE_WHOLIST].SetInterval(getConfig(CONFIG_UINT32_WHOLIST_INDEX_INTERVAL));
+
+    // close the minute of per zone update time and traffic
+    m_timers[WUPDATE_ZONESTATS].SetInterval(MINUTE * IN_MILLISECONDS);
+
+    // drop guild bank content and logs of guilds nobody used for a while
+    m_timers[WUPDATE_GUILDDATA].SetInterval(MINUTE * IN_MILLISECONDS);
+
     // to set mailtimer to return mails every day between 4 and 5 am
     // mailtimer is increased when updating auctions
     // one second is 1000 -(tested on win system)
@@ -1362,6 +1542,9 @@ void World::SetInitialWorldSettings()
     sMapMgr.Initialize();
     sLog.outString();
 
+    if (uint32 sessionThreads = getConfig(CONFIG_UINT32_NUM_SESSION_THREADS))
+        m_sessionUpdater.reset(new MapUpdater(sessionThreads));
+
     ///- Initialize Battlegrounds
     sLog.outString("Starting BattleGround System");
     sBattleGroundMgr.CreateInitialBattleGrounds();
@@ -1478,12 +1661,18 @@ void World::DetectDBCLang()
     sLog.outString();
 }
 
-/// Update the World !
-void World::Update(uint32 diff)
+void World::UpdateClocks(uint32 diff)
 {
     m_currentMSTime = WorldTimer::getMSTime();
     m_currentTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
     m_currentDiff = diff;
+}
+
+/// Update the World !
+void World::Update(uint32 diff)
+{
+    TRACE_ZONE("World::Update");
+    UpdateClocks(diff);
 
     ///- Update the different timers
     for (auto& m_timer : m_timers)
@@ -1502,6 +1691,9 @@ void World::Update(uint32 diff)
     ///-Update mass mailer tasks if any
     sMassMailMgr.Update();
 
+    ///- Refill the periodic player save tokens
+    sPlayerSaveScheduler.Update(diff);
+
     /// Handle daily quests reset time
     if (m_gameTime > m_NextDailyQuestReset)
         ResetDailyQuests();
@@ -1538,22 +1730,17 @@ void World::Update(uint32 diff)
         sAuctionHouseBot.Update();
         m_timers[WUPDATE_AHBOT].Reset();
     }
+    sAuctionHouseBot.ProcessPendingAuctions();
 #endif
 
     /// <li> Handle session updates
 #ifdef BUILD_METRICS
     auto preSessionTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
-    UpdateSessions(diff);
-
-    /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
     {
-        uint32 tmpDiff = uint32(m_gameTime - m_startTime);
-        uint32 maxClientsNum = GetMaxActiveSessionCount();
-
-        m_timers[WUPDATE_UPTIME].Reset();
-        LoginDatabase.PExecute("UPDATE uptime SET uptime = %u, maxplayers = %u WHERE realmid = %u AND starttime = " UI64FMTD, tmpDiff, maxClientsNum, realmID, uint64(m_startTime));
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "world sessions");
+        TRACE_ZONE("world sessions");
+        UpdateSessions(diff);
     }
 
     /// <li> Handle all other objects
@@ -1561,13 +1748,31 @@ void World::Update(uint32 diff)
 #ifdef BUILD_METRICS
     auto preMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
-    sMapMgr.Update(diff);
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "maps");
+        TRACE_ZONE("MapManager::StartUpdate");
+        sMapMgr.StartUpdate(diff);
+    }
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "world work beside maps");
+        TRACE_ZONE("world work beside maps");
+        UpdateBesideMaps();
+    }
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "maps");
+        TRACE_ZONE("MapManager::FinishUpdate");
+        sMapMgr.FinishUpdate();
+    }
 #ifdef BUILD_METRICS
     auto postMapTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
-    sBattleGroundMgr.Update(diff);
-    sOutdoorPvPMgr.Update(diff);
-    sWorldState.Update(diff);
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "battlegrounds and world state");
+        TRACE_ZONE("battlegrounds and world state");
+        sBattleGroundMgr.Update(diff);
+        sOutdoorPvPMgr.Update(diff);
+        sWorldState.Update(diff);
+    }
 #ifdef BUILD_METRICS
     auto postSingletonTime = std::chrono::time_point_cast<std::chrono::milliseconds>(Clock::now());
 #endif
@@ -1582,6 +1787,20 @@ void World::Update(uint32 diff)
         }
     }
 
+    ///- Refresh the players searched by /who
+    if (m_timers[WUPDATE_WHOLIST].Passed())
+    {
+        m_timers[WUPDATE_WHOLIST].Reset();
+        sWhoListIndex.Rebuild();
+    }
+
+    ///- Unload idle guild bank content and logs
+    if (m_timers[WUPDATE_GUILDDATA].Passed())
+    {
+        m_timers[WUPDATE_GUILDDATA].Reset();
+        sGuildMgr.UnloadIdleGuildData();
+    }
+
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
     {
@@ -1590,7 +1809,11 @@ void World::Update(uint32 diff)
     }
 
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "query callbacks");
+        TRACE_ZONE("query callbacks");
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -1613,13 +1836,17 @@ void World::Update(uint32 diff)
     if (m_timers[WUPDATE_METRICS].Passed())
     {
         m_timers[WUPDATE_METRICS].Reset();
-        GeneratePacketMetrics();
+        sMapMgr.GenerateMetrics();                          // the others are sent by UpdateBesideMaps
     }
 #endif
 
     /// </ul>
     ///- Move all creatures with "delayed move" and remove and delete all objects with "delayed remove"
-    sMapMgr.RemoveAllObjectsInRemoveList();
+    {
+        WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "object removal");
+        TRACE_ZONE("object removal");
+        sMapMgr.RemoveAllObjectsInRemoveList();
+    }
 
     // update the instance reset times
     sMapPersistentStateMgr.Update();
@@ -2075,6 +2302,70 @@ void World::ShutdownCancel()
     DEBUG_LOG("Server %s cancelled.", (m_ShutdownMask & SHUTDOWN_MASK_RESTART ? "restart" : "shutdown"));
 }
 
+#define SESSION_UPDATE_BATCH_SIZE size_t(64)              // sessions per job of the session update threads
+
+// runs the PROCESS_SESSION_PARALLEL packets of a range of sessions
+class SessionUpdateWorker : public Worker
+{
+    public:
+        typedef std::vector<WorldSession*>::const_iterator Iterator;
+
+        SessionUpdateWorker(Iterator first, Iterator last, MapUpdater& updater) : Worker(updater), m_first(first), m_last(last) {}
+
+        void execute() override
+        {
+            WatchdogFrame frame(WATCHDOG_FRAME_PHASE, "parallel session packets");
+            TRACE_ZONE("parallel session packets");
+            for (Iterator itr = m_first; itr != m_last; ++itr)
+                (*itr)->UpdateParallel();
+            frame.Pop();
+
+            GetWorker().update_finished();
+        }
+
+    private:
+        Iterator m_first;
+        Iterator m_last;
+};
+
+// Runs on the world thread while the map threads update the maps, so nothing here may touch maps, their objects,
+// players, groups or anything else reached from a map update. Only own world state, locked stores and async queries.
+void World::UpdateBesideMaps()
+{
+    ///- Update uptime table
+    if (m_timers[WUPDATE_UPTIME].Passed())
+    {
+        uint32 tmpDiff = uint32(m_gameTime - m_startTime);
+        uint32 maxClientsNum = GetMaxActiveSessionCount();
+
+        m_timers[WUPDATE_UPTIME].Reset();
+        LoginDatabase.PExecute("UPDATE uptime SET uptime = %u, maxplayers = %u WHERE realmid = %u AND starttime = " UI64FMTD, tmpDiff, maxClientsNum, realmID, uint64(m_startTime));
+    }
+
+    ///- Publish the per zone update time and traffic and the allocations of the last minute
+    if (m_timers[WUPDATE_ZONESTATS].Passed())
+    {
+        m_timers[WUPDATE_ZONESTATS].Reset();
+        sZoneStats.CloseInterval();
+        sAllocStats.CloseInterval();
+#ifdef BUILD_METRICS
+        GenerateZoneStatsMetrics();
+        if (AllocStats::IsEnabled())
+            GenerateAllocStatsMetrics();
+#endif
+    }
+
+#ifdef BUILD_METRICS
+    // the metrics timer is reset with the map metrics after the map update
+    if (m_timers[WUPDATE_METRICS].Passed())
+    {
+        GeneratePacketMetrics();
+        GenerateDatabaseMetrics();
+        GenerateScriptProfileMetrics();
+    }
+#endif
+}
+
 void World::UpdateSessions(uint32 diff)
 {
     ///- Add new sessions
@@ -2089,6 +2380,22 @@ void World::UpdateSessions(uint32 diff)
             AddSession_(session);
     }
 
+    ///- Process the packets safe to run in parallel, nothing else runs meanwhile
+    if (m_sessionUpdater)
+    {
+        m_parallelSessions.clear();
+        for (auto const& session : m_sessions)
+            m_parallelSessions.push_back(session.second);
+
+        for (size_t i = 0; i < m_parallelSessions.size(); i += SESSION_UPDATE_BATCH_SIZE)
+        {
+            auto first = m_parallelSessions.begin() + i;
+            auto last = m_parallelSessions.begin() + std::min(i + SESSION_UPDATE_BATCH_SIZE, m_parallelSessions.size());
+            m_sessionUpdater->schedule_update(new SessionUpdateWorker(first, last, *m_sessionUpdater));
+        }
+        m_sessionUpdater->wait();
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(); itr != m_sessions.end();)
     {
@@ -2106,6 +2413,27 @@ void World::UpdateSessions(uint32 diff)
     }
 }
 
+void World::QueueCliCommand(const CliCommandHolder* commandHolder)
+{
+    // SOAP and RA clients do not wait for the end of the world tick and for each other for these
+    CliHandler handler(commandHolder->m_cliAccountId, commandHolder->m_cliAccessLevel, commandHolder->m_print);
+    if (handler.IsConcurrentCommand(&commandHolder->m_command[0]))
+    {
+        DEBUG_LOG("CLI command executed concurrently...");
+
+        handler.ParseCommands(&commandHolder->m_command[0]);
+
+        if (commandHolder->m_commandFinished)
+            commandHolder->m_commandFinished(!handler.HasSentErrorMessage());
+
+        delete commandHolder;
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_cliCommandQueueLock);
+    m_cliCommandQueue.push_back(commandHolder);
+}
+
 // This handles the issued and queued CLI/RA commands
 void World::ProcessCliCommands()
 {
@@ -2130,6 +2458,15 @@ void World::ProcessCliCommands()
 
 void World::InitResultQueue()
 {
+    // character queries routed by account run with the owning session, on the map thread of its player in world
+    // the callbacks look the session up again themselves, for a session gone they are run here to free their results
+    CharacterDatabase.SetResultRouter([this](uint32 accountId, std::unique_ptr<MaNGOS::IQueryCallback> callback)
+    {
+        if (WorldSession* session = FindSession(accountId))
+            session->QueueQueryCallback(std::move(callback));
+        else
+            callback->Execute();
+    });
 }
 
 void World::UpdateResultQueue()
@@ -2361,6 +2698,7 @@ void World::ResetDailyQuests()
 {
     DETAIL_LOG("Daily quests reset for all characters.");
     CharacterDatabase.Execute("TRUNCATE character_queststatus_daily");
+    sCharacterLoginCache.Clear();
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
             itr->second->GetPlayer()->ResetDailyQuestStatus();
@@ -2375,6 +2713,7 @@ void World::ResetWeeklyQuests()
 {
     DETAIL_LOG("Weekly quests reset for all characters.");
     CharacterDatabase.Execute("TRUNCATE character_queststatus_weekly");
+    sCharacterLoginCache.Clear();
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
             itr->second->GetPlayer()->ResetWeeklyQuestStatus();
@@ -2390,6 +2729,7 @@ void World::ResetMonthlyQuests()
 {
     DETAIL_LOG("Monthly quests reset for all characters.");
     CharacterDatabase.Execute("TRUNCATE character_queststatus_monthly");
+    sCharacterLoginCache.Clear();
 
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
         if (itr->second->GetPlayer())
@@ -2615,6 +2955,8 @@ bool World::configNoReload(bool reload, eConfigBoolValues index, char const* fie
 
 void World::InvalidatePlayerDataToAllClient(ObjectGuid guid) const
 {
+    sObjectMgr.InvalidateNameQueryResponse(guid);
+
     WorldPacket data(SMSG_INVALIDATE_PLAYER, 8);
     data << guid;
     SendGlobalMessage(data);
@@ -2656,6 +2998,37 @@ void World::GeneratePacketMetrics()
         m_opcodeCounters[i] = 0;
     }
 
+    static char const* processingNames[] = { "inplace", "threadunsafe", "threadsafe", "map_thread", "immediate", "session_parallel" };
+    uint64 processingCount[countof(processingNames)] = {};
+    uint64 processingTotalUs[countof(processingNames)] = {};
+    LatencyHistogram::Snapshot handlerStats;
+    for (uint32 i = 0; i < NUM_MSG_TYPES; ++i)
+    {
+        if (!sOpcodeStats.GetSnapshot(i, OpcodeStats::RANGE_INTERVAL, handlerStats, true))
+            continue;
+
+        uint32 processing = opcodeTable[i].packetProcessing;
+        processingCount[processing] += handlerStats.count;
+        processingTotalUs[processing] += handlerStats.totalUs;
+
+        metric::measurement meas("world.metrics.packets.handler", { {"opcode", opcodeTable[i].name}, {"processing", processingNames[processing]} });
+        meas.add_field("count", std::to_string(handlerStats.count));
+        meas.add_field("total_us", std::to_string(handlerStats.totalUs));
+        meas.add_field("p50_us", std::to_string(handlerStats.Percentile(50.0)));
+        meas.add_field("p99_us", std::to_string(handlerStats.Percentile(99.0)));
+        meas.add_field("max_us", std::to_string(handlerStats.maxUs));
+    }
+
+    for (uint32 i = 0; i < countof(processingNames); ++i)
+    {
+        if (!processingCount[i])
+            continue;
+
+        metric::measurement meas("world.metrics.packets.processing", { {"processing", processingNames[i]} });
+        meas.add_field("count", std::to_string(processingCount[i]));
+        meas.add_field("total_us", std::to_string(processingTotalUs[i]));
+    }
+
     metric::measurement meas_players("world.metrics.players");
     meas_players.add_field("online", std::to_string(GetActiveSessionCount()));
     meas_players.add_field("unique", std::to_string(GetUniqueSessionCount()));
@@ -2688,6 +3061,111 @@ void World::GeneratePacketMetrics()
 
     metric::measurement meas_latency("world.metrics.latency");
     meas_latency.add_field("online", std::to_string(GetAverageLatency()));
+
+    uint64 socketWrites, socketWriteBytes;
+    MaNGOS::Socket::GetWriteStats(socketWrites, socketWriteBytes, true);
+    metric::measurement meas_network("world.metrics.network");
+    meas_network.add_field("writes", std::to_string(socketWrites));
+    meas_network.add_field("bytes", std::to_string(socketWriteBytes));
+    meas_network.add_field("bytes_per_write", std::to_string(socketWrites ? socketWriteBytes / socketWrites : 0));
+
+    uint64 compressedIn, compressedOut;
+    UpdateData::GetCompressionStats(compressedIn, compressedOut, true);
+    metric::measurement meas_compression("world.metrics.packets.compression", { {"level", std::to_string(getConfig(CONFIG_UINT32_COMPRESSION))} });
+    meas_compression.add_field("bytes_in", std::to_string(compressedIn));
+    meas_compression.add_field("bytes_out", std::to_string(compressedOut));
+
+    auto addPoolMeasurement = [](char const* type, MaNGOS::ObjectPoolStats const& stats)
+    {
+        metric::measurement meas_pool("world.metrics.object_pool", { {"type", type} });
+        meas_pool.add_field("in_use", std::to_string(stats.inUse));
+        meas_pool.add_field("cached", std::to_string(stats.cached));
+        meas_pool.add_field("system_allocations", std::to_string(stats.systemAllocations));
+        meas_pool.add_field("reuses", std::to_string(stats.reuses));
+        // share of pooled blocks idle in free lists
+        size_t total = stats.inUse + stats.cached;
+        meas_pool.add_field("idle_pct", std::to_string(total ? stats.cached * 100 / total : 0));
+    };
+    addPoolMeasurement("spell", Spell::GetPoolStats());
+    addPoolMeasurement("aura_holder", SpellAuraHolder::GetPoolStats());
+    addPoolMeasurement("aura", Aura::GetPoolStats());
+    addPoolMeasurement("movement_generator", MovementGenerator::GetPoolStats());
+
+    ByteBufferPoolStats bufferStats = ByteBufferPool::GetStats();
+    metric::measurement meas_buffers("world.metrics.packet_buffer_pool");
+    meas_buffers.add_field("acquires", std::to_string(bufferStats.acquires));
+    meas_buffers.add_field("reuses", std::to_string(bufferStats.reuses));
+    meas_buffers.add_field("releases", std::to_string(bufferStats.releases));
+    meas_buffers.add_field("dropped", std::to_string(bufferStats.dropped));
+    meas_buffers.add_field("cached_bytes", std::to_string(bufferStats.cachedBytes));
+    meas_buffers.add_field("reuse_pct", std::to_string(bufferStats.acquires ? bufferStats.reuses * 100 / bufferStats.acquires : 0));
+}
+
+void World::GenerateScriptProfileMetrics()
+{
+    std::vector<std::pair<ScriptProfiler::Key, LatencyHistogram::Snapshot>> snapshots;
+    sScriptProfiler.GetSnapshots(ScriptProfiler::RANGE_INTERVAL, snapshots, true);
+    for (auto const& entry : snapshots)
+    {
+        metric::measurement meas("world.metrics.scripts", {
+            { "script", sScriptDevAIMgr.GetScriptName(entry.first.scriptId) },
+            { "map_id", std::to_string(entry.first.mapId) },
+            { "hook", ScriptProfiler::GetHookName(entry.first.hook) }
+        });
+        meas.add_field("samples", std::to_string(entry.second.count));
+        meas.add_field("total_us", std::to_string(entry.second.totalUs));
+        meas.add_field("p50_us", std::to_string(entry.second.Percentile(50.0)));
+        meas.add_field("p99_us", std::to_string(entry.second.Percentile(99.0)));
+        meas.add_field("max_us", std::to_string(entry.second.maxUs));
+    }
+}
+
+void World::GenerateZoneStatsMetrics()
+{
+    ZoneStats::Snapshot snapshot;
+    sZoneStats.GetLastInterval(snapshot);
+    for (auto const& entry : snapshot)
+    {
+        metric::measurement meas("world.metrics.zones", {
+            { "map_id", std::to_string(entry.first.mapId) },
+            { "zone_id", std::to_string(entry.first.zoneId) },
+            { "area_id", std::to_string(entry.first.areaId) }
+        });
+        for (uint32 i = 0; i < ZONE_STATS_CATEGORY_COUNT; ++i)
+            meas.add_field(std::string(ZoneStats::GetCategoryName(ZoneStatsCategory(i))) + "_us", std::to_string(entry.second.us[i]));
+        meas.add_field("packets", std::to_string(entry.second.packets));
+        meas.add_field("bytes", std::to_string(entry.second.bytes));
+    }
+}
+
+void World::GenerateAllocStatsMetrics()
+{
+    AllocStatsCounters counters;
+    sAllocStats.GetLastInterval(counters);
+    for (uint32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+    {
+        metric::measurement meas("world.metrics.allocations", {
+            { "tag", AllocStats::GetTagName(AllocTag(i)) },
+            { "allocator", AllocStats::GetAllocatorName() }
+        });
+        meas.add_field("count", std::to_string(counters.count[i]));
+        meas.add_field("bytes", std::to_string(counters.bytes[i]));
+    }
+}
+
+void World::GenerateDatabaseMetrics()
+{
+    std::pair<char const*, Database*> databases[] = { {"world", &WorldDatabase}, {"character", &CharacterDatabase}, {"login", &LoginDatabase}, {"logs", &LogsDatabase} };
+    std::vector<uint32> queueSizes;
+    for (auto const& database : databases)
+    {
+        database.second->GetAsyncQueueSizes(queueSizes);
+        for (uint32 i = 0; i < queueSizes.size(); ++i)
+        {
+            metric::measurement meas("world.metrics.database.async", { {"database", database.first}, {"connection", std::to_string(i)} });
+            meas.add_field("queue", std::to_string(queueSizes[i]));
+        }
+    }
 }
 
 uint32 World::GetAverageLatency() const
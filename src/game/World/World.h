@@ -36,6 +36,7 @@
 #include <list>
 #include <deque>
 #include <mutex>
+#include <memory>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -48,6 +49,7 @@ class WorldSession;
 class Player;
 class QueryResult;
 class WorldSocket;
+class MapUpdater;
 
 // ServerMessages.dbc
 enum ServerMessageType
@@ -84,7 +86,10 @@ enum WorldTimers
     WUPDATE_GROUPS      = 6,
     WUPDATE_WARDEN      = 7, // This is here for headache merge error issues
     WUPDATE_METRICS     = 8, // not used if BUILD_METRICS is not set
-    WUPDATE_COUNT       = 9
+    WUPDATE_WHOLIST     = 9,
+    WUPDATE_ZONESTATS   = 10,
+    WUPDATE_GUILDDATA   = 11,
+    WUPDATE_COUNT       = 12
 };
 
 /// Configuration elements
@@ -93,6 +98,10 @@ enum eConfigUInt32Values
     CONFIG_UINT32_COMPRESSION = 0,
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
+    CONFIG_UINT32_GRID_UNLOAD_TIME_BUDGET,
+    CONFIG_UINT32_GRID_PREFETCH_TIME,
+    CONFIG_UINT32_GRID_PREFETCH_THREADS,
+    CONFIG_UINT32_TAXI_POSITION_UPDATE_INTERVAL,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
@@ -117,6 +126,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_START_ARENA_POINTS,
     CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR,
     CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,
+    CONFIG_UINT32_INSTANCE_TERRAIN_KEEP_ALIVE,
+    CONFIG_UINT32_INSTANCE_DATA_SAVE_INTERVAL,
     CONFIG_UINT32_MAX_SPELL_CASTS_IN_CHAIN,
     CONFIG_UINT32_RABBIT_DAY,
     CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL,
@@ -138,10 +149,24 @@ enum eConfigUInt32Values
     CONFIG_UINT32_START_GM_LEVEL,
     CONFIG_UINT32_GM_INVISIBLE_AURA,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
+    CONFIG_UINT32_MAIL_UNLOAD_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_MASS_MAILER_WRITES_PER_SECOND,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_NUM_MAP_THREADS,
+    CONFIG_UINT32_NUM_MAP_CELL_THREADS,
+    CONFIG_UINT32_NUM_SESSION_THREADS,
+    CONFIG_UINT32_NUM_LOAD_THREADS,
+    CONFIG_UINT32_SCRIPT_PROFILE_SAMPLE_RATE,
+    CONFIG_UINT32_ZONE_STATS_SAMPLE_RATE,
+    CONFIG_UINT32_WATCHDOG_SLOW_TICK_THRESHOLD,
+    CONFIG_UINT32_EVENT_SPAWN_BUDGET,
+    CONFIG_UINT32_PATH_FIND_CACHE_LIFETIME,
+    CONFIG_UINT32_VMAP_QUERY_CACHE_ENTRIES,
+    CONFIG_UINT32_NETWORK_FLUSH_DELAY,
+    CONFIG_UINT32_NETWORK_FLUSH_BYTES,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
+    CONFIG_UINT32_AUCTION_SEARCH_THREADS,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
     CONFIG_UINT32_SKILL_CHANCE_GREEN,
@@ -163,6 +188,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_QUEST_DAILY_RESET_HOUR,
     CONFIG_UINT32_QUEST_WEEKLY_RESET_WEEK_DAY,
     CONFIG_UINT32_QUEST_WEEKLY_RESET_HOUR,
+    CONFIG_UINT32_QUESTGIVER_STATUS_CACHE_TIME,
     CONFIG_UINT32_CHAT_STRICT_LINK_CHECKING_SEVERITY,
     CONFIG_UINT32_CHAT_STRICT_LINK_CHECKING_KICK,
     CONFIG_UINT32_CHANNEL_RESTRICTED_LANGUAGE_MODE,
@@ -184,6 +210,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GROUP_OFFLINE_LEADER_DELAY,
     CONFIG_UINT32_GUILD_EVENT_LOG_COUNT,
     CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT,
+    CONFIG_UINT32_GUILD_DATA_UNLOAD_DELAY,
     CONFIG_UINT32_MIRRORTIMER_FATIGUE_MAX,
     CONFIG_UINT32_MIRRORTIMER_BREATH_MAX,
     CONFIG_UINT32_MIRRORTIMER_ENVIRONMENTAL_MAX,
@@ -191,6 +218,11 @@ enum eConfigUInt32Values
     CONFIG_UINT32_ENVIRONMENTAL_DAMAGE_MAX,
     CONFIG_UINT32_INTERACTION_PAUSE_TIMER,
     CONFIG_UINT32_MIN_LEVEL_STAT_SAVE,
+    CONFIG_UINT32_LOGIN_CACHE_SIZE,
+    CONFIG_UINT32_LOGIN_CACHE_TTL,
+    CONFIG_UINT32_PLAYER_SAVE_MAX_ASYNC_QUEUE,
+    CONFIG_UINT32_INTERVAL_SAVE_VALUABLE,
+    CONFIG_UINT32_MMAP_TILE_MEMORY_LIMIT,
     CONFIG_UINT32_CHARDELETE_KEEP_DAYS,
     CONFIG_UINT32_CHARDELETE_METHOD,
     CONFIG_UINT32_CHARDELETE_MIN_LEVEL,
@@ -198,10 +230,15 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY,
     CONFIG_UINT32_CREATURE_CHECK_FOR_HELP_AGGRO_DELAY,
+    CONFIG_UINT32_CREATURE_HIBERNATE_INTERVAL,
     CONFIG_UINT32_MAX_WHOLIST_RETURNS,
+    CONFIG_UINT32_WHOLIST_INDEX_INTERVAL,
     CONFIG_UINT32_FOGOFWAR_STEALTH,
     CONFIG_UINT32_FOGOFWAR_HEALTH,
     CONFIG_UINT32_FOGOFWAR_STATS,
+    CONFIG_UINT32_VISIBILITY_FULL_SWEEP_INTERVAL,
+    CONFIG_UINT32_RELOCATION_NOTIFY_BUDGET,
+    CONFIG_UINT32_VISIBILITY_LOW_DETAIL_UPDATE_TICKS,
     CONFIG_UINT32_CREATURE_PICKPOCKET_RESTOCK_DELAY,
     CONFIG_UINT32_CHANNEL_STATIC_AUTO_TRESHOLD,
     CONFIG_UINT32_MAX_RECRUIT_A_FRIEND_BONUS_PLAYER_LEVEL,
@@ -290,7 +327,11 @@ enum eConfigFloatValues
     CONFIG_FLOAT_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_FAMILY_ASSISTANCE_RADIUS,
     CONFIG_FLOAT_CREATURE_CHECK_FOR_HELP_RADIUS,
+    CONFIG_FLOAT_CREATURE_HIBERNATE_DISTANCE,
+    CONFIG_FLOAT_VISIBILITY_FULL_DETAIL_DISTANCE,
+    CONFIG_FLOAT_VISIBILITY_COMBAT_LOG_RANGE,
     CONFIG_FLOAT_GROUP_XP_DISTANCE,
+    CONFIG_FLOAT_VMAP_QUERY_CACHE_STEP,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
     CONFIG_FLOAT_LEASH_RADIUS,
@@ -340,6 +381,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_CHAT_STRICT_LINK_CHECKING_KICK,
     CONFIG_BOOL_ADDON_CHANNEL,
     CONFIG_BOOL_CORPSE_EMPTY_LOOT_SHOW,
+    CONFIG_BOOL_CORPSE_DEFERRED_LOOT,
     CONFIG_BOOL_CORPSE_ALLOW_ALL_ITEMS_SHOW_IN_MASTER_LOOT,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVP,
     CONFIG_BOOL_DEATH_CORPSE_RECLAIM_DELAY_PVE,
@@ -365,17 +407,28 @@ enum eConfigBoolValues
     CONFIG_BOOL_OUTDOORPVP_TF_ENABLED,
     CONFIG_BOOL_OUTDOORPVP_NA_ENABLED,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
+    CONFIG_BOOL_NETWORK_FLUSH_LATENCY_CRITICAL,
+    CONFIG_BOOL_NETWORK_BATCH_MONSTER_MOVES,
+    CONFIG_BOOL_NETWORK_AGGREGATE_COMBAT_LOG,
+    CONFIG_BOOL_OPCODE_STATS,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
+    CONFIG_BOOL_PLAYER_SAVE_SPREAD,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
     CONFIG_BOOL_VMAP_INDOOR_CHECK,
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_PET_ATTACK_FROM_BEHIND,
     CONFIG_BOOL_AUTO_DOWNRANK,
     CONFIG_BOOL_MMAP_ENABLED,
+    CONFIG_BOOL_MMAP_MAPPED_TILES,
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_AUTOLOAD_ACTIVE,
+    CONFIG_BOOL_TAXI_LOAD_GRIDS,
     CONFIG_BOOL_PATH_FIND_OPTIMIZE,
     CONFIG_BOOL_PATH_FIND_NORMALIZE_Z,
+    CONFIG_BOOL_VISIBILITY_BROADCAST_TO_OBSERVERS,
+    CONFIG_BOOL_MAPUPDATE_STICKY_MAPS,
+    CONFIG_BOOL_MAPUPDATE_STATE_SNAPSHOT,
+    CONFIG_BOOL_ALLOC_STATS_ENABLED,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -567,6 +620,7 @@ class World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+        void UpdateBesideMaps();
 
         /// Get a server configuration element (see #eConfigFloatValues)
         void setConfig(eConfigFloatValues index, float value) { m_configFloatValues[index] = value; }
@@ -590,6 +644,8 @@ class World
 
         /// Get configuration about force-loaded maps
         bool isForceLoadMap(uint32 id) const { return m_configForceLoadMapIds.find(id) != m_configForceLoadMapIds.end(); }
+        /// Get configuration about maps caching line of sight and height queries, empty list means all maps
+        bool isQueryCacheMap(uint32 id) const { return m_configQueryCacheMapIds.empty() || m_configQueryCacheMapIds.find(id) != m_configQueryCacheMapIds.end(); }
 
         /// Are we on a "Player versus Player" server?
         bool IsPvPRealm() const { return (getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_PVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_RPPVP || getConfig(CONFIG_UINT32_GAME_TYPE) == REALM_TYPE_FFA_PVP); }
@@ -611,7 +667,8 @@ class World
         static uint32 GetRelocationAINotifyDelay() { return m_relocation_ai_notify_delay; }
 
         void ProcessCliCommands();
-        void QueueCliCommand(const CliCommandHolder* commandHolder) { std::lock_guard<std::mutex> guard(m_cliCommandQueueLock); m_cliCommandQueue.push_back(commandHolder); }
+        // any thread, read only commands are executed by the calling thread, the others by the world thread
+        void QueueCliCommand(const CliCommandHolder* commandHolder);
 
         void UpdateResultQueue();
         void InitResultQueue();
@@ -645,6 +702,8 @@ class World
         static uint32 GetCurrentMSTime() { return m_currentMSTime; }
         static TimePoint GetCurrentClockTime() { return m_currentTime; }
         static uint32 GetCurrentDiff() { return m_currentDiff; }
+        /// Advances the clocks above, done by Update, for mangos-bench running maps without the world
+        static void UpdateClocks(uint32 diff);
 
         template<typename T>
         void ExecuteForAllSessions(T executor)
@@ -679,6 +738,10 @@ class World
         void ResetMonthlyQuests();
 #ifdef BUILD_METRICS
         void GeneratePacketMetrics(); // thread safe due to atomics
+        void GenerateDatabaseMetrics();
+        void GenerateScriptProfileMetrics();
+        void GenerateZoneStatsMetrics();
+        void GenerateAllocStatsMetrics();
         uint32 GetAverageLatency() const;
 #endif
 
@@ -713,6 +776,8 @@ class World
         typedef std::unordered_map<uint32, WorldSession*> SessionMap;
         typedef std::unordered_set<uint32> UniqueSessions;
         SessionMap m_sessions;
+        std::unique_ptr<MapUpdater> m_sessionUpdater;      // runs UpdateParallel of the sessions, see SessionUpdate.Threads
+        std::vector<WorldSession*> m_parallelSessions;
         UniqueSessions m_uniqueSessionCount;
         uint32 m_maxActiveSessionCount;
         uint32 m_maxQueuedSessionCount;
@@ -763,6 +828,9 @@ class World
         // List of Maps that should be force-loaded on startup
         std::set<uint32> m_configForceLoadMapIds;
 
+        // List of Maps that cache line of sight and height query results
+        std::set<uint32> m_configQueryCacheMapIds;
+
         // Vector of quests that were chosen for given group
         std::vector<uint32> m_eventGroupChosen;
 
@@ -110,7 +110,7 @@ std::vector<std::pair<WorldStateID, uint32>> aqWorldStateTotalsMap =
 };
 
 WorldState::WorldState() : m_emeraldDragonsState(0xF), m_emeraldDragonsTimer(0), m_emeraldDragonsChosenPositions(4, 0), m_isMagtheridonHeadSpawnedHorde(false), m_isMagtheridonHeadSpawnedAlliance(false),
-    m_adalSongOfBattleTimer(0), m_expansion(EXPANSION_TBC), m_highlordKruulSpawned(false), m_highlordKruulTimer(0), m_highlordKruulChosenPosition(0)
+    m_saveTimer(WORLD_STATE_SAVE_INTERVAL), m_pendingSaves(0), m_adalSongOfBattleTimer(0), m_expansion(EXPANSION_TBC), m_highlordKruulSpawned(false), m_highlordKruulTimer(0), m_highlordKruulChosenPosition(0)
 {
     m_transportStates[GROMGOL_UNDERCITY]    = GROMGOLUC_EVENT_1;
     m_transportStates[GROMGOL_ORGRIMMAR]    = OGUC_EVENT_1;
@@ -312,6 +312,8 @@ void WorldState::Load()
 
 void WorldState::Save(SaveIds saveId)
 {
+    m_pendingSaves &= ~(1 << saveId);
+
     switch (saveId)
     {
         case SAVE_ID_EMERALD_DRAGONS:
@@ -377,6 +379,47 @@ void WorldState::SaveHelper(std::string& stringToSave, SaveIds saveId)
     CharacterDatabase.PExecute("INSERT INTO world_state(Id,Data) VALUES('%u','%s')", saveId, stringToSave.data());
 }
 
+void WorldState::SavePending()
+{
+    uint32 pending = m_pendingSaves.exchange(0);
+    if (!pending)
+        return;
+
+    CharacterDatabase.BeginTransaction();
+    for (uint32 saveId = 0; saveId < 32; ++saveId)
+    {
+        if ((pending & (1 << saveId)) == 0)
+            continue;
+
+        // the data is changed under these locks
+        switch (saveId)
+        {
+            case SAVE_ID_AHN_QIRAJ:
+            {
+                std::lock_guard<std::mutex> guard(m_aqData.m_warEffortMutex);
+                Save(SaveIds(saveId));
+                break;
+            }
+            case SAVE_ID_LOVE_IS_IN_THE_AIR:
+            {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                Save(SaveIds(saveId));
+                break;
+            }
+            case SAVE_ID_SCOURGE_INVASION:
+            {
+                std::lock_guard<std::mutex> guard(m_siData.m_siMutex);
+                Save(SaveIds(saveId));
+                break;
+            }
+            default:
+                Save(SaveIds(saveId));
+                break;
+        }
+    }
+    CharacterDatabase.CommitTransaction();
+}
+
 void WorldState::HandleGameObjectUse(GameObject* go, Unit* user)
 {
     switch (go->GetEntry())
@@ -818,7 +861,7 @@ void WorldState::HandleExternalEvent(uint32 eventId, uint32 param)
         {
             MANGOS_ASSERT(param < LOVE_LEADER_MAX);
             ++m_loveIsInTheAirData.counters[param];
-            Save(SAVE_ID_LOVE_IS_IN_THE_AIR);
+            SaveLater(SAVE_ID_LOVE_IS_IN_THE_AIR);
             break;
         }
         case CUSTOM_EVENT_ADALS_SONG_OF_BATTLE:
@@ -830,6 +873,15 @@ void WorldState::HandleExternalEvent(uint32 eventId, uint32 param)
 
 void WorldState::Update(const uint32 diff)
 {
+    SendPendingWorldstates();
+
+    if (m_saveTimer <= diff)
+    {
+        m_saveTimer = WORLD_STATE_SAVE_INTERVAL;
+        SavePending();
+    }
+    else m_saveTimer -= diff;
+
     std::lock_guard<std::mutex> guard(m_mutex);
 
     if (m_adalSongOfBattleTimer)
@@ -897,10 +949,38 @@ void WorldState::Update(const uint32 diff)
 
 void WorldState::SendWorldstateUpdate(std::mutex& mutex, GuidVector const& guids, uint32 value, uint32 worldStateId)
 {
-    std::lock_guard<std::mutex> guard(mutex);
-    for (ObjectGuid const& guid : guids)
-        if (Player* player = sObjectMgr.GetPlayer(guid))
-            player->SendUpdateWorldState(worldStateId, value);
+    std::lock_guard<std::mutex> guard(m_pendingWorldstatesMutex);
+    for (PendingWorldstate& pending : m_pendingWorldstates)
+    {
+        if (pending.guids == &guids && pending.worldStateId == worldStateId)
+        {
+            pending.value = value;
+            return;
+        }
+    }
+
+    m_pendingWorldstates.push_back({ &mutex, &guids, worldStateId, value });
+}
+
+void WorldState::SendPendingWorldstates()
+{
+    std::vector<PendingWorldstate> pendingWorldstates;
+    {
+        std::lock_guard<std::mutex> guard(m_pendingWorldstatesMutex);
+        pendingWorldstates.swap(m_pendingWorldstates);
+    }
+
+    for (PendingWorldstate const& pending : pendingWorldstates)
+    {
+        WorldPacket data(SMSG_UPDATE_WORLD_STATE, 8);
+        data << pending.worldStateId;
+        data << pending.value;
+
+        std::lock_guard<std::mutex> guard(*pending.mutex);
+        for (ObjectGuid const& guid : *pending.guids)
+            if (Player* player = sObjectMgr.GetPlayer(guid))
+                player->GetSession()->SendPacket(data);
+    }
 }
 
 void WorldState::BuffAdalsSongOfBattle()
@@ -1018,10 +1098,8 @@ void WorldState::AddWarEffortProgress(AQResources resource, uint32 count)
     if (m_aqData.m_phase != PHASE_1_GATHERING_RESOURCES)
         return;
     m_aqData.m_WarEffortCounters[resource] += count;
-    Save(SAVE_ID_AHN_QIRAJ);
-    for (ObjectGuid& guid : m_aqData.m_warEffortWorldstatesPlayers)
-        if (Player* player = sObjectMgr.GetPlayer(guid))
-            player->SendUpdateWorldState(aqWorldstateMap[resource], m_aqData.m_WarEffortCounters[resource]);
+    SaveLater(SAVE_ID_AHN_QIRAJ);
+    SendWorldstateUpdate(m_aqData.m_warEffortMutex, m_aqData.m_warEffortWorldstatesPlayers, m_aqData.m_WarEffortCounters[resource], aqWorldstateMap[resource]);
     uint32 id = uint32(resource);
     if (id >= aqWorldStateTotalsMap.size())
         id -= 5;
@@ -1588,7 +1666,7 @@ void WorldState::SetSIRemaining(SIRemaining remaining, uint32 value)
 {
     std::lock_guard<std::mutex> guard(m_siData.m_siMutex);
     m_siData.m_remaining[remaining] = value;
-    Save(SAVE_ID_SCOURGE_INVASION);
+    SaveLater(SAVE_ID_SCOURGE_INVASION);
 }
 
 TimePoint WorldState::GetSITimer(SITimers timer)
@@ -1612,7 +1690,7 @@ void WorldState::AddBattlesWon(int32 count)
     std::lock_guard<std::mutex> guard(m_siData.m_siMutex);
     m_siData.m_battlesWon += count;
     HandleDefendedZones();
-    Save(SAVE_ID_SCOURGE_INVASION);
+    SaveLater(SAVE_ID_SCOURGE_INVASION);
 }
 
 uint32 WorldState::GetLastAttackZone()
@@ -2223,7 +2301,7 @@ void WorldState::AddSunsReachProgress(uint32 questId)
         }
     }
     if (save)
-        Save(SAVE_ID_QUEL_DANAS);
+        SaveLater(SAVE_ID_QUEL_DANAS);
 }
 
 void WorldState::AddSunwellGateProgress(uint32 questId)
@@ -2281,7 +2359,7 @@ void WorldState::AddSunwellGateProgress(uint32 questId)
         }
     }
     if (save)
-        Save(SAVE_ID_QUEL_DANAS);
+        SaveLater(SAVE_ID_QUEL_DANAS);
 }
 
 void WorldState::HandleSunsReachPhaseTransition(uint32 newPhase)
@@ -143,6 +143,8 @@ enum SaveIds
     SAVE_ID_HIGHLORD_KRUUL = 22,
 };
 
+#define WORLD_STATE_SAVE_INTERVAL (5 * IN_MILLISECONDS)     // progress saved with SaveLater is written at most this late
+
 enum GameEvents
 {
     GAME_EVENT_GURUBASHI_ARENA = 16,
@@ -470,6 +472,9 @@ class WorldState
         void Load();
         void Save(SaveIds saveId);
         void SaveHelper(std::string& stringToSave, SaveIds saveId);
+        // for frequent progress, saved with the other pending ids in one transaction every WORLD_STATE_SAVE_INTERVAL
+        void SaveLater(SaveIds saveId) { m_pendingSaves |= 1 << saveId; }
+        void SavePending();
 
         // Called when a gameobject is created or removed
         void HandleGameObjectUse(GameObject* go, Unit* user);
@@ -490,6 +495,7 @@ class WorldState
 
         void Update(const uint32 diff);
 
+        // sent at the next update with the last value queued for the world state of these players
         void SendWorldstateUpdate(std::mutex& mutex, GuidVector const& guids, uint32 value, uint32 worldStateId);
 
         // vanilla section
@@ -605,6 +611,19 @@ class WorldState
 
         std::mutex m_mutex; // all World State operations are thread unsafe
         uint32 m_saveTimer;
+        std::atomic<uint32> m_pendingSaves;                 // mask of SaveIds
+
+        struct PendingWorldstate
+        {
+            std::mutex* mutex;                              // guards guids
+            GuidVector const* guids;
+            uint32 worldStateId;
+            uint32 value;
+        };
+        void SendPendingWorldstates();
+
+        std::vector<PendingWorldstate> m_pendingWorldstates;
+        std::mutex m_pendingWorldstatesMutex;
 
         // vanilla section
         bool IsDragonSpawned(uint32 entry);
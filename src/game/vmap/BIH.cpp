@@ -260,27 +260,26 @@ bool BIH::writeToFile(FILE* wf) const
     check += fwrite(&bounds.low(), sizeof(float), 3, wf);
     check += fwrite(&bounds.high(), sizeof(float), 3, wf);
     check += fwrite(&treeSize, sizeof(uint32), 1, wf);
-    check += fwrite(&tree[0], sizeof(uint32), treeSize, wf);
+    check += fwrite(tree.data(), sizeof(uint32), treeSize, wf);
     check += fwrite(&count, sizeof(uint32), 1, wf);
-    check += fwrite(&objects[0], sizeof(uint32), count, wf);
+    check += fwrite(objects.data(), sizeof(uint32), count, wf);
     return check == (3 + 3 + 2 + treeSize + count);
 }
 
-bool BIH::readFromFile(FILE* rf)
+bool BIH::readFromFile(FILE* rf, ModelFileMapping const* mapping)
 {
-    uint32 treeSize;
+    uint32 treeSize = 0;
     Vector3 lo, hi;
     uint32 check = 0, count = 0;
     check += fread(&lo, sizeof(float), 3, rf);
     check += fread(&hi, sizeof(float), 3, rf);
     bounds = AABox(lo, hi);
     check += fread(&treeSize, sizeof(uint32), 1, rf);
-    tree.resize(treeSize);
-    check += fread(&tree[0], sizeof(uint32), treeSize, rf);
-    check += fread(&count, sizeof(uint32), 1, rf);
-    objects.resize(count); // = new uint32[nObjects];
-    check += fread(&objects[0], sizeof(uint32), count, rf);
-    return check == (3 + 3 + 2 + treeSize + count);
+    if (check != 3 + 3 + 1 || !tree.read(rf, treeSize, mapping))
+        return false;
+    if (fread(&count, sizeof(uint32), 1, rf) != 1)
+        return false;
+    return objects.read(rf, count, mapping);
 }
 
 void BIH::BuildStats::updateLeaf(int depth, int n)
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdio>
 
 #define MAX_STACK_SIZE 64
 
@@ -61,6 +62,80 @@ struct AABound
     Vector3 lo, hi;
 };
 
+/// A model file mapped read only, see vmap.mappedModels
+struct ModelFileMapping
+{
+    char const* data;
+    size_t size;
+};
+
+/// Array either owning its elements or pointing into a mapped model file, the mapping must outlive it
+template<typename T>
+class ModelArray
+{
+    public:
+        ModelArray() : m_data(nullptr), m_size(0) {}
+        ModelArray(ModelArray const& other) : m_owned(other.m_owned), m_data(other.m_data), m_size(other.m_size)
+        {
+            if (!other.m_owned.empty())
+                m_data = m_owned.data();
+        }
+        ModelArray& operator=(ModelArray const& other)
+        {
+            if (this != &other)
+            {
+                m_owned = other.m_owned;
+                m_data = other.m_owned.empty() ? other.m_data : m_owned.data();
+                m_size = other.m_size;
+            }
+            return *this;
+        }
+
+        T const& operator[](size_t i) const { return m_data[i]; }
+        T const* data() const { return m_data; }
+        T const* begin() const { return m_data; }
+        T const* end() const { return m_data + m_size; }
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+
+        /// Takes over the elements, values is left with the old ones
+        void swap(std::vector<T>& values)
+        {
+            m_owned.swap(values);
+            m_data = m_owned.data();
+            m_size = m_owned.size();
+        }
+
+        /// Reads count elements, points into mapping instead when the file offset allows it
+        bool read(FILE* rf, uint32 count, ModelFileMapping const* mapping)
+        {
+            if (mapping)
+            {
+                long pos = ftell(rf);
+                if (pos >= 0 && pos % alignof(T) == 0)
+                {
+                    if (size_t(pos) + size_t(count) * sizeof(T) > mapping->size)
+                        return false;
+                    m_owned.clear();
+                    m_data = reinterpret_cast<T const*>(mapping->data + pos);
+                    m_size = count;
+                    return fseek(rf, long(count * sizeof(T)), SEEK_CUR) == 0;
+                }
+            }
+
+            std::vector<T> values(count);
+            if (count && fread(values.data(), sizeof(T), count, rf) != count)
+                return false;
+            swap(values);
+            return true;
+        }
+
+    private:
+        std::vector<T> m_owned;
+        T const* m_data;
+        size_t m_size;
+};
+
 /** Bounding Interval Hierarchy Class.
     Building and Ray-Intersection functions based on BIH from
     Sunflow, a Java Raytracer, released under MIT/X11 License
@@ -73,11 +148,12 @@ class BIH
     private:
         void init_empty()
         {
-            tree.clear();
-            objects.clear();
+            std::vector<uint32> emptyTree, emptyObjects;
             // create space for the first node
-            tree.push_back(static_cast<uint32>(3 << 30)); // dummy leaf
-            tree.insert(tree.end(), 2, 0);
+            emptyTree.push_back(static_cast<uint32>(3 << 30)); // dummy leaf
+            emptyTree.insert(emptyTree.end(), 2, 0);
+            tree.swap(emptyTree);
+            objects.swap(emptyObjects);
         }
 
     public:
@@ -108,11 +184,9 @@ class BIH
             if (printStats)
                 stats.printStats();
 
-            objects.resize(dat.numPrims);
-            for (uint32 i = 0; i < dat.numPrims; ++i)
-                objects[i] = dat.indices[i];
-            // nObjects = dat.numPrims;
-            tree = tempTree;
+            std::vector<uint32> tempObjects(dat.indices, dat.indices + dat.numPrims);
+            objects.swap(tempObjects);
+            tree.swap(tempTree);
             delete[] dat.primBound;
             delete[] dat.indices;
         }
@@ -259,6 +333,82 @@ class BIH
             }
         }
 
+        // calls back every object of the leaves overlapping box, a ray packet uses it to walk the tree once
+        template<typename BoxCallback>
+        void intersectBox(const AABox& box, BoxCallback& boxCallback) const
+        {
+            if (!bounds.intersects(box))
+                return;
+
+            const Vector3& lo = box.low();
+            const Vector3& hi = box.high();
+
+            StackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+
+            while (true)
+            {
+                while (true)
+                {
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    const bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node
+                            float tl = intBitsToFloat(tree[node + 1]);
+                            float tr = intBitsToFloat(tree[node + 2]);
+                            bool left = lo[axis] <= tl;
+                            bool right = hi[axis] >= tr;
+                            // box is between clip zones
+                            if (!left && !right)
+                                break;
+                            node = left ? offset : offset + 3;
+                            // box overlaps both nodes, push back right node
+                            if (left && right)
+                            {
+                                stack[stackPos].node = offset + 3;
+                                ++stackPos;
+                            }
+                        }
+                        else
+                        {
+                            // leaf - report its objects
+                            int n = tree[node + 1];
+                            while (n > 0)
+                            {
+                                boxCallback(objects[offset]);
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else // BVH2 node (empty space cut off left and right)
+                    {
+                        if (axis > 2)
+                            return; // should not happen
+                        float tl = intBitsToFloat(tree[node + 1]);
+                        float tr = intBitsToFloat(tree[node + 2]);
+                        node = offset;
+                        if (tl > hi[axis] || tr < lo[axis])
+                            break;
+                    }
+                } // traversal loop
+
+                // stack is empty?
+                if (stackPos == 0)
+                    return;
+                // move back up the stack
+                --stackPos;
+                node = stack[stackPos].node;
+            }
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const Vector3& p, IsectCallback& intersectCallback) const
         {
@@ -340,11 +490,11 @@ class BIH
         }
 
         bool writeToFile(FILE* wf) const;
-        bool readFromFile(FILE* rf);
+        bool readFromFile(FILE* rf, ModelFileMapping const* mapping = nullptr);
 
     protected:
-        std::vector<uint32> tree;
-        std::vector<uint32> objects;
+        ModelArray<uint32> tree;
+        ModelArray<uint32> objects;
         AABox bounds;
 
         struct buildData
@@ -22,6 +22,11 @@
 #include <string>
 #include <Platform/Define.h>
 
+namespace G3D
+{
+    class Vector3;
+}
+
 //===========================================================
 
 /**
@@ -46,9 +51,10 @@ namespace VMAP
         private:
             bool iEnableLineOfSightCalc;
             bool iEnableHeightCalc;
+            bool iMappedModels;
 
         public:
-            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true) {}
+            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true), iMappedModels(false) {}
 
             virtual ~IVMapManager(void) {}
 
@@ -60,6 +66,8 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) = 0;
+            // line of sight from one origin to up to 64 targets, bit i of the result set when targets[i] is visible
+            virtual uint64 isInLineOfSight(unsigned int pMapId, G3D::Vector3 const& origin, G3D::Vector3 const* targets, uint32 count, bool ignoreM2Model) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx,ry,rz will hold the hit position or the dest position, if no intersection was found
@@ -81,10 +89,15 @@ namespace VMAP
             It is enabled by default. If it is enabled in mid game the maps have to loaded manualy
             */
             void setEnableHeightCalc(bool pVal) { iEnableHeightCalc = pVal; }
+            /**
+            Map the model files read only instead of reading them, only affects models loaded afterwards
+            */
+            void setMappedModels(bool pVal) { iMappedModels = pVal; }
 
             bool isLineOfSightCalcEnabled() const { return iEnableLineOfSightCalc; }
             bool isHeightCalcEnabled() const { return iEnableHeightCalc; }
             bool isMapLoadingEnabled() const { return iEnableLineOfSightCalc || iEnableHeightCalc; }
+            bool isModelMappingEnabled() const { return iMappedModels; }
 
             virtual std::string getDirFileName(unsigned int pMapId, int x, int y) const = 0;
             virtual bool IsTileLoaded(uint32 mapId, uint32 x, uint32 y) const = 0;
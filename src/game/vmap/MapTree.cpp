@@ -164,6 +164,59 @@ namespace VMAP
         return !getIntersectionTime(ray, maxDist, true, ignoreM2Model);
     }
     //=========================================================
+
+    uint64 StaticMapTree::isInLineOfSight(const Vector3& origin, const Vector3* targets, uint32 count, bool ignoreM2Model) const
+    {
+        MANGOS_ASSERT(count <= 64);
+        uint64 visible = count == 64 ? ~uint64(0) : (uint64(1) << count) - 1;
+
+        // all rays start at origin, so the box around origin and targets holds every segment
+        G3D::AABox box(origin);
+        for (uint32 i = 0; i < count; ++i)
+            box.merge(targets[i]);
+
+        // walk the tree once for the whole packet instead of once per ray
+        std::vector<uint32> candidates;
+        auto collector = [&candidates](uint32 entry) { candidates.push_back(entry); };
+        iTree.intersectBox(box, collector);
+        if (candidates.empty())
+            return visible;
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        G3D::Ray rays[64];
+        float dists[64];
+        for (uint32 i = 0; i < count; ++i)
+        {
+            dists[i] = (targets[i] - origin).magnitude();
+            MANGOS_ASSERT(dists[i] < std::numeric_limits<float>::max());
+            // prevent NaN values, a target on the origin is always visible
+            if (dists[i] < 1e-10f)
+                continue;
+            rays[i] = G3D::Ray::fromOriginAndDirection(origin, (targets[i] - origin) / dists[i]);
+        }
+
+        // one model at a time so its tree stays in cache for all rays still unblocked
+        for (uint32 entry : candidates)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                if (!(visible & (uint64(1) << i)) || dists[i] < 1e-10f)
+                    continue;
+
+                float distance = dists[i];
+                if (iTreeValues[entry].intersectRay(rays[i], distance, true, ignoreM2Model))
+                    visible &= ~(uint64(1) << i);
+            }
+
+            if (!visible)
+                break;
+        }
+
+        return visible;
+    }
+    //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
@@ -24,6 +24,8 @@
 #include <set>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -58,6 +60,8 @@ namespace VMAP
         iFilterMethod = nullptr;
         iSrcDir = pSrcDirName;
         iDestDir = pDestDirName;
+        iThreads = 0;
+        iRebuild = false;
         // mkdir(iDestDir);
         // init();
     }
@@ -67,143 +71,262 @@ namespace VMAP
         // delete iCoordModelMapping;
     }
 
+    // runs task(0) .. task(count - 1) on up to threads threads, the calling one included
+    template<class Task>
+    void runParallel(uint32 threads, size_t count, Task task)
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&]()
+        {
+            for (size_t i = next++; i < count; i = next++)
+                task(i);
+        };
+
+        std::vector<std::thread> workers;
+        for (uint32 i = 1; i < threads && i < count; ++i)
+            workers.emplace_back(worker);
+        worker();
+        for (auto& thread : workers)
+            thread.join();
+    }
+
+    // FNV-1a over the file content, seeded with the vmap magic so a format change converts everything again
+    static bool hashFile(const std::string& filename, uint64& hash)
+    {
+        FILE* rf = fopen(filename.c_str(), "rb");
+        if (!rf)
+            return false;
+
+        hash = 14695981039346656037ULL;
+        for (const char* c = VMAP_MAGIC; *c; ++c)
+            hash = (hash ^ uint8(*c)) * 1099511628211ULL;
+
+        uint8 buffer[64 * 1024];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), rf)) > 0)
+            for (size_t i = 0; i < read; ++i)
+                hash = (hash ^ buffer[i]) * 1099511628211ULL;
+
+        bool success = ferror(rf) == 0;
+        fclose(rf);
+        return success;
+    }
+
     bool TileAssembler::convertWorld2()
     {
         bool success = readMapSpawns();
         if (!success)
             return false;
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        if (!iThreads)
+            iThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        // export Map data, the maps do not share anything
+        std::vector<MapData::iterator> maps;
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+            maps.push_back(map_iter);
+
+        std::vector<std::set<std::string>> mapModelFiles(maps.size());
+        std::atomic<bool> mapFailed(false);
+        runParallel(iThreads, maps.size(), [&](size_t i)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                        break;
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    // TODO: remove extractor hack and uncomment below line:
-                    // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+            if (!mapFailed && !convertMap(maps[i]->first, *maps[i]->second, mapModelFiles[i]))
+                mapFailed = true;
+        });
+        success = !mapFailed;
+
+        for (auto& modelFiles : mapModelFiles)
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
+
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+
+        // export objects
+        if (success)
+            success = convertModelFiles();
 
-            printf("Creating map tree...\n");
-            BIH pTree;
-            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        // cleanup:
+        for (auto& map_iter : mapData)
+        {
+            delete map_iter.second;
+        }
+        return success;
+    }
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles)
+    {
+        bool success = true;
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                if (!calculateTransformedBound(entry->second))
+                    break;
             }
-
-            // general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
-
-            uint32 i = 0;
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob, ++i)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                ModelSpawn& globSpawn = map_iter->second->UniqueEntries[glob->second];
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
-                // MapTree nodes to update when loading tile:
-                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(globSpawn.ID);
-                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, mapfile) != 1) success = false;
+                // TODO: remove extractor hack and uncomment below line:
+                // entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
+
+        printf("Creating map tree...\n");
+        BIH pTree;
+        pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << "/" << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        // general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) success = false;
+
+        uint32 i = 0;
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob, ++i)
+        {
+            ModelSpawn& globSpawn = spawns.UniqueEntries[glob->second];
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
+            // MapTree nodes to update when loading tile:
+            std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(globSpawn.ID);
+            if (success && fwrite(&nIdx->second, sizeof(uint32), 1, mapfile) != 1) success = false;
+        }
 
-            printf("Map %u global objects %u", map_iter->first, i);
+        printf("Map %u global objects %u\n", mapId, i);
 
-            fclose(mapfile);
+        fclose(mapfile);
 
-            // <====
+        // <====
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
+                continue;
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << "/" << std::setw(3) << mapId << "_";
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
+            FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
+            // file header
+            if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
+            // write number of tile spawns
+            if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
+            // write tile spawns
+            for (uint32 s = 0; s < nSpawns; ++s)
             {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN)           // WDT spawn, saved as tile 65/65 currently...
-                    continue;
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << "/" << std::setw(3) << map_iter->first << "_";
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << "_" << std::setw(2) << y << ".vmtile";
-                FILE* tilefile = fopen(tilefilename.str().c_str(), "wb");
-                // file header
-                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) success = false;
-                // write number of tile spawns
-                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) success = false;
-                // write tile spawns
-                for (uint32 s = 0; s < nSpawns; ++s)
-                {
-                    if (s)
-                        ++tile;
-                    ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                    // MapTree nodes to update when loading tile:
-                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
-                }
-                fclose(tilefile);
+                if (s)
+                    ++tile;
+                ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                // MapTree nodes to update when loading tile:
+                std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) success = false;
             }
-            // break; // test, extract only first map; TODO: remvoe this line
+            fclose(tilefile);
         }
+        return success;
+    }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
+    bool TileAssembler::convertModelFiles()
+    {
+        // content hashes of the raw files the existing .vmo files were converted from
+        std::string hashFilename = iDestDir + "/" + MODEL_HASHES;
+        std::map<std::string, uint64> oldHashes;
+        if (!iRebuild)
+        {
+            if (FILE* hashList = fopen(hashFilename.c_str(), "r"))
+            {
+                unsigned long long hash;
+                char name[500];
+                while (fscanf(hashList, "%llx %499[^\n]\n", &hash, name) == 2)
+                    oldHashes[name] = hash;
+                fclose(hashList);
+            }
+        }
+
+        std::vector<std::string> models(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::vector<uint64> hashes(models.size(), 0);
+        std::vector<char> converted(models.size(), 0);
+        std::atomic<uint32> skipped(0);
+        std::atomic<bool> failed(false);
 
-        // export objects
         std::cout << "\nConverting Model Files" << std::endl;
-        for (const auto& spawnedModelFile : spawnedModelFiles)
+        runParallel(iThreads, models.size(), [&](size_t i)
         {
-            std::cout << "Converting " << spawnedModelFile << std::endl;
-            if (!convertRawFile(spawnedModelFile))
+            if (failed)
+                return;
+
+            std::string const& model = models[i];
+            if (hashFile(iSrcDir + "/" + model, hashes[i]) && !iRebuild)
             {
-                std::cout << "error converting " << spawnedModelFile << std::endl;
-                success = false;
-                break;
+                auto oldHash = oldHashes.find(model);
+                FILE* vmo = oldHash != oldHashes.end() && oldHash->second == hashes[i] ? fopen((iDestDir + "/" + model + ".vmo").c_str(), "rb") : nullptr;
+                if (vmo)
+                {
+                    fclose(vmo);
+                    converted[i] = 1;
+                    ++skipped;
+                    return;
+                }
             }
-        }
 
-        // cleanup:
-        for (auto& map_iter : mapData)
+            printf("Converting %s\n", model.c_str());
+            if (!convertRawFile(model))
+            {
+                printf("error converting %s\n", model.c_str());
+                failed = true;
+                return;
+            }
+            converted[i] = 1;
+        });
+
+        printf("%u of %u model files unchanged\n", skipped.load(), uint32(models.size()));
+
+        // also written on failure so the next run continues with the models still missing
+        if (FILE* hashList = fopen(hashFilename.c_str(), "w"))
         {
-            delete map_iter.second;
+            for (size_t i = 0; i < models.size(); ++i)
+                if (converted[i])
+                    fprintf(hashList, "%016llx %s\n", (unsigned long long)hashes[i], models[i].c_str());
+            fclose(hashList);
         }
-        return success;
+
+        return !failed;
     }
 
     bool TileAssembler::readMapSpawns()
@@ -98,6 +98,11 @@ namespace VMAP
             unsigned int iCurrentUniqueNameId;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
+            uint32 iThreads;
+            bool iRebuild;
+
+            bool convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles);
+            bool convertModelFiles();
 
         public:
             TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
@@ -110,6 +115,10 @@ namespace VMAP
             void exportGameobjectModels();
             bool convertRawFile(const std::string& pModelFilename);
             void setModelNameFilterMethod(bool (*pFilterMethod)(char* pName)) { iFilterMethod = pFilterMethod; }
+            /// Maps and model files are converted by this many threads, 0 - one per hardware thread
+            void setThreads(uint32 threads) { iThreads = threads; }
+            /// Converts all model files again, also the ones unchanged since the last run
+            void setRebuild(bool rebuild) { iRebuild = rebuild; }
     };
 }                                                           // VMAP
 #endif                                                      /*_TILEASSEMBLER_H_*/
@@ -26,6 +26,7 @@ namespace VMAP
     const char VMAP_MAGIC[] = "VMAP_7.0";                   // used in final vmap files
     const char RAW_VMAP_MAGIC[] = "VMAPs05";                // used in extracted vmap files with raw data
     const char GAMEOBJECT_MODELS[] = "temp_gameobject_models";
+    const char MODEL_HASHES[] = "model_hashes";              // raw model content hashes of the vmo files, for incremental conversion
 
     // defined in TileAssembler.cpp currently...
     bool readChunk(FILE* rf, char* dest, const char* compare, uint32 len);
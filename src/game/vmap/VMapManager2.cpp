@@ -19,12 +19,14 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <tuple>
 #include "VMapManager2.h"
 #include "MapTree.h"
 #include "ModelInstance.h"
 #include "WorldModel.h"
 #include "VMapDefinitions.h"
 #include "Maps/GridMapDefines.h"
+#include "Trace.h"
 
 using G3D::Vector3;
 
@@ -102,8 +104,15 @@ namespace VMAP
 
     bool VMapManager2::_loadMap(unsigned int pMapId, const std::string& basePath, uint32 tileX, uint32 tileY)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-        if (instanceTree == iInstanceMapTrees.end())
+        StaticMapTree* tree = nullptr;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_vmStaticMapMutex);
+            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+            if (instanceTree != iInstanceMapTrees.end())
+                tree = instanceTree->second;
+        }
+
+        if (!tree)
         {
             std::string mapFileName = getMapFileName(pMapId);
             StaticMapTree* newTree = new StaticMapTree(pMapId, basePath);
@@ -113,19 +122,23 @@ namespace VMAP
                 return false;
             }
 
-            // insert new data
+            // insert new data, another thread may have been faster
             {
-                std::lock_guard<std::mutex> lock(m_vmStaticMapMutex);
-                instanceTree = iInstanceMapTrees.insert(InstanceTreeMap::value_type(pMapId, newTree)).first;
+                std::unique_lock<std::shared_mutex> lock(m_vmStaticMapMutex);
+                auto inserted = iInstanceMapTrees.insert(InstanceTreeMap::value_type(pMapId, newTree));
+                tree = inserted.first->second;
+                if (!inserted.second)
+                    delete newTree;
             }
         }
-        return instanceTree->second->LoadMapTile(tileX, tileY, this);
+        return tree->LoadMapTile(tileX, tileY, this);
     }
 
     //=========================================================
 
     void VMapManager2::unloadMap(unsigned int pMapId)
     {
+        std::unique_lock<std::shared_mutex> lock(m_vmStaticMapMutex);
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
         if (instanceTree != iInstanceMapTrees.end())
         {
@@ -142,6 +155,7 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int  pMapId, int x, int y)
     {
+        std::unique_lock<std::shared_mutex> lock(m_vmStaticMapMutex);
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
         if (instanceTree != iInstanceMapTrees.end())
         {
@@ -158,6 +172,7 @@ namespace VMAP
 
     bool VMapManager2::isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model)
     {
+        TRACE_ZONE_ID("VMapManager2::isInLineOfSight", pMapId);
         if (!isLineOfSightCalcEnabled()) return true;
         bool result = true;
         InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
@@ -173,6 +188,26 @@ namespace VMAP
         return result;
     }
     //=========================================================
+
+    uint64 VMapManager2::isInLineOfSight(unsigned int pMapId, Vector3 const& origin, Vector3 const* targets, uint32 count, bool ignoreM2Model)
+    {
+        TRACE_ZONE_ID("VMapManager2::isInLineOfSight batch", pMapId);
+        MANGOS_ASSERT(count <= 64);
+        uint64 all = count == 64 ? ~uint64(0) : (uint64(1) << count) - 1;
+        if (!isLineOfSightCalcEnabled())
+            return all;
+
+        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return all;
+
+        Vector3 internalTargets[64];
+        for (uint32 i = 0; i < count; ++i)
+            internalTargets[i] = convertPositionToInternalRep(targets[i].x, targets[i].y, targets[i].z);
+
+        return instanceTree->second->isInLineOfSight(convertPositionToInternalRep(origin.x, origin.y, origin.z), internalTargets, count, ignoreM2Model);
+    }
+    //=========================================================
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -281,21 +316,34 @@ namespace VMAP
 
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
-        std::lock_guard<std::mutex> lock(m_vmModelMutex);
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            WorldModel* worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            std::shared_lock<std::shared_mutex> lock(m_vmModelMutex);
+            ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+            if (model != iLoadedModelFiles.end())
             {
-                ERROR_LOG("VMapManager2: could not load '%s%s.vmo'!", basepath.c_str(), filename.c_str());
-                delete worldmodel;
-                return nullptr;
+                model->second.incRefCount();
+                return model->second.getModel();
             }
+        }
+
+        // read the file outside of the lock, loads of other models go on meanwhile
+        WorldModel* worldmodel = new WorldModel();
+        if (!worldmodel->readFile(basepath + filename + ".vmo", isModelMappingEnabled()))
+        {
+            ERROR_LOG("VMapManager2: could not load '%s%s.vmo'!", basepath.c_str(), filename.c_str());
+            delete worldmodel;
+            return nullptr;
+        }
 
+        std::unique_lock<std::shared_mutex> lock(m_vmModelMutex);
+        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+        if (model != iLoadedModelFiles.end())
+            delete worldmodel;                              // loaded by another thread meanwhile
+        else
+        {
             // insert new data
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: loading file '%s%s'.", basepath.c_str(), filename.c_str());
-            model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
+            model = iLoadedModelFiles.emplace(std::piecewise_construct, std::forward_as_tuple(filename), std::forward_as_tuple()).first;
             model->second.setModel(worldmodel);
         }
         model->second.incRefCount();
@@ -304,13 +352,22 @@ namespace VMAP
 
     void VMapManager2::releaseModelInstance(const std::string& filename)
     {
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            ERROR_LOG("VMapManager2: trying to unload non-loaded file '%s'!", filename.c_str());
-            return;
+            std::shared_lock<std::shared_mutex> lock(m_vmModelMutex);
+            ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+            if (model == iLoadedModelFiles.end())
+            {
+                ERROR_LOG("VMapManager2: trying to unload non-loaded file '%s'!", filename.c_str());
+                return;
+            }
+            if (model->second.decRefCount() != 0)
+                return;
         }
-        if (model->second.decRefCount() == 0)
+
+        // last reference gone, unless acquired again before the exclusive lock was taken
+        std::unique_lock<std::shared_mutex> lock(m_vmModelMutex);
+        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
+        if (model != iLoadedModelFiles.end() && model->second.getRefCount() == 0)
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: unloading file '%s'", filename.c_str());
             delete model->second.getModel();
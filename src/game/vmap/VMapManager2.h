@@ -23,8 +23,10 @@
 
 #include <G3D/Vector3.h>
 
+#include <atomic>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
 
 //===========================================================
 
@@ -53,11 +55,12 @@ namespace VMAP
             ManagedModel() : iModel(nullptr), iRefCount(0) {}
             void setModel(WorldModel* model) { iModel = model; }
             WorldModel* getModel() const { return iModel; }
-            void incRefCount() { ++iRefCount; }
-            int decRefCount() { return --iRefCount; }
+            void incRefCount() { iRefCount.fetch_add(1, std::memory_order_relaxed); }
+            int decRefCount() { return iRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+            int getRefCount() const { return iRefCount.load(std::memory_order_acquire); }
         protected:
             WorldModel* iModel;
-            int iRefCount;
+            std::atomic<int> iRefCount;
     };
 
     typedef std::unordered_map<uint32, StaticMapTree*> InstanceTreeMap;
@@ -66,8 +69,10 @@ namespace VMAP
     class VMapManager2 : public IVMapManager
     {
         private:
-            std::mutex m_vmStaticMapMutex;
-            std::mutex m_vmModelMutex;
+            std::shared_mutex m_vmStaticMapMutex;
+            // shared for lookups of loaded models, the refcounts are atomic so concurrent tile loads of
+            // different maps only serialize when a model file has to be read or freed
+            std::shared_mutex m_vmModelMutex;
 
         protected:
             // Tree to check collision
@@ -92,6 +97,7 @@ namespace VMAP
             void unloadMap(unsigned int pMapId) override;
 
             bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, bool ignoreM2Model) override;
+            uint64 isInLineOfSight(unsigned int pMapId, G3D::Vector3 const& origin, G3D::Vector3 const* targets, uint32 count, bool ignoreM2Model) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
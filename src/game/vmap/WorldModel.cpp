@@ -22,6 +22,9 @@
 #include "ModelInstance.h"
 #include <string.h>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 using G3D::Vector3;
 using G3D::Ray;
 
@@ -32,7 +35,7 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle& tri, std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, float& distance)
+    bool IntersectTriangle(const MeshTriangle& tri, Vector3 const* points, const G3D::Ray& ray, float& distance)
     {
         static const float EPS = 1e-5f;
 
@@ -88,7 +91,7 @@ namespace VMAP
     class TriBoundFunc
     {
         public:
-            TriBoundFunc(std::vector<Vector3>& vert): vertices(vert.begin()) {}
+            TriBoundFunc(ModelArray<Vector3> const& vert): vertices(vert.data()) {}
             void operator()(const MeshTriangle& tri, G3D::AABox& out) const
             {
                 G3D::Vector3 lo = vertices[tri.idx0];
@@ -100,7 +103,7 @@ namespace VMAP
                 out = G3D::AABox(lo, hi);
             }
         protected:
-            const std::vector<Vector3>::const_iterator vertices;
+            Vector3 const* const vertices;
     };
 
     // ===================== WmoLiquid ==================================
@@ -281,7 +284,7 @@ namespace VMAP
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result && fwrite(&vertices[0], sizeof(Vector3), count, wf) != count) result = false;
+        if (result && fwrite(vertices.data(), sizeof(Vector3), count, wf) != count) result = false;
 
         // write triangle mesh
         if (result && fwrite("TRIM", 1, 4, wf) != 4) result = false;
@@ -290,7 +293,7 @@ namespace VMAP
         if (result && fwrite(&chunkSize, sizeof(uint32), 1, wf) != 1) result = false;
         if (result && fwrite(&count, sizeof(uint32), 1, wf) != 1) result = false;
         if (count)
-            if (result && fwrite(&triangles[0], sizeof(MeshTriangle), count, wf) != count) result = false;
+            if (result && fwrite(triangles.data(), sizeof(MeshTriangle), count, wf) != count) result = false;
 
         // write mesh BIH
         if (result && fwrite("MBIH", 1, 4, wf) != 4) result = false;
@@ -306,14 +309,16 @@ namespace VMAP
         return result;
     }
 
-    bool GroupModel::readFromFile(FILE* rf)
+    bool GroupModel::readFromFile(FILE* rf, ModelFileMapping const* mapping)
     {
         char chunk[8];
         bool result = true;
         uint32 chunkSize = 0;
         uint32 count = 0;
-        triangles.clear();
-        vertices.clear();
+        std::vector<Vector3> noVertices;
+        std::vector<MeshTriangle> noTriangles;
+        vertices.swap(noVertices);
+        triangles.swap(noTriangles);
         delete iLiquid;
         iLiquid = nullptr;
 
@@ -327,22 +332,17 @@ namespace VMAP
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
         if (!count) // models without (collision) geometry end here, unsure if they are useful
             return result;
-        if (result) vertices.resize(count);
-        if (result && fread(&vertices[0], sizeof(Vector3), count, rf) != count) result = false;
+        if (result) result = vertices.read(rf, count, mapping);
 
         // read triangle mesh
         if (result && !readChunk(rf, chunk, "TRIM", 4)) result = false;
         if (result && fread(&chunkSize, sizeof(uint32), 1, rf) != 1) result = false;
         if (result && fread(&count, sizeof(uint32), 1, rf) != 1) result = false;
-        if (count)
-        {
-            if (result) triangles.resize(count);
-            if (result && fread(&triangles[0], sizeof(MeshTriangle), count, rf) != count) result = false;
-        }
+        if (result) result = triangles.read(rf, count, mapping);
 
         // read mesh BIH
         if (result && !readChunk(rf, chunk, "MBIH", 4)) result = false;
-        if (result) result = meshTree.readFromFile(rf);
+        if (result) result = meshTree.readFromFile(rf, mapping);
 
         // read liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4)) result = false;
@@ -354,16 +354,16 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
+        GModelRayCallback(ModelArray<MeshTriangle> const& tris, ModelArray<Vector3> const& vert):
+            vertices(vert.data()), triangles(tris.data()), hit(false) {}
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/, bool /*ignoreM2Model*/)
         {
             bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
             if (result)  hit = true;
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        Vector3 const* vertices;
+        MeshTriangle const* triangles;
         bool hit;
     };
 
@@ -544,12 +544,31 @@ namespace VMAP
         return result;
     }
 
-    bool WorldModel::readFile(const std::string& filename)
+    bool WorldModel::readFile(const std::string& filename, bool mapped)
     {
         FILE* rf = fopen(filename.c_str(), "rb");
         if (!rf)
             return false;
 
+        // the chunk headers are still read from rf, the arrays point into the mapping at the same offsets
+        ModelFileMapping mapping = { nullptr, 0 };
+        iMapping.reset();
+        if (mapped)
+        {
+            try
+            {
+                boost::interprocess::file_mapping file(filename.c_str(), boost::interprocess::read_only);
+                iMapping.reset(new boost::interprocess::mapped_region(file, boost::interprocess::read_only));
+                mapping.data = static_cast<char const*>(iMapping->get_address());
+                mapping.size = iMapping->get_size();
+            }
+            catch (boost::interprocess::interprocess_exception const&)
+            {
+                iMapping.reset();                       // read into memory instead
+            }
+        }
+        ModelFileMapping const* mappingPtr = iMapping ? &mapping : nullptr;
+
         bool result = true;
         uint32 chunkSize = 0;
         uint32 count = 0;
@@ -569,11 +588,11 @@ namespace VMAP
             if (result) groupModels.resize(count);
             // if (result && fread(&groupModels[0], sizeof(GroupModel), count, rf) != count) result = false;
             for (uint32 i = 0; i < count && result; ++i)
-                result = groupModels[i].readFromFile(rf);
+                result = groupModels[i].readFromFile(rf, mappingPtr);
 
             // read group BIH
             if (result && !readChunk(rf, chunk, "GBIH", 4)) result = false;
-            if (result) result = groupTree.readFromFile(rf);
+            if (result) result = groupTree.readFromFile(rf, mappingPtr);
         }
 
         fclose(rf);
@@ -26,6 +26,10 @@
 
 #include "Platform/Define.h"
 
+#include <memory>
+
+namespace boost { namespace interprocess { class mapped_region; } }
+
 namespace VMAP
 {
     class TreeNode;
@@ -90,7 +94,7 @@ namespace VMAP
             bool GetLiquidLevel(const Vector3& pos, float& liqHeight) const;
             uint32 GetLiquidType() const;
             bool writeToFile(FILE* wf);
-            bool readFromFile(FILE* rf);
+            bool readFromFile(FILE* rf, ModelFileMapping const* mapping = nullptr);
             const G3D::AABox& GetBound() const { return iBound; }
             uint32 GetMogpFlags() const { return iMogpFlags; }
             uint32 GetWmoID() const { return iGroupWMOID; }
@@ -98,8 +102,8 @@ namespace VMAP
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
             uint32 iGroupWMOID;
-            std::vector<Vector3> vertices;
-            std::vector<MeshTriangle> triangles;
+            ModelArray<Vector3> vertices;
+            ModelArray<MeshTriangle> triangles;
             BIH meshTree;
             WmoLiquid* iLiquid;
 
@@ -121,7 +125,8 @@ namespace VMAP
             bool IntersectPoint(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, AreaInfo& info) const;
             bool GetLocationInfo(const G3D::Vector3& p, const G3D::Vector3& down, float& dist, LocationInfo& info) const;
             bool writeFile(const std::string& filename);
-            bool readFile(const std::string& filename);
+            //! mapped - point the geometry into the file mapped read only instead of copying it, shared with other processes
+            bool readFile(const std::string& filename, bool mapped = false);
             void setModelFlags(uint32 newFlags) { modelFlags = newFlags; }
             uint32 getModelFlags() const { return modelFlags; }
         protected:
@@ -129,6 +134,7 @@ namespace VMAP
             std::vector<GroupModel> groupModels;
             BIH groupTree;
             uint32 modelFlags;
+            std::shared_ptr<boost::interprocess::mapped_region> iMapping;   //!< backs the group geometry when read mapped
 
 #ifdef MMAP_GENERATOR
         public:
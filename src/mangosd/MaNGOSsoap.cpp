@@ -18,9 +18,13 @@
 
 #include "MaNGOSsoap.h"
 
+#include <future>
 #include <string>
 
-SOAPThread::SOAPThread(const std::string& host, int port) : m_host(host), m_port(port), m_workerThread(&SOAPThread::Work, this) {}
+SOAPThread::SOAPThread(const std::string& host, int port) : m_host(host), m_port(port), m_stopServing(false)
+{
+    m_workerThread = std::thread(&SOAPThread::Work, this);
+}
 
 SOAPThread::~SOAPThread()
 {
@@ -48,6 +52,9 @@ void SOAPThread::Work()
 
     sLog.outString("MaNGOSsoap: bound to http://%s:%d", m_host.c_str(), m_port);
 
+    for (int i = 0; i < WorkerThreads; ++i)
+        m_serveThreads.emplace_back(&SOAPThread::Serve, this);
+
     while (!World::IsStopped())
     {
         auto s = soap_accept(&soap);
@@ -59,14 +66,50 @@ void SOAPThread::Work()
         DEBUG_LOG("MaNGOSsoap: accepted connection from IP=%d.%d.%d.%d", (int)(soap.ip >> 24) & 0xFF, (int)(soap.ip >> 16) & 0xFF, (int)(soap.ip >> 8) & 0xFF, (int)soap.ip & 0xFF);
 
         auto copy = soap_copy(&soap);
-        soap_serve(copy);
-        soap_destroy(copy);
+        {
+            std::lock_guard<std::mutex> guard(m_connectionsLock);
+            m_connections.push_back(copy);
+        }
+        m_connectionsCondition.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_connectionsLock);
+        m_stopServing = true;
     }
+    m_connectionsCondition.notify_all();
+
+    for (auto& thread : m_serveThreads)
+        thread.join();
 
     soap_end(&soap);
     soap_done(&soap);
 }
 
+void SOAPThread::Serve()
+{
+    for (;;)
+    {
+        soap* connection;
+        {
+            std::unique_lock<std::mutex> lock(m_connectionsLock);
+            m_connectionsCondition.wait(lock, [this]() { return m_stopServing || !m_connections.empty(); });
+
+            // connections accepted before the shutdown are still answered
+            if (m_connections.empty())
+                return;
+
+            connection = m_connections.front();
+            m_connections.pop_front();
+        }
+
+        soap_serve(connection);
+        soap_destroy(connection);
+        soap_end(connection);
+        soap_free(connection);
+    }
+}
+
 /*
 Code used for generating stubs:
 
@@ -105,27 +148,42 @@ int ns1__executeCommand(soap* soap, char* command, char** result)
 
     DEBUG_LOG("MaNGOSsoap: got command '%s'", command);
 
-    bool commandExecuted = false, commandSucceeded = false;
+    bool commandSucceeded = true;
     std::vector<char> buffer;
     buffer.reserve(SOAPThread::CommandOutputBufferSize);
 
-    // commands are executed in the world thread. We have to wait for them to be completed
-    sWorld.QueueCliCommand(new CliCommandHolder(accountId, SEC_CONSOLE, command,
-                           [&buffer](const char* output)
+    // several commands are executed in order, the request fails when one of them does
+    std::string const commands(command);
+    for (size_t start = 0; start < commands.size();)
     {
-        assert(output);
+        size_t end = commands.find(SOAPThread::CommandSeparator, start);
+        if (end == std::string::npos)
+            end = commands.size();
 
-        for (auto p = output; *p; ++p)
-            buffer.push_back(*p);
-    },
-    [soap, &commandExecuted, &commandSucceeded](bool success)
-    {
-        commandExecuted = true;
-        commandSucceeded = success;
-    }));
+        std::string const line = commands.substr(start, end - start);
+        start = end + 1;
+        if (line.empty())
+            continue;
 
-    while (!commandExecuted)
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // most commands are executed in the world thread, read only ones right here. We have to wait for them to be completed
+        std::promise<bool> finished;
+        std::future<bool> result = finished.get_future();
+        sWorld.QueueCliCommand(new CliCommandHolder(accountId, SEC_CONSOLE, line.c_str(),
+                               [&buffer](const char* output)
+        {
+            assert(output);
+
+            for (auto p = output; *p; ++p)
+                buffer.push_back(*p);
+        },
+        [&finished](bool success)
+        {
+            finished.set_value(success);
+        }));
+
+        if (!result.get())
+            commandSucceeded = false;
+    }
 
     buffer.push_back(0);
     auto const printBuffer = soap_strdup(soap, &buffer[0]);
@@ -27,8 +27,12 @@
 #include "soapH.h"
 #include "soapStub.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 class SOAPThread
 {
@@ -43,11 +47,20 @@ class SOAPThread
 
         std::thread m_workerThread;
 
+        // accepted connections, served by WorkerThreads threads so a slow request does not hold up the others
+        std::vector<std::thread> m_serveThreads;
+        std::deque<soap*> m_connections;
+        std::mutex m_connectionsLock;
+        std::condition_variable m_connectionsCondition;
+        bool m_stopServing;
+
         void Work();
+        void Serve();
 
     public:
         static const AccountTypes MinLevel = AccountTypes::SEC_ADMINISTRATOR;
         static const int CommandOutputBufferSize = 256;
+        static const char CommandSeparator = '\n';         // a request can carry several commands, one per line
 
         SOAPThread(const std::string& host, int port);
         ~SOAPThread();
@@ -25,6 +25,7 @@
 #include "Config/Config.h"
 #include "ProgressBar.h"
 #include "Log.h"
+#include "AllocStats.h"
 #include "Master.h"
 #include "SystemConfig.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
@@ -36,7 +37,9 @@
 #include <boost/program_options.hpp>
 #include <boost/version.hpp>
 
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string>
 
 #ifdef _WIN32
@@ -62,6 +65,27 @@ DatabaseType LogsDatabase;                                  ///< Accessor to the
 
 uint32 realmID;                                             ///< Id of the realm
 
+// every operator new of the process goes through here to be counted while AllocStats.Enabled is set
+void* operator new(std::size_t size)
+{
+    if (AllocStats::IsEnabled())
+        AllocStats::Record(size);
+
+    while (true)
+    {
+        if (void* ptr = std::malloc(size ? size : 1))
+            return ptr;
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
 /// Launch the mangos server
 int main(int argc, char* argv[])
 {
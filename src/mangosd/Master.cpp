@@ -38,6 +38,7 @@
 #include "revision_sql.h"
 #include "MaNGOSsoap.h"
 #include "Mails/MassMailMgr.h"
+#include "World/TickWatchdog.h"
 #include "Server/DBCStores.h"
 
 #include "Config/Config.h"
@@ -215,6 +216,9 @@ int Master::Run()
         freeze_thread->setPriority(MaNGOS::Priority_Highest);
     }
 
+    ///- Start up slow tick watchdog thread
+    sTickWatchdog.Start(sWorld.getConfig(CONFIG_UINT32_WATCHDOG_SLOW_TICK_THRESHOLD));
+
     {
         int32 networkThreadWorker = sConfig.GetIntDefault("Network.Threads", 1);
         if (networkThreadWorker <= 0)
@@ -222,7 +226,10 @@ int Master::Run()
             sLog.outError("Invalid network tread workers setting in mangosd.conf. (%d) should be > 0", networkThreadWorker);
             networkThreadWorker = 1;
         }
-        MaNGOS::Listener<WorldSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)), networkThreadWorker);
+        bool networkReusePort = sConfig.GetBoolDefault("Network.ReusePort", false);
+        uint64 networkAffinity = std::strtoull(sConfig.GetStringDefault("Network.Affinity", "0").c_str(), nullptr, 0);
+        MaNGOS::Listener<WorldSocket> listener(sConfig.GetStringDefault("BindIP", "0.0.0.0"), int32(sWorld.getConfig(CONFIG_UINT32_PORT_WORLD)), networkThreadWorker,
+                                               networkReusePort, networkAffinity);
 
         std::unique_ptr<MaNGOS::Listener<RASocket>> raListener;
         if (sConfig.GetBoolDefault("Ra.Enable", false))
@@ -245,6 +252,7 @@ int Master::Run()
         freeze_thread->destroy();
         delete freeze_thread;
     }
+    sTickWatchdog.Stop();
 
     ///- Set server offline in realmlist
     LoginDatabase.DirectPExecute("UPDATE realmlist SET realmflags = realmflags | %u WHERE id = '%u'", REALM_FLAG_OFFLINE, realmID);
@@ -335,6 +343,8 @@ bool Master::_StartDB()
 
     dbstring = sConfig.GetStringDefault("CharacterDatabaseInfo");
     nConnections = sConfig.GetIntDefault("CharacterDatabaseConnections", 1);
+    int nAsyncConnections = sConfig.GetIntDefault("CharacterDatabaseAsyncConnections", 1);
+    int nHolderConnections = sConfig.GetIntDefault("CharacterDatabaseHolderConnections", 0);
     if (dbstring.empty())
     {
         sLog.outError("Character Database not specified in configuration file");
@@ -343,10 +353,10 @@ bool Master::_StartDB()
         WorldDatabase.HaltDelayThread();
         return false;
     }
-    sLog.outString("Character Database total connections: %i", nConnections + 1);
+    sLog.outString("Character Database total connections: %i", nConnections + nAsyncConnections + nHolderConnections);
 
     ///- Initialise the Character database
-    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections))
+    if (!CharacterDatabase.Initialize(dbstring.c_str(), nConnections, nAsyncConnections, nHolderConnections))
     {
         sLog.outError("Cannot connect to Character database %s", dbstring.c_str());
 
@@ -25,6 +25,7 @@
 #include "WorldRunnable.h"
 #include "Timer.h"
 #include "Maps/MapManager.h"
+#include "World/TickWatchdog.h"
 
 #include "Database/DatabaseEnv.h"
 
@@ -46,13 +47,17 @@ void WorldRunnable::run()
     uint32 diffTime = 0; // used to compute real time elapsed in World::Update()
     uint32 overCounter = 0; // count overtime loops
 
+    TickWatchdog::SetThreadName("world");
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
         ++World::m_worldLoopCounter;
 
         diffTick = WorldTimer::tick();
+        sTickWatchdog.BeginTick();
         sWorld.Update(diffTick);
+        sTickWatchdog.EndTick();
         diffTime = WorldTimer::getMSTime() - WorldTimer::tickTime();
 
         // we have to wait WORLD_SLEEP_CONST max between loops
@@ -29,9 +29,14 @@
 #include "RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthWorkerPool.h"
 #include "SRP6/SRP6.h"
 #include "CommonDefines.h"
 
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
+
 #include <openssl/md5.h>
 #include <ctime>
 #include <utility>
@@ -178,7 +183,8 @@ std::array<uint8, 16> VersionChallenge = { { 0xBA, 0xA3, 0x1E, 0x99, 0xA0, 0x0B,
 
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
-    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), m_timeoutTimer(service)
+    : Socket(service, std::move(closeHandler)), _status(STATUS_CHALLENGE), _build(0), _accountSecurityLevel(SEC_PLAYER), m_timeoutTimer(service),
+      m_service(service), m_authPending(false)
 {
     m_timeoutTimer.expires_from_now(boost::posix_time::seconds(30));
     m_timeoutTimer.async_wait([&] (const boost::system::error_code& error)
@@ -224,6 +230,13 @@ bool AuthSocket::ProcessIncomingData()
             if (table[i].cmd != cmd)
                 continue;
 
+            // nothing is expected from the client while an auth worker handles its last command
+            if (m_authPending)
+            {
+                DEBUG_LOG("[Auth] Received command %u while the previous one is handled", cmd);
+                return false;
+            }
+
             // unauthorized
             DEBUG_LOG("[Auth] Status %u, table status %u", _status, table[i].status);
 
@@ -258,7 +271,7 @@ bool AuthSocket::ProcessIncomingData()
     return true;
 }
 
-void AuthSocket::SendProof(Sha1Hash sha)
+void AuthSocket::BuildProof(Sha1Hash sha, ByteBuffer& pkt)
 {
     switch (_build)
     {
@@ -272,7 +285,7 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.error = 0;
             proof.LoginFlags = 0x00;
 
-            Write((const char*)&proof, sizeof(proof));
+            pkt.append((const char*)&proof, sizeof(proof));
             break;
         }
         case 8606:                                          // 2.4.3
@@ -291,12 +304,84 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.surveyId = 0x00000000;
             proof.unkFlags = 0x0000;
 
-            Write((const char*)&proof, sizeof(proof));
+            pkt.append((const char*)&proof, sizeof(proof));
             break;
         }
     }
 }
 
+/// Run a login step on the auth workers when they are enabled, else right away
+bool AuthSocket::RunAuthJob(char const* stage, uint8 cmd, AuthJob job)
+{
+    if (!sAuthWorkerPool.IsEnabled())
+    {
+        ByteBuffer pkt;
+        bool result = RunAuthStage(stage, job, pkt);
+        if (pkt.size())
+            Write((const char*)pkt.contents(), pkt.size());
+        return result;
+    }
+
+    // the response is sent by the network thread of the socket
+    std::shared_ptr<AuthSocket> self = shared<AuthSocket>();
+    m_authPending = true;
+    if (!sAuthWorkerPool.Enqueue(stage, [self, stage, job]()
+    {
+        std::shared_ptr<ByteBuffer> pkt = std::make_shared<ByteBuffer>();
+        bool result = self->RunAuthStage(stage, job, *pkt);
+        self->m_service.post([self, pkt, result]() { self->OnAuthJobDone(*pkt, result); });
+    }))
+    {
+        m_authPending = false;
+        SendBusy(cmd);
+        DEBUG_LOG("[Auth] Login queue is full, %s turned down", m_address.c_str());
+    }
+    return true;
+}
+
+bool AuthSocket::RunAuthStage(char const* stage, AuthJob const& job, ByteBuffer& pkt)
+{
+#ifdef BUILD_METRICS
+    metric::duration<std::chrono::microseconds> meas("realmd.auth.stage", {
+        { "stage", stage }
+    });
+#endif
+    return job(pkt);
+}
+
+void AuthSocket::OnAuthJobDone(ByteBuffer const& pkt, bool result)
+{
+    m_authPending = false;
+    if (IsClosed())
+        return;
+
+    if (pkt.size())
+        Write((const char*)pkt.contents(), pkt.size());
+
+    if (!result)
+        Close();
+}
+
+/// The login queue is full, the client may try again later
+void AuthSocket::SendBusy(uint8 cmd)
+{
+    if (cmd == CMD_AUTH_LOGON_CHALLENGE)
+    {
+        const char data[3] = { CMD_AUTH_LOGON_CHALLENGE, 0, AUTH_LOGON_FAILED_DB_BUSY };
+        Write(data, sizeof(data));
+    }
+    else if (_build > 6005)                                 // > 1.12.2
+    {
+        const char data[4] = { char(cmd), AUTH_LOGON_FAILED_DB_BUSY, 0, 0 };
+        Write(data, sizeof(data));
+    }
+    else
+    {
+        const char data[2] = { char(cmd), AUTH_LOGON_FAILED_DB_BUSY };
+        Write(data, sizeof(data));
+    }
+}
+
 /// Logon Challenge command handler
 bool AuthSocket::_HandleLogonChallenge()
 {
@@ -341,8 +426,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
 
@@ -366,6 +449,12 @@ bool AuthSocket::_HandleLogonChallenge()
     LoginDatabase.escape_string(_safelocale);
     LoginDatabase.escape_string(m_os);
 
+    return RunAuthJob("challenge", CMD_AUTH_LOGON_CHALLENGE, [this](ByteBuffer& pkt) { return _ProcessLogonChallenge(pkt); });
+}
+
+/// Account lookup and SRP6 setup of the logon challenge, may run on an auth worker
+bool AuthSocket::_ProcessLogonChallenge(ByteBuffer& pkt)
+{
     pkt << uint8(CMD_AUTH_LOGON_CHALLENGE);
     pkt << uint8(0x00);
 
@@ -497,7 +586,6 @@ bool AuthSocket::_HandleLogonChallenge()
             pkt << uint8(AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT);
     }
 
-    Write((const char*)pkt.contents(), pkt.size());
     return true;
 }
 
@@ -528,6 +616,28 @@ bool AuthSocket::_HandleLogonProof()
     }
     /// </ul>
 
+    // the authenticator pin follows the proof, it is read here as only the network thread may touch the socket buffer
+    LogonPin pin = { false, 0, 0 };
+    if (lp.securityFlags & SECURITY_FLAG_AUTHENTICATOR || !_token.empty())
+    {
+        if (Read((char*)&pin.count, sizeof(uint8)))
+        {
+            std::vector<uint8> keys(pin.count + 1);
+            if (Read((char*)keys.data(), sizeof(uint8) * pin.count))
+            {
+                keys[pin.count] = '\0';
+                pin.token = atoi((const char*)keys.data());
+                pin.received = true;
+            }
+        }
+    }
+
+    return RunAuthJob("proof", CMD_AUTH_LOGON_PROOF, [this, lp, pin](ByteBuffer& pkt) mutable { return _ProcessLogonProof(pkt, lp, pin); });
+}
+
+/// SRP6 verification of the logon proof and the account updates, may run on an auth worker
+bool AuthSocket::_ProcessLogonProof(ByteBuffer& pkt, AUTH_LOGON_PROOF_C& lp, LogonPin const& pin)
+{
     ///- Continue the SRP6 calculation based on data received from the client
     if(!srp.CalculateSessionKey(lp.A, 32))
     {
@@ -543,30 +653,21 @@ bool AuthSocket::_HandleLogonProof()
     {
         if (lp.securityFlags & SECURITY_FLAG_AUTHENTICATOR || !_token.empty())
         {
-            uint8 pinCount;
-            if (!Read((char*)&pinCount, sizeof(uint8)))
+            if (!pin.received)
             {
                 const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 3, 0 };
-                Write(data, sizeof(data));
-                return true;
-            }
-            std::vector<uint8> keys(pinCount + 1);
-            if (!Read((char*)keys.data(), sizeof(uint8) * pinCount))
-            {
-                const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 3, 0 };
-                Write(data, sizeof(data));
+                pkt.append(data, sizeof(data));
                 return true;
             }
 
-            keys[pinCount] = '\0';
             auto ServerToken = generateToken(_token.c_str());
-            auto clientToken = atoi((const char*)keys.data());
+            auto clientToken = pin.token;
             if (ServerToken != clientToken)
             {
-                BASIC_LOG("[AuthChallenge] Account %s tried to login with wrong pincode! Given %u Expected %u Pin Count: %u", _login.c_str(), clientToken, ServerToken, pinCount);
+                BASIC_LOG("[AuthChallenge] Account %s tried to login with wrong pincode! Given %u Expected %u Pin Count: %u", _login.c_str(), clientToken, ServerToken, pin.count);
 
                 const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
-                Write(data, sizeof(data));
+                pkt.append(data, sizeof(data));
                 return true;
             }
         }
@@ -576,7 +677,7 @@ bool AuthSocket::_HandleLogonProof()
             BASIC_LOG("[AuthChallenge] Account %s tried to login with modified client!", _login.c_str());
 
             const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_VERSION_INVALID };
-            Write(data, sizeof(data));
+            pkt.append(data, sizeof(data));
             return true;
         }
 
@@ -594,7 +695,7 @@ bool AuthSocket::_HandleLogonProof()
         Sha1Hash sha;
         srp.Finalize(sha);
 
-        SendProof(sha);
+        BuildProof(sha, pkt);
 
         ///- Set _status to authed!
         _status = STATUS_AUTHED;
@@ -604,13 +705,13 @@ bool AuthSocket::_HandleLogonProof()
         if (_build > 6005)                                  // > 1.12.2
         {
             const char data[4] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT, 0, 0 };
-            Write(data, sizeof(data));
+            pkt.append(data, sizeof(data));
         }
         else
         {
             // 1.x not react incorrectly at 4-byte message use 3 as real error
             const char data[2] = { CMD_AUTH_LOGON_PROOF, AUTH_LOGON_FAILED_UNKNOWN_ACCOUNT };
-            Write(data, sizeof(data));
+            pkt.append(data, sizeof(data));
         }
 
         BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
@@ -807,164 +908,41 @@ bool AuthSocket::_HandleRealmList()
     ///- Update realm list if need
     sRealmList.UpdateIfNeed();
 
-    ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
-    ByteBuffer pkt;
-    LoadRealmlist(pkt, id, accountSecurityLevel);
+    ///- The realm list of the build and security is shared, only the number of user characters in each realm differs
+    RealmListPacketPtr realmList = sRealmList.GetRealmListPacket(_build, accountSecurityLevel, _accountSecurityLevel);
 
-    ByteBuffer hdr;
-    hdr << (uint8) CMD_REALM_LIST;
-    hdr << (uint16)pkt.size();
-    hdr.append(pkt);
-
-    Write((const char*)hdr.contents(), hdr.size());
-    return true;
-}
-
-void AuthSocket::LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 securityLevel)
-{
-    switch (_build)
+    std::vector<std::pair<uint32, uint8>> charCounts;
+    // No SQL injection. id of account is controlled by the database.
+    if (QueryResult* charResult = LoginDatabase.PQuery("SELECT realmid, numchars FROM realmcharacters WHERE acctid = '%u' AND numchars > 0", id))
     {
-        case 5875:                                          // 1.12.1
-        case 6005:                                          // 1.12.2
-        case 6141:                                          // 1.12.3
+        do
         {
-            pkt << uint32(0);                               // unused value
-            pkt << uint8(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                RealmFlags realmflags = i.second.realmflags;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
-                std::string name = i.first;
-                if (realmflags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    char buf[20];
-                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
-                    name += buf;
-                }
-
-                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
-                if (!ok_build || (i.second.allowedSecurityLevel > _accountSecurityLevel))
-                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
-
-                pkt << uint32(i.second.icon);              // realm type
-                pkt << uint8(realmflags);                   // realmflags
-                pkt << name;                                // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category
-                pkt << uint8(0x00);                         // unk, may be realm number/id?
-            }
-
-            pkt << uint16(0x0002);                          // unused value (why 2?)
-            break;
+            Field* fields = charResult->Fetch();
+            charCounts.emplace_back(fields[0].GetUInt32(), fields[1].GetUInt8());
         }
+        while (charResult->NextRow());
+        delete charResult;
+    }
 
-        case 8606:                                          // 2.4.3
-        case 10505:                                         // 3.2.2a
-        case 11159:                                         // 3.3.0a
-        case 11403:                                         // 3.3.2
-        case 11723:                                         // 3.3.3a
-        case 12340:                                         // 3.3.5a
-        default:                                            // and later
-        {
-            pkt << uint32(0);                               // unused value
-            pkt << uint16(getEligibleRealmCount(securityLevel));
-
-            for (const auto& i : sRealmList)
-            {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult* result = LoginDatabase.PQuery("SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i.second.m_ID, acctid);
-                if (result)
-                {
-                    Field* fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
-
-                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), _build) != i.second.realmbuilds.end();
-
-                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(_build) : nullptr;
-                if (!buildInfo)
-                    buildInfo = &i.second.realmBuildInfo;
-
-                // Don't display higher security realms for players.
-                if (!securityLevel && i.second.allowedSecurityLevel > 0)
-                    continue;
-
-                uint8 lock = (i.second.allowedSecurityLevel > _accountSecurityLevel) ? 1 : 0;
-
-                RealmFlags realmFlags = i.second.realmflags;
-
-                // Show offline state for unsupported client builds
-                if (!ok_build)
-                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
-
-                if (!buildInfo)
-                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
-
-                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
-                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
-                pkt << uint8(realmFlags);                   // see enum RealmFlags
-                pkt << i.first;                            // name
-                pkt << i.second.address;                   // address
-                pkt << float(i.second.populationLevel);
-                pkt << uint8(AmountOfCharacters);
-                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
-                pkt << uint8(0x2C);                         // unk, may be realm number/id?
-
-                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
-                {
-                    pkt << uint8(buildInfo->major_version);
-                    pkt << uint8(buildInfo->minor_version);
-                    pkt << uint8(buildInfo->bugfix_version);
-                    pkt << uint16(_build);
-                }
-            }
+    ByteBuffer hdr;
+    hdr << (uint8) CMD_REALM_LIST;
+    hdr << (uint16)realmList->data.size();
 
-            pkt << uint16(0x0010);                          // unused value (why 10?)
-            break;
-        }
+    // accounts without characters get the shared buffer itself
+    if (charCounts.empty())
+    {
+        Write((const char*)hdr.contents(), hdr.size(), std::shared_ptr<const std::vector<uint8>>(realmList, &realmList->data));
+        return true;
     }
-}
 
-uint8 AuthSocket::getEligibleRealmCount(uint8 accountSecurityLevel)
-{
-    uint8 size = 0;
-    for (const auto& i : sRealmList)
-        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
-            size++;
+    std::vector<uint8> pkt(realmList->data);
+    for (auto const& position : realmList->charCounts)
+        for (auto const& charCount : charCounts)
+            if (charCount.first == position.first)
+                pkt[position.second] = charCount.second;
 
-    return size;
+    Write((const char*)hdr.contents(), hdr.size(), (const char*)pkt.data(), pkt.size());
+    return true;
 }
 
 /// Resume patch transfer
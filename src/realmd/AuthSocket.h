@@ -37,6 +37,8 @@
 
 #define HMAC_RES_SIZE 20
 
+struct AUTH_LOGON_PROOF_C;
+
 class AuthSocket : public MaNGOS::Socket
 {
     public:
@@ -44,12 +46,9 @@ class AuthSocket : public MaNGOS::Socket
 
         AuthSocket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler);
 
-        void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer& pkt, uint32 acctid, uint8 accountSecurityLevel = 0);
+        void BuildProof(Sha1Hash sha, ByteBuffer& pkt);
         int32 generateToken(char const* b32key);
 
-        uint8 getEligibleRealmCount(uint8 accountSecurityLevel);
-
         bool VerifyVersion(uint8 const* a, int32 aLength, uint8 const* versionProof, bool isReconnect);
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -73,6 +72,25 @@ class AuthSocket : public MaNGOS::Socket
             STATUS_CLOSED
         };
 
+        /// authenticator pin sent after the logon proof
+        struct LogonPin
+        {
+            bool received;
+            uint8 count;
+            int32 token;
+        };
+
+        // a login step filling the response, false closes the connection
+        typedef std::function<bool(ByteBuffer&)> AuthJob;
+
+        bool RunAuthJob(char const* stage, uint8 cmd, AuthJob job);
+        bool RunAuthStage(char const* stage, AuthJob const& job, ByteBuffer& pkt);
+        void OnAuthJobDone(ByteBuffer const& pkt, bool result);
+        void SendBusy(uint8 cmd);
+
+        bool _ProcessLogonChallenge(ByteBuffer& pkt);
+        bool _ProcessLogonProof(ByteBuffer& pkt, AUTH_LOGON_PROOF_C& lp, LogonPin const& pin);
+
         SRP6 srp;
         BigNumber _reconnectProof;
 
@@ -89,6 +107,9 @@ class AuthSocket : public MaNGOS::Socket
 
         boost::asio::deadline_timer m_timeoutTimer;
 
+        boost::asio::io_service& m_service;
+        bool m_authPending;                                 // a login step is handled by an auth worker
+
         virtual bool ProcessIncomingData() override;
 };
 #endif
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthWorkerPool.h"
+#include "Log.h"
+#include "Database/DatabaseEnv.h"
+
+#ifdef BUILD_METRICS
+#include "Metric/Metric.h"
+#endif
+
+extern DatabaseType LoginDatabase;
+
+AuthWorkerPool::AuthWorkerPool() : m_queueLimit(0), m_stopped(false)
+{
+}
+
+AuthWorkerPool& sAuthWorkerPool
+{
+    static AuthWorkerPool authWorkerPool;
+    return authWorkerPool;
+}
+
+void AuthWorkerPool::Start(uint32 threads, uint32 queueLimit)
+{
+    m_queueLimit = queueLimit;
+    m_stopped = false;
+    for (uint32 i = 0; i < threads; ++i)
+        m_workers.emplace_back(&AuthWorkerPool::WorkerThread, this);
+
+    if (threads)
+        sLog.outString("Login handling uses %u worker threads, at most %u logins queued", threads, queueLimit);
+}
+
+void AuthWorkerPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        m_stopped = true;
+        // the sockets of queued logins are closed with the listener, their clients retry
+        m_queue.clear();
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers)
+        if (worker.joinable())
+            worker.join();
+    m_workers.clear();
+}
+
+bool AuthWorkerPool::Enqueue(char const* stage, Job&& job)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        if (m_stopped || (m_queueLimit && m_queue.size() >= m_queueLimit))
+            return false;
+
+        m_queue.push_back({ stage, std::move(job), std::chrono::steady_clock::now() });
+    }
+    m_condition.notify_one();
+    return true;
+}
+
+void AuthWorkerPool::WorkerThread()
+{
+    LoginDatabase.ThreadStart();
+
+    while (true)
+    {
+        QueuedJob queued;
+        {
+            std::unique_lock<std::mutex> lock(m_queueLock);
+            while (m_queue.empty() && !m_stopped)
+                m_condition.wait(lock);
+
+            if (m_stopped)
+                break;
+
+            queued = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+#ifdef BUILD_METRICS
+        metric::measurement meas("realmd.auth.queue", {
+            { "stage", queued.stage }
+        });
+        meas.add_field("wait", std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued.queuedAt).count()));
+#endif
+        queued.job();
+    }
+
+    LoginDatabase.ThreadEnd();
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _AUTHWORKERPOOL_H
+#define _AUTHWORKERPOOL_H
+
+#include "Common.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Workers running the account lookups and SRP6 math of logins away from the network threads
+class AuthWorkerPool
+{
+    public:
+        typedef std::function<void()> Job;
+
+        static AuthWorkerPool& Instance();
+
+        AuthWorkerPool();
+        ~AuthWorkerPool() { Stop(); }
+
+        void Start(uint32 threads, uint32 queueLimit);
+        void Stop();
+
+        /// Without workers logins are handled by the network threads
+        bool IsEnabled() const { return !m_workers.empty(); }
+
+        /// Admission of a login step, false when the queue is full and the login has to be turned down
+        bool Enqueue(char const* stage, Job&& job);
+
+    private:
+        struct QueuedJob
+        {
+            char const* stage;
+            Job job;
+            std::chrono::steady_clock::time_point queuedAt;
+        };
+
+        void WorkerThread();
+
+        std::vector<std::thread> m_workers;
+        std::deque<QueuedJob> m_queue;                      ///< admission queue, bounded by m_queueLimit
+        std::mutex m_queueLock;
+        std::condition_variable m_condition;
+        uint32 m_queueLimit;
+        bool m_stopped;
+};
+
+#define sAuthWorkerPool AuthWorkerPool::Instance()
+
+#endif
+/// @}
@@ -145,10 +145,15 @@ void RealmList::UpdateIfNeed()
     if (!m_UpdateInterval || m_NextUpdateTime > time(nullptr))
         return;
 
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (m_NextUpdateTime > time(nullptr))
+        return;
+
     m_NextUpdateTime = time(nullptr) + m_UpdateInterval;
 
-    // Clears Realm list
+    // Clears Realm list and the responses built from it, packets already handed out stay valid
     m_realms.clear();
+    m_realmListPackets.clear();
 
     // Get the content of the realmlist table in the database
     UpdateRealms(false);
@@ -192,3 +197,144 @@ void RealmList::UpdateRealms(bool init)
         delete result;
     }
 }
+
+RealmListPacketPtr RealmList::GetRealmListPacket(uint16 build, uint8 securityLevel, uint8 accountSecurityLevel)
+{
+    uint32 key = (uint32(build) << 16) | (uint32(securityLevel) << 8) | accountSecurityLevel;
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    RealmListPacketPtr& packet = m_realmListPackets[key];
+    if (!packet)
+    {
+        std::shared_ptr<RealmListPacket> built = std::make_shared<RealmListPacket>();
+        BuildRealmListPacket(*built, build, securityLevel, accountSecurityLevel);
+        packet = built;
+    }
+    return packet;
+}
+
+uint8 RealmList::GetEligibleRealmCount(uint8 accountSecurityLevel) const
+{
+    uint8 size = 0;
+    for (const auto& i : m_realms)
+        if (i.second.allowedSecurityLevel <= accountSecurityLevel)
+            size++;
+
+    return size;
+}
+
+void RealmList::BuildRealmListPacket(RealmListPacket& packet, uint16 build, uint8 securityLevel, uint8 accountSecurityLevel) const
+{
+    ByteBuffer pkt;
+    switch (build)
+    {
+        case 5875:                                          // 1.12.1
+        case 6005:                                          // 1.12.2
+        case 6141:                                          // 1.12.3
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint8(GetEligibleRealmCount(securityLevel));
+
+            for (const auto& i : m_realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                RealmFlags realmflags = i.second.realmflags;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                // 1.x clients not support explicitly REALM_FLAG_SPECIFYBUILD, so manually form similar name as show in more recent clients
+                std::string name = i.first;
+                if (realmflags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    char buf[20];
+                    snprintf(buf, 20, " (%u,%u,%u)", buildInfo->major_version, buildInfo->minor_version, buildInfo->bugfix_version);
+                    name += buf;
+                }
+
+                // Show offline state for unsupported client builds and locked realms (1.x clients not support locked state show)
+                if (!ok_build || (i.second.allowedSecurityLevel > accountSecurityLevel))
+                    realmflags = RealmFlags(realmflags | REALM_FLAG_OFFLINE);
+
+                pkt << uint32(i.second.icon);              // realm type
+                pkt << uint8(realmflags);                   // realmflags
+                pkt << name;                                // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.charCounts.emplace_back(i.second.m_ID, uint32(pkt.wpos()));
+                pkt << uint8(0);                            // amount of characters, per account
+                pkt << uint8(i.second.timezone);           // realm category
+                pkt << uint8(0x00);                         // unk, may be realm number/id?
+            }
+
+            pkt << uint16(0x0002);                          // unused value (why 2?)
+            break;
+        }
+
+        case 8606:                                          // 2.4.3
+        case 10505:                                         // 3.2.2a
+        case 11159:                                         // 3.3.0a
+        case 11403:                                         // 3.3.2
+        case 11723:                                         // 3.3.3a
+        case 12340:                                         // 3.3.5a
+        default:                                            // and later
+        {
+            pkt << uint32(0);                               // unused value
+            pkt << uint16(GetEligibleRealmCount(securityLevel));
+
+            for (const auto& i : m_realms)
+            {
+                bool ok_build = std::find(i.second.realmbuilds.begin(), i.second.realmbuilds.end(), build) != i.second.realmbuilds.end();
+
+                RealmBuildInfo const* buildInfo = ok_build ? FindBuildInfo(build) : nullptr;
+                if (!buildInfo)
+                    buildInfo = &i.second.realmBuildInfo;
+
+                // Don't display higher security realms for players.
+                if (!securityLevel && i.second.allowedSecurityLevel > 0)
+                    continue;
+
+                uint8 lock = (i.second.allowedSecurityLevel > accountSecurityLevel) ? 1 : 0;
+
+                RealmFlags realmFlags = i.second.realmflags;
+
+                // Show offline state for unsupported client builds
+                if (!ok_build)
+                    realmFlags = RealmFlags(realmFlags | REALM_FLAG_OFFLINE);
+
+                if (!buildInfo)
+                    realmFlags = RealmFlags(realmFlags & ~REALM_FLAG_SPECIFYBUILD);
+
+                pkt << uint8(i.second.icon);               // realm type (this is second column in Cfg_Configs.dbc)
+                pkt << uint8(lock);                         // flags, if 0x01, then realm locked
+                pkt << uint8(realmFlags);                   // see enum RealmFlags
+                pkt << i.first;                            // name
+                pkt << i.second.address;                   // address
+                pkt << float(i.second.populationLevel);
+                packet.charCounts.emplace_back(i.second.m_ID, uint32(pkt.wpos()));
+                pkt << uint8(0);                            // amount of characters, per account
+                pkt << uint8(i.second.timezone);           // realm category (Cfg_Categories.dbc)
+                pkt << uint8(0x2C);                         // unk, may be realm number/id?
+
+                if (realmFlags & REALM_FLAG_SPECIFYBUILD)
+                {
+                    pkt << uint8(buildInfo->major_version);
+                    pkt << uint8(buildInfo->minor_version);
+                    pkt << uint8(buildInfo->bugfix_version);
+                    pkt << uint16(build);
+                }
+            }
+
+            pkt << uint16(0x0010);                          // unused value (why 10?)
+            break;
+        }
+    }
+
+    packet.data.assign(pkt.contents(), pkt.contents() + pkt.size());
+}
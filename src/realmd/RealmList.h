@@ -24,7 +24,11 @@
 #define _REALMLIST_H
 
 #include "Common.h"
+#include "ByteBuffer.h"
+
 #include <array>
+#include <memory>
+#include <mutex>
 
 struct RealmBuildInfo
 {
@@ -55,6 +59,15 @@ struct Realm
     RealmBuildInfo realmBuildInfo;                          // build info for show version in list
 };
 
+/// Realm list response for one client build and account security, serialized once per realm list refresh
+struct RealmListPacket
+{
+    std::vector<uint8> data;                                ///< CMD_REALM_LIST body, all character counts 0
+    std::vector<std::pair<uint32, uint32>> charCounts;      ///< realm id and position of its character count in data
+};
+
+typedef std::shared_ptr<RealmListPacket const> RealmListPacketPtr;
+
 /// Storage object for the list of realms on the server
 class RealmList
 {
@@ -70,16 +83,24 @@ class RealmList
 
         void UpdateIfNeed();
 
+        /// Shared realm list response, the character counts of the account are patched in by the caller
+        RealmListPacketPtr GetRealmListPacket(uint16 build, uint8 securityLevel, uint8 accountSecurityLevel);
+
         RealmMap::const_iterator begin() const { return m_realms.begin(); }
         RealmMap::const_iterator end() const { return m_realms.end(); }
         uint32 size() const { return m_realms.size(); }
     private:
         void UpdateRealms(bool init);
         void UpdateRealm(uint32 ID, const std::string& name, const std::string& address, uint32 port, uint8 icon, RealmFlags realmflags, uint8 timezone, AccountTypes allowedSecurityLevel, float popu, const std::string& builds);
+        void BuildRealmListPacket(RealmListPacket& packet, uint16 build, uint8 securityLevel, uint8 accountSecurityLevel) const;
+        uint8 GetEligibleRealmCount(uint8 accountSecurityLevel) const;
     private:
         RealmMap m_realms;                                  ///< Internal map of realms
         uint32   m_UpdateInterval;
         time_t   m_NextUpdateTime;
+
+        std::map<uint32, RealmListPacketPtr> m_realmListPackets;    ///< by build, security and account security, cleared at refresh
+        std::mutex m_lock;                                  ///< realms are refreshed by the listener threads
 };
 
 #define sRealmList RealmList::Instance()
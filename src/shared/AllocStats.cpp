@@ -0,0 +1,104 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "AllocStats.h"
+#include "Log.h"
+
+#ifdef MANGOS_ALLOCATOR_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
+
+std::atomic<bool> AllocStats::s_enabled(false);
+thread_local AllocTag AllocStats::s_threadTag = ALLOC_TAG_OTHER;
+thread_local uint32 AllocStats::s_threadSlot = 0;
+std::atomic<uint32> AllocStats::s_nextSlot(0);
+AllocStats::Slot AllocStats::s_slots[AllocStats::SLOT_COUNT];
+
+AllocStats& AllocStats::Instance()
+{
+    static AllocStats instance;
+    return instance;
+}
+
+void AllocStats::Record(size_t bytes)
+{
+    if (!s_threadSlot)
+        s_threadSlot = s_nextSlot.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT + 1;
+
+    // slots are mostly owned by one thread, so the cache line rarely moves
+    Slot& slot = s_slots[s_threadSlot - 1];
+    slot.bytes[s_threadTag].fetch_add(bytes, std::memory_order_relaxed);
+    slot.count[s_threadTag].fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocStats::CloseInterval()
+{
+    AllocStatsCounters totals;
+    for (Slot const& slot : s_slots)
+    {
+        for (uint32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+        {
+            totals.bytes[i] += slot.bytes[i].load(std::memory_order_relaxed);
+            totals.count[i] += slot.count[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    for (uint32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+    {
+        m_lastInterval.bytes[i] = totals.bytes[i] - m_previousTotals.bytes[i];
+        m_lastInterval.count[i] = totals.count[i] - m_previousTotals.count[i];
+    }
+    m_previousTotals = totals;
+}
+
+void AllocStats::GetLastInterval(AllocStatsCounters& counters) const
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    counters = m_lastInterval;
+}
+
+char const* AllocStats::GetTagName(AllocTag tag)
+{
+    static char const* names[ALLOC_TAG_COUNT] = { "other", "map_sessions", "map_players", "map_objects", "map_relocations", "map_send_updates", "database", "network" };
+    return names[tag];
+}
+
+char const* AllocStats::GetAllocatorName()
+{
+#if defined(MANGOS_ALLOCATOR_MIMALLOC)
+    return "mimalloc";
+#elif defined(MANGOS_ALLOCATOR_JEMALLOC)
+    return "jemalloc";
+#else
+    return "system";
+#endif
+}
+
+void AllocStats::InitThreadArena()
+{
+#ifdef MANGOS_ALLOCATOR_JEMALLOC
+    // jemalloc spreads threads over a few shared arenas, long lived update threads get their own
+    unsigned arena;
+    size_t size = sizeof(arena);
+    if (mallctl("arenas.create", &arena, &size, nullptr, 0) != 0 ||
+        mallctl("thread.arena", nullptr, nullptr, &arena, sizeof(arena)) != 0)
+        sLog.outError("AllocStats: can't create a jemalloc arena for the thread");
+#endif
+    // mimalloc already uses a heap per thread, the system allocator is left alone
+}
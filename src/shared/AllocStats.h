@@ -0,0 +1,115 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_ALLOCSTATS_H
+#define MANGOS_ALLOCSTATS_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <mutex>
+
+// subsystem the operator new calls of a thread are attributed to, see AllocTagScope
+enum AllocTag
+{
+    ALLOC_TAG_OTHER,                                        // untagged, mostly world thread and startup
+    ALLOC_TAG_MAP_SESSIONS,                                 // Map::Update phases, see MapUpdatePhaseTimes
+    ALLOC_TAG_MAP_PLAYERS,
+    ALLOC_TAG_MAP_OBJECTS,
+    ALLOC_TAG_MAP_RELOCATIONS,
+    ALLOC_TAG_MAP_SEND_UPDATES,
+    ALLOC_TAG_DATABASE,                                     // synchronous queries and database worker threads
+    ALLOC_TAG_NETWORK,                                      // network threads
+    ALLOC_TAG_COUNT
+};
+
+struct AllocStatsCounters
+{
+    uint64 bytes[ALLOC_TAG_COUNT];
+    uint64 count[ALLOC_TAG_COUNT];
+
+    AllocStatsCounters() : bytes(), count() {}
+};
+
+// Bytes and number of operator new calls per tag while AllocStats.Enabled is set.
+// Only executables replacing operator new with a call to Record are counted (mangosd).
+// Counts are summed up for one minute, the last complete minute is shown by .server allocstats and sent to metrics.
+class AllocStats
+{
+    public:
+        static AllocStats& Instance();
+
+        static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        static AllocTag GetThreadTag() { return s_threadTag; }
+        static void SetThreadTag(AllocTag tag) { s_threadTag = tag; }
+
+        // any thread, from operator new, must not allocate
+        static void Record(size_t bytes);
+
+        // world thread, every minute
+        void CloseInterval();
+        void GetLastInterval(AllocStatsCounters& counters) const;
+
+        static char const* GetTagName(AllocTag tag);
+        // allocator linked in with the ALLOCATOR cmake option
+        static char const* GetAllocatorName();
+        // gives the calling thread its own arena where the allocator does not do it already
+        static void InitThreadArena();
+
+    private:
+        AllocStats() {}
+
+        // threads share a fixed number of counter slots, no registration or cleanup at thread exit
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64> bytes[ALLOC_TAG_COUNT];
+            std::atomic<uint64> count[ALLOC_TAG_COUNT];
+        };
+
+        static constexpr uint32 SLOT_COUNT = 64;
+
+        static std::atomic<bool> s_enabled;
+        static thread_local AllocTag s_threadTag;
+        static thread_local uint32 s_threadSlot;            // 0 until the thread's first counted allocation
+        static std::atomic<uint32> s_nextSlot;
+        static Slot s_slots[SLOT_COUNT];
+
+        AllocStatsCounters m_previousTotals;
+        AllocStatsCounters m_lastInterval;
+        mutable std::mutex m_lock;
+};
+
+#define sAllocStats AllocStats::Instance()
+
+// Attributes the allocations of the calling thread to tag until the scope ends
+class AllocTagScope
+{
+    public:
+        explicit AllocTagScope(AllocTag tag) : m_previous(AllocStats::GetThreadTag()) { AllocStats::SetThreadTag(tag); }
+        ~AllocTagScope() { AllocStats::SetThreadTag(m_previous); }
+
+        AllocTagScope(AllocTagScope const&) = delete;
+        AllocTagScope& operator=(AllocTagScope const&) = delete;
+
+    private:
+        AllocTag m_previous;
+};
+
+#endif
@@ -24,14 +24,14 @@
 const static size_t CRYPTED_SEND_LEN = 4;
 const static size_t CRYPTED_RECV_LEN = 6;
 
-AuthCrypt::AuthCrypt() : _initialized(false) {}
+AuthCrypt::AuthCrypt() : _sendLen(CRYPTED_SEND_LEN), _recvLen(CRYPTED_RECV_LEN), _initialized(false) {}
 
 void AuthCrypt::DecryptRecv(uint8* data, size_t len)
 {
     if (!_initialized) return;
-    if (len < CRYPTED_RECV_LEN) return;
+    if (len < _recvLen) return;
 
-    for (size_t t = 0; t < CRYPTED_RECV_LEN; t++)
+    for (size_t t = 0; t < _recvLen; t++)
     {
         _recv_i %= _key.size();
         uint8 x = (data[t] - _recv_j) ^ _key[_recv_i];
@@ -44,9 +44,9 @@ void AuthCrypt::DecryptRecv(uint8* data, size_t len)
 void AuthCrypt::EncryptSend(uint8* data, size_t len)
 {
     if (!_initialized) return;
-    if (len < CRYPTED_SEND_LEN) return;
+    if (len < _sendLen) return;
 
-    for (size_t t = 0; t < CRYPTED_SEND_LEN; t++)
+    for (size_t t = 0; t < _sendLen; t++)
     {
         _send_i %= _key.size();
         uint8 x = (data[t] ^ _key[_send_i]) + _send_j;
@@ -55,7 +55,7 @@ void AuthCrypt::EncryptSend(uint8* data, size_t len)
     }
 }
 
-void AuthCrypt::Init(BigNumber* K)
+void AuthCrypt::Init(BigNumber* K, bool clientSide /*= false*/)
 {
     uint8* key = new uint8[SHA_DIGEST_LENGTH];
     uint8 recvSeed[SEED_KEY_SIZE] = { 0x38, 0xA7, 0x83, 0x15, 0xF8, 0x92, 0x25, 0x30, 0x71, 0x98, 0x67, 0xB1, 0x8C, 0x4, 0xE2, 0xAA };
@@ -68,5 +68,7 @@ void AuthCrypt::Init(BigNumber* K)
     delete[] key;
 
     _send_i = _send_j = _recv_i = _recv_j = 0;
+    _sendLen = clientSide ? CRYPTED_RECV_LEN : CRYPTED_SEND_LEN;
+    _recvLen = clientSide ? CRYPTED_SEND_LEN : CRYPTED_RECV_LEN;
     _initialized = true;
 }
@@ -29,7 +29,8 @@ class AuthCrypt
     public:
         AuthCrypt();
 
-        void Init(BigNumber* K);
+        // the client side encrypts the longer client header and decrypts the server header, used by mangos-replay
+        void Init(BigNumber* K, bool clientSide = false);
 
         void DecryptRecv(uint8*, size_t);
         void EncryptSend(uint8*, size_t);
@@ -37,6 +38,7 @@ class AuthCrypt
     private:
         std::vector<uint8> _key;
         uint8 _send_i, _send_j, _recv_i, _recv_j;
+        size_t _sendLen, _recvLen;
         bool _initialized;
 };
 #endif
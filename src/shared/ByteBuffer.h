@@ -21,7 +21,9 @@
 
 #include "Common.h"
 #include "Utilities/ByteConverter.h"
+#include "ByteBufferPool.h"
 #include <utf8.h>
+#include <type_traits>
 
 class ByteBufferException
 {
@@ -54,17 +56,30 @@ class ByteBuffer
         // constructor
         ByteBuffer(): _rpos(0), _wpos(0)
         {
-            _storage.reserve(DEFAULT_SIZE);
+            ByteBufferPool::Acquire(_storage, DEFAULT_SIZE);
         }
 
         // constructor
         ByteBuffer(size_t res): _rpos(0), _wpos(0)
         {
-            _storage.reserve(res);
+            if (res)
+                ByteBufferPool::Acquire(_storage, res);
         }
 
         // copy constructor
-        ByteBuffer(const ByteBuffer& buf): _rpos(buf._rpos), _wpos(buf._wpos), _storage(buf._storage) { }
+        ByteBuffer(const ByteBuffer& buf): _rpos(buf._rpos), _wpos(buf._wpos)
+        {
+            if (!buf._storage.empty())
+                ByteBufferPool::Acquire(_storage, buf._storage.size());
+            _storage.assign(buf._storage.begin(), buf._storage.end());
+        }
+
+        ByteBuffer& operator=(const ByteBuffer& buf) = default;
+
+        ~ByteBuffer()
+        {
+            ByteBufferPool::Release(_storage);
+        }
 
         void clear()
         {
@@ -417,6 +432,25 @@ class ByteBuffer
             append(packGUID, size);
         }
 
+        // room for cnt bytes at wpos, filled by ByteBufferWriter
+        uint8* prepare_write(size_t cnt)
+        {
+            MANGOS_ASSERT(size() < 10000000);
+
+            if (_storage.size() < _wpos + cnt)
+                _storage.resize(_wpos + cnt);
+            return _storage.data() + _wpos;
+        }
+
+        // commits the cnt bytes written after prepare_write, the unused room up to sizeBefore is dropped again
+        void finish_write(size_t cnt, size_t sizeBefore)
+        {
+            _wpos += cnt;
+            size_t newSize = std::max(_wpos, sizeBefore);
+            if (_storage.size() > newSize)
+                _storage.resize(newSize);
+        }
+
         void put(size_t pos, const uint8* src, size_t cnt)
         {
             if (pos + cnt > size())
@@ -441,6 +475,87 @@ class ByteBuffer
         std::vector<uint8> _storage;
 };
 
+// Writer for server built content of known maximum size, like update blocks and movement packets.
+// The room is made once on construction and fields are stored without the per field size check of ByteBuffer,
+// what is not written is dropped again by Finish() or the destructor. Client input keeps the checked ByteBuffer reader.
+class ByteBufferWriter
+{
+    public:
+        ByteBufferWriter(ByteBuffer& buffer, size_t maxSize) : m_buffer(&buffer), m_sizeBefore(buffer.size())
+        {
+            m_begin = m_pos = buffer.prepare_write(maxSize);
+            m_end = m_begin + maxSize;
+        }
+        ByteBufferWriter(ByteBufferWriter const&) = delete;
+        ByteBufferWriter& operator=(ByteBufferWriter const&) = delete;
+
+        ~ByteBufferWriter() { Finish(); }
+
+        template <typename T> ByteBufferWriter& operator<<(T value)
+        {
+            static_assert(std::is_arithmetic<T>::value, "only plain numbers are written unchecked");
+            EndianConvert(value);
+            Append(&value, sizeof(value));
+            return *this;
+        }
+
+        void Append(void const* src, size_t cnt)
+        {
+#ifdef MANGOS_DEBUG
+            MANGOS_ASSERT(m_pos + cnt <= m_end);
+#endif
+            memcpy(m_pos, src, cnt);
+            m_pos += cnt;
+        }
+
+        void AppendPackGUID(uint64 guid)
+        {
+#ifdef MANGOS_DEBUG
+            MANGOS_ASSERT(m_pos + 8 + 1 <= m_end);
+#endif
+            uint8* mask = m_pos++;
+            *mask = 0;
+            for (uint8 i = 0; guid != 0; ++i)
+            {
+                if (guid & 0xFF)
+                {
+                    *mask |= uint8(1 << i);
+                    *m_pos++ = uint8(guid & 0xFF);
+                }
+
+                guid >>= 8;
+            }
+        }
+
+        // same packing as ByteBuffer::appendPackXYZ
+        void AppendPackXYZ(float x, float y, float z)
+        {
+            uint32 packed = 0;
+            packed |= ((int)(x / 0.25f) & 0x7FF);
+            packed |= ((int)(y / 0.25f) & 0x7FF) << 11;
+            packed |= ((int)(z / 0.25f) & 0x3FF) << 22;
+            *this << packed;
+        }
+
+        size_t written() const { return m_pos - m_begin; }
+
+        void Finish()
+        {
+            if (!m_buffer)
+                return;
+
+            m_buffer->finish_write(written(), m_sizeBefore);
+            m_buffer = nullptr;
+        }
+
+    private:
+        ByteBuffer* m_buffer;
+        size_t m_sizeBefore;
+        uint8* m_begin;
+        uint8* m_pos;
+        uint8* m_end;
+};
+
 template <typename T>
 inline ByteBuffer& operator<<(ByteBuffer& b, std::vector<T> const& v)
 {
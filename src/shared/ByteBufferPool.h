@@ -0,0 +1,178 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_BYTEBUFFERPOOL_H
+#define MANGOS_BYTEBUFFERPOOL_H
+
+#include "Platform/Define.h"
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+struct ByteBufferPoolStats
+{
+    uint64 acquires;                                        // buffers asked for with a size hint
+    uint64 reuses;                                          // of these served from a free list
+    uint64 releases;                                        // buffers handed back on destruction
+    uint64 dropped;                                         // of these freed, list full or capacity out of class range
+    size_t cachedBytes;                                     // capacity kept in thread free lists
+};
+
+// Per thread free lists of ByteBuffer storage in size classes of 64 bytes to 16 KB.
+// A buffer is filed under the largest class its capacity covers and handed out for hints up to that class,
+// so a reused buffer never has to grow for its hint. Buffers freed on another thread join that thread lists.
+// Counters are kept per thread and folded into the shared statistics every STATS_FLUSH_EVENTS calls.
+class ByteBufferPool
+{
+    public:
+        static const size_t CLASS_COUNT = 5;
+        static const size_t MAX_CACHED_PER_CLASS = 128;
+        static const uint32 STATS_FLUSH_EVENTS = 256;
+
+        // gives storage an empty buffer with capacity for at least size bytes
+        static void Acquire(std::vector<uint8>& storage, size_t size)
+        {
+            FreeLists& lists = t_freeLists;
+            ++lists.stats.acquires;
+            lists.CountEvent();
+
+            size_t sizeClass = GetClassFor(size);
+            if (sizeClass < CLASS_COUNT)
+            {
+                std::vector<std::vector<uint8>>& list = lists.classes[sizeClass];
+                if (!list.empty())
+                {
+                    storage.swap(list.back());
+                    list.pop_back();
+                    lists.cachedBytesDelta -= int64(storage.capacity());
+                    ++lists.stats.reuses;
+                    return;
+                }
+                size = ClassSize(sizeClass);
+            }
+
+            storage.reserve(size);
+        }
+
+        // takes the buffer of storage back, storage is left without memory
+        static void Release(std::vector<uint8>& storage)
+        {
+            size_t capacity = storage.capacity();
+            if (!capacity)
+                return;
+
+            FreeLists& lists = t_freeLists;
+            if (lists.closed)                               // thread exit, the lists are gone
+                return;
+
+            ++lists.stats.releases;
+            lists.CountEvent();
+
+            // oversized buffers are not kept, a single large packet must not pin its memory in a list
+            if (capacity < ClassSize(0) || capacity > ClassSize(CLASS_COUNT - 1) * 2)
+            {
+                ++lists.stats.dropped;
+                return;
+            }
+
+            size_t sizeClass = CLASS_COUNT - 1;
+            while (ClassSize(sizeClass) > capacity)
+                --sizeClass;
+
+            std::vector<std::vector<uint8>>& list = lists.classes[sizeClass];
+            if (list.size() >= MAX_CACHED_PER_CLASS)
+            {
+                ++lists.stats.dropped;
+                return;
+            }
+
+            if (list.capacity() == 0)
+                list.reserve(MAX_CACHED_PER_CLASS);
+
+            storage.clear();
+            list.emplace_back();
+            list.back().swap(storage);
+            lists.cachedBytesDelta += int64(capacity);
+        }
+
+        static ByteBufferPoolStats GetStats()
+        {
+            return { s_acquires.load(std::memory_order_relaxed), s_reuses.load(std::memory_order_relaxed),
+                s_releases.load(std::memory_order_relaxed), s_dropped.load(std::memory_order_relaxed),
+                s_cachedBytes.load(std::memory_order_relaxed) };
+        }
+
+    private:
+        static size_t ClassSize(size_t sizeClass) { return size_t(64) << (2 * sizeClass); }
+
+        // smallest class holding size bytes, CLASS_COUNT when larger than all of them
+        static size_t GetClassFor(size_t size)
+        {
+            size_t sizeClass = 0;
+            while (sizeClass < CLASS_COUNT && ClassSize(sizeClass) < size)
+                ++sizeClass;
+            return sizeClass;
+        }
+
+        struct FreeLists
+        {
+            std::vector<std::vector<uint8>> classes[CLASS_COUNT];
+            ByteBufferPoolStats stats;                      // not yet flushed, cachedBytes unused
+            int64 cachedBytesDelta;
+            uint32 events;
+            bool closed;
+
+            FreeLists() : stats(), cachedBytesDelta(0), events(0), closed(false) {}
+            ~FreeLists()
+            {
+                for (auto& list : classes)
+                    for (auto& buffer : list)
+                        cachedBytesDelta -= int64(buffer.capacity());
+                Flush();
+                closed = true;                              // buffers freed later in thread exit are not kept
+            }
+
+            void CountEvent()
+            {
+                if (++events >= STATS_FLUSH_EVENTS)
+                    Flush();
+            }
+
+            void Flush()
+            {
+                s_acquires.fetch_add(stats.acquires, std::memory_order_relaxed);
+                s_reuses.fetch_add(stats.reuses, std::memory_order_relaxed);
+                s_releases.fetch_add(stats.releases, std::memory_order_relaxed);
+                s_dropped.fetch_add(stats.dropped, std::memory_order_relaxed);
+                s_cachedBytes.fetch_add(size_t(cachedBytesDelta), std::memory_order_relaxed);
+                stats = ByteBufferPoolStats();
+                cachedBytesDelta = 0;
+                events = 0;
+            }
+        };
+
+        static inline thread_local FreeLists t_freeLists;
+        static inline std::atomic<uint64> s_acquires{0};
+        static inline std::atomic<uint64> s_reuses{0};
+        static inline std::atomic<uint64> s_releases{0};
+        static inline std::atomic<uint64> s_dropped{0};
+        static inline std::atomic<size_t> s_cachedBytes{0};
+};
+
+#endif
@@ -24,10 +24,16 @@
 
 #include <unordered_map>
 #include <string>
+#include <cstdlib>
 #include <fstream>
 
 INSTANTIATE_SINGLETON_1(Config);
 
+Config::Config() : m_snapshot(nullptr)
+{
+    Publish(std::unique_ptr<Snapshot>(new Snapshot()));
+}
+
 bool Config::SetSource(const std::string& file)
 {
     m_filename = file;
@@ -42,7 +48,7 @@ bool Config::Reload()
     if (in.fail())
         return false;
 
-    std::unordered_map<std::string, std::string> newEntries;
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
     std::lock_guard<std::mutex> guard(m_configLock);
 
     do
@@ -65,51 +71,94 @@ bool Config::Reload()
         auto const entry = boost::algorithm::trim_copy(boost::algorithm::to_lower_copy(line.substr(0, equals)));
         auto const value = boost::algorithm::trim_copy_if(boost::algorithm::trim_copy(line.substr(equals + 1)), boost::algorithm::is_any_of("\""));
 
-        newEntries[entry] = value;
+        auto const valueLower = boost::algorithm::to_lower_copy(value);
+
+        Entry& parsed = snapshot->entries[entry];
+        parsed.value = value;
+        parsed.intValue = int32(strtol(value.c_str(), nullptr, 10));
+        parsed.floatValue = strtof(value.c_str(), nullptr);
+        parsed.boolValue = valueLower == "true" || valueLower == "1" || valueLower == "yes";
     }
     while (in.good());
 
-    m_entries = std::move(newEntries);
+    Publish(std::move(snapshot));
 
     return true;
 }
 
-bool Config::IsSet(const std::string& name) const
+void Config::Publish(std::unique_ptr<Snapshot> snapshot)
+{
+    // resolve the interned keys against the new entries
+    snapshot->keys.resize(m_keyNames.size());
+    for (size_t i = 0; i < m_keyNames.size(); ++i)
+    {
+        auto const entry = snapshot->entries.find(m_keyNames[i]);
+        snapshot->keys[i] = entry == snapshot->entries.cend() ? nullptr : &entry->second;
+    }
+
+    m_snapshot.store(snapshot.get(), std::memory_order_release);
+    m_snapshots.push_back(std::move(snapshot));
+}
+
+Config::Key Config::Intern(const std::string& name)
 {
     auto const nameLower = boost::algorithm::to_lower_copy(name);
-    return m_entries.find(nameLower) != m_entries.cend();
+
+    std::lock_guard<std::mutex> guard(m_configLock);
+
+    auto const itr = m_keyIds.find(nameLower);
+    if (itr != m_keyIds.cend())
+        return itr->second;
+
+    Key const key = Key(m_keyNames.size());
+    m_keyIds[nameLower] = key;
+    m_keyNames.push_back(nameLower);
+
+    // the published snapshot does not know the key yet
+    Publish(std::unique_ptr<Snapshot>(new Snapshot{ m_snapshot.load(std::memory_order_acquire)->entries, {} }));
+
+    return key;
 }
 
-const std::string Config::GetStringDefault(const std::string& name, const std::string& def) const
+Config::Entry const* Config::Find(const std::string& name) const
 {
     auto const nameLower = boost::algorithm::to_lower_copy(name);
 
-    auto const entry = m_entries.find(nameLower);
+    Snapshot const* snapshot = m_snapshot.load(std::memory_order_acquire);
+    auto const entry = snapshot->entries.find(nameLower);
 
-    return entry == m_entries.cend() ? def : entry->second;
+    return entry == snapshot->entries.cend() ? nullptr : &entry->second;
 }
 
-bool Config::GetBoolDefault(const std::string& name, bool def) const
+bool Config::IsSet(const std::string& name) const
+{
+    return Find(name) != nullptr;
+}
+
+const std::string Config::GetStringDefault(const std::string& name, const std::string& def) const
 {
-    auto const value = GetStringDefault(name, def ? "true" : "false");
+    Entry const* entry = Find(name);
 
-    std::string valueLower;
-    std::transform(value.cbegin(), value.cend(), std::back_inserter(valueLower), ::tolower);
+    return entry ? entry->value : def;
+}
 
-    return valueLower == "true" || valueLower == "1" || valueLower == "yes";
+bool Config::GetBoolDefault(const std::string& name, bool def) const
+{
+    Entry const* entry = Find(name);
+
+    return entry ? entry->boolValue : def;
 }
 
 int32 Config::GetIntDefault(const std::string& name, int32 def) const
 {
-    auto const value = GetStringDefault(name, std::to_string(def));
+    Entry const* entry = Find(name);
 
-    return std::stoi(value);
+    return entry ? entry->intValue : def;
 }
 
 float Config::GetFloatDefault(const std::string& name, float def) const
 {
-    auto const value = GetStringDefault(name, std::to_string(def));
+    Entry const* entry = Find(name);
 
-    return std::stof(value);
+    return entry ? entry->floatValue : def;
 }
-
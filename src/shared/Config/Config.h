@@ -22,18 +22,53 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 #include "Platform/Define.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 class Config
 {
+    public:
+        typedef uint32 Key;                                 // interned entry name, see Intern
+
     private:
+        // values are parsed once when the file is read
+        struct Entry
+        {
+            std::string value;
+            int32 intValue;
+            float floatValue;
+            bool boolValue;
+        };
+
+        // never changed once published, Reload and Intern publish a new one
+        struct Snapshot
+        {
+            std::unordered_map<std::string, Entry> entries; // keys are converted to lower case.  values cannot be.
+            std::vector<Entry const*> keys;                 // by interned key, nullptr when not set
+        };
+
         std::string m_filename;
-        std::unordered_map<std::string, std::string> m_entries; // keys are converted to lower case.  values cannot be.
+        std::atomic<Snapshot const*> m_snapshot;
+        std::vector<std::unique_ptr<Snapshot>> m_snapshots; // replaced ones too, readers may still hold them
+        std::unordered_map<std::string, Key> m_keyIds;
+        std::vector<std::string> m_keyNames;                // lower case, by key
+
+        void Publish(std::unique_ptr<Snapshot> snapshot);
+        Entry const* Find(const std::string& name) const;
+        Entry const* Find(Key key) const
+        {
+            Snapshot const* snapshot = m_snapshot.load(std::memory_order_acquire);
+            return key < snapshot->keys.size() ? snapshot->keys[key] : nullptr;
+        }
 
     public:
+        Config();
+
         bool SetSource(const std::string& file);
         bool Reload();
 
@@ -44,6 +79,16 @@ class Config
         int32 GetIntDefault(const std::string& name, int32 def) const;
         float GetFloatDefault(const std::string& name, float def) const;
 
+        // for values read at runtime: intern the name once, keep the key (e.g. function static)
+        // and read through it, which is one snapshot load and an index, also while reloading
+        Key Intern(const std::string& name);
+
+        bool IsSet(Key key) const { return Find(key) != nullptr; }
+        const std::string GetString(Key key, const std::string& def = "") const { Entry const* entry = Find(key); return entry ? entry->value : def; }
+        bool GetBool(Key key, bool def) const { Entry const* entry = Find(key); return entry ? entry->boolValue : def; }
+        int32 GetInt(Key key, int32 def) const { Entry const* entry = Find(key); return entry ? entry->intValue : def; }
+        float GetFloat(Key key, float def) const { Entry const* entry = Find(key); return entry ? entry->floatValue : def; }
+
         const std::string& GetFilename() const { return m_filename; }
         std::mutex m_configLock;
 };
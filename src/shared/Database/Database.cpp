@@ -25,6 +25,8 @@
 #include <fstream>
 #include <memory>
 #include <cstdarg>
+#include <limits>
+#include <regex>
 
 #define MIN_CONNECTION_POOL_SIZE 1
 #define MAX_CONNECTION_POOL_SIZE 16
@@ -91,13 +93,92 @@ bool SqlConnection::ExecuteStmt(int nIndex, const SqlStmtParameters& id)
     return pStmt->execute();
 }
 
+SqlConnection::StmtBatchFormat const& SqlConnection::GetBatchFormat(uint32 nIndex)
+{
+    if (m_batchFormats.size() <= nIndex)
+        m_batchFormats.resize(nIndex + 1);
+
+    StmtBatchFormat& format = m_batchFormats[nIndex];
+    if (format.parsed)
+        return format;
+
+    format.parsed = true;
+    std::string fmt = m_db.GetStmtString(nIndex);
+
+    static std::regex const insertRegex("^\\s*((?:insert|replace)(?:\\s+ignore)?\\s+into\\s+[^?]*?\\s+values)\\s*(\\([^()]*\\))\\s*;?\\s*$", std::regex::icase);
+    static std::regex const deleteRegex("^\\s*(delete\\s+from\\s+\\S+\\s+where)\\s+(\\w+\\s*=\\s*\\?(?:\\s+and\\s+\\w+\\s*=\\s*\\?)*)\\s*;?\\s*$", std::regex::icase);
+    static std::regex const columnRegex("(\\w+)\\s*=\\s*\\?");
+
+    std::smatch match;
+    if (std::regex_match(fmt, match, insertRegex))
+    {
+        format.head = match.str(1) + " ";
+        format.row = match.str(2);
+        format.batchable = true;
+    }
+    else if (std::regex_match(fmt, match, deleteRegex))
+    {
+        // WHERE a = ? AND b = ? becomes WHERE (a, b) IN ((?, ?), (?, ?))
+        std::string conditions = match.str(2);
+        std::string columns;
+        uint32 count = 0;
+        for (std::sregex_iterator itr(conditions.begin(), conditions.end(), columnRegex), end; itr != end; ++itr, ++count)
+        {
+            columns += count ? ", " : "";
+            columns += itr->str(1);
+            format.row += count ? ", ?" : "?";
+        }
+
+        format.head = match.str(1) + (count > 1 ? " (" + columns + ") IN (" : " " + columns + " IN (");
+        if (count > 1)
+            format.row = "(" + format.row + ")";
+        format.tail = ")";
+        format.batchable = true;
+    }
+
+    return format;
+}
+
+bool SqlConnection::CanBatchStmt(int nIndex)
+{
+    return nIndex != -1 && GetBatchFormat(nIndex).batchable;
+}
+
+bool SqlConnection::ExecuteStmtBatch(int nIndex, SqlStmtParameters const* const* params, size_t count)
+{
+    StmtBatchFormat const& format = GetBatchFormat(nIndex);
+    MANGOS_ASSERT(format.batchable);
+
+    std::ostringstream sql;
+    sql.precision(std::numeric_limits<double>::max_digits10);  // the binary protocol would not round floats either
+    sql << format.head;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i)
+            sql << ", ";
+
+        SqlStmtParameters::ParameterContainer const& args = params[i]->params();
+        size_t arg = 0;
+        for (char c : format.row)
+        {
+            if (c == '?' && arg < args.size())
+                SqlPlainPreparedStatement::DataToString(args[arg++], sql, *this);
+            else
+                sql << c;
+        }
+    }
+    sql << format.tail;
+
+    return Execute(sql.str().c_str());
+}
+
 //////////////////////////////////////////////////////////////////////////
 Database::~Database()
 {
     StopServer();
 }
 
-bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
+bool Database::Initialize(const char* infoString, int nConns /*= 1*/, int nAsyncConns /*= 1*/, int nHolderConns /*= 0*/)
 {
     // Enable logging of SQL commands (usually only GM commands)
     // (See method: PExecuteLog)
@@ -134,10 +215,34 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
-    // create and initialize connection for async requests
-    m_pAsyncConn = CreateConnection();
-    if (!m_pAsyncConn->Initialize(infoString))
-        return false;
+    // create and initialize connections for async requests
+    nAsyncConns = std::min(std::max(nAsyncConns, MIN_CONNECTION_POOL_SIZE), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nAsyncConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pAsyncConnections.push_back(pConn);
+    }
+    m_pAsyncConn = m_pAsyncConnections[0];
+
+    // connections for the holder workers, none - holders run on the delay thread connection only
+    nHolderConns = std::min(std::max(nHolderConns, 0), MAX_CONNECTION_POOL_SIZE);
+    for (int i = 0; i < nHolderConns; ++i)
+    {
+        SqlConnection* pConn = CreateConnection();
+        if (!pConn->Initialize(infoString))
+        {
+            delete pConn;
+            return false;
+        }
+
+        m_pHolderConnections.push_back(pConn);
+    }
 
     m_pResultQueue = new SqlResultQueue;
 
@@ -150,10 +255,17 @@ void Database::StopServer()
     HaltDelayThread();
 
     delete m_pResultQueue;
-    delete m_pAsyncConn;
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
+        delete m_pAsyncConnection;
 
     m_pResultQueue = nullptr;
     m_pAsyncConn = nullptr;
+    m_pAsyncConnections.clear();
+
+    for (auto& m_pHolderConnection : m_pHolderConnections)
+        delete m_pHolderConnection;
+
+    m_pHolderConnections.clear();
 
     for (auto& m_pQueryConnection : m_pQueryConnections)
         delete m_pQueryConnection;
@@ -161,30 +273,127 @@ void Database::StopServer()
     m_pQueryConnections.clear();
 }
 
-SqlDelayThread* Database::CreateDelayThread()
+SqlDelayThread* Database::CreateDelayThread(SqlConnection* conn, uint32 index)
 {
-    assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    assert(conn);
+    return new SqlDelayThread(this, conn, index);
 }
 
 void Database::InitDelayThread()
 {
-    assert(!m_delayThread);
+    assert(m_delayThreads.empty());
+
+    m_asyncSeq = 0;
+    m_lastGlobalSeq = 0;
+    m_completedGlobalSeq = 0;
+    m_lastEnqueuedSeq.assign(m_pAsyncConnections.size(), 0);
+    m_completedSeq.assign(m_pAsyncConnections.size(), 0);
 
-    // New delay thread for delay execute
-    m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
-    m_delayThread = new MaNGOS::Thread(m_threadBody);
+    // New delay threads for delay execute, one per async connection
+    for (uint32 i = 0; i < m_pAsyncConnections.size(); ++i)
+    {
+        SqlDelayThread* threadBody = CreateDelayThread(m_pAsyncConnections[i], i);  // will deleted at thread delete
+        m_threadBodies.push_back(threadBody);
+        m_delayThreads.push_back(new MaNGOS::Thread(threadBody));
+    }
+
+    for (auto& holderConnection : m_pHolderConnections)
+    {
+        SqlHolderWorker* holderBody = new SqlHolderWorker(holderConnection);    // will deleted at thread delete
+        m_holderBodies.push_back(holderBody);
+        m_holderThreads.push_back(new MaNGOS::Thread(holderBody));
+    }
 }
 
 void Database::HaltDelayThread()
 {
-    if (!m_threadBody || !m_delayThread) return;
+    if (m_threadBodies.empty() || m_delayThreads.empty()) return;
+
+    // stop all before waiting, threads may wait for requests of each other while flushing
+    for (auto& threadBody : m_threadBodies)
+        threadBody->Stop();                                 // Stop event
+
+    for (auto& delayThread : m_delayThreads)
+        delayThread->wait();                                // Wait for flush to DB
 
-    m_threadBody->Stop();                                   // Stop event
-    m_delayThread->wait();                                  // Wait for flush to DB
-    delete m_delayThread;                                   // This also deletes m_threadBody
-    m_delayThread = nullptr;
-    m_threadBody = nullptr;
+    for (auto& delayThread : m_delayThreads)
+        delete delayThread;                                 // This also deletes the thread body
+
+    m_delayThreads.clear();
+    m_threadBodies.clear();
+
+    // delay threads flushing their queues may still need the holder workers
+    for (auto& holderBody : m_holderBodies)
+        holderBody->Stop();
+
+    for (auto& holderThread : m_holderThreads)
+    {
+        holderThread->wait();
+        delete holderThread;
+    }
+
+    m_holderThreads.clear();
+    m_holderBodies.clear();
+}
+
+bool Database::DelayAsync(SqlOperation* operation, uint32 serialKey /*= 0*/)
+{
+    if (m_threadBodies.size() == 1)
+        return m_threadBodies[0]->Delay(operation);
+
+    // keyed requests only wait for unkeyed ones and unkeyed requests wait for everything queued before them,
+    // so requests of different keys run in parallel while any request still sees all writes it could depend on
+    std::lock_guard<std::mutex> guard(m_asyncOrderLock);
+
+    SqlDelayThread::Request request{ std::unique_ptr<SqlOperation>(operation), ++m_asyncSeq, 0, {} };
+    uint32 thread = 0;
+    if (serialKey)
+    {
+        thread = serialKey % m_threadBodies.size();
+        request.waitGlobal = m_lastGlobalSeq;
+    }
+    else
+    {
+        request.waitThreads = m_lastEnqueuedSeq;
+        m_lastGlobalSeq = request.seq;
+    }
+
+    m_lastEnqueuedSeq[thread] = request.seq;
+    return m_threadBodies[thread]->Delay(std::move(request));
+}
+
+void Database::WaitAsyncPredecessors(uint32 thread, SqlDelayThread::Request const& request)
+{
+    std::unique_lock<std::mutex> lock(m_asyncDoneLock);
+    m_asyncDoneCondition.wait(lock, [&]()
+    {
+        if (m_completedGlobalSeq < request.waitGlobal)
+            return false;
+
+        for (uint32 i = 0; i < request.waitThreads.size(); ++i)
+            if (i != thread && m_completedSeq[i] < request.waitThreads[i])
+                return false;
+
+        return true;
+    });
+}
+
+void Database::AsyncRequestDone(uint32 thread, SqlDelayThread::Request const& request)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_asyncDoneLock);
+        m_completedSeq[thread] = request.seq;
+        if (!request.waitThreads.empty())                   // unkeyed requests all run on the first thread, in order
+            m_completedGlobalSeq = request.seq;
+    }
+    m_asyncDoneCondition.notify_all();
+}
+
+void Database::GetAsyncQueueSizes(std::vector<uint32>& sizes) const
+{
+    sizes.clear();
+    for (auto threadBody : m_threadBodies)
+        sizes.push_back(threadBody->GetQueueSize());
 }
 
 void Database::ThreadStart()
@@ -201,6 +410,12 @@ void Database::ProcessResultQueue()
         m_pResultQueue->Update();
 }
 
+void Database::SetResultRouter(SqlResultRouter router)
+{
+    if (m_pResultQueue)
+        m_pResultQueue->SetRouter(std::move(router));
+}
+
 void Database::escape_string(std::string& str)
 {
     if (str.empty())
@@ -229,8 +444,9 @@ void Database::Ping()
 {
     const char* sql = "SELECT 1";
 
+    for (auto& m_pAsyncConnection : m_pAsyncConnections)
     {
-        SqlConnection::Lock guard(m_pAsyncConn);
+        SqlConnection::Lock guard(m_pAsyncConnection);
         delete guard->Query(sql);
     }
 
@@ -239,6 +455,12 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    for (auto& m_pHolderConnection : m_pHolderConnections)
+    {
+        SqlConnection::Lock guard(m_pHolderConnection);
+        delete guard->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char* format, ...)
@@ -321,6 +543,25 @@ QueryNamedResult* Database::PQueryNamed(const char* format, ...)
     return QueryNamed(szQuery);
 }
 
+QueryResult* Database::PQueryStream(const char* format, ...)
+{
+    if (!format) return nullptr;
+
+    va_list ap;
+    char szQuery [MAX_QUERY_LEN];
+    va_start(ap, format);
+    int res = vsnprintf(szQuery, MAX_QUERY_LEN, format, ap);
+    va_end(ap);
+
+    if (res == -1)
+    {
+        sLog.outError("SQL Query truncated (and not execute) for format: %s", format);
+        return nullptr;
+    }
+
+    return QueryStream(szQuery);
+}
+
 bool Database::Execute(const char* sql)
 {
     if (!m_pAsyncConn)
@@ -339,7 +580,7 @@ bool Database::Execute(const char* sql)
             return DirectExecute(sql);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPlainRequest(sql));
+        DelayAsync(new SqlPlainRequest(sql));
     }
 
     return true;
@@ -385,7 +626,7 @@ bool Database::DirectPExecute(const char* format, ...)
     return DirectExecute(szQuery);
 }
 
-bool Database::BeginTransaction()
+bool Database::BeginTransaction(uint32 serialKey /*= 0*/)
 {
     if (!m_pAsyncConn)
         return false;
@@ -393,7 +634,7 @@ bool Database::BeginTransaction()
     MANGOS_ASSERT(!m_currentTransaction.get());   // if we will get a nested transaction request - we MUST fix code!!!
 
     if (!m_currentTransaction.get())
-        m_currentTransaction.reset(new SqlTransaction);
+        m_currentTransaction.reset(new SqlTransaction(serialKey));
 
     return m_currentTransaction.get() != nullptr;
 }
@@ -408,7 +649,8 @@ bool Database::CommitTransaction()
         return CommitTransactionDirect();
 
     // add SqlTransaction to the async queue
-    m_threadBody->Delay(m_currentTransaction.release());
+    SqlTransaction* pTrans = m_currentTransaction.release();
+    DelayAsync(pTrans, pTrans->GetSerialKey());
     return true;
 }
 
@@ -563,7 +805,7 @@ bool Database::ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params)
             return DirectExecuteStmt(id, params);
 
         // Simple sql statement
-        m_threadBody->Delay(new SqlPreparedRequest(id.ID(), params));
+        DelayAsync(new SqlPreparedRequest(id.ID(), params));
     }
 
     return true;
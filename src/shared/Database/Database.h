@@ -21,12 +21,14 @@
 
 #include "Common.h"
 #include "Threading.h"
+#include "AllocStats.h"
 #include "Database/SqlDelayThread.h"
 #include "Policies/ThreadingModel.h"
 #include "SqlPreparedStatement.h"
 
 #include <boost/thread/tss.hpp>
 #include <atomic>
+#include <condition_variable>
 
 class SqlTransaction;
 class SqlResultQueue;
@@ -48,6 +50,9 @@ class SqlConnection
         // public methods for making queries
         virtual QueryResult* Query(const char* sql) = 0;
         virtual QueryNamedResult* QueryNamed(const char* sql) = 0;
+        // rows are fetched from the server while the result is read, the connection stays locked until the result is deleted
+        // no other query may be run on this connection meanwhile and GetRowCount() of the result is 0
+        virtual QueryResult* QueryStream(const char* sql) { return Query(sql); }
 
         // public methods for making requests
         virtual bool Execute(const char* sql) = 0;
@@ -63,6 +68,9 @@ class SqlConnection
 
         // methods to work with prepared statements
         bool ExecuteStmt(int nIndex, const SqlStmtParameters& id);
+        // plain INSERT ... VALUES (...) and DELETE ... WHERE a = ? AND b = ? statements can be merged into one multi-row request
+        bool CanBatchStmt(int nIndex);
+        bool ExecuteStmtBatch(int nIndex, SqlStmtParameters const* const* params, size_t count);
 
         // SqlConnection object lock
         class Lock
@@ -97,6 +105,19 @@ class SqlConnection
 
         typedef std::vector<SqlPreparedStatement* > StmtHolder;
         StmtHolder m_holder;
+
+        // multi-row form of a statement: head, row repeated with ", " between rows, tail
+        struct StmtBatchFormat
+        {
+            bool parsed = false;
+            bool batchable = false;
+            std::string head;
+            std::string row;
+            std::string tail;
+        };
+        std::vector<StmtBatchFormat> m_batchFormats;
+
+        StmtBatchFormat const& GetBatchFormat(uint32 nIndex);
 };
 
 class Database
@@ -104,7 +125,9 @@ class Database
     public:
         virtual ~Database();
 
-        virtual bool Initialize(const char* infoString, int nConns = 1);
+        // nAsyncConns > 1 spreads async requests with a serial key over several delay threads, see DelayAsync
+        // nHolderConns > 0 runs the queries of one query holder over several connections at once, see SqlQueryHolderEx
+        virtual bool Initialize(const char* infoString, int nConns = 1, int nAsyncConns = 1, int nHolderConns = 0);
         // start worker thread for async DB request execution
         virtual void InitDelayThread();
         // stop worker thread
@@ -113,18 +136,29 @@ class Database
         /// Synchronous DB queries
         inline QueryResult* Query(const char* sql)
         {
+            AllocTagScope allocTag(ALLOC_TAG_DATABASE);
             SqlConnection::Lock guard(getQueryConnection());
             return guard->Query(sql);
         }
 
         inline QueryNamedResult* QueryNamed(const char* sql)
         {
+            AllocTagScope allocTag(ALLOC_TAG_DATABASE);
             SqlConnection::Lock guard(getQueryConnection());
             return guard->QueryNamed(sql);
         }
 
+        // for big single pass loads, avoids holding the whole result set in the client library, see SqlConnection::QueryStream
+        inline QueryResult* QueryStream(const char* sql)
+        {
+            AllocTagScope allocTag(ALLOC_TAG_DATABASE);
+            SqlConnection::Lock guard(getQueryConnection());
+            return guard->QueryStream(sql);
+        }
+
         QueryResult* PQuery(const char* format, ...) ATTR_PRINTF(2, 3);
         QueryNamedResult* PQueryNamed(const char* format, ...) ATTR_PRINTF(2, 3);
+        QueryResult* PQueryStream(const char* format, ...) ATTR_PRINTF(2, 3);
 
         bool DirectExecute(const char* sql) const
         {
@@ -176,6 +210,15 @@ class Database
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
         template<class Class, typename ParamType1>
         bool DelayQueryHolder(Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*, ParamType1), SqlQueryHolder* holder, ParamType1 param1);
+        // Routed, the callback is handed to the result router instead of being executed by ProcessResultQueue
+        template<typename ParamType1>
+        bool AsyncQuery(SqlResultRoute route, void (*method)(QueryResult*, ParamType1), ParamType1 param1, const char* sql);
+        template<typename ParamType1>
+        bool AsyncPQuery(SqlResultRoute route, void (*method)(QueryResult*, ParamType1), ParamType1 param1, const char* format, ...) ATTR_PRINTF(5, 6);
+        template<class Class>
+        bool DelayQueryHolder(SqlResultRoute route, Class* object, void (Class::*method)(QueryResult*, SqlQueryHolder*), SqlQueryHolder* holder);
+        // without a router routed callbacks are executed like the others
+        void SetResultRouter(SqlResultRouter router);
 
         bool Execute(const char* sql);
         bool PExecute(const char* format, ...) ATTR_PRINTF(2, 3);
@@ -183,11 +226,14 @@ class Database
         // Writes SQL commands to a LOG file (see mangosd.conf "LogSQL")
         bool PExecuteLog(const char* format, ...) ATTR_PRINTF(2, 3);
 
-        bool BeginTransaction();
+        // transactions with the same non zero serial key (character or account id) keep their order,
+        // transactions with different keys may execute in parallel when several async connections are used
+        bool BeginTransaction(uint32 serialKey = 0);
         bool CommitTransaction();
         bool RollbackTransaction();
         // for sync transaction execution
         bool CommitTransactionDirect();
+        bool IsInTransaction() const { return m_currentTransaction.get() != nullptr; }
 
         // PREPARED STATEMENT API
 
@@ -209,6 +255,13 @@ class Database
         // set database-wide result queue. also we should use object-bases and not thread-based result queues
         void ProcessResultQueue();
 
+        // queue an operation for the delay threads, serial key 0 is ordered against every other operation
+        bool DelayAsync(SqlOperation* operation, uint32 serialKey = 0);
+        // requests waiting in the queue of each delay thread
+        void GetAsyncQueueSizes(std::vector<uint32>& sizes) const;
+        // workers sharing the queries of a holder with the delay thread executing it
+        std::vector<SqlHolderWorker*> const& GetHolderWorkers() const { return m_holderBodies; }
+
         bool CheckRequiredField(char const* table_name, char const* required_name);
         uint32 GetPingIntervall() const { return m_pingIntervallms; }
 
@@ -223,7 +276,7 @@ class Database
     protected:
         Database() :
             m_nQueryConnPoolSize(1), m_pAsyncConn(nullptr), m_pResultQueue(nullptr),
-            m_threadBody(nullptr), m_delayThread(nullptr), m_allowAsyncTransactions(false),
+            m_asyncSeq(0), m_lastGlobalSeq(0), m_completedGlobalSeq(0), m_allowAsyncTransactions(false),
             m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0)
         {
             m_nQueryCounter = -1;
@@ -234,7 +287,7 @@ class Database
         // factory method to create SqlConnection objects
         virtual SqlConnection* CreateConnection() = 0;
         // factory method to create SqlDelayThread objects
-        virtual SqlDelayThread* CreateDelayThread();
+        virtual SqlDelayThread* CreateDelayThread(SqlConnection* conn, uint32 index);
 
         // per-thread based storage for SqlTransaction object initialization - no locking is required
         boost::thread_specific_ptr<SqlTransaction> m_currentTransaction;
@@ -247,6 +300,11 @@ class Database
         SqlConnection* getAsyncConnection() const { return m_pAsyncConn; }
 
         friend class SqlStatement;
+        friend class SqlDelayThread;
+        // ordering between delay threads, called by the delay thread executing the request
+        void WaitAsyncPredecessors(uint32 thread, SqlDelayThread::Request const& request);
+        void AsyncRequestDone(uint32 thread, SqlDelayThread::Request const& request);
+
         // PREPARED STATEMENT API
         // query function for prepared statements
         bool ExecuteStmt(const SqlStatementID& id, SqlStmtParameters* params);
@@ -260,12 +318,27 @@ class Database
         typedef std::vector< SqlConnection* > SqlConnectionContainer;
         SqlConnectionContainer m_pQueryConnections;
 
-        // only one single DB connection for transactions
+        // one DB connection per delay thread, the first one is also used for direct execution
+        SqlConnectionContainer m_pAsyncConnections;
         SqlConnection* m_pAsyncConn;
 
         SqlResultQueue*     m_pResultQueue;                 ///< Transaction queues from diff. threads
-        SqlDelayThread*     m_threadBody;                   ///< Pointer to delay sql executer (owned by m_delayThread)
-        MaNGOS::Thread*     m_delayThread;                  ///< Pointer to executer thread
+        std::vector<SqlDelayThread*> m_threadBodies;        ///< Delay sql executers (owned by m_delayThreads)
+        std::vector<MaNGOS::Thread*> m_delayThreads;        ///< Executer threads
+
+        SqlConnectionContainer m_pHolderConnections;        ///< one per holder worker
+        std::vector<SqlHolderWorker*> m_holderBodies;       ///< (owned by m_holderThreads)
+        std::vector<MaNGOS::Thread*> m_holderThreads;
+
+        // request order between delay threads, unused with a single delay thread
+        std::mutex m_asyncOrderLock;                        ///< serializes sequence assignment and enqueueing
+        uint64 m_asyncSeq;
+        uint64 m_lastGlobalSeq;                             ///< last request without serial key
+        std::vector<uint64> m_lastEnqueuedSeq;              ///< last request per delay thread
+        std::mutex m_asyncDoneLock;
+        std::condition_variable m_asyncDoneCondition;
+        uint64 m_completedGlobalSeq;
+        std::vector<uint64> m_completedSeq;                 ///< last executed request per delay thread
 
         std::atomic<bool> m_allowAsyncTransactions;         ///< flag which specifies if async transactions are enabled
 
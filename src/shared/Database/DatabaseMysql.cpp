@@ -172,9 +172,20 @@ bool MySQLConnection::Initialize(const char* infoString)
     return true;
 }
 
-bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount)
+bool MySQLConnection::_IsStreaming(const char* sql) const
 {
-    if (!mMysql)
+    if (!mStreaming)
+        return false;
+
+    // the client library can't run anything before all rows of an unbuffered result are read
+    sLog.outError("SQL: %s", sql);
+    sLog.outError("SQL ERROR: connection is still reading an unbuffered result");
+    return true;
+}
+
+bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount, bool stream /*= false*/)
+{
+    if (!mMysql || _IsStreaming(sql))
         return false;
 
     uint32 _s = WorldTimer::getMSTime();
@@ -187,6 +198,20 @@ bool MySQLConnection::_Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD**
     }
     DEBUG_FILTER_LOG(LOG_FILTER_SQL_TEXT, "[%u ms] SQL: %s", WorldTimer::getMSTimeDiff(_s, WorldTimer::getMSTime()), sql);
 
+    if (stream)
+    {
+        // row count is unknown until the last row is fetched
+        *pResult = mysql_use_result(mMysql);
+        *pRowCount = 0;
+        *pFieldCount = mysql_field_count(mMysql);
+
+        if (!*pResult)
+            return false;
+
+        *pFields = mysql_fetch_fields(*pResult);
+        return true;
+    }
+
     *pResult = mysql_store_result(mMysql);
     *pRowCount = mysql_affected_rows(mMysql);
     *pFieldCount = mysql_field_count(mMysql);
@@ -240,9 +265,31 @@ QueryNamedResult* MySQLConnection::QueryNamed(const char* sql)
     return new QueryNamedResult(queryResult, names);
 }
 
+QueryResult* MySQLConnection::QueryStream(const char* sql)
+{
+    MYSQL_RES* result = nullptr;
+    MYSQL_FIELD* fields = nullptr;
+    uint64 rowCount = 0;
+    uint32 fieldCount = 0;
+
+    if (!_Query(sql, &result, &fields, &rowCount, &fieldCount, true))
+        return nullptr;
+
+    QueryResultMysql* queryResult = new QueryResultMysql(result, fields, fieldCount, this, &mStreaming);
+
+    // same as Query, empty result is returned as nullptr
+    if (!queryResult->NextRow())
+    {
+        delete queryResult;
+        return nullptr;
+    }
+
+    return queryResult;
+}
+
 bool MySQLConnection::Execute(const char* sql)
 {
-    if (!mMysql)
+    if (!mMysql || _IsStreaming(sql))
         return false;
 
     {
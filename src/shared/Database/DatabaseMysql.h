@@ -62,7 +62,7 @@ class MySqlPreparedStatement : public SqlPreparedStatement
 class MySQLConnection : public SqlConnection
 {
     public:
-        MySQLConnection(Database& db) : SqlConnection(db), mMysql(nullptr) {}
+        MySQLConnection(Database& db) : SqlConnection(db), mMysql(nullptr), mStreaming(false) {}
         ~MySQLConnection();
 
         //! Initializes Mysql and connects to a server.
@@ -71,6 +71,7 @@ class MySQLConnection : public SqlConnection
 
         QueryResult* Query(const char* sql) override;
         QueryNamedResult* QueryNamed(const char* sql) override;
+        QueryResult* QueryStream(const char* sql) override;
         bool Execute(const char* sql) override;
 
         unsigned long escape_string(char* to, const char* from, unsigned long length);
@@ -84,9 +85,11 @@ class MySQLConnection : public SqlConnection
 
     private:
         bool _TransactionCmd(const char* sql);
-        bool _Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount);
+        bool _Query(const char* sql, MYSQL_RES** pResult, MYSQL_FIELD** pFields, uint64* pRowCount, uint32* pFieldCount, bool stream = false);
+        bool _IsStreaming(const char* sql) const;
 
         MYSQL* mMysql;
+        bool mStreaming;                                    // an unbuffered result is still being read
 };
 
 class DatabaseMysql : public Database
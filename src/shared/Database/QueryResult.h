@@ -23,6 +23,8 @@
 #include "Errors.h"
 #include "Field.h"
 
+#include <memory>
+
 class QueryResult
 {
     public:
@@ -46,6 +48,84 @@ class QueryResult
         uint64 mRowCount;
 };
 
+// Rows of a result copied into memory, served any number of times by QueryResultCopy
+class QueryResultRows
+{
+    public:
+        // takes the rows left in result, the current one first, and deletes it
+        explicit QueryResultRows(QueryResult* result) : m_fieldCount(result->GetFieldCount()), m_rowCount(0)
+        {
+            Field* fields = result->Fetch();
+            for (uint32 i = 0; i < m_fieldCount; ++i)
+                m_types.push_back(fields[i].GetType());
+
+            do
+            {
+                fields = result->Fetch();
+                for (uint32 i = 0; i < m_fieldCount; ++i)
+                {
+                    m_nulls.push_back(fields[i].IsNULL());
+                    m_values.push_back(fields[i].GetCppString());
+                }
+                ++m_rowCount;
+            }
+            while (result->NextRow());
+
+            delete result;
+        }
+
+    private:
+        friend class QueryResultCopy;
+
+        uint32 m_fieldCount;
+        uint64 m_rowCount;
+        std::vector<Field::DataTypes> m_types;
+        std::vector<std::string> m_values;                  // row by row
+        std::vector<bool> m_nulls;
+};
+
+class QueryResultCopy : public QueryResult
+{
+    public:
+        explicit QueryResultCopy(std::shared_ptr<QueryResultRows const> rows)
+            : QueryResult(rows->m_rowCount, rows->m_fieldCount), m_rows(std::move(rows)), m_row(0)
+        {
+            mCurrentRow = new Field[mFieldCount];
+            for (uint32 i = 0; i < mFieldCount; ++i)
+                mCurrentRow[i].SetType(m_rows->m_types[i]);
+            SetRow();
+        }
+
+        ~QueryResultCopy() { delete[] mCurrentRow; }
+
+        bool NextRow() override
+        {
+            if (!mCurrentRow)
+                return false;
+
+            if (++m_row >= mRowCount)
+            {
+                delete[] mCurrentRow;
+                mCurrentRow = nullptr;
+                return false;
+            }
+
+            SetRow();
+            return true;
+        }
+
+    private:
+        void SetRow()
+        {
+            size_t first = size_t(m_row) * mFieldCount;
+            for (uint32 i = 0; i < mFieldCount; ++i)
+                mCurrentRow[i].SetValue(m_rows->m_nulls[first + i] ? nullptr : m_rows->m_values[first + i].c_str());
+        }
+
+        std::shared_ptr<QueryResultRows const> m_rows;
+        uint64 m_row;
+};
+
 typedef std::vector<std::string> QueryFieldNames;
 
 class QueryNamedResult
@@ -22,7 +22,7 @@
 #include "Errors.h"
 
 QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount) :
-    QueryResult(rowCount, fieldCount), mResult(result)
+    QueryResult(rowCount, fieldCount), mResult(result), mStreaming(nullptr)
 {
     mCurrentRow = new Field[mFieldCount];
     MANGOS_ASSERT(mCurrentRow);
@@ -31,6 +31,18 @@ QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint6
         mCurrentRow[i].SetType(ConvertNativeType(fields[i].type));
 }
 
+QueryResultMysql::QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, SqlConnection* conn, bool* streaming) :
+    QueryResult(0, fieldCount), mResult(result), mConnectionLock(new SqlConnection::Lock(conn)), mStreaming(streaming)
+{
+    *mStreaming = true;
+
+    mCurrentRow = new Field[mFieldCount];
+    MANGOS_ASSERT(mCurrentRow);
+
+    for (uint32 i = 0; i < mFieldCount; ++i)
+        mCurrentRow[i].SetType(ConvertNativeType(fields[i].type));
+}
+
 QueryResultMysql::~QueryResultMysql()
 {
     EndQuery();
@@ -44,6 +56,10 @@ bool QueryResultMysql::NextRow()
     MYSQL_ROW row = mysql_fetch_row(mResult);
     if (!row)
     {
+        // an unbuffered result reports a lost connection only here
+        if (mStreaming && mysql_errno(mResult->handle))
+            sLog.outErrorDb("query ERROR while fetching rows: %s", mysql_error(mResult->handle));
+
         EndQuery();
         return false;
     }
@@ -61,9 +77,16 @@ void QueryResultMysql::EndQuery()
 
     if (mResult)
     {
-        mysql_free_result(mResult);
+        mysql_free_result(mResult);                         // for an unbuffered result this also skips the rows not read
         mResult = nullptr;
     }
+
+    if (mStreaming)
+    {
+        *mStreaming = false;
+        mStreaming = nullptr;
+        mConnectionLock.reset();
+    }
 }
 
 enum Field::DataTypes QueryResultMysql::ConvertNativeType(enum_field_types mysqlType) const
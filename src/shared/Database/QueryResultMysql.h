@@ -22,6 +22,7 @@
 #define QUERYRESULTMYSQL_H
 
 #include "Common.h"
+#include "Database/Database.h"
 
 #ifdef _WIN32
   #include <WinSock2.h>
@@ -33,6 +34,8 @@ class QueryResultMysql : public QueryResult
 {
     public:
         QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint64 rowCount, uint32 fieldCount);
+        // unbuffered result, keeps the connection locked and marked busy until the result is done
+        QueryResultMysql(MYSQL_RES* result, MYSQL_FIELD* fields, uint32 fieldCount, SqlConnection* conn, bool* streaming);
 
         ~QueryResultMysql();
 
@@ -43,6 +46,8 @@ class QueryResultMysql : public QueryResult
         void EndQuery();
 
         MYSQL_RES* mResult;
+        std::unique_ptr<SqlConnection::Lock> mConnectionLock;
+        bool* mStreaming;
 };
 #endif
 #endif
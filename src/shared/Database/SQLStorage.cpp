@@ -17,6 +17,9 @@
  */
 
 #include "SQLStorage.h"
+#include "revision_sql.h"
+
+#include <cstdio>
 
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
@@ -65,6 +68,32 @@ void SQLStorageBase::prepareToLoad(uint32 maxEntry, uint32 recordCount, uint32 r
     m_recordCount = 0;
 }
 
+uint32 SQLStorageBase::GetDstFieldSize(uint32 idx) const
+{
+    switch (m_dst_format[idx])
+    {
+        case FT_LOGIC:
+            return sizeof(bool);
+        case FT_STRING:
+        case FT_NA_POINTER:
+            return sizeof(char*);
+        case FT_NA:
+        case FT_INT:
+            return sizeof(uint32);
+        case FT_BYTE:
+        case FT_NA_BYTE:
+            return sizeof(char);
+        case FT_FLOAT:
+        case FT_NA_FLOAT:
+            return sizeof(float);
+        case FT_64BITINT:
+            return sizeof(uint64);
+        default:
+            assert(false && "unknown format character");
+            return 0;
+    }
+}
+
 // Function to delete the data
 void SQLStorageBase::Free()
 {
@@ -120,6 +149,209 @@ void SQLStorageBase::Free()
     m_recordCount = 0;
 }
 
+// -----------------------------------  Cache  ------------------------------------------------- //
+
+std::string SQLStorageBase::s_cacheDirectory;
+
+static uint32 const SQL_STORAGE_CACHE_MAGIC = 0x43514C53;  // "SLQC"
+
+struct SQLStorageCacheHeader
+{
+    uint32 magic;
+    uint32 keySize;
+    uint32 maxEntry;
+    uint32 recordCount;
+    uint32 recordSize;
+};
+
+std::string SQLStorageBase::GetCacheKey() const
+{
+#ifdef DO_POSTGRESQL
+    return "";
+#else
+    if (s_cacheDirectory.empty())
+        return "";
+
+    // checksum is computed by the server, so this is far cheaper than transferring the table
+    QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE %s", m_tableName);
+    if (!result)
+        return "";
+
+    std::string checksum = (*result)[1].GetCppString();
+    delete result;
+
+    if (checksum.empty())                                   // NULL for not existing table
+        return "";
+
+    std::ostringstream key;
+    key << REVISION_DB_MANGOS << ';' << m_tableName << ';' << checksum << ';' << m_src_format << ';' << m_dst_format << ';' << sizeof(char*);
+    return key.str();
+#endif
+}
+
+bool SQLStorageBase::LoadFromCache(std::string const& key)
+{
+    std::string fileName = s_cacheDirectory + "/" + m_tableName + ".cache";
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return false;
+
+    SQLStorageCacheHeader header;
+    std::string fileKey;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 && header.magic == SQL_STORAGE_CACHE_MAGIC && header.keySize == key.size();
+    if (valid)
+    {
+        fileKey.resize(header.keySize);
+        valid = fread(&fileKey[0], 1, header.keySize, file) == header.keySize && fileKey == key;
+    }
+
+    std::vector<uint32> recordIds;
+    if (valid)
+    {
+        recordIds.resize(header.recordCount);
+        valid = fread(recordIds.data(), sizeof(uint32), header.recordCount, file) == header.recordCount;
+    }
+
+    if (!valid)
+    {
+        fclose(file);
+        return false;
+    }
+
+    prepareToLoad(header.maxEntry, header.recordCount, header.recordSize);
+
+    valid = fread(m_data, header.recordSize, header.recordCount, file) == header.recordCount;
+
+    // stale pointers from the file must not be freed if the strings below can't be read
+    for (uint32 i = 0; valid && i < header.recordCount; ++i)
+    {
+        uint32 offset = 0;
+        for (uint32 x = 0; x < m_dstFieldCount; ++x)
+        {
+            if (m_dst_format[x] == FT_STRING || m_dst_format[x] == FT_NA_POINTER)
+                *(char**)(m_data + i * m_recordSize + offset) = nullptr;
+            offset += GetDstFieldSize(x);
+        }
+    }
+
+    // rebuild the string fields, the file holds their length and text after the records
+    for (uint32 i = 0; valid && i < header.recordCount; ++i)
+    {
+        char* record = createRecord(recordIds[i]);
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < m_dstFieldCount; ++x)
+        {
+            switch (m_dst_format[x])
+            {
+                case FT_STRING:
+                case FT_NA_POINTER:
+                {
+                    char*& str = *(char**)(record + offset);
+                    uint32 length = 0;
+                    if (fread(&length, sizeof(length), 1, file) != 1)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    str = new char[length + 1];
+                    valid = fread(str, 1, length, file) == length;
+                    str[length] = 0;
+                    offset += sizeof(char*);
+                    break;
+                }
+                default:
+                    offset += GetDstFieldSize(x);
+                    break;
+            }
+
+            if (!valid)
+                break;
+        }
+    }
+
+    fclose(file);
+
+    if (!valid)
+    {
+        sLog.outError("SQLStorage: cache file %s is damaged, loading `%s` from DB", fileName.c_str(), m_tableName);
+        // Free() releases only FT_STRING fields
+        for (uint32 i = 0; i < m_recordCount; ++i)
+        {
+            char* record = m_data + i * m_recordSize;
+            uint32 offset = 0;
+            for (uint32 x = 0; x < m_dstFieldCount; ++x)
+            {
+                if (m_dst_format[x] == FT_NA_POINTER)
+                    delete[] *(char**)(record + offset);
+                offset += GetDstFieldSize(x);
+            }
+        }
+        Free();
+        return false;
+    }
+
+    return true;
+}
+
+void SQLStorageBase::SaveToCache(std::string const& key, std::vector<uint32> const& recordIds) const
+{
+    if (!m_recordCount || recordIds.size() != m_recordCount)
+        return;
+
+    std::string fileName = s_cacheDirectory + "/" + m_tableName + ".cache";
+    std::string tmpName = fileName + ".tmp";
+    FILE* file = fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("SQLStorage: can't write cache file %s", tmpName.c_str());
+        return;
+    }
+
+    SQLStorageCacheHeader header;
+    header.magic = SQL_STORAGE_CACHE_MAGIC;
+    header.keySize = key.size();
+    header.maxEntry = m_maxEntry;
+    header.recordCount = m_recordCount;
+    header.recordSize = m_recordSize;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    written = written && fwrite(key.data(), 1, key.size(), file) == key.size();
+    written = written && fwrite(recordIds.data(), sizeof(uint32), recordIds.size(), file) == recordIds.size();
+    // pointer fields are written as they are and replaced at load
+    written = written && fwrite(m_data, m_recordSize, m_recordCount, file) == m_recordCount;
+
+    for (uint32 i = 0; written && i < m_recordCount; ++i)
+    {
+        char const* record = m_data + i * m_recordSize;
+        uint32 offset = 0;
+        for (uint32 x = 0; written && x < m_dstFieldCount; ++x)
+        {
+            if (m_dst_format[x] == FT_STRING || m_dst_format[x] == FT_NA_POINTER)
+            {
+                char const* str = *(char* const*)(record + offset);
+                uint32 length = str ? uint32(strlen(str)) : 0;
+                written = fwrite(&length, sizeof(length), 1, file) == 1 && fwrite(str, 1, length, file) == length;
+            }
+            offset += GetDstFieldSize(x);
+        }
+    }
+
+    if (fclose(file) != 0)
+        written = false;
+
+#ifdef _WIN32
+    if (written)
+        remove(fileName.c_str());                           // rename does not replace an existing file here
+#endif
+
+    if (!written || rename(tmpName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("SQLStorage: can't write cache file %s", fileName.c_str());
+        remove(tmpName.c_str());
+    }
+}
+
 // -----------------------------------  SQLStorage  -------------------------------------------- //
 
 void SQLStorage::EraseEntry(uint32 id)
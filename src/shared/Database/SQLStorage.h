@@ -39,6 +39,9 @@ class SQLStorageBase
         uint32 GetMaxEntry() const { return m_maxEntry; };
         uint32 GetRecordCount() const { return m_recordCount; };
 
+        // directory for binary copies of the loaded tables, used instead of the DB while the table is unchanged. Empty disables them
+        static void SetCacheDirectory(std::string const& directory) { s_cacheDirectory = directory; }
+
         template<typename T>
         class SQLSIterator
         {
@@ -78,8 +81,14 @@ class SQLStorageBase
         virtual void JustCreatedRecord(uint32 recordId, char* record) = 0;
         virtual void Free();
 
+        // identifies DB revision, table content and record layout, empty if no cache can be used
+        std::string GetCacheKey() const;
+        bool LoadFromCache(std::string const& key);
+        void SaveToCache(std::string const& key, std::vector<uint32> const& recordIds) const;
+
     private:
         char* createRecord(uint32 recordId);
+        uint32 GetDstFieldSize(uint32 idx) const;
 
         // Information about the table
         const char* m_tableName;
@@ -96,6 +105,8 @@ class SQLStorageBase
 
         // Data Storage
         char* m_data;
+
+        static std::string s_cacheDirectory;
 };
 
 class SQLStorage : public SQLStorageBase
@@ -262,6 +273,8 @@ class SQLStorageLoaderBase
         void convert_str_to_str(uint32 field_pos, char const* src, char*& dst);
         template<class S, class D>
         void default_fill(uint32 field_pos, S src, D& dst);
+        // added to the cache key by loaders whose conversions depend on other data
+        std::string GetCacheKeyExtra() const { return ""; }
         void default_fill_to_str(uint32 field_pos, char const* src, char*& dst);
 
         // trap, no body
@@ -306,6 +306,16 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = nullptr;
+
+    std::string cacheKey = store.GetCacheKey();
+    if (!cacheKey.empty())
+        cacheKey += ';' + static_cast<DerivedLoader*>(this)->GetCacheKeyExtra();
+    if (!cacheKey.empty() && store.LoadFromCache(cacheKey))
+    {
+        sLog.outString(">> Loaded %u %s records from cache", store.GetRecordCount(), store.GetTableName());
+        return;
+    }
+
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(%s) FROM %s", store.EntryFieldName(), store.GetTableName());
     if (!result)
     {
@@ -327,7 +337,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         delete result;
     }
 
-    result = WorldDatabase.PQuery("SELECT * FROM %s", store.GetTableName());
+    // rows are parsed into the storage while they arrive
+    result = WorldDatabase.PQueryStream("SELECT * FROM %s", store.GetTableName());
 
     if (!result)
     {
@@ -388,6 +399,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
+    std::vector<uint32> recordIds;
+    if (!cacheKey.empty())
+        recordIds.reserve(recordCount);
+
     BarGoLink bar(recordCount);
     do
     {
@@ -395,6 +410,8 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
+        if (!cacheKey.empty())
+            recordIds.push_back(fields[0].GetUInt32());
         offset = 0;
 
         // dependend on dest-size
@@ -445,6 +462,10 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    // written before any of the loaders fixing up records run, they do the same on the cached copy
+    if (!cacheKey.empty())
+        store.SaveToCache(cacheKey, recordIds);
 }
 
 #endif
@@ -19,15 +19,17 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Trace.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, uint32 index) : m_dbEngine(db), m_dbConnection(conn), m_index(index), m_running(true), m_queueSize(0)
 {
 }
 
 SqlDelayThread::~SqlDelayThread()
 {
     // process all requests which might have been queued while thread was stopping
-    ProcessRequests();
+    // other delay threads may already be gone, so their ordering can't be waited for anymore
+    ProcessRequests(false);
 }
 
 void SqlDelayThread::run()
@@ -36,6 +38,8 @@ void SqlDelayThread::run()
     mysql_thread_init();
 #endif
 
+    AllocStats::SetThreadTag(ALLOC_TAG_DATABASE);
+
     const uint32 loopSleepms = 10;
 
     const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
@@ -47,15 +51,20 @@ void SqlDelayThread::run()
         // empty the queue before exiting
         MaNGOS::Thread::Sleep(loopSleepms);
 
-        ProcessRequests();
+        ProcessRequests(true);
 
-        if ((loopCounter++) >= pingEveryLoop)
+        // first delay thread pings all connections of the database
+        if (m_index == 0 && (loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
             m_dbEngine->Ping();
         }
     }
 
+    // flush what was queued while stopping, requests of other delay threads may depend on it
+    while (GetQueueSize())
+        ProcessRequests(true);
+
 #ifndef DO_POSTGRESQL
     mysql_thread_end();
 #endif
@@ -66,9 +75,10 @@ void SqlDelayThread::Stop()
     m_running = false;
 }
 
-void SqlDelayThread::ProcessRequests()
+void SqlDelayThread::ProcessRequests(bool ordered)
 {
-    std::queue<std::unique_ptr<SqlOperation>> sqlQueue;
+    TRACE_ZONE("SqlDelayThread::ProcessRequests");
+    std::queue<Request> sqlQueue;
 
     // we need to move the contents of the queue to a local copy because executing these statements with the
     // lock in place can result in a deadlock with the world thread which calls Database::ProcessResultQueue()
@@ -79,8 +89,55 @@ void SqlDelayThread::ProcessRequests()
 
     while (!sqlQueue.empty())
     {
-        auto const s = std::move(sqlQueue.front());
+        Request request = std::move(sqlQueue.front());
         sqlQueue.pop();
-        s->Execute(m_dbConnection);
+
+        if (ordered && request.seq)
+            m_dbEngine->WaitAsyncPredecessors(m_index, request);
+
+        request.operation->Execute(m_dbConnection);
+        --m_queueSize;
+
+        if (request.seq)
+            m_dbEngine->AsyncRequestDone(m_index, request);
+    }
+}
+
+void SqlHolderWorker::Stop()
+{
+    std::lock_guard<std::mutex> guard(m_queueMutex);
+    m_running = false;
+    m_queueCondition.notify_one();
+}
+
+void SqlHolderWorker::run()
+{
+#ifndef DO_POSTGRESQL
+    mysql_thread_init();
+#endif
+
+    AllocStats::SetThreadTag(ALLOC_TAG_DATABASE);
+
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this]() { return !m_queue.empty() || !m_running; });
+
+            // a delay thread may still wait for queued tasks when stopping
+            if (m_queue.empty())
+                break;
+
+            task = std::move(m_queue.front());
+            m_queue.pop();
+        }
+
+        SqlConnection::Lock guard(m_dbConnection);
+        task(m_dbConnection);
     }
+
+#ifndef DO_POSTGRESQL
+    mysql_thread_end();
+#endif
 }
@@ -23,9 +23,12 @@
 #include "SqlOperations.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 class Database;
 class SqlOperation;
@@ -33,29 +36,76 @@ class SqlConnection;
 
 class SqlDelayThread : public MaNGOS::Runnable
 {
+    public:
+        // seq 0 - unordered, the database has a single delay thread
+        struct Request
+        {
+            std::unique_ptr<SqlOperation> operation;
+            uint64 seq;
+            uint64 waitGlobal;                              ///< keyed request, last unkeyed request enqueued before it
+            std::vector<uint64> waitThreads;                ///< unkeyed request, last request enqueued to each delay thread before it
+        };
+
     private:
         std::mutex m_queueMutex;
-        std::queue<std::unique_ptr<SqlOperation>> m_sqlQueue;   ///< Queue of SQL statements
+        std::queue<Request> m_sqlQueue;                         ///< Queue of SQL statements
         Database* m_dbEngine;                                   ///< Pointer to used Database engine
         SqlConnection* m_dbConnection;                          ///< Pointer to DB connection
+        uint32 m_index;                                         ///< Position in the database delay thread pool
         std::atomic<bool> m_running;
+        std::atomic<uint32> m_queueSize;
 
-        // process all enqueued requests
-        void ProcessRequests();
+        // process all enqueued requests, ordered - wait for requests of other delay threads they depend on
+        void ProcessRequests(bool ordered);
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, uint32 index = 0);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
         bool Delay(SqlOperation* sql)
+        {
+            return Delay(Request{ std::unique_ptr<SqlOperation>(sql), 0, 0, {} });
+        }
+
+        bool Delay(Request&& request)
         {
             std::lock_guard<std::mutex> guard(m_queueMutex);
-            m_sqlQueue.push(std::unique_ptr<SqlOperation>(sql));
+            m_sqlQueue.push(std::move(request));
+            ++m_queueSize;
             return true;
         }
 
+        uint32 GetQueueSize() const { return m_queueSize; }
+        SqlConnection* GetConnection() const { return m_dbConnection; }
+
         virtual void Stop();                                ///< Stop event
         virtual void run();                                 ///< Main Thread loop
 };
+
+// Runs parts of query holders for the delay threads on its own connection, see SqlQueryHolderEx
+class SqlHolderWorker : public MaNGOS::Runnable
+{
+    public:
+        typedef std::function<void(SqlConnection*)> Task;
+
+        explicit SqlHolderWorker(SqlConnection* conn) : m_dbConnection(conn), m_running(true) {}
+
+        void Delay(Task&& task)
+        {
+            std::lock_guard<std::mutex> guard(m_queueMutex);
+            m_queue.push(std::move(task));
+            m_queueCondition.notify_one();
+        }
+
+        void Stop();
+        void run() override;
+
+    private:
+        std::mutex m_queueMutex;
+        std::condition_variable m_queueCondition;           ///< woken for every task, a delay thread waits for it
+        std::queue<Task> m_queue;
+        SqlConnection* m_dbConnection;
+        bool m_running;                                     ///< guarded by m_queueMutex
+};
 #endif                                                      //__SQLDELAYTHREAD_H
@@ -21,10 +21,14 @@
 #include "DatabaseEnv.h"
 #include "DatabaseImpl.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdarg>
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
+#define MAX_TRANSACTION_BATCH_ROWS 256
+
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
 
 bool SqlPlainRequest::Execute(SqlConnection* conn)
@@ -52,11 +56,40 @@ bool SqlTransaction::Execute(SqlConnection* conn)
 
     conn->BeginTransaction();
 
+    std::vector<SqlStmtParameters const*> batch;
+
     const int nItems = m_queue.size();
     for (int i = 0; i < nItems; ++i)
     {
         SqlOperation* pStmt = m_queue[i];
 
+        // consecutive executions of the same statement are sent as one multi-row request
+        if (SqlPreparedRequest* pRequest = dynamic_cast<SqlPreparedRequest*>(pStmt))
+        {
+            batch.clear();
+            batch.push_back(pRequest->GetParams());
+            for (int j = i + 1; j < nItems && batch.size() < MAX_TRANSACTION_BATCH_ROWS; ++j)
+            {
+                SqlPreparedRequest* pNext = dynamic_cast<SqlPreparedRequest*>(m_queue[j]);
+                if (!pNext || pNext->GetIndex() != pRequest->GetIndex())
+                    break;
+
+                batch.push_back(pNext->GetParams());
+            }
+
+            if (batch.size() > 1 && conn->CanBatchStmt(pRequest->GetIndex()))
+            {
+                if (!conn->ExecuteStmtBatch(pRequest->GetIndex(), batch.data(), batch.size()))
+                {
+                    conn->RollbackTransaction();
+                    return false;
+                }
+
+                i += batch.size() - 1;
+                continue;
+            }
+        }
+
         if (!pStmt->Execute(conn))
         {
             conn->RollbackTransaction();
@@ -93,7 +126,7 @@ bool SqlQuery::Execute(SqlConnection* conn)
     /// execute the query and store the result in the callback
     m_callback->SetResult(conn->Query(&m_sql[0]));
     /// add the callback to the sql result queue of the thread it originated from
-    m_queue->Add(m_callback);
+    m_queue->Add(m_callback, m_route);
 
     return true;
 }
@@ -102,30 +135,40 @@ void SqlResultQueue::Update()
 {
     std::lock_guard<std::mutex> guard(m_mutex);
 
-    /// execute the callbacks waiting in the synchronization queue
+    /// execute the callbacks waiting in the synchronization queue, routed ones are passed on
     while (!m_queue.empty())
     {
-        auto const callback = std::move(m_queue.front());
+        uint32 const route = m_queue.front().first;
+        auto callback = std::move(m_queue.front().second);
         m_queue.pop();
-        callback->Execute();
+        if (route && m_router)
+            m_router(route, std::move(callback));
+        else
+            callback->Execute();
     }
 }
 
-void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback)
+void SqlResultQueue::Add(MaNGOS::IQueryCallback* callback, uint32 route /*= 0*/)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_queue.emplace(route, std::unique_ptr<MaNGOS::IQueryCallback>(callback));
+}
+
+void SqlResultQueue::SetRouter(SqlResultRouter router)
 {
     std::lock_guard<std::mutex> guard(m_mutex);
-    m_queue.push(std::unique_ptr<MaNGOS::IQueryCallback>(callback));
+    m_router = std::move(router);
 }
 
-bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue)
+bool SqlQueryHolder::Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue, uint32 route /*= 0*/)
 {
-    if (!callback || !thread || !queue)
+    if (!callback || !db || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue);
-    thread->Delay(holderEx);
+    SqlQueryHolderEx* holderEx = new SqlQueryHolderEx(this, callback, queue, db, route);
+    db->DelayAsync(holderEx, m_serialKey);
     return true;
 }
 
@@ -215,23 +258,56 @@ void SqlQueryHolder::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+void SqlQueryHolderEx::ExecuteSlice(SqlConnection* conn, size_t slice, size_t slices)
+{
+    /// we can do this, we are friends
+    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
+    for (size_t i = slice; i < queries.size(); i += slices)
+    {
+        /// execute the queries of the slice and pass the results
+        char const* sql = queries[i].first;
+        if (sql) m_holder->SetResult(i, conn->Query(sql));
+    }
+}
+
 bool SqlQueryHolderEx::Execute(SqlConnection* conn)
 {
     if (!m_holder || !m_callback || !m_queue)
         return false;
 
     LOCK_DB_CONN(conn);
-    /// we can do this, we are friends
-    std::vector<SqlQueryHolder::SqlResultPair>& queries = m_holder->m_queries;
-    for (size_t i = 0; i < queries.size(); ++i)
+
+    /// the holder workers take a share of the queries, so the round trips overlap
+    std::vector<SqlHolderWorker*> const& workers = m_db->GetHolderWorkers();
+    size_t const slices = std::min(workers.size() + 1, m_holder->m_queries.size());
+    if (slices > 1)
     {
-        /// execute all queries in the holder and pass the results
-        char const* sql = queries[i].first;
-        if (sql) m_holder->SetResult(i, conn->Query(sql));
+        std::mutex doneLock;
+        std::condition_variable doneCondition;
+        size_t pending = slices - 1;
+
+        for (size_t slice = 1; slice < slices; ++slice)
+        {
+            workers[slice - 1]->Delay([&, slice](SqlConnection* workerConn)
+            {
+                ExecuteSlice(workerConn, slice, slices);
+
+                std::lock_guard<std::mutex> doneGuard(doneLock);
+                if (--pending == 0)
+                    doneCondition.notify_one();
+            });
+        }
+
+        ExecuteSlice(conn, 0, slices);
+
+        std::unique_lock<std::mutex> lock(doneLock);
+        doneCondition.wait(lock, [&pending]() { return pending == 0; });
     }
+    else
+        ExecuteSlice(conn, 0, 1);
 
     /// sync with the caller thread
-    m_queue->Add(m_callback);
+    m_queue->Add(m_callback, m_route);
 
     return true;
 }
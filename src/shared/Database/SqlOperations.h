@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Utilities/Callback.h"
 
+#include <functional>
 #include <queue>
 #include <vector>
 #include <mutex>
@@ -58,12 +59,14 @@ class SqlTransaction : public SqlOperation
 {
     private:
         std::vector<SqlOperation* > m_queue;
+        uint32 m_serialKey;
 
     public:
-        SqlTransaction() {}
+        SqlTransaction(uint32 serialKey = 0) : m_serialKey(serialKey) {}
         ~SqlTransaction();
 
         void DelayExecute(SqlOperation* sql) { m_queue.push_back(sql); }
+        uint32 GetSerialKey() const { return m_serialKey; }
 
         bool Execute(SqlConnection* conn) override;
 };
@@ -76,6 +79,9 @@ class SqlPreparedRequest : public SqlOperation
 
         bool Execute(SqlConnection* conn) override;
 
+        int GetIndex() const { return m_nIndex; }
+        SqlStmtParameters const* GetParams() const { return m_param; }
+
     private:
         const int m_nIndex;
         SqlStmtParameters* m_param;
@@ -88,15 +94,28 @@ class QueryResult;                                          /// the result of on
 class SqlQueryHolder;                                       /// groups several async quries
 class SqlQueryHolderEx;                                     /// points to a holder, added to the delay thread
 
+/// target of a routed async query, handed to the result router with its completed callback
+struct SqlResultRoute
+{
+    explicit SqlResultRoute(uint32 key) : key(key) {}
+    uint32 key;
+};
+
+/// runs on the thread processing the result queue, takes over the callbacks of routed queries
+typedef std::function<void(uint32 /*route key*/, std::unique_ptr<MaNGOS::IQueryCallback>)> SqlResultRouter;
+
 class SqlResultQueue
 {
     private:
         std::mutex m_mutex;
-        std::queue<std::unique_ptr<MaNGOS::IQueryCallback>> m_queue;
+        std::queue<std::pair<uint32, std::unique_ptr<MaNGOS::IQueryCallback>>> m_queue;
+        SqlResultRouter m_router;
 
     public:
         void Update();
-        void Add(MaNGOS::IQueryCallback*);
+        // callbacks with a non zero route are handed to the router by Update, see SqlResultRoute
+        void Add(MaNGOS::IQueryCallback*, uint32 route = 0);
+        void SetRouter(SqlResultRouter router);
 };
 
 class SqlQuery : public SqlOperation
@@ -105,10 +124,11 @@ class SqlQuery : public SqlOperation
         std::vector<char> m_sql;
         MaNGOS::IQueryCallback* const m_callback;
         SqlResultQueue* const m_queue;
+        uint32 const m_route;
 
     public:
-        SqlQuery(const char* sql, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_sql(strlen(sql) + 1), m_callback(callback), m_queue(queue)
+        SqlQuery(const char* sql, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, uint32 route = 0)
+            : m_sql(strlen(sql) + 1), m_callback(callback), m_queue(queue), m_route(route)
         {
             memcpy(&m_sql[0], sql, m_sql.size());
         }
@@ -122,15 +142,18 @@ class SqlQueryHolder
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
+        uint32 m_serialKey;
     public:
-        SqlQueryHolder() {}
+        SqlQueryHolder() : m_serialKey(0) {}
         virtual ~SqlQueryHolder();
         bool SetQuery(size_t index, const char* sql);
         bool SetPQuery(size_t index, const char* format, ...) ATTR_PRINTF(3, 4);
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult* result);
-        bool Execute(MaNGOS::IQueryCallback* callback, SqlDelayThread* thread, SqlResultQueue* queue);
+        // keep order with transactions of the same serial key, see Database::BeginTransaction
+        void SetSerialKey(uint32 serialKey) { m_serialKey = serialKey; }
+        bool Execute(MaNGOS::IQueryCallback* callback, Database* db, SqlResultQueue* queue, uint32 route = 0);
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -139,9 +162,14 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder* m_holder;
         MaNGOS::IQueryCallback* m_callback;
         SqlResultQueue* m_queue;
+        Database* m_db;
+        uint32 m_route;
+
+        // every slices-th query starting at slice
+        void ExecuteSlice(SqlConnection* conn, size_t slice, size_t slices);
     public:
-        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderEx(SqlQueryHolder* holder, MaNGOS::IQueryCallback* callback, SqlResultQueue* queue, Database* db, uint32 route)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_db(db), m_route(route) {}
         bool Execute(SqlConnection* conn) override;
 };
 #endif                                                      //__SQLOPERATIONS_H
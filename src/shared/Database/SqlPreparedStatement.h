@@ -344,8 +344,10 @@ class SqlPlainPreparedStatement : public SqlPreparedStatement
 
         virtual bool execute() override;
 
+        // format a parameter as SQL literal, strings are escaped for the connection
+        static void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt, SqlConnection& conn);
+
     protected:
-        void DataToString(const SqlStmtFieldData& data, std::ostringstream& fmt) const;
 
         std::string m_szPlainRequest;
 };
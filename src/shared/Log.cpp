@@ -24,6 +24,7 @@
 #include "ByteBuffer.h"
 #include "ProgressBar.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <thread>
@@ -69,7 +70,9 @@ const int LogType_count = int(LogError) + 1;
 
 Log::Log() :
     raLogfile(nullptr), logfile(nullptr), gmLogfile(nullptr), charLogfile(nullptr), dberLogfile(nullptr),
-    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr), m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
+    eventAiErLogfile(nullptr), scriptErrLogFile(nullptr), worldLogfile(nullptr), customLogFile(nullptr),
+    m_asyncRunning(false), m_asyncQueueLimit(0), m_asyncPending(0), m_asyncDropped(0),
+    m_colored(false), m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(nullptr)
 {
     Initialize();
 }
@@ -219,6 +222,9 @@ void Log::SetLogFileLevel(char* level)
 
 void Log::Initialize()
 {
+    // files may be reopened below, write what is queued for the old ones first
+    stopAsyncWriter();
+
     /// Common log files data
     m_logsDir = sConfig.GetStringDefault("LogsDir");
     if (!m_logsDir.empty())
@@ -285,6 +291,9 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    if (uint32 queueLimit = sConfig.GetIntDefault("LogAsyncQueueSize", 0))
+        startAsyncWriter(queueLimit);
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -358,6 +367,135 @@ std::string Log::GetTimestampStr()
     return std::string(buf);
 }
 
+std::string Log::getLineTimestamp()
+{
+    time_t t = time(nullptr);
+    tm* aTm = localtime(&t);
+    // same format as outTimestamp
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%-4d-%02d-%02d %02d:%02d:%02d ", aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec);
+    return std::string(buf);
+}
+
+void Log::outFile(FILE* file, char const* prefix, char const* str, va_list ap, bool closeAfter)
+{
+    std::string text = getLineTimestamp();
+    if (prefix)
+        text.append(prefix);
+
+    va_list apRetry;
+    va_copy(apRetry, ap);
+
+    char buf[1024];
+    int len = vsnprintf(buf, sizeof(buf), str, ap);
+    if (len >= int(sizeof(buf)))
+    {
+        size_t offset = text.size();
+        text.resize(offset + len + 1);
+        vsnprintf(&text[offset], len + 1, str, apRetry);
+        text.resize(offset + len);
+    }
+    else if (len > 0)
+        text.append(buf, len);
+
+    va_end(apRetry);
+
+    text.append("\n");
+    writeFile(file, std::move(text), closeAfter);
+}
+
+void Log::writeFile(FILE* file, std::string&& text, bool closeAfter)
+{
+    uint32 queueLimit = m_asyncQueueLimit.load(std::memory_order_relaxed);
+    if (!queueLimit)
+    {
+        fwrite(text.data(), 1, text.size(), file);
+        if (closeAfter)
+            fclose(file);
+        else
+            fflush(file);
+        return;
+    }
+
+    // bounded queue, the lines over the limit are dropped and their count reported by the writer
+    if (m_asyncPending.fetch_add(1) >= queueLimit)
+    {
+        --m_asyncPending;
+        ++m_asyncDropped;
+        if (closeAfter)
+            fclose(file);
+        return;
+    }
+
+    AsyncLine line;
+    line.file = file;
+    line.text = std::move(text);
+    line.closeAfter = closeAfter;
+    m_asyncQueue.Enqueue(std::move(line));
+}
+
+void Log::startAsyncWriter(uint32 queueLimit)
+{
+    m_asyncRunning = true;
+    m_asyncQueueLimit = queueLimit;
+    m_asyncThread = std::thread(&Log::asyncWriterLoop, this);
+}
+
+void Log::stopAsyncWriter()
+{
+    if (!m_asyncThread.joinable())
+        return;
+
+    // new lines are written synchronously from now on, the writer finishes the queued ones
+    m_asyncQueueLimit = 0;
+    m_asyncRunning = false;
+    m_asyncThread.join();
+}
+
+void Log::waitAsyncWriter()
+{
+    while (m_asyncPending)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void Log::asyncWriterLoop()
+{
+    std::vector<FILE*> written;
+    while (m_asyncRunning || m_asyncPending)
+    {
+        AsyncLine line;
+        while (m_asyncQueue.Dequeue(line))
+        {
+            fwrite(line.text.data(), 1, line.text.size(), line.file);
+            if (line.closeAfter)
+                fclose(line.file);
+            else if (std::find(written.begin(), written.end(), line.file) == written.end())
+                written.push_back(line.file);
+            --m_asyncPending;
+        }
+
+        // one flush per file for everything written in this pass
+        for (FILE* file : written)
+            fflush(file);
+
+        if (uint32 dropped = m_asyncDropped.exchange(0))
+        {
+            if (logfile)
+            {
+                std::string text = getLineTimestamp();
+                text.append("ERROR:").append(std::to_string(dropped)).append(" log lines dropped, LogAsyncQueueSize reached\n");
+                fwrite(text.data(), 1, text.size(), logfile);
+                fflush(logfile);
+            }
+        }
+
+        if (written.empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOG_ASYNC_WRITER_SLEEP));
+
+        written.clear();
+    }
+}
+
 void Log::outString()
 {
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
@@ -365,11 +503,7 @@ void Log::outString()
         outTime();
     printf("\n");
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
-    }
+        writeFile(logfile, getLineTimestamp() + "\n");
 
     fflush(stdout);
 }
@@ -400,14 +534,9 @@ void Log::outString(const char* str, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, nullptr, str, ap);
         va_end(ap);
-
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -438,15 +567,9 @@ void Log::outError(const char* err, ...)
     fprintf(stderr, "\n");
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR:", err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stderr);
@@ -462,18 +585,10 @@ void Log::outErrorDb()
     fprintf(stderr, "\n");
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
-    }
+        writeFile(logfile, getLineTimestamp() + "ERROR:\n");
 
     if (dberLogfile)
-    {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
-    }
+        writeFile(dberLogfile, getLineTimestamp() + "\n");
 
     fflush(stderr);
 }
@@ -504,28 +619,16 @@ void Log::outErrorDb(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR:", err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-
-        va_list ap;
         va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
+        outFile(dberLogfile, nullptr, err, ap);
         va_end(ap);
-
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
     }
 
     fflush(stderr);
@@ -541,18 +644,10 @@ void Log::outErrorEventAI()
     fprintf(stderr, "\n");
 
     if (logfile)
-    {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
-    }
+        writeFile(logfile, getLineTimestamp() + "ERROR CreatureEventAI\n");
 
     if (eventAiErLogfile)
-    {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
-    }
+        writeFile(eventAiErLogfile, getLineTimestamp() + "\n");
 
     fflush(stderr);
 }
@@ -563,6 +658,7 @@ void Log::outErrorEventAI(const char* err, ...)
         return;
 
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
+
     if (m_colored)
         SetColor(false, m_colors[LogError]);
 
@@ -582,28 +678,16 @@ void Log::outErrorEventAI(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR CreatureEventAI: ", err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (eventAiErLogfile)
     {
-        outTimestamp(eventAiErLogfile);
-
-        va_list ap;
         va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
+        outFile(eventAiErLogfile, nullptr, err, ap);
         va_end(ap);
-
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
     }
 
     fflush(stderr);
@@ -637,12 +721,9 @@ void Log::outBasic(const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, nullptr, str, ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -675,15 +756,10 @@ void Log::outDetail(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        outFile(logfile, nullptr, str, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -716,15 +792,10 @@ void Log::outDebug(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        outFile(logfile, nullptr, str, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -758,12 +829,9 @@ void Log::outCommand(uint32 account, const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, nullptr, str, ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     if (m_gmlog_per_account)
@@ -771,23 +839,17 @@ void Log::outCommand(uint32 account, const char* str, ...)
         if (FILE* per_file = openGmlogPerAccount(account))
         {
             va_list ap;
-            outTimestamp(per_file);
             va_start(ap, str);
-            vfprintf(per_file, str, ap);
-            fprintf(per_file, "\n");
+            outFile(per_file, nullptr, str, ap, true);
             va_end(ap);
-            fclose(per_file);
         }
     }
     else if (gmLogfile)
     {
         va_list ap;
-        outTimestamp(gmLogfile);
         va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
+        outFile(gmLogfile, nullptr, str, ap);
         va_end(ap);
-        fflush(gmLogfile);
     }
 
     fflush(stdout);
@@ -802,12 +864,9 @@ void Log::outChar(const char* str, ...)
     if (charLogfile)
     {
         va_list ap;
-        outTimestamp(charLogfile);
         va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
+        outFile(charLogfile, nullptr, str, ap);
         va_end(ap);
-        fflush(charLogfile);
     }
 }
 
@@ -821,20 +880,16 @@ void Log::outErrorScriptLib()
 
     if (logfile)
     {
-        outTimestamp(logfile);
+        std::string text = getLineTimestamp();
         if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
+            text.append("<").append(m_scriptLibName).append(" ERROR:> ");
         else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        fflush(logfile);
+            text.append("<Scripting Library ERROR>: ");
+        writeFile(logfile, std::move(text));
     }
 
     if (scriptErrLogFile)
-    {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
-    }
+        writeFile(scriptErrLogFile, getLineTimestamp() + "\n");
 
     fflush(stderr);
 }
@@ -864,31 +919,22 @@ void Log::outErrorScriptLib(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
+        std::string prefix;
         if (m_scriptLibName)
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
+            prefix.append("<").append(m_scriptLibName).append(" ERROR>: ");
         else
-            fprintf(logfile, "<Scripting Library ERROR>: ");
+            prefix.append("<Scripting Library ERROR>: ");
 
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, prefix.c_str(), err, ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-
-        va_list ap;
         va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
+        outFile(scriptErrLogFile, nullptr, err, ap);
         va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
     }
 
     fflush(stderr);
@@ -901,23 +947,28 @@ void Log::outWorldPacketDump(const char* socket, uint32 opcode, char const* opco
 
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
 
-    outTimestamp(worldLogfile);
+    std::string text = getLineTimestamp();
 
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    char buf[256];
+    snprintf(buf, sizeof(buf), "\n%s:\nSOCKET: %s\nLENGTH: %u\nOPCODE: %s (0x%.4X)\nDATA:\n",
+             incoming ? "CLIENT" : "SERVER",
+             socket, static_cast<uint32>(packet.size()), opcodeName, opcode);
+    text.append(buf);
 
     size_t p = 0;
     while (p < packet.size())
     {
         for (size_t j = 0; j < 16 && p < packet.size(); ++j)
-            fprintf(worldLogfile, "%.2X ", packet[p++]);
+        {
+            snprintf(buf, sizeof(buf), "%.2X ", packet[p++]);
+            text.append(buf);
+        }
 
-        fprintf(worldLogfile, "\n");
+        text.append("\n");
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    text.append("\n\n");
+    writeFile(worldLogfile, std::move(text));
 }
 
 void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
@@ -926,8 +977,12 @@ void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const cha
 
     if (charLogfile)
     {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
+        char buf[256];
+        snprintf(buf, sizeof(buf), "== START DUMP == (account: %u guid: %u name: %s )\n", account_id, guid, name);
+
+        std::string text(buf);
+        text.append(str).append("\n== END DUMP ==\n");
+        writeFile(charLogfile, std::move(text));
     }
 }
 
@@ -940,12 +995,9 @@ void Log::outRALog(const char* str, ...)
     if (raLogfile)
     {
         va_list ap;
-        outTimestamp(raLogfile);
         va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
+        outFile(raLogfile, nullptr, str, ap);
         va_end(ap);
-        fflush(raLogfile);
     }
 
     fflush(stdout);
@@ -960,12 +1012,9 @@ void Log::outCustomLog(const char* str, ...)
     if (customLogFile)
     {
         va_list ap;
-        outTimestamp(customLogFile);
         va_start(ap, str);
-        vfprintf(customLogFile, str, ap);
-        fprintf(customLogFile, "\n");
+        outFile(customLogFile, nullptr, str, ap);
         va_end(ap);
-        fflush(customLogFile);
     }
 
     fflush(stdout);
@@ -999,7 +1048,10 @@ void Log::setScriptLibraryErrorFile(char const* fname, char const* libName)
     m_scriptLibName = libName;
 
     if (scriptErrLogFile)
+    {
+        waitAsyncWriter();
         fclose(scriptErrLogFile);
+    }
 
     if (!fname)
     {
@@ -1110,10 +1162,7 @@ void Log::traceLog()
 {
     std::lock_guard<std::mutex> guard(m_worldLogMtx);
     if (customLogFile)
-    {
-        fprintf(customLogFile, "%s\n", GetTraceLog().data());
-        fflush(customLogFile);
-    }
+        writeFile(customLogFile, GetTraceLog() + "\n");
 
     fflush(stdout);
 }
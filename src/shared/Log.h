@@ -21,8 +21,12 @@
 
 #include "Common.h"
 #include "Policies/Singleton.h"
+#include "Multithreading/MPSCQueue.h"
 
+#include <atomic>
+#include <cstdarg>
 #include <mutex>
+#include <thread>
 
 class Config;
 class ByteBuffer;
@@ -92,6 +96,8 @@ enum Color
 
 const int Color_count = int(WHITE) + 1;
 
+#define LOG_ASYNC_WRITER_SLEEP      10                      // ms the async writer waits when nothing is queued
+
 class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::mutex> >
 {
         friend class MaNGOS::OperatorNew<Log>;
@@ -99,6 +105,8 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
 
         ~Log()
         {
+            stopAsyncWriter();
+
             if (logfile != nullptr)
                 fclose(logfile);
             logfile = nullptr;
@@ -197,6 +205,16 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         FILE* openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode);
         FILE* openGmlogPerAccount(uint32 account);
 
+        // file output, written by the async writer thread when LogAsyncQueueSize is set, else on the caller thread
+        void outFile(FILE* file, char const* prefix, char const* str, va_list ap, bool closeAfter = false);
+        void writeFile(FILE* file, std::string&& text, bool closeAfter = false);
+        static std::string getLineTimestamp();
+
+        void startAsyncWriter(uint32 queueLimit);
+        void stopAsyncWriter();
+        void waitAsyncWriter();                             // until everything queued so far is written
+        void asyncWriterLoop();
+
         FILE* raLogfile;
         FILE* logfile;
         FILE* gmLogfile;
@@ -210,6 +228,21 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         std::mutex m_worldLogMtx;
         std::mutex m_traceLogMtx;
 
+        struct AsyncLine
+        {
+            FILE* file = nullptr;
+            std::string text;
+            bool closeAfter = false;
+        };
+
+        // the caller thread only formats the line, the writes and flushes are done by m_asyncThread
+        MPSCQueue<AsyncLine> m_asyncQueue;
+        std::thread m_asyncThread;
+        std::atomic<bool> m_asyncRunning;
+        std::atomic<uint32> m_asyncQueueLimit;              // 0 when the writes are synchronous
+        std::atomic<uint32> m_asyncPending;                 // queued and not yet written
+        std::atomic<uint32> m_asyncDropped;                 // over the limit since the last report
+
         // log/console control
         LogLevel m_logLevel;
         LogLevel m_logFileLevel;
@@ -258,6 +291,14 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
             sLog.outDetail(__VA_ARGS__);                \
     } while(0)
 
+// built with NO_DEBUG_LOG, the debug output is compiled out and its arguments are not evaluated
+#ifdef MANGOS_NO_DEBUG_LOG
+#define DEBUG_LOG(...)                                  \
+    do {} while(0)
+
+#define DEBUG_FILTER_LOG(F,...)                         \
+    do {} while(0)
+#else
 #define DEBUG_LOG(...)                                  \
     do {                                                \
         if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))    \
@@ -269,6 +310,7 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, std::m
         if (sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG) && !sLog.HasLogFilter(F)) \
             sLog.outDebug(__VA_ARGS__);                 \
     } while(0)
+#endif
 
 #define ERROR_DB_FILTER_LOG(F,...)                      \
     do {                                                \
@@ -17,6 +17,7 @@
  */
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <algorithm>
 #include <functional>
 
 #include "Config/Config.h"
@@ -74,6 +75,102 @@ void metric::measurement::set_condition(std::function<bool()> condition)
     m_condition = std::move(condition);
 }
 
+namespace
+{
+    uint32 shard_index()
+    {
+        static std::atomic<uint32> nextShard(0);
+        static thread_local uint32 shard = nextShard++ % METRIC_SHARDS;
+        return shard;
+    }
+}
+
+metric::series::series(std::string name, std::map<std::string, std::string> tags, kind type)
+    : m_name(std::move(name)), m_tags(std::move(tags)), m_kind(type)
+{
+}
+
+void metric::series::record(int64 value)
+{
+    shard& target = m_shards[shard_index()];
+
+    target.count.fetch_add(1, std::memory_order_relaxed);
+    target.sum.fetch_add(value, std::memory_order_relaxed);
+
+    if (m_kind == COUNTER)
+        return;
+
+    int64 current = target.min.load(std::memory_order_relaxed);
+    while (value < current && !target.min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+
+    current = target.max.load(std::memory_order_relaxed);
+    while (value > current && !target.max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+bool metric::series::collect(std::map<std::string, boost::any>& fields)
+{
+    int64 count = 0, sum = 0;
+    int64 min = std::numeric_limits<int64>::max();
+    int64 max = std::numeric_limits<int64>::min();
+
+    // a value recorded meanwhile may be split between this interval and the next one
+    for (shard& source : m_shards)
+    {
+        count += source.count.exchange(0, std::memory_order_relaxed);
+        sum += source.sum.exchange(0, std::memory_order_relaxed);
+        min = std::min(min, source.min.exchange(std::numeric_limits<int64>::max(), std::memory_order_relaxed));
+        max = std::max(max, source.max.exchange(std::numeric_limits<int64>::min(), std::memory_order_relaxed));
+    }
+
+    if (!count)
+        return false;
+
+    if (m_kind == COUNTER)
+    {
+        fields.insert({ "value", sum });
+        return true;
+    }
+
+    fields.insert({ "count", count });
+    fields.insert({ "sum", sum });
+    fields.insert({ "min", min });
+    fields.insert({ "max", max });
+    return true;
+}
+
+metric::counter::counter(std::string name, std::map<std::string, std::string> tags)
+{
+    if (!metric::enabled())
+        return;
+
+    m_series = std::make_shared<series>(std::move(name), std::move(tags), series::COUNTER);
+    metric::instance().register_series(m_series);
+}
+
+void metric::counter::add(int64 value)
+{
+    if (m_series)
+        m_series->record(value);
+}
+
+metric::histogram::histogram(std::string name, std::map<std::string, std::string> tags)
+{
+    if (!metric::enabled())
+        return;
+
+    m_series = std::make_shared<series>(std::move(name), std::move(tags), series::HISTOGRAM);
+    metric::instance().register_series(m_series);
+}
+
+void metric::histogram::record(int64 value)
+{
+    if (m_series)
+        m_series->record(value);
+}
+
+std::atomic<bool> metric::metric::s_enabled(false);
+std::atomic<uint32> metric::metric::s_spanSampleRate(1);
+
 metric::metric::metric()
 {
     initialize();
@@ -100,6 +197,9 @@ void metric::metric::initialize()
     if (!(m_enabled = sConfig.GetBoolDefault("Metric.Enable", false)))
         return;
 
+    s_spanSampleRate = std::max(1, sConfig.GetIntDefault("Metric.SpanSampleRate", 1));
+    s_enabled = true;
+
     m_connectionInfo = {
         sConfig.GetStringDefault("Metric.Address", "127.0.0.1"),
         sConfig.GetIntDefault("Metric.Port", 8086),
@@ -138,6 +238,8 @@ void metric::metric::reload_config()
         return;
     }
 
+    s_spanSampleRate = std::max(1, sConfig.GetIntDefault("Metric.SpanSampleRate", 1));
+
     m_writeService.post([&]
     {
         m_connectionInfo = {
@@ -167,6 +269,51 @@ void metric::metric::report(std::string measurement, std::map<std::string, boost
     });
 }
 
+bool metric::metric::sample_span()
+{
+    uint32 rate = s_spanSampleRate.load(std::memory_order_relaxed);
+    if (rate <= 1)
+        return true;
+
+    // every thread counts its own spans, no shared state for the ones not sampled
+    static thread_local uint32 spans = 0;
+    return ++spans % rate == 0;
+}
+
+void metric::metric::register_series(std::shared_ptr<series> const& aggregated)
+{
+    std::lock_guard<std::mutex> guard(m_seriesLock);
+    m_series.push_back(aggregated);
+}
+
+void metric::metric::collect_series()
+{
+    std::vector<std::unique_ptr<Measurement>> collected;
+
+    {
+        std::lock_guard<std::mutex> guard(m_seriesLock);
+        for (auto itr = m_series.begin(); itr != m_series.end();)
+        {
+            std::map<std::string, boost::any> fields;
+            if ((*itr)->collect(fields))
+                collected.push_back(std::unique_ptr<Measurement>(new Measurement((*itr)->name(), (*itr)->tags(), fields)));
+
+            // no handle left, the last values were just collected
+            if (itr->use_count() == 1)
+                itr = m_series.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
+    if (collected.empty())
+        return;
+
+    std::lock_guard<std::mutex> guard(m_queueWriteLock);
+    for (auto& measurement : collected)
+        m_measurementQueue.push_back(std::move(measurement));
+}
+
 void metric::metric::schedule_timer()
 {
     using namespace std::placeholders;
@@ -194,6 +341,8 @@ void metric::metric::prepare_send(const boost::system::error_code& ec)
 
 void metric::metric::send()
 {
+    collect_series();
+
     std::vector<std::unique_ptr<Measurement>> measurements;
 
     // Scope swapping
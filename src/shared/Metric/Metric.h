@@ -21,16 +21,21 @@
 
 #include <boost/any.hpp>
 #include <boost/asio.hpp>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <thread>
 #include <vector>
 
 #include "Measurement.h"
 #include "Common.h"
 
+#define METRIC_SHARDS 8                                     // series shards, threads are spread over them
+
 struct MetricConnectionInfo
 {
     std::string hostname;
@@ -105,6 +110,120 @@ namespace metric
             std::chrono::high_resolution_clock::time_point m_startTime;
     };
 
+    // Values aggregated over the send interval and reported as one measurement per interval.
+    // Recording is lock-free and allocation free, each thread updates its own shard.
+    class series
+    {
+        public:
+            enum kind
+            {
+                COUNTER,                                    // reports the sum as "value"
+                HISTOGRAM                                   // reports count, sum, min and max
+            };
+
+            series(std::string name, std::map<std::string, std::string> tags, kind type);
+
+            void record(int64 value);
+
+            // fields of the values recorded since the last call, false when there were none
+            bool collect(std::map<std::string, boost::any>& fields);
+
+            std::string const& name() const { return m_name; }
+            std::map<std::string, std::string> const& tags() const { return m_tags; }
+
+        private:
+            struct alignas(64) shard
+            {
+                std::atomic<int64> count{0};
+                std::atomic<int64> sum{0};
+                std::atomic<int64> min{std::numeric_limits<int64>::max()};
+                std::atomic<int64> max{std::numeric_limits<int64>::min()};
+            };
+
+            std::string m_name;
+            std::map<std::string, std::string> m_tags;
+            kind m_kind;
+            shard m_shards[METRIC_SHARDS];
+    };
+
+    // Handles of aggregated series, keep them static in a function or with their owner.
+    // The series is reported one last time and forgotten after its last handle is gone.
+    class counter
+    {
+        public:
+            counter(std::string name, std::map<std::string, std::string> tags = {});
+
+            void add(int64 value = 1);
+
+        private:
+            std::shared_ptr<series> m_series;
+    };
+
+    class histogram
+    {
+        public:
+            histogram(std::string name, std::map<std::string, std::string> tags = {});
+
+            void record(int64 value);
+
+        private:
+            std::shared_ptr<series> m_series;
+    };
+
+    // Records the duration of the enclosing scope into a histogram, only for the calls picked by Metric.SpanSampleRate
+    template <class precision>
+    class span
+    {
+        public:
+            explicit span(histogram& target);
+            ~span()
+            {
+                if (m_sampled)
+                    m_target.record(std::chrono::duration_cast<precision>(std::chrono::steady_clock::now() - m_startTime).count());
+            }
+
+            span(span const&) = delete;
+            span& operator=(span const&) = delete;
+
+        private:
+            histogram& m_target;
+            bool m_sampled;
+            std::chrono::steady_clock::time_point m_startTime;
+    };
+
+    // Reports the scopes taking at least threshold as a "duration" measurement, tags() is only called for those.
+    // Unlike duration nothing is allocated for the fast scopes, create it with make_slow_span.
+    template <class precision, class Tags>
+    class slow_span
+    {
+        public:
+            slow_span(char const* name, int64 threshold, Tags tags);
+            ~slow_span();
+
+            // true when the scope already took the threshold, extra fields are only worth building then
+            bool slow() const { return m_enabled && elapsed() >= m_threshold; }
+            void add_field(std::string key, boost::any value) { m_fields.insert({ key, value }); }
+
+            slow_span(slow_span const&) = delete;
+            slow_span& operator=(slow_span const&) = delete;
+
+        private:
+            int64 elapsed() const { return std::chrono::duration_cast<precision>(std::chrono::steady_clock::now() - m_startTime).count(); }
+
+            char const* m_name;
+            int64 m_threshold;
+            Tags m_tags;
+            std::map<std::string, boost::any> m_fields;
+            bool m_enabled;
+            std::chrono::steady_clock::time_point m_startTime;
+    };
+
+    template <class precision, class Tags>
+    slow_span<precision, Tags> make_slow_span(char const* name, int64 threshold, Tags tags)
+    {
+        return slow_span<precision, Tags>(name, threshold, std::move(tags));
+    }
+
     class metric
     {
         public:
@@ -119,6 +238,13 @@ namespace metric
             void report(std::string measurement, std::string key, boost::any value, std::map<std::string, std::string> tags = {});
             void report(std::string measurement, std::map<std::string, boost::any> fields, std::map<std::string, std::string> tags = {});
 
+            static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+            // true for the spans picked by Metric.SpanSampleRate on the calling thread
+            static bool sample_span();
+
+            void register_series(std::shared_ptr<series> const& aggregated);
+
         private:
             boost::asio::io_service m_queueService;
             boost::asio::io_service m_writeService;
@@ -135,10 +261,46 @@ namespace metric
             std::mutex m_queueWriteLock;
             std::vector<std::unique_ptr<Measurement>> m_measurementQueue;
 
+            std::mutex m_seriesLock;
+            std::vector<std::shared_ptr<series>> m_series;
+
+            static std::atomic<bool> s_enabled;
+            static std::atomic<uint32> s_spanSampleRate;
+
             void schedule_timer();
             void prepare_send(const boost::system::error_code& ec);
+            void collect_series();
             void send();
     };
+
+    template <class precision>
+    span<precision>::span(histogram& target) : m_target(target), m_sampled(metric::enabled() && metric::sample_span())
+    {
+        if (m_sampled)
+            m_startTime = std::chrono::steady_clock::now();
+    }
+
+    template <class precision, class Tags>
+    slow_span<precision, Tags>::slow_span(char const* name, int64 threshold, Tags tags)
+        : m_name(name), m_threshold(threshold), m_tags(std::move(tags)), m_enabled(metric::enabled())
+    {
+        if (m_enabled)
+            m_startTime = std::chrono::steady_clock::now();
+    }
+
+    template <class precision, class Tags>
+    slow_span<precision, Tags>::~slow_span()
+    {
+        if (!m_enabled)
+            return;
+
+        int64 duration = elapsed();
+        if (duration < m_threshold)
+            return;
+
+        m_fields.insert({ "duration", duration });
+        metric::instance().report(m_name, m_fields, m_tags());
+    }
 }
 
 #endif // MANGOSSERVER_METRIC_H
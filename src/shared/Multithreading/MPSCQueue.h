@@ -0,0 +1,80 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _MPSC_QUEUE_H
+#define _MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free queue, any number of threads may Enqueue but only one thread at a time may Dequeue.
+// Producers never wait on each other or on the consumer, they swap the head and link the previous node.
+// A producer preempted between both steps hides the following nodes from the consumer until it resumes.
+template <typename T>
+class MPSCQueue
+{
+    public:
+        MPSCQueue() : m_head(new Node()), m_tail(m_head.load(std::memory_order_relaxed)) {}
+        MPSCQueue(const MPSCQueue&) = delete;
+        MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+        ~MPSCQueue()
+        {
+            T value;
+            while (Dequeue(value));
+            delete m_tail;
+        }
+
+        void Enqueue(T&& value)
+        {
+            Node* node = new Node(std::move(value));
+            Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // consumer thread only
+        bool Dequeue(T& value)
+        {
+            Node* next = m_tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return false;
+
+            value = std::move(next->value);
+            delete m_tail;
+            m_tail = next;                                  // next becomes the new stub
+            return true;
+        }
+
+        // consumer thread only, may miss a node a producer is just linking
+        bool Empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+
+    private:
+        struct Node
+        {
+            Node() : next(nullptr) {}
+            explicit Node(T&& v) : value(std::move(v)), next(nullptr) {}
+
+            T value;
+            std::atomic<Node*> next;
+        };
+
+        std::atomic<Node*> m_head;                          // last enqueued node, producers side
+        Node* m_tail;                                       // stub before the oldest node, consumer side
+};
+
+#endif
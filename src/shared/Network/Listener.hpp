@@ -23,6 +23,7 @@
 
 #include <boost/asio.hpp>
 
+#include <future>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -39,6 +40,9 @@ namespace MaNGOS
             std::thread m_acceptorThread;
             std::vector<std::unique_ptr<NetworkThread<SocketType>>> m_workerThreads;
 
+            // with SO_REUSEPORT every worker accepts on its own socket and the kernel spreads the connections
+            std::vector<std::unique_ptr<boost::asio::ip::tcp::acceptor>> m_workerAcceptors;
+
             // the time in milliseconds to sleep a worker thread at the end of each tick
             const int SleepInterval = 100;
 
@@ -64,19 +68,51 @@ namespace MaNGOS
             void BeginAccept();
             void OnAccept(NetworkThread<SocketType> *worker, std::shared_ptr<SocketType> const& socket, const boost::system::error_code &ec);
 
+            bool OpenWorkerAcceptors(boost::asio::ip::tcp::endpoint const& endpoint);
+            void BeginWorkerAccept(size_t index);
+            void OnWorkerAccept(size_t index, std::shared_ptr<SocketType> const& socket, const boost::system::error_code &ec);
+
         public:
-            Listener(std::string const& address, int port, int workerThreads);
+            // affinityMask binds the workers to the processors of its set bits in turn, 0 leaves them to the OS
+            Listener(std::string const& address, int port, int workerThreads, bool reusePort = false, uint64 affinityMask = 0);
             ~Listener();
     };
 
     template <typename SocketType>
-    Listener<SocketType>::Listener(std::string const& address, int port, int workerThreads)
-    : m_service(), m_acceptor(m_service, boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(address), port))
+    Listener<SocketType>::Listener(std::string const& address, int port, int workerThreads, bool reusePort, uint64 affinityMask)
+    : m_service(), m_acceptor(m_service)
     {
         m_workerThreads.reserve(workerThreads);
         for (auto i = 0; i < workerThreads; ++i)
             m_workerThreads.push_back(std::unique_ptr<NetworkThread<SocketType>>(new NetworkThread<SocketType>));
 
+        if (affinityMask)
+        {
+            uint32 cpu = 0;
+            for (auto& worker : m_workerThreads)
+            {
+                while (!(affinityMask & (uint64(1) << cpu)))
+                    cpu = (cpu + 1) % 64;
+
+                worker->SetAffinity(cpu);
+                cpu = (cpu + 1) % 64;
+            }
+        }
+
+        boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address::from_string(address), port);
+
+        if (reusePort && OpenWorkerAcceptors(endpoint))
+        {
+            for (size_t i = 0; i < m_workerAcceptors.size(); ++i)
+                BeginWorkerAccept(i);
+            return;
+        }
+
+        m_acceptor.open(endpoint.protocol());
+        m_acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+        m_acceptor.bind(endpoint);
+        m_acceptor.listen();
+
         BeginAccept();
 
         m_acceptorThread = std::thread([this]() { m_service.run(); });
@@ -85,6 +121,26 @@ namespace MaNGOS
     template <typename SocketType>
     Listener<SocketType>::~Listener()
     {
+        if (!m_workerAcceptors.empty())
+        {
+            // every acceptor lives in its worker's thread, close and destroy it there
+            for (size_t i = 0; i < m_workerAcceptors.size(); ++i)
+            {
+                std::promise<void> closed;
+                boost::asio::io_service& service = m_workerThreads[i]->GetService();
+                service.post([this, i, &closed, &service]()
+                {
+                    m_workerAcceptors[i]->close();
+                    m_workerAcceptors[i].reset();
+
+                    // queued behind the aborted accept, so that handler is done with us once this runs
+                    service.post([&closed]() { closed.set_value(); });
+                });
+                closed.get_future().wait();
+            }
+            return;
+        }
+
         // Close the acceptor. This will cancel any asynchronous accept
         // operation and should stop the acceptor thread. Note that closing
         // the acceptor needs to be done in the acceptor thread, because
@@ -93,6 +149,69 @@ namespace MaNGOS
         m_acceptorThread.join();
     }
 
+    template <typename SocketType>
+    bool Listener<SocketType>::OpenWorkerAcceptors(boost::asio::ip::tcp::endpoint const& endpoint)
+    {
+#ifdef SO_REUSEPORT
+        typedef boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> reuse_port;
+
+        boost::system::error_code ec;
+        for (auto& worker : m_workerThreads)
+        {
+            std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor(new boost::asio::ip::tcp::acceptor(worker->GetService()));
+
+            acceptor->open(endpoint.protocol(), ec);
+            if (!ec)
+                acceptor->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), ec);
+            if (!ec)
+                acceptor->set_option(reuse_port(true), ec);
+            if (!ec)
+                acceptor->bind(endpoint, ec);
+            if (!ec)
+                acceptor->listen(boost::asio::socket_base::max_listen_connections, ec);
+
+            if (ec)
+            {
+                sLog.outError("Listener: can't open SO_REUSEPORT acceptor (%s), falling back to a single acceptor", ec.message().c_str());
+                // nothing accepts yet, the worker threads never touched these acceptors
+                m_workerAcceptors.clear();
+                return false;
+            }
+
+            m_workerAcceptors.push_back(std::move(acceptor));
+        }
+        return true;
+#else
+        sLog.outError("Listener: SO_REUSEPORT is not supported on this platform, using a single acceptor");
+        return false;
+#endif
+    }
+
+    template <typename SocketType>
+    void Listener<SocketType>::BeginWorkerAccept(size_t index)
+    {
+        auto socket = m_workerThreads[index]->CreateSocket();
+
+        m_workerAcceptors[index]->async_accept(socket->GetAsioSocket(),
+            [this, index, socket] (const boost::system::error_code &ec)
+        {
+            this->OnWorkerAccept(index, socket, ec);
+        });
+    }
+
+    template <typename SocketType>
+    void Listener<SocketType>::OnWorkerAccept(size_t index, std::shared_ptr<SocketType> const& socket, const boost::system::error_code &ec)
+    {
+        // runs in the worker's own thread, the socket never crosses threads
+        if (ec)
+            m_workerThreads[index]->RemoveSocket(socket.get());
+        else
+            socket->Open();
+
+        // the acceptor may already be gone when shutting down
+        if (ec != boost::asio::error::operation_aborted && m_workerAcceptors[index] && m_workerAcceptors[index]->is_open())
+            BeginWorkerAccept(index);
+    }
     template <typename SocketType>
     void Listener<SocketType>::BeginAccept()
     {
@@ -20,13 +20,21 @@
 #define __NETWORK_THREAD_HPP_
 
 #include "Socket.hpp"
+#include "Log.h"
+#include "AllocStats.h"
 
 #include <boost/asio.hpp>
 
+#include <atomic>
 #include <thread>
-#include <mutex>
 #include <unordered_set>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 namespace MaNGOS
 {
     template <typename SocketType>
@@ -35,8 +43,9 @@ namespace MaNGOS
         private:
             boost::asio::io_service m_service;
 
-            std::mutex m_socketLock;
+            // only touched from the service thread, other threads post their changes
             std::unordered_set<std::shared_ptr<SocketType>> m_sockets;
+            std::atomic<size_t> m_socketCount;
 
             // note that the work member *must* be declared after the service member for the work constructor to function correctly
             std::unique_ptr<boost::asio::io_service::work> m_work;
@@ -44,13 +53,18 @@ namespace MaNGOS
             std::thread m_serviceThread;
 
         public:
-            NetworkThread() : m_work(new boost::asio::io_service::work(m_service)), m_serviceThread([this] { boost::system::error_code ec; this->m_service.run(ec); })
+            NetworkThread() : m_socketCount(0), m_work(new boost::asio::io_service::work(m_service)), m_serviceThread([this] { AllocStats::SetThreadTag(ALLOC_TAG_NETWORK); boost::system::error_code ec; this->m_service.run(ec); })
             {
             }
 
             ~NetworkThread()
             {
-                // attempt to gracefully close any open connections
+                // Allow io_service::run() to exit.
+                m_service.stop();
+                if (m_serviceThread.joinable())
+                    m_serviceThread.join();
+
+                // attempt to gracefully close any open connections, the service thread is gone so the set is ours now
                 for (auto i = m_sockets.begin(); i != m_sockets.end();)
                 {
                     auto const current = i;
@@ -60,34 +74,56 @@ namespace MaNGOS
                         (*current)->Close();
                 }
 
-                // Allow io_service::run() to exit.
-                m_service.stop();
-                if (m_serviceThread.joinable())
-                    m_serviceThread.join();
+                // run the removals the close handlers just posted
+                m_service.restart();
+                m_service.poll();
+                m_sockets.clear();
             }
 
-            size_t Size() const { return m_sockets.size(); }
+            boost::asio::io_service& GetService() { return m_service; }
 
+            size_t Size() const { return m_socketCount; }
+
+            // may be called from any thread, the socket is registered by the service thread before any of its handlers run
             std::shared_ptr<SocketType> CreateSocket();
 
             void RemoveSocket(Socket *socket)
             {
-                std::lock_guard<std::mutex> guard(m_socketLock);
-                m_sockets.erase(socket->shared<SocketType>());
+                std::shared_ptr<SocketType> ptr = socket->shared<SocketType>();
+                m_service.post([this, ptr]()
+                {
+                    if (m_sockets.erase(ptr))
+                        --m_socketCount;
+                });
+            }
+
+            void SetAffinity(uint32 cpu)
+            {
+#ifdef _WIN32
+                if (!SetThreadAffinityMask(m_serviceThread.native_handle(), DWORD_PTR(1) << cpu))
+                    sLog.outError("NetworkThread: can't bind network thread to processor %u", cpu);
+#elif defined(__linux__)
+                cpu_set_t cpuSet;
+                CPU_ZERO(&cpuSet);
+                CPU_SET(cpu, &cpuSet);
+                if (pthread_setaffinity_np(m_serviceThread.native_handle(), sizeof(cpuSet), &cpuSet) != 0)
+                    sLog.outError("NetworkThread: can't bind network thread to processor %u", cpu);
+#else
+                sLog.outError("NetworkThread: thread affinity is not supported on this platform, processor %u ignored", cpu);
+#endif
             }
     };
 
     template <typename SocketType>
     std::shared_ptr<SocketType> NetworkThread<SocketType>::CreateSocket()
     {
-        std::lock_guard<std::mutex> guard(m_socketLock);
-
-        auto const i = m_sockets.emplace(std::make_shared<SocketType>(m_service, [this] (Socket *socket) { this->RemoveSocket(socket); }));
+        std::shared_ptr<SocketType> socket = std::make_shared<SocketType>(m_service, [this] (Socket *socket) { this->RemoveSocket(socket); });
 
-        MANGOS_ASSERT(i.second);
+        ++m_socketCount;
+        m_service.post([this, socket]() { m_sockets.insert(socket); });
 
-        return *i.first;
+        return socket;
     }
 }
 
-#endif /* !__NETWORK_THREAD_HPP_ */
\ No newline at end of file
+#endif /* !__NETWORK_THREAD_HPP_ */
@@ -32,9 +32,14 @@
 
 namespace MaNGOS
 {
+    std::atomic<uint32> Socket::s_bufferTimeout(50000);
+    std::atomic<uint32> Socket::s_bufferFlushBytes(0);
+    std::atomic<uint64> Socket::s_writeCount(0);
+    std::atomic<uint64> Socket::s_writeBytes(0);
+
     Socket::Socket(boost::asio::io_service& service, std::function<void (Socket*)> closeHandler)
         : m_writeState(WriteState::Idle), m_readState(ReadState::Idle), m_socket(service),
-          m_closeHandler(std::move(closeHandler)), m_outBufferFlushTimer(service), m_address("0.0.0.0"),
+          m_closeHandler(std::move(closeHandler)), m_outInFlight(0), m_outBackOpen(false), m_outBufferedBytes(0), m_outBufferFlushTimer(service), m_address("0.0.0.0"),
           m_remoteAddress(boost::asio::ip::address()), m_remotePort(0){}
 
     bool Socket::Open()
@@ -52,8 +57,6 @@ namespace MaNGOS
             return false;
         }
 
-        m_outBuffer.reset(new PacketBuffer);
-        m_secondaryOutBuffer.reset(new PacketBuffer);
         m_inBuffer.reset(new PacketBuffer);
 
         StartAsyncRead();
@@ -168,37 +171,101 @@ namespace MaNGOS
         return true;
     }
 
+// note that this function assumes that the socket mutex is locked
+    void Socket::AppendOut(const char* buffer, int length)
+    {
+        if (!m_outBackOpen)
+        {
+            OutChunk chunk;
+            if (m_spareOutBuffer)
+                chunk.coalesced = std::move(m_spareOutBuffer);
+            else
+            {
+                chunk.coalesced = std::make_shared<std::vector<uint8>>();
+                chunk.coalesced->reserve(DEFAULT_BUFFER_SIZE);
+            }
+
+            m_outQueue.push_back(std::move(chunk));
+            m_outBackOpen = true;
+        }
+
+        std::vector<uint8>& out = *m_outQueue.back().coalesced;
+        out.insert(out.end(), reinterpret_cast<const uint8*>(buffer), reinterpret_cast<const uint8*>(buffer) + length);
+        m_outBufferedBytes += length;
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::ScheduleFlush()
+    {
+        if (m_writeState == WriteState::Idle)
+            StartWriteFlushTimer();
+        // enough data for a full write, do not wait for the timeout
+        else if (m_writeState == WriteState::Buffering)
+        {
+            uint32 const flushBytes = s_bufferFlushBytes.load(std::memory_order_relaxed);
+            if (flushBytes && m_outBufferedBytes >= flushBytes)
+                m_outBufferFlushTimer.cancel();
+        }
+    }
+
+    void Socket::SetWriteBufferPolicy(uint32 timeout, uint32 flushBytes)
+    {
+        s_bufferTimeout = timeout;
+        s_bufferFlushBytes = flushBytes;
+    }
+
+    void Socket::GetWriteStats(uint64& writes, uint64& bytes, bool reset)
+    {
+        if (reset)
+        {
+            writes = s_writeCount.exchange(0, std::memory_order_relaxed);
+            bytes = s_writeBytes.exchange(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            writes = s_writeCount.load(std::memory_order_relaxed);
+            bytes = s_writeBytes.load(std::memory_order_relaxed);
+        }
+    }
+
     void Socket::Write(const char* header, int headerSize, const char* content, int contentSize)
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
-
         // write the header
-        outBuffer->Write(header, headerSize);
+        AppendOut(header, headerSize);
 
         // write the content
-        outBuffer->Write(content, contentSize);
+        AppendOut(content, contentSize);
 
         // flush data if need
-        if (m_writeState == WriteState::Idle)
-            StartWriteFlushTimer();
+        ScheduleFlush();
     }
 
-    void Socket::Write(const char* buffer, int length)
+    void Socket::Write(const char* header, int headerSize, SharedBuffer content)
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        // get the correct buffer depending on the current writing state
-        PacketBuffer* outBuffer = m_writeState == WriteState::Sending ? m_secondaryOutBuffer.get() : m_outBuffer.get();
+        AppendOut(header, headerSize);
 
-        // write the header
-        outBuffer->Write(buffer, length);
+        // the payload stays in its own chunk, later small writes start a new coalescing buffer behind it
+        OutChunk chunk;
+        m_outBufferedBytes += content->size();
+        chunk.shared = std::move(content);
+        m_outQueue.push_back(std::move(chunk));
+        m_outBackOpen = false;
+
+        ScheduleFlush();
+    }
+
+    void Socket::Write(const char* buffer, int length)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        AppendOut(buffer, length);
 
         // flush data if need
-        if (m_writeState == WriteState::Idle)
-            StartWriteFlushTimer();
+        ScheduleFlush();
     }
 
 // note that this function assumes that the socket mutex is locked
@@ -217,7 +284,7 @@ namespace MaNGOS
         m_writeState = WriteState::Buffering;
 
         std::shared_ptr<Socket> ptr = shared<Socket>();
-        m_outBufferFlushTimer.expires_from_now(boost::posix_time::milliseconds(int(BufferTimeout)));
+        m_outBufferFlushTimer.expires_from_now(boost::posix_time::microseconds(int64(s_bufferTimeout.load(std::memory_order_relaxed))));
         m_outBufferFlushTimer.async_wait([ptr](const boost::system::error_code&) { ptr->FlushOut(); });
     }
 
@@ -234,12 +301,27 @@ namespace MaNGOS
 
         assert(m_writeState == WriteState::Buffering);
 
-        // at this point we are guarunteed that there is data to send in the primary buffer.  send it.
+        // at this point we are guarunteed that there is data queued.  send it.
         m_writeState = WriteState::Sending;
 
+        StartAsyncWrite();
+    }
+
+// note that this function assumes that the socket mutex is locked
+    void Socket::StartAsyncWrite()
+    {
+        // everything queued goes out in one gathered write, nothing more may be appended to these chunks
+        m_outInFlight = m_outQueue.size();
+        m_outBackOpen = false;
+        m_outBufferedBytes = 0;
+
+        m_outBufferSequence.clear();
+        for (auto const& chunk : m_outQueue)
+            m_outBufferSequence.push_back(boost::asio::buffer(chunk.Data()));
+
         std::shared_ptr<Socket> ptr = shared<Socket>();
-        m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                  make_custom_alloc_handler(m_allocator,
+        boost::asio::async_write(m_socket, m_outBufferSequence,
+                                 make_custom_alloc_handler(m_allocator,
         [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length); }));
     }
 
@@ -270,37 +352,28 @@ namespace MaNGOS
         std::lock_guard<std::mutex> guard(m_mutex);
 
         assert(m_writeState == WriteState::Sending);
-        assert(length <= m_outBuffer->m_writePosition);
 
-        // if there is data left to write, move it to the start of the buffer
-        if (length < m_outBuffer->m_writePosition)
-        {
-            memcpy(&(m_outBuffer->m_buffer[0]), &(m_outBuffer->m_buffer[length]), (m_outBuffer->m_writePosition - length) * sizeof(m_outBuffer->m_buffer[0]));
-            m_outBuffer->m_writePosition -= length;
-        }
-        // if not, reset the write pointer
-        else
-            m_outBuffer->m_writePosition = 0;
+        ++s_writeCount;
+        s_writeBytes += length;
 
-        // if there is data in the secondary buffer, append it to the primary buffer
-        if (m_secondaryOutBuffer->m_writePosition > 0)
+        // async_write only completes without error once every chunk was fully written
+        for (; m_outInFlight > 0; --m_outInFlight)
         {
-            // do we have enough space? if not, resize
-            if (m_outBuffer->m_buffer.size() < (m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition))
-                m_outBuffer->m_buffer.resize(m_outBuffer->m_writePosition + m_secondaryOutBuffer->m_writePosition);
+            OutChunk& chunk = m_outQueue.front();
 
-            memcpy(&(m_outBuffer->m_buffer[m_outBuffer->m_writePosition]), &(m_secondaryOutBuffer->m_buffer[0]), (m_secondaryOutBuffer->m_writePosition) * sizeof(m_secondaryOutBuffer->m_buffer[0]));
+            // keep one coalescing buffer and its capacity for the next writes
+            if (chunk.coalesced && !m_spareOutBuffer && chunk.coalesced->capacity() <= 4 * DEFAULT_BUFFER_SIZE)
+            {
+                chunk.coalesced->clear();
+                m_spareOutBuffer = std::move(chunk.coalesced);
+            }
 
-            m_outBuffer->m_writePosition += m_secondaryOutBuffer->m_writePosition;
-            m_secondaryOutBuffer->m_writePosition = 0;
+            m_outQueue.pop_front();
         }
 
-        std::shared_ptr<Socket> ptr = shared<Socket>();
-        // if there is any data to write, do so immediately
-        if (m_outBuffer->m_writePosition > 0)
-            m_socket.async_write_some(boost::asio::buffer(m_outBuffer->m_buffer, m_outBuffer->m_writePosition),
-                                      make_custom_alloc_handler(m_allocator,
-            [ptr](const boost::system::error_code & error, size_t length) { ptr->OnWriteComplete(error, length);}));
+        // if there is any data queued meanwhile, send it immediately
+        if (!m_outQueue.empty())
+            StartAsyncWrite();
         else
             m_writeState = WriteState::Idle;
     }
@@ -25,19 +25,28 @@
 
 #include <boost/asio.hpp>
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <string>
 #include <mutex>
 #include <functional>
+#include <vector>
 
 namespace MaNGOS
 {
     class Socket : public std::enable_shared_from_this<Socket>
     {
         private:
-            // buffer timeout period, in milliseconds.  higher values decrease responsiveness
+            // buffer timeout period, in microseconds.  higher values decrease responsiveness
             // ingame but increase bandwidth efficiency by reducing tcp overhead.
-            static const int BufferTimeout = 50;
+            static std::atomic<uint32> s_bufferTimeout;
+            // buffered bytes which cause an early flush, 0 waits for the timeout only
+            static std::atomic<uint32> s_bufferFlushBytes;
+
+            // completed writes and their bytes, over all sockets
+            static std::atomic<uint64> s_writeCount;
+            static std::atomic<uint64> s_writeBytes;
 
             enum class WriteState
             {
@@ -59,9 +68,26 @@ namespace MaNGOS
 
             std::function<void(Socket *)> m_closeHandler;
 
+            typedef std::shared_ptr<const std::vector<uint8>> SharedBuffer;
+
+            // one piece of outgoing data, either a buffer small writes are copied into or a payload handed over by the caller
+            struct OutChunk
+            {
+                std::shared_ptr<std::vector<uint8>> coalesced;
+                SharedBuffer shared;
+
+                const std::vector<uint8>& Data() const { return coalesced ? *coalesced : *shared; }
+            };
+
             std::unique_ptr<PacketBuffer> m_inBuffer;
-            std::unique_ptr<PacketBuffer> m_outBuffer;
-            std::unique_ptr<PacketBuffer> m_secondaryOutBuffer;
+
+            // chunks in send order, the first m_outInFlight of them belong to the running async_write
+            std::deque<OutChunk> m_outQueue;
+            size_t m_outInFlight;
+            bool m_outBackOpen;                             // back chunk is a coalescing buffer not yet handed to the kernel
+            size_t m_outBufferedBytes;                      // queued but not yet handed to the kernel
+            std::vector<boost::asio::const_buffer> m_outBufferSequence;
+            std::shared_ptr<std::vector<uint8>> m_spareOutBuffer;
 
             std::mutex m_mutex;
             std::mutex m_closeMutex;
@@ -73,6 +99,9 @@ namespace MaNGOS
             void StartWriteFlushTimer();
             void OnWriteComplete(const boost::system::error_code &error, size_t length);
             void FlushOut();
+            void StartAsyncWrite();
+            void AppendOut(const char *buffer, int length);
+            void ScheduleFlush();
 
             void OnError(const boost::system::error_code &error);
 
@@ -105,6 +134,8 @@ namespace MaNGOS
 
             void Write(const char *buffer, int length);
             void Write(const char *header, int headerSize, const char* content, int contentSize);
+            // the content is sent straight from the given buffer, without being copied into the output queue
+            void Write(const char *header, int headerSize, SharedBuffer content);
 
             boost::asio::ip::tcp::socket &GetAsioSocket() { return m_socket; }
 
@@ -114,6 +145,10 @@ namespace MaNGOS
             template <typename T>
             std::shared_ptr<T> shared() { return std::static_pointer_cast<T>(shared_from_this()); }
 
+            // coalescing policy of all sockets: flush after timeout microseconds or once flushBytes are buffered
+            static void SetWriteBufferPolicy(uint32 timeout, uint32 flushBytes);
+            static void GetWriteStats(uint64& writes, uint64& bytes, bool reset);
+
             boost::asio::ip::address GetRemoteIpAddress() const { return m_remoteAddress; }
             uint16 GetRemotePort() const { return m_remotePort; }
 
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Trace.h"
+#include "Log.h"
+
+#include <chrono>
+#include <cstdio>
+
+std::atomic<bool> Trace::s_capturing(false);
+std::atomic<uint64> Trace::s_captureStart(0);
+thread_local Trace::ThreadBuffer* Trace::s_threadBuffer = nullptr;
+
+Trace& Trace::Instance()
+{
+    static Trace instance;
+    return instance;
+}
+
+Trace::~Trace()
+{
+    StopCapture();
+    if (m_captureThread.joinable())
+        m_captureThread.join();
+}
+
+uint64 Trace::Now()
+{
+    return uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Trace::Record(char const* name, uint32 id, uint64 start, uint64 end)
+{
+    // zones that ended after the capture or began before it, possibly in an earlier one
+    if (!IsCapturing() || start < s_captureStart.load(std::memory_order_relaxed))
+        return;
+
+    if (!s_threadBuffer)
+        s_threadBuffer = Instance().RegisterThread();
+
+    std::lock_guard<std::mutex> guard(s_threadBuffer->lock);
+    if (s_threadBuffer->events.size() >= MAX_EVENTS_PER_THREAD)
+    {
+        ++s_threadBuffer->dropped;
+        return;
+    }
+    s_threadBuffer->events.push_back({ name, id, start, end });
+}
+
+Trace::ThreadBuffer* Trace::RegisterThread()
+{
+    std::lock_guard<std::mutex> guard(m_buffersLock);
+    m_buffers.push_back(std::make_unique<ThreadBuffer>());
+    m_buffers.back()->threadId = ++m_nextThreadId;
+    return m_buffers.back().get();
+}
+
+bool Trace::StartCapture(std::string const& fileName, uint32 durationMs)
+{
+    std::lock_guard<std::mutex> guard(m_captureLock);
+    if (m_running)
+        return false;
+
+    // the previous helper thread has already written its file
+    if (m_captureThread.joinable())
+        m_captureThread.join();
+
+    m_stop = false;
+    m_running = true;
+    s_captureStart.store(Now(), std::memory_order_relaxed);
+    s_capturing.store(true, std::memory_order_relaxed);
+    m_captureThread = std::thread(&Trace::RunCapture, this, fileName, durationMs);
+    return true;
+}
+
+void Trace::StopCapture()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_captureLock);
+        m_stop = true;
+    }
+    m_stopCondition.notify_all();
+}
+
+bool Trace::IsCaptureRunning() const
+{
+    std::lock_guard<std::mutex> guard(m_captureLock);
+    return m_running;
+}
+
+void Trace::RunCapture(std::string fileName, uint32 durationMs)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_captureLock);
+        m_stopCondition.wait_for(lock, std::chrono::milliseconds(durationMs), [&] { return m_stop; });
+    }
+
+    s_capturing.store(false, std::memory_order_relaxed);
+    WriteCapture(fileName, Now());
+
+    std::lock_guard<std::mutex> guard(m_captureLock);
+    m_running = false;
+}
+
+void Trace::WriteCapture(std::string const& fileName, uint64 captureEnd)
+{
+    std::vector<std::pair<uint32, std::vector<Event>>> threads;
+    uint64 dropped = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_buffersLock);
+        for (auto& buffer : m_buffers)
+        {
+            std::lock_guard<std::mutex> bufferGuard(buffer->lock);
+            threads.emplace_back(buffer->threadId, std::move(buffer->events));
+            buffer->events.clear();
+            dropped += buffer->dropped;
+            buffer->dropped = 0;
+        }
+    }
+
+    FILE* file = fopen(fileName.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("Trace: can not open %s for writing", fileName.c_str());
+        return;
+    }
+
+    uint64 captureStart = s_captureStart.load(std::memory_order_relaxed);
+    size_t written = 0;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (auto const& thread : threads)
+    {
+        for (Event const& event : thread.second)
+        {
+            if (event.end > captureEnd)
+                continue;
+
+            fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"id\":%u}}", written ? "," : "",
+                event.name, thread.first, double(event.start - captureStart) / 1000.0, double(event.end - event.start) / 1000.0, event.id);
+            ++written;
+        }
+    }
+    fputs("\n]}\n", file);
+    fclose(file);
+
+    sLog.outString("Trace: wrote %u zones over %.1f s to %s", uint32(written), double(captureEnd - captureStart) / 1e9, fileName.c_str());
+    if (dropped)
+        sLog.outError("Trace: %llu zones dropped, a thread recorded more than %u", (unsigned long long)dropped, uint32(MAX_EVENTS_PER_THREAD));
+}
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the CMaNGOS Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MANGOS_TRACE_H
+#define MANGOS_TRACE_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Timeline of the TraceZone scopes of all threads, recorded while a capture started by .debug trace runs.
+// The capture is written as chrome trace event json, open it in ui.perfetto.dev or chrome://tracing.
+// Zones only exist in builds with the BUILD_TRACING cmake option, outside a capture they cost one relaxed load.
+class Trace
+{
+    public:
+        static Trace& Instance();
+        ~Trace();
+
+        static bool IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+        // steady clock in ns
+        static uint64 Now();
+        // any thread, name must be a string literal
+        static void Record(char const* name, uint32 id, uint64 start, uint64 end);
+
+        // false when a capture is already running, the file is written from a helper thread after durationMs or StopCapture
+        bool StartCapture(std::string const& fileName, uint32 durationMs);
+        void StopCapture();
+        bool IsCaptureRunning() const;
+
+    private:
+        Trace() : m_running(false), m_stop(false), m_nextThreadId(0) {}
+
+        struct Event
+        {
+            char const* name;
+            uint32 id;
+            uint64 start;
+            uint64 end;
+        };
+
+        // one per recording thread, kept until shutdown so no cleanup is needed at thread exit
+        struct ThreadBuffer
+        {
+            std::mutex lock;                                // only contended while the capture is written
+            std::vector<Event> events;
+            uint64 dropped = 0;
+            uint32 threadId = 0;
+        };
+
+        static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+        ThreadBuffer* RegisterThread();
+        void RunCapture(std::string fileName, uint32 durationMs);
+        void WriteCapture(std::string const& fileName, uint64 captureEnd);
+
+        static std::atomic<bool> s_capturing;
+        static std::atomic<uint64> s_captureStart;
+        static thread_local ThreadBuffer* s_threadBuffer;
+
+        std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+        std::mutex m_buffersLock;
+
+        std::thread m_captureThread;
+        bool m_running;
+        bool m_stop;
+        mutable std::mutex m_captureLock;
+        std::condition_variable m_stopCondition;
+        uint32 m_nextThreadId;
+};
+
+#define sTrace Trace::Instance()
+
+// Records the time until it goes out of scope or End is called, when a capture was running at its start
+class TraceZone
+{
+    public:
+        explicit TraceZone(char const* name, uint32 id = 0) : m_name(name), m_id(id), m_start(Trace::IsCapturing() ? Trace::Now() : 0) {}
+        ~TraceZone() { End(); }
+
+        TraceZone(TraceZone const&) = delete;
+        TraceZone& operator=(TraceZone const&) = delete;
+
+        void End()
+        {
+            if (m_start)
+                Trace::Record(m_name, m_id, m_start, Trace::Now());
+            m_start = 0;
+        }
+
+    private:
+        char const* m_name;
+        uint32 m_id;
+        uint64 m_start;
+};
+
+#define MANGOS_TRACE_CONCAT_(a, b) a##b
+#define MANGOS_TRACE_CONCAT(a, b) MANGOS_TRACE_CONCAT_(a, b)
+
+#ifdef BUILD_TRACING
+#define TRACE_ZONE(name) TraceZone MANGOS_TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_ZONE_ID(name, id) TraceZone MANGOS_TRACE_CONCAT(traceZone, __LINE__)(name, id)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_ZONE_ID(name, id)
+#endif
+
+#endif
@@ -23,6 +23,9 @@
 #include "ByteBuffer.h"
 #include "Server/Opcodes.h"
 #include <chrono>
+#include <memory>
+
+#define ZERO_COPY_MIN_PACKET_SIZE   1024                    // moved or shared packets of at least this size are written without copying their content
 
 // Note: m_opcode and size stored in platfom dependent format
 // ignore endianess until send, and converted at receive
@@ -50,6 +53,15 @@ class WorldPacket : public ByteBuffer
             m_opcode = opcode;
         }
 
+        // hands the content over to the caller, the packet is left empty
+        std::vector<uint8> ReleaseStorage()
+        {
+            std::vector<uint8> storage;
+            storage.swap(_storage);
+            _rpos = _wpos = 0;
+            return storage;
+        }
+
         Opcodes GetOpcode() const { return m_opcode; }
         void SetOpcode(Opcodes opcode) { m_opcode = opcode; }
         inline const char* GetOpcodeName() const { return LookupOpcodeName(m_opcode); }
@@ -61,4 +73,24 @@ class WorldPacket : public ByteBuffer
         Opcodes m_opcode;
         std::chrono::steady_clock::time_point m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
+
+// packet built once and sent to many sessions, large content is copied once and then queued by every socket by reference
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(WorldPacket const& packet) : m_packet(packet)
+        {
+            if (packet.size() >= ZERO_COPY_MIN_PACKET_SIZE)
+                m_content = std::make_shared<const std::vector<uint8>>(packet.contents(), packet.contents() + packet.size());
+        }
+        SharedWorldPacket(SharedWorldPacket const&) = delete;
+
+        WorldPacket const& GetPacket() const { return m_packet; }
+        // nullptr for small packets, these are cheaper to copy next to their header
+        std::shared_ptr<const std::vector<uint8>> const& GetContent() const { return m_content; }
+
+    private:
+        WorldPacket const& m_packet;
+        std::shared_ptr<const std::vector<uint8>> m_content;
+};
 #endif
@@ -3,5 +3,5 @@
  #define REVISION_DB_REALMD "required_s2433_01_realmd_anticheat"
  #define REVISION_DB_LOGS "required_s2433_01_logs_anticheat"
  #define REVISION_DB_CHARACTERS "required_s2452_01_characters_fishingSteps"
- #define REVISION_DB_MANGOS "required_s2454_01_mangos_battleground_reflooot"
+ #define REVISION_DB_MANGOS "required_s2462_01_mangos_command"
 #endif // __REVISION_SQL_H__